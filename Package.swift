@@ -1,6 +1,21 @@
 // swift-tools-version:6.0
 import PackageDescription
 
+// Link the jemalloc from `Scripts/build_rocksdb.sh --jemalloc`, replacing the
+// system malloc for the whole process: ROCKSDB_JEMALLOC=1 swift build
+let jemalloc = Context.environment["ROCKSDB_JEMALLOC"] == "1"
+let jemallocSettings: [LinkerSetting] = jemalloc
+  ? [.linkedLibrary("jemalloc", .when(platforms: [.linux]))]
+  : []
+
+// Link liburing when lib/librocksdb.a was built with io_uring, which
+// Scripts/build_rocksdb.sh does on Linux if liburing-dev is installed:
+// ROCKSDB_URING=1 swift build
+let uring = Context.environment["ROCKSDB_URING"] == "1"
+let uringSettings: [LinkerSetting] = uring
+  ? [.linkedLibrary("uring", .when(platforms: [.linux]))]
+  : []
+
 let package = Package(
   name: "RocksDBSwift",
   platforms: [.macOS(.v14)],
@@ -9,6 +24,14 @@ let package = Package(
     .library(name: "RocksDBSwift", targets: ["RocksDBSwift"]),
     // Lightweight wrapper for basic key-value operations only
     .library(name: "RocksDBSwiftLite", targets: ["RocksDBSwiftLite"]),
+    // Offline block cache simulator for traces from startBlockCacheTrace
+    .executable(name: "rocksdb-cache-sim", targets: ["RocksDBCacheSimulator"]),
+    // Replays a query trace from startTrace and reports latency percentiles
+    .executable(name: "rocksdb-replay", targets: ["RocksDBReplayBenchmark"]),
+    // db_bench-style workloads against both wrappers
+    .executable(name: "rocksdb-bench", targets: ["RocksDBBench"]),
+    // Nanoseconds per operation of each layer over raw RocksDB
+    .executable(name: "rocksdb-microbench", targets: ["RocksDBMicrobench"]),
   ],
   targets: [
     // C++ bridge module
@@ -28,8 +51,9 @@ let package = Package(
         .linkedLibrary("lz4"),
         .linkedLibrary("zstd"),
         .linkedLibrary("z"),
-        .linkedLibrary("c++"),
-      ]
+        .linkedLibrary("c++", .when(platforms: [.macOS])),
+        .linkedLibrary("stdc++", .when(platforms: [.linux])),
+      ] + uringSettings + jemallocSettings
     ),
 
     // Full Swift wrapper with C++ interop
@@ -52,6 +76,46 @@ let package = Package(
       ]
     ),
 
+    // Block cache trace simulator
+    .executableTarget(
+      name: "RocksDBCacheSimulator",
+      dependencies: ["RocksDBSwift"],
+      path: "Sources/RocksDBCacheSimulator",
+      swiftSettings: [
+        .interoperabilityMode(.Cxx),
+      ]
+    ),
+
+    // Query trace replay benchmark
+    .executableTarget(
+      name: "RocksDBReplayBenchmark",
+      dependencies: ["RocksDBSwift"],
+      path: "Sources/RocksDBReplayBenchmark",
+      swiftSettings: [
+        .interoperabilityMode(.Cxx),
+      ]
+    ),
+
+    // Throughput and latency benchmark
+    .executableTarget(
+      name: "RocksDBBench",
+      dependencies: ["RocksDBSwift", "RocksDBSwiftLite"],
+      path: "Sources/RocksDBBench",
+      swiftSettings: [
+        .interoperabilityMode(.Cxx),
+      ] + (jemalloc ? [.define("ROCKSDB_JEMALLOC", .when(platforms: [.linux]))] : [])
+    ),
+
+    // Bridge and wrapper overhead microbenchmarks
+    .executableTarget(
+      name: "RocksDBMicrobench",
+      dependencies: ["CRocksDB", "RocksDBSwift", "RocksDBSwiftLite"],
+      path: "Sources/RocksDBMicrobench",
+      swiftSettings: [
+        .interoperabilityMode(.Cxx),
+      ]
+    ),
+
     // Tests for full wrapper
     .testTarget(
       name: "RocksDBSwiftTests",
@@ -11,13 +11,51 @@ PROJECT_ROOT="$(dirname "$SCRIPT_DIR")"
 THIRD_PARTY="$PROJECT_ROOT/ThirdParty"
 OUTPUT_DIR="$PROJECT_ROOT/lib"
 
+# Platform: universal (arm64 + x86_64) on macOS, native single-arch on Linux
+OS_NAME="$(uname -s)"
+if [ "$OS_NAME" = "Darwin" ]; then
+  ARCHS=(arm64 x86_64)
+else
+  ARCHS=(native)
+fi
+
+# Per-arch CMake flags shared by every library
+arch_cmake_opts() {
+  if [ "$1" = "native" ]; then
+    echo "-DCMAKE_POSITION_INDEPENDENT_CODE=ON"
+  else
+    echo "-DCMAKE_OSX_ARCHITECTURES=$1 -DCMAKE_OSX_DEPLOYMENT_TARGET=14.0"
+  fi
+}
+
+# Combine per-arch static libraries into one output library
+combine_libs() {
+  local output="$1"
+  shift
+  if [ "$OS_NAME" = "Darwin" ]; then
+    lipo -create "$@" -output "$output"
+  else
+    cp "$1" "$output"
+  fi
+}
+
 # Parse arguments
+#   --portable      Baseline instruction set only, for binaries run on unknown CPUs
+#   --march=CPU     Tune for a CPU family instead of the build host, e.g.
+#                   x86-64-v3 for an AVX2 fleet (hardware CRC32C and PCLMUL checksums)
+#   --jemalloc      Build against jemalloc (Linux); link it with ROCKSDB_JEMALLOC=1
 CLEAN=false
 SLIM=false
+PORTABLE=false
+MARCH=""
+JEMALLOC=false
 for arg in "$@"; do
   case $arg in
     --clean) CLEAN=true ;;
     --slim) SLIM=true ;;
+    --portable) PORTABLE=true ;;
+    --march=*) MARCH="${arg#--march=}" ;;
+    --jemalloc) JEMALLOC=true ;;
   esac
 done
 
@@ -29,6 +67,13 @@ else
   echo "Building WITH static compression libraries (self-contained)"
 fi
 echo "RocksDB Version: $ROCKSDB_VERSION"
+if [ -n "$MARCH" ]; then
+  echo "CPU: -march=$MARCH"
+elif [ "$PORTABLE" = true ]; then
+  echo "CPU: portable"
+else
+  echo "CPU: tuned for this host"
+fi
 echo "Output: $OUTPUT_DIR"
 echo ""
 
@@ -36,13 +81,56 @@ echo ""
 check_dependency() {
   if ! command -v "$1" &> /dev/null; then
     echo "Error: $1 is required but not installed."
-    echo "Install with: brew install $2"
+    if [ "$OS_NAME" = "Darwin" ]; then
+      echo "Install with: brew install $2"
+    else
+      echo "Install with: sudo apt-get install $3"
+    fi
     exit 1
   fi
 }
 
-check_dependency cmake cmake
-check_dependency ninja ninja
+check_dependency cmake cmake cmake
+check_dependency ninja ninja ninja-build
+
+# io_uring backs async reads (ReadOptions::async_io) on Linux
+if [ "$OS_NAME" = "Linux" ]; then
+  if [ -f /usr/include/liburing.h ]; then
+    URING_OPTS=(-DWITH_LIBURING=ON)
+    echo "Building with io_uring; link it with ROCKSDB_URING=1 swift build"
+  else
+    echo "Warning: liburing not found, async I/O will fall back to synchronous reads."
+    echo "Install with: sudo apt-get install liburing-dev"
+    URING_OPTS=(-DWITH_LIBURING=OFF)
+  fi
+else
+  URING_OPTS=()
+fi
+
+# jemalloc's per-thread arenas cut allocator contention under many threads;
+# its static library is copied to lib/ so the package stays self-contained
+JEMALLOC_OPTS=(-DWITH_JEMALLOC=OFF)
+JEMALLOC_LIB=""
+if [ "$JEMALLOC" = true ]; then
+  if [ "$OS_NAME" != "Linux" ]; then
+    echo "Warning: --jemalloc is only supported on Linux, building with the system allocator."
+    JEMALLOC=false
+  else
+    for candidate in libjemalloc_pic.a libjemalloc.a; do
+      path="$(cc -print-file-name=$candidate)"
+      if [ -f "$path" ]; then
+        JEMALLOC_LIB="$path"
+        break
+      fi
+    done
+    if [ ! -f /usr/include/jemalloc/jemalloc.h ] || [ -z "$JEMALLOC_LIB" ]; then
+      echo "Error: jemalloc is required for --jemalloc but not installed."
+      echo "Install with: sudo apt-get install libjemalloc-dev"
+      exit 1
+    fi
+    JEMALLOC_OPTS=(-DWITH_JEMALLOC=ON)
+  fi
+fi
 
 mkdir -p "$THIRD_PARTY"
 mkdir -p "$OUTPUT_DIR"
@@ -78,38 +166,25 @@ if [ "$SLIM" = false ]; then
     fi
 
     cd "$SNAPPY_SRC"
-    rm -rf build_arm64 build_x86_64
-
-    # Build arm64
-    mkdir -p build_arm64 && cd build_arm64
-    cmake .. -G Ninja \
-      -DCMAKE_BUILD_TYPE=Release \
-      -DCMAKE_OSX_ARCHITECTURES=arm64 \
-      -DCMAKE_OSX_DEPLOYMENT_TARGET=14.0 \
-      -DSNAPPY_BUILD_TESTS=OFF \
-      -DSNAPPY_BUILD_BENCHMARKS=OFF \
-      -DBUILD_SHARED_LIBS=OFF
-    ninja snappy
-    cd ..
-
-    # Build x86_64
-    mkdir -p build_x86_64 && cd build_x86_64
-    cmake .. -G Ninja \
-      -DCMAKE_BUILD_TYPE=Release \
-      -DCMAKE_OSX_ARCHITECTURES=x86_64 \
-      -DCMAKE_OSX_DEPLOYMENT_TARGET=14.0 \
-      -DSNAPPY_BUILD_TESTS=OFF \
-      -DSNAPPY_BUILD_BENCHMARKS=OFF \
-      -DBUILD_SHARED_LIBS=OFF
-    ninja snappy
-    cd ..
-
-    # Create universal binary
-    lipo -create build_arm64/libsnappy.a build_x86_64/libsnappy.a \
-      -output "$STATIC_LIBS_DIR/lib/libsnappy.a"
+    SNAPPY_LIBS=()
+    for arch in "${ARCHS[@]}"; do
+      rm -rf "build_$arch"
+      mkdir -p "build_$arch" && cd "build_$arch"
+      cmake .. -G Ninja \
+        -DCMAKE_BUILD_TYPE=Release \
+        $(arch_cmake_opts "$arch") \
+        -DSNAPPY_BUILD_TESTS=OFF \
+        -DSNAPPY_BUILD_BENCHMARKS=OFF \
+        -DBUILD_SHARED_LIBS=OFF
+      ninja snappy
+      cd ..
+      SNAPPY_LIBS+=("build_$arch/libsnappy.a")
+    done
+
+    combine_libs "$STATIC_LIBS_DIR/lib/libsnappy.a" "${SNAPPY_LIBS[@]}"
     cp snappy.h snappy-c.h snappy-sinksource.h snappy-stubs-public.h \
       "$STATIC_LIBS_DIR/include/" 2>/dev/null || true
-    cp build_arm64/snappy-stubs-public.h "$STATIC_LIBS_DIR/include/" 2>/dev/null || true
+    cp "build_${ARCHS[0]}/snappy-stubs-public.h" "$STATIC_LIBS_DIR/include/" 2>/dev/null || true
 
     echo "Snappy built: $STATIC_LIBS_DIR/lib/libsnappy.a"
   else
@@ -130,37 +205,23 @@ if [ "$SLIM" = false ]; then
     fi
 
     cd "$LZ4_SRC/build/cmake"
-    rm -rf build_arm64 build_x86_64
-
-    # Build arm64
-    mkdir -p build_arm64 && cd build_arm64
-    cmake .. -G Ninja \
-      -DCMAKE_BUILD_TYPE=Release \
-      -DCMAKE_OSX_ARCHITECTURES=arm64 \
-      -DCMAKE_OSX_DEPLOYMENT_TARGET=14.0 \
-      -DLZ4_BUILD_CLI=OFF \
-      -DLZ4_BUILD_LEGACY_LZ4C=OFF \
-      -DBUILD_SHARED_LIBS=OFF \
-      -DBUILD_STATIC_LIBS=ON
-    ninja lz4_static
-    cd ..
-
-    # Build x86_64
-    mkdir -p build_x86_64 && cd build_x86_64
-    cmake .. -G Ninja \
-      -DCMAKE_BUILD_TYPE=Release \
-      -DCMAKE_OSX_ARCHITECTURES=x86_64 \
-      -DCMAKE_OSX_DEPLOYMENT_TARGET=14.0 \
-      -DLZ4_BUILD_CLI=OFF \
-      -DLZ4_BUILD_LEGACY_LZ4C=OFF \
-      -DBUILD_SHARED_LIBS=OFF \
-      -DBUILD_STATIC_LIBS=ON
-    ninja lz4_static
-    cd ..
-
-    # Create universal binary
-    lipo -create build_arm64/liblz4.a build_x86_64/liblz4.a \
-      -output "$STATIC_LIBS_DIR/lib/liblz4.a"
+    LZ4_LIBS=()
+    for arch in "${ARCHS[@]}"; do
+      rm -rf "build_$arch"
+      mkdir -p "build_$arch" && cd "build_$arch"
+      cmake .. -G Ninja \
+        -DCMAKE_BUILD_TYPE=Release \
+        $(arch_cmake_opts "$arch") \
+        -DLZ4_BUILD_CLI=OFF \
+        -DLZ4_BUILD_LEGACY_LZ4C=OFF \
+        -DBUILD_SHARED_LIBS=OFF \
+        -DBUILD_STATIC_LIBS=ON
+      ninja lz4_static
+      cd ..
+      LZ4_LIBS+=("build_$arch/liblz4.a")
+    done
+
+    combine_libs "$STATIC_LIBS_DIR/lib/liblz4.a" "${LZ4_LIBS[@]}"
     cp "$LZ4_SRC/lib/lz4.h" "$LZ4_SRC/lib/lz4hc.h" "$LZ4_SRC/lib/lz4frame.h" \
       "$STATIC_LIBS_DIR/include/"
 
@@ -183,37 +244,23 @@ if [ "$SLIM" = false ]; then
     fi
 
     cd "$ZSTD_SRC/build/cmake"
-    rm -rf build_arm64 build_x86_64
-
-    # Build arm64
-    mkdir -p build_arm64 && cd build_arm64
-    cmake .. -G Ninja \
-      -DCMAKE_BUILD_TYPE=Release \
-      -DCMAKE_OSX_ARCHITECTURES=arm64 \
-      -DCMAKE_OSX_DEPLOYMENT_TARGET=14.0 \
-      -DZSTD_BUILD_PROGRAMS=OFF \
-      -DZSTD_BUILD_TESTS=OFF \
-      -DZSTD_BUILD_SHARED=OFF \
-      -DZSTD_BUILD_STATIC=ON
-    ninja libzstd_static
-    cd ..
-
-    # Build x86_64
-    mkdir -p build_x86_64 && cd build_x86_64
-    cmake .. -G Ninja \
-      -DCMAKE_BUILD_TYPE=Release \
-      -DCMAKE_OSX_ARCHITECTURES=x86_64 \
-      -DCMAKE_OSX_DEPLOYMENT_TARGET=14.0 \
-      -DZSTD_BUILD_PROGRAMS=OFF \
-      -DZSTD_BUILD_TESTS=OFF \
-      -DZSTD_BUILD_SHARED=OFF \
-      -DZSTD_BUILD_STATIC=ON
-    ninja libzstd_static
-    cd ..
-
-    # Create universal binary
-    lipo -create build_arm64/lib/libzstd.a build_x86_64/lib/libzstd.a \
-      -output "$STATIC_LIBS_DIR/lib/libzstd.a"
+    ZSTD_LIBS=()
+    for arch in "${ARCHS[@]}"; do
+      rm -rf "build_$arch"
+      mkdir -p "build_$arch" && cd "build_$arch"
+      cmake .. -G Ninja \
+        -DCMAKE_BUILD_TYPE=Release \
+        $(arch_cmake_opts "$arch") \
+        -DZSTD_BUILD_PROGRAMS=OFF \
+        -DZSTD_BUILD_TESTS=OFF \
+        -DZSTD_BUILD_SHARED=OFF \
+        -DZSTD_BUILD_STATIC=ON
+      ninja libzstd_static
+      cd ..
+      ZSTD_LIBS+=("build_$arch/lib/libzstd.a")
+    done
+
+    combine_libs "$STATIC_LIBS_DIR/lib/libzstd.a" "${ZSTD_LIBS[@]}"
     cp "$ZSTD_SRC/lib/zstd.h" "$ZSTD_SRC/lib/zstd_errors.h" \
       "$STATIC_LIBS_DIR/include/"
 
@@ -241,7 +288,7 @@ cd "$ROCKSDB_SRC"
 
 # Clean RocksDB builds if requested
 if [ "$CLEAN" = true ]; then
-  rm -rf build_arm64 build_x86_64
+  rm -rf build_arm64 build_x86_64 build_native
 fi
 
 # Set compression options
@@ -276,7 +323,6 @@ fi
 CMAKE_COMMON_OPTS=(
   -G Ninja
   -DCMAKE_BUILD_TYPE=Release
-  -DCMAKE_OSX_DEPLOYMENT_TARGET=14.0
   -DROCKSDB_BUILD_SHARED=OFF
   -DWITH_TESTS=OFF
   -DWITH_TOOLS=OFF
@@ -288,50 +334,69 @@ CMAKE_COMMON_OPTS=(
   -DPORTABLE=OFF
   -DFAIL_ON_WARNINGS=OFF
   -DCMAKE_CXX_STANDARD=20
+  "${URING_OPTS[@]}"
+  "${JEMALLOC_OPTS[@]}"
 )
 
-# Build for arm64
-echo ""
-echo "=== Building RocksDB for arm64 ==="
-mkdir -p build_arm64 && cd build_arm64
-
-cmake .. \
-  "${CMAKE_COMMON_OPTS[@]}" \
-  -DCMAKE_OSX_ARCHITECTURES=arm64 \
-  -DCMAKE_C_FLAGS="-march=armv8-a+crc+crypto" \
-  -DCMAKE_CXX_FLAGS="-march=armv8-a+crc+crypto"
-
-ninja rocksdb
-
-cd ..
-
-# Build for x86_64
-echo ""
-echo "=== Building RocksDB for x86_64 ==="
-mkdir -p build_x86_64 && cd build_x86_64
+# Native builds use every instruction the host has (PORTABLE=OFF means
+# -march=native); --march and --portable trade that for builds that run on
+# other machines, keeping runtime-dispatched CRC32C either way. The flags
+# are always passed so an earlier variant's cached ones are replaced.
+NATIVE_PORTABLE=OFF
+NATIVE_FLAGS=""
+if [ -n "$MARCH" ]; then
+  NATIVE_PORTABLE=ON
+  NATIVE_FLAGS="-march=$MARCH"
+elif [ "$PORTABLE" = true ]; then
+  NATIVE_PORTABLE=ON
+fi
 
-cmake .. \
-  "${CMAKE_COMMON_OPTS[@]}" \
-  -DCMAKE_OSX_ARCHITECTURES=x86_64 \
-  -DPORTABLE=ON
+ROCKSDB_LIBS=()
+for arch in "${ARCHS[@]}"; do
+  echo ""
+  echo "=== Building RocksDB for $arch ==="
+  mkdir -p "build_$arch" && cd "build_$arch"
+
+  case $arch in
+    arm64)
+      cmake .. \
+        "${CMAKE_COMMON_OPTS[@]}" \
+        $(arch_cmake_opts arm64) \
+        -DCMAKE_C_FLAGS="-march=armv8-a+crc+crypto" \
+        -DCMAKE_CXX_FLAGS="-march=armv8-a+crc+crypto"
+      ;;
+    x86_64)
+      cmake .. \
+        "${CMAKE_COMMON_OPTS[@]}" \
+        $(arch_cmake_opts x86_64) \
+        -DPORTABLE=ON
+      ;;
+    native)
+      cmake .. \
+        "${CMAKE_COMMON_OPTS[@]}" \
+        $(arch_cmake_opts native) \
+        -DPORTABLE=$NATIVE_PORTABLE \
+        -DCMAKE_C_FLAGS="$NATIVE_FLAGS" \
+        -DCMAKE_CXX_FLAGS="$NATIVE_FLAGS"
+      ;;
+  esac
 
-ninja rocksdb
+  ninja rocksdb
 
-cd ..
+  cd ..
+  ROCKSDB_LIBS+=("build_$arch/librocksdb.a")
+done
 
 # =============================================================================
 # Create output
 # =============================================================================
 
 echo ""
-echo "=== Creating universal binary ==="
+echo "=== Creating output library ==="
 
 mkdir -p "$OUTPUT_DIR/include"
 
-lipo -create \
-  build_arm64/librocksdb.a \
-  build_x86_64/librocksdb.a \
-  -output "$OUTPUT_DIR/librocksdb.a"
+combine_libs "$OUTPUT_DIR/librocksdb.a" "${ROCKSDB_LIBS[@]}"
 
 cp -r include/rocksdb "$OUTPUT_DIR/include/"
 
@@ -342,15 +407,23 @@ if [ "$SLIM" = false ]; then
   cp "$STATIC_LIBS_DIR/lib/libzstd.a" "$OUTPUT_DIR/"
 fi
 
+if [ "$JEMALLOC" = true ]; then
+  cp "$JEMALLOC_LIB" "$OUTPUT_DIR/libjemalloc.a"
+else
+  rm -f "$OUTPUT_DIR/libjemalloc.a"
+fi
+
 echo ""
 echo "=== Build Complete ==="
 echo "Output: $OUTPUT_DIR/"
 echo ""
 ls -lh "$OUTPUT_DIR"/*.a
 
-echo ""
-echo "Library architectures:"
-lipo -info "$OUTPUT_DIR/librocksdb.a"
+if [ "$OS_NAME" = "Darwin" ]; then
+  echo ""
+  echo "Library architectures:"
+  lipo -info "$OUTPUT_DIR/librocksdb.a"
+fi
 
 if [ "$SLIM" = true ]; then
   echo ""
@@ -364,3 +437,9 @@ else
   echo "FULL BUILD - Static compression libs included"
   echo "Package is self-contained, no brew dependencies needed!"
 fi
+
+if [ "$JEMALLOC" = true ]; then
+  echo ""
+  echo "JEMALLOC BUILD - build the package with:"
+  echo "  ROCKSDB_JEMALLOC=1 swift build -c release"
+fi
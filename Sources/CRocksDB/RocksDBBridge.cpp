@@ -6,31 +6,128 @@
 //
 
 #include "include/RocksDBBridge.h"
-
+#include "include/RocksDBMicrobench.h"
+
+#include <rocksdb/advanced_cache.h>
+#include <rocksdb/attribute_groups.h>
+#include <rocksdb/block_cache_trace_writer.h>
+#include <rocksdb/cache.h>
+#include <rocksdb/compaction_filter.h>
+#include <rocksdb/convenience.h>
 #include <rocksdb/db.h>
+#include <rocksdb/env.h>
+#include <rocksdb/file_system.h>
+#include <rocksdb/filter_policy.h>
+#include <rocksdb/iostats_context.h>
+#include <rocksdb/listener.h>
 #include <rocksdb/options.h>
+#include <rocksdb/perf_context.h>
+#include <rocksdb/perf_level.h>
+#include <rocksdb/rate_limiter.h>
 #include <rocksdb/slice.h>
+#include <rocksdb/slice_transform.h>
+#include <rocksdb/sst_file_manager.h>
+#include <rocksdb/sst_partitioner.h>
 #include <rocksdb/statistics.h>
+#include <rocksdb/system_clock.h>
+#include <rocksdb/sst_file_writer.h>
 #include <rocksdb/status.h>
 #include <rocksdb/iterator.h>
+#include <rocksdb/memtablerep.h>
+#include <rocksdb/merge_operator.h>
+#include <rocksdb/metadata.h>
+#include <rocksdb/table.h>
+#include <rocksdb/table_properties.h>
+#include <rocksdb/thread_status.h>
+#include <rocksdb/threadpool.h>
+#include <rocksdb/trace_reader_writer.h>
+#include <rocksdb/trace_record.h>
+#include <rocksdb/trace_record_result.h>
+#include <rocksdb/transaction_log.h>
+#include <rocksdb/wal_filter.h>
+#include <rocksdb/wide_columns.h>
 #include <rocksdb/write_batch.h>
+#include <rocksdb/write_buffer_manager.h>
+#include <rocksdb/utilities/backup_engine.h>
+#include <rocksdb/utilities/cache_dump_load.h>
+#include <rocksdb/utilities/checkpoint.h>
+#include <rocksdb/utilities/memory_util.h>
+#include <rocksdb/utilities/db_ttl.h>
 #include <rocksdb/utilities/optimistic_transaction_db.h>
+#include <rocksdb/utilities/options_util.h>
+#include <rocksdb/utilities/replayer.h>
+#include <rocksdb/utilities/table_properties_collectors.h>
 #include <rocksdb/utilities/transaction.h>
+#include <rocksdb/utilities/transaction_db.h>
+#include <rocksdb/utilities/write_batch_with_index.h>
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
 #include <cstring>
+#include <limits>
+#include <map>
+#include <string_view>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 // =============================================================================
 // MARK: - Internal Handle Structures
 // =============================================================================
 
+struct CompactionFilterState;
+
+struct RocksDBColumnFamilyHandle {
+  rocksdb::ColumnFamilyHandle* handle = nullptr;
+  std::string name;
+};
+
 struct RocksDBHandle {
   rocksdb::DB* db = nullptr;
   rocksdb::OptimisticTransactionDB* txn_db = nullptr;
+  rocksdb::TransactionDB* pessimistic_db = nullptr;  // same object as db in pessimistic mode
+  rocksdb::DBWithTTL* ttl_db = nullptr;  // same object as db when opened with a TTL
   bool is_transactional = false;
+  bool two_phase_commit = false;  // opened with allow_2pc
+  // Defaults for pessimistic transactions (lock timeout, deadlock detection)
+  rocksdb::TransactionOptions txn_options;
+  // Statistics object from the open options (null unless enabled)
+  std::shared_ptr<rocksdb::Statistics> statistics;
+  // WAL filter from the open options; the DB only holds a raw pointer to it
+  std::shared_ptr<rocksdb::WalFilter> wal_filter;
+  // Prepared transactions recovered at open and not yet handed out; the
+  // TransactionDB deletes any still registered when it closes
+  std::mutex recovered_mutex;
+  std::vector<rocksdb::Transaction*> recovered_txns;
+
+  // Owned by rocksdb_close plus one reference per outstanding pinned value,
+  // iterator and transaction, so none of them outlive the database.
+  std::atomic<int> ref_count{1};
+
+  // Every column family handle lives until the database is deleted, so refs
+  // handed out to callers (including dropped families) never dangle while open.
+  std::mutex cf_mutex;
+  std::vector<std::unique_ptr<RocksDBColumnFamilyHandle>> column_families;
+  // Wraps DefaultColumnFamily(), which the DB owns; filled in on first use
+  RocksDBColumnFamilyHandle default_family;
+
+  // Env installed by rocksdb_open_timed or rocksdb_open_in_memory; members
+  // are destroyed after the destructor body deletes the database, so it
+  // outlives every use
+  std::unique_ptr<rocksdb::Env> open_env;
 
   ~RocksDBHandle() {
+    for (auto& cf : column_families) {
+      db->DestroyColumnFamilyHandle(cf->handle);
+    }
+    column_families.clear();
+
     if (is_transactional && txn_db) {
       delete txn_db;
     } else if (db) {
@@ -39,48 +136,409 @@ struct RocksDBHandle {
   }
 };
 
+static void release_db(RocksDBHandle* db);
+
+struct RocksDBTransactionHandle {
+  rocksdb::Transaction* txn = nullptr;
+  rocksdb::ColumnFamilyHandle* default_cf = nullptr;
+  bool read_from_snapshot = false;  // began with set_snapshot
+  // Bumped whenever the write batch index is rewound or reset (commit,
+  // rollback, rollback to savepoint, reuse), which invalidates iterators
+  uint64_t epoch = 0;
+  // The transaction belongs to the TransactionDB, so it keeps it open
+  RocksDBHandle* owner = nullptr;
+  // Owned by rocksdb_transaction_destroy plus one reference per iterator,
+  // so pooling or destroying the transaction never frees what they read
+  std::atomic<int> ref_count{1};
+
+  ~RocksDBTransactionHandle() {
+    delete txn;
+    txn = nullptr;
+    if (owner) {
+      release_db(owner);
+    }
+  }
+};
+
+static void release_transaction(RocksDBTransactionHandle* txn) {
+  if (txn->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete txn;
+  }
+}
+
 struct RocksDBIteratorHandle {
   rocksdb::Iterator* iter = nullptr;
+  // Transaction iterators only: the transaction, kept alive by the
+  // iterator, and its epoch at creation; the iterator goes stale once the
+  // transaction's epoch moves on
+  RocksDBTransactionHandle* txn = nullptr;
+  uint64_t epoch = 0;
+
+  // Read options the iterator was created with; iterators keep pointers
+  // to the bounds and timestamps, so the handle owns copies of their bytes
+  // instead of borrowing the caller's read options handle
+  rocksdb::ReadOptions options;
+  std::string lower_bound;
+  std::string upper_bound;
+  std::string timestamp;
+  std::string iter_start_ts;
+  rocksdb::Slice lower_bound_slice;
+  rocksdb::Slice upper_bound_slice;
+  rocksdb::Slice timestamp_slice;
+  rocksdb::Slice iter_start_ts_slice;
+
+  bool stale() const {
+    return txn && txn->epoch != epoch;
+  }
+
+  // Copy base into options, re-pointing its slices at the handle's copies
+  const rocksdb::ReadOptions& adopt(const rocksdb::ReadOptions& base) {
+    options = base;
+    options.iterate_lower_bound = keep(base.iterate_lower_bound, &lower_bound, &lower_bound_slice);
+    options.iterate_upper_bound = keep(base.iterate_upper_bound, &upper_bound, &upper_bound_slice);
+    options.timestamp = keep(base.timestamp, &timestamp, &timestamp_slice);
+    options.iter_start_ts = keep(base.iter_start_ts, &iter_start_ts, &iter_start_ts_slice);
+    return options;
+  }
 
   ~RocksDBIteratorHandle() {
     delete iter;
+    if (txn) {
+      release_transaction(txn);
+    }
+  }
+
+ private:
+  static const rocksdb::Slice* keep(const rocksdb::Slice* source, std::string* bytes,
+                                    rocksdb::Slice* slice) {
+    if (!source) {
+      return nullptr;
+    }
+    bytes->assign(source->data(), source->size());
+    *slice = rocksdb::Slice(*bytes);
+    return slice;
   }
 };
 
+struct RocksDBScanPredicateHandle {
+  struct Node {
+    RocksDBPredicateKind kind;
+    bool on_value;
+    size_t offset;
+    bool from_end;
+    RocksDBCompareOp op;
+    RocksDBAggregateFieldSpec field;
+    uint64_t integer;
+    std::vector<std::string> operands;
+    // BytesIn only: distinct operand lengths and a lookup set over operands
+    std::vector<size_t> lengths;
+    std::unordered_set<std::string_view> members;
+    size_t child_count;
+    // Nodes in this subtree, itself included
+    size_t subtree_size;
+  };
+  std::vector<Node> nodes;
+};
+
 struct RocksDBBatchHandle {
   rocksdb::WriteBatch batch;
+  rocksdb::Status status;  // first failed append (e.g. max_bytes exceeded)
+
+  RocksDBBatchHandle() = default;
+  RocksDBBatchHandle(size_t reserved_bytes, size_t max_bytes)
+    : batch(reserved_bytes, max_bytes) {}
+  explicit RocksDBBatchHandle(std::string rep) : batch(std::move(rep)) {}
+
+  void record(const rocksdb::Status& s) {
+    if (status.ok() && !s.ok()) {
+      status = s;
+    }
+  }
 };
 
-struct RocksDBTransactionHandle {
-  rocksdb::Transaction* txn = nullptr;
+struct RocksDBIndexedBatchHandle {
+  rocksdb::WriteBatchWithIndex batch;
+  rocksdb::Status status;  // first failed append
 
-  ~RocksDBTransactionHandle() {
-    delete txn;
+  RocksDBIndexedBatchHandle(size_t reserved_bytes, bool overwrite_key)
+    : batch(rocksdb::BytewiseComparator(), reserved_bytes, overwrite_key) {}
+
+  void record(const rocksdb::Status& s) {
+    if (status.ok() && !s.ok()) {
+      status = s;
+    }
   }
 };
 
 struct RocksDBOptionsHandle {
   rocksdb::Options options;
+  // Owner of options.wal_filter, which is a raw pointer
+  std::shared_ptr<rocksdb::WalFilter> wal_filter;
+};
+
+struct RocksDBTransactionDBOptionsHandle {
+  int mode = RocksDBTransactionModeOptimistic;
+  bool two_phase_commit = false;
+  rocksdb::TransactionDBOptions db_options;
+  rocksdb::TransactionOptions txn_options;
+  rocksdb::OptimisticTransactionDBOptions occ_options;
+};
+
+struct RocksDBOccLockBucketsHandle {
+  std::shared_ptr<rocksdb::OccLockBuckets> buckets;
+};
+
+struct RocksDBCacheHandle {
+  std::shared_ptr<rocksdb::Cache> cache;
+  // Secondary cache attached to cache, the target of cache dump loads
+  std::shared_ptr<rocksdb::SecondaryCache> secondary;
+};
+
+struct RocksDBWriteBufferManagerHandle {
+  std::shared_ptr<rocksdb::WriteBufferManager> manager;
+};
+
+struct RocksDBCompactionFilterHandle {
+  std::shared_ptr<CompactionFilterState> state;
+};
+
+struct RocksDBRateLimiterHandle {
+  std::shared_ptr<rocksdb::RateLimiter> limiter;
+};
+
+struct RocksDBSstFileManagerHandle {
+  std::shared_ptr<rocksdb::SstFileManager> manager;
+};
+
+struct RocksDBTableOptionsHandle {
+  rocksdb::BlockBasedTableOptions options;
 };
 
 struct RocksDBReadOptionsHandle {
   rocksdb::ReadOptions options;
+
+  // Iterator bounds are referenced by slice, so the handle owns their bytes
+  std::string lower_bound;
+  std::string upper_bound;
+  rocksdb::Slice lower_bound_slice;
+  rocksdb::Slice upper_bound_slice;
+
+  // Encoded user timestamps, referenced by slice as well
+  std::string timestamp;
+  std::string iter_start_ts;
+  rocksdb::Slice timestamp_slice;
+  rocksdb::Slice iter_start_ts_slice;
 };
 
 struct RocksDBWriteOptionsHandle {
   rocksdb::WriteOptions options;
 };
 
+struct RocksDBIngestOptionsHandle {
+  rocksdb::IngestExternalFileOptions options;
+};
+
+struct RocksDBCompactRangeOptionsHandle {
+  rocksdb::CompactRangeOptions options;
+};
+
+struct RocksDBCompactionOptionsHandle {
+  rocksdb::CompactionOptions options;
+};
+
+struct RocksDBCancelFlagHandle {
+  std::atomic<bool> canceled{false};
+};
+
+struct RocksDBSstFileWriterHandle {
+  rocksdb::Options options;
+  std::unique_ptr<rocksdb::SstFileWriter> writer;
+};
+
 struct RocksDBSnapshotHandle {
   const rocksdb::Snapshot* snapshot = nullptr;
 };
 
+struct RocksDBExportMetadataHandle {
+  std::unique_ptr<rocksdb::ExportImportFilesMetaData> metadata;
+};
+
+struct RocksDBBackupEngineHandle {
+  std::unique_ptr<rocksdb::BackupEngine> engine;
+};
+
+static void retain_db(RocksDBHandle* db) {
+  db->ref_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+static void release_db(RocksDBHandle* db) {
+  if (db->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete db;
+  }
+}
+
+struct RocksDBWalIteratorHandle {
+  std::unique_ptr<rocksdb::TransactionLogIterator> iter;
+  // GetBatch moves the batch out, so it is fetched once per position
+  rocksdb::BatchResult current;
+  bool loaded = false;
+  std::string records;
+  size_t record_count = 0;
+  bool decoded = false;
+  RocksDBHandle* owner = nullptr;
+
+  void load() {
+    if (!loaded && iter->Valid()) {
+      current = iter->GetBatch();
+      loaded = true;
+    }
+  }
+
+  ~RocksDBWalIteratorHandle() {
+    current.writeBatchPtr.reset();
+    iter.reset();
+    if (owner) {
+      release_db(owner);
+    }
+  }
+};
+
+struct RocksDBReadContextHandle {
+  rocksdb::ReadOptions options;
+  rocksdb::PinnableSlice value;
+
+  // MultiGet scratch, grown to the largest batch seen and reused
+  std::vector<rocksdb::Slice> keys;
+  std::vector<rocksdb::PinnableSlice> values;
+  std::vector<rocksdb::Status> statuses;
+};
+
+struct RocksDBPinnableSliceHandle {
+  rocksdb::PinnableSlice value;
+  RocksDBHandle* owner = nullptr;
+
+  ~RocksDBPinnableSliceHandle() {
+    // Release the pinned block before the database can be torn down
+    value.Reset();
+    if (owner) {
+      release_db(owner);
+    }
+  }
+};
+
+struct RocksDBWideColumnsHandle {
+  rocksdb::PinnableWideColumns columns;
+  RocksDBHandle* owner = nullptr;
+
+  ~RocksDBWideColumnsHandle() {
+    columns.Reset();
+    if (owner) {
+      release_db(owner);
+    }
+  }
+};
+
+struct RocksDBAttributeGroupsHandle {
+  rocksdb::PinnableAttributeGroups groups;
+  RocksDBHandle* owner = nullptr;
+
+  ~RocksDBAttributeGroupsHandle() {
+    groups.clear();
+    if (owner) {
+      release_db(owner);
+    }
+  }
+};
+
+struct RocksDBAttributeGroupIteratorHandle {
+  std::unique_ptr<rocksdb::AttributeGroupIterator> iter;
+  // Families the iterator was created over, to map groups back to refs
+  std::vector<RocksDBColumnFamilyRef> families;
+};
+
 // =============================================================================
 // MARK: - Helper Functions
 // =============================================================================
 
+static rocksdb::ColumnFamilyHandle* column_family(RocksDBRef db, RocksDBColumnFamilyRef cf) {
+  return cf ? cf->handle : db->db->DefaultColumnFamily();
+}
+
+static rocksdb::ColumnFamilyHandle* column_family(RocksDBTransactionRef txn,
+                                                  RocksDBColumnFamilyRef cf) {
+  return cf ? cf->handle : txn->default_cf;
+}
+
+static RocksDBColumnFamilyRef add_column_family(RocksDBRef db,
+                                                rocksdb::ColumnFamilyHandle* handle) {
+  auto cf = std::make_unique<RocksDBColumnFamilyHandle>();
+  cf->handle = handle;
+  cf->name = handle->GetName();
+
+  std::lock_guard<std::mutex> lock(db->cf_mutex);
+  db->column_families.push_back(std::move(cf));
+  return db->column_families.back().get();
+}
+
+static rocksdb::WideColumns make_columns(size_t num_columns,
+                                         const char* const* names, const size_t* name_lens,
+                                         const char* const* values, const size_t* value_lens) {
+  rocksdb::WideColumns columns;
+  columns.reserve(num_columns);
+  for (size_t i = 0; i < num_columns; i++) {
+    columns.emplace_back(rocksdb::Slice(names[i], name_lens[i]),
+                         rocksdb::Slice(values[i], value_lens[i]));
+  }
+  return columns;
+}
+
+// Split the flattened columns of num_groups groups (column_counts[i] each)
+static rocksdb::AttributeGroups make_attribute_groups(
+    size_t num_groups, const RocksDBColumnFamilyRef* families, const size_t* column_counts,
+    const char* const* names, const size_t* name_lens,
+    const char* const* values, const size_t* value_lens) {
+  rocksdb::AttributeGroups groups;
+  groups.reserve(num_groups);
+  size_t offset = 0;
+  for (size_t i = 0; i < num_groups; i++) {
+    groups.emplace_back(families[i] ? families[i]->handle : nullptr,
+                        make_columns(column_counts[i], names + offset, name_lens + offset,
+                                     values + offset, value_lens + offset));
+    offset += column_counts[i];
+  }
+  return groups;
+}
+
+static const rocksdb::WideColumns* attribute_group_columns(RocksDBAttributeGroupIteratorRef iter,
+                                                           size_t group) {
+  if (!iter || !iter->iter || !iter->iter->Valid() ||
+      group >= iter->iter->attribute_groups().size()) {
+    return nullptr;
+  }
+  return &iter->iter->attribute_groups()[group].columns();
+}
+
+// User timestamps of BytewiseComparatorWithU64Ts are fixed 64-bit little-endian
+static constexpr size_t kTimestampSize = sizeof(uint64_t);
+
+static std::string encode_timestamp(uint64_t timestamp) {
+  std::string encoded(kTimestampSize, '\0');
+  for (size_t i = 0; i < kTimestampSize; i++) {
+    encoded[i] = static_cast<char>((timestamp >> (8 * i)) & 0xff);
+  }
+  return encoded;
+}
+
+static uint64_t decode_timestamp(const rocksdb::Slice& encoded) {
+  uint64_t timestamp = 0;
+  for (size_t i = 0; i < kTimestampSize && i < encoded.size(); i++) {
+    timestamp |= static_cast<uint64_t>(static_cast<unsigned char>(encoded[i])) << (8 * i);
+  }
+  return timestamp;
+}
+
 static RocksDBStatus make_status(const rocksdb::Status& s) {
-  RocksDBStatus result;
+  RocksDBStatus result{};
 
   if (s.ok()) {
     result.code = RocksDBStatusOK;
@@ -88,9 +546,16 @@ static RocksDBStatus make_status(const rocksdb::Status& s) {
     return result;
   }
 
+  result.subcode = static_cast<int>(s.subcode());
+
   // Map status codes
   if (s.IsNotFound()) {
     result.code = RocksDBStatusNotFound;
+    // Misses on the read path carry no detail; skip ToString and strdup
+    if (s.getState() == nullptr && s.subcode() == rocksdb::Status::kNone) {
+      result.message = nullptr;
+      return result;
+    }
   } else if (s.IsCorruption()) {
     result.code = RocksDBStatusCorruption;
   } else if (s.IsNotSupported()) {
@@ -126,740 +591,7633 @@ static RocksDBStatus make_status(const rocksdb::Status& s) {
   return result;
 }
 
+// Option handles are built once on the Swift side and treated as immutable,
+// so the hot paths reference them directly instead of copying per call.
+static const rocksdb::ReadOptions kDefaultReadOptions;
+static const rocksdb::WriteOptions kDefaultWriteOptions;
+
+static const rocksdb::ReadOptions& read_options(RocksDBReadOptionsRef opts) {
+  return opts ? opts->options : kDefaultReadOptions;
+}
+
+static const rocksdb::WriteOptions& write_options(RocksDBWriteOptionsRef opts) {
+  return opts ? opts->options : kDefaultWriteOptions;
+}
+
+// Reads of a snapshot-bound transaction default to the transaction's snapshot;
+// scratch holds the adjusted copy when one is needed
+static const rocksdb::ReadOptions& read_options(RocksDBTransactionRef txn,
+                                                RocksDBReadOptionsRef opts,
+                                                rocksdb::ReadOptions* scratch) {
+  const rocksdb::ReadOptions& base = read_options(opts);
+  if (!txn->read_from_snapshot || base.snapshot) {
+    return base;
+  }
+  *scratch = base;
+  scratch->snapshot = txn->txn->GetSnapshot();
+  return *scratch;
+}
+
 static RocksDBStatus make_ok() {
-  RocksDBStatus result;
+  RocksDBStatus result{};
   result.code = RocksDBStatusOK;
   result.message = nullptr;
   return result;
 }
 
-// =============================================================================
-// MARK: - Memory Management
-// =============================================================================
-
-void rocksdb_free_string(char* str) {
-  free(str);
-}
-
-void rocksdb_free_data(void* data) {
-  free(data);
+// Hand batched lookup results to the caller as pinned handles, retaining
+// owner (if any) once per value
+static void export_multi_get(std::vector<rocksdb::PinnableSlice>& values,
+                             const std::vector<rocksdb::Status>& statuses,
+                             RocksDBHandle* owner,
+                             RocksDBPinnableSliceRef* values_out,
+                             RocksDBStatus* statuses_out) {
+  for (size_t i = 0; i < values.size(); i++) {
+    if (statuses[i].ok()) {
+      auto handle = new RocksDBPinnableSliceHandle();
+      handle->value = std::move(values[i]);
+      if (owner) {
+        retain_db(owner);
+        handle->owner = owner;
+      }
+      values_out[i] = handle;
+      statuses_out[i] = make_ok();
+    } else if (statuses[i].IsNotFound()) {
+      // Misses are expected in a batch; skip the message allocation
+      statuses_out[i].code = RocksDBStatusNotFound;
+      statuses_out[i].message = nullptr;
+    } else {
+      statuses_out[i] = make_status(statuses[i]);
+    }
+  }
 }
 
 // =============================================================================
-// MARK: - Database Options
+// MARK: - Call Tracing Internals
 // =============================================================================
 
-RocksDBOptionsRef rocksdb_options_create(void) {
-  return new RocksDBOptionsHandle();
-}
+#ifdef ROCKSDB_BRIDGE_DISABLE_TRACING
+static constexpr bool kTracingCompiled = false;
+#else
+static constexpr bool kTracingCompiled = true;
+#endif
 
-void rocksdb_options_destroy(RocksDBOptionsRef opts) {
-  delete opts;
-}
+static std::atomic<bool> g_tracing_enabled{false};
 
-void rocksdb_options_set_create_if_missing(RocksDBOptionsRef opts, int value) {
-  opts->options.create_if_missing = (value != 0);
+static bool tracing_active() {
+  return kTracingCompiled && g_tracing_enabled.load(std::memory_order_relaxed);
 }
 
-void rocksdb_options_set_error_if_exists(RocksDBOptionsRef opts, int value) {
-  opts->options.error_if_exists = (value != 0);
+static uint64_t trace_clock() {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count());
 }
 
-void rocksdb_options_set_paranoid_checks(RocksDBOptionsRef opts, int value) {
-  opts->options.paranoid_checks = (value != 0);
-}
+struct TraceCounters {
+  std::atomic<uint64_t> calls[RocksDBTraceOpCount][RocksDBTraceLayerCount]{};
+  std::atomic<uint64_t> nanos[RocksDBTraceOpCount][RocksDBTraceLayerCount]{};
+  std::atomic<uint64_t> buckets[RocksDBTraceOpCount][RocksDBTraceLayerCount][ROCKSDB_TRACE_BUCKETS]{};
+};
 
-void rocksdb_options_set_compression(RocksDBOptionsRef opts, int type) {
-  opts->options.compression = static_cast<rocksdb::CompressionType>(type);
-}
+// Counters of live threads, plus the folded totals of exited ones and the
+// totals at the last reset. Counters only ever grow, so readers never race
+// the owning thread's plain load/store increments.
+struct TraceRegistry {
+  std::mutex mutex;
+  std::vector<TraceCounters*> live;
+  TraceCounters retired;
+  TraceCounters baseline;
+};
 
-void rocksdb_options_set_write_buffer_size(RocksDBOptionsRef opts, size_t size) {
-  opts->options.write_buffer_size = size;
+static TraceRegistry& trace_registry() {
+  // Leaked so threads exiting during static destruction can still fold in
+  static TraceRegistry* registry = new TraceRegistry();
+  return *registry;
 }
 
-void rocksdb_options_set_max_write_buffer_number(RocksDBOptionsRef opts, int value) {
-  opts->options.max_write_buffer_number = value;
+static void add_counters(TraceCounters& into, const TraceCounters& from) {
+  for (int op = 0; op < RocksDBTraceOpCount; op++) {
+    for (int layer = 0; layer < RocksDBTraceLayerCount; layer++) {
+      into.calls[op][layer].fetch_add(from.calls[op][layer].load(std::memory_order_relaxed),
+                                      std::memory_order_relaxed);
+      into.nanos[op][layer].fetch_add(from.nanos[op][layer].load(std::memory_order_relaxed),
+                                      std::memory_order_relaxed);
+      for (int b = 0; b < ROCKSDB_TRACE_BUCKETS; b++) {
+        into.buckets[op][layer][b].fetch_add(
+            from.buckets[op][layer][b].load(std::memory_order_relaxed), std::memory_order_relaxed);
+      }
+    }
+  }
 }
 
-void rocksdb_options_set_max_open_files(RocksDBOptionsRef opts, int value) {
-  opts->options.max_open_files = value;
-}
+struct TraceSlot {
+  TraceCounters* counters = nullptr;
 
-void rocksdb_options_set_max_background_compactions(RocksDBOptionsRef opts, int value) {
-  opts->options.max_background_compactions = value;
-}
+  ~TraceSlot() {
+    if (!counters) {
+      return;
+    }
+    TraceRegistry& registry = trace_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    add_counters(registry.retired, *counters);
+    registry.live.erase(std::find(registry.live.begin(), registry.live.end(), counters));
+    delete counters;
+  }
+};
 
-void rocksdb_options_set_max_background_flushes(RocksDBOptionsRef opts, int value) {
-  opts->options.max_background_flushes = value;
-}
+static thread_local TraceSlot t_trace_slot;
 
-void rocksdb_options_set_level0_file_num_compaction_trigger(RocksDBOptionsRef opts, int value) {
-  opts->options.level0_file_num_compaction_trigger = value;
+static TraceCounters& thread_trace_counters() {
+  if (!t_trace_slot.counters) {
+    auto counters = new TraceCounters();
+    TraceRegistry& registry = trace_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.live.push_back(counters);
+    t_trace_slot.counters = counters;
+  }
+  return *t_trace_slot.counters;
 }
 
-void rocksdb_options_set_level0_slowdown_writes_trigger(RocksDBOptionsRef opts, int value) {
-  opts->options.level0_slowdown_writes_trigger = value;
+// Only the owning thread writes its counters, so a plain load/store pair
+// replaces a locked read-modify-write
+static void bump(std::atomic<uint64_t>& counter, uint64_t delta) {
+  counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
 }
 
-void rocksdb_options_set_level0_stop_writes_trigger(RocksDBOptionsRef opts, int value) {
-  opts->options.level0_stop_writes_trigger = value;
+static void trace_record(int op, int layer, uint64_t nanos) {
+  TraceCounters& counters = thread_trace_counters();
+  int bucket = std::max(0, static_cast<int>(std::bit_width(nanos)) - 1);
+  bucket = std::min(bucket, ROCKSDB_TRACE_BUCKETS - 1);
+  bump(counters.calls[op][layer], 1);
+  bump(counters.nanos[op][layer], nanos);
+  bump(counters.buckets[op][layer][bucket], 1);
 }
 
-void rocksdb_options_set_target_file_size_base(RocksDBOptionsRef opts, uint64_t size) {
-  opts->options.target_file_size_base = size;
-}
+// Times a bridge call from construction to destruction; engine() times the
+// RocksDB call made inside it
+class TraceScope {
+ public:
+  explicit TraceScope(RocksDBTraceOp op) : op_(op), active_(tracing_active()) {
+    if (active_) {
+      start_ = trace_clock();
+    }
+  }
 
-void rocksdb_options_set_max_bytes_for_level_base(RocksDBOptionsRef opts, uint64_t size) {
-  opts->options.max_bytes_for_level_base = size;
-}
+  ~TraceScope() {
+    if (active_) {
+      trace_record(op_, RocksDBTraceLayerBridge, trace_clock() - start_);
+    }
+  }
 
-void rocksdb_options_enable_statistics(RocksDBOptionsRef opts) {
-  opts->options.statistics = rocksdb::CreateDBStatistics();
-}
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
 
-void rocksdb_options_optimize_for_point_lookup(RocksDBOptionsRef opts, uint64_t block_cache_size_mb) {
-  opts->options.OptimizeForPointLookup(block_cache_size_mb);
-}
+  template <typename Fn>
+  decltype(auto) engine(Fn&& fn) {
+    if (!active_) {
+      return fn();
+    }
+    struct EngineTimer {
+      RocksDBTraceOp op;
+      uint64_t start = trace_clock();
+      ~EngineTimer() { trace_record(op, RocksDBTraceLayerEngine, trace_clock() - start); }
+    } timer{op_};
+    return fn();
+  }
 
-void rocksdb_options_optimize_level_style_compaction(RocksDBOptionsRef opts, uint64_t memtable_memory_budget) {
-  opts->options.OptimizeLevelStyleCompaction(memtable_memory_budget);
-}
+  bool active() const { return active_; }
+
+  // Record engine time accumulated across several RocksDB calls as one call
+  void record_engine(uint64_t nanos) {
+    if (active_) {
+      trace_record(op_, RocksDBTraceLayerEngine, nanos);
+    }
+  }
+
+ private:
+  RocksDBTraceOp op_;
+  bool active_;
+  uint64_t start_ = 0;
+};
 
 // =============================================================================
-// MARK: - Read Options
+// MARK: - Built-in Merge Operators
 // =============================================================================
 
-RocksDBReadOptionsRef rocksdb_read_options_create(void) {
-  return new RocksDBReadOptionsHandle();
-}
+// Adds little-endian 64-bit unsigned integers; malformed operands count as 0
+class UInt64AddOperator : public rocksdb::AssociativeMergeOperator {
+ public:
+  bool Merge(const rocksdb::Slice& /*key*/, const rocksdb::Slice* existing_value,
+             const rocksdb::Slice& value, std::string* new_value,
+             rocksdb::Logger* /*logger*/) const override {
+    uint64_t result = Decode(value);
+    if (existing_value) {
+      result += Decode(*existing_value);
+    }
+    char buf[sizeof(uint64_t)];
+    for (size_t i = 0; i < sizeof(uint64_t); i++) {
+      buf[i] = static_cast<char>((result >> (8 * i)) & 0xff);
+    }
+    new_value->assign(buf, sizeof(buf));
+    return true;
+  }
 
-void rocksdb_read_options_destroy(RocksDBReadOptionsRef opts) {
-  delete opts;
-}
+  const char* Name() const override { return "RocksDBSwift.UInt64Add"; }
 
-void rocksdb_read_options_set_verify_checksums(RocksDBReadOptionsRef opts, int value) {
-  opts->options.verify_checksums = (value != 0);
-}
+ private:
+  static uint64_t Decode(const rocksdb::Slice& slice) {
+    if (slice.size() != sizeof(uint64_t)) {
+      return 0;
+    }
+    uint64_t result = 0;
+    for (size_t i = 0; i < sizeof(uint64_t); i++) {
+      result |= static_cast<uint64_t>(static_cast<unsigned char>(slice[i])) << (8 * i);
+    }
+    return result;
+  }
+};
 
-void rocksdb_read_options_set_fill_cache(RocksDBReadOptionsRef opts, int value) {
-  opts->options.fill_cache = (value != 0);
-}
+// Appends operands to the existing value, separated by a delimiter
+class StringAppendOperator : public rocksdb::AssociativeMergeOperator {
+ public:
+  explicit StringAppendOperator(std::string delimiter) : delimiter_(std::move(delimiter)) {}
+
+  bool Merge(const rocksdb::Slice& /*key*/, const rocksdb::Slice* existing_value,
+             const rocksdb::Slice& value, std::string* new_value,
+             rocksdb::Logger* /*logger*/) const override {
+    new_value->clear();
+    if (existing_value) {
+      new_value->reserve(existing_value->size() + delimiter_.size() + value.size());
+      new_value->assign(existing_value->data(), existing_value->size());
+      new_value->append(delimiter_);
+    }
+    new_value->append(value.data(), value.size());
+    return true;
+  }
 
-void rocksdb_read_options_set_snapshot(RocksDBReadOptionsRef opts, RocksDBSnapshotRef snapshot) {
-  opts->options.snapshot = snapshot ? snapshot->snapshot : nullptr;
-}
+  const char* Name() const override { return "RocksDBSwift.StringAppend"; }
 
-void rocksdb_read_options_set_prefix_same_as_start(RocksDBReadOptionsRef opts, int value) {
-  opts->options.prefix_same_as_start = (value != 0);
-}
+ private:
+  std::string delimiter_;
+};
 
-// =============================================================================
-// MARK: - Write Options
-// =============================================================================
+// Keeps the bytewise-largest value
+class MaxOperator : public rocksdb::AssociativeMergeOperator {
+ public:
+  bool Merge(const rocksdb::Slice& /*key*/, const rocksdb::Slice* existing_value,
+             const rocksdb::Slice& value, std::string* new_value,
+             rocksdb::Logger* /*logger*/) const override {
+    if (existing_value && existing_value->compare(value) >= 0) {
+      new_value->assign(existing_value->data(), existing_value->size());
+    } else {
+      new_value->assign(value.data(), value.size());
+    }
+    return true;
+  }
+
+  const char* Name() const override { return "RocksDBSwift.Max"; }
+};
+
+// =============================================================================
+// MARK: - Built-in Comparators
+// =============================================================================
+
+// Orders keys by their first 8 bytes (a big-endian uint64) descending, then
+// the remainder bytewise, so newest-first scans over time-prefixed keys run
+// forward. Keys shorter than 8 bytes use their whole key as the prefix.
+class DescendingU64PrefixComparator : public rocksdb::Comparator {
+ public:
+  int Compare(const rocksdb::Slice& a, const rocksdb::Slice& b) const override {
+    rocksdb::Slice prefix_a(a.data(), std::min(a.size(), kPrefixSize));
+    rocksdb::Slice prefix_b(b.data(), std::min(b.size(), kPrefixSize));
+    int c = prefix_b.compare(prefix_a);
+    if (c != 0) {
+      return c;
+    }
+    rocksdb::Slice rest_a(a.data() + prefix_a.size(), a.size() - prefix_a.size());
+    rocksdb::Slice rest_b(b.data() + prefix_b.size(), b.size() - prefix_b.size());
+    return rest_a.compare(rest_b);
+  }
+
+  const char* Name() const override { return "RocksDBSwift.DescendingU64Prefix"; }
+
+  // Index keys are left unshortened; correct for any order
+  void FindShortestSeparator(std::string* /*start*/,
+                             const rocksdb::Slice& /*limit*/) const override {}
+  void FindShortSuccessor(std::string* /*key*/) const override {}
+
+ private:
+  static constexpr size_t kPrefixSize = sizeof(uint64_t);
+};
+
+static const rocksdb::Comparator* descending_u64_prefix_comparator() {
+  static const DescendingU64PrefixComparator comparator;
+  return &comparator;
+}
+
+// =============================================================================
+// MARK: - Built-in Compaction Filters
+// =============================================================================
+
+// Rules applied by BridgeCompactionFilter; each is disabled by default
+struct CompactionFilterConfig {
+  // Sorted, with prefixes covered by a shorter one removed, so the only
+  // candidate prefix of a key is its predecessor in the list
+  std::shared_ptr<const std::vector<std::string>> dropped_prefixes =
+    std::make_shared<const std::vector<std::string>>();
+
+  // Drop values whose unsigned header field is below threshold
+  size_t header_offset = 0;
+  size_t header_width = 0;  // 0 disables, otherwise 1...8 bytes
+  bool header_big_endian = true;
+  uint64_t header_threshold = 0;
+
+  // Keep the first max_versions keys per key prefix, in key order
+  size_t version_prefix_len = 0;
+  size_t max_versions = 0;  // 0 disables
+};
+
+// Shared by the options handle and every filter factory it was installed in
+struct CompactionFilterState {
+  std::mutex mutex;
+  CompactionFilterConfig config;
+  std::atomic<uint64_t> dropped{0};
+
+  CompactionFilterConfig snapshot() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return config;
+  }
+};
+
+class BridgeCompactionFilter : public rocksdb::CompactionFilter {
+ public:
+  BridgeCompactionFilter(std::shared_ptr<CompactionFilterState> state,
+                         CompactionFilterConfig config)
+    : state_(std::move(state)), config_(std::move(config)) {}
+
+  bool Filter(int /*level*/, const rocksdb::Slice& key, const rocksdb::Slice& existing_value,
+              std::string* /*new_value*/, bool* /*value_changed*/) const override {
+    bool drop = HasDroppedPrefix(key) || HeaderBelowThreshold(existing_value) ||
+                ExceedsMaxVersions(key);
+    if (drop) {
+      state_->dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    return drop;
+  }
+
+  bool FilterMergeOperand(int /*level*/, const rocksdb::Slice& key,
+                          const rocksdb::Slice& /*operand*/) const override {
+    bool drop = HasDroppedPrefix(key);
+    if (drop) {
+      state_->dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    return drop;
+  }
+
+  const char* Name() const override { return "RocksDBSwift.CompactionFilter"; }
+
+ private:
+  bool HasDroppedPrefix(const rocksdb::Slice& key) const {
+    const std::vector<std::string>& prefixes = *config_.dropped_prefixes;
+    if (prefixes.empty()) {
+      return false;
+    }
+    auto it = std::upper_bound(prefixes.begin(), prefixes.end(), key,
+                               [](const rocksdb::Slice& k, const std::string& p) {
+                                 return k.compare(rocksdb::Slice(p)) < 0;
+                               });
+    return it != prefixes.begin() && key.starts_with(rocksdb::Slice(*std::prev(it)));
+  }
+
+  bool HeaderBelowThreshold(const rocksdb::Slice& value) const {
+    if (config_.header_width == 0 ||
+        value.size() < config_.header_offset + config_.header_width) {
+      return false;
+    }
+    uint64_t field = 0;
+    for (size_t i = 0; i < config_.header_width; i++) {
+      uint64_t byte = static_cast<unsigned char>(value[config_.header_offset + i]);
+      field |= config_.header_big_endian
+        ? byte << (8 * (config_.header_width - 1 - i))
+        : byte << (8 * i);
+    }
+    return field < config_.header_threshold;
+  }
+
+  // A subcompaction sees its keys in order, so versions of one prefix are
+  // adjacent; only versions within the same compaction are counted.
+  bool ExceedsMaxVersions(const rocksdb::Slice& key) const {
+    if (config_.max_versions == 0) {
+      return false;
+    }
+    rocksdb::Slice prefix(key.data(), std::min(key.size(), config_.version_prefix_len));
+    if (prefix != rocksdb::Slice(current_prefix_)) {
+      current_prefix_.assign(prefix.data(), prefix.size());
+      versions_seen_ = 0;
+    }
+    return ++versions_seen_ > config_.max_versions;
+  }
+
+  std::shared_ptr<CompactionFilterState> state_;
+  CompactionFilterConfig config_;
+  mutable std::string current_prefix_;
+  mutable size_t versions_seen_ = 0;
+};
+
+// Creates one filter per (sub)compaction with the rules current at its start
+class BridgeCompactionFilterFactory : public rocksdb::CompactionFilterFactory {
+ public:
+  explicit BridgeCompactionFilterFactory(std::shared_ptr<CompactionFilterState> state)
+    : state_(std::move(state)) {}
+
+  std::unique_ptr<rocksdb::CompactionFilter> CreateCompactionFilter(
+      const rocksdb::CompactionFilter::Context& /*context*/) override {
+    return std::make_unique<BridgeCompactionFilter>(state_, state_->snapshot());
+  }
+
+  const char* Name() const override { return "RocksDBSwift.CompactionFilterFactory"; }
+
+ private:
+  std::shared_ptr<CompactionFilterState> state_;
+};
+
+// Drops WAL records whose keys all start with a skipped prefix and stops
+// replay after a sequence number
+class BridgeWALFilter : public rocksdb::WalFilter {
+ public:
+  BridgeWALFilter(std::vector<std::string> skip_prefixes, uint64_t stop_after_sequence)
+    : skip_prefixes_(std::move(skip_prefixes)), stop_after_sequence_(stop_after_sequence) {}
+
+  WalProcessingOption LogRecordFound(unsigned long long /*log_number*/,
+                                     const std::string& /*log_file_name*/,
+                                     const rocksdb::WriteBatch& batch,
+                                     rocksdb::WriteBatch* /*new_batch*/,
+                                     bool* batch_changed) override {
+    *batch_changed = false;
+
+    // The WriteBatch header starts with its fixed64 sequence number
+    const std::string& rep = batch.Data();
+    if (stop_after_sequence_ != UINT64_MAX && rep.size() >= 8) {
+      uint64_t sequence = 0;
+      for (int i = 7; i >= 0; i--) {
+        sequence = (sequence << 8) | static_cast<uint8_t>(rep[i]);
+      }
+      if (sequence > stop_after_sequence_) {
+        return WalProcessingOption::kStopReplay;
+      }
+    }
+
+    if (skip_prefixes_.empty()) {
+      return WalProcessingOption::kContinueProcessing;
+    }
+    // Records are replayed or skipped whole: rebuilding a partial batch
+    // needs column family handles, which do not exist yet during recovery
+    PrefixMatcher matcher(skip_prefixes_);
+    if (batch.Iterate(&matcher).ok() && matcher.all_skipped && matcher.operations > 0) {
+      return WalProcessingOption::kIgnoreCurrentRecord;
+    }
+    return WalProcessingOption::kContinueProcessing;
+  }
+
+  const char* Name() const override { return "RocksDBSwift.WalFilter"; }
+
+ private:
+  // Checks whether every data operation in a batch has a skipped key
+  class PrefixMatcher : public rocksdb::WriteBatch::Handler {
+   public:
+    explicit PrefixMatcher(const std::vector<std::string>& prefixes) : prefixes_(prefixes) {}
+
+    bool all_skipped = true;
+    size_t operations = 0;
+
+    rocksdb::Status PutCF(uint32_t, const rocksdb::Slice& key, const rocksdb::Slice&) override {
+      return Check(key);
+    }
+    rocksdb::Status TimedPutCF(uint32_t, const rocksdb::Slice& key, const rocksdb::Slice&,
+                               uint64_t) override {
+      return Check(key);
+    }
+    rocksdb::Status PutEntityCF(uint32_t, const rocksdb::Slice& key, const rocksdb::Slice&) override {
+      return Check(key);
+    }
+    rocksdb::Status DeleteCF(uint32_t, const rocksdb::Slice& key) override {
+      return Check(key);
+    }
+    rocksdb::Status SingleDeleteCF(uint32_t, const rocksdb::Slice& key) override {
+      return Check(key);
+    }
+    rocksdb::Status MergeCF(uint32_t, const rocksdb::Slice& key, const rocksdb::Slice&) override {
+      return Check(key);
+    }
+    // Range deletions and transaction markers keep the record (the default
+    // handlers of the remaining operations fail the iteration, which does too)
+    rocksdb::Status DeleteRangeCF(uint32_t, const rocksdb::Slice&, const rocksdb::Slice&) override {
+      all_skipped = false;
+      return rocksdb::Status::OK();
+    }
+    bool Continue() override { return all_skipped; }
+
+   private:
+    rocksdb::Status Check(const rocksdb::Slice& key) {
+      operations++;
+      bool matched = std::any_of(prefixes_.begin(), prefixes_.end(),
+                                 [&](const std::string& prefix) { return key.starts_with(prefix); });
+      if (!matched) {
+        all_skipped = false;
+      }
+      return rocksdb::Status::OK();
+    }
+
+    const std::vector<std::string>& prefixes_;
+  };
+
+  std::vector<std::string> skip_prefixes_;
+  uint64_t stop_after_sequence_;
+};
+
+// =============================================================================
+// MARK: - Memory Management
+// =============================================================================
+
+void rocksdb_free_string(char* str) {
+  free(str);
+}
+
+void rocksdb_free_data(void* data) {
+  free(data);
+}
+
+// =============================================================================
+// MARK: - Database Options
+// =============================================================================
+
+RocksDBOptionsRef rocksdb_options_create(void) {
+  return new RocksDBOptionsHandle();
+}
+
+void rocksdb_options_destroy(RocksDBOptionsRef opts) {
+  delete opts;
+}
+
+void rocksdb_options_set_create_if_missing(RocksDBOptionsRef opts, int value) {
+  opts->options.create_if_missing = (value != 0);
+}
+
+void rocksdb_options_set_error_if_exists(RocksDBOptionsRef opts, int value) {
+  opts->options.error_if_exists = (value != 0);
+}
+
+void rocksdb_options_set_create_missing_column_families(RocksDBOptionsRef opts, int value) {
+  opts->options.create_missing_column_families = (value != 0);
+}
+
+void rocksdb_options_set_paranoid_checks(RocksDBOptionsRef opts, int value) {
+  opts->options.paranoid_checks = (value != 0);
+}
+
+void rocksdb_options_set_compression(RocksDBOptionsRef opts, int type) {
+  opts->options.compression = static_cast<rocksdb::CompressionType>(type);
+}
+
+void rocksdb_options_set_compression_per_level(RocksDBOptionsRef opts, const int* types, size_t count) {
+  opts->options.compression_per_level.clear();
+  for (size_t i = 0; i < count; i++) {
+    opts->options.compression_per_level.push_back(static_cast<rocksdb::CompressionType>(types[i]));
+  }
+}
+
+void rocksdb_options_set_bottommost_compression(RocksDBOptionsRef opts, int type) {
+  opts->options.bottommost_compression = type < 0
+    ? rocksdb::kDisableCompressionOption
+    : static_cast<rocksdb::CompressionType>(type);
+}
+
+void rocksdb_options_set_compression_options(RocksDBOptionsRef opts, int bottommost, int level,
+                                             uint32_t max_dict_bytes, uint32_t zstd_max_train_bytes,
+                                             uint32_t parallel_threads, uint64_t max_dict_buffer_bytes,
+                                             int use_zstd_dict_trainer) {
+  rocksdb::CompressionOptions& target = bottommost != 0
+    ? opts->options.bottommost_compression_opts
+    : opts->options.compression_opts;
+  target.level = level;
+  target.max_dict_bytes = max_dict_bytes;
+  target.zstd_max_train_bytes = zstd_max_train_bytes;
+  target.parallel_threads = parallel_threads;
+  target.max_dict_buffer_bytes = max_dict_buffer_bytes;
+  target.use_zstd_dict_trainer = (use_zstd_dict_trainer != 0);
+  if (bottommost != 0) {
+    target.enabled = true;
+  }
+}
+
+void rocksdb_options_set_write_buffer_size(RocksDBOptionsRef opts, size_t size) {
+  opts->options.write_buffer_size = size;
+}
+
+void rocksdb_options_set_max_write_buffer_number(RocksDBOptionsRef opts, int value) {
+  opts->options.max_write_buffer_number = value;
+}
+
+void rocksdb_options_set_max_open_files(RocksDBOptionsRef opts, int value) {
+  opts->options.max_open_files = value;
+}
+
+void rocksdb_options_set_max_background_compactions(RocksDBOptionsRef opts, int value) {
+  opts->options.max_background_compactions = value;
+}
+
+void rocksdb_options_set_max_background_flushes(RocksDBOptionsRef opts, int value) {
+  opts->options.max_background_flushes = value;
+}
+
+void rocksdb_options_set_max_background_jobs(RocksDBOptionsRef opts, int value) {
+  opts->options.max_background_jobs = value;
+}
+
+void rocksdb_options_set_max_subcompactions(RocksDBOptionsRef opts, uint32_t value) {
+  opts->options.max_subcompactions = value;
+}
+
+void rocksdb_options_set_level0_file_num_compaction_trigger(RocksDBOptionsRef opts, int value) {
+  opts->options.level0_file_num_compaction_trigger = value;
+}
+
+void rocksdb_options_set_level0_slowdown_writes_trigger(RocksDBOptionsRef opts, int value) {
+  opts->options.level0_slowdown_writes_trigger = value;
+}
+
+void rocksdb_options_set_level0_stop_writes_trigger(RocksDBOptionsRef opts, int value) {
+  opts->options.level0_stop_writes_trigger = value;
+}
+
+void rocksdb_options_set_target_file_size_base(RocksDBOptionsRef opts, uint64_t size) {
+  opts->options.target_file_size_base = size;
+}
+
+void rocksdb_options_set_max_bytes_for_level_base(RocksDBOptionsRef opts, uint64_t size) {
+  opts->options.max_bytes_for_level_base = size;
+}
+
+void rocksdb_options_set_compaction_style(RocksDBOptionsRef opts, int style) {
+  switch (style) {
+    case RocksDBCompactionStyleUniversal:
+      opts->options.compaction_style = rocksdb::kCompactionStyleUniversal;
+      break;
+    case RocksDBCompactionStyleFIFO:
+      opts->options.compaction_style = rocksdb::kCompactionStyleFIFO;
+      break;
+    default:
+      opts->options.compaction_style = rocksdb::kCompactionStyleLevel;
+      break;
+  }
+}
+
+void rocksdb_options_set_universal_compaction_options(RocksDBOptionsRef opts, uint32_t size_ratio,
+                                                      uint32_t min_merge_width, uint32_t max_merge_width,
+                                                      uint32_t max_size_amplification_percent,
+                                                      int compression_size_percent, int stop_style,
+                                                      int allow_trivial_move) {
+  rocksdb::CompactionOptionsUniversal& universal = opts->options.compaction_options_universal;
+  universal.size_ratio = size_ratio;
+  universal.min_merge_width = min_merge_width;
+  universal.max_merge_width = max_merge_width;
+  universal.max_size_amplification_percent = max_size_amplification_percent;
+  universal.compression_size_percent = compression_size_percent;
+  universal.stop_style = stop_style == 1
+    ? rocksdb::kCompactionStopStyleTotalSize
+    : rocksdb::kCompactionStopStyleSimilarSize;
+  universal.allow_trivial_move = (allow_trivial_move != 0);
+}
+
+void rocksdb_options_set_fifo_compaction_options(RocksDBOptionsRef opts, uint64_t max_table_files_size,
+                                                 int allow_compaction) {
+  opts->options.compaction_options_fifo.max_table_files_size = max_table_files_size;
+  opts->options.compaction_options_fifo.allow_compaction = (allow_compaction != 0);
+}
+
+void rocksdb_options_set_level_compaction_dynamic_level_bytes(RocksDBOptionsRef opts, int value) {
+  opts->options.level_compaction_dynamic_level_bytes = (value != 0);
+}
+
+void rocksdb_options_set_max_bytes_for_level_multiplier(RocksDBOptionsRef opts, double multiplier) {
+  opts->options.max_bytes_for_level_multiplier = multiplier;
+}
+
+void rocksdb_options_set_compaction_pri(RocksDBOptionsRef opts, int pri) {
+  opts->options.compaction_pri = static_cast<rocksdb::CompactionPri>(pri);
+}
+
+void rocksdb_options_set_periodic_compaction_seconds(RocksDBOptionsRef opts, uint64_t seconds) {
+  opts->options.periodic_compaction_seconds = seconds;
+}
+
+void rocksdb_options_set_ttl(RocksDBOptionsRef opts, uint64_t seconds) {
+  opts->options.ttl = seconds;
+}
+
+void rocksdb_options_set_compact_on_deletion(RocksDBOptionsRef opts, size_t window_size,
+                                             size_t deletion_trigger, double deletion_ratio) {
+  // Replace only an earlier compact-on-deletion collector; keep the others
+  auto& factories = opts->options.table_properties_collector_factories;
+  std::erase_if(factories, [](const auto& factory) {
+    return factory && std::strcmp(factory->Name(),
+                                  rocksdb::CompactOnDeletionCollectorFactory::kClassName()) == 0;
+  });
+  if (window_size > 0) {
+    factories.push_back(
+        rocksdb::NewCompactOnDeletionCollectorFactory(window_size, deletion_trigger, deletion_ratio));
+  }
+}
+
+void rocksdb_options_set_sst_partitioner_fixed_prefix(RocksDBOptionsRef opts, size_t prefix_len) {
+  opts->options.sst_partitioner_factory =
+      prefix_len > 0 ? rocksdb::NewSstPartitionerFixedPrefixFactory(prefix_len) : nullptr;
+}
+
+static std::vector<rocksdb::DbPath> make_db_paths(const char* const* paths,
+                                                  const uint64_t* target_sizes, size_t count) {
+  std::vector<rocksdb::DbPath> result;
+  result.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    result.emplace_back(paths[i], target_sizes[i]);
+  }
+  return result;
+}
+
+void rocksdb_options_set_db_paths(RocksDBOptionsRef opts, const char* const* paths,
+                                  const uint64_t* target_sizes, size_t count) {
+  opts->options.db_paths = make_db_paths(paths, target_sizes, count);
+}
+
+void rocksdb_options_set_cf_paths(RocksDBOptionsRef opts, const char* const* paths,
+                                  const uint64_t* target_sizes, size_t count) {
+  opts->options.cf_paths = make_db_paths(paths, target_sizes, count);
+}
+
+void rocksdb_options_set_last_level_temperature(RocksDBOptionsRef opts, int temperature) {
+  opts->options.last_level_temperature = static_cast<rocksdb::Temperature>(temperature);
+}
+
+void rocksdb_options_set_preclude_last_level_data_seconds(RocksDBOptionsRef opts, uint64_t seconds) {
+  opts->options.preclude_last_level_data_seconds = seconds;
+}
+
+void rocksdb_options_set_memtable_prefix_bloom_size_ratio(RocksDBOptionsRef opts, double ratio) {
+  opts->options.memtable_prefix_bloom_size_ratio = ratio;
+}
+
+void rocksdb_options_set_memtable_whole_key_filtering(RocksDBOptionsRef opts, int value) {
+  opts->options.memtable_whole_key_filtering = (value != 0);
+}
+
+void rocksdb_options_set_memtable_huge_page_size(RocksDBOptionsRef opts, size_t size) {
+  opts->options.memtable_huge_page_size = size;
+}
+
+void rocksdb_options_set_enable_blob_files(RocksDBOptionsRef opts, int value) {
+  opts->options.enable_blob_files = (value != 0);
+}
+
+void rocksdb_options_set_min_blob_size(RocksDBOptionsRef opts, uint64_t size) {
+  opts->options.min_blob_size = size;
+}
+
+void rocksdb_options_set_blob_file_size(RocksDBOptionsRef opts, uint64_t size) {
+  opts->options.blob_file_size = size;
+}
+
+void rocksdb_options_set_blob_compression(RocksDBOptionsRef opts, int type) {
+  opts->options.blob_compression_type = static_cast<rocksdb::CompressionType>(type);
+}
+
+void rocksdb_options_set_enable_blob_garbage_collection(RocksDBOptionsRef opts, int value) {
+  opts->options.enable_blob_garbage_collection = (value != 0);
+}
+
+void rocksdb_options_set_blob_garbage_collection_age_cutoff(RocksDBOptionsRef opts,
+                                                            double cutoff) {
+  opts->options.blob_garbage_collection_age_cutoff = cutoff;
+}
+
+void rocksdb_options_set_blob_cache(RocksDBOptionsRef opts, RocksDBCacheRef cache) {
+  opts->options.blob_cache = cache ? cache->cache : nullptr;
+}
+
+void rocksdb_options_set_row_cache(RocksDBOptionsRef opts, RocksDBCacheRef cache) {
+  opts->options.row_cache = cache ? cache->cache : nullptr;
+}
+
+void rocksdb_options_set_manual_wal_flush(RocksDBOptionsRef opts, int value) {
+  opts->options.manual_wal_flush = (value != 0);
+}
+
+void rocksdb_options_set_wal_bytes_per_sync(RocksDBOptionsRef opts, uint64_t bytes) {
+  opts->options.wal_bytes_per_sync = bytes;
+}
+
+void rocksdb_options_set_wal_recovery_mode(RocksDBOptionsRef opts, int mode) {
+  opts->options.wal_recovery_mode = static_cast<rocksdb::WALRecoveryMode>(mode);
+}
+
+void rocksdb_options_set_wal_filter(RocksDBOptionsRef opts,
+                                    size_t num_prefixes,
+                                    const char* const* skip_prefixes,
+                                    const size_t* skip_prefix_lens,
+                                    uint64_t stop_after_sequence) {
+  if (num_prefixes == 0 && stop_after_sequence == UINT64_MAX) {
+    opts->wal_filter.reset();
+    opts->options.wal_filter = nullptr;
+    return;
+  }
+
+  std::vector<std::string> prefixes;
+  prefixes.reserve(num_prefixes);
+  for (size_t i = 0; i < num_prefixes; i++) {
+    prefixes.emplace_back(skip_prefixes[i], skip_prefix_lens[i]);
+  }
+  opts->wal_filter = std::make_shared<BridgeWALFilter>(std::move(prefixes), stop_after_sequence);
+  opts->options.wal_filter = opts->wal_filter.get();
+}
+
+void rocksdb_options_set_wal_ttl_seconds(RocksDBOptionsRef opts, uint64_t seconds) {
+  opts->options.WAL_ttl_seconds = seconds;
+}
+
+void rocksdb_options_set_wal_size_limit_mb(RocksDBOptionsRef opts, uint64_t megabytes) {
+  opts->options.WAL_size_limit_MB = megabytes;
+}
+
+void rocksdb_options_set_bytes_per_sync(RocksDBOptionsRef opts, uint64_t bytes) {
+  opts->options.bytes_per_sync = bytes;
+}
+
+void rocksdb_options_set_use_direct_reads(RocksDBOptionsRef opts, int value) {
+  opts->options.use_direct_reads = (value != 0);
+}
+
+void rocksdb_options_set_use_direct_io_for_flush_and_compaction(RocksDBOptionsRef opts, int value) {
+  opts->options.use_direct_io_for_flush_and_compaction = (value != 0);
+}
+
+void rocksdb_options_set_compaction_readahead_size(RocksDBOptionsRef opts, size_t size) {
+  opts->options.compaction_readahead_size = size;
+}
+
+void rocksdb_options_set_allow_mmap_reads(RocksDBOptionsRef opts, int value) {
+  opts->options.allow_mmap_reads = (value != 0);
+}
+
+void rocksdb_options_set_allow_mmap_writes(RocksDBOptionsRef opts, int value) {
+  opts->options.allow_mmap_writes = (value != 0);
+}
+
+RocksDBStatus rocksdb_probe_direct_io(const char* dir) {
+  // Write a small file with buffered I/O, then reopen it the way RocksDB
+  // reads SST files with use_direct_reads
+  rocksdb::Env* env = rocksdb::Env::Default();
+  std::string probe = std::string(dir) + "/.direct_io_probe";
+  rocksdb::EnvOptions buffered;
+  std::unique_ptr<rocksdb::WritableFile> writer;
+  rocksdb::Status s = env->NewWritableFile(probe, &writer, buffered);
+  if (s.ok()) {
+    s = writer->Append(std::string(4096, '\0'));
+    if (s.ok()) s = writer->Close();
+  }
+  if (s.ok()) {
+    rocksdb::EnvOptions direct;
+    direct.use_direct_reads = true;
+    std::unique_ptr<rocksdb::RandomAccessFile> reader;
+    s = env->NewRandomAccessFile(probe, &reader, direct);
+  }
+  env->DeleteFile(probe).PermitUncheckedError();
+  return make_status(s);
+}
+
+void rocksdb_options_set_wal_compression(RocksDBOptionsRef opts, int type) {
+  opts->options.wal_compression = static_cast<rocksdb::CompressionType>(type);
+}
+
+void rocksdb_options_set_recycle_log_file_num(RocksDBOptionsRef opts, size_t num) {
+  opts->options.recycle_log_file_num = num;
+}
+
+void rocksdb_options_set_max_total_wal_size(RocksDBOptionsRef opts, uint64_t size) {
+  opts->options.max_total_wal_size = size;
+}
+
+void rocksdb_options_set_allow_concurrent_memtable_write(RocksDBOptionsRef opts, int value) {
+  opts->options.allow_concurrent_memtable_write = (value != 0);
+}
+
+void rocksdb_options_set_enable_pipelined_write(RocksDBOptionsRef opts, int value) {
+  opts->options.enable_pipelined_write = (value != 0);
+}
+
+void rocksdb_options_set_unordered_write(RocksDBOptionsRef opts, int value) {
+  opts->options.unordered_write = (value != 0);
+}
+
+void rocksdb_options_set_enable_write_thread_adaptive_yield(RocksDBOptionsRef opts, int value) {
+  opts->options.enable_write_thread_adaptive_yield = (value != 0);
+}
+
+void rocksdb_options_set_two_write_queues(RocksDBOptionsRef opts, int value) {
+  opts->options.two_write_queues = (value != 0);
+}
+
+void rocksdb_options_set_allow_ingest_behind(RocksDBOptionsRef opts, int value) {
+  opts->options.allow_ingest_behind = (value != 0);
+}
+
+void rocksdb_options_set_max_file_opening_threads(RocksDBOptionsRef opts, int threads) {
+  opts->options.max_file_opening_threads = threads;
+}
+
+void rocksdb_options_set_skip_stats_update_on_db_open(RocksDBOptionsRef opts, int value) {
+  opts->options.skip_stats_update_on_db_open = (value != 0);
+}
+
+void rocksdb_options_set_skip_checking_sst_file_sizes_on_db_open(RocksDBOptionsRef opts, int value) {
+  opts->options.skip_checking_sst_file_sizes_on_db_open = (value != 0);
+}
+
+void rocksdb_options_set_avoid_flush_during_recovery(RocksDBOptionsRef opts, int value) {
+  opts->options.avoid_flush_during_recovery = (value != 0);
+}
+
+void rocksdb_options_set_best_efforts_recovery(RocksDBOptionsRef opts, int value) {
+  opts->options.best_efforts_recovery = (value != 0);
+}
+
+void rocksdb_options_set_write_buffer_manager(RocksDBOptionsRef opts,
+                                              RocksDBWriteBufferManagerRef manager) {
+  opts->options.write_buffer_manager = manager ? manager->manager : nullptr;
+}
+
+void rocksdb_options_set_compaction_filter(RocksDBOptionsRef opts,
+                                          RocksDBCompactionFilterRef filter) {
+  opts->options.compaction_filter_factory =
+    filter ? std::make_shared<BridgeCompactionFilterFactory>(filter->state) : nullptr;
+}
+
+void rocksdb_options_set_rate_limiter(RocksDBOptionsRef opts, RocksDBRateLimiterRef limiter) {
+  opts->options.rate_limiter = limiter ? limiter->limiter : nullptr;
+}
+
+void rocksdb_options_set_sst_file_manager(RocksDBOptionsRef opts, RocksDBSstFileManagerRef manager) {
+  opts->options.sst_file_manager = manager ? manager->manager : nullptr;
+}
+
+void rocksdb_options_enable_statistics(RocksDBOptionsRef opts) {
+  opts->options.statistics = rocksdb::CreateDBStatistics();
+}
+
+void rocksdb_options_set_statistics_level(RocksDBOptionsRef opts, int level) {
+  if (opts->options.statistics) {
+    opts->options.statistics->set_stats_level(static_cast<rocksdb::StatsLevel>(level));
+  }
+}
+
+void rocksdb_options_set_enable_thread_tracking(RocksDBOptionsRef opts, int value) {
+  opts->options.enable_thread_tracking = (value != 0);
+}
+
+void rocksdb_options_optimize_for_point_lookup(RocksDBOptionsRef opts, uint64_t block_cache_size_mb) {
+  opts->options.OptimizeForPointLookup(block_cache_size_mb);
+}
+
+void rocksdb_options_optimize_level_style_compaction(RocksDBOptionsRef opts, uint64_t memtable_memory_budget) {
+  opts->options.OptimizeLevelStyleCompaction(memtable_memory_budget);
+}
+
+void rocksdb_options_set_prefix_extractor(RocksDBOptionsRef opts, int type, size_t length) {
+  switch (type) {
+    case RocksDBPrefixExtractorFixed:
+      opts->options.prefix_extractor.reset(rocksdb::NewFixedPrefixTransform(length));
+      break;
+    case RocksDBPrefixExtractorCapped:
+      opts->options.prefix_extractor.reset(rocksdb::NewCappedPrefixTransform(length));
+      break;
+    default:
+      opts->options.prefix_extractor.reset();
+      break;
+  }
+}
+
+void rocksdb_options_set_memtable_rep(RocksDBOptionsRef opts, int type, size_t size,
+                                      int32_t height, int32_t branching) {
+  switch (type) {
+    case RocksDBMemtableRepVector:
+      opts->options.memtable_factory = std::make_shared<rocksdb::VectorRepFactory>(size);
+      break;
+    case RocksDBMemtableRepHashSkipList:
+      opts->options.memtable_factory.reset(rocksdb::NewHashSkipListRepFactory(size, height, branching));
+      break;
+    case RocksDBMemtableRepHashLinkList:
+      opts->options.memtable_factory.reset(rocksdb::NewHashLinkListRepFactory(size));
+      break;
+    default:
+      opts->options.memtable_factory = std::make_shared<rocksdb::SkipListFactory>(size);
+      return;
+  }
+  opts->options.allow_concurrent_memtable_write = false;
+}
+
+void rocksdb_options_set_comparator(RocksDBOptionsRef opts, int type) {
+  switch (type) {
+    case RocksDBComparatorBytewiseU64Timestamp:
+      opts->options.comparator = rocksdb::BytewiseComparatorWithU64Ts();
+      break;
+    case RocksDBComparatorReverseBytewise:
+      opts->options.comparator = rocksdb::ReverseBytewiseComparator();
+      break;
+    case RocksDBComparatorDescendingU64Prefix:
+      opts->options.comparator = descending_u64_prefix_comparator();
+      break;
+    default:
+      opts->options.comparator = rocksdb::BytewiseComparator();
+      break;
+  }
+}
+
+void rocksdb_options_set_merge_operator(RocksDBOptionsRef opts, int type,
+                                        const char* delimiter, size_t delimiter_len) {
+  switch (type) {
+    case RocksDBMergeOperatorUInt64Add:
+      opts->options.merge_operator = std::make_shared<UInt64AddOperator>();
+      break;
+    case RocksDBMergeOperatorStringAppend:
+      opts->options.merge_operator = std::make_shared<StringAppendOperator>(
+        delimiter ? std::string(delimiter, delimiter_len) : std::string());
+      break;
+    case RocksDBMergeOperatorMax:
+      opts->options.merge_operator = std::make_shared<MaxOperator>();
+      break;
+    default:
+      opts->options.merge_operator.reset();
+      break;
+  }
+}
+
+void rocksdb_options_set_block_based_table_factory(RocksDBOptionsRef opts,
+                                                   RocksDBTableOptionsRef table_opts) {
+  if (table_opts) {
+    opts->options.table_factory.reset(rocksdb::NewBlockBasedTableFactory(table_opts->options));
+  }
+}
+
+void rocksdb_options_set_plain_table_factory(RocksDBOptionsRef opts, uint32_t user_key_len,
+                                             int bloom_bits_per_key, double hash_table_ratio,
+                                             size_t index_sparseness, size_t huge_page_tlb_size,
+                                             int encoding, int full_scan_mode, int store_index_in_file) {
+  rocksdb::PlainTableOptions table;
+  table.user_key_len = user_key_len == 0 ? rocksdb::kPlainTableVariableLength : user_key_len;
+  table.bloom_bits_per_key = bloom_bits_per_key;
+  table.hash_table_ratio = hash_table_ratio;
+  table.index_sparseness = index_sparseness;
+  table.huge_page_tlb_size = huge_page_tlb_size;
+  table.encoding_type = encoding == 1 ? rocksdb::kPrefix : rocksdb::kPlain;
+  table.full_scan_mode = (full_scan_mode != 0);
+  table.store_index_in_file = (store_index_in_file != 0);
+  opts->options.table_factory.reset(rocksdb::NewPlainTableFactory(table));
+  opts->options.allow_mmap_reads = true;
+}
+
+void rocksdb_options_set_cuckoo_table_factory(RocksDBOptionsRef opts, double hash_table_ratio,
+                                              uint32_t max_search_depth, uint32_t cuckoo_block_size,
+                                              int identity_as_first_hash, int use_module_hash) {
+  rocksdb::CuckooTableOptions table;
+  table.hash_table_ratio = hash_table_ratio;
+  table.max_search_depth = max_search_depth;
+  table.cuckoo_block_size = cuckoo_block_size;
+  table.identity_as_first_hash = (identity_as_first_hash != 0);
+  table.use_module_hash = (use_module_hash != 0);
+  opts->options.table_factory.reset(rocksdb::NewCuckooTableFactory(table));
+  opts->options.allow_mmap_reads = true;
+}
+
+// =============================================================================
+// MARK: - Table Options
+// =============================================================================
+
+RocksDBTableOptionsRef rocksdb_table_options_create(void) {
+  return new RocksDBTableOptionsHandle();
+}
+
+void rocksdb_table_options_destroy(RocksDBTableOptionsRef opts) {
+  delete opts;
+}
+
+void rocksdb_table_options_set_bloom_filter(RocksDBTableOptionsRef opts, double bits_per_key) {
+  if (bits_per_key > 0) {
+    opts->options.filter_policy.reset(rocksdb::NewBloomFilterPolicy(bits_per_key));
+  } else {
+    opts->options.filter_policy.reset();
+  }
+}
+
+void rocksdb_table_options_set_ribbon_filter(RocksDBTableOptionsRef opts, double bits_per_key) {
+  if (bits_per_key > 0) {
+    opts->options.filter_policy.reset(rocksdb::NewRibbonFilterPolicy(bits_per_key));
+  } else {
+    opts->options.filter_policy.reset();
+  }
+}
+
+void rocksdb_table_options_set_block_cache(RocksDBTableOptionsRef opts, RocksDBCacheRef cache) {
+  opts->options.block_cache = cache ? cache->cache : nullptr;
+}
+
+void rocksdb_table_options_set_whole_key_filtering(RocksDBTableOptionsRef opts, int value) {
+  opts->options.whole_key_filtering = (value != 0);
+}
+
+void rocksdb_table_options_set_block_size(RocksDBTableOptionsRef opts, uint64_t size) {
+  opts->options.block_size = size;
+}
+
+void rocksdb_table_options_set_no_block_cache(RocksDBTableOptionsRef opts, int value) {
+  opts->options.no_block_cache = (value != 0);
+}
+
+void rocksdb_table_options_set_metadata_block_size(RocksDBTableOptionsRef opts, uint64_t size) {
+  opts->options.metadata_block_size = size;
+}
+
+void rocksdb_table_options_set_cache_index_and_filter_blocks(RocksDBTableOptionsRef opts, int value) {
+  opts->options.cache_index_and_filter_blocks = (value != 0);
+}
+
+void rocksdb_table_options_set_use_delta_encoding(RocksDBTableOptionsRef opts, int value) {
+  opts->options.use_delta_encoding = (value != 0);
+}
+
+void rocksdb_table_options_set_pin_l0_filter_and_index_blocks_in_cache(RocksDBTableOptionsRef opts, int value) {
+  opts->options.pin_l0_filter_and_index_blocks_in_cache = (value != 0);
+}
+
+void rocksdb_table_options_set_pin_top_level_index_and_filter(RocksDBTableOptionsRef opts, int value) {
+  opts->options.pin_top_level_index_and_filter = (value != 0);
+}
+
+void rocksdb_table_options_set_index_type(RocksDBTableOptionsRef opts, int type) {
+  opts->options.index_type = static_cast<rocksdb::BlockBasedTableOptions::IndexType>(type);
+}
+
+void rocksdb_table_options_set_partition_filters(RocksDBTableOptionsRef opts, int value) {
+  opts->options.partition_filters = (value != 0);
+}
+
+void rocksdb_table_options_set_format_version(RocksDBTableOptionsRef opts, int version) {
+  opts->options.format_version = static_cast<uint32_t>(version);
+}
+
+void rocksdb_table_options_set_data_block_hash_index(RocksDBTableOptionsRef opts, int enabled,
+                                                     double util_ratio) {
+  opts->options.data_block_index_type = enabled
+    ? rocksdb::BlockBasedTableOptions::kDataBlockBinaryAndHash
+    : rocksdb::BlockBasedTableOptions::kDataBlockBinarySearch;
+  opts->options.data_block_hash_table_util_ratio = util_ratio;
+}
+
+void rocksdb_table_options_set_auto_readahead(RocksDBTableOptionsRef opts,
+                                              uint64_t num_file_reads,
+                                              size_t initial_size, size_t max_size) {
+  opts->options.num_file_reads_for_auto_readahead = num_file_reads;
+  opts->options.initial_auto_readahead_size = initial_size;
+  opts->options.max_auto_readahead_size = max_size;
+}
+
+// =============================================================================
+// MARK: - Cache
+// =============================================================================
+
+RocksDBCacheRef rocksdb_cache_create_lru(size_t capacity, int num_shard_bits,
+                                         int strict_capacity_limit,
+                                         double high_pri_pool_ratio) {
+  auto handle = new RocksDBCacheHandle();
+  handle->cache = rocksdb::LRUCacheOptions(capacity, num_shard_bits,
+                                           strict_capacity_limit != 0,
+                                           high_pri_pool_ratio)
+                    .MakeSharedCache();
+  return handle;
+}
+
+RocksDBCacheRef rocksdb_cache_create_hyper_clock(size_t capacity, size_t estimated_entry_charge,
+                                                 int num_shard_bits,
+                                                 int strict_capacity_limit) {
+  auto handle = new RocksDBCacheHandle();
+  handle->cache = rocksdb::HyperClockCacheOptions(capacity, estimated_entry_charge,
+                                                  num_shard_bits,
+                                                  strict_capacity_limit != 0)
+                    .MakeSharedCache();
+  return handle;
+}
+
+RocksDBCacheRef rocksdb_cache_create_lru_with_secondary(size_t capacity, int num_shard_bits,
+                                                        int strict_capacity_limit,
+                                                        double high_pri_pool_ratio,
+                                                        size_t secondary_capacity,
+                                                        int compression_type) {
+  rocksdb::CompressedSecondaryCacheOptions secondary_options;
+  secondary_options.capacity = secondary_capacity;
+  secondary_options.num_shard_bits = num_shard_bits;
+  secondary_options.compression_type = static_cast<rocksdb::CompressionType>(compression_type);
+
+  auto handle = new RocksDBCacheHandle();
+  handle->secondary = secondary_options.MakeSharedSecondaryCache();
+  rocksdb::LRUCacheOptions options(capacity, num_shard_bits, strict_capacity_limit != 0,
+                                   high_pri_pool_ratio);
+  options.secondary_cache = handle->secondary;
+  handle->cache = options.MakeSharedCache();
+  return handle;
+}
+
+RocksDBCacheRef rocksdb_cache_create_tiered(size_t total_capacity, double compressed_secondary_ratio,
+                                           int primary_type, size_t estimated_entry_charge,
+                                           int num_shard_bits, double high_pri_pool_ratio,
+                                           int adm_policy, int compression_type) {
+  // NewTieredCache copies the primary options, so they may live on the stack
+  rocksdb::LRUCacheOptions lru;
+  lru.num_shard_bits = num_shard_bits;
+  lru.high_pri_pool_ratio = high_pri_pool_ratio;
+  rocksdb::HyperClockCacheOptions hyper_clock(0, estimated_entry_charge, num_shard_bits);
+
+  rocksdb::TieredCacheOptions tiered;
+  if (primary_type == 1) {
+    tiered.cache_type = rocksdb::PrimaryCacheType::kCacheTypeHCC;
+    tiered.cache_opts = &hyper_clock;
+  } else {
+    tiered.cache_type = rocksdb::PrimaryCacheType::kCacheTypeLRU;
+    tiered.cache_opts = &lru;
+  }
+  tiered.adm_policy = static_cast<rocksdb::TieredAdmissionPolicy>(adm_policy);
+  tiered.comp_cache_opts.compression_type = static_cast<rocksdb::CompressionType>(compression_type);
+  tiered.total_capacity = total_capacity;
+  tiered.compressed_secondary_ratio = compressed_secondary_ratio;
+
+  std::shared_ptr<rocksdb::Cache> cache = rocksdb::NewTieredCache(tiered);
+  if (!cache) {
+    return nullptr;
+  }
+  auto handle = new RocksDBCacheHandle();
+  handle->cache = std::move(cache);
+  return handle;
+}
+
+RocksDBStatus rocksdb_cache_update_tiered(RocksDBCacheRef cache, int64_t total_capacity,
+                                          double compressed_secondary_ratio, int adm_policy) {
+  if (!cache) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Cache is null");
+    return result;
+  }
+
+  return make_status(rocksdb::UpdateTieredCache(
+    cache->cache, total_capacity,
+    compressed_secondary_ratio < 0 ? std::numeric_limits<double>::max() : compressed_secondary_ratio,
+    adm_policy < 0 ? rocksdb::TieredAdmissionPolicy::kAdmPolicyMax
+                   : static_cast<rocksdb::TieredAdmissionPolicy>(adm_policy)));
+}
+
+void rocksdb_cache_destroy(RocksDBCacheRef cache) {
+  delete cache;
+}
+
+RocksDBStatus rocksdb_dump_block_cache(RocksDBRef db, const char* file, uint64_t max_size_bytes) {
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  const rocksdb::Options options = db->db->GetOptions();
+  const auto* table = options.table_factory
+    ? options.table_factory->GetOptions<rocksdb::BlockBasedTableOptions>()
+    : nullptr;
+  if (!table || !table->block_cache) {
+    return make_status(rocksdb::Status::NotSupported("Database has no block cache"));
+  }
+
+  std::unique_ptr<rocksdb::CacheDumpWriter> writer;
+  rocksdb::IOStatus io = rocksdb::NewToFileCacheDumpWriter(rocksdb::FileSystem::Default(),
+                                                           rocksdb::FileOptions(), file, &writer);
+  if (!io.ok()) {
+    return make_status(io);
+  }
+
+  rocksdb::CacheDumpOptions dump_options;
+  dump_options.clock = rocksdb::SystemClock::Default().get();
+  dump_options.max_size_bytes = max_size_bytes;
+  std::unique_ptr<rocksdb::CacheDumper> dumper;
+  rocksdb::Status s = rocksdb::NewDefaultCacheDumper(dump_options, table->block_cache,
+                                                     std::move(writer), &dumper);
+  if (s.ok()) {
+    s = dumper->SetDumpFilter({db->db});
+  }
+  if (s.ok()) {
+    s = dumper->DumpCacheEntriesToWriter();
+  }
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_cache_load_dump(RocksDBCacheRef cache, const char* file) {
+  if (!cache) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Cache is null");
+    return result;
+  }
+  if (!cache->secondary) {
+    return make_status(rocksdb::Status::NotSupported("Cache has no secondary cache to load into"));
+  }
+
+  std::unique_ptr<rocksdb::CacheDumpReader> reader;
+  rocksdb::IOStatus io = rocksdb::NewFromFileCacheDumpReader(rocksdb::FileSystem::Default(),
+                                                             rocksdb::FileOptions(), file, &reader);
+  if (!io.ok()) {
+    return make_status(io);
+  }
+
+  rocksdb::CacheDumpOptions dump_options;
+  dump_options.clock = rocksdb::SystemClock::Default().get();
+  rocksdb::BlockBasedTableOptions table_options;
+  table_options.block_cache = cache->cache;
+  std::unique_ptr<rocksdb::CacheDumpedLoader> loader;
+  rocksdb::Status s = rocksdb::NewDefaultCacheDumpedLoader(dump_options, table_options, cache->secondary,
+                                                           std::move(reader), &loader);
+  if (s.ok()) {
+    s = loader->RestoreCacheEntriesToSecondaryCache();
+  }
+  return make_status(s);
+}
+
+size_t rocksdb_cache_get_capacity(RocksDBCacheRef cache) {
+  return cache ? cache->cache->GetCapacity() : 0;
+}
+
+void rocksdb_cache_set_capacity(RocksDBCacheRef cache, size_t capacity) {
+  if (cache) {
+    cache->cache->SetCapacity(capacity);
+  }
+}
+
+size_t rocksdb_cache_get_usage(RocksDBCacheRef cache) {
+  return cache ? cache->cache->GetUsage() : 0;
+}
+
+size_t rocksdb_cache_get_pinned_usage(RocksDBCacheRef cache) {
+  return cache ? cache->cache->GetPinnedUsage() : 0;
+}
+
+// =============================================================================
+// MARK: - Write Buffer Manager
+// =============================================================================
+
+RocksDBWriteBufferManagerRef rocksdb_write_buffer_manager_create(size_t buffer_size,
+                                                                 RocksDBCacheRef cache,
+                                                                 int allow_stall) {
+  auto handle = new RocksDBWriteBufferManagerHandle();
+  handle->manager = std::make_shared<rocksdb::WriteBufferManager>(
+    buffer_size, cache ? cache->cache : nullptr, allow_stall != 0);
+  return handle;
+}
+
+void rocksdb_write_buffer_manager_destroy(RocksDBWriteBufferManagerRef manager) {
+  delete manager;
+}
+
+size_t rocksdb_write_buffer_manager_get_buffer_size(RocksDBWriteBufferManagerRef manager) {
+  return manager ? manager->manager->buffer_size() : 0;
+}
+
+void rocksdb_write_buffer_manager_set_buffer_size(RocksDBWriteBufferManagerRef manager,
+                                                  size_t buffer_size) {
+  if (manager) {
+    manager->manager->SetBufferSize(buffer_size);
+  }
+}
+
+void rocksdb_write_buffer_manager_set_allow_stall(RocksDBWriteBufferManagerRef manager,
+                                                  int allow_stall) {
+  if (manager) {
+    manager->manager->SetAllowStall(allow_stall != 0);
+  }
+}
+
+size_t rocksdb_write_buffer_manager_get_memory_usage(RocksDBWriteBufferManagerRef manager) {
+  return manager ? manager->manager->memory_usage() : 0;
+}
+
+size_t rocksdb_write_buffer_manager_get_mutable_memtable_memory_usage(
+    RocksDBWriteBufferManagerRef manager) {
+  return manager ? manager->manager->mutable_memtable_memory_usage() : 0;
+}
+
+size_t rocksdb_write_buffer_manager_get_dummy_entries_in_cache_usage(
+    RocksDBWriteBufferManagerRef manager) {
+  return manager ? manager->manager->dummy_entries_in_cache_usage() : 0;
+}
+
+// =============================================================================
+// MARK: - Rate Limiter
+// =============================================================================
+
+RocksDBRateLimiterRef rocksdb_rate_limiter_create(int64_t rate_bytes_per_sec,
+                                                  int64_t refill_period_us,
+                                                  int32_t fairness, int mode,
+                                                  int auto_tuned) {
+  auto handle = new RocksDBRateLimiterHandle();
+  handle->limiter.reset(rocksdb::NewGenericRateLimiter(
+    rate_bytes_per_sec, refill_period_us, fairness,
+    static_cast<rocksdb::RateLimiter::Mode>(mode), auto_tuned != 0));
+  return handle;
+}
+
+void rocksdb_rate_limiter_destroy(RocksDBRateLimiterRef limiter) {
+  delete limiter;
+}
+
+void rocksdb_rate_limiter_set_bytes_per_second(RocksDBRateLimiterRef limiter,
+                                               int64_t bytes_per_second) {
+  if (limiter && bytes_per_second > 0) {
+    limiter->limiter->SetBytesPerSecond(bytes_per_second);
+  }
+}
+
+int64_t rocksdb_rate_limiter_get_bytes_per_second(RocksDBRateLimiterRef limiter) {
+  return limiter ? limiter->limiter->GetBytesPerSecond() : 0;
+}
+
+int64_t rocksdb_rate_limiter_get_total_bytes_through(RocksDBRateLimiterRef limiter) {
+  return limiter ? limiter->limiter->GetTotalBytesThrough() : 0;
+}
+
+int64_t rocksdb_rate_limiter_get_total_requests(RocksDBRateLimiterRef limiter) {
+  return limiter ? limiter->limiter->GetTotalRequests() : 0;
+}
+
+// =============================================================================
+// MARK: - SST File Manager
+// =============================================================================
+
+RocksDBSstFileManagerRef rocksdb_sst_file_manager_create(int64_t delete_rate_bytes_per_sec,
+                                                         double max_trash_db_ratio,
+                                                         uint64_t bytes_max_delete_chunk) {
+  rocksdb::Status status;
+  std::shared_ptr<rocksdb::SstFileManager> manager(rocksdb::NewSstFileManager(
+    rocksdb::Env::Default(), nullptr, "", delete_rate_bytes_per_sec, true, &status,
+    max_trash_db_ratio, bytes_max_delete_chunk));
+  if (!status.ok() || !manager) {
+    return nullptr;
+  }
+
+  auto handle = new RocksDBSstFileManagerHandle();
+  handle->manager = std::move(manager);
+  return handle;
+}
+
+void rocksdb_sst_file_manager_destroy(RocksDBSstFileManagerRef manager) {
+  delete manager;
+}
+
+void rocksdb_sst_file_manager_set_delete_rate_bytes_per_second(RocksDBSstFileManagerRef manager,
+                                                               int64_t delete_rate) {
+  if (manager && delete_rate >= 0) {
+    manager->manager->SetDeleteRateBytesPerSecond(delete_rate);
+  }
+}
+
+int64_t rocksdb_sst_file_manager_get_delete_rate_bytes_per_second(RocksDBSstFileManagerRef manager) {
+  return manager ? manager->manager->GetDeleteRateBytesPerSecond() : 0;
+}
+
+void rocksdb_sst_file_manager_set_max_allowed_space_usage(RocksDBSstFileManagerRef manager,
+                                                          uint64_t max_allowed_space) {
+  if (manager) {
+    manager->manager->SetMaxAllowedSpaceUsage(max_allowed_space);
+  }
+}
+
+void rocksdb_sst_file_manager_set_compaction_buffer_size(RocksDBSstFileManagerRef manager,
+                                                         uint64_t compaction_buffer_size) {
+  if (manager) {
+    manager->manager->SetCompactionBufferSize(compaction_buffer_size);
+  }
+}
+
+int rocksdb_sst_file_manager_is_max_allowed_space_reached(RocksDBSstFileManagerRef manager) {
+  return manager && manager->manager->IsMaxAllowedSpaceReached() ? 1 : 0;
+}
+
+int rocksdb_sst_file_manager_is_max_allowed_space_reached_including_compactions(
+    RocksDBSstFileManagerRef manager) {
+  return manager && manager->manager->IsMaxAllowedSpaceReachedIncludingCompactions() ? 1 : 0;
+}
+
+uint64_t rocksdb_sst_file_manager_get_total_size(RocksDBSstFileManagerRef manager) {
+  return manager ? manager->manager->GetTotalSize() : 0;
+}
+
+uint64_t rocksdb_sst_file_manager_get_total_trash_size(RocksDBSstFileManagerRef manager) {
+  return manager ? manager->manager->GetTotalTrashSize() : 0;
+}
+
+// =============================================================================
+// MARK: - Compaction Filter
+// =============================================================================
+
+RocksDBCompactionFilterRef rocksdb_compaction_filter_create(void) {
+  auto handle = new RocksDBCompactionFilterHandle();
+  handle->state = std::make_shared<CompactionFilterState>();
+  return handle;
+}
+
+void rocksdb_compaction_filter_destroy(RocksDBCompactionFilterRef filter) {
+  delete filter;
+}
+
+void rocksdb_compaction_filter_set_dropped_prefixes(RocksDBCompactionFilterRef filter,
+                                                    size_t num_prefixes,
+                                                    const char* const* prefixes,
+                                                    const size_t* prefix_lens) {
+  if (!filter) {
+    return;
+  }
+
+  std::vector<std::string> sorted;
+  sorted.reserve(num_prefixes);
+  for (size_t i = 0; i < num_prefixes; i++) {
+    sorted.emplace_back(prefixes[i], prefix_lens[i]);
+  }
+  std::sort(sorted.begin(), sorted.end());
+
+  // A prefix sorts right after any shorter prefix of itself, so one pass
+  // against the last kept prefix removes every covered one
+  auto pruned = std::make_shared<std::vector<std::string>>();
+  for (auto& prefix : sorted) {
+    if (pruned->empty() || !rocksdb::Slice(prefix).starts_with(rocksdb::Slice(pruned->back()))) {
+      pruned->push_back(std::move(prefix));
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(filter->state->mutex);
+  filter->state->config.dropped_prefixes = std::move(pruned);
+}
+
+void rocksdb_compaction_filter_set_header_threshold(RocksDBCompactionFilterRef filter,
+                                                    size_t offset, size_t width,
+                                                    int big_endian, uint64_t threshold) {
+  if (!filter) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(filter->state->mutex);
+  filter->state->config.header_offset = offset;
+  filter->state->config.header_width = std::min<size_t>(width, sizeof(uint64_t));
+  filter->state->config.header_big_endian = (big_endian != 0);
+  filter->state->config.header_threshold = threshold;
+}
+
+void rocksdb_compaction_filter_set_max_versions(RocksDBCompactionFilterRef filter,
+                                                size_t prefix_len, size_t max_versions) {
+  if (!filter) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(filter->state->mutex);
+  filter->state->config.version_prefix_len = prefix_len;
+  filter->state->config.max_versions = max_versions;
+}
+
+uint64_t rocksdb_compaction_filter_get_dropped_count(RocksDBCompactionFilterRef filter) {
+  return filter ? filter->state->dropped.load(std::memory_order_relaxed) : 0;
+}
+
+// =============================================================================
+// MARK: - Read Options
+// =============================================================================
+
+RocksDBReadOptionsRef rocksdb_read_options_create(void) {
+  return new RocksDBReadOptionsHandle();
+}
+
+void rocksdb_read_options_destroy(RocksDBReadOptionsRef opts) {
+  delete opts;
+}
+
+void rocksdb_read_options_set_verify_checksums(RocksDBReadOptionsRef opts, int value) {
+  opts->options.verify_checksums = (value != 0);
+}
+
+void rocksdb_read_options_set_fill_cache(RocksDBReadOptionsRef opts, int value) {
+  opts->options.fill_cache = (value != 0);
+}
+
+void rocksdb_read_options_set_snapshot(RocksDBReadOptionsRef opts, RocksDBSnapshotRef snapshot) {
+  opts->options.snapshot = snapshot ? snapshot->snapshot : nullptr;
+}
+
+void rocksdb_read_options_set_prefix_same_as_start(RocksDBReadOptionsRef opts, int value) {
+  opts->options.prefix_same_as_start = (value != 0);
+}
+
+void rocksdb_read_options_set_async_io(RocksDBReadOptionsRef opts, int value) {
+  opts->options.async_io = (value != 0);
+}
+
+void rocksdb_read_options_set_optimize_multiget_for_io(RocksDBReadOptionsRef opts, int value) {
+  opts->options.optimize_multiget_for_io = (value != 0);
+}
+
+void rocksdb_read_options_set_readahead_size(RocksDBReadOptionsRef opts, size_t size) {
+  opts->options.readahead_size = size;
+}
+
+void rocksdb_read_options_set_auto_readahead_size(RocksDBReadOptionsRef opts, int value) {
+  opts->options.auto_readahead_size = (value != 0);
+}
+
+void rocksdb_read_options_set_adaptive_readahead(RocksDBReadOptionsRef opts, int value) {
+  opts->options.adaptive_readahead = (value != 0);
+}
+
+void rocksdb_read_options_set_read_tier(RocksDBReadOptionsRef opts, int tier) {
+  opts->options.read_tier = static_cast<rocksdb::ReadTier>(tier);
+}
+
+void rocksdb_read_options_set_deadline(RocksDBReadOptionsRef opts, uint64_t deadline_micros) {
+  opts->options.deadline = std::chrono::microseconds(deadline_micros);
+}
+
+void rocksdb_read_options_set_io_timeout(RocksDBReadOptionsRef opts, uint64_t timeout_micros) {
+  opts->options.io_timeout = std::chrono::microseconds(timeout_micros);
+}
+
+void rocksdb_read_options_set_value_size_soft_limit(RocksDBReadOptionsRef opts, uint64_t limit) {
+  opts->options.value_size_soft_limit = limit;
+}
+
+void rocksdb_read_options_set_rate_limiter_priority(RocksDBReadOptionsRef opts, int priority) {
+  opts->options.rate_limiter_priority = static_cast<rocksdb::Env::IOPriority>(priority);
+}
+
+void rocksdb_read_options_set_tailing(RocksDBReadOptionsRef opts, int value) {
+  opts->options.tailing = (value != 0);
+}
+
+void rocksdb_read_options_set_pin_data(RocksDBReadOptionsRef opts, int value) {
+  opts->options.pin_data = (value != 0);
+}
+
+void rocksdb_read_options_set_background_purge_on_iterator_cleanup(RocksDBReadOptionsRef opts,
+                                                                   int value) {
+  opts->options.background_purge_on_iterator_cleanup = (value != 0);
+}
+
+void rocksdb_read_options_set_iterate_lower_bound(RocksDBReadOptionsRef opts,
+                                                  const char* key, size_t key_len) {
+  if (!key) {
+    opts->lower_bound.clear();
+    opts->options.iterate_lower_bound = nullptr;
+    return;
+  }
+  opts->lower_bound.assign(key, key_len);
+  opts->lower_bound_slice = rocksdb::Slice(opts->lower_bound);
+  opts->options.iterate_lower_bound = &opts->lower_bound_slice;
+}
+
+void rocksdb_read_options_set_iterate_upper_bound(RocksDBReadOptionsRef opts,
+                                                  const char* key, size_t key_len) {
+  if (!key) {
+    opts->upper_bound.clear();
+    opts->options.iterate_upper_bound = nullptr;
+    return;
+  }
+  opts->upper_bound.assign(key, key_len);
+  opts->upper_bound_slice = rocksdb::Slice(opts->upper_bound);
+  opts->options.iterate_upper_bound = &opts->upper_bound_slice;
+}
+
+void rocksdb_read_options_set_timestamp(RocksDBReadOptionsRef opts, int has_timestamp,
+                                        uint64_t timestamp) {
+  if (!has_timestamp) {
+    opts->timestamp.clear();
+    opts->options.timestamp = nullptr;
+    return;
+  }
+  opts->timestamp = encode_timestamp(timestamp);
+  opts->timestamp_slice = rocksdb::Slice(opts->timestamp);
+  opts->options.timestamp = &opts->timestamp_slice;
+}
+
+void rocksdb_read_options_set_iter_start_timestamp(RocksDBReadOptionsRef opts,
+                                                   int has_timestamp, uint64_t timestamp) {
+  if (!has_timestamp) {
+    opts->iter_start_ts.clear();
+    opts->options.iter_start_ts = nullptr;
+    return;
+  }
+  opts->iter_start_ts = encode_timestamp(timestamp);
+  opts->iter_start_ts_slice = rocksdb::Slice(opts->iter_start_ts);
+  opts->options.iter_start_ts = &opts->iter_start_ts_slice;
+}
+
+// =============================================================================
+// MARK: - Write Options
+// =============================================================================
 
 RocksDBWriteOptionsRef rocksdb_write_options_create(void) {
   return new RocksDBWriteOptionsHandle();
 }
 
-void rocksdb_write_options_destroy(RocksDBWriteOptionsRef opts) {
-  delete opts;
+void rocksdb_write_options_destroy(RocksDBWriteOptionsRef opts) {
+  delete opts;
+}
+
+void rocksdb_write_options_set_sync(RocksDBWriteOptionsRef opts, int value) {
+  opts->options.sync = (value != 0);
+}
+
+void rocksdb_write_options_disable_wal(RocksDBWriteOptionsRef opts, int value) {
+  opts->options.disableWAL = (value != 0);
+}
+
+// =============================================================================
+// MARK: - Transaction Database Options
+// =============================================================================
+
+RocksDBTransactionDBOptionsRef rocksdb_transaction_db_options_create(int mode) {
+  auto handle = new RocksDBTransactionDBOptionsHandle();
+  handle->mode = mode;
+  return handle;
+}
+
+void rocksdb_transaction_db_options_destroy(RocksDBTransactionDBOptionsRef opts) {
+  delete opts;
+}
+
+void rocksdb_transaction_db_options_set_lock_timeout(RocksDBTransactionDBOptionsRef opts,
+                                                     int64_t timeout_ms) {
+  opts->db_options.transaction_lock_timeout = timeout_ms;
+  opts->txn_options.lock_timeout = timeout_ms;
+}
+
+void rocksdb_transaction_db_options_set_default_lock_timeout(RocksDBTransactionDBOptionsRef opts,
+                                                             int64_t timeout_ms) {
+  opts->db_options.default_lock_timeout = timeout_ms;
+}
+
+void rocksdb_transaction_db_options_set_num_stripes(RocksDBTransactionDBOptionsRef opts,
+                                                    size_t num_stripes) {
+  opts->db_options.num_stripes = num_stripes;
+}
+
+void rocksdb_transaction_db_options_set_max_num_locks(RocksDBTransactionDBOptionsRef opts,
+                                                      int64_t max_num_locks) {
+  opts->db_options.max_num_locks = max_num_locks;
+}
+
+void rocksdb_transaction_db_options_set_deadlock_detect(RocksDBTransactionDBOptionsRef opts,
+                                                        int enabled, int64_t depth) {
+  opts->txn_options.deadlock_detect = (enabled != 0);
+  opts->txn_options.deadlock_detect_depth = depth;
+}
+
+void rocksdb_transaction_db_options_set_write_policy(RocksDBTransactionDBOptionsRef opts,
+                                                     int policy) {
+  switch (policy) {
+    case RocksDBTxnWritePrepared:
+      opts->db_options.write_policy = rocksdb::TxnDBWritePolicy::WRITE_PREPARED;
+      break;
+    case RocksDBTxnWriteUnprepared:
+      opts->db_options.write_policy = rocksdb::TxnDBWritePolicy::WRITE_UNPREPARED;
+      break;
+    default:
+      opts->db_options.write_policy = rocksdb::TxnDBWritePolicy::WRITE_COMMITTED;
+      break;
+  }
+}
+
+void rocksdb_transaction_db_options_set_write_batch_flush_threshold(RocksDBTransactionDBOptionsRef opts,
+                                                                    int64_t bytes) {
+  opts->db_options.default_write_batch_flush_threshold = bytes;
+}
+
+void rocksdb_transaction_db_options_set_two_phase_commit(RocksDBTransactionDBOptionsRef opts,
+                                                         int enabled) {
+  opts->two_phase_commit = (enabled != 0);
+}
+
+void rocksdb_transaction_db_options_set_validate_policy(RocksDBTransactionDBOptionsRef opts,
+                                                        int policy) {
+  opts->occ_options.validate_policy = policy == RocksDBOccValidateSerial
+    ? rocksdb::OccValidationPolicy::kValidateSerial
+    : rocksdb::OccValidationPolicy::kValidateParallel;
+}
+
+void rocksdb_transaction_db_options_set_occ_lock_buckets(RocksDBTransactionDBOptionsRef opts,
+                                                         uint32_t bucket_count) {
+  opts->occ_options.occ_lock_buckets = bucket_count;
+}
+
+void rocksdb_transaction_db_options_set_shared_occ_lock_buckets(RocksDBTransactionDBOptionsRef opts,
+                                                                RocksDBOccLockBucketsRef buckets) {
+  opts->occ_options.shared_lock_buckets = buckets ? buckets->buckets : nullptr;
+}
+
+RocksDBOccLockBucketsRef rocksdb_occ_lock_buckets_create(size_t bucket_count, int cache_aligned) {
+  auto handle = new RocksDBOccLockBucketsHandle();
+  handle->buckets = rocksdb::MakeSharedOccLockBuckets(bucket_count, cache_aligned != 0);
+  return handle;
+}
+
+void rocksdb_occ_lock_buckets_destroy(RocksDBOccLockBucketsRef buckets) {
+  delete buckets;
+}
+
+// =============================================================================
+// MARK: - Database Operations
+// =============================================================================
+
+RocksDBStatus rocksdb_open(const char* path, RocksDBOptionsRef opts, RocksDBRef* db_out) {
+  auto handle = new RocksDBHandle();
+  handle->statistics = opts->options.statistics;
+  handle->wal_filter = opts->wal_filter;
+  rocksdb::Status s = rocksdb::DB::Open(opts->options, path, &handle->db);
+
+  if (s.ok()) {
+    *db_out = handle;
+  } else {
+    delete handle;
+    *db_out = nullptr;
+  }
+  return make_status(s);
+}
+
+// Time stamps the first opens of table and WAL files while a database opens.
+// VersionSet::Recover reads the MANIFEST and then loads table handlers; WAL
+// replay (and its flush) follows, so the first file of each kind marks the
+// start of a phase.
+class OpenTimingFileSystem : public rocksdb::FileSystemWrapper {
+ public:
+  explicit OpenTimingFileSystem(const std::shared_ptr<rocksdb::FileSystem>& target)
+    : FileSystemWrapper(target), start_(std::chrono::steady_clock::now()) {}
+
+  static const char* kClassName() { return "OpenTimingFileSystem"; }
+  const char* Name() const override { return kClassName(); }
+
+  rocksdb::IOStatus NewSequentialFile(const std::string& fname, const rocksdb::FileOptions& file_opts,
+                                      std::unique_ptr<rocksdb::FSSequentialFile>* result,
+                                      rocksdb::IODebugContext* dbg) override {
+    if (recording_.load(std::memory_order_relaxed) && fname.ends_with(".log")) {
+      uint64_t unset = 0;
+      first_wal_.compare_exchange_strong(unset, elapsed());
+      wal_files_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return target()->NewSequentialFile(fname, file_opts, result, dbg);
+  }
+
+  rocksdb::IOStatus NewRandomAccessFile(const std::string& fname, const rocksdb::FileOptions& file_opts,
+                                        std::unique_ptr<rocksdb::FSRandomAccessFile>* result,
+                                        rocksdb::IODebugContext* dbg) override {
+    bool table = recording_.load(std::memory_order_relaxed) && fname.ends_with(".sst") &&
+                 first_wal_.load(std::memory_order_relaxed) == 0;
+    if (table) {
+      uint64_t unset = 0;
+      first_table_.compare_exchange_strong(unset, elapsed());
+    }
+    rocksdb::IOStatus s = target()->NewRandomAccessFile(fname, file_opts, result, dbg);
+    if (table) {
+      uint64_t end = elapsed();
+      uint64_t last = last_table_.load(std::memory_order_relaxed);
+      while (last < end && !last_table_.compare_exchange_weak(last, end)) {}
+      tables_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return s;
+  }
+
+  // Stop recording and report the phases
+  void finish(RocksDBOpenTimingValues* out) {
+    recording_.store(false, std::memory_order_relaxed);
+    uint64_t total = elapsed();
+    uint64_t first_table = first_table_.load();
+    uint64_t first_wal = first_wal_.load();
+
+    out->total_nanos = total;
+    out->manifest_recovery_nanos = first_table ? first_table : (first_wal ? first_wal : total);
+    out->table_opening_nanos = first_table ? last_table_.load() - first_table : 0;
+    out->wal_replay_nanos = first_wal ? total - first_wal : 0;
+    out->tables_opened = tables_.load();
+    out->wal_files_replayed = wal_files_.load();
+  }
+
+ private:
+  // Nanoseconds since construction, never 0 so 0 can mean "not seen"
+  uint64_t elapsed() const {
+    auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start_).count();
+    return std::max<uint64_t>(static_cast<uint64_t>(nanos), 1);
+  }
+
+  const std::chrono::steady_clock::time_point start_;
+  std::atomic<bool> recording_{true};
+  std::atomic<uint64_t> first_table_{0};
+  std::atomic<uint64_t> last_table_{0};
+  std::atomic<uint64_t> first_wal_{0};
+  std::atomic<uint64_t> tables_{0};
+  std::atomic<uint64_t> wal_files_{0};
+};
+
+RocksDBStatus rocksdb_open_timed(const char* path, RocksDBOptionsRef opts,
+                                 RocksDBOpenTimingValues* timing_out, RocksDBRef* db_out) {
+  memset(timing_out, 0, sizeof(*timing_out));
+  auto handle = new RocksDBHandle();
+  handle->statistics = opts->options.statistics;
+  handle->wal_filter = opts->wal_filter;
+
+  rocksdb::Options options = opts->options;
+  std::shared_ptr<OpenTimingFileSystem> fs;
+  if (options.env == rocksdb::Env::Default()) {
+    fs = std::make_shared<OpenTimingFileSystem>(rocksdb::FileSystem::Default());
+    handle->open_env = rocksdb::NewCompositeEnv(fs);
+    options.env = handle->open_env.get();
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  rocksdb::Status s = rocksdb::DB::Open(options, path, &handle->db);
+  if (fs) {
+    fs->finish(timing_out);
+  } else {
+    timing_out->total_nanos = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start).count());
+  }
+
+  if (s.ok()) {
+    *db_out = handle;
+  } else {
+    delete handle;
+    *db_out = nullptr;
+  }
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_open_in_memory(const char* path, RocksDBOptionsRef opts, RocksDBRef* db_out) {
+  auto handle = new RocksDBHandle();
+  handle->statistics = opts->options.statistics;
+  handle->wal_filter = opts->wal_filter;
+  handle->open_env.reset(rocksdb::NewMemEnv(rocksdb::Env::Default()));
+
+  rocksdb::Options options = opts->options;
+  options.env = handle->open_env.get();
+  options.create_if_missing = true;
+  rocksdb::Status s = rocksdb::DB::Open(options, path, &handle->db);
+
+  if (s.ok()) {
+    *db_out = handle;
+  } else {
+    delete handle;
+    *db_out = nullptr;
+  }
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_open_for_read_only(const char* path, RocksDBOptionsRef opts,
+                                          int error_if_wal_exists, RocksDBRef* db_out) {
+  auto handle = new RocksDBHandle();
+  handle->statistics = opts->options.statistics;
+  handle->wal_filter = opts->wal_filter;
+  rocksdb::Status s = rocksdb::DB::OpenForReadOnly(opts->options, path, &handle->db,
+                                                    error_if_wal_exists != 0);
+
+  if (s.ok()) {
+    *db_out = handle;
+  } else {
+    delete handle;
+    *db_out = nullptr;
+  }
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_open_as_secondary(const char* path, const char* secondary_path,
+                                        RocksDBOptionsRef opts, RocksDBRef* db_out) {
+  auto handle = new RocksDBHandle();
+  handle->statistics = opts->options.statistics;
+  handle->wal_filter = opts->wal_filter;
+  rocksdb::Status s = rocksdb::DB::OpenAsSecondary(opts->options, path, secondary_path, &handle->db);
+
+  if (s.ok()) {
+    *db_out = handle;
+  } else {
+    delete handle;
+    *db_out = nullptr;
+  }
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_try_catch_up_with_primary(RocksDBRef db) {
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  return make_status(db->db->TryCatchUpWithPrimary());
+}
+
+RocksDBStatus rocksdb_open_with_ttl(const char* path, RocksDBOptionsRef opts,
+                                   int32_t ttl_seconds, int read_only, RocksDBRef* db_out) {
+  auto handle = new RocksDBHandle();
+  handle->statistics = opts->options.statistics;
+  handle->wal_filter = opts->wal_filter;
+  rocksdb::Status s = rocksdb::DBWithTTL::Open(opts->options, path, &handle->ttl_db,
+                                               ttl_seconds, read_only != 0);
+
+  if (s.ok()) {
+    handle->db = handle->ttl_db;
+    *db_out = handle;
+  } else {
+    delete handle;
+    *db_out = nullptr;
+  }
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_set_ttl(RocksDBRef db, RocksDBColumnFamilyRef cf, int32_t ttl_seconds) {
+  if (!db || !db->ttl_db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database was not opened with a TTL");
+    return result;
+  }
+
+  db->ttl_db->SetTtl(column_family(db, cf), ttl_seconds);
+  return make_ok();
+}
+
+// Open an optimistic or pessimistic transaction database into handle,
+// setting handle->db on success
+static rocksdb::Status open_transaction_db(const rocksdb::DBOptions& db_opts, const char* path,
+                                           const std::vector<rocksdb::ColumnFamilyDescriptor>& descriptors,
+                                           std::vector<rocksdb::ColumnFamilyHandle*>* handles,
+                                           RocksDBTransactionDBOptionsRef txn_opts,
+                                           RocksDBHandle* handle) {
+  handle->is_transactional = true;
+
+  if (txn_opts && txn_opts->mode == RocksDBTransactionModePessimistic) {
+    // Prepared transactions are only recovered from the WAL with 2PC enabled,
+    // which costs every commit an extra WAL sync, so it is opt-in
+    rocksdb::DBOptions pessimisticOpts = db_opts;
+    pessimisticOpts.allow_2pc = txn_opts->two_phase_commit;
+    rocksdb::Status s = rocksdb::TransactionDB::Open(pessimisticOpts, txn_opts->db_options, path,
+                                                     descriptors, handles,
+                                                     &handle->pessimistic_db);
+    if (s.ok()) {
+      handle->db = handle->pessimistic_db;
+      handle->txn_options = txn_opts->txn_options;
+      handle->two_phase_commit = txn_opts->two_phase_commit;
+      // Only transactions prepared by an earlier process exist this early
+      handle->pessimistic_db->GetAllPreparedTransactions(&handle->recovered_txns);
+    }
+    return s;
+  }
+
+  rocksdb::OptimisticTransactionDBOptions occOpts;
+  if (txn_opts) {
+    occOpts = txn_opts->occ_options;
+  }
+  rocksdb::Status s = rocksdb::OptimisticTransactionDB::Open(db_opts, occOpts, path, descriptors,
+                                                             handles, &handle->txn_db);
+  if (s.ok()) {
+    handle->db = handle->txn_db->GetBaseDB();
+  }
+  return s;
+}
+
+RocksDBStatus rocksdb_open_transactional(const char* path, RocksDBOptionsRef opts, RocksDBRef* db_out) {
+  return rocksdb_open_transaction_db(path, opts, nullptr, db_out);
+}
+
+RocksDBStatus rocksdb_open_transaction_db(const char* path, RocksDBOptionsRef opts,
+                                          RocksDBTransactionDBOptionsRef txn_opts,
+                                          RocksDBRef* db_out) {
+  auto handle = new RocksDBHandle();
+  handle->statistics = opts->options.statistics;
+  handle->wal_filter = opts->wal_filter;
+
+  std::vector<rocksdb::ColumnFamilyDescriptor> descriptors;
+  descriptors.emplace_back(rocksdb::kDefaultColumnFamilyName,
+                           rocksdb::ColumnFamilyOptions(opts->options));
+  std::vector<rocksdb::ColumnFamilyHandle*> handles;
+
+  rocksdb::Status s = open_transaction_db(rocksdb::DBOptions(opts->options), path,
+                                          descriptors, &handles, txn_opts, handle);
+
+  if (s.ok()) {
+    // The default family is reached through DefaultColumnFamily(), as with DB::Open
+    delete handles[0];
+    *db_out = handle;
+  } else {
+    delete handle;
+    *db_out = nullptr;
+  }
+  return make_status(s);
+}
+
+void rocksdb_close(RocksDBRef db) {
+  if (db) {
+    release_db(db);
+  }
+}
+
+int rocksdb_is_transactional(RocksDBRef db) {
+  return db && db->is_transactional ? 1 : 0;
+}
+
+// =============================================================================
+// MARK: - Column Families
+// =============================================================================
+
+static RocksDBStatus open_column_families(const char* path, RocksDBOptionsRef opts,
+                                          size_t num_families,
+                                          const char* const* names,
+                                          const RocksDBOptionsRef* family_opts,
+                                          bool transactional,
+                                          RocksDBTransactionDBOptionsRef txn_opts,
+                                          RocksDBRef* db_out,
+                                          RocksDBColumnFamilyRef* families_out) {
+  *db_out = nullptr;
+  for (size_t i = 0; i < num_families; i++) {
+    families_out[i] = nullptr;
+  }
+
+  std::vector<rocksdb::ColumnFamilyDescriptor> descriptors;
+  bool has_default = false;
+  for (size_t i = 0; i < num_families; i++) {
+    const rocksdb::Options& source = family_opts && family_opts[i]
+      ? family_opts[i]->options : opts->options;
+    descriptors.emplace_back(names[i], rocksdb::ColumnFamilyOptions(source));
+    has_default = has_default || descriptors.back().name == rocksdb::kDefaultColumnFamilyName;
+  }
+  // RocksDB requires the default family to be opened as well
+  if (!has_default) {
+    descriptors.emplace_back(rocksdb::kDefaultColumnFamilyName,
+                             rocksdb::ColumnFamilyOptions(opts->options));
+  }
+
+  auto handle = new RocksDBHandle();
+  handle->statistics = opts->options.statistics;
+  handle->wal_filter = opts->wal_filter;
+
+  std::vector<rocksdb::ColumnFamilyHandle*> handles;
+  rocksdb::DBOptions dbOpts(opts->options);
+  rocksdb::Status s;
+  if (transactional) {
+    s = open_transaction_db(dbOpts, path, descriptors, &handles, txn_opts, handle);
+  } else {
+    s = rocksdb::DB::Open(dbOpts, path, descriptors, &handles, &handle->db);
+  }
+
+  if (!s.ok()) {
+    delete handle;
+    return make_status(s);
+  }
+
+  for (size_t i = 0; i < handles.size(); i++) {
+    RocksDBColumnFamilyRef cf = add_column_family(handle, handles[i]);
+    if (i < num_families) {
+      families_out[i] = cf;
+    }
+  }
+
+  *db_out = handle;
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_open_column_families(const char* path, RocksDBOptionsRef opts,
+                                           size_t num_families,
+                                           const char* const* names,
+                                           const RocksDBOptionsRef* family_opts,
+                                           RocksDBRef* db_out,
+                                           RocksDBColumnFamilyRef* families_out) {
+  return open_column_families(path, opts, num_families, names, family_opts, false, nullptr,
+                              db_out, families_out);
+}
+
+RocksDBStatus rocksdb_open_transactional_column_families(const char* path, RocksDBOptionsRef opts,
+                                                         size_t num_families,
+                                                         const char* const* names,
+                                                         const RocksDBOptionsRef* family_opts,
+                                                         RocksDBRef* db_out,
+                                                         RocksDBColumnFamilyRef* families_out) {
+  return open_column_families(path, opts, num_families, names, family_opts, true, nullptr,
+                              db_out, families_out);
+}
+
+RocksDBStatus rocksdb_open_transaction_db_column_families(const char* path, RocksDBOptionsRef opts,
+                                                          RocksDBTransactionDBOptionsRef txn_opts,
+                                                          size_t num_families,
+                                                          const char* const* names,
+                                                          const RocksDBOptionsRef* family_opts,
+                                                          RocksDBRef* db_out,
+                                                          RocksDBColumnFamilyRef* families_out) {
+  return open_column_families(path, opts, num_families, names, family_opts, true, txn_opts,
+                              db_out, families_out);
+}
+
+RocksDBStatus rocksdb_list_column_families(const char* path, RocksDBOptionsRef opts,
+                                           char*** names_out, size_t* count_out) {
+  *names_out = nullptr;
+  *count_out = 0;
+
+  std::vector<std::string> names;
+  rocksdb::Status s = rocksdb::DB::ListColumnFamilies(rocksdb::DBOptions(opts->options),
+                                                      path, &names);
+  if (s.ok() && !names.empty()) {
+    *names_out = static_cast<char**>(malloc(names.size() * sizeof(char*)));
+    for (size_t i = 0; i < names.size(); i++) {
+      (*names_out)[i] = strdup(names[i].c_str());
+    }
+    *count_out = names.size();
+  }
+  return make_status(s);
+}
+
+void rocksdb_free_string_list(char** names, size_t count) {
+  if (!names) {
+    return;
+  }
+  for (size_t i = 0; i < count; i++) {
+    free(names[i]);
+  }
+  free(names);
+}
+
+RocksDBStatus rocksdb_create_column_family(RocksDBRef db, RocksDBOptionsRef opts,
+                                           const char* name,
+                                           RocksDBColumnFamilyRef* cf_out) {
+  *cf_out = nullptr;
+
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  rocksdb::ColumnFamilyHandle* handle = nullptr;
+  rocksdb::Status s = db->db->CreateColumnFamily(rocksdb::ColumnFamilyOptions(opts->options),
+                                                 name, &handle);
+  if (s.ok()) {
+    *cf_out = add_column_family(db, handle);
+  }
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_drop_column_family(RocksDBRef db, RocksDBColumnFamilyRef cf) {
+  if (!db || !db->db || !cf) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database or column family is null");
+    return result;
+  }
+
+  rocksdb::Status s = db->db->DropColumnFamily(cf->handle);
+  return make_status(s);
+}
+
+RocksDBColumnFamilyRef rocksdb_default_column_family(RocksDBRef db) {
+  if (!db || !db->db) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(db->cf_mutex);
+  if (!db->default_family.handle) {
+    db->default_family.handle = db->db->DefaultColumnFamily();
+    db->default_family.name = rocksdb::kDefaultColumnFamilyName;
+  }
+  return &db->default_family;
+}
+
+const char* rocksdb_column_family_name(RocksDBColumnFamilyRef cf) {
+  return cf ? cf->name.c_str() : nullptr;
+}
+
+uint32_t rocksdb_column_family_id(RocksDBColumnFamilyRef cf) {
+  return cf ? cf->handle->GetID() : 0;
+}
+
+// =============================================================================
+// MARK: - Key-Value Operations
+// =============================================================================
+
+RocksDBStatus rocksdb_put(RocksDBRef db, RocksDBWriteOptionsRef opts,
+                          const char* key, size_t key_len,
+                          const char* value, size_t value_len) {
+  return rocksdb_put_cf(db, nullptr, opts, key, key_len, value, value_len);
+}
+
+RocksDBStatus rocksdb_put_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                             RocksDBWriteOptionsRef opts,
+                             const char* key, size_t key_len,
+                             const char* value, size_t value_len) {
+  TraceScope trace(RocksDBTraceOpPut);
+
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  const rocksdb::WriteOptions& writeOpts = write_options(opts);
+
+  rocksdb::Status s = trace.engine([&] {
+    return db->db->Put(
+      writeOpts,
+      column_family(db, cf),
+      rocksdb::Slice(key, key_len),
+      rocksdb::Slice(value, value_len));
+  });
+
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_merge(RocksDBRef db, RocksDBWriteOptionsRef opts,
+                            const char* key, size_t key_len,
+                            const char* value, size_t value_len) {
+  return rocksdb_merge_cf(db, nullptr, opts, key, key_len, value, value_len);
+}
+
+RocksDBStatus rocksdb_merge_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                               RocksDBWriteOptionsRef opts,
+                               const char* key, size_t key_len,
+                               const char* value, size_t value_len) {
+  TraceScope trace(RocksDBTraceOpMerge);
+
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  const rocksdb::WriteOptions& writeOpts = write_options(opts);
+
+  rocksdb::Status s = trace.engine([&] {
+    return db->db->Merge(
+      writeOpts,
+      column_family(db, cf),
+      rocksdb::Slice(key, key_len),
+      rocksdb::Slice(value, value_len));
+  });
+
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_get(RocksDBRef db, RocksDBReadOptionsRef opts,
+                          const char* key, size_t key_len,
+                          char** value_out, size_t* value_len_out) {
+  *value_out = nullptr;
+  *value_len_out = 0;
+
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  const rocksdb::ReadOptions& readOpts = read_options(opts);
+
+  std::string value;
+  rocksdb::Status s = db->db->Get(
+    readOpts,
+    rocksdb::Slice(key, key_len),
+    &value);
+
+  if (s.ok()) {
+    *value_len_out = value.size();
+    *value_out = static_cast<char*>(malloc(value.size()));
+    if (*value_out) {
+      memcpy(*value_out, value.data(), value.size());
+    }
+  }
+
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_delete(RocksDBRef db, RocksDBWriteOptionsRef opts,
+                             const char* key, size_t key_len) {
+  return rocksdb_delete_cf(db, nullptr, opts, key, key_len);
+}
+
+RocksDBStatus rocksdb_delete_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                RocksDBWriteOptionsRef opts,
+                                const char* key, size_t key_len) {
+  TraceScope trace(RocksDBTraceOpDelete);
+
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  const rocksdb::WriteOptions& writeOpts = write_options(opts);
+
+  rocksdb::Status s = trace.engine([&] {
+    return db->db->Delete(
+      writeOpts,
+      column_family(db, cf),
+      rocksdb::Slice(key, key_len));
+  });
+
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_single_delete(RocksDBRef db, RocksDBWriteOptionsRef opts,
+                                    const char* key, size_t key_len) {
+  return rocksdb_single_delete_cf(db, nullptr, opts, key, key_len);
+}
+
+RocksDBStatus rocksdb_single_delete_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                       RocksDBWriteOptionsRef opts,
+                                       const char* key, size_t key_len) {
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  rocksdb::Status s = db->db->SingleDelete(
+    write_options(opts),
+    column_family(db, cf),
+    rocksdb::Slice(key, key_len));
+
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_delete_range(RocksDBRef db, RocksDBWriteOptionsRef opts,
+                                   const char* start_key, size_t start_key_len,
+                                   const char* end_key, size_t end_key_len) {
+  return rocksdb_delete_range_cf(db, nullptr, opts, start_key, start_key_len,
+                                 end_key, end_key_len);
+}
+
+RocksDBStatus rocksdb_delete_range_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                      RocksDBWriteOptionsRef opts,
+                                      const char* start_key, size_t start_key_len,
+                                      const char* end_key, size_t end_key_len) {
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  rocksdb::Status s = db->db->DeleteRange(
+    write_options(opts),
+    column_family(db, cf),
+    rocksdb::Slice(start_key, start_key_len),
+    rocksdb::Slice(end_key, end_key_len));
+
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_get_pinned(RocksDBRef db, RocksDBReadOptionsRef opts,
+                                 const char* key, size_t key_len,
+                                 RocksDBPinnableSliceRef* pinned_out) {
+  return rocksdb_get_pinned_cf(db, nullptr, opts, key, key_len, pinned_out);
+}
+
+RocksDBStatus rocksdb_get_pinned_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                    RocksDBReadOptionsRef opts,
+                                    const char* key, size_t key_len,
+                                    RocksDBPinnableSliceRef* pinned_out) {
+  TraceScope trace(RocksDBTraceOpGet);
+  *pinned_out = nullptr;
+
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  const rocksdb::ReadOptions& readOpts = read_options(opts);
+
+  auto handle = new RocksDBPinnableSliceHandle();
+  rocksdb::Status s = trace.engine([&] {
+    return db->db->Get(
+      readOpts,
+      column_family(db, cf),
+      rocksdb::Slice(key, key_len),
+      &handle->value);
+  });
+
+  if (s.ok()) {
+    retain_db(db);
+    handle->owner = db;
+    *pinned_out = handle;
+  } else {
+    delete handle;
+  }
+
+  return make_status(s);
+}
+
+const char* rocksdb_pinnable_slice_value(RocksDBPinnableSliceRef pinned, size_t* len_out) {
+  if (!pinned) {
+    *len_out = 0;
+    return nullptr;
+  }
+
+  *len_out = pinned->value.size();
+  return pinned->value.data();
+}
+
+void rocksdb_pinnable_slice_destroy(RocksDBPinnableSliceRef pinned) {
+  delete pinned;
+}
+
+void rocksdb_multi_get(RocksDBRef db, RocksDBReadOptionsRef opts,
+                       size_t num_keys,
+                       const char* const* keys, const size_t* key_lens,
+                       int sorted_input,
+                       RocksDBPinnableSliceRef* values_out,
+                       RocksDBStatus* statuses_out) {
+  rocksdb_multi_get_cf(db, nullptr, opts, num_keys, keys, key_lens, sorted_input,
+                       values_out, statuses_out);
+}
+
+void rocksdb_multi_get_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                          RocksDBReadOptionsRef opts,
+                          size_t num_keys,
+                          const char* const* keys, const size_t* key_lens,
+                          int sorted_input,
+                          RocksDBPinnableSliceRef* values_out,
+                          RocksDBStatus* statuses_out) {
+  TraceScope trace(RocksDBTraceOpMultiGet);
+  for (size_t i = 0; i < num_keys; i++) {
+    values_out[i] = nullptr;
+  }
+
+  if (!db || !db->db) {
+    for (size_t i = 0; i < num_keys; i++) {
+      statuses_out[i].code = RocksDBStatusInvalidArgument;
+      statuses_out[i].message = strdup("Database is null");
+    }
+    return;
+  }
+
+  if (num_keys == 0) {
+    return;
+  }
+
+  const rocksdb::ReadOptions& readOpts = read_options(opts);
+
+  std::vector<rocksdb::Slice> keySlices;
+  keySlices.reserve(num_keys);
+  for (size_t i = 0; i < num_keys; i++) {
+    keySlices.emplace_back(keys[i], key_lens[i]);
+  }
+
+  std::vector<rocksdb::PinnableSlice> values(num_keys);
+  std::vector<rocksdb::Status> statuses(num_keys);
+
+  trace.engine([&] {
+    db->db->MultiGet(readOpts, column_family(db, cf), num_keys,
+                     keySlices.data(), values.data(), statuses.data(),
+                     sorted_input != 0);
+  });
+
+  export_multi_get(values, statuses, db, values_out, statuses_out);
+}
+
+int rocksdb_key_may_exist(RocksDBRef db, RocksDBReadOptionsRef opts,
+                          const char* key, size_t key_len) {
+  if (!db || !db->db) {
+    return 0;
+  }
+
+  const rocksdb::ReadOptions& readOpts = read_options(opts);
+
+  // Without value_found the value is not read at all
+  return db->db->KeyMayExist(readOpts, rocksdb::Slice(key, key_len), nullptr) ? 1 : 0;
+}
+
+RocksDBKeyExistenceCode rocksdb_key_may_exist_value_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                                       RocksDBReadOptionsRef opts,
+                                                       const char* key, size_t key_len,
+                                                       RocksDBPinnableSliceRef* value_out) {
+  if (value_out) {
+    *value_out = nullptr;
+  }
+  if (!db || !db->db) {
+    return RocksDBKeyAbsent;
+  }
+
+  const rocksdb::ReadOptions& readOpts = read_options(opts);
+  rocksdb::Slice key_slice(key, key_len);
+  if (!value_out) {
+    return db->db->KeyMayExist(readOpts, column_family(db, cf), key_slice, nullptr)
+               ? RocksDBKeyMaybePresent : RocksDBKeyAbsent;
+  }
+
+  // The value is written straight into the slice's own buffer, so handing
+  // it to the caller costs no further copy
+  auto handle = new RocksDBPinnableSliceHandle();
+  bool value_found = false;
+  bool may_exist = db->db->KeyMayExist(readOpts, column_family(db, cf), key_slice,
+                                       handle->value.GetSelf(), &value_found);
+  if (!may_exist || !value_found) {
+    delete handle;
+    return may_exist ? RocksDBKeyMaybePresent : RocksDBKeyAbsent;
+  }
+
+  handle->value.PinSelf();
+  retain_db(db);
+  handle->owner = db;
+  *value_out = handle;
+  return RocksDBKeyPresent;
+}
+
+void rocksdb_keys_may_exist_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                               RocksDBReadOptionsRef opts,
+                               size_t num_keys,
+                               const char* const* keys, const size_t* key_lens,
+                               int sorted_input,
+                               RocksDBKeyExistenceCode* results_out) {
+  for (size_t i = 0; i < num_keys; i++) {
+    results_out[i] = RocksDBKeyMaybePresent;
+  }
+  if (!db || !db->db || num_keys == 0) {
+    return;
+  }
+
+  // Anything that would need I/O comes back Incomplete instead
+  rocksdb::ReadOptions readOpts = read_options(opts);
+  readOpts.read_tier = rocksdb::kBlockCacheTier;
+
+  std::vector<rocksdb::Slice> keySlices;
+  keySlices.reserve(num_keys);
+  for (size_t i = 0; i < num_keys; i++) {
+    keySlices.emplace_back(keys[i], key_lens[i]);
+  }
+
+  std::vector<rocksdb::PinnableSlice> values(num_keys);
+  std::vector<rocksdb::Status> statuses(num_keys);
+  db->db->MultiGet(readOpts, column_family(db, cf), num_keys,
+                   keySlices.data(), values.data(), statuses.data(),
+                   sorted_input != 0);
+
+  for (size_t i = 0; i < num_keys; i++) {
+    if (statuses[i].ok()) {
+      results_out[i] = RocksDBKeyPresent;
+    } else if (statuses[i].IsNotFound()) {
+      results_out[i] = RocksDBKeyAbsent;
+    }
+  }
+}
+
+// =============================================================================
+// MARK: - Read Contexts
+// =============================================================================
+
+// Like make_status, but a not-found status is reported without a message so
+// the miss path does not allocate
+static RocksDBStatus make_lookup_status(const rocksdb::Status& s) {
+  if (s.IsNotFound()) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusNotFound;
+    result.message = nullptr;
+    return result;
+  }
+  return make_status(s);
+}
+
+RocksDBReadContextRef rocksdb_read_context_create(RocksDBReadOptionsRef opts) {
+  auto ctx = new RocksDBReadContextHandle();
+  ctx->options = read_options(opts);
+  return ctx;
+}
+
+void rocksdb_read_context_destroy(RocksDBReadContextRef ctx) {
+  delete ctx;
+}
+
+void rocksdb_read_context_reset(RocksDBReadContextRef ctx) {
+  if (!ctx) {
+    return;
+  }
+
+  ctx->value.Reset();
+  for (auto& value : ctx->values) {
+    value.Reset();
+  }
+}
+
+RocksDBStatus rocksdb_read_context_get(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                       RocksDBReadContextRef ctx,
+                                       const char* key, size_t key_len,
+                                       const char** value_out, size_t* value_len_out) {
+  *value_out = nullptr;
+  *value_len_out = 0;
+
+  if (!db || !db->db || !ctx) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup(ctx ? "Database is null" : "Read context is null");
+    return result;
+  }
+
+  ctx->value.Reset();
+  rocksdb::Status s = db->db->Get(ctx->options, column_family(db, cf),
+                                  rocksdb::Slice(key, key_len), &ctx->value);
+  if (s.ok()) {
+    *value_out = ctx->value.data();
+    *value_len_out = ctx->value.size();
+  }
+
+  return make_lookup_status(s);
+}
+
+void rocksdb_read_context_multi_get(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                    RocksDBReadContextRef ctx,
+                                    size_t num_keys,
+                                    const char* const* keys, const size_t* key_lens,
+                                    int sorted_input,
+                                    const char** values_out, size_t* value_lens_out,
+                                    RocksDBStatus* statuses_out) {
+  for (size_t i = 0; i < num_keys; i++) {
+    values_out[i] = nullptr;
+    value_lens_out[i] = 0;
+  }
+
+  if (!db || !db->db || !ctx) {
+    for (size_t i = 0; i < num_keys; i++) {
+      statuses_out[i].code = RocksDBStatusInvalidArgument;
+      statuses_out[i].message = strdup(ctx ? "Database is null" : "Read context is null");
+    }
+    return;
+  }
+
+  if (num_keys == 0) {
+    return;
+  }
+
+  rocksdb_read_context_reset(ctx);
+  if (ctx->values.size() < num_keys) {
+    ctx->values.resize(num_keys);
+    ctx->statuses.resize(num_keys);
+  }
+  ctx->keys.clear();
+  for (size_t i = 0; i < num_keys; i++) {
+    ctx->keys.emplace_back(keys[i], key_lens[i]);
+  }
+
+  db->db->MultiGet(ctx->options, column_family(db, cf), num_keys,
+                   ctx->keys.data(), ctx->values.data(), ctx->statuses.data(),
+                   sorted_input != 0);
+
+  for (size_t i = 0; i < num_keys; i++) {
+    if (ctx->statuses[i].ok()) {
+      values_out[i] = ctx->values[i].data();
+      value_lens_out[i] = ctx->values[i].size();
+    }
+    statuses_out[i] = make_lookup_status(ctx->statuses[i]);
+  }
+}
+
+// =============================================================================
+// MARK: - User-Defined Timestamps
+// =============================================================================
+
+RocksDBStatus rocksdb_put_with_timestamp_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                            RocksDBWriteOptionsRef opts,
+                                            const char* key, size_t key_len,
+                                            uint64_t timestamp,
+                                            const char* value, size_t value_len) {
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  std::string ts = encode_timestamp(timestamp);
+  rocksdb::Status s = db->db->Put(
+    write_options(opts),
+    column_family(db, cf),
+    rocksdb::Slice(key, key_len),
+    rocksdb::Slice(ts),
+    rocksdb::Slice(value, value_len));
+
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_delete_with_timestamp_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                               RocksDBWriteOptionsRef opts,
+                                               const char* key, size_t key_len,
+                                               uint64_t timestamp) {
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  std::string ts = encode_timestamp(timestamp);
+  rocksdb::Status s = db->db->Delete(
+    write_options(opts),
+    column_family(db, cf),
+    rocksdb::Slice(key, key_len),
+    rocksdb::Slice(ts));
+
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_get_pinned_with_timestamp_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                                   RocksDBReadOptionsRef opts,
+                                                   uint64_t read_timestamp,
+                                                   const char* key, size_t key_len,
+                                                   RocksDBPinnableSliceRef* pinned_out,
+                                                   uint64_t* timestamp_out) {
+  *pinned_out = nullptr;
+  *timestamp_out = 0;
+
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  // Copy so the shared options handle is left untouched
+  rocksdb::ReadOptions readOpts = read_options(opts);
+  std::string readTs = encode_timestamp(read_timestamp);
+  rocksdb::Slice readTsSlice(readTs);
+  readOpts.timestamp = &readTsSlice;
+
+  auto handle = new RocksDBPinnableSliceHandle();
+  std::string ts;
+  rocksdb::Status s = db->db->Get(
+    readOpts,
+    column_family(db, cf),
+    rocksdb::Slice(key, key_len),
+    &handle->value,
+    &ts);
+
+  if (s.ok()) {
+    retain_db(db);
+    handle->owner = db;
+    *pinned_out = handle;
+    *timestamp_out = decode_timestamp(ts);
+  } else {
+    delete handle;
+  }
+
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_increase_full_history_ts_low(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                                   uint64_t timestamp) {
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  return make_status(db->db->IncreaseFullHistoryTsLow(column_family(db, cf),
+                                                      encode_timestamp(timestamp)));
+}
+
+RocksDBStatus rocksdb_get_full_history_ts_low(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                              uint64_t* timestamp_out) {
+  *timestamp_out = 0;
+
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  std::string ts;
+  rocksdb::Status s = db->db->GetFullHistoryTsLow(column_family(db, cf), &ts);
+  if (s.ok()) {
+    *timestamp_out = decode_timestamp(ts);
+  }
+  return make_status(s);
+}
+
+// =============================================================================
+// MARK: - Wide Columns
+// =============================================================================
+
+RocksDBStatus rocksdb_put_entity_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                    RocksDBWriteOptionsRef opts,
+                                    const char* key, size_t key_len,
+                                    size_t num_columns,
+                                    const char* const* names, const size_t* name_lens,
+                                    const char* const* values, const size_t* value_lens) {
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  rocksdb::Status s = db->db->PutEntity(
+    write_options(opts),
+    column_family(db, cf),
+    rocksdb::Slice(key, key_len),
+    make_columns(num_columns, names, name_lens, values, value_lens));
+
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_get_entity_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                    RocksDBReadOptionsRef opts,
+                                    const char* key, size_t key_len,
+                                    RocksDBWideColumnsRef* columns_out) {
+  *columns_out = nullptr;
+
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  auto handle = new RocksDBWideColumnsHandle();
+  rocksdb::Status s = db->db->GetEntity(
+    read_options(opts),
+    column_family(db, cf),
+    rocksdb::Slice(key, key_len),
+    &handle->columns);
+
+  if (s.ok()) {
+    retain_db(db);
+    handle->owner = db;
+    *columns_out = handle;
+  } else {
+    delete handle;
+  }
+
+  return make_status(s);
+}
+
+size_t rocksdb_wide_columns_count(RocksDBWideColumnsRef columns) {
+  return columns ? columns->columns.columns().size() : 0;
+}
+
+const char* rocksdb_wide_columns_name(RocksDBWideColumnsRef columns, size_t index,
+                                      size_t* len_out) {
+  if (!columns || index >= columns->columns.columns().size()) {
+    *len_out = 0;
+    return nullptr;
+  }
+
+  const rocksdb::Slice& name = columns->columns.columns()[index].name();
+  *len_out = name.size();
+  return name.data();
+}
+
+const char* rocksdb_wide_columns_value(RocksDBWideColumnsRef columns, size_t index,
+                                       size_t* len_out) {
+  if (!columns || index >= columns->columns.columns().size()) {
+    *len_out = 0;
+    return nullptr;
+  }
+
+  const rocksdb::Slice& value = columns->columns.columns()[index].value();
+  *len_out = value.size();
+  return value.data();
+}
+
+const char* rocksdb_wide_columns_find(RocksDBWideColumnsRef columns,
+                                      const char* name, size_t name_len,
+                                      size_t* len_out) {
+  *len_out = 0;
+  if (!columns) {
+    return nullptr;
+  }
+
+  // Entities are stored with their columns sorted by name
+  const rocksdb::WideColumns& list = columns->columns.columns();
+  rocksdb::Slice target(name, name_len);
+  auto it = std::lower_bound(list.begin(), list.end(), target,
+                             [](const rocksdb::WideColumn& column, const rocksdb::Slice& n) {
+                               return column.name().compare(n) < 0;
+                             });
+  if (it == list.end() || it->name() != target) {
+    return nullptr;
+  }
+
+  *len_out = it->value().size();
+  return it->value().data();
+}
+
+void rocksdb_wide_columns_destroy(RocksDBWideColumnsRef columns) {
+  delete columns;
+}
+
+// =============================================================================
+// MARK: - Attribute Groups
+// =============================================================================
+
+RocksDBStatus rocksdb_put_attribute_groups(RocksDBRef db, RocksDBWriteOptionsRef opts,
+                                           const char* key, size_t key_len,
+                                           size_t num_groups,
+                                           const RocksDBColumnFamilyRef* families,
+                                           const size_t* column_counts,
+                                           const char* const* names, const size_t* name_lens,
+                                           const char* const* values, const size_t* value_lens) {
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  rocksdb::Status s = db->db->PutEntity(
+    write_options(opts),
+    rocksdb::Slice(key, key_len),
+    make_attribute_groups(num_groups, families, column_counts,
+                          names, name_lens, values, value_lens));
+
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_get_attribute_groups(RocksDBRef db, RocksDBReadOptionsRef opts,
+                                           const char* key, size_t key_len,
+                                           size_t num_groups,
+                                           const RocksDBColumnFamilyRef* families,
+                                           RocksDBAttributeGroupsRef* groups_out) {
+  *groups_out = nullptr;
+
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  auto handle = new RocksDBAttributeGroupsHandle();
+  handle->groups.reserve(num_groups);
+  for (size_t i = 0; i < num_groups; i++) {
+    handle->groups.emplace_back(column_family(db, families[i]));
+  }
+
+  rocksdb::Status s = db->db->GetEntity(
+    read_options(opts),
+    rocksdb::Slice(key, key_len),
+    &handle->groups);
+
+  if (s.ok()) {
+    retain_db(db);
+    handle->owner = db;
+    *groups_out = handle;
+  } else {
+    delete handle;
+  }
+
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_attribute_group_status(RocksDBAttributeGroupsRef groups, size_t group) {
+  if (!groups || group >= groups->groups.size()) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Attribute group index out of range");
+    return result;
+  }
+  return make_status(groups->groups[group].status());
+}
+
+size_t rocksdb_attribute_group_column_count(RocksDBAttributeGroupsRef groups, size_t group) {
+  if (!groups || group >= groups->groups.size()) {
+    return 0;
+  }
+  return groups->groups[group].columns().size();
+}
+
+const char* rocksdb_attribute_group_column_name(RocksDBAttributeGroupsRef groups, size_t group,
+                                                size_t index, size_t* len_out) {
+  if (!groups || group >= groups->groups.size() ||
+      index >= groups->groups[group].columns().size()) {
+    *len_out = 0;
+    return nullptr;
+  }
+
+  const rocksdb::Slice& name = groups->groups[group].columns()[index].name();
+  *len_out = name.size();
+  return name.data();
+}
+
+const char* rocksdb_attribute_group_column_value(RocksDBAttributeGroupsRef groups, size_t group,
+                                                 size_t index, size_t* len_out) {
+  if (!groups || group >= groups->groups.size() ||
+      index >= groups->groups[group].columns().size()) {
+    *len_out = 0;
+    return nullptr;
+  }
+
+  const rocksdb::Slice& value = groups->groups[group].columns()[index].value();
+  *len_out = value.size();
+  return value.data();
+}
+
+void rocksdb_attribute_groups_destroy(RocksDBAttributeGroupsRef groups) {
+  delete groups;
+}
+
+RocksDBAttributeGroupIteratorRef rocksdb_attribute_group_iterator_create(
+    RocksDBRef db, RocksDBReadOptionsRef opts,
+    size_t num_families, const RocksDBColumnFamilyRef* families) {
+  if (!db || !db->db) {
+    return nullptr;
+  }
+
+  std::vector<rocksdb::ColumnFamilyHandle*> handles;
+  handles.reserve(num_families);
+  for (size_t i = 0; i < num_families; i++) {
+    handles.push_back(column_family(db, families[i]));
+  }
+
+  auto handle = new RocksDBAttributeGroupIteratorHandle();
+  handle->iter = db->db->NewAttributeGroupIterator(read_options(opts), handles);
+  handle->families.assign(families, families + num_families);
+  return handle;
+}
+
+void rocksdb_attribute_group_iterator_destroy(RocksDBAttributeGroupIteratorRef iter) {
+  delete iter;
+}
+
+int rocksdb_attribute_group_iterator_valid(RocksDBAttributeGroupIteratorRef iter) {
+  return (iter && iter->iter && iter->iter->Valid()) ? 1 : 0;
+}
+
+void rocksdb_attribute_group_iterator_seek_to_first(RocksDBAttributeGroupIteratorRef iter) {
+  if (iter && iter->iter) {
+    iter->iter->SeekToFirst();
+  }
+}
+
+void rocksdb_attribute_group_iterator_seek_to_last(RocksDBAttributeGroupIteratorRef iter) {
+  if (iter && iter->iter) {
+    iter->iter->SeekToLast();
+  }
+}
+
+void rocksdb_attribute_group_iterator_seek(RocksDBAttributeGroupIteratorRef iter,
+                                           const char* key, size_t key_len) {
+  if (iter && iter->iter) {
+    iter->iter->Seek(rocksdb::Slice(key, key_len));
+  }
+}
+
+void rocksdb_attribute_group_iterator_seek_for_prev(RocksDBAttributeGroupIteratorRef iter,
+                                                    const char* key, size_t key_len) {
+  if (iter && iter->iter) {
+    iter->iter->SeekForPrev(rocksdb::Slice(key, key_len));
+  }
+}
+
+void rocksdb_attribute_group_iterator_next(RocksDBAttributeGroupIteratorRef iter) {
+  if (iter && iter->iter) {
+    iter->iter->Next();
+  }
+}
+
+void rocksdb_attribute_group_iterator_prev(RocksDBAttributeGroupIteratorRef iter) {
+  if (iter && iter->iter) {
+    iter->iter->Prev();
+  }
+}
+
+const char* rocksdb_attribute_group_iterator_key(RocksDBAttributeGroupIteratorRef iter,
+                                                 size_t* len_out) {
+  if (!iter || !iter->iter || !iter->iter->Valid()) {
+    *len_out = 0;
+    return nullptr;
+  }
+
+  rocksdb::Slice key = iter->iter->key();
+  *len_out = key.size();
+  return key.data();
+}
+
+size_t rocksdb_attribute_group_iterator_group_count(RocksDBAttributeGroupIteratorRef iter) {
+  if (!iter || !iter->iter || !iter->iter->Valid()) {
+    return 0;
+  }
+  return iter->iter->attribute_groups().size();
+}
+
+size_t rocksdb_attribute_group_iterator_group_family(RocksDBAttributeGroupIteratorRef iter,
+                                                     size_t group) {
+  if (!iter || !iter->iter || !iter->iter->Valid() ||
+      group >= iter->iter->attribute_groups().size()) {
+    return SIZE_MAX;
+  }
+
+  rocksdb::ColumnFamilyHandle* cf = iter->iter->attribute_groups()[group].column_family();
+  for (size_t i = 0; i < iter->families.size(); i++) {
+    rocksdb::ColumnFamilyHandle* candidate = iter->families[i] ? iter->families[i]->handle : nullptr;
+    if (candidate == cf || (candidate && cf && candidate->GetID() == cf->GetID())) {
+      return i;
+    }
+  }
+  return SIZE_MAX;
+}
+
+size_t rocksdb_attribute_group_iterator_column_count(RocksDBAttributeGroupIteratorRef iter,
+                                                     size_t group) {
+  const rocksdb::WideColumns* columns = attribute_group_columns(iter, group);
+  return columns ? columns->size() : 0;
+}
+
+const char* rocksdb_attribute_group_iterator_column_name(RocksDBAttributeGroupIteratorRef iter,
+                                                         size_t group, size_t index,
+                                                         size_t* len_out) {
+  const rocksdb::WideColumns* columns = attribute_group_columns(iter, group);
+  if (!columns || index >= columns->size()) {
+    *len_out = 0;
+    return nullptr;
+  }
+
+  const rocksdb::Slice& name = (*columns)[index].name();
+  *len_out = name.size();
+  return name.data();
+}
+
+const char* rocksdb_attribute_group_iterator_column_value(RocksDBAttributeGroupIteratorRef iter,
+                                                          size_t group, size_t index,
+                                                          size_t* len_out) {
+  const rocksdb::WideColumns* columns = attribute_group_columns(iter, group);
+  if (!columns || index >= columns->size()) {
+    *len_out = 0;
+    return nullptr;
+  }
+
+  const rocksdb::Slice& value = (*columns)[index].value();
+  *len_out = value.size();
+  return value.data();
+}
+
+RocksDBStatus rocksdb_attribute_group_iterator_status(RocksDBAttributeGroupIteratorRef iter) {
+  if (!iter || !iter->iter) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Iterator is null");
+    return result;
+  }
+  return make_status(iter->iter->status());
+}
+
+// =============================================================================
+// MARK: - Batch Operations
+// =============================================================================
+
+RocksDBBatchRef rocksdb_batch_create(void) {
+  return new RocksDBBatchHandle();
+}
+
+RocksDBBatchRef rocksdb_batch_create_with_capacity(size_t reserved_bytes, size_t max_bytes) {
+  return new RocksDBBatchHandle(reserved_bytes, max_bytes);
+}
+
+void rocksdb_batch_destroy(RocksDBBatchRef batch) {
+  delete batch;
+}
+
+// Accepts every operation, so Iterate only checks that the rep parses and
+// holds as many operations as its header claims
+class BatchRepVerifier : public rocksdb::WriteBatch::Handler {
+ public:
+  rocksdb::Status PutCF(uint32_t, const rocksdb::Slice&, const rocksdb::Slice&) override {
+    return rocksdb::Status::OK();
+  }
+  rocksdb::Status TimedPutCF(uint32_t, const rocksdb::Slice&, const rocksdb::Slice&, uint64_t) override {
+    return rocksdb::Status::OK();
+  }
+  rocksdb::Status PutEntityCF(uint32_t, const rocksdb::Slice&, const rocksdb::Slice&) override {
+    return rocksdb::Status::OK();
+  }
+  rocksdb::Status DeleteCF(uint32_t, const rocksdb::Slice&) override { return rocksdb::Status::OK(); }
+  rocksdb::Status SingleDeleteCF(uint32_t, const rocksdb::Slice&) override { return rocksdb::Status::OK(); }
+  rocksdb::Status DeleteRangeCF(uint32_t, const rocksdb::Slice&, const rocksdb::Slice&) override {
+    return rocksdb::Status::OK();
+  }
+  rocksdb::Status MergeCF(uint32_t, const rocksdb::Slice&, const rocksdb::Slice&) override {
+    return rocksdb::Status::OK();
+  }
+  rocksdb::Status PutBlobIndexCF(uint32_t, const rocksdb::Slice&, const rocksdb::Slice&) override {
+    return rocksdb::Status::OK();
+  }
+  void LogData(const rocksdb::Slice&) override {}
+  rocksdb::Status MarkBeginPrepare(bool) override { return rocksdb::Status::OK(); }
+  rocksdb::Status MarkEndPrepare(const rocksdb::Slice&) override { return rocksdb::Status::OK(); }
+  rocksdb::Status MarkNoop(bool) override { return rocksdb::Status::OK(); }
+  rocksdb::Status MarkRollback(const rocksdb::Slice&) override { return rocksdb::Status::OK(); }
+  rocksdb::Status MarkCommit(const rocksdb::Slice&) override { return rocksdb::Status::OK(); }
+  rocksdb::Status MarkCommitWithTimestamp(const rocksdb::Slice&, const rocksdb::Slice&) override {
+    return rocksdb::Status::OK();
+  }
+};
+
+RocksDBStatus rocksdb_batch_create_from_data(const char* data, size_t len, int verify,
+                                             RocksDBBatchRef* batch_out) {
+  *batch_out = nullptr;
+  // 8-byte sequence number and 4-byte count precede the operations
+  if (!data || len < 12) {
+    return make_status(rocksdb::Status::Corruption("Malformed WriteBatch (too small)"));
+  }
+
+  auto handle = std::make_unique<RocksDBBatchHandle>(std::string(data, len));
+  if (verify) {
+    BatchRepVerifier verifier;
+    rocksdb::Status s = handle->batch.Iterate(&verifier);
+    if (!s.ok()) {
+      return make_status(s);
+    }
+  }
+  *batch_out = handle.release();
+  return make_ok();
+}
+
+void rocksdb_batch_put(RocksDBBatchRef batch,
+                       const char* key, size_t key_len,
+                       const char* value, size_t value_len) {
+  if (batch) {
+    batch->record(batch->batch.Put(rocksdb::Slice(key, key_len), rocksdb::Slice(value, value_len)));
+  }
+}
+
+void rocksdb_batch_put_cf(RocksDBBatchRef batch, RocksDBColumnFamilyRef cf,
+                          const char* key, size_t key_len,
+                          const char* value, size_t value_len) {
+  if (batch) {
+    batch->record(batch->batch.Put(cf ? cf->handle : nullptr,
+                                   rocksdb::Slice(key, key_len), rocksdb::Slice(value, value_len)));
+  }
+}
+
+void rocksdb_batch_merge(RocksDBBatchRef batch,
+                         const char* key, size_t key_len,
+                         const char* value, size_t value_len) {
+  if (batch) {
+    batch->record(batch->batch.Merge(rocksdb::Slice(key, key_len), rocksdb::Slice(value, value_len)));
+  }
+}
+
+void rocksdb_batch_merge_cf(RocksDBBatchRef batch, RocksDBColumnFamilyRef cf,
+                            const char* key, size_t key_len,
+                            const char* value, size_t value_len) {
+  if (batch) {
+    batch->record(batch->batch.Merge(cf ? cf->handle : nullptr,
+                                     rocksdb::Slice(key, key_len), rocksdb::Slice(value, value_len)));
+  }
+}
+
+void rocksdb_batch_delete(RocksDBBatchRef batch,
+                          const char* key, size_t key_len) {
+  if (batch) {
+    batch->record(batch->batch.Delete(rocksdb::Slice(key, key_len)));
+  }
+}
+
+void rocksdb_batch_delete_cf(RocksDBBatchRef batch, RocksDBColumnFamilyRef cf,
+                             const char* key, size_t key_len) {
+  if (batch) {
+    batch->record(batch->batch.Delete(cf ? cf->handle : nullptr, rocksdb::Slice(key, key_len)));
+  }
+}
+
+void rocksdb_batch_single_delete(RocksDBBatchRef batch,
+                                 const char* key, size_t key_len) {
+  if (batch) {
+    batch->record(batch->batch.SingleDelete(rocksdb::Slice(key, key_len)));
+  }
+}
+
+void rocksdb_batch_single_delete_cf(RocksDBBatchRef batch, RocksDBColumnFamilyRef cf,
+                                    const char* key, size_t key_len) {
+  if (batch) {
+    batch->record(batch->batch.SingleDelete(cf ? cf->handle : nullptr,
+                                            rocksdb::Slice(key, key_len)));
+  }
+}
+
+void rocksdb_batch_delete_range(RocksDBBatchRef batch,
+                                const char* start_key, size_t start_key_len,
+                                const char* end_key, size_t end_key_len) {
+  if (batch) {
+    batch->record(batch->batch.DeleteRange(rocksdb::Slice(start_key, start_key_len),
+                                           rocksdb::Slice(end_key, end_key_len)));
+  }
+}
+
+void rocksdb_batch_delete_range_cf(RocksDBBatchRef batch, RocksDBColumnFamilyRef cf,
+                                   const char* start_key, size_t start_key_len,
+                                   const char* end_key, size_t end_key_len) {
+  if (batch) {
+    batch->record(batch->batch.DeleteRange(cf ? cf->handle : nullptr,
+                                           rocksdb::Slice(start_key, start_key_len),
+                                           rocksdb::Slice(end_key, end_key_len)));
+  }
+}
+
+void rocksdb_batch_put_many(RocksDBBatchRef batch, size_t num_entries,
+                            const char* const* keys, const size_t* key_lens,
+                            const char* const* values, const size_t* value_lens) {
+  if (!batch) {
+    return;
+  }
+
+  for (size_t i = 0; i < num_entries && batch->status.ok(); i++) {
+    batch->record(batch->batch.Put(rocksdb::Slice(keys[i], key_lens[i]),
+                                   rocksdb::Slice(values[i], value_lens[i])));
+  }
+}
+
+void rocksdb_batch_put_packed(RocksDBBatchRef batch, const char* buffer,
+                              const size_t* offsets, size_t num_entries) {
+  if (!batch || !buffer || !offsets) {
+    return;
+  }
+
+  for (size_t i = 0; i < num_entries && batch->status.ok(); i++) {
+    size_t key_start = offsets[2 * i];
+    size_t value_start = offsets[2 * i + 1];
+    size_t value_end = offsets[2 * i + 2];
+    batch->record(batch->batch.Put(
+      rocksdb::Slice(buffer + key_start, value_start - key_start),
+      rocksdb::Slice(buffer + value_start, value_end - value_start)));
+  }
+}
+
+void rocksdb_batch_put_parts(RocksDBBatchRef batch,
+                             size_t num_key_parts, const char* const* key_parts,
+                             const size_t* key_part_lens,
+                             size_t num_value_parts, const char* const* value_parts,
+                             const size_t* value_part_lens) {
+  if (!batch) {
+    return;
+  }
+
+  std::vector<rocksdb::Slice> keySlices(num_key_parts);
+  for (size_t i = 0; i < num_key_parts; i++) {
+    keySlices[i] = rocksdb::Slice(key_parts[i], key_part_lens[i]);
+  }
+  std::vector<rocksdb::Slice> valueSlices(num_value_parts);
+  for (size_t i = 0; i < num_value_parts; i++) {
+    valueSlices[i] = rocksdb::Slice(value_parts[i], value_part_lens[i]);
+  }
+
+  batch->record(batch->batch.Put(
+    rocksdb::SliceParts(keySlices.data(), static_cast<int>(num_key_parts)),
+    rocksdb::SliceParts(valueSlices.data(), static_cast<int>(num_value_parts))));
+}
+
+void rocksdb_batch_delete_many(RocksDBBatchRef batch, size_t num_keys,
+                               const char* const* keys, const size_t* key_lens) {
+  if (!batch) {
+    return;
+  }
+
+  for (size_t i = 0; i < num_keys && batch->status.ok(); i++) {
+    batch->record(batch->batch.Delete(rocksdb::Slice(keys[i], key_lens[i])));
+  }
+}
+
+void rocksdb_batch_put_entity_cf(RocksDBBatchRef batch, RocksDBColumnFamilyRef cf,
+                                 const char* key, size_t key_len,
+                                 size_t num_columns,
+                                 const char* const* names, const size_t* name_lens,
+                                 const char* const* values, const size_t* value_lens) {
+  if (!batch) {
+    return;
+  }
+
+  batch->record(batch->batch.PutEntity(
+    cf ? cf->handle : nullptr,
+    rocksdb::Slice(key, key_len),
+    make_columns(num_columns, names, name_lens, values, value_lens)));
+}
+
+void rocksdb_batch_put_attribute_groups(RocksDBBatchRef batch,
+                                        const char* key, size_t key_len,
+                                        size_t num_groups,
+                                        const RocksDBColumnFamilyRef* families,
+                                        const size_t* column_counts,
+                                        const char* const* names, const size_t* name_lens,
+                                        const char* const* values, const size_t* value_lens) {
+  if (!batch) {
+    return;
+  }
+
+  batch->record(batch->batch.PutEntity(
+    rocksdb::Slice(key, key_len),
+    make_attribute_groups(num_groups, families, column_counts,
+                          names, name_lens, values, value_lens)));
+}
+
+void rocksdb_batch_put_with_timestamp_cf(RocksDBBatchRef batch, RocksDBColumnFamilyRef cf,
+                                         const char* key, size_t key_len,
+                                         uint64_t timestamp,
+                                         const char* value, size_t value_len) {
+  if (batch) {
+    std::string ts = encode_timestamp(timestamp);
+    batch->record(batch->batch.Put(cf ? cf->handle : nullptr, rocksdb::Slice(key, key_len),
+                                   rocksdb::Slice(ts), rocksdb::Slice(value, value_len)));
+  }
+}
+
+void rocksdb_batch_delete_with_timestamp_cf(RocksDBBatchRef batch, RocksDBColumnFamilyRef cf,
+                                            const char* key, size_t key_len,
+                                            uint64_t timestamp) {
+  if (batch) {
+    std::string ts = encode_timestamp(timestamp);
+    batch->record(batch->batch.Delete(cf ? cf->handle : nullptr, rocksdb::Slice(key, key_len),
+                                      rocksdb::Slice(ts)));
+  }
+}
+
+void rocksdb_batch_clear(RocksDBBatchRef batch) {
+  if (batch) {
+    batch->batch.Clear();
+    batch->status = rocksdb::Status::OK();
+  }
+}
+
+RocksDBStatus rocksdb_batch_status(RocksDBBatchRef batch) {
+  if (!batch) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Batch is null");
+    return result;
+  }
+  return make_status(batch->status);
+}
+
+size_t rocksdb_batch_count(RocksDBBatchRef batch) {
+  return batch ? batch->batch.Count() : 0;
+}
+
+size_t rocksdb_batch_data_size(RocksDBBatchRef batch) {
+  return batch ? batch->batch.GetDataSize() : 0;
+}
+
+const char* rocksdb_batch_data(RocksDBBatchRef batch, size_t* len_out) {
+  if (!batch) {
+    *len_out = 0;
+    return nullptr;
+  }
+  const std::string& rep = batch->batch.Data();
+  *len_out = rep.size();
+  return rep.data();
+}
+
+RocksDBStatus rocksdb_write_batch(RocksDBRef db, RocksDBWriteOptionsRef opts,
+                                  RocksDBBatchRef batch) {
+  TraceScope trace(RocksDBTraceOpWriteBatch);
+
+  if (!db || !db->db || !batch) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database or batch is null");
+    return result;
+  }
+
+  // Refuse partially built batches instead of silently dropping entries
+  if (!batch->status.ok()) {
+    return make_status(batch->status);
+  }
+
+  const rocksdb::WriteOptions& writeOpts = write_options(opts);
+
+  rocksdb::Status s = trace.engine([&] { return db->db->Write(writeOpts, &batch->batch); });
+  return make_status(s);
+}
+
+// =============================================================================
+// MARK: - Indexed Batch Operations
+// =============================================================================
+
+RocksDBIndexedBatchRef rocksdb_indexed_batch_create(size_t reserved_bytes, int overwrite_key) {
+  return new RocksDBIndexedBatchHandle(reserved_bytes, overwrite_key != 0);
+}
+
+void rocksdb_indexed_batch_destroy(RocksDBIndexedBatchRef batch) {
+  delete batch;
+}
+
+void rocksdb_indexed_batch_put_cf(RocksDBIndexedBatchRef batch, RocksDBColumnFamilyRef cf,
+                                  const char* key, size_t key_len,
+                                  const char* value, size_t value_len) {
+  if (batch) {
+    batch->record(batch->batch.Put(cf ? cf->handle : nullptr,
+                                   rocksdb::Slice(key, key_len), rocksdb::Slice(value, value_len)));
+  }
+}
+
+void rocksdb_indexed_batch_merge_cf(RocksDBIndexedBatchRef batch, RocksDBColumnFamilyRef cf,
+                                    const char* key, size_t key_len,
+                                    const char* value, size_t value_len) {
+  if (batch) {
+    batch->record(batch->batch.Merge(cf ? cf->handle : nullptr,
+                                     rocksdb::Slice(key, key_len), rocksdb::Slice(value, value_len)));
+  }
+}
+
+void rocksdb_indexed_batch_delete_cf(RocksDBIndexedBatchRef batch, RocksDBColumnFamilyRef cf,
+                                     const char* key, size_t key_len) {
+  if (batch) {
+    batch->record(batch->batch.Delete(cf ? cf->handle : nullptr, rocksdb::Slice(key, key_len)));
+  }
+}
+
+void rocksdb_indexed_batch_single_delete_cf(RocksDBIndexedBatchRef batch, RocksDBColumnFamilyRef cf,
+                                            const char* key, size_t key_len) {
+  if (batch) {
+    batch->record(batch->batch.SingleDelete(cf ? cf->handle : nullptr,
+                                            rocksdb::Slice(key, key_len)));
+  }
+}
+
+void rocksdb_indexed_batch_clear(RocksDBIndexedBatchRef batch) {
+  if (batch) {
+    batch->batch.Clear();
+    batch->status = rocksdb::Status::OK();
+  }
+}
+
+RocksDBStatus rocksdb_indexed_batch_status(RocksDBIndexedBatchRef batch) {
+  if (!batch) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Batch is null");
+    return result;
+  }
+  return make_status(batch->status);
+}
+
+size_t rocksdb_indexed_batch_count(RocksDBIndexedBatchRef batch) {
+  return batch ? static_cast<size_t>(batch->batch.GetWriteBatch()->Count()) : 0;
+}
+
+RocksDBStatus rocksdb_indexed_batch_get_pinned_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                                  RocksDBReadOptionsRef opts,
+                                                  RocksDBIndexedBatchRef batch,
+                                                  const char* key, size_t key_len,
+                                                  RocksDBPinnableSliceRef* pinned_out) {
+  *pinned_out = nullptr;
+
+  if (!db || !db->db || !batch) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database or batch is null");
+    return result;
+  }
+
+  auto handle = new RocksDBPinnableSliceHandle();
+  rocksdb::Status s = batch->batch.GetFromBatchAndDB(
+    db->db,
+    read_options(opts),
+    column_family(db, cf),
+    rocksdb::Slice(key, key_len),
+    &handle->value);
+
+  if (s.ok()) {
+    retain_db(db);
+    handle->owner = db;
+    *pinned_out = handle;
+  } else {
+    delete handle;
+  }
+
+  return make_status(s);
+}
+
+RocksDBIteratorRef rocksdb_indexed_batch_create_iterator_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                                            RocksDBReadOptionsRef opts,
+                                                            RocksDBIndexedBatchRef batch) {
+  if (!db || !db->db || !batch) {
+    return nullptr;
+  }
+
+  rocksdb::ColumnFamilyHandle* family = column_family(db, cf);
+
+  auto handle = new RocksDBIteratorHandle();
+  const rocksdb::ReadOptions& readOpts = handle->adopt(read_options(opts));
+  handle->iter = batch->batch.NewIteratorWithBase(family, db->db->NewIterator(readOpts, family),
+                                                  &readOpts);
+  return handle;
+}
+
+RocksDBStatus rocksdb_write_indexed_batch(RocksDBRef db, RocksDBWriteOptionsRef opts,
+                                          RocksDBIndexedBatchRef batch) {
+  if (!db || !db->db || !batch) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database or batch is null");
+    return result;
+  }
+
+  if (!batch->status.ok()) {
+    return make_status(batch->status);
+  }
+
+  rocksdb::Status s = db->db->Write(write_options(opts), batch->batch.GetWriteBatch());
+  return make_status(s);
+}
+
+// =============================================================================
+// MARK: - Iterator Operations
+// =============================================================================
+
+RocksDBIteratorRef rocksdb_iterator_create(RocksDBRef db, RocksDBReadOptionsRef opts) {
+  return rocksdb_iterator_create_cf(db, nullptr, opts);
+}
+
+RocksDBIteratorRef rocksdb_iterator_create_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                              RocksDBReadOptionsRef opts) {
+  if (!db || !db->db) {
+    return nullptr;
+  }
+
+  auto handle = new RocksDBIteratorHandle();
+  const rocksdb::ReadOptions& readOpts = handle->adopt(read_options(opts));
+  handle->iter = db->db->NewIterator(readOpts, column_family(db, cf));
+  return handle;
+}
+
+// Usable iterator: transaction iterators stop working, instead of touching
+// a rewound write batch index, once their transaction moves on
+static bool live(RocksDBIteratorHandle* iter) {
+  return iter && iter->iter && !iter->stale();
+}
+
+void rocksdb_iterator_destroy(RocksDBIteratorRef iter) {
+  delete iter;
+}
+
+int rocksdb_iterator_valid(RocksDBIteratorRef iter) {
+  return (live(iter) && iter->iter->Valid()) ? 1 : 0;
+}
+
+void rocksdb_iterator_seek_to_first(RocksDBIteratorRef iter) {
+  if (live(iter)) {
+    iter->iter->SeekToFirst();
+  }
+}
+
+void rocksdb_iterator_seek_to_last(RocksDBIteratorRef iter) {
+  if (live(iter)) {
+    iter->iter->SeekToLast();
+  }
+}
+
+void rocksdb_iterator_seek(RocksDBIteratorRef iter, const char* key, size_t key_len) {
+  if (live(iter)) {
+    iter->iter->Seek(rocksdb::Slice(key, key_len));
+  }
+}
+
+void rocksdb_iterator_seek_for_prev(RocksDBIteratorRef iter, const char* key, size_t key_len) {
+  if (live(iter)) {
+    iter->iter->SeekForPrev(rocksdb::Slice(key, key_len));
+  }
+}
+
+void rocksdb_iterator_next(RocksDBIteratorRef iter) {
+  if (live(iter)) {
+    iter->iter->Next();
+  }
+}
+
+void rocksdb_iterator_prev(RocksDBIteratorRef iter) {
+  if (live(iter)) {
+    iter->iter->Prev();
+  }
+}
+
+const char* rocksdb_iterator_key(RocksDBIteratorRef iter, size_t* len_out) {
+  if (!live(iter) || !iter->iter->Valid()) {
+    *len_out = 0;
+    return nullptr;
+  }
+
+  rocksdb::Slice key = iter->iter->key();
+  *len_out = key.size();
+  return key.data();
+}
+
+const char* rocksdb_iterator_value(RocksDBIteratorRef iter, size_t* len_out) {
+  if (!live(iter) || !iter->iter->Valid()) {
+    *len_out = 0;
+    return nullptr;
+  }
+
+  rocksdb::Slice value = iter->iter->value();
+  *len_out = value.size();
+  return value.data();
+}
+
+int rocksdb_iterator_timestamp(RocksDBIteratorRef iter, uint64_t* timestamp_out) {
+  *timestamp_out = 0;
+  if (!live(iter) || !iter->iter->Valid()) {
+    return 0;
+  }
+
+  rocksdb::Slice ts = iter->iter->timestamp();
+  if (ts.size() != kTimestampSize) {
+    return 0;
+  }
+  *timestamp_out = decode_timestamp(ts);
+  return 1;
+}
+
+size_t rocksdb_iterator_columns_count(RocksDBIteratorRef iter) {
+  if (!live(iter) || !iter->iter->Valid()) {
+    return 0;
+  }
+  return iter->iter->columns().size();
+}
+
+const char* rocksdb_iterator_column_name(RocksDBIteratorRef iter, size_t index,
+                                         size_t* len_out) {
+  if (!live(iter) || !iter->iter->Valid() || index >= iter->iter->columns().size()) {
+    *len_out = 0;
+    return nullptr;
+  }
+
+  const rocksdb::Slice& name = iter->iter->columns()[index].name();
+  *len_out = name.size();
+  return name.data();
+}
+
+const char* rocksdb_iterator_column_value(RocksDBIteratorRef iter, size_t index,
+                                          size_t* len_out) {
+  if (!live(iter) || !iter->iter->Valid() || index >= iter->iter->columns().size()) {
+    *len_out = 0;
+    return nullptr;
+  }
+
+  const rocksdb::Slice& value = iter->iter->columns()[index].value();
+  *len_out = value.size();
+  return value.data();
+}
+
+// Pack entries accepted by `accept` into buffer, skipping the others; shared
+// by the plain and the filtered batch reads
+template <typename Accept>
+static size_t fill_batch(RocksDBIteratorRef iter,
+                         char* buffer, size_t buffer_size,
+                         size_t max_entries,
+                         size_t* bytes_used_out,
+                         const Accept& accept) {
+  TraceScope trace(RocksDBTraceOpIteratorNextBatch);
+  *bytes_used_out = 0;
+  if (!live(iter)) {
+    return 0;
+  }
+
+  size_t count = 0;
+  size_t used = 0;
+  uint64_t engine_nanos = 0;
+
+  while (count < max_entries && iter->iter->Valid()) {
+    rocksdb::Slice key = iter->iter->key();
+    rocksdb::Slice value = iter->iter->value();
+    if (!accept(key, value)) {
+      iter->iter->Next();
+      continue;
+    }
+    size_t needed = 2 * sizeof(uint32_t) + key.size() + value.size();
+
+    if (used + needed > buffer_size) {
+      if (count == 0) {
+        // Report the size required for the next entry so the caller can grow
+        *bytes_used_out = needed;
+        return 0;
+      }
+      break;
+    }
+
+    uint32_t key_len = static_cast<uint32_t>(key.size());
+    uint32_t value_len = static_cast<uint32_t>(value.size());
+    memcpy(buffer + used, &key_len, sizeof(key_len));
+    used += sizeof(key_len);
+    memcpy(buffer + used, &value_len, sizeof(value_len));
+    used += sizeof(value_len);
+    memcpy(buffer + used, key.data(), key.size());
+    used += key.size();
+    memcpy(buffer + used, value.data(), value.size());
+    used += value.size();
+
+    count++;
+    if (trace.active()) {
+      uint64_t start = trace_clock();
+      iter->iter->Next();
+      engine_nanos += trace_clock() - start;
+    } else {
+      iter->iter->Next();
+    }
+  }
+
+  trace.record_engine(engine_nanos);
+  *bytes_used_out = used;
+  return count;
+}
+
+size_t rocksdb_iterator_next_batch(RocksDBIteratorRef iter,
+                                   char* buffer, size_t buffer_size,
+                                   size_t max_entries,
+                                   size_t* bytes_used_out) {
+  return fill_batch(iter, buffer, buffer_size, max_entries, bytes_used_out,
+                    [](const rocksdb::Slice&, const rocksdb::Slice&) { return true; });
+}
+
+RocksDBStatus rocksdb_iterator_status(RocksDBIteratorRef iter) {
+  if (!iter || !iter->iter) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Iterator is null");
+    return result;
+  }
+  if (iter->stale()) {
+    return make_status(rocksdb::Status::InvalidArgument(
+      "Transaction iterator invalidated by commit, rollback or savepoint rollback"));
+  }
+  return make_status(iter->iter->status());
+}
+
+RocksDBStatus rocksdb_iterator_refresh(RocksDBIteratorRef iter) {
+  if (!iter || !iter->iter) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Iterator is null");
+    return result;
+  }
+  if (iter->txn) {
+    return make_status(rocksdb::Status::NotSupported("Transaction iterators cannot be refreshed"));
+  }
+  return make_status(iter->iter->Refresh());
+}
+
+int rocksdb_iterator_is_key_pinned(RocksDBIteratorRef iter) {
+  if (!iter || !iter->iter || !iter->iter->Valid()) {
+    return 0;
+  }
+  std::string value;
+  return iter->iter->GetProperty("rocksdb.iterator.is-key-pinned", &value).ok() && value == "1";
+}
+
+// =============================================================================
+// MARK: - Range Aggregation
+// =============================================================================
+
+// Field value as a 64-bit pattern, sign-extended for signed fields
+static uint64_t decode_field(const char* data, const RocksDBAggregateFieldSpec& field) {
+  const auto* bytes = reinterpret_cast<const uint8_t*>(data) + field.offset;
+  uint64_t value = 0;
+  for (size_t i = 0; i < field.width; i++) {
+    if (field.byte_order == RocksDBByteOrderBigEndian) {
+      value = (value << 8) | bytes[i];
+    } else {
+      value |= uint64_t(bytes[i]) << (8 * i);
+    }
+  }
+  if (field.is_signed && field.width < 8) {
+    uint64_t sign = uint64_t(1) << (8 * field.width - 1);
+    value = (value ^ sign) - sign;
+  }
+  return value;
+}
+
+RocksDBStatus rocksdb_aggregate_range_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                         RocksDBReadOptionsRef opts,
+                                         const char* start, size_t start_len,
+                                         const char* end, size_t end_len,
+                                         const RocksDBAggregateFieldSpec* field,
+                                         RocksDBAggregateValues* values_out) {
+  memset(values_out, 0, sizeof(*values_out));
+
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+  if (field && field->width != 1 && field->width != 2 && field->width != 4 && field->width != 8) {
+    return make_status(rocksdb::Status::InvalidArgument("Field width must be 1, 2, 4 or 8 bytes"));
+  }
+
+  rocksdb::ReadOptions readOpts = read_options(opts);
+  rocksdb::Slice lower(start ? start : "", start_len);
+  rocksdb::Slice upper(end ? end : "", end_len);
+  readOpts.iterate_lower_bound = start ? &lower : nullptr;
+  readOpts.iterate_upper_bound = end ? &upper : nullptr;
+
+  std::unique_ptr<rocksdb::Iterator> iter(db->db->NewIterator(readOpts, column_family(db, cf)));
+  if (start) {
+    iter->Seek(lower);
+  } else {
+    iter->SeekToFirst();
+  }
+
+  for (; iter->Valid(); iter->Next()) {
+    rocksdb::Slice key = iter->key();
+    rocksdb::Slice value = iter->value();
+    values_out->count++;
+    values_out->key_bytes += key.size();
+    values_out->value_bytes += value.size();
+
+    if (!field || field->width > value.size() || field->offset > value.size() - field->width) {
+      continue;
+    }
+    uint64_t v = decode_field(value.data(), *field);
+    values_out->sum += v;
+    if (values_out->field_count == 0) {
+      values_out->min = v;
+      values_out->max = v;
+    } else if (field->is_signed) {
+      values_out->min = int64_t(v) < int64_t(values_out->min) ? v : values_out->min;
+      values_out->max = int64_t(v) > int64_t(values_out->max) ? v : values_out->max;
+    } else {
+      values_out->min = std::min(values_out->min, v);
+      values_out->max = std::max(values_out->max, v);
+    }
+    values_out->field_count++;
+  }
+
+  return make_status(iter->status());
+}
+
+// =============================================================================
+// MARK: - Scan Predicates
+// =============================================================================
+
+// Size the subtree rooted at nodes[index]; false if it runs past the end
+static bool size_predicate_subtree(std::vector<RocksDBScanPredicateHandle::Node>& nodes,
+                                   size_t index, int depth) {
+  if (index >= nodes.size() || depth > 64) {
+    return false;
+  }
+  auto& node = nodes[index];
+  size_t next = index + 1;
+  for (size_t i = 0; i < node.child_count; i++) {
+    if (!size_predicate_subtree(nodes, next, depth + 1)) {
+      return false;
+    }
+    next += nodes[next].subtree_size;
+  }
+  node.subtree_size = next - index;
+  return true;
+}
+
+RocksDBScanPredicateRef rocksdb_scan_predicate_create(const RocksDBPredicateNode* nodes,
+                                                      size_t num_nodes,
+                                                      char** error_out) {
+  *error_out = nullptr;
+  auto fail = [&](const char* message) -> RocksDBScanPredicateRef {
+    *error_out = strdup(message);
+    return nullptr;
+  };
+
+  auto predicate = std::make_unique<RocksDBScanPredicateHandle>();
+  predicate->nodes.reserve(num_nodes);
+  for (size_t i = 0; i < num_nodes; i++) {
+    const RocksDBPredicateNode& in = nodes[i];
+    RocksDBScanPredicateHandle::Node node{};
+    node.kind = in.kind;
+    node.on_value = in.on_value != 0;
+    node.offset = in.offset;
+    node.from_end = in.from_end != 0;
+    node.op = in.op;
+    node.field = in.field;
+    node.integer = in.integer;
+    node.child_count = in.child_count;
+
+    switch (in.kind) {
+      case RocksDBPredicateAnd:
+      case RocksDBPredicateOr:
+        break;
+      case RocksDBPredicateNot:
+        if (in.child_count != 1) {
+          return fail("Not predicates take exactly one child");
+        }
+        break;
+      case RocksDBPredicateInteger:
+        if (in.field.width != 1 && in.field.width != 2 && in.field.width != 4 && in.field.width != 8) {
+          return fail("Field width must be 1, 2, 4 or 8 bytes");
+        }
+        [[fallthrough]];
+      case RocksDBPredicateBytes:
+      case RocksDBPredicateBytesIn:
+        if (in.child_count != 0) {
+          return fail("Comparison predicates take no children");
+        }
+        if (in.kind == RocksDBPredicateBytes && in.num_operands != 1) {
+          return fail("Byte comparisons take exactly one operand");
+        }
+        break;
+      default:
+        return fail("Unknown predicate kind");
+    }
+    for (size_t j = 0; j < in.num_operands; j++) {
+      node.operands.emplace_back(in.operands[j], in.operand_lens[j]);
+    }
+    predicate->nodes.push_back(std::move(node));
+  }
+
+  if (num_nodes == 0 || !size_predicate_subtree(predicate->nodes, 0, 0) ||
+      predicate->nodes[0].subtree_size != num_nodes) {
+    return fail("Malformed predicate tree");
+  }
+
+  // The operand strings no longer move, so the set can view them
+  for (auto& node : predicate->nodes) {
+    if (node.kind != RocksDBPredicateBytesIn) {
+      continue;
+    }
+    for (const auto& operand : node.operands) {
+      if (node.members.insert(operand).second &&
+          std::find(node.lengths.begin(), node.lengths.end(), operand.size()) == node.lengths.end()) {
+        node.lengths.push_back(operand.size());
+      }
+    }
+  }
+  return predicate.release();
+}
+
+void rocksdb_scan_predicate_destroy(RocksDBScanPredicateRef predicate) {
+  delete predicate;
+}
+
+static bool compare_result(int c, RocksDBCompareOp op) {
+  switch (op) {
+    case RocksDBCompareEqual: return c == 0;
+    case RocksDBCompareNotEqual: return c != 0;
+    case RocksDBCompareLess: return c < 0;
+    case RocksDBCompareLessOrEqual: return c <= 0;
+    case RocksDBCompareGreater: return c > 0;
+    case RocksDBCompareGreaterOrEqual: return c >= 0;
+  }
+  return false;
+}
+
+// Window of `length` bytes the node addresses in target, if it fits
+static bool predicate_window(const RocksDBScanPredicateHandle::Node& node,
+                             const rocksdb::Slice& target, size_t length,
+                             std::string_view* window) {
+  if (target.size() < node.offset || target.size() - node.offset < length) {
+    return false;
+  }
+  size_t start = node.from_end ? target.size() - node.offset - length : node.offset;
+  *window = std::string_view(target.data() + start, length);
+  return true;
+}
+
+static bool evaluate_predicate(const RocksDBScanPredicateHandle& predicate, size_t index,
+                               const rocksdb::Slice& key, const rocksdb::Slice& value) {
+  const auto& node = predicate.nodes[index];
+  const rocksdb::Slice& target = node.on_value ? value : key;
+
+  switch (node.kind) {
+    case RocksDBPredicateAnd:
+    case RocksDBPredicateOr: {
+      bool is_and = node.kind == RocksDBPredicateAnd;
+      size_t child = index + 1;
+      for (size_t i = 0; i < node.child_count; i++) {
+        if (evaluate_predicate(predicate, child, key, value) != is_and) {
+          return !is_and;
+        }
+        child += predicate.nodes[child].subtree_size;
+      }
+      return is_and;
+    }
+    case RocksDBPredicateNot:
+      return !evaluate_predicate(predicate, index + 1, key, value);
+    case RocksDBPredicateBytes: {
+      const std::string& operand = node.operands[0];
+      std::string_view window;
+      if (!predicate_window(node, target, operand.size(), &window)) {
+        return false;
+      }
+      return compare_result(window.compare(operand), node.op);
+    }
+    case RocksDBPredicateInteger: {
+      if (node.field.width > target.size() ||
+          node.field.offset > target.size() - node.field.width) {
+        return false;
+      }
+      uint64_t v = decode_field(target.data(), node.field);
+      int c;
+      if (node.field.is_signed) {
+        c = int64_t(v) < int64_t(node.integer) ? -1 : int64_t(v) > int64_t(node.integer) ? 1 : 0;
+      } else {
+        c = v < node.integer ? -1 : v > node.integer ? 1 : 0;
+      }
+      return compare_result(c, node.op);
+    }
+    case RocksDBPredicateBytesIn:
+      for (size_t length : node.lengths) {
+        std::string_view window;
+        if (predicate_window(node, target, length, &window) && node.members.count(window)) {
+          return true;
+        }
+      }
+      return false;
+  }
+  return false;
+}
+
+size_t rocksdb_iterator_next_batch_filtered(RocksDBIteratorRef iter,
+                                            RocksDBScanPredicateRef predicate,
+                                            char* buffer, size_t buffer_size,
+                                            size_t max_entries,
+                                            size_t* bytes_used_out) {
+  if (!predicate) {
+    return rocksdb_iterator_next_batch(iter, buffer, buffer_size, max_entries, bytes_used_out);
+  }
+  return fill_batch(iter, buffer, buffer_size, max_entries, bytes_used_out,
+                    [&](const rocksdb::Slice& key, const rocksdb::Slice& value) {
+                      return evaluate_predicate(*predicate, 0, key, value);
+                    });
+}
+
+// =============================================================================
+// MARK: - Transaction Operations
+// =============================================================================
+
+RocksDBTransactionRef rocksdb_transaction_begin(RocksDBRef db, RocksDBWriteOptionsRef opts) {
+  return rocksdb_transaction_begin_with_snapshot(db, opts, 0);
+}
+
+RocksDBTransactionRef rocksdb_transaction_begin_with_snapshot(RocksDBRef db,
+                                                              RocksDBWriteOptionsRef opts,
+                                                              int set_snapshot) {
+  return rocksdb_transaction_begin_reusing(db, opts, set_snapshot, nullptr);
+}
+
+RocksDBTransactionRef rocksdb_transaction_begin_reusing(RocksDBRef db,
+                                                        RocksDBWriteOptionsRef opts,
+                                                        int set_snapshot,
+                                                        RocksDBTransactionRef old_txn) {
+  if (!db || !db->is_transactional || !(db->txn_db || db->pessimistic_db)) {
+    return nullptr;
+  }
+
+  const rocksdb::WriteOptions& writeOpts = write_options(opts);
+
+  // BeginTransaction reinitializes and returns old_txn when one is passed
+  // Open iterators still read the old write batch, so leave it to them
+  auto handle = old_txn;
+  if (handle && handle->ref_count.load(std::memory_order_acquire) > 1) {
+    release_transaction(handle);
+    handle = nullptr;
+  }
+  if (!handle) {
+    handle = new RocksDBTransactionHandle();
+    retain_db(db);
+    handle->owner = db;
+  }
+  if (db->pessimistic_db) {
+    rocksdb::TransactionOptions txnOpts = db->txn_options;
+    txnOpts.set_snapshot = (set_snapshot != 0);
+    handle->txn = db->pessimistic_db->BeginTransaction(writeOpts, txnOpts, handle->txn);
+  } else {
+    rocksdb::OptimisticTransactionOptions txnOpts;
+    txnOpts.set_snapshot = (set_snapshot != 0);
+    handle->txn = db->txn_db->BeginTransaction(writeOpts, txnOpts, handle->txn);
+  }
+  handle->default_cf = db->db->DefaultColumnFamily();
+  handle->read_from_snapshot = (set_snapshot != 0);
+  handle->epoch++;
+  return handle;
+}
+
+void rocksdb_transaction_destroy(RocksDBTransactionRef txn) {
+  if (txn) {
+    release_transaction(txn);
+  }
+}
+
+RocksDBStatus rocksdb_transaction_put(RocksDBTransactionRef txn,
+                                      const char* key, size_t key_len,
+                                      const char* value, size_t value_len) {
+  return rocksdb_transaction_put_cf(txn, nullptr, key, key_len, value, value_len);
+}
+
+RocksDBStatus rocksdb_transaction_put_cf(RocksDBTransactionRef txn, RocksDBColumnFamilyRef cf,
+                                         const char* key, size_t key_len,
+                                         const char* value, size_t value_len) {
+  if (!txn || !txn->txn) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Transaction is null");
+    return result;
+  }
+
+  rocksdb::Status s = txn->txn->Put(column_family(txn, cf),
+                                     rocksdb::Slice(key, key_len),
+                                     rocksdb::Slice(value, value_len));
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_transaction_merge(RocksDBTransactionRef txn,
+                                        const char* key, size_t key_len,
+                                        const char* value, size_t value_len) {
+  return rocksdb_transaction_merge_cf(txn, nullptr, key, key_len, value, value_len);
+}
+
+RocksDBStatus rocksdb_transaction_merge_cf(RocksDBTransactionRef txn, RocksDBColumnFamilyRef cf,
+                                           const char* key, size_t key_len,
+                                           const char* value, size_t value_len) {
+  if (!txn || !txn->txn) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Transaction is null");
+    return result;
+  }
+
+  rocksdb::Status s = txn->txn->Merge(column_family(txn, cf),
+                                       rocksdb::Slice(key, key_len),
+                                       rocksdb::Slice(value, value_len));
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_transaction_get(RocksDBTransactionRef txn, RocksDBReadOptionsRef opts,
+                                      const char* key, size_t key_len,
+                                      char** value_out, size_t* value_len_out) {
+  *value_out = nullptr;
+  *value_len_out = 0;
+
+  if (!txn || !txn->txn) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Transaction is null");
+    return result;
+  }
+
+  rocksdb::ReadOptions scratch;
+  const rocksdb::ReadOptions& readOpts = read_options(txn, opts, &scratch);
+
+  std::string value;
+  rocksdb::Status s = txn->txn->Get(readOpts, rocksdb::Slice(key, key_len), &value);
+
+  if (s.ok()) {
+    *value_len_out = value.size();
+    *value_out = static_cast<char*>(malloc(value.size()));
+    if (*value_out) {
+      memcpy(*value_out, value.data(), value.size());
+    }
+  }
+
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_transaction_get_for_update(RocksDBTransactionRef txn, RocksDBReadOptionsRef opts,
+                                                  const char* key, size_t key_len,
+                                                  char** value_out, size_t* value_len_out) {
+  return rocksdb_transaction_get_for_update_cf(txn, nullptr, opts, key, key_len,
+                                               value_out, value_len_out);
+}
+
+RocksDBStatus rocksdb_transaction_get_for_update_cf(RocksDBTransactionRef txn,
+                                                     RocksDBColumnFamilyRef cf,
+                                                     RocksDBReadOptionsRef opts,
+                                                     const char* key, size_t key_len,
+                                                     char** value_out, size_t* value_len_out) {
+  *value_out = nullptr;
+  *value_len_out = 0;
+
+  if (!txn || !txn->txn) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Transaction is null");
+    return result;
+  }
+
+  rocksdb::ReadOptions scratch;
+  const rocksdb::ReadOptions& readOpts = read_options(txn, opts, &scratch);
+
+  std::string value;
+  rocksdb::Status s = txn->txn->GetForUpdate(readOpts, column_family(txn, cf),
+                                              rocksdb::Slice(key, key_len), &value);
+
+  if (s.ok()) {
+    *value_len_out = value.size();
+    *value_out = static_cast<char*>(malloc(value.size()));
+    if (*value_out) {
+      memcpy(*value_out, value.data(), value.size());
+    }
+  }
+
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_transaction_get_pinned(RocksDBTransactionRef txn, RocksDBReadOptionsRef opts,
+                                             const char* key, size_t key_len,
+                                             RocksDBPinnableSliceRef* pinned_out) {
+  return rocksdb_transaction_get_pinned_cf(txn, nullptr, opts, key, key_len, pinned_out);
+}
+
+RocksDBStatus rocksdb_transaction_get_pinned_cf(RocksDBTransactionRef txn,
+                                                RocksDBColumnFamilyRef cf,
+                                                RocksDBReadOptionsRef opts,
+                                                const char* key, size_t key_len,
+                                                RocksDBPinnableSliceRef* pinned_out) {
+  *pinned_out = nullptr;
+
+  if (!txn || !txn->txn) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Transaction is null");
+    return result;
+  }
+
+  rocksdb::ReadOptions scratch;
+  const rocksdb::ReadOptions& readOpts = read_options(txn, opts, &scratch);
+
+  auto handle = new RocksDBPinnableSliceHandle();
+  rocksdb::Status s = txn->txn->Get(readOpts, column_family(txn, cf),
+                                     rocksdb::Slice(key, key_len), &handle->value);
+
+  if (s.ok()) {
+    // The value may point into the database's blocks, which outlive the transaction
+    if (txn->owner) {
+      retain_db(txn->owner);
+      handle->owner = txn->owner;
+    }
+    *pinned_out = handle;
+  } else {
+    delete handle;
+  }
+
+  return make_status(s);
+}
+
+// Null-transaction guard shared by the batched transaction reads
+static bool check_transaction(RocksDBTransactionRef txn, size_t num_keys,
+                              RocksDBPinnableSliceRef* values_out,
+                              RocksDBStatus* statuses_out) {
+  for (size_t i = 0; i < num_keys; i++) {
+    values_out[i] = nullptr;
+  }
+  if (txn && txn->txn) {
+    return true;
+  }
+  for (size_t i = 0; i < num_keys; i++) {
+    statuses_out[i].code = RocksDBStatusInvalidArgument;
+    statuses_out[i].message = strdup("Transaction is null");
+  }
+  return false;
+}
+
+void rocksdb_transaction_multi_get_cf(RocksDBTransactionRef txn, RocksDBColumnFamilyRef cf,
+                                      RocksDBReadOptionsRef opts,
+                                      size_t num_keys,
+                                      const char* const* keys, const size_t* key_lens,
+                                      RocksDBPinnableSliceRef* values_out,
+                                      RocksDBStatus* statuses_out) {
+  if (!check_transaction(txn, num_keys, values_out, statuses_out) || num_keys == 0) {
+    return;
+  }
+
+  rocksdb::ReadOptions scratch;
+  const rocksdb::ReadOptions& readOpts = read_options(txn, opts, &scratch);
+
+  std::vector<rocksdb::Slice> keySlices;
+  keySlices.reserve(num_keys);
+  for (size_t i = 0; i < num_keys; i++) {
+    keySlices.emplace_back(keys[i], key_lens[i]);
+  }
+
+  std::vector<rocksdb::PinnableSlice> values(num_keys);
+  std::vector<rocksdb::Status> statuses(num_keys);
+
+  txn->txn->MultiGet(readOpts, column_family(txn, cf), num_keys,
+                     keySlices.data(), values.data(), statuses.data());
+
+  export_multi_get(values, statuses, txn->owner, values_out, statuses_out);
+}
+
+void rocksdb_transaction_multi_get_for_update_cf(RocksDBTransactionRef txn,
+                                                 RocksDBColumnFamilyRef cf,
+                                                 RocksDBReadOptionsRef opts,
+                                                 size_t num_keys,
+                                                 const char* const* keys, const size_t* key_lens,
+                                                 RocksDBPinnableSliceRef* values_out,
+                                                 RocksDBStatus* statuses_out) {
+  if (!check_transaction(txn, num_keys, values_out, statuses_out) || num_keys == 0) {
+    return;
+  }
+
+  rocksdb::ReadOptions scratch;
+  const rocksdb::ReadOptions& readOpts = read_options(txn, opts, &scratch);
+
+  std::vector<rocksdb::Slice> keySlices;
+  keySlices.reserve(num_keys);
+  for (size_t i = 0; i < num_keys; i++) {
+    keySlices.emplace_back(keys[i], key_lens[i]);
+  }
+
+  std::vector<std::string> strings(num_keys);
+  std::vector<rocksdb::Status> statuses = txn->txn->MultiGetForUpdate(
+    readOpts,
+    std::vector<rocksdb::ColumnFamilyHandle*>(num_keys, column_family(txn, cf)),
+    keySlices, &strings);
+
+  // Move each value into a self-pinned slice to share the export path
+  std::vector<rocksdb::PinnableSlice> values(num_keys);
+  for (size_t i = 0; i < num_keys; i++) {
+    if (statuses[i].ok()) {
+      *values[i].GetSelf() = std::move(strings[i]);
+      values[i].PinSelf();
+    }
+  }
+
+  export_multi_get(values, statuses, txn->owner, values_out, statuses_out);
+}
+
+RocksDBStatus rocksdb_transaction_delete(RocksDBTransactionRef txn,
+                                         const char* key, size_t key_len) {
+  return rocksdb_transaction_delete_cf(txn, nullptr, key, key_len);
+}
+
+RocksDBStatus rocksdb_transaction_delete_cf(RocksDBTransactionRef txn, RocksDBColumnFamilyRef cf,
+                                            const char* key, size_t key_len) {
+  if (!txn || !txn->txn) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Transaction is null");
+    return result;
+  }
+
+  rocksdb::Status s = txn->txn->Delete(column_family(txn, cf), rocksdb::Slice(key, key_len));
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_transaction_single_delete(RocksDBTransactionRef txn,
+                                                const char* key, size_t key_len) {
+  return rocksdb_transaction_single_delete_cf(txn, nullptr, key, key_len);
+}
+
+RocksDBStatus rocksdb_transaction_single_delete_cf(RocksDBTransactionRef txn,
+                                                   RocksDBColumnFamilyRef cf,
+                                                   const char* key, size_t key_len) {
+  if (!txn || !txn->txn) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Transaction is null");
+    return result;
+  }
+
+  rocksdb::Status s = txn->txn->SingleDelete(column_family(txn, cf), rocksdb::Slice(key, key_len));
+  return make_status(s);
+}
+
+RocksDBIteratorRef rocksdb_transaction_create_iterator(RocksDBTransactionRef txn,
+                                                        RocksDBReadOptionsRef opts) {
+  return rocksdb_transaction_create_iterator_cf(txn, nullptr, opts);
+}
+
+RocksDBIteratorRef rocksdb_transaction_create_iterator_cf(RocksDBTransactionRef txn,
+                                                           RocksDBColumnFamilyRef cf,
+                                                           RocksDBReadOptionsRef opts) {
+  if (!txn || !txn->txn) {
+    return nullptr;
+  }
+
+  rocksdb::ReadOptions scratch;
+  auto handle = new RocksDBIteratorHandle();
+  const rocksdb::ReadOptions& readOpts = handle->adopt(read_options(txn, opts, &scratch));
+  handle->iter = txn->txn->GetIterator(readOpts, column_family(txn, cf));
+  txn->ref_count.fetch_add(1, std::memory_order_relaxed);
+  handle->txn = txn;
+  handle->epoch = txn->epoch;
+  return handle;
+}
+
+RocksDBStatus rocksdb_transaction_set_name(RocksDBTransactionRef txn, const char* name) {
+  if (!txn || !txn->txn) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Transaction is null");
+    return result;
+  }
+
+  // Without allow_2pc a prepared transaction would not be recovered
+  if (!txn->owner || !txn->owner->two_phase_commit) {
+    return make_status(rocksdb::Status::NotSupported(
+        "Transactions can only be named in a database opened with two-phase commit"));
+  }
+
+  rocksdb::Status s = txn->txn->SetName(name ? name : "");
+  return make_status(s);
+}
+
+char* rocksdb_transaction_get_name(RocksDBTransactionRef txn) {
+  if (!txn || !txn->txn) {
+    return strdup("");
+  }
+  return strdup(txn->txn->GetName().c_str());
+}
+
+RocksDBStatus rocksdb_transaction_prepare(RocksDBTransactionRef txn) {
+  if (!txn || !txn->txn) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Transaction is null");
+    return result;
+  }
+
+  rocksdb::Status s = txn->txn->Prepare();
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_transaction_commit(RocksDBTransactionRef txn) {
+  if (!txn || !txn->txn) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Transaction is null");
+    return result;
+  }
+
+  rocksdb::Status s = txn->txn->Commit();
+  txn->epoch++;
+  return make_status(s);
+}
+
+void rocksdb_transaction_rollback(RocksDBTransactionRef txn) {
+  if (txn && txn->txn) {
+    txn->txn->Rollback();
+    txn->epoch++;
+  }
+}
+
+RocksDBStatus rocksdb_get_prepared_transactions(RocksDBRef db, RocksDBTransactionRef** txns_out,
+                                                size_t* count_out) {
+  *txns_out = nullptr;
+  *count_out = 0;
+
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  if (!db->pessimistic_db) {
+    return make_status(rocksdb::Status::NotSupported("Not a pessimistic transaction database"));
+  }
+
+  // Ownership passes to the caller, so each recovered transaction is
+  // handed out once; live prepared transactions already have an owner
+  std::vector<rocksdb::Transaction*> prepared;
+  {
+    std::lock_guard<std::mutex> lock(db->recovered_mutex);
+    prepared.swap(db->recovered_txns);
+  }
+  if (prepared.empty()) {
+    return make_ok();
+  }
+
+  auto txns = static_cast<RocksDBTransactionRef*>(malloc(prepared.size() * sizeof(RocksDBTransactionRef)));
+  for (size_t i = 0; i < prepared.size(); i++) {
+    auto handle = new RocksDBTransactionHandle();
+    handle->txn = prepared[i];
+    handle->default_cf = db->db->DefaultColumnFamily();
+    retain_db(db);
+    handle->owner = db;
+    txns[i] = handle;
+  }
+  *txns_out = txns;
+  *count_out = prepared.size();
+  return make_ok();
+}
+
+void rocksdb_transaction_set_savepoint(RocksDBTransactionRef txn) {
+  if (txn && txn->txn) {
+    txn->txn->SetSavePoint();
+  }
+}
+
+RocksDBStatus rocksdb_transaction_rollback_to_savepoint(RocksDBTransactionRef txn) {
+  if (!txn || !txn->txn) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Transaction is null");
+    return result;
+  }
+
+  rocksdb::Status s = txn->txn->RollbackToSavePoint();
+  txn->epoch++;
+  return make_status(s);
+}
+
+// =============================================================================
+// MARK: - External SST Files
+// =============================================================================
+
+RocksDBIngestOptionsRef rocksdb_ingest_options_create(void) {
+  return new RocksDBIngestOptionsHandle();
+}
+
+void rocksdb_ingest_options_destroy(RocksDBIngestOptionsRef opts) {
+  delete opts;
+}
+
+void rocksdb_ingest_options_set_move_files(RocksDBIngestOptionsRef opts, int value) {
+  opts->options.move_files = (value != 0);
+}
+
+void rocksdb_ingest_options_set_snapshot_consistency(RocksDBIngestOptionsRef opts, int value) {
+  opts->options.snapshot_consistency = (value != 0);
+}
+
+void rocksdb_ingest_options_set_allow_global_seqno(RocksDBIngestOptionsRef opts, int value) {
+  opts->options.allow_global_seqno = (value != 0);
+}
+
+void rocksdb_ingest_options_set_allow_blocking_flush(RocksDBIngestOptionsRef opts, int value) {
+  opts->options.allow_blocking_flush = (value != 0);
+}
+
+void rocksdb_ingest_options_set_ingest_behind(RocksDBIngestOptionsRef opts, int value) {
+  opts->options.ingest_behind = (value != 0);
+}
+
+void rocksdb_ingest_options_set_verify_checksums_before_ingest(RocksDBIngestOptionsRef opts, int value) {
+  opts->options.verify_checksums_before_ingest = (value != 0);
+}
+
+RocksDBSstFileWriterRef rocksdb_sst_file_writer_create(RocksDBOptionsRef opts) {
+  auto handle = new RocksDBSstFileWriterHandle();
+  if (opts) {
+    handle->options = opts->options;
+  }
+  handle->writer = std::make_unique<rocksdb::SstFileWriter>(rocksdb::EnvOptions(), handle->options);
+  return handle;
+}
+
+void rocksdb_sst_file_writer_destroy(RocksDBSstFileWriterRef writer) {
+  delete writer;
+}
+
+RocksDBStatus rocksdb_sst_file_writer_open(RocksDBSstFileWriterRef writer, const char* path) {
+  if (!writer || !writer->writer) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("SST file writer is null");
+    return result;
+  }
+
+  rocksdb::Status s = writer->writer->Open(path);
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_sst_file_writer_put(RocksDBSstFileWriterRef writer,
+                                          const char* key, size_t key_len,
+                                          const char* value, size_t value_len) {
+  if (!writer || !writer->writer) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("SST file writer is null");
+    return result;
+  }
+
+  rocksdb::Status s = writer->writer->Put(rocksdb::Slice(key, key_len),
+                                          rocksdb::Slice(value, value_len));
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_sst_file_writer_merge(RocksDBSstFileWriterRef writer,
+                                            const char* key, size_t key_len,
+                                            const char* value, size_t value_len) {
+  if (!writer || !writer->writer) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("SST file writer is null");
+    return result;
+  }
+
+  rocksdb::Status s = writer->writer->Merge(rocksdb::Slice(key, key_len),
+                                            rocksdb::Slice(value, value_len));
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_sst_file_writer_delete(RocksDBSstFileWriterRef writer,
+                                             const char* key, size_t key_len) {
+  if (!writer || !writer->writer) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("SST file writer is null");
+    return result;
+  }
+
+  rocksdb::Status s = writer->writer->Delete(rocksdb::Slice(key, key_len));
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_sst_file_writer_delete_range(RocksDBSstFileWriterRef writer,
+                                                   const char* start_key, size_t start_key_len,
+                                                   const char* end_key, size_t end_key_len) {
+  if (!writer || !writer->writer) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("SST file writer is null");
+    return result;
+  }
+
+  rocksdb::Status s = writer->writer->DeleteRange(rocksdb::Slice(start_key, start_key_len),
+                                                  rocksdb::Slice(end_key, end_key_len));
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_sst_file_writer_finish(RocksDBSstFileWriterRef writer,
+                                             uint64_t* file_size_out,
+                                             uint64_t* num_entries_out) {
+  if (!writer || !writer->writer) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("SST file writer is null");
+    return result;
+  }
+
+  rocksdb::ExternalSstFileInfo info;
+  rocksdb::Status s = writer->writer->Finish(&info);
+  if (s.ok()) {
+    if (file_size_out) {
+      *file_size_out = info.file_size;
+    }
+    if (num_entries_out) {
+      *num_entries_out = info.num_entries;
+    }
+  }
+  return make_status(s);
+}
+
+uint64_t rocksdb_sst_file_writer_file_size(RocksDBSstFileWriterRef writer) {
+  return (writer && writer->writer) ? writer->writer->FileSize() : 0;
+}
+
+RocksDBStatus rocksdb_ingest_external_file(RocksDBRef db,
+                                           const char* const* paths, size_t num_paths,
+                                           RocksDBIngestOptionsRef opts) {
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  std::vector<std::string> files;
+  files.reserve(num_paths);
+  for (size_t i = 0; i < num_paths; i++) {
+    files.emplace_back(paths[i]);
+  }
+
+  rocksdb::IngestExternalFileOptions defaults;
+  rocksdb::Status s = db->db->IngestExternalFile(files, opts ? opts->options : defaults);
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_export_range_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                      RocksDBReadOptionsRef opts,
+                                      const char* start, size_t start_len,
+                                      const char* end, size_t end_len,
+                                      const char* directory, uint64_t target_file_size,
+                                      char*** paths_out, size_t* count_out) {
+  *paths_out = nullptr;
+  *count_out = 0;
+
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  rocksdb::ColumnFamilyHandle* family = column_family(db, cf);
+  rocksdb::Env* env = db->db->GetEnv();
+  rocksdb::Status s = env->CreateDirIfMissing(directory);
+  if (!s.ok()) {
+    return make_status(s);
+  }
+
+  rocksdb::ReadOptions readOpts = read_options(opts);
+  readOpts.fill_cache = false;
+  rocksdb::Slice lower(start ? start : "", start_len);
+  rocksdb::Slice upper(end ? end : "", end_len);
+  readOpts.iterate_lower_bound = start ? &lower : nullptr;
+  readOpts.iterate_upper_bound = end ? &upper : nullptr;
+
+  std::unique_ptr<rocksdb::Iterator> iter(db->db->NewIterator(readOpts, family));
+  if (start) {
+    iter->Seek(lower);
+  } else {
+    iter->SeekToFirst();
+  }
+
+  // No family handle: the files carry no column family id, so the target
+  // may ingest them into any family
+  rocksdb::SstFileWriter writer(rocksdb::EnvOptions(), db->db->GetOptions(family));
+  std::vector<std::string> paths;
+  bool open = false;
+  for (; s.ok() && iter->Valid(); iter->Next()) {
+    if (!open) {
+      char name[32];
+      snprintf(name, sizeof(name), "/export-%06zu.sst", paths.size() + 1);
+      paths.push_back(std::string(directory) + name);
+      s = writer.Open(paths.back());
+      open = s.ok();
+    }
+    if (s.ok()) {
+      s = writer.Put(iter->key(), iter->value());
+    }
+    if (s.ok() && target_file_size > 0 && writer.FileSize() >= target_file_size) {
+      s = writer.Finish();
+      open = false;
+    }
+  }
+  if (s.ok()) {
+    s = iter->status();
+  }
+  if (s.ok() && open) {
+    s = writer.Finish();
+  }
+
+  if (!s.ok()) {
+    for (const auto& path : paths) {
+      env->DeleteFile(path).PermitUncheckedError();
+    }
+    return make_status(s);
+  }
+
+  if (!paths.empty()) {
+    *paths_out = static_cast<char**>(malloc(paths.size() * sizeof(char*)));
+    for (size_t i = 0; i < paths.size(); i++) {
+      (*paths_out)[i] = strdup(paths[i].c_str());
+    }
+    *count_out = paths.size();
+  }
+  return make_status(s);
+}
+
+// =============================================================================
+// MARK: - Snapshot Operations
+// =============================================================================
+
+RocksDBSnapshotRef rocksdb_create_snapshot(RocksDBRef db) {
+  if (!db || !db->db) {
+    return nullptr;
+  }
+
+  auto handle = new RocksDBSnapshotHandle();
+  handle->snapshot = db->db->GetSnapshot();
+  return handle;
+}
+
+void rocksdb_release_snapshot(RocksDBRef db, RocksDBSnapshotRef snapshot) {
+  if (db && db->db && snapshot && snapshot->snapshot) {
+    db->db->ReleaseSnapshot(snapshot->snapshot);
+  }
+  delete snapshot;
+}
+
+uint64_t rocksdb_snapshot_sequence_number(RocksDBSnapshotRef snapshot) {
+  if (!snapshot || !snapshot->snapshot) {
+    return 0;
+  }
+  return snapshot->snapshot->GetSequenceNumber();
+}
+
+void rocksdb_get_snapshot_stats(RocksDBRef db, uint64_t* count_out, uint64_t* oldest_time_out) {
+  *count_out = 0;
+  *oldest_time_out = 0;
+  if (!db || !db->db) {
+    return;
+  }
+
+  db->db->GetIntProperty(rocksdb::DB::Properties::kNumSnapshots, count_out);
+  db->db->GetIntProperty(rocksdb::DB::Properties::kOldestSnapshotTime, oldest_time_out);
+}
+
+// =============================================================================
+// MARK: - Maintenance Operations
+// =============================================================================
+
+RocksDBStatus rocksdb_compact_range(RocksDBRef db,
+                                    const char* start_key, size_t start_key_len,
+                                    const char* end_key, size_t end_key_len) {
+  return rocksdb_compact_range_cf(db, nullptr, start_key, start_key_len, end_key, end_key_len);
+}
+
+RocksDBStatus rocksdb_compact_range_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                       const char* start_key, size_t start_key_len,
+                                       const char* end_key, size_t end_key_len) {
+  return rocksdb_compact_range_opt_cf(db, cf, nullptr, start_key, start_key_len,
+                                      end_key, end_key_len);
+}
+
+RocksDBCompactRangeOptionsRef rocksdb_compact_range_options_create(void) {
+  return new RocksDBCompactRangeOptionsHandle();
+}
+
+void rocksdb_compact_range_options_destroy(RocksDBCompactRangeOptionsRef opts) {
+  delete opts;
+}
+
+void rocksdb_compact_range_options_set_exclusive_manual_compaction(RocksDBCompactRangeOptionsRef opts, int value) {
+  opts->options.exclusive_manual_compaction = (value != 0);
+}
+
+void rocksdb_compact_range_options_set_max_subcompactions(RocksDBCompactRangeOptionsRef opts, uint32_t value) {
+  opts->options.max_subcompactions = value;
+}
+
+void rocksdb_compact_range_options_set_bottommost_level_compaction(RocksDBCompactRangeOptionsRef opts, int value) {
+  switch (value) {
+    case RocksDBBottommostSkip:
+      opts->options.bottommost_level_compaction = rocksdb::BottommostLevelCompaction::kSkip;
+      break;
+    case RocksDBBottommostForce:
+      opts->options.bottommost_level_compaction = rocksdb::BottommostLevelCompaction::kForce;
+      break;
+    case RocksDBBottommostForceOptimized:
+      opts->options.bottommost_level_compaction = rocksdb::BottommostLevelCompaction::kForceOptimized;
+      break;
+    default:
+      opts->options.bottommost_level_compaction = rocksdb::BottommostLevelCompaction::kIfHaveCompactionFilter;
+      break;
+  }
+}
+
+void rocksdb_compact_range_options_set_change_level(RocksDBCompactRangeOptionsRef opts, int value) {
+  opts->options.change_level = (value != 0);
+}
+
+void rocksdb_compact_range_options_set_target_level(RocksDBCompactRangeOptionsRef opts, int level) {
+  opts->options.target_level = level;
+}
+
+void rocksdb_compact_range_options_set_allow_write_stall(RocksDBCompactRangeOptionsRef opts, int value) {
+  opts->options.allow_write_stall = (value != 0);
+}
+
+void rocksdb_compact_range_options_set_canceled(RocksDBCompactRangeOptionsRef opts, RocksDBCancelFlagRef flag) {
+  opts->options.canceled = flag ? &flag->canceled : nullptr;
+}
+
+RocksDBCancelFlagRef rocksdb_cancel_flag_create(void) {
+  return new RocksDBCancelFlagHandle();
+}
+
+void rocksdb_cancel_flag_destroy(RocksDBCancelFlagRef flag) {
+  delete flag;
+}
+
+void rocksdb_cancel_flag_set(RocksDBCancelFlagRef flag, int value) {
+  flag->canceled.store(value != 0, std::memory_order_release);
+}
+
+int rocksdb_cancel_flag_get(RocksDBCancelFlagRef flag) {
+  return flag->canceled.load(std::memory_order_acquire) ? 1 : 0;
+}
+
+RocksDBStatus rocksdb_compact_range_opt_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                           RocksDBCompactRangeOptionsRef opts,
+                                           const char* start_key, size_t start_key_len,
+                                           const char* end_key, size_t end_key_len) {
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  static const rocksdb::CompactRangeOptions kDefaultCompactRangeOptions;
+  const rocksdb::CompactRangeOptions& compactOpts = opts ? opts->options : kDefaultCompactRangeOptions;
+
+  rocksdb::Slice* start = nullptr;
+  rocksdb::Slice* end = nullptr;
+  rocksdb::Slice startSlice, endSlice;
+
+  if (start_key && start_key_len > 0) {
+    startSlice = rocksdb::Slice(start_key, start_key_len);
+    start = &startSlice;
+  }
+  if (end_key && end_key_len > 0) {
+    endSlice = rocksdb::Slice(end_key, end_key_len);
+    end = &endSlice;
+  }
+
+  rocksdb::Status s = db->db->CompactRange(compactOpts, column_family(db, cf), start, end);
+  return make_status(s);
+}
+
+RocksDBCompactionOptionsRef rocksdb_compaction_options_create(void) {
+  return new RocksDBCompactionOptionsHandle();
+}
+
+void rocksdb_compaction_options_destroy(RocksDBCompactionOptionsRef opts) {
+  delete opts;
+}
+
+void rocksdb_compaction_options_set_compression(RocksDBCompactionOptionsRef opts, int type) {
+  opts->options.compression = type < 0 ? rocksdb::kDisableCompressionOption
+                                       : static_cast<rocksdb::CompressionType>(type);
+}
+
+void rocksdb_compaction_options_set_output_file_size_limit(RocksDBCompactionOptionsRef opts, uint64_t limit) {
+  opts->options.output_file_size_limit = limit == 0 ? std::numeric_limits<uint64_t>::max() : limit;
+}
+
+void rocksdb_compaction_options_set_max_subcompactions(RocksDBCompactionOptionsRef opts, uint32_t value) {
+  opts->options.max_subcompactions = value;
+}
+
+RocksDBStatus rocksdb_compact_files_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                       RocksDBCompactionOptionsRef opts,
+                                       const char* const* file_names, size_t num_files,
+                                       int output_level,
+                                       char*** output_files_out, size_t* output_count_out) {
+  if (output_files_out) *output_files_out = nullptr;
+  if (output_count_out) *output_count_out = 0;
+
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  static const rocksdb::CompactionOptions kDefaultCompactionOptions;
+  const rocksdb::CompactionOptions& compactOpts = opts ? opts->options : kDefaultCompactionOptions;
+
+  std::vector<std::string> inputs(file_names, file_names + num_files);
+  std::vector<std::string> outputs;
+  rocksdb::Status s = db->db->CompactFiles(compactOpts, column_family(db, cf), inputs,
+                                           output_level, -1, &outputs);
+  if (!s.ok()) {
+    return make_status(s);
+  }
+
+  if (output_files_out && output_count_out && !outputs.empty()) {
+    auto paths = static_cast<char**>(malloc(outputs.size() * sizeof(char*)));
+    for (size_t i = 0; i < outputs.size(); i++) {
+      paths[i] = strdup(outputs[i].c_str());
+    }
+    *output_files_out = paths;
+    *output_count_out = outputs.size();
+  }
+  return make_ok();
+}
+
+RocksDBStatus rocksdb_delete_files_in_ranges(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                             size_t num_ranges,
+                                             const char* const* bounds,
+                                             const size_t* bound_lens,
+                                             int include_end) {
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  std::vector<rocksdb::Slice> slices(2 * num_ranges);
+  std::vector<rocksdb::RangePtr> ranges(num_ranges);
+  for (size_t i = 0; i < num_ranges; i++) {
+    const rocksdb::Slice* limits[2] = {nullptr, nullptr};
+    for (size_t j = 0; j < 2; j++) {
+      size_t index = 2 * i + j;
+      if (bounds[index]) {
+        slices[index] = rocksdb::Slice(bounds[index], bound_lens[index]);
+        limits[j] = &slices[index];
+      }
+    }
+    ranges[i] = rocksdb::RangePtr(limits[0], limits[1]);
+  }
+
+  rocksdb::Status s = rocksdb::DeleteFilesInRanges(db->db, column_family(db, cf),
+                                                   ranges.data(), num_ranges,
+                                                   include_end != 0);
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_flush(RocksDBRef db, int wait) {
+  return rocksdb_flush_cf(db, nullptr, wait);
+}
+
+RocksDBStatus rocksdb_flush_cf(RocksDBRef db, RocksDBColumnFamilyRef cf, int wait) {
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  rocksdb::FlushOptions flushOpts;
+  flushOpts.wait = (wait != 0);
+
+  rocksdb::Status s = db->db->Flush(flushOpts, column_family(db, cf));
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_flush_wal(RocksDBRef db, int sync) {
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  rocksdb::Status s = db->db->FlushWAL(sync != 0);
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_sync_wal(RocksDBRef db) {
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  rocksdb::Status s = db->db->SyncWAL();
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_pause_background_work(RocksDBRef db) {
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  return make_status(db->db->PauseBackgroundWork());
+}
+
+RocksDBStatus rocksdb_continue_background_work(RocksDBRef db) {
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  return make_status(db->db->ContinueBackgroundWork());
+}
+
+void rocksdb_disable_manual_compaction(RocksDBRef db) {
+  if (db && db->db) {
+    db->db->DisableManualCompaction();
+  }
+}
+
+void rocksdb_enable_manual_compaction(RocksDBRef db) {
+  if (db && db->db) {
+    db->db->EnableManualCompaction();
+  }
+}
+
+RocksDBStatus rocksdb_set_disable_auto_compactions_cf(RocksDBRef db, RocksDBColumnFamilyRef cf, int value) {
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  rocksdb::Status s = db->db->SetOptions(column_family(db, cf),
+                                         {{"disable_auto_compactions", value != 0 ? "true" : "false"}});
+  return make_status(s);
+}
+
+int rocksdb_get_level0_slowdown_writes_trigger_cf(RocksDBRef db, RocksDBColumnFamilyRef cf) {
+  if (!db || !db->db) {
+    return -1;
+  }
+
+  return db->db->GetOptions(column_family(db, cf)).level0_slowdown_writes_trigger;
+}
+
+static std::unordered_map<std::string, std::string> option_map(size_t count,
+                                                              const char* const* names,
+                                                              const char* const* values) {
+  std::unordered_map<std::string, std::string> options;
+  for (size_t i = 0; i < count; i++) {
+    options[names[i]] = values[i];
+  }
+  return options;
+}
+
+RocksDBStatus rocksdb_set_options_cf(RocksDBRef db, RocksDBColumnFamilyRef cf, size_t count,
+                                     const char* const* names, const char* const* values) {
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  rocksdb::Status s = db->db->SetOptions(column_family(db, cf), option_map(count, names, values));
+  return make_status(s);
+}
+
+RocksDBStatus rocksdb_set_db_options(RocksDBRef db, size_t count,
+                                     const char* const* names, const char* const* values) {
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  rocksdb::Status s = db->db->SetDBOptions(option_map(count, names, values));
+  return make_status(s);
+}
+
+char* rocksdb_get_options_string_cf(RocksDBRef db, RocksDBColumnFamilyRef cf) {
+  if (!db || !db->db) {
+    return nullptr;
+  }
+
+  RocksDBOptionsHandle current;
+  current.options = db->db->GetOptions(column_family(db, cf));
+  return rocksdb_options_get_string(&current);
+}
+
+RocksDBStatus rocksdb_get_write_stall_state_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                               RocksDBWriteStallValues* state_out) {
+  memset(state_out, 0, sizeof(*state_out));
+
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  rocksdb::ColumnFamilyHandle* family = column_family(db, cf);
+  const rocksdb::Options options = db->db->GetOptions(family);
+  state_out->l0_slowdown_trigger = options.level0_slowdown_writes_trigger;
+  state_out->l0_stop_trigger = options.level0_stop_writes_trigger;
+  state_out->max_write_buffer_number = options.max_write_buffer_number;
+  state_out->soft_pending_compaction_bytes_limit = options.soft_pending_compaction_bytes_limit;
+  state_out->hard_pending_compaction_bytes_limit = options.hard_pending_compaction_bytes_limit;
+
+  uint64_t value = 0;
+  if (db->db->GetIntProperty(rocksdb::DB::Properties::kIsWriteStopped, &value)) {
+    state_out->is_write_stopped = value != 0 ? 1 : 0;
+  }
+  db->db->GetIntProperty(rocksdb::DB::Properties::kActualDelayedWriteRate, &state_out->delayed_write_rate);
+  db->db->GetIntProperty(family, rocksdb::DB::Properties::kNumImmutableMemTable, &state_out->immutable_memtables);
+  db->db->GetIntProperty(family, rocksdb::DB::Properties::kEstimatePendingCompactionBytes,
+                         &state_out->pending_compaction_bytes);
+  std::string l0;
+  if (db->db->GetProperty(family, rocksdb::DB::Properties::kNumFilesAtLevelPrefix + "0", &l0)) {
+    state_out->l0_files = strtoull(l0.c_str(), nullptr, 10);
+  }
+
+  // Same ordering as ColumnFamilyData::GetWriteStallConditionAndCause:
+  // stop conditions first, then delays
+  const uint64_t imm = state_out->immutable_memtables;
+  const int max_buffers = state_out->max_write_buffer_number;
+  const uint64_t files = state_out->l0_files;
+  const uint64_t pending = state_out->pending_compaction_bytes;
+  const uint64_t soft = state_out->soft_pending_compaction_bytes_limit;
+  const uint64_t hard = state_out->hard_pending_compaction_bytes_limit;
+
+  if (imm >= static_cast<uint64_t>(max_buffers)) {
+    state_out->condition = RocksDBWriteStallStopped;
+    state_out->cause = RocksDBWriteStallCauseMemtableLimit;
+  } else if (!options.disable_auto_compactions && files >= static_cast<uint64_t>(options.level0_stop_writes_trigger)) {
+    state_out->condition = RocksDBWriteStallStopped;
+    state_out->cause = RocksDBWriteStallCauseL0FileCount;
+  } else if (!options.disable_auto_compactions && hard > 0 && pending >= hard) {
+    state_out->condition = RocksDBWriteStallStopped;
+    state_out->cause = RocksDBWriteStallCausePendingCompactionBytes;
+  } else if (max_buffers > 3 && imm >= static_cast<uint64_t>(max_buffers - 1)) {
+    state_out->condition = RocksDBWriteStallDelayed;
+    state_out->cause = RocksDBWriteStallCauseMemtableLimit;
+  } else if (!options.disable_auto_compactions && options.level0_slowdown_writes_trigger >= 0 &&
+             files >= static_cast<uint64_t>(options.level0_slowdown_writes_trigger)) {
+    state_out->condition = RocksDBWriteStallDelayed;
+    state_out->cause = RocksDBWriteStallCauseL0FileCount;
+  } else if (!options.disable_auto_compactions && soft > 0 && pending >= soft) {
+    state_out->condition = RocksDBWriteStallDelayed;
+    state_out->cause = RocksDBWriteStallCausePendingCompactionBytes;
+  } else {
+    state_out->condition = RocksDBWriteStallNormal;
+    state_out->cause = RocksDBWriteStallCauseNone;
+  }
+
+  return make_ok();
+}
+
+char* rocksdb_get_property(RocksDBRef db, const char* property) {
+  return rocksdb_get_property_cf(db, nullptr, property);
+}
+
+char* rocksdb_get_property_cf(RocksDBRef db, RocksDBColumnFamilyRef cf, const char* property) {
+  if (!db || !db->db) {
+    return nullptr;
+  }
+
+  std::string value;
+  if (db->db->GetProperty(column_family(db, cf), property, &value)) {
+    return strdup(value.c_str());
+  }
+  return nullptr;
+}
+
+int rocksdb_get_int_property_cf(RocksDBRef db, RocksDBColumnFamilyRef cf, const char* property,
+                                uint64_t* value_out) {
+  *value_out = 0;
+  if (!db || !db->db) {
+    return 0;
+  }
+
+  return db->db->GetIntProperty(column_family(db, cf), property, value_out) ? 1 : 0;
+}
+
+int rocksdb_get_aggregated_int_property(RocksDBRef db, const char* property, uint64_t* value_out) {
+  *value_out = 0;
+  if (!db || !db->db) {
+    return 0;
+  }
+
+  return db->db->GetAggregatedIntProperty(property, value_out) ? 1 : 0;
+}
+
+int rocksdb_get_map_property_cf(RocksDBRef db, RocksDBColumnFamilyRef cf, const char* property,
+                                char*** keys_out, char*** values_out, size_t* count_out) {
+  *keys_out = nullptr;
+  *values_out = nullptr;
+  *count_out = 0;
+  if (!db || !db->db) {
+    return 0;
+  }
+
+  std::map<std::string, std::string> values;
+  if (!db->db->GetMapProperty(column_family(db, cf), property, &values)) {
+    return 0;
+  }
+  if (values.empty()) {
+    return 1;
+  }
+
+  *keys_out = static_cast<char**>(malloc(values.size() * sizeof(char*)));
+  *values_out = static_cast<char**>(malloc(values.size() * sizeof(char*)));
+  size_t i = 0;
+  for (const auto& entry : values) {
+    (*keys_out)[i] = strdup(entry.first.c_str());
+    (*values_out)[i] = strdup(entry.second.c_str());
+    i++;
+  }
+  *count_out = values.size();
+  return 1;
+}
+
+void rocksdb_get_approximate_sizes(RocksDBRef db,
+                                   int num_ranges,
+                                   const char* const* start_keys,
+                                   const size_t* start_key_lens,
+                                   const char* const* end_keys,
+                                   const size_t* end_key_lens,
+                                   uint64_t* sizes_out) {
+  if (!db || !db->db || num_ranges <= 0) {
+    return;
+  }
+
+  std::vector<rocksdb::Range> ranges;
+  ranges.reserve(num_ranges);
+
+  for (int i = 0; i < num_ranges; i++) {
+    ranges.emplace_back(
+      rocksdb::Slice(start_keys[i], start_key_lens[i]),
+      rocksdb::Slice(end_keys[i], end_key_lens[i])
+    );
+  }
+
+  db->db->GetApproximateSizes(ranges.data(), num_ranges, sizes_out);
 }
 
-void rocksdb_write_options_set_sync(RocksDBWriteOptionsRef opts, int value) {
-  opts->options.sync = (value != 0);
+// Concrete bounds for ranges with open sides, which GetApproximateSizes
+// and GetApproximateMemTableStats do not accept. Open starts become the
+// family's first key and open ends the smallest key after its last one,
+// found with one iterator shared by all ranges.
+class RangeBoundResolver {
+ public:
+  RangeBoundResolver(RocksDBRef db, rocksdb::ColumnFamilyHandle* family)
+      : db_(db), family_(family) {}
+
+  std::vector<rocksdb::Range> resolve(size_t num_ranges, const char* const* bounds,
+                                      const size_t* bound_lens) {
+    std::vector<rocksdb::Range> ranges(num_ranges);
+    for (size_t i = 0; i < num_ranges; i++) {
+      const char* start = bounds[2 * i];
+      const char* end = bounds[2 * i + 1];
+      ranges[i].start = start ? rocksdb::Slice(start, bound_lens[2 * i]) : first();
+      ranges[i].limit = end ? rocksdb::Slice(end, bound_lens[2 * i + 1]) : afterLast();
+    }
+    return ranges;
+  }
+
+ private:
+  rocksdb::Slice first() {
+    load();
+    return first_;
+  }
+
+  rocksdb::Slice afterLast() {
+    load();
+    return after_last_;
+  }
+
+  void load() {
+    if (loaded_) return;
+    loaded_ = true;
+
+    rocksdb::ReadOptions options;
+    options.fill_cache = false;
+    options.total_order_seek = true;
+    std::unique_ptr<rocksdb::Iterator> it(db_->db->NewIterator(options, family_));
+    it->SeekToFirst();
+    if (!it->Valid()) return;  // Empty family: every open range is empty
+    first_ = it->key().ToString();
+    it->SeekToLast();
+    if (!it->Valid()) return;
+
+    // Appending a zero byte gives the next key under bytewise order; other
+    // comparators fall back to the last key itself
+    std::string last = it->key().ToString();
+    after_last_ = last + '\0';
+    if (family_->GetComparator()->Compare(after_last_, last) <= 0) {
+      after_last_ = std::move(last);
+    }
+  }
+
+  RocksDBRef db_;
+  rocksdb::ColumnFamilyHandle* family_;
+  bool loaded_ = false;
+  std::string first_;
+  std::string after_last_;
+};
+
+RocksDBStatus rocksdb_get_approximate_sizes_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                               const RocksDBSizeApproximationOptions* options,
+                                               size_t num_ranges,
+                                               const char* const* bounds,
+                                               const size_t* bound_lens,
+                                               uint64_t* sizes_out) {
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+  if (num_ranges == 0) {
+    return make_ok();
+  }
+
+  rocksdb::SizeApproximationOptions approximation;
+  if (options) {
+    approximation.include_memtables = options->include_memtables != 0;
+    approximation.include_files = options->include_files != 0;
+    approximation.files_size_error_margin = options->files_size_error_margin;
+  }
+
+  rocksdb::ColumnFamilyHandle* family = column_family(db, cf);
+  RangeBoundResolver resolver(db, family);
+  std::vector<rocksdb::Range> ranges = resolver.resolve(num_ranges, bounds, bound_lens);
+  rocksdb::Status s = db->db->GetApproximateSizes(approximation, family, ranges.data(),
+                                                  static_cast<int>(num_ranges), sizes_out);
+  return make_status(s);
 }
 
-void rocksdb_write_options_disable_wal(RocksDBWriteOptionsRef opts, int value) {
-  opts->options.disableWAL = (value != 0);
+RocksDBStatus rocksdb_get_approximate_memtable_stats_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                                        const char* start, size_t start_len,
+                                                        const char* end, size_t end_len,
+                                                        uint64_t* count_out, uint64_t* size_out) {
+  *count_out = 0;
+  *size_out = 0;
+
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  rocksdb::ColumnFamilyHandle* family = column_family(db, cf);
+  const char* bounds[2] = {start, end};
+  size_t bound_lens[2] = {start_len, end_len};
+  RangeBoundResolver resolver(db, family);
+  rocksdb::Range range = resolver.resolve(1, bounds, bound_lens)[0];
+  db->db->GetApproximateMemTableStats(family, range, count_out, size_out);
+  return make_ok();
+}
+
+RocksDBStatus rocksdb_split_range_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                     const char* start, size_t start_len,
+                                     const char* end, size_t end_len,
+                                     size_t partitions,
+                                     char*** keys_out, size_t** key_lens_out,
+                                     size_t* count_out) {
+  *keys_out = nullptr;
+  *key_lens_out = nullptr;
+  *count_out = 0;
+
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  rocksdb::ColumnFamilyHandle* family = column_family(db, cf);
+  const rocksdb::Comparator* cmp = family->GetComparator();
+  std::optional<rocksdb::Slice> lower, upper;
+  if (start) lower = rocksdb::Slice(start, start_len);
+  if (end) upper = rocksdb::Slice(end, end_len);
+
+  // Each overlapping file puts half its bytes on each of its boundary keys
+  std::vector<rocksdb::LiveFileMetaData> files;
+  db->db->GetLiveFilesMetaData(&files);
+  std::vector<std::pair<std::string, uint64_t>> points;
+  uint64_t total = 0;
+  for (const auto& file : files) {
+    if (file.column_family_name != family->GetName()) continue;
+    if (upper && cmp->Compare(file.smallestkey, *upper) >= 0) continue;
+    if (lower && cmp->Compare(file.largestkey, *lower) < 0) continue;
+    points.emplace_back(file.smallestkey, file.size / 2);
+    points.emplace_back(file.largestkey, file.size - file.size / 2);
+    total += file.size;
+  }
+  if (partitions < 2 || total == 0) {
+    return make_ok();
+  }
+
+  std::sort(points.begin(), points.end(), [cmp](const auto& a, const auto& b) {
+    return cmp->Compare(a.first, b.first) < 0;
+  });
+
+  // Cut where the running weight crosses each multiple of total / partitions,
+  // keeping cuts strictly inside the range and strictly ascending
+  std::vector<std::string> splits;
+  uint64_t running = 0;
+  size_t next = 1;
+  for (const auto& point : points) {
+    if (next >= partitions) break;
+    if (running >= total * next / partitions) {
+      const std::string& key = point.first;
+      bool inside = (!lower || cmp->Compare(key, *lower) > 0) &&
+                    (!upper || cmp->Compare(key, *upper) < 0) &&
+                    (splits.empty() || cmp->Compare(key, splits.back()) > 0);
+      if (inside) {
+        splits.push_back(key);
+      }
+      while (next < partitions && running >= total * next / partitions) next++;
+    }
+    running += point.second;
+  }
+  if (splits.empty()) {
+    return make_ok();
+  }
+
+  auto keys = static_cast<char**>(malloc(splits.size() * sizeof(char*)));
+  auto lens = static_cast<size_t*>(malloc(splits.size() * sizeof(size_t)));
+  for (size_t i = 0; i < splits.size(); i++) {
+    keys[i] = static_cast<char*>(malloc(std::max<size_t>(splits[i].size(), 1)));
+    memcpy(keys[i], splits[i].data(), splits[i].size());
+    lens[i] = splits[i].size();
+  }
+  *keys_out = keys;
+  *key_lens_out = lens;
+  *count_out = splits.size();
+  return make_ok();
 }
 
 // =============================================================================
-// MARK: - Database Operations
+// MARK: - SST File Metadata
 // =============================================================================
 
-RocksDBStatus rocksdb_open(const char* path, RocksDBOptionsRef opts, RocksDBRef* db_out) {
-  auto handle = new RocksDBHandle();
-  rocksdb::Status s = rocksdb::DB::Open(opts->options, path, &handle->db);
+// malloc'd copy of a string's bytes, never NULL so empty keys stay distinct
+// from missing ones
+static char* copy_bytes(const std::string& bytes) {
+  auto copy = static_cast<char*>(malloc(std::max<size_t>(bytes.size(), 1)));
+  memcpy(copy, bytes.data(), bytes.size());
+  return copy;
+}
+
+static RocksDBSstFileValues make_sst_file(const rocksdb::SstFileMetaData& file,
+                                          const std::string& column_family, int level) {
+  RocksDBSstFileValues values{};
+  values.file_name = strdup(file.relative_filename.c_str());
+  values.directory = strdup(file.directory.c_str());
+  values.column_family = strdup(column_family.c_str());
+  values.level = level;
+  values.file_number = file.file_number;
+  values.size = file.size;
+  values.smallest_key = copy_bytes(file.smallestkey);
+  values.smallest_key_len = file.smallestkey.size();
+  values.largest_key = copy_bytes(file.largestkey);
+  values.largest_key_len = file.largestkey.size();
+  values.smallest_seqno = file.smallest_seqno;
+  values.largest_seqno = file.largest_seqno;
+  values.num_entries = file.num_entries;
+  values.num_deletions = file.num_deletions;
+  values.num_reads_sampled = file.num_reads_sampled;
+  values.being_compacted = file.being_compacted ? 1 : 0;
+  values.file_creation_time = file.file_creation_time;
+  return values;
+}
+
+static void export_sst_files(const std::vector<RocksDBSstFileValues>& files,
+                             RocksDBSstFileValues** files_out, size_t* count_out) {
+  if (files.empty()) return;
+  auto out = static_cast<RocksDBSstFileValues*>(malloc(files.size() * sizeof(RocksDBSstFileValues)));
+  std::copy(files.begin(), files.end(), out);
+  *files_out = out;
+  *count_out = files.size();
+}
+
+RocksDBStatus rocksdb_get_live_files_metadata(RocksDBRef db, RocksDBSstFileValues** files_out,
+                                              size_t* count_out) {
+  *files_out = nullptr;
+  *count_out = 0;
+
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  // Files come back in no particular order; sort each family's files with
+  // its own comparator, overlapping L0 files newest first
+  std::map<std::string, const rocksdb::Comparator*> comparators;
+  comparators[db->db->DefaultColumnFamily()->GetName()] =
+      db->db->DefaultColumnFamily()->GetComparator();
+  {
+    std::lock_guard<std::mutex> lock(db->cf_mutex);
+    for (auto& cf : db->column_families) {
+      comparators.emplace(cf->name, cf->handle->GetComparator());
+    }
+  }
+
+  std::vector<rocksdb::LiveFileMetaData> live;
+  db->db->GetLiveFilesMetaData(&live);
+  std::sort(live.begin(), live.end(), [&comparators](const auto& a, const auto& b) {
+    if (a.column_family_name != b.column_family_name) {
+      return a.column_family_name < b.column_family_name;
+    }
+    if (a.level != b.level) return a.level < b.level;
+    if (a.level == 0) return a.largest_seqno > b.largest_seqno;
+    auto cmp = comparators.find(a.column_family_name);
+    if (cmp == comparators.end()) return a.smallestkey < b.smallestkey;
+    return cmp->second->Compare(a.smallestkey, b.smallestkey) < 0;
+  });
+
+  std::vector<RocksDBSstFileValues> files;
+  files.reserve(live.size());
+  for (const auto& file : live) {
+    files.push_back(make_sst_file(file, file.column_family_name, file.level));
+  }
+  export_sst_files(files, files_out, count_out);
+  return make_ok();
+}
+
+RocksDBStatus rocksdb_get_column_family_metadata(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                                 RocksDBSstFileValues** files_out, size_t* count_out,
+                                                 int* num_levels_out) {
+  *files_out = nullptr;
+  *count_out = 0;
+  *num_levels_out = 0;
+
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  rocksdb::ColumnFamilyMetaData metadata;
+  db->db->GetColumnFamilyMetaData(column_family(db, cf), &metadata);
+
+  std::vector<RocksDBSstFileValues> files;
+  files.reserve(metadata.file_count);
+  for (const auto& level : metadata.levels) {
+    for (const auto& file : level.files) {
+      files.push_back(make_sst_file(file, metadata.name, level.level));
+    }
+  }
+  *num_levels_out = static_cast<int>(metadata.levels.size());
+  export_sst_files(files, files_out, count_out);
+  return make_ok();
+}
+
+void rocksdb_sst_files_destroy(RocksDBSstFileValues* files, size_t count) {
+  if (!files) return;
+  for (size_t i = 0; i < count; i++) {
+    free(files[i].file_name);
+    free(files[i].directory);
+    free(files[i].column_family);
+    free(files[i].smallest_key);
+    free(files[i].largest_key);
+  }
+  free(files);
+}
+
+RocksDBStatus rocksdb_get_properties_of_tables_in_range_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                                           size_t num_ranges,
+                                                           const char* const* bounds,
+                                                           const size_t* bound_lens,
+                                                           RocksDBTablePropertiesValues** tables_out,
+                                                           size_t* count_out) {
+  *tables_out = nullptr;
+  *count_out = 0;
+
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+  if (num_ranges == 0) {
+    return make_ok();
+  }
+
+  rocksdb::ColumnFamilyHandle* family = column_family(db, cf);
+  RangeBoundResolver resolver(db, family);
+  std::vector<rocksdb::Range> ranges = resolver.resolve(num_ranges, bounds, bound_lens);
+
+  // The collection is keyed by file path, so tables come out in path order
+  rocksdb::TablePropertiesCollection collection;
+  rocksdb::Status s = db->db->GetPropertiesOfTablesInRange(family, ranges.data(), num_ranges,
+                                                           &collection);
+  if (!s.ok()) {
+    return make_status(s);
+  }
+  if (collection.empty()) {
+    return make_ok();
+  }
+
+  auto tables = static_cast<RocksDBTablePropertiesValues*>(
+      malloc(collection.size() * sizeof(RocksDBTablePropertiesValues)));
+  size_t i = 0;
+  for (const auto& [path, properties] : collection) {
+    RocksDBTablePropertiesValues& values = tables[i++];
+    values = RocksDBTablePropertiesValues{};
+    values.file_path = strdup(path.c_str());
+    values.data_size = properties->data_size;
+    values.index_size = properties->index_size;
+    values.filter_size = properties->filter_size;
+    values.raw_key_size = properties->raw_key_size;
+    values.raw_value_size = properties->raw_value_size;
+    values.num_data_blocks = properties->num_data_blocks;
+    values.num_entries = properties->num_entries;
+    values.num_deletions = properties->num_deletions;
+    values.num_merge_operands = properties->num_merge_operands;
+    values.num_range_deletions = properties->num_range_deletions;
+    values.creation_time = properties->creation_time;
+    values.oldest_key_time = properties->oldest_key_time;
+    values.compression_name = strdup(properties->compression_name.c_str());
+  }
+  *tables_out = tables;
+  *count_out = collection.size();
+  return make_ok();
+}
+
+void rocksdb_table_properties_destroy(RocksDBTablePropertiesValues* tables, size_t count) {
+  if (!tables) return;
+  for (size_t i = 0; i < count; i++) {
+    free(tables[i].file_path);
+    free(tables[i].compression_name);
+  }
+  free(tables);
+}
+
+// =============================================================================
+// MARK: - Memory Usage
+// =============================================================================
+
+RocksDBStatus rocksdb_approximate_memory_usage(const RocksDBRef* dbs, size_t num_dbs,
+                                               const RocksDBCacheRef* caches, size_t num_caches,
+                                               RocksDBMemoryUsageValues* usage_out) {
+  memset(usage_out, 0, sizeof(*usage_out));
+
+  std::vector<rocksdb::DB*> databases;
+  std::unordered_set<const rocksdb::Cache*> cache_set;
+  rocksdb::Status s;
+  for (size_t i = 0; i < num_dbs; i++) {
+    if (!dbs[i] || !dbs[i]->db) {
+      RocksDBStatus result{};
+      result.code = RocksDBStatusInvalidArgument;
+      result.message = strdup("Database is null");
+      return result;
+    }
+    databases.push_back(dbs[i]->db);
+
+    // MemoryUtil only counts the caches it is given, so add each
+    // database's block caches, once per family that has one
+    std::vector<rocksdb::ColumnFamilyDescriptor> families;
+    rocksdb::DBOptions db_options;
+    {
+      std::lock_guard<std::mutex> lock(dbs[i]->cf_mutex);
+      for (auto& cf : dbs[i]->column_families) {
+        rocksdb::ColumnFamilyDescriptor descriptor;
+        if (cf->handle->GetDescriptor(&descriptor).ok()) {
+          families.push_back(std::move(descriptor));
+        }
+      }
+    }
+    families.emplace_back(rocksdb::kDefaultColumnFamilyName,
+                          rocksdb::ColumnFamilyOptions(dbs[i]->db->GetOptions()));
+    for (const auto& family : families) {
+      const auto& factory = family.options.table_factory;
+      const auto* table = factory ? factory->GetOptions<rocksdb::BlockBasedTableOptions>() : nullptr;
+      if (table && table->block_cache) {
+        cache_set.insert(table->block_cache.get());
+      }
+    }
+  }
+  for (size_t i = 0; i < num_caches; i++) {
+    if (caches[i]) {
+      cache_set.insert(caches[i]->cache.get());
+    }
+  }
+
+  std::map<rocksdb::MemoryUtil::UsageType, uint64_t> usage;
+  s = rocksdb::MemoryUtil::GetApproximateMemoryUsageByType(databases, cache_set, &usage);
+  if (!s.ok()) {
+    return make_status(s);
+  }
+
+  usage_out->memtable_total = usage[rocksdb::MemoryUtil::kMemTableTotal];
+  usage_out->memtable_unflushed = usage[rocksdb::MemoryUtil::kMemTableUnFlushed];
+  usage_out->table_readers = usage[rocksdb::MemoryUtil::kTableReadersTotal];
+  usage_out->cache_total = usage[rocksdb::MemoryUtil::kCacheTotal];
+  for (const rocksdb::Cache* cache : cache_set) {
+    usage_out->cache_pinned += cache->GetPinnedUsage();
+    usage_out->cache_capacity += cache->GetCapacity();
+  }
+  return make_status(s);
+}
+
+// =============================================================================
+// MARK: - Statistics
+// =============================================================================
+
+static rocksdb::Statistics* db_statistics(RocksDBRef db) {
+  return db ? db->statistics.get() : nullptr;
+}
+
+uint32_t rocksdb_statistics_ticker_count(void) {
+  return static_cast<uint32_t>(rocksdb::TickersNameMap.size());
+}
+
+const char* rocksdb_statistics_ticker_name(uint32_t ticker) {
+  if (ticker >= rocksdb::TickersNameMap.size()) {
+    return nullptr;
+  }
+  return rocksdb::TickersNameMap[ticker].second.c_str();
+}
+
+uint32_t rocksdb_statistics_histogram_count(void) {
+  return static_cast<uint32_t>(rocksdb::HistogramsNameMap.size());
+}
+
+const char* rocksdb_statistics_histogram_name(uint32_t histogram) {
+  if (histogram >= rocksdb::HistogramsNameMap.size()) {
+    return nullptr;
+  }
+  return rocksdb::HistogramsNameMap[histogram].second.c_str();
+}
+
+int rocksdb_statistics_enabled(RocksDBRef db) {
+  return db_statistics(db) ? 1 : 0;
+}
+
+uint64_t rocksdb_statistics_get_ticker(RocksDBRef db, uint32_t ticker) {
+  rocksdb::Statistics* stats = db_statistics(db);
+  if (!stats || ticker >= rocksdb::TickersNameMap.size()) {
+    return 0;
+  }
+  return stats->getTickerCount(rocksdb::TickersNameMap[ticker].first);
+}
+
+size_t rocksdb_statistics_get_all_tickers(RocksDBRef db, uint64_t* values_out, size_t capacity) {
+  rocksdb::Statistics* stats = db_statistics(db);
+  if (!stats) {
+    return 0;
+  }
+
+  size_t count = std::min(capacity, rocksdb::TickersNameMap.size());
+  for (size_t i = 0; i < count; i++) {
+    values_out[i] = stats->getTickerCount(rocksdb::TickersNameMap[i].first);
+  }
+  return count;
+}
+
+int rocksdb_statistics_get_histogram(RocksDBRef db, uint32_t histogram, RocksDBHistogramValues* data_out) {
+  rocksdb::Statistics* stats = db_statistics(db);
+  if (!stats || histogram >= rocksdb::HistogramsNameMap.size()) {
+    return 0;
+  }
+
+  rocksdb::HistogramData data;
+  stats->histogramData(rocksdb::HistogramsNameMap[histogram].first, &data);
+  data_out->median = data.median;
+  data_out->percentile95 = data.percentile95;
+  data_out->percentile99 = data.percentile99;
+  data_out->average = data.average;
+  data_out->standard_deviation = data.standard_deviation;
+  data_out->max = data.max;
+  data_out->min = data.min;
+  data_out->count = data.count;
+  data_out->sum = data.sum;
+  return 1;
+}
+
+void rocksdb_statistics_set_level(RocksDBRef db, int level) {
+  if (rocksdb::Statistics* stats = db_statistics(db)) {
+    stats->set_stats_level(static_cast<rocksdb::StatsLevel>(level));
+  }
+}
+
+int rocksdb_statistics_get_level(RocksDBRef db) {
+  rocksdb::Statistics* stats = db_statistics(db);
+  return stats ? static_cast<int>(stats->get_stats_level()) : -1;
+}
+
+RocksDBStatus rocksdb_statistics_reset(RocksDBRef db) {
+  rocksdb::Statistics* stats = db_statistics(db);
+  if (!stats) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusNotSupported;
+    result.message = strdup("Statistics are not enabled");
+    return result;
+  }
+  return make_status(stats->Reset());
+}
+
+// =============================================================================
+// MARK: - Perf Context
+// =============================================================================
+
+void rocksdb_set_perf_level(int level) {
+  rocksdb::SetPerfLevel(static_cast<rocksdb::PerfLevel>(
+    std::clamp(level, static_cast<int>(rocksdb::kDisable), static_cast<int>(rocksdb::kEnableTime))));
+}
+
+int rocksdb_get_perf_level(void) {
+  return static_cast<int>(rocksdb::GetPerfLevel());
+}
+
+void rocksdb_perf_context_reset(void) {
+  rocksdb::get_perf_context()->Reset();
+  rocksdb::get_iostats_context()->Reset();
+}
+
+void rocksdb_perf_context_snapshot(RocksDBPerfContextValues* values_out) {
+  const rocksdb::PerfContext* perf = rocksdb::get_perf_context();
+  const rocksdb::IOStatsContext* io = rocksdb::get_iostats_context();
+
+  values_out->user_key_comparison_count = perf->user_key_comparison_count;
+  values_out->block_cache_hit_count = perf->block_cache_hit_count;
+  values_out->block_read_count = perf->block_read_count;
+  values_out->block_read_byte = perf->block_read_byte;
+  values_out->block_read_time = perf->block_read_time;
+  values_out->block_checksum_time = perf->block_checksum_time;
+  values_out->block_decompress_time = perf->block_decompress_time;
+  values_out->index_block_read_count = perf->index_block_read_count;
+  values_out->filter_block_read_count = perf->filter_block_read_count;
+  values_out->get_read_bytes = perf->get_read_bytes;
+  values_out->iter_read_bytes = perf->iter_read_bytes;
+  values_out->internal_key_skipped_count = perf->internal_key_skipped_count;
+  values_out->internal_delete_skipped_count = perf->internal_delete_skipped_count;
+  values_out->internal_merge_count = perf->internal_merge_count;
+  values_out->get_snapshot_time = perf->get_snapshot_time;
+  values_out->get_from_memtable_time = perf->get_from_memtable_time;
+  values_out->get_from_memtable_count = perf->get_from_memtable_count;
+  values_out->get_post_process_time = perf->get_post_process_time;
+  values_out->get_from_output_files_time = perf->get_from_output_files_time;
+  values_out->seek_on_memtable_time = perf->seek_on_memtable_time;
+  values_out->seek_child_seek_time = perf->seek_child_seek_time;
+  values_out->seek_internal_seek_time = perf->seek_internal_seek_time;
+  values_out->find_next_user_entry_time = perf->find_next_user_entry_time;
+  values_out->write_wal_time = perf->write_wal_time;
+  values_out->write_memtable_time = perf->write_memtable_time;
+  values_out->write_delay_time = perf->write_delay_time;
+  values_out->write_pre_and_post_process_time = perf->write_pre_and_post_process_time;
+  values_out->write_thread_wait_nanos = perf->write_thread_wait_nanos;
+  values_out->db_mutex_lock_nanos = perf->db_mutex_lock_nanos;
+  values_out->db_condition_wait_nanos = perf->db_condition_wait_nanos;
+  values_out->merge_operator_time_nanos = perf->merge_operator_time_nanos;
+  values_out->find_table_nanos = perf->find_table_nanos;
+  values_out->bloom_memtable_hit_count = perf->bloom_memtable_hit_count;
+  values_out->bloom_memtable_miss_count = perf->bloom_memtable_miss_count;
+  values_out->bloom_sst_hit_count = perf->bloom_sst_hit_count;
+  values_out->bloom_sst_miss_count = perf->bloom_sst_miss_count;
+  values_out->key_lock_wait_time = perf->key_lock_wait_time;
+  values_out->get_cpu_nanos = perf->get_cpu_nanos;
+
+  values_out->io_bytes_read = io->bytes_read;
+  values_out->io_bytes_written = io->bytes_written;
+  values_out->io_open_nanos = io->open_nanos;
+  values_out->io_read_nanos = io->read_nanos;
+  values_out->io_write_nanos = io->write_nanos;
+  values_out->io_fsync_nanos = io->fsync_nanos;
+  values_out->io_range_sync_nanos = io->range_sync_nanos;
+  values_out->io_logger_nanos = io->logger_nanos;
+}
+
+// =============================================================================
+// MARK: - Event Listener
+// =============================================================================
+
+// Bounded multi-producer multi-consumer queue (Vyukov): each slot carries a
+// sequence number telling producers and consumers whose turn it is, so
+// neither side ever takes a lock
+class EventRing {
+ public:
+  explicit EventRing(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    mask_ = size - 1;
+    slots_ = std::vector<Slot>(size);
+    for (size_t i = 0; i < size; i++) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  bool push(const RocksDBEventRecord& event) {
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot& slot = slots_[pos & mask_];
+      size_t sequence = slot.sequence.load(std::memory_order_acquire);
+      intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          slot.event = event;
+          slot.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  bool pop(RocksDBEventRecord* event) {
+    size_t pos = head_.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot& slot = slots_[pos & mask_];
+      size_t sequence = slot.sequence.load(std::memory_order_acquire);
+      intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          *event = slot.event;
+          slot.sequence.store(pos + mask_ + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+ private:
+  struct Slot {
+    std::atomic<size_t> sequence{0};
+    RocksDBEventRecord event;
+  };
+
+  std::vector<Slot> slots_;
+  size_t mask_ = 0;
+  alignas(64) std::atomic<size_t> head_{0};
+  alignas(64) std::atomic<size_t> tail_{0};
+};
+
+class BridgeEventListener : public rocksdb::EventListener {
+ public:
+  explicit BridgeEventListener(size_t capacity) : ring(capacity) {}
+
+  const char* Name() const override { return "RocksDBSwiftEventListener"; }
+
+  void OnFlushCompleted(rocksdb::DB*, const rocksdb::FlushJobInfo& info) override {
+    RocksDBEventRecord event = make_event(RocksDBEventFlushCompleted, info.cf_name);
+    event.job_id = info.job_id;
+    const rocksdb::TableProperties& props = info.table_properties;
+    event.output_bytes = props.data_size + props.index_size + props.filter_size;
+    event.output_files = 1;
+    event.reason = static_cast<int>(info.flush_reason);
+    event.triggered_writes_slowdown = info.triggered_writes_slowdown ? 1 : 0;
+    event.triggered_writes_stop = info.triggered_writes_stop ? 1 : 0;
+    record(event);
+  }
+
+  void OnCompactionCompleted(rocksdb::DB*, const rocksdb::CompactionJobInfo& info) override {
+    RocksDBEventRecord event = make_event(RocksDBEventCompactionCompleted, info.cf_name);
+    event.job_id = info.job_id;
+    event.input_level = info.base_input_level;
+    event.output_level = info.output_level;
+    event.input_bytes = info.stats.total_input_bytes;
+    event.output_bytes = info.stats.total_output_bytes;
+    event.input_files = info.input_files.size();
+    event.output_files = info.output_files.size();
+    event.duration_micros = info.stats.elapsed_micros;
+    event.reason = static_cast<int>(info.compaction_reason);
+    event.status_code = status_code(info.status);
+    record(event);
+  }
+
+  void OnStallConditionsChanged(const rocksdb::WriteStallInfo& info) override {
+    RocksDBEventRecord event = make_event(RocksDBEventStallConditionsChanged, info.cf_name);
+    event.stall_previous = stall_condition(info.condition.prev);
+    event.stall_current = stall_condition(info.condition.cur);
+    record(event);
+  }
+
+  void OnBackgroundError(rocksdb::BackgroundErrorReason reason, rocksdb::Status* error) override {
+    RocksDBEventRecord event = make_event(RocksDBEventBackgroundError, std::string());
+    event.reason = static_cast<int>(reason);
+    if (error) {
+      event.status_code = status_code(*error);
+      std::string msg = error->ToString();
+      strncpy(event.message, msg.c_str(), sizeof(event.message) - 1);
+    }
+    record(event);
+  }
+
+  EventRing ring;
+  std::atomic<uint64_t> dropped{0};
+
+ private:
+  static RocksDBEventRecord make_event(RocksDBEventType type, const std::string& cf_name) {
+    RocksDBEventRecord event;
+    memset(&event, 0, sizeof(event));
+    event.type = type;
+    event.timestamp_micros = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    strncpy(event.column_family, cf_name.c_str(), sizeof(event.column_family) - 1);
+    return event;
+  }
+
+  static int status_code(const rocksdb::Status& s) {
+    RocksDBStatus status = make_status(s);
+    free(status.message);
+    return status.code;
+  }
+
+  static int stall_condition(rocksdb::WriteStallCondition condition) {
+    switch (condition) {
+      case rocksdb::WriteStallCondition::kDelayed: return RocksDBWriteStallDelayed;
+      case rocksdb::WriteStallCondition::kStopped: return RocksDBWriteStallStopped;
+      default: return RocksDBWriteStallNormal;
+    }
+  }
+
+  void record(const RocksDBEventRecord& event) {
+    if (!ring.push(event)) {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+};
+
+struct RocksDBEventListenerHandle {
+  std::shared_ptr<BridgeEventListener> listener;
+};
+
+RocksDBEventListenerRef rocksdb_event_listener_create(size_t capacity) {
+  auto handle = new RocksDBEventListenerHandle();
+  handle->listener = std::make_shared<BridgeEventListener>(std::max<size_t>(capacity, 2));
+  return handle;
+}
+
+void rocksdb_event_listener_destroy(RocksDBEventListenerRef listener) {
+  delete listener;
+}
+
+void rocksdb_options_add_event_listener(RocksDBOptionsRef opts, RocksDBEventListenerRef listener) {
+  opts->options.listeners.push_back(listener->listener);
+}
+
+size_t rocksdb_event_listener_poll(RocksDBEventListenerRef listener, RocksDBEventRecord* events_out,
+                                   size_t max_events) {
+  size_t count = 0;
+  while (count < max_events && listener->listener->ring.pop(&events_out[count])) {
+    count++;
+  }
+  return count;
+}
+
+uint64_t rocksdb_event_listener_dropped(RocksDBEventListenerRef listener) {
+  return listener->listener->dropped.load(std::memory_order_relaxed);
+}
+
+// =============================================================================
+// MARK: - Block Cache Tracing
+// =============================================================================
+
+// Writes accesses as fixed-size RocksDBBlockCacheAccessRecords so traces can
+// be replayed without RocksDB's internal trace reader
+class BridgeBlockCacheTraceWriter : public rocksdb::BlockCacheTraceWriter {
+ public:
+  BridgeBlockCacheTraceWriter(FILE* file, uint64_t max_size) : file_(file), max_size_(max_size) {}
+
+  ~BridgeBlockCacheTraceWriter() override {
+    fclose(file_);
+  }
 
-  if (s.ok()) {
-    *db_out = handle;
-  } else {
-    delete handle;
-    *db_out = nullptr;
+  rocksdb::Status WriteHeader() override {
+    uint8_t header[ROCKSDB_BLOCK_CACHE_TRACE_HEADER_SIZE] = {};
+    memcpy(header, ROCKSDB_BLOCK_CACHE_TRACE_MAGIC, 8);
+    const uint32_t record_size = sizeof(RocksDBBlockCacheAccessRecord);
+    for (int i = 0; i < 4; i++) {
+      header[8 + i] = static_cast<uint8_t>(record_size >> (8 * i));
+    }
+    return write(header, sizeof(header));
   }
-  return make_status(s);
-}
 
-RocksDBStatus rocksdb_open_for_read_only(const char* path, RocksDBOptionsRef opts,
-                                          int error_if_wal_exists, RocksDBRef* db_out) {
-  auto handle = new RocksDBHandle();
-  rocksdb::Status s = rocksdb::DB::OpenForReadOnly(opts->options, path, &handle->db,
-                                                    error_if_wal_exists != 0);
+  rocksdb::Status WriteBlockAccess(const rocksdb::BlockCacheTraceRecord& record,
+                                   const rocksdb::Slice& block_key, const rocksdb::Slice& /*cf_name*/,
+                                   const rocksdb::Slice& /*referenced_key*/) override {
+    RocksDBBlockCacheAccessRecord out = {};
+    out.timestamp_us = record.access_timestamp;
+    out.block_key_hash = fnv1a(block_key);
+    out.block_size = record.block_size;
+    out.get_id = record.get_id;
+    out.cf_id = static_cast<uint32_t>(record.cf_id);
+    out.level = record.level;
+    out.block_type = static_cast<uint8_t>(record.block_type);
+    out.caller = static_cast<uint8_t>(record.caller);
+    out.is_cache_hit = record.is_cache_hit ? 1 : 0;
+    out.no_insert = record.no_insert ? 1 : 0;
+    return write(&out, sizeof(out));
+  }
 
-  if (s.ok()) {
-    *db_out = handle;
-  } else {
-    delete handle;
-    *db_out = nullptr;
+ private:
+  static uint64_t fnv1a(const rocksdb::Slice& data) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < data.size(); i++) {
+      hash ^= static_cast<unsigned char>(data[i]);
+      hash *= 0x100000001b3ull;
+    }
+    return hash;
   }
-  return make_status(s);
-}
 
-RocksDBStatus rocksdb_open_transactional(const char* path, RocksDBOptionsRef opts, RocksDBRef* db_out) {
-  auto handle = new RocksDBHandle();
-  handle->is_transactional = true;
+  rocksdb::Status write(const void* data, size_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (written_ + size > max_size_) {
+      return rocksdb::Status::OK();
+    }
+    if (fwrite(data, 1, size, file_) != size) {
+      return rocksdb::Status::IOError("Short write to block cache trace");
+    }
+    written_ += size;
+    return rocksdb::Status::OK();
+  }
 
-  rocksdb::Status s = rocksdb::OptimisticTransactionDB::Open(
-    opts->options, path, &handle->txn_db);
+  std::mutex mutex_;
+  FILE* file_;
+  uint64_t max_size_;
+  uint64_t written_ = 0;
+};
 
-  if (s.ok()) {
-    handle->db = handle->txn_db->GetBaseDB();
-    *db_out = handle;
-  } else {
-    delete handle;
-    *db_out = nullptr;
+RocksDBStatus rocksdb_start_block_cache_trace(RocksDBRef db, const char* path,
+                                              uint64_t sampling_frequency, uint64_t max_trace_size) {
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
   }
-  return make_status(s);
-}
 
-void rocksdb_close(RocksDBRef db) {
-  delete db;
+  FILE* file = fopen(path, "wb");
+  if (!file) {
+    return make_status(rocksdb::Status::IOError("Cannot create block cache trace", path));
+  }
+
+  rocksdb::BlockCacheTraceOptions options;
+  options.sampling_frequency = std::max<uint64_t>(sampling_frequency, 1);
+  std::unique_ptr<rocksdb::BlockCacheTraceWriter> writer =
+      std::make_unique<BridgeBlockCacheTraceWriter>(file, max_trace_size);
+  return make_status(db->db->StartBlockCacheTrace(options, std::move(writer)));
 }
 
-int rocksdb_is_transactional(RocksDBRef db) {
-  return db && db->is_transactional ? 1 : 0;
+RocksDBStatus rocksdb_end_block_cache_trace(RocksDBRef db) {
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
+  }
+
+  return make_status(db->db->EndBlockCacheTrace());
 }
 
 // =============================================================================
-// MARK: - Key-Value Operations
+// MARK: - Query Tracing
 // =============================================================================
 
-RocksDBStatus rocksdb_put(RocksDBRef db, RocksDBWriteOptionsRef opts,
-                          const char* key, size_t key_len,
-                          const char* value, size_t value_len) {
+RocksDBStatus rocksdb_start_trace(RocksDBRef db, const char* path,
+                                  uint64_t sampling_frequency, uint64_t max_trace_size,
+                                  uint64_t filter, int preserve_write_order) {
   if (!db || !db->db) {
-    RocksDBStatus result;
+    RocksDBStatus result{};
     result.code = RocksDBStatusInvalidArgument;
     result.message = strdup("Database is null");
     return result;
   }
 
-  rocksdb::WriteOptions writeOpts;
-  if (opts) {
-    writeOpts = opts->options;
+  std::unique_ptr<rocksdb::TraceWriter> writer;
+  rocksdb::Status s = rocksdb::NewFileTraceWriter(rocksdb::Env::Default(), rocksdb::EnvOptions(),
+                                                  path, &writer);
+  if (!s.ok()) {
+    return make_status(s);
   }
 
-  rocksdb::Status s = db->db->Put(
-    writeOpts,
-    rocksdb::Slice(key, key_len),
-    rocksdb::Slice(value, value_len));
-
-  return make_status(s);
+  rocksdb::TraceOptions options;
+  options.sampling_frequency = std::max<uint64_t>(sampling_frequency, 1);
+  options.max_trace_file_size = max_trace_size;
+  options.filter = filter;
+  options.preserve_write_order = (preserve_write_order != 0);
+  return make_status(db->db->StartTrace(options, std::move(writer)));
 }
 
-RocksDBStatus rocksdb_get(RocksDBRef db, RocksDBReadOptionsRef opts,
-                          const char* key, size_t key_len,
-                          char** value_out, size_t* value_len_out) {
-  *value_out = nullptr;
-  *value_len_out = 0;
-
+RocksDBStatus rocksdb_end_trace(RocksDBRef db) {
   if (!db || !db->db) {
-    RocksDBStatus result;
+    RocksDBStatus result{};
     result.code = RocksDBStatusInvalidArgument;
     result.message = strdup("Database is null");
     return result;
   }
 
-  rocksdb::ReadOptions readOpts;
-  if (opts) {
-    readOpts = opts->options;
+  return make_status(db->db->EndTrace());
+}
+
+// Collects per-kind latencies of replayed records; the replayer calls back
+// from its worker threads. Results are visited rather than cast, since
+// RocksDB may be built without RTTI.
+class ReplayCollector : public rocksdb::TraceRecordResult::Handler {
+ public:
+  void add(const rocksdb::Status& status, std::unique_ptr<rocksdb::TraceRecordResult>&& result) {
+    if (!result) {
+      if (!status.ok()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        failed_records_++;
+      }
+      return;
+    }
+    result->Accept(this);
   }
 
-  std::string value;
-  rocksdb::Status s = db->db->Get(
-    readOpts,
-    rocksdb::Slice(key, key_len),
-    &value);
+  rocksdb::Status Handle(const rocksdb::StatusOnlyTraceExecutionResult& result) override {
+    record(result.GetTraceType(), result.GetLatency(), result.GetStatus().ok());
+    return rocksdb::Status::OK();
+  }
 
-  if (s.ok()) {
-    *value_len_out = value.size();
-    *value_out = static_cast<char*>(malloc(value.size()));
-    if (*value_out) {
-      memcpy(*value_out, value.data(), value.size());
+  rocksdb::Status Handle(const rocksdb::SingleValueTraceExecutionResult& result) override {
+    const rocksdb::Status& s = result.GetStatus();
+    record(result.GetTraceType(), result.GetLatency(), s.ok() || s.IsNotFound());
+    return rocksdb::Status::OK();
+  }
+
+  rocksdb::Status Handle(const rocksdb::MultiValuesTraceExecutionResult& result) override {
+    bool ok = true;
+    for (const rocksdb::Status& s : result.GetMultiStatus()) {
+      ok = ok && (s.ok() || s.IsNotFound());
     }
+    record(result.GetTraceType(), result.GetLatency(), ok);
+    return rocksdb::Status::OK();
   }
 
-  return make_status(s);
-}
+  rocksdb::Status Handle(const rocksdb::IteratorTraceExecutionResult& result) override {
+    record(result.GetTraceType(), result.GetLatency(), result.GetStatus().ok());
+    return rocksdb::Status::OK();
+  }
+
+  void summarize(RocksDBReplayValues* values_out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    summarize(gets_, &values_out->get);
+    summarize(multi_gets_, &values_out->multi_get);
+    summarize(writes_, &values_out->write);
+    summarize(seeks_, &values_out->iterator_seek);
+    values_out->failed_records = failed_records_;
+  }
+
+ private:
+  struct Samples {
+    std::vector<uint64_t> latencies;
+    uint64_t errors = 0;
+  };
+
+  void record(rocksdb::TraceType type, uint64_t latency, bool ok) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Samples* samples = nullptr;
+    switch (type) {
+      case rocksdb::kTraceGet: samples = &gets_; break;
+      case rocksdb::kTraceMultiGet: samples = &multi_gets_; break;
+      case rocksdb::kTraceWrite: samples = &writes_; break;
+      case rocksdb::kTraceIteratorSeek:
+      case rocksdb::kTraceIteratorSeekForPrev: samples = &seeks_; break;
+      default: return;
+    }
+    samples->latencies.push_back(latency);
+    if (!ok) {
+      samples->errors++;
+    }
+  }
+
+  static void summarize(Samples& samples, RocksDBReplayLatencyValues* out) {
+    memset(out, 0, sizeof(*out));
+    std::vector<uint64_t>& latencies = samples.latencies;
+    out->count = latencies.size();
+    out->errors = samples.errors;
+    if (latencies.empty()) {
+      return;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    auto at = [&](double fraction) {
+      size_t index = static_cast<size_t>(fraction * static_cast<double>(latencies.size() - 1) + 0.5);
+      return latencies[std::min(index, latencies.size() - 1)];
+    };
+    for (uint64_t latency : latencies) {
+      out->total_us += latency;
+    }
+    out->p50_us = at(0.50);
+    out->p95_us = at(0.95);
+    out->p99_us = at(0.99);
+    out->max_us = latencies.back();
+  }
+
+  std::mutex mutex_;
+  Samples gets_;
+  Samples multi_gets_;
+  Samples writes_;
+  Samples seeks_;
+  uint64_t failed_records_ = 0;
+};
+
+RocksDBStatus rocksdb_replay_trace(RocksDBRef db, const char* path, uint32_t threads, double speedup,
+                                   RocksDBReplayValues* values_out) {
+  memset(values_out, 0, sizeof(*values_out));
 
-RocksDBStatus rocksdb_delete(RocksDBRef db, RocksDBWriteOptionsRef opts,
-                             const char* key, size_t key_len) {
   if (!db || !db->db) {
-    RocksDBStatus result;
+    RocksDBStatus result{};
     result.code = RocksDBStatusInvalidArgument;
     result.message = strdup("Database is null");
     return result;
   }
-
-  rocksdb::WriteOptions writeOpts;
-  if (opts) {
-    writeOpts = opts->options;
+  if (!(speedup > 0)) {
+    return make_status(rocksdb::Status::InvalidArgument("Replay speedup must be positive"));
   }
 
-  rocksdb::Status s = db->db->Delete(
-    writeOpts,
-    rocksdb::Slice(key, key_len));
-
-  return make_status(s);
-}
+  std::unique_ptr<rocksdb::TraceReader> reader;
+  rocksdb::Status s = rocksdb::NewFileTraceReader(rocksdb::Env::Default(), rocksdb::EnvOptions(),
+                                                  path, &reader);
+  if (!s.ok()) {
+    return make_status(s);
+  }
 
-int rocksdb_key_may_exist(RocksDBRef db, RocksDBReadOptionsRef opts,
-                          const char* key, size_t key_len) {
-  if (!db || !db->db) {
-    return 0;
+  std::vector<rocksdb::ColumnFamilyHandle*> handles{db->db->DefaultColumnFamily()};
+  {
+    std::lock_guard<std::mutex> lock(db->cf_mutex);
+    for (const auto& cf : db->column_families) {
+      handles.push_back(cf->handle);
+    }
   }
 
-  rocksdb::ReadOptions readOpts;
-  if (opts) {
-    readOpts = opts->options;
+  std::unique_ptr<rocksdb::Replayer> replayer;
+  s = db->db->NewDefaultReplayer(handles, std::move(reader), &replayer);
+  if (s.ok()) {
+    s = replayer->Prepare();
+  }
+  if (!s.ok()) {
+    return make_status(s);
   }
 
-  std::string value;
-  bool value_found = false;
-  return db->db->KeyMayExist(readOpts, rocksdb::Slice(key, key_len), &value, &value_found) ? 1 : 0;
+  ReplayCollector collector;
+  const auto start = std::chrono::steady_clock::now();
+  s = replayer->Replay(rocksdb::ReplayOptions(std::max<uint32_t>(threads, 1), speedup),
+                       [&](rocksdb::Status status, std::unique_ptr<rocksdb::TraceRecordResult>&& result) {
+                         collector.add(status, std::move(result));
+                       });
+  values_out->elapsed_us = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start).count());
+  collector.summarize(values_out);
+
+  // Reaching the end of the trace is reported as Incomplete
+  if (s.IsIncomplete()) {
+    return make_ok();
+  }
+  return make_status(s);
 }
 
 // =============================================================================
-// MARK: - Batch Operations
+// MARK: - Call Tracing
 // =============================================================================
 
-RocksDBBatchRef rocksdb_batch_create(void) {
-  return new RocksDBBatchHandle();
+void rocksdb_trace_set_enabled(int enabled) {
+  g_tracing_enabled.store(kTracingCompiled && enabled != 0, std::memory_order_relaxed);
 }
 
-void rocksdb_batch_destroy(RocksDBBatchRef batch) {
-  delete batch;
+int rocksdb_trace_enabled(void) {
+  return tracing_active() ? 1 : 0;
 }
 
-void rocksdb_batch_put(RocksDBBatchRef batch,
-                       const char* key, size_t key_len,
-                       const char* value, size_t value_len) {
-  if (batch) {
-    batch->batch.Put(rocksdb::Slice(key, key_len), rocksdb::Slice(value, value_len));
+void rocksdb_trace_record(int op, int layer, uint64_t nanos) {
+  if (!tracing_active() || op < 0 || op >= RocksDBTraceOpCount ||
+      layer < 0 || layer >= RocksDBTraceLayerCount) {
+    return;
   }
+  trace_record(op, layer, nanos);
 }
 
-void rocksdb_batch_delete(RocksDBBatchRef batch,
-                          const char* key, size_t key_len) {
-  if (batch) {
-    batch->batch.Delete(rocksdb::Slice(key, key_len));
+// Sum of live and retired counters; caller holds the registry mutex
+static void trace_totals(TraceRegistry& registry, TraceCounters& totals) {
+  add_counters(totals, registry.retired);
+  for (TraceCounters* counters : registry.live) {
+    add_counters(totals, *counters);
   }
 }
 
-void rocksdb_batch_delete_range(RocksDBBatchRef batch,
-                                const char* start_key, size_t start_key_len,
-                                const char* end_key, size_t end_key_len) {
-  if (batch) {
-    batch->batch.DeleteRange(rocksdb::Slice(start_key, start_key_len),
-                             rocksdb::Slice(end_key, end_key_len));
+void rocksdb_trace_get(int op, int layer, uint64_t* calls_out, uint64_t* nanos_out,
+                       uint64_t* buckets_out) {
+  *calls_out = 0;
+  *nanos_out = 0;
+  if (buckets_out) {
+    memset(buckets_out, 0, sizeof(uint64_t) * ROCKSDB_TRACE_BUCKETS);
+  }
+  if (op < 0 || op >= RocksDBTraceOpCount || layer < 0 || layer >= RocksDBTraceLayerCount) {
+    return;
   }
-}
 
-void rocksdb_batch_clear(RocksDBBatchRef batch) {
-  if (batch) {
-    batch->batch.Clear();
+  TraceRegistry& registry = trace_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto sum = [&](auto pick) {
+    uint64_t total = pick(registry.retired).load(std::memory_order_relaxed);
+    for (TraceCounters* counters : registry.live) {
+      total += pick(*counters).load(std::memory_order_relaxed);
+    }
+    return total - pick(registry.baseline).load(std::memory_order_relaxed);
+  };
+
+  *calls_out = sum([&](TraceCounters& c) -> std::atomic<uint64_t>& { return c.calls[op][layer]; });
+  *nanos_out = sum([&](TraceCounters& c) -> std::atomic<uint64_t>& { return c.nanos[op][layer]; });
+  if (buckets_out) {
+    for (int b = 0; b < ROCKSDB_TRACE_BUCKETS; b++) {
+      buckets_out[b] = sum([&](TraceCounters& c) -> std::atomic<uint64_t>& {
+        return c.buckets[op][layer][b];
+      });
+    }
   }
 }
 
-size_t rocksdb_batch_count(RocksDBBatchRef batch) {
-  return batch ? batch->batch.Count() : 0;
+void rocksdb_trace_reset(void) {
+  TraceRegistry& registry = trace_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto totals = std::make_unique<TraceCounters>();
+  trace_totals(registry, *totals);
+  for (int op = 0; op < RocksDBTraceOpCount; op++) {
+    for (int layer = 0; layer < RocksDBTraceLayerCount; layer++) {
+      registry.baseline.calls[op][layer].store(totals->calls[op][layer].load());
+      registry.baseline.nanos[op][layer].store(totals->nanos[op][layer].load());
+      for (int b = 0; b < ROCKSDB_TRACE_BUCKETS; b++) {
+        registry.baseline.buckets[op][layer][b].store(totals->buckets[op][layer][b].load());
+      }
+    }
+  }
 }
 
-size_t rocksdb_batch_data_size(RocksDBBatchRef batch) {
-  return batch ? batch->batch.GetDataSize() : 0;
+// =============================================================================
+// MARK: - Options Files
+// =============================================================================
+
+// Hand loaded options out as one Options per family, the default family's
+// also carrying the DB options
+static void export_loaded_options(const rocksdb::DBOptions& db_options,
+                                  const std::vector<rocksdb::ColumnFamilyDescriptor>& descriptors,
+                                  RocksDBOptionsRef* db_opts_out, char*** names_out,
+                                  RocksDBOptionsRef** families_out, size_t* count_out) {
+  auto db_handle = new RocksDBOptionsHandle();
+  db_handle->options = rocksdb::Options(db_options, rocksdb::ColumnFamilyOptions());
+  *count_out = descriptors.size();
+  *names_out = static_cast<char**>(malloc(descriptors.size() * sizeof(char*)));
+  *families_out = static_cast<RocksDBOptionsRef*>(malloc(descriptors.size() * sizeof(RocksDBOptionsRef)));
+  for (size_t i = 0; i < descriptors.size(); i++) {
+    auto family = new RocksDBOptionsHandle();
+    family->options = rocksdb::Options(db_options, descriptors[i].options);
+    (*names_out)[i] = strdup(descriptors[i].name.c_str());
+    (*families_out)[i] = family;
+    if (descriptors[i].name == rocksdb::kDefaultColumnFamilyName) {
+      db_handle->options = family->options;
+    }
+  }
+  *db_opts_out = db_handle;
 }
 
-RocksDBStatus rocksdb_write_batch(RocksDBRef db, RocksDBWriteOptionsRef opts,
-                                  RocksDBBatchRef batch) {
-  if (!db || !db->db || !batch) {
-    RocksDBStatus result;
-    result.code = RocksDBStatusInvalidArgument;
-    result.message = strdup("Database or batch is null");
-    return result;
+template <typename Loader>
+static RocksDBStatus load_options(Loader loader, RocksDBOptionsRef* db_opts_out, char*** names_out,
+                                  RocksDBOptionsRef** families_out, size_t* count_out) {
+  *db_opts_out = nullptr;
+  *names_out = nullptr;
+  *families_out = nullptr;
+  *count_out = 0;
+
+  rocksdb::ConfigOptions config;
+  config.env = rocksdb::Env::Default();
+  rocksdb::DBOptions db_options;
+  std::vector<rocksdb::ColumnFamilyDescriptor> descriptors;
+  rocksdb::Status s = loader(config, &db_options, &descriptors);
+  if (s.ok()) {
+    export_loaded_options(db_options, descriptors, db_opts_out, names_out, families_out, count_out);
   }
+  return make_status(s);
+}
 
-  rocksdb::WriteOptions writeOpts;
-  if (opts) {
-    writeOpts = opts->options;
+RocksDBStatus rocksdb_load_latest_options(const char* path, RocksDBOptionsRef* db_opts_out,
+                                          char*** names_out, RocksDBOptionsRef** families_out,
+                                          size_t* count_out) {
+  return load_options([&](const rocksdb::ConfigOptions& config, rocksdb::DBOptions* db_options,
+                          std::vector<rocksdb::ColumnFamilyDescriptor>* descriptors) {
+    return rocksdb::LoadLatestOptions(config, path, db_options, descriptors);
+  }, db_opts_out, names_out, families_out, count_out);
+}
+
+RocksDBStatus rocksdb_load_options_from_file(const char* file, RocksDBOptionsRef* db_opts_out,
+                                             char*** names_out, RocksDBOptionsRef** families_out,
+                                             size_t* count_out) {
+  return load_options([&](const rocksdb::ConfigOptions& config, rocksdb::DBOptions* db_options,
+                          std::vector<rocksdb::ColumnFamilyDescriptor>* descriptors) {
+    return rocksdb::LoadOptionsFromFile(config, file, db_options, descriptors);
+  }, db_opts_out, names_out, families_out, count_out);
+}
+
+RocksDBStatus rocksdb_get_latest_options_file(const char* path, char** file_out) {
+  *file_out = nullptr;
+  std::string name;
+  rocksdb::Status s = rocksdb::GetLatestOptionsFileName(path, rocksdb::Env::Default(), &name);
+  if (s.ok()) {
+    *file_out = strdup((std::string(path) + "/" + name).c_str());
   }
+  return make_status(s);
+}
 
-  rocksdb::Status s = db->db->Write(writeOpts, &batch->batch);
+RocksDBStatus rocksdb_options_create_from_string(RocksDBOptionsRef base, const char* opts_str,
+                                                 RocksDBOptionsRef* opts_out) {
+  *opts_out = nullptr;
+  rocksdb::ConfigOptions config;
+  config.env = rocksdb::Env::Default();
+  auto handle = new RocksDBOptionsHandle();
+  rocksdb::Status s = rocksdb::GetOptionsFromString(
+    config, base ? base->options : rocksdb::Options(), opts_str, &handle->options);
+  if (!s.ok()) {
+    delete handle;
+    return make_status(s);
+  }
+  *opts_out = handle;
   return make_status(s);
 }
 
+char* rocksdb_options_get_string(RocksDBOptionsRef opts) {
+  rocksdb::ConfigOptions config;
+  config.delimiter = ";";
+  std::string db_string;
+  std::string cf_string;
+  rocksdb::Status s = rocksdb::GetStringFromDBOptions(config, rocksdb::DBOptions(opts->options), &db_string);
+  if (s.ok()) {
+    s = rocksdb::GetStringFromColumnFamilyOptions(config, rocksdb::ColumnFamilyOptions(opts->options),
+                                                  &cf_string);
+  }
+  if (!s.ok()) {
+    return nullptr;
+  }
+  return strdup((db_string + ";" + cf_string).c_str());
+}
+
 // =============================================================================
-// MARK: - Iterator Operations
+// MARK: - Change Data Capture
 // =============================================================================
 
-RocksDBIteratorRef rocksdb_iterator_create(RocksDBRef db, RocksDBReadOptionsRef opts) {
+uint64_t rocksdb_latest_sequence_number(RocksDBRef db) {
   if (!db || !db->db) {
-    return nullptr;
+    return 0;
   }
+  return db->db->GetLatestSequenceNumber();
+}
 
-  rocksdb::ReadOptions readOpts;
-  if (opts) {
-    readOpts = opts->options;
+RocksDBStatus rocksdb_get_updates_since(RocksDBRef db, uint64_t sequence,
+                                        int verify_checksums,
+                                        RocksDBWalIteratorRef* iter_out) {
+  *iter_out = nullptr;
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
   }
 
-  auto handle = new RocksDBIteratorHandle();
-  handle->iter = db->db->NewIterator(readOpts);
-  return handle;
+  std::unique_ptr<rocksdb::TransactionLogIterator> iter;
+  rocksdb::Status s = db->db->GetUpdatesSince(
+    sequence, &iter, rocksdb::TransactionLogIterator::ReadOptions(verify_checksums != 0));
+  if (s.ok()) {
+    auto handle = new RocksDBWalIteratorHandle();
+    handle->iter = std::move(iter);
+    retain_db(db);
+    handle->owner = db;
+    *iter_out = handle;
+  }
+  return make_status(s);
 }
 
-void rocksdb_iterator_destroy(RocksDBIteratorRef iter) {
+void rocksdb_wal_iterator_destroy(RocksDBWalIteratorRef iter) {
   delete iter;
 }
 
-int rocksdb_iterator_valid(RocksDBIteratorRef iter) {
-  return (iter && iter->iter && iter->iter->Valid()) ? 1 : 0;
+int rocksdb_wal_iterator_valid(RocksDBWalIteratorRef iter) {
+  return iter && iter->iter->Valid() ? 1 : 0;
 }
 
-void rocksdb_iterator_seek_to_first(RocksDBIteratorRef iter) {
-  if (iter && iter->iter) {
-    iter->iter->SeekToFirst();
+void rocksdb_wal_iterator_next(RocksDBWalIteratorRef iter) {
+  if (!iter || !iter->iter->Valid()) {
+    return;
   }
+  iter->iter->Next();
+  iter->current = rocksdb::BatchResult();
+  iter->loaded = false;
+  iter->records.clear();
+  iter->record_count = 0;
+  iter->decoded = false;
 }
 
-void rocksdb_iterator_seek_to_last(RocksDBIteratorRef iter) {
-  if (iter && iter->iter) {
-    iter->iter->SeekToLast();
+RocksDBStatus rocksdb_wal_iterator_status(RocksDBWalIteratorRef iter) {
+  if (!iter) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Iterator is null");
+    return result;
   }
+  return make_status(iter->iter->status());
 }
 
-void rocksdb_iterator_seek(RocksDBIteratorRef iter, const char* key, size_t key_len) {
-  if (iter && iter->iter) {
-    iter->iter->Seek(rocksdb::Slice(key, key_len));
+const char* rocksdb_wal_iterator_batch(RocksDBWalIteratorRef iter,
+                                       uint64_t* sequence_out, size_t* count_out,
+                                       size_t* len_out) {
+  *sequence_out = 0;
+  *count_out = 0;
+  *len_out = 0;
+  if (!iter) {
+    return nullptr;
   }
-}
-
-void rocksdb_iterator_seek_for_prev(RocksDBIteratorRef iter, const char* key, size_t key_len) {
-  if (iter && iter->iter) {
-    iter->iter->SeekForPrev(rocksdb::Slice(key, key_len));
+  iter->load();
+  if (!iter->loaded || !iter->current.writeBatchPtr) {
+    return nullptr;
   }
-}
 
-void rocksdb_iterator_next(RocksDBIteratorRef iter) {
-  if (iter && iter->iter) {
-    iter->iter->Next();
-  }
+  const rocksdb::WriteBatch& batch = *iter->current.writeBatchPtr;
+  *sequence_out = iter->current.sequence;
+  *count_out = static_cast<size_t>(batch.Count());
+  *len_out = batch.GetDataSize();
+  return batch.Data().data();
 }
 
-void rocksdb_iterator_prev(RocksDBIteratorRef iter) {
-  if (iter && iter->iter) {
-    iter->iter->Prev();
-  }
-}
+// Appends each operation of a batch to a packed record buffer
+class WalRecordPacker : public rocksdb::WriteBatch::Handler {
+ public:
+  WalRecordPacker(std::string* out, size_t* count) : out_(out), count_(count) {}
 
-const char* rocksdb_iterator_key(RocksDBIteratorRef iter, size_t* len_out) {
-  if (!iter || !iter->iter || !iter->iter->Valid()) {
-    *len_out = 0;
-    return nullptr;
+  rocksdb::Status PutCF(uint32_t cf, const rocksdb::Slice& key, const rocksdb::Slice& value) override {
+    return Append(RocksDBWalRecordPut, cf, key, value);
+  }
+  rocksdb::Status TimedPutCF(uint32_t cf, const rocksdb::Slice& key, const rocksdb::Slice& value,
+                             uint64_t /*write_time*/) override {
+    return Append(RocksDBWalRecordPut, cf, key, value);
+  }
+  rocksdb::Status PutEntityCF(uint32_t cf, const rocksdb::Slice& key,
+                              const rocksdb::Slice& entity) override {
+    return Append(RocksDBWalRecordPutEntity, cf, key, entity);
+  }
+  rocksdb::Status DeleteCF(uint32_t cf, const rocksdb::Slice& key) override {
+    return Append(RocksDBWalRecordDelete, cf, key, rocksdb::Slice());
+  }
+  rocksdb::Status SingleDeleteCF(uint32_t cf, const rocksdb::Slice& key) override {
+    return Append(RocksDBWalRecordSingleDelete, cf, key, rocksdb::Slice());
+  }
+  rocksdb::Status DeleteRangeCF(uint32_t cf, const rocksdb::Slice& begin,
+                                const rocksdb::Slice& end) override {
+    return Append(RocksDBWalRecordDeleteRange, cf, begin, end);
+  }
+  rocksdb::Status MergeCF(uint32_t cf, const rocksdb::Slice& key, const rocksdb::Slice& value) override {
+    return Append(RocksDBWalRecordMerge, cf, key, value);
+  }
+  rocksdb::Status PutBlobIndexCF(uint32_t cf, const rocksdb::Slice& key,
+                                 const rocksdb::Slice& index) override {
+    return Append(RocksDBWalRecordPutBlobIndex, cf, key, index);
+  }
+  void LogData(const rocksdb::Slice& blob) override {
+    Append(RocksDBWalRecordLogData, 0, rocksdb::Slice(), blob);
   }
 
-  rocksdb::Slice key = iter->iter->key();
-  *len_out = key.size();
-  return key.data();
-}
+  // Transaction markers carry no data for a follower
+  rocksdb::Status MarkBeginPrepare(bool) override { return rocksdb::Status::OK(); }
+  rocksdb::Status MarkEndPrepare(const rocksdb::Slice&) override { return rocksdb::Status::OK(); }
+  rocksdb::Status MarkNoop(bool) override { return rocksdb::Status::OK(); }
+  rocksdb::Status MarkRollback(const rocksdb::Slice&) override { return rocksdb::Status::OK(); }
+  rocksdb::Status MarkCommit(const rocksdb::Slice&) override { return rocksdb::Status::OK(); }
+  rocksdb::Status MarkCommitWithTimestamp(const rocksdb::Slice&, const rocksdb::Slice&) override {
+    return rocksdb::Status::OK();
+  }
 
-const char* rocksdb_iterator_value(RocksDBIteratorRef iter, size_t* len_out) {
-  if (!iter || !iter->iter || !iter->iter->Valid()) {
-    *len_out = 0;
-    return nullptr;
+ private:
+  rocksdb::Status Append(RocksDBWalRecordType type, uint32_t cf,
+                         const rocksdb::Slice& key, const rocksdb::Slice& value) {
+    uint8_t type_byte = static_cast<uint8_t>(type);
+    uint32_t key_len = static_cast<uint32_t>(key.size());
+    uint32_t value_len = static_cast<uint32_t>(value.size());
+    out_->append(reinterpret_cast<const char*>(&type_byte), sizeof(type_byte));
+    out_->append(reinterpret_cast<const char*>(&cf), sizeof(cf));
+    out_->append(reinterpret_cast<const char*>(&key_len), sizeof(key_len));
+    out_->append(reinterpret_cast<const char*>(&value_len), sizeof(value_len));
+    out_->append(key.data(), key.size());
+    out_->append(value.data(), value.size());
+    (*count_)++;
+    return rocksdb::Status::OK();
   }
 
-  rocksdb::Slice value = iter->iter->value();
-  *len_out = value.size();
-  return value.data();
-}
+  std::string* out_;
+  size_t* count_;
+};
 
-RocksDBStatus rocksdb_iterator_status(RocksDBIteratorRef iter) {
-  if (!iter || !iter->iter) {
-    RocksDBStatus result;
+RocksDBStatus rocksdb_wal_iterator_decode(RocksDBWalIteratorRef iter,
+                                          const char** records_out, size_t* len_out,
+                                          size_t* count_out) {
+  *records_out = nullptr;
+  *len_out = 0;
+  *count_out = 0;
+  if (!iter) {
+    RocksDBStatus result{};
     result.code = RocksDBStatusInvalidArgument;
     result.message = strdup("Iterator is null");
     return result;
   }
-  return make_status(iter->iter->status());
+  iter->load();
+  if (!iter->loaded || !iter->current.writeBatchPtr) {
+    return make_status(rocksdb::Status::InvalidArgument("WAL iterator is not valid"));
+  }
+
+  if (!iter->decoded) {
+    WalRecordPacker packer(&iter->records, &iter->record_count);
+    rocksdb::Status s = iter->current.writeBatchPtr->Iterate(&packer);
+    if (!s.ok()) {
+      iter->records.clear();
+      iter->record_count = 0;
+      return make_status(s);
+    }
+    iter->decoded = true;
+  }
+
+  *records_out = iter->records.data();
+  *len_out = iter->records.size();
+  *count_out = iter->record_count;
+  return make_status(rocksdb::Status::OK());
 }
 
 // =============================================================================
-// MARK: - Transaction Operations
+// MARK: - Checkpoints
 // =============================================================================
 
-RocksDBTransactionRef rocksdb_transaction_begin(RocksDBRef db, RocksDBWriteOptionsRef opts) {
-  if (!db || !db->is_transactional || !db->txn_db) {
-    return nullptr;
+RocksDBStatus rocksdb_create_checkpoint(RocksDBRef db, const char* dir, uint64_t log_size_for_flush,
+                                        uint64_t* sequence_out) {
+  if (!db || !db->db) {
+    RocksDBStatus result{};
+    result.code = RocksDBStatusInvalidArgument;
+    result.message = strdup("Database is null");
+    return result;
   }
 
-  rocksdb::WriteOptions writeOpts;
-  if (opts) {
-    writeOpts = opts->options;
+  rocksdb::Checkpoint* raw = nullptr;
+  rocksdb::Status s = rocksdb::Checkpoint::Create(db->db, &raw);
+  std::unique_ptr<rocksdb::Checkpoint> checkpoint(raw);
+  if (s.ok()) {
+    s = checkpoint->CreateCheckpoint(dir, log_size_for_flush, sequence_out);
   }
-
-  auto handle = new RocksDBTransactionHandle();
-  handle->txn = db->txn_db->BeginTransaction(writeOpts);
-  return handle;
+  return make_status(s);
 }
 
-void rocksdb_transaction_destroy(RocksDBTransactionRef txn) {
-  delete txn;
-}
+RocksDBStatus rocksdb_export_column_family(RocksDBRef db, RocksDBColumnFamilyRef cf, const char* dir,
+                                           RocksDBExportMetadataRef* metadata_out) {
+  *metadata_out = nullptr;
 
-RocksDBStatus rocksdb_transaction_put(RocksDBTransactionRef txn,
-                                      const char* key, size_t key_len,
-                                      const char* value, size_t value_len) {
-  if (!txn || !txn->txn) {
-    RocksDBStatus result;
+  if (!db || !db->db) {
+    RocksDBStatus result{};
     result.code = RocksDBStatusInvalidArgument;
-    result.message = strdup("Transaction is null");
+    result.message = strdup("Database is null");
     return result;
   }
 
-  rocksdb::Status s = txn->txn->Put(rocksdb::Slice(key, key_len),
-                                     rocksdb::Slice(value, value_len));
+  rocksdb::Checkpoint* raw = nullptr;
+  rocksdb::Status s = rocksdb::Checkpoint::Create(db->db, &raw);
+  std::unique_ptr<rocksdb::Checkpoint> checkpoint(raw);
+  rocksdb::ExportImportFilesMetaData* metadata = nullptr;
+  if (s.ok()) {
+    s = checkpoint->ExportColumnFamily(column_family(db, cf), dir, &metadata);
+  }
+  if (s.ok()) {
+    auto handle = new RocksDBExportMetadataHandle();
+    handle->metadata.reset(metadata);
+    *metadata_out = handle;
+  }
   return make_status(s);
 }
 
-RocksDBStatus rocksdb_transaction_get(RocksDBTransactionRef txn, RocksDBReadOptionsRef opts,
-                                      const char* key, size_t key_len,
-                                      char** value_out, size_t* value_len_out) {
-  *value_out = nullptr;
-  *value_len_out = 0;
+void rocksdb_export_metadata_destroy(RocksDBExportMetadataRef metadata) {
+  delete metadata;
+}
 
-  if (!txn || !txn->txn) {
-    RocksDBStatus result;
+size_t rocksdb_export_metadata_file_count(RocksDBExportMetadataRef metadata) {
+  return metadata ? metadata->metadata->files.size() : 0;
+}
+
+char* rocksdb_export_metadata_comparator(RocksDBExportMetadataRef metadata) {
+  return metadata ? strdup(metadata->metadata->db_comparator_name.c_str()) : nullptr;
+}
+
+RocksDBStatus rocksdb_create_column_family_with_import(RocksDBRef db, RocksDBOptionsRef opts,
+                                                       const char* name, int move_files,
+                                                       RocksDBExportMetadataRef metadata,
+                                                       RocksDBColumnFamilyRef* cf_out) {
+  *cf_out = nullptr;
+
+  if (!db || !db->db || !metadata) {
+    RocksDBStatus result{};
     result.code = RocksDBStatusInvalidArgument;
-    result.message = strdup("Transaction is null");
+    result.message = strdup("Database or export metadata is null");
     return result;
   }
 
-  rocksdb::ReadOptions readOpts;
-  if (opts) {
-    readOpts = opts->options;
+  rocksdb::ImportColumnFamilyOptions import_options;
+  import_options.move_files = (move_files != 0);
+  rocksdb::ColumnFamilyHandle* handle = nullptr;
+  rocksdb::Status s = db->db->CreateColumnFamilyWithImport(
+    rocksdb::ColumnFamilyOptions(opts->options), name, import_options, *metadata->metadata, &handle);
+  if (s.ok()) {
+    *cf_out = add_column_family(db, handle);
   }
+  return make_status(s);
+}
 
-  std::string value;
-  rocksdb::Status s = txn->txn->Get(readOpts, rocksdb::Slice(key, key_len), &value);
+// =============================================================================
+// MARK: - Backups
+// =============================================================================
 
+static RocksDBStatus null_backup_engine_status() {
+  RocksDBStatus result{};
+  result.code = RocksDBStatusInvalidArgument;
+  result.message = strdup("Backup engine is null");
+  return result;
+}
+
+RocksDBStatus rocksdb_backup_engine_open(const char* dir, const RocksDBBackupEngineValues* options,
+                                         RocksDBBackupEngineRef* engine_out) {
+  *engine_out = nullptr;
+
+  rocksdb::BackupEngineOptions engine_options(dir);
+  engine_options.share_table_files = (options->share_table_files != 0);
+  engine_options.share_files_with_checksum =
+    engine_options.share_table_files && options->share_files_with_checksum != 0;
+  engine_options.sync = (options->sync != 0);
+  engine_options.destroy_old_data = (options->destroy_old_data != 0);
+  engine_options.backup_log_files = (options->backup_log_files != 0);
+  engine_options.backup_rate_limit = options->backup_rate_limit;
+  engine_options.restore_rate_limit = options->restore_rate_limit;
+  engine_options.max_background_operations = std::max(options->max_background_operations, 1);
+
+  rocksdb::BackupEngine* engine = nullptr;
+  rocksdb::IOStatus s = rocksdb::BackupEngine::Open(engine_options, rocksdb::Env::Default(), &engine);
   if (s.ok()) {
-    *value_len_out = value.size();
-    *value_out = static_cast<char*>(malloc(value.size()));
-    if (*value_out) {
-      memcpy(*value_out, value.data(), value.size());
-    }
+    auto handle = new RocksDBBackupEngineHandle();
+    handle->engine.reset(engine);
+    *engine_out = handle;
   }
-
   return make_status(s);
 }
 
-RocksDBStatus rocksdb_transaction_get_for_update(RocksDBTransactionRef txn, RocksDBReadOptionsRef opts,
-                                                  const char* key, size_t key_len,
-                                                  char** value_out, size_t* value_len_out) {
-  *value_out = nullptr;
-  *value_len_out = 0;
+void rocksdb_backup_engine_close(RocksDBBackupEngineRef engine) {
+  delete engine;
+}
 
-  if (!txn || !txn->txn) {
-    RocksDBStatus result;
+RocksDBStatus rocksdb_backup_engine_create_new_backup(RocksDBBackupEngineRef engine, RocksDBRef db,
+                                                      int flush_before_backup,
+                                                      const char* app_metadata,
+                                                      uint32_t* id_out) {
+  if (!engine) {
+    return null_backup_engine_status();
+  }
+  if (!db || !db->db) {
+    RocksDBStatus result{};
     result.code = RocksDBStatusInvalidArgument;
-    result.message = strdup("Transaction is null");
+    result.message = strdup("Database is null");
     return result;
   }
 
-  rocksdb::ReadOptions readOpts;
-  if (opts) {
-    readOpts = opts->options;
+  rocksdb::CreateBackupOptions options;
+  options.flush_before_backup = (flush_before_backup != 0);
+  rocksdb::BackupID backup_id = 0;
+  rocksdb::IOStatus s = engine->engine->CreateNewBackupWithMetadata(
+    options, db->db, app_metadata ? app_metadata : "", &backup_id);
+  if (s.ok() && id_out) {
+    *id_out = backup_id;
   }
+  return make_status(s);
+}
 
-  std::string value;
-  rocksdb::Status s = txn->txn->GetForUpdate(readOpts, rocksdb::Slice(key, key_len), &value);
+void rocksdb_backup_engine_stop_backup(RocksDBBackupEngineRef engine) {
+  if (engine) {
+    engine->engine->StopBackup();
+  }
+}
 
-  if (s.ok()) {
-    *value_len_out = value.size();
-    *value_out = static_cast<char*>(malloc(value.size()));
-    if (*value_out) {
-      memcpy(*value_out, value.data(), value.size());
-    }
+RocksDBStatus rocksdb_backup_engine_purge_old_backups(RocksDBBackupEngineRef engine, uint32_t num_to_keep) {
+  if (!engine) {
+    return null_backup_engine_status();
   }
+  return make_status(engine->engine->PurgeOldBackups(num_to_keep));
+}
 
-  return make_status(s);
+RocksDBStatus rocksdb_backup_engine_delete_backup(RocksDBBackupEngineRef engine, uint32_t backup_id) {
+  if (!engine) {
+    return null_backup_engine_status();
+  }
+  return make_status(engine->engine->DeleteBackup(backup_id));
 }
 
-RocksDBStatus rocksdb_transaction_delete(RocksDBTransactionRef txn,
-                                         const char* key, size_t key_len) {
-  if (!txn || !txn->txn) {
-    RocksDBStatus result;
-    result.code = RocksDBStatusInvalidArgument;
-    result.message = strdup("Transaction is null");
-    return result;
+RocksDBStatus rocksdb_backup_engine_garbage_collect(RocksDBBackupEngineRef engine) {
+  if (!engine) {
+    return null_backup_engine_status();
   }
+  return make_status(engine->engine->GarbageCollect());
+}
 
-  rocksdb::Status s = txn->txn->Delete(rocksdb::Slice(key, key_len));
-  return make_status(s);
+RocksDBStatus rocksdb_backup_engine_verify_backup(RocksDBBackupEngineRef engine, uint32_t backup_id,
+                                                  int verify_with_checksum) {
+  if (!engine) {
+    return null_backup_engine_status();
+  }
+  return make_status(engine->engine->VerifyBackup(backup_id, verify_with_checksum != 0));
 }
 
-RocksDBIteratorRef rocksdb_transaction_create_iterator(RocksDBTransactionRef txn,
-                                                        RocksDBReadOptionsRef opts) {
-  if (!txn || !txn->txn) {
-    return nullptr;
+void rocksdb_backup_engine_get_backup_info(RocksDBBackupEngineRef engine,
+                                           RocksDBBackupInfoValues** infos_out, size_t* count_out) {
+  *infos_out = nullptr;
+  *count_out = 0;
+  if (!engine) {
+    return;
   }
 
-  rocksdb::ReadOptions readOpts;
-  if (opts) {
-    readOpts = opts->options;
+  std::vector<rocksdb::BackupInfo> infos;
+  engine->engine->GetBackupInfo(&infos);
+  if (infos.empty()) {
+    return;
   }
 
-  auto handle = new RocksDBIteratorHandle();
-  handle->iter = txn->txn->GetIterator(readOpts);
-  return handle;
+  auto* values = static_cast<RocksDBBackupInfoValues*>(malloc(infos.size() * sizeof(RocksDBBackupInfoValues)));
+  for (size_t i = 0; i < infos.size(); i++) {
+    values[i].backup_id = infos[i].backup_id;
+    values[i].timestamp = infos[i].timestamp;
+    values[i].size = infos[i].size;
+    values[i].number_files = infos[i].number_files;
+  }
+  *infos_out = values;
+  *count_out = infos.size();
 }
 
-RocksDBStatus rocksdb_transaction_commit(RocksDBTransactionRef txn) {
-  if (!txn || !txn->txn) {
-    RocksDBStatus result;
-    result.code = RocksDBStatusInvalidArgument;
-    result.message = strdup("Transaction is null");
-    return result;
+RocksDBStatus rocksdb_backup_engine_get_backup_metadata(RocksDBBackupEngineRef engine, uint32_t backup_id,
+                                                        char** metadata_out) {
+  *metadata_out = nullptr;
+  if (!engine) {
+    return null_backup_engine_status();
   }
 
-  rocksdb::Status s = txn->txn->Commit();
+  rocksdb::BackupInfo info;
+  rocksdb::Status s = engine->engine->GetBackupInfo(backup_id, &info);
+  if (s.ok()) {
+    *metadata_out = strdup(info.app_metadata.c_str());
+  }
   return make_status(s);
 }
 
-void rocksdb_transaction_rollback(RocksDBTransactionRef txn) {
-  if (txn && txn->txn) {
-    txn->txn->Rollback();
+RocksDBStatus rocksdb_backup_engine_restore(RocksDBBackupEngineRef engine, uint32_t backup_id,
+                                            const char* db_dir, const char* wal_dir,
+                                            int keep_log_files) {
+  if (!engine) {
+    return null_backup_engine_status();
   }
-}
 
-void rocksdb_transaction_set_savepoint(RocksDBTransactionRef txn) {
-  if (txn && txn->txn) {
-    txn->txn->SetSavePoint();
-  }
+  rocksdb::RestoreOptions options(keep_log_files != 0);
+  std::string wal = wal_dir ? wal_dir : db_dir;
+  rocksdb::IOStatus s = backup_id == 0
+    ? engine->engine->RestoreDBFromLatestBackup(options, db_dir, wal)
+    : engine->engine->RestoreDBFromBackup(options, backup_id, db_dir, wal);
+  return make_status(s);
 }
 
-RocksDBStatus rocksdb_transaction_rollback_to_savepoint(RocksDBTransactionRef txn) {
-  if (!txn || !txn->txn) {
-    RocksDBStatus result;
+// =============================================================================
+// MARK: - Microbenchmarks
+// =============================================================================
+
+// Read results land here so the timed loops cannot be optimized away
+static volatile size_t g_microbench_sink = 0;
+
+RocksDBStatus rocksdb_microbench_raw(RocksDBRef db, RocksDBColumnFamilyRef cf, int op,
+                                     const char* keys, size_t key_len, size_t key_count,
+                                     const char* value, size_t value_len,
+                                     uint64_t iterations, uint64_t* nanos_out) {
+  *nanos_out = 0;
+  if (!db || !db->db) {
+    RocksDBStatus result{};
     result.code = RocksDBStatusInvalidArgument;
-    result.message = strdup("Transaction is null");
+    result.message = strdup("Database is null");
     return result;
   }
+  if (key_count == 0 && op != RocksDBMicrobenchNext) {
+    return make_status(rocksdb::Status::InvalidArgument("No keys given"));
+  }
 
-  rocksdb::Status s = txn->txn->RollbackToSavePoint();
-  return make_status(s);
+  rocksdb::DB* raw = db->db;
+  rocksdb::ColumnFamilyHandle* family = column_family(db, cf);
+  const rocksdb::Slice value_slice(value, value_len);
+  auto key_at = [&](uint64_t i) {
+    return rocksdb::Slice(keys + (i % key_count) * key_len, key_len);
+  };
+
+  rocksdb::Status status;
+  size_t checksum = 0;
+  const auto start = std::chrono::steady_clock::now();
+  switch (op) {
+    case RocksDBMicrobenchPut: {
+      const rocksdb::WriteOptions options;
+      for (uint64_t i = 0; i < iterations && status.ok(); i++) {
+        status = raw->Put(options, family, key_at(i), value_slice);
+      }
+      break;
+    }
+    case RocksDBMicrobenchGet: {
+      const rocksdb::ReadOptions options;
+      rocksdb::PinnableSlice pinned;
+      for (uint64_t i = 0; i < iterations && (status.ok() || status.IsNotFound()); i++) {
+        pinned.Reset();
+        status = raw->Get(options, family, key_at(i), &pinned);
+        checksum += pinned.size();
+      }
+      if (status.IsNotFound()) {
+        status = rocksdb::Status::OK();
+      }
+      break;
+    }
+    case RocksDBMicrobenchNext: {
+      std::unique_ptr<rocksdb::Iterator> iter(raw->NewIterator(rocksdb::ReadOptions(), family));
+      iter->SeekToFirst();
+      for (uint64_t i = 0; i < iterations && iter->Valid(); i++) {
+        checksum += iter->key().size() + iter->value().size();
+        iter->Next();
+        if (!iter->Valid()) {
+          iter->SeekToFirst();
+        }
+      }
+      status = iter->status();
+      break;
+    }
+    case RocksDBMicrobenchBatchAppend: {
+      rocksdb::WriteBatch batch;
+      for (uint64_t i = 0; i < iterations && status.ok(); i++) {
+        if (i % key_count == 0) {
+          batch.Clear();
+        }
+        status = batch.Put(family, key_at(i), value_slice);
+      }
+      checksum += batch.Count();
+      break;
+    }
+    default:
+      return make_status(rocksdb::Status::InvalidArgument("Unknown microbenchmark op"));
+  }
+  *nanos_out = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start).count());
+
+  g_microbench_sink = checksum;
+  return make_status(status);
 }
 
 // =============================================================================
-// MARK: - Snapshot Operations
+// MARK: - Environment
 // =============================================================================
 
-RocksDBSnapshotRef rocksdb_create_snapshot(RocksDBRef db) {
-  if (!db || !db->db) {
-    return nullptr;
+static rocksdb::Env::Priority env_priority(int pool) {
+  switch (pool) {
+    case RocksDBThreadPoolBottom: return rocksdb::Env::BOTTOM;
+    case RocksDBThreadPoolHigh: return rocksdb::Env::HIGH;
+    default: return rocksdb::Env::LOW;
   }
+}
 
-  auto handle = new RocksDBSnapshotHandle();
-  handle->snapshot = db->db->GetSnapshot();
-  return handle;
+void rocksdb_env_set_background_threads(int pool, int num_threads) {
+  rocksdb::Env::Default()->SetBackgroundThreads(std::max(num_threads, 0), env_priority(pool));
 }
 
-void rocksdb_release_snapshot(RocksDBRef db, RocksDBSnapshotRef snapshot) {
-  if (db && db->db && snapshot && snapshot->snapshot) {
-    db->db->ReleaseSnapshot(snapshot->snapshot);
+int rocksdb_env_get_background_threads(int pool) {
+  return rocksdb::Env::Default()->GetBackgroundThreads(env_priority(pool));
+}
+
+RocksDBStatus rocksdb_env_lower_thread_pool_cpu_priority(int pool, int cpu_priority) {
+  rocksdb::Status s = rocksdb::Env::Default()->LowerThreadPoolCPUPriority(
+    env_priority(pool), static_cast<rocksdb::CpuPriority>(std::clamp(cpu_priority, 0, 3)));
+  return make_status(s);
+}
+
+void rocksdb_env_lower_thread_pool_io_priority(int pool) {
+  rocksdb::Env::Default()->LowerThreadPoolIOPriority(env_priority(pool));
+}
+
+static void copy_name(char* dest, size_t capacity, const std::string& name) {
+  size_t len = std::min(name.size(), capacity - 1);
+  memcpy(dest, name.data(), len);
+  dest[len] = '\0';
+}
+
+RocksDBStatus rocksdb_env_get_thread_list(RocksDBThreadStatusValues** threads_out, size_t* count_out) {
+  *threads_out = nullptr;
+  *count_out = 0;
+
+  std::vector<rocksdb::ThreadStatus> threads;
+  rocksdb::Status s = rocksdb::Env::Default()->GetThreadList(&threads);
+  if (!s.ok()) {
+    return make_status(s);
   }
-  delete snapshot;
+  if (threads.empty()) {
+    return make_ok();
+  }
+
+  auto out = static_cast<RocksDBThreadStatusValues*>(calloc(threads.size(), sizeof(RocksDBThreadStatusValues)));
+  if (!out) {
+    return make_status(rocksdb::Status::MemoryLimit("Cannot allocate thread list"));
+  }
+
+  for (size_t i = 0; i < threads.size(); i++) {
+    const rocksdb::ThreadStatus& thread = threads[i];
+    RocksDBThreadStatusValues& values = out[i];
+    values.thread_id = thread.thread_id;
+    values.thread_type = static_cast<int>(thread.thread_type);
+    values.operation_type = static_cast<int>(thread.operation_type);
+    values.operation_stage = static_cast<int>(thread.operation_stage);
+    values.state_type = static_cast<int>(thread.state_type);
+    values.elapsed_micros = thread.op_elapsed_micros;
+    copy_name(values.db_name, sizeof(values.db_name), thread.db_name);
+    copy_name(values.cf_name, sizeof(values.cf_name), thread.cf_name);
+    values.input_level = -1;
+    values.output_level = -1;
+
+    // Unpacks the level pair and flags of compactions
+    std::map<std::string, uint64_t> props = rocksdb::ThreadStatus::InterpretOperationProperties(
+        thread.operation_type, thread.op_properties);
+    auto prop = [&](const char* name) -> uint64_t {
+      auto it = props.find(name);
+      return it == props.end() ? 0 : it->second;
+    };
+    if (thread.operation_type == rocksdb::ThreadStatus::OP_COMPACTION) {
+      values.job_id = prop("JobID");
+      values.input_level = static_cast<int>(prop("BaseInputLevel"));
+      values.output_level = static_cast<int>(prop("OutputLevel"));
+      values.is_manual = prop("IsManual") != 0 ? 1 : 0;
+      values.total_input_bytes = prop("TotalInputBytes");
+      values.bytes_read = prop("BytesRead");
+      values.bytes_written = prop("BytesWritten");
+    } else if (thread.operation_type == rocksdb::ThreadStatus::OP_FLUSH) {
+      values.job_id = prop("JobID");
+      values.total_input_bytes = prop("BytesMemtables");
+      values.bytes_written = prop("BytesWritten");
+    }
+  }
+
+  *threads_out = out;
+  *count_out = threads.size();
+  return make_ok();
+}
+
+const char* rocksdb_thread_operation_name(int operation_type) {
+  if (operation_type < 0 || operation_type >= rocksdb::ThreadStatus::NUM_OP_TYPES) {
+    return "";
+  }
+  return rocksdb::ThreadStatus::GetOperationName(
+      static_cast<rocksdb::ThreadStatus::OperationType>(operation_type)).c_str();
+}
+
+const char* rocksdb_thread_stage_name(int operation_stage) {
+  if (operation_stage < 0 || operation_stage >= rocksdb::ThreadStatus::NUM_OP_STAGES) {
+    return "";
+  }
+  return rocksdb::ThreadStatus::GetOperationStageName(
+      static_cast<rocksdb::ThreadStatus::OperationStage>(operation_stage)).c_str();
 }
 
 // =============================================================================
-// MARK: - Maintenance Operations
+// MARK: - Remote Compaction
 // =============================================================================
 
-RocksDBStatus rocksdb_compact_range(RocksDBRef db,
-                                    const char* start_key, size_t start_key_len,
-                                    const char* end_key, size_t end_key_len) {
-  if (!db || !db->db) {
-    RocksDBStatus result;
-    result.code = RocksDBStatusInvalidArgument;
-    result.message = strdup("Database is null");
-    return result;
+static rocksdb::CompactionServiceJobStatus compaction_job_status(int status) {
+  switch (status) {
+    case RocksDBCompactionJobSuccess:
+      return rocksdb::CompactionServiceJobStatus::kSuccess;
+    case RocksDBCompactionJobFailure:
+      return rocksdb::CompactionServiceJobStatus::kFailure;
+    default:
+      return rocksdb::CompactionServiceJobStatus::kUseLocal;
   }
+}
 
-  rocksdb::CompactRangeOptions compactOpts;
+// Forwards Schedule/Wait to the caller's callbacks and releases their
+// context once the last options or database referencing it is gone
+class BridgeCompactionService : public rocksdb::CompactionService {
+ public:
+  BridgeCompactionService(std::string name, void* context, RocksDBCompactionScheduleFn schedule,
+                          RocksDBCompactionWaitFn wait, RocksDBCompactionInstalledFn installed,
+                          RocksDBCompactionServiceDestroyFn destroy)
+    : name_(std::move(name)), context_(context), schedule_(schedule), wait_(wait),
+      installed_(installed), destroy_(destroy) {}
+
+  ~BridgeCompactionService() override {
+    if (destroy_) {
+      destroy_(context_);
+    }
+  }
 
-  rocksdb::Slice* start = nullptr;
-  rocksdb::Slice* end = nullptr;
-  rocksdb::Slice startSlice, endSlice;
+  const char* Name() const override { return name_.c_str(); }
+
+  rocksdb::CompactionServiceScheduleResponse Schedule(
+      const rocksdb::CompactionServiceJobInfo& info, const std::string& input) override {
+    RocksDBCompactionJobInfo job{};
+    job.db_name = info.db_name.c_str();
+    job.db_id = info.db_id.c_str();
+    job.db_session_id = info.db_session_id.c_str();
+    job.job_id = info.job_id;
+    job.priority = static_cast<int>(info.priority);
+    job.compaction_reason = static_cast<int>(info.compaction_reason);
+    job.is_full_compaction = info.is_full_compaction ? 1 : 0;
+    job.is_manual_compaction = info.is_manual_compaction ? 1 : 0;
+    job.bottommost_level = info.bottommost_level ? 1 : 0;
+
+    char* job_id = nullptr;
+    int status = schedule_(context_, &job, input.data(), input.size(), &job_id);
+    std::string scheduled_id = job_id ? job_id : "";
+    free(job_id);
+    return rocksdb::CompactionServiceScheduleResponse(scheduled_id, compaction_job_status(status));
+  }
 
-  if (start_key && start_key_len > 0) {
-    startSlice = rocksdb::Slice(start_key, start_key_len);
-    start = &startSlice;
+  rocksdb::CompactionServiceJobStatus Wait(const std::string& scheduled_job_id,
+                                           std::string* result) override {
+    char* output = nullptr;
+    size_t output_len = 0;
+    int status = wait_(context_, scheduled_job_id.c_str(), &output, &output_len);
+    if (output) {
+      result->assign(output, output_len);
+      free(output);
+    }
+    return compaction_job_status(status);
   }
-  if (end_key && end_key_len > 0) {
-    endSlice = rocksdb::Slice(end_key, end_key_len);
-    end = &endSlice;
+
+  void OnInstallation(const std::string& scheduled_job_id,
+                      rocksdb::CompactionServiceJobStatus status) override {
+    if (installed_) {
+      installed_(context_, scheduled_job_id.c_str(), static_cast<int>(status));
+    }
   }
 
-  rocksdb::Status s = db->db->CompactRange(compactOpts, start, end);
-  return make_status(s);
+ private:
+  std::string name_;
+  void* context_;
+  RocksDBCompactionScheduleFn schedule_;
+  RocksDBCompactionWaitFn wait_;
+  RocksDBCompactionInstalledFn installed_;
+  RocksDBCompactionServiceDestroyFn destroy_;
+};
+
+void rocksdb_options_set_compaction_service(RocksDBOptionsRef opts, const char* name, void* context,
+                                            RocksDBCompactionScheduleFn schedule,
+                                            RocksDBCompactionWaitFn wait,
+                                            RocksDBCompactionInstalledFn installed,
+                                            RocksDBCompactionServiceDestroyFn destroy) {
+  if (!opts || !schedule || !wait) {
+    if (destroy) {
+      destroy(context);
+    }
+    return;
+  }
+  opts->options.compaction_service = std::make_shared<BridgeCompactionService>(
+    name ? name : "RocksDBSwiftCompactionService", context, schedule, wait, installed, destroy);
 }
 
-RocksDBStatus rocksdb_flush(RocksDBRef db, int wait) {
-  if (!db || !db->db) {
-    RocksDBStatus result;
+RocksDBStatus rocksdb_open_and_compact(const char* name, const char* output_directory,
+                                       const char* input, size_t input_len,
+                                       RocksDBOptionsRef opts, RocksDBCancelFlagRef canceled,
+                                       char** output_out, size_t* output_len_out) {
+  *output_out = nullptr;
+  *output_len_out = 0;
+  if (!name || !output_directory || !opts) {
+    RocksDBStatus result{};
     result.code = RocksDBStatusInvalidArgument;
-    result.message = strdup("Database is null");
+    result.message = strdup("Database name, output directory or options is null");
     return result;
   }
 
-  rocksdb::FlushOptions flushOpts;
-  flushOpts.wait = (wait != 0);
-
-  rocksdb::Status s = db->db->Flush(flushOpts);
-  return make_status(s);
-}
+  const rocksdb::Options& options = opts->options;
+  rocksdb::CompactionServiceOptionsOverride overrides;
+  overrides.env = options.env;
+  overrides.file_checksum_gen_factory = options.file_checksum_gen_factory;
+  overrides.comparator = options.comparator;
+  overrides.merge_operator = options.merge_operator;
+  overrides.compaction_filter = options.compaction_filter;
+  overrides.compaction_filter_factory = options.compaction_filter_factory;
+  overrides.prefix_extractor = options.prefix_extractor;
+  overrides.table_factory = options.table_factory;
+  overrides.sst_partitioner_factory = options.sst_partitioner_factory;
+  overrides.listeners = options.listeners;
+  overrides.statistics = options.statistics;
+  overrides.table_properties_collector_factories = options.table_properties_collector_factories;
+
+  rocksdb::Status s = options.env->CreateDirIfMissing(output_directory);
+  if (!s.ok()) {
+    return make_status(s);
+  }
 
-char* rocksdb_get_property(RocksDBRef db, const char* property) {
-  if (!db || !db->db) {
-    return nullptr;
+  rocksdb::OpenAndCompactOptions compact_options;
+  compact_options.canceled = canceled ? &canceled->canceled : nullptr;
+  std::string output;
+  s = rocksdb::DB::OpenAndCompact(compact_options, name, output_directory,
+                                  std::string(input ? input : "", input_len), &output, overrides);
+  if (!s.ok()) {
+    return make_status(s);
   }
 
-  std::string value;
-  if (db->db->GetProperty(property, &value)) {
-    return strdup(value.c_str());
+  if (!output.empty()) {
+    char* buffer = static_cast<char*>(malloc(output.size()));
+    memcpy(buffer, output.data(), output.size());
+    *output_out = buffer;
+    *output_len_out = output.size();
   }
-  return nullptr;
+  return make_ok();
 }
 
-void rocksdb_get_approximate_sizes(RocksDBRef db,
-                                   int num_ranges,
-                                   const char* const* start_keys,
-                                   const size_t* start_key_lens,
-                                   const char* const* end_keys,
-                                   const size_t* end_key_lens,
-                                   uint64_t* sizes_out) {
-  if (!db || !db->db || num_ranges <= 0) {
-    return;
-  }
+// =============================================================================
+// MARK: - I/O Thread Pool
+// =============================================================================
 
-  std::vector<rocksdb::Range> ranges;
-  ranges.reserve(num_ranges);
+// Created on first use and intentionally never destroyed, so jobs still
+// queued at exit cannot race static destructors
+static rocksdb::ThreadPool* io_pool() {
+  static rocksdb::ThreadPool* pool = rocksdb::NewThreadPool(8);
+  return pool;
+}
 
-  for (int i = 0; i < num_ranges; i++) {
-    ranges.emplace_back(
-      rocksdb::Slice(start_keys[i], start_key_lens[i]),
-      rocksdb::Slice(end_keys[i], end_key_lens[i])
-    );
-  }
+void rocksdb_io_pool_submit(RocksDBIOJob job, void* context) {
+  io_pool()->SubmitJob([job, context] { job(context); });
+}
 
-  db->db->GetApproximateSizes(ranges.data(), num_ranges, sizes_out);
+void rocksdb_io_pool_set_threads(int num_threads) {
+  io_pool()->SetBackgroundThreads(std::max(num_threads, 1));
+}
+
+int rocksdb_io_pool_get_threads(void) {
+  return io_pool()->GetBackgroundThreads();
+}
+
+unsigned int rocksdb_io_pool_queue_length(void) {
+  return io_pool()->GetQueueLen();
 }
@@ -27,6 +27,31 @@ typedef struct RocksDBOptionsHandle* RocksDBOptionsRef;
 typedef struct RocksDBReadOptionsHandle* RocksDBReadOptionsRef;
 typedef struct RocksDBWriteOptionsHandle* RocksDBWriteOptionsRef;
 typedef struct RocksDBSnapshotHandle* RocksDBSnapshotRef;
+typedef struct RocksDBPinnableSliceHandle* RocksDBPinnableSliceRef;
+typedef struct RocksDBTableOptionsHandle* RocksDBTableOptionsRef;
+typedef struct RocksDBCacheHandle* RocksDBCacheRef;
+typedef struct RocksDBWriteBufferManagerHandle* RocksDBWriteBufferManagerRef;
+typedef struct RocksDBRateLimiterHandle* RocksDBRateLimiterRef;
+typedef struct RocksDBSstFileManagerHandle* RocksDBSstFileManagerRef;
+typedef struct RocksDBCompactionFilterHandle* RocksDBCompactionFilterRef;
+typedef struct RocksDBSstFileWriterHandle* RocksDBSstFileWriterRef;
+typedef struct RocksDBIngestOptionsHandle* RocksDBIngestOptionsRef;
+typedef struct RocksDBColumnFamilyHandle* RocksDBColumnFamilyRef;
+typedef struct RocksDBWideColumnsHandle* RocksDBWideColumnsRef;
+typedef struct RocksDBAttributeGroupsHandle* RocksDBAttributeGroupsRef;
+typedef struct RocksDBAttributeGroupIteratorHandle* RocksDBAttributeGroupIteratorRef;
+typedef struct RocksDBTransactionDBOptionsHandle* RocksDBTransactionDBOptionsRef;
+typedef struct RocksDBIndexedBatchHandle* RocksDBIndexedBatchRef;
+typedef struct RocksDBOccLockBucketsHandle* RocksDBOccLockBucketsRef;
+typedef struct RocksDBReadContextHandle* RocksDBReadContextRef;
+typedef struct RocksDBCompactRangeOptionsHandle* RocksDBCompactRangeOptionsRef;
+typedef struct RocksDBCompactionOptionsHandle* RocksDBCompactionOptionsRef;
+typedef struct RocksDBCancelFlagHandle* RocksDBCancelFlagRef;
+typedef struct RocksDBEventListenerHandle* RocksDBEventListenerRef;
+typedef struct RocksDBExportMetadataHandle* RocksDBExportMetadataRef;
+typedef struct RocksDBBackupEngineHandle* RocksDBBackupEngineRef;
+typedef struct RocksDBScanPredicateHandle* RocksDBScanPredicateRef;
+typedef struct RocksDBWalIteratorHandle* RocksDBWalIteratorRef;
 
 // =============================================================================
 // MARK: - Status Codes
@@ -50,9 +75,13 @@ typedef enum {
   RocksDBStatusCompactionTooLarge = 14
 } RocksDBStatusCode;
 
+// Statuses are returned by value without allocating, except for message.
+// A NotFound carrying no detail (e.g. a missed lookup) has a NULL message,
+// so negative lookups cost no heap allocation.
 typedef struct {
   RocksDBStatusCode code;
-  char* message;  // Caller must free with rocksdb_free_string
+  int subcode;    // rocksdb::Status::SubCode (e.g. lock timeout, no space); 0 if none
+  char* message;  // Caller must free with rocksdb_free_string; may be NULL
 } RocksDBStatus;
 
 // =============================================================================
@@ -70,6 +99,570 @@ typedef enum {
   RocksDBCompressionZSTD = 7
 } RocksDBCompressionType;
 
+// =============================================================================
+// MARK: - Prefix Extractor Types
+// =============================================================================
+
+typedef enum {
+  RocksDBPrefixExtractorNone = 0,
+  RocksDBPrefixExtractorFixed = 1,
+  RocksDBPrefixExtractorCapped = 2
+} RocksDBPrefixExtractorType;
+
+// =============================================================================
+// MARK: - Memtable Types
+// =============================================================================
+
+typedef enum {
+  RocksDBMemtableRepSkipList = 0,
+  RocksDBMemtableRepVector = 1,
+  RocksDBMemtableRepHashSkipList = 2,
+  RocksDBMemtableRepHashLinkList = 3
+} RocksDBMemtableRepType;
+
+// =============================================================================
+// MARK: - Compaction Style Types
+// =============================================================================
+
+typedef enum {
+  RocksDBCompactionStyleLevel = 0,
+  RocksDBCompactionStyleUniversal = 1,
+  RocksDBCompactionStyleFIFO = 2
+} RocksDBCompactionStyleType;
+
+// =============================================================================
+// MARK: - Merge Operator Types
+// =============================================================================
+
+typedef enum {
+  RocksDBMergeOperatorNone = 0,
+  RocksDBMergeOperatorUInt64Add = 1,      // Little-endian uint64 addition
+  RocksDBMergeOperatorStringAppend = 2,   // Append with delimiter
+  RocksDBMergeOperatorMax = 3             // Bytewise maximum
+} RocksDBMergeOperatorType;
+
+// =============================================================================
+// MARK: - Index Types
+// =============================================================================
+
+typedef enum {
+  RocksDBIndexBinarySearch = 0,
+  RocksDBIndexHashSearch = 1,
+  RocksDBIndexTwoLevelIndexSearch = 2,
+  RocksDBIndexBinarySearchWithFirstKey = 3
+} RocksDBIndexTypeCode;
+
+// =============================================================================
+// MARK: - Comparator Types
+// =============================================================================
+
+typedef enum {
+  RocksDBComparatorBytewise = 0,
+  RocksDBComparatorBytewiseU64Timestamp = 1,  // Bytewise keys with a uint64 user timestamp
+  RocksDBComparatorReverseBytewise = 2,
+  RocksDBComparatorDescendingU64Prefix = 3    // Big-endian uint64 prefix descending, rest bytewise
+} RocksDBComparatorType;
+
+// =============================================================================
+// MARK: - Transaction Modes
+// =============================================================================
+
+typedef enum {
+  RocksDBTransactionModeOptimistic = 0,   // OptimisticTransactionDB: conflicts fail at commit
+  RocksDBTransactionModePessimistic = 1   // TransactionDB: row locks taken on write
+} RocksDBTransactionModeCode;
+
+typedef enum {
+  RocksDBOccValidateSerial = 0,    // Validate inside the write group, behind the DB mutex
+  RocksDBOccValidateParallel = 1   // Validate before the write group under striped key locks
+} RocksDBOccValidationPolicy;
+
+typedef enum {
+  RocksDBTxnWriteCommitted = 0,   // Writes reach the memtable at commit
+  RocksDBTxnWritePrepared = 1,    // Writes reach the memtable at prepare; commit writes a marker
+  RocksDBTxnWriteUnprepared = 2   // Large batches spill to the memtable before prepare
+} RocksDBTxnWritePolicy;
+
+// =============================================================================
+// MARK: - Rate Limiter Modes
+// =============================================================================
+
+typedef enum {
+  RocksDBRateLimiterReadsOnly = 0,
+  RocksDBRateLimiterWritesOnly = 1,
+  RocksDBRateLimiterAllIo = 2
+} RocksDBRateLimiterModeCode;
+
+// =============================================================================
+// MARK: - Bottommost Level Compaction
+// =============================================================================
+
+typedef enum {
+  RocksDBBottommostSkip = 0,
+  RocksDBBottommostIfHaveCompactionFilter = 1,
+  RocksDBBottommostForce = 2,
+  RocksDBBottommostForceOptimized = 3
+} RocksDBBottommostLevelCompactionCode;
+
+// =============================================================================
+// MARK: - Statistics Levels
+// =============================================================================
+
+typedef enum {
+  RocksDBStatsLevelDisableAll = 0,
+  RocksDBStatsLevelExceptHistogramOrTimers = 1,
+  RocksDBStatsLevelExceptTimers = 2,
+  RocksDBStatsLevelExceptDetailedTimers = 3,
+  RocksDBStatsLevelExceptTimeForMutex = 4,
+  RocksDBStatsLevelAll = 5
+} RocksDBStatsLevelCode;
+
+typedef struct {
+  double median;
+  double percentile95;
+  double percentile99;
+  double average;
+  double standard_deviation;
+  double max;
+  double min;
+  uint64_t count;
+  uint64_t sum;
+} RocksDBHistogramValues;
+
+// =============================================================================
+// MARK: - Perf Levels
+// =============================================================================
+
+typedef enum {
+  RocksDBPerfLevelDisable = 1,
+  RocksDBPerfLevelEnableCount = 2,
+  RocksDBPerfLevelEnableWait = 3,
+  RocksDBPerfLevelEnableTimeExceptForMutex = 4,
+  RocksDBPerfLevelEnableTimeAndCPUTimeExceptForMutex = 5,
+  RocksDBPerfLevelEnableTime = 6
+} RocksDBPerfLevelCode;
+
+// Selected PerfContext and IOStatsContext counters; times in nanoseconds
+typedef struct {
+  uint64_t user_key_comparison_count;
+  uint64_t block_cache_hit_count;
+  uint64_t block_read_count;
+  uint64_t block_read_byte;
+  uint64_t block_read_time;
+  uint64_t block_checksum_time;
+  uint64_t block_decompress_time;
+  uint64_t index_block_read_count;
+  uint64_t filter_block_read_count;
+  uint64_t get_read_bytes;
+  uint64_t iter_read_bytes;
+  uint64_t internal_key_skipped_count;
+  uint64_t internal_delete_skipped_count;
+  uint64_t internal_merge_count;
+  uint64_t get_snapshot_time;
+  uint64_t get_from_memtable_time;
+  uint64_t get_from_memtable_count;
+  uint64_t get_post_process_time;
+  uint64_t get_from_output_files_time;
+  uint64_t seek_on_memtable_time;
+  uint64_t seek_child_seek_time;
+  uint64_t seek_internal_seek_time;
+  uint64_t find_next_user_entry_time;
+  uint64_t write_wal_time;
+  uint64_t write_memtable_time;
+  uint64_t write_delay_time;
+  uint64_t write_pre_and_post_process_time;
+  uint64_t write_thread_wait_nanos;
+  uint64_t db_mutex_lock_nanos;
+  uint64_t db_condition_wait_nanos;
+  uint64_t merge_operator_time_nanos;
+  uint64_t find_table_nanos;
+  uint64_t bloom_memtable_hit_count;
+  uint64_t bloom_memtable_miss_count;
+  uint64_t bloom_sst_hit_count;
+  uint64_t bloom_sst_miss_count;
+  uint64_t key_lock_wait_time;
+  uint64_t get_cpu_nanos;
+  // IOStatsContext
+  uint64_t io_bytes_read;
+  uint64_t io_bytes_written;
+  uint64_t io_open_nanos;
+  uint64_t io_read_nanos;
+  uint64_t io_write_nanos;
+  uint64_t io_fsync_nanos;
+  uint64_t io_range_sync_nanos;
+  uint64_t io_logger_nanos;
+} RocksDBPerfContextValues;
+
+// =============================================================================
+// MARK: - Event Types
+// =============================================================================
+
+typedef enum {
+  RocksDBEventFlushCompleted = 0,
+  RocksDBEventCompactionCompleted = 1,
+  RocksDBEventStallConditionsChanged = 2,
+  RocksDBEventBackgroundError = 3
+} RocksDBEventType;
+
+typedef enum {
+  RocksDBWriteStallNormal = 0,
+  RocksDBWriteStallDelayed = 1,
+  RocksDBWriteStallStopped = 2
+} RocksDBWriteStallConditionCode;
+
+typedef enum {
+  RocksDBWriteStallCauseNone = 0,
+  RocksDBWriteStallCauseMemtableLimit = 1,
+  RocksDBWriteStallCauseL0FileCount = 2,
+  RocksDBWriteStallCausePendingCompactionBytes = 3
+} RocksDBWriteStallCauseCode;
+
+// Inputs to a column family's write stall decision and the condition they
+// imply, evaluated with RocksDB's own thresholds
+typedef struct {
+  int condition;                      // RocksDBWriteStallConditionCode
+  int cause;                          // RocksDBWriteStallCauseCode
+  int is_write_stopped;               // rocksdb.is-write-stopped (database-wide)
+  uint64_t delayed_write_rate;        // rocksdb.actual-delayed-write-rate, bytes/s
+  uint64_t l0_files;
+  int l0_slowdown_trigger;
+  int l0_stop_trigger;
+  uint64_t immutable_memtables;
+  int max_write_buffer_number;
+  uint64_t pending_compaction_bytes;
+  uint64_t soft_pending_compaction_bytes_limit;
+  uint64_t hard_pending_compaction_bytes_limit;
+} RocksDBWriteStallValues;
+
+// Fixed-size record of one background event; fields not meaningful for the
+// event type are zero
+typedef struct {
+  int type;                       // RocksDBEventType
+  int job_id;
+  uint64_t timestamp_micros;      // Wall clock time the event was recorded
+  char column_family[64];         // NUL-terminated, truncated if longer
+  int input_level;                // Compaction base input level
+  int output_level;               // Compaction output level (0 for flushes)
+  uint64_t input_bytes;           // Compaction input bytes
+  uint64_t output_bytes;          // Bytes written by the flush or compaction
+  uint64_t input_files;
+  uint64_t output_files;
+  uint64_t duration_micros;       // Compaction run time
+  int reason;                     // Flush, compaction or background error reason
+  int status_code;                // RocksDBStatusCode of the job or error
+  int stall_previous;             // RocksDBWriteStallConditionCode
+  int stall_current;
+  int triggered_writes_slowdown;  // Flush completed while writes were slowed
+  int triggered_writes_stop;      // ... or stopped
+  char message[128];              // Background error message, truncated
+} RocksDBEventRecord;
+
+// =============================================================================
+// MARK: - Block Cache Tracing Types
+// =============================================================================
+
+// Block kinds in a block cache trace (RocksDB TraceType values)
+typedef enum {
+  RocksDBTraceBlockIndex = 7,
+  RocksDBTraceBlockFilter = 8,
+  RocksDBTraceBlockData = 9,
+  RocksDBTraceBlockUncompressionDict = 10,
+  RocksDBTraceBlockRangeDeletion = 11
+} RocksDBTraceBlockType;
+
+// Block cache trace file layout: ROCKSDB_BLOCK_CACHE_TRACE_MAGIC (8 bytes),
+// the record size as a little-endian uint32, 4 reserved bytes, then one
+// RocksDBBlockCacheAccessRecord per sampled access in host byte order
+#define ROCKSDB_BLOCK_CACHE_TRACE_MAGIC "RDBBCT\0\1"
+#define ROCKSDB_BLOCK_CACHE_TRACE_HEADER_SIZE 16
+
+typedef struct {
+  uint64_t timestamp_us;
+  uint64_t block_key_hash;   // 64-bit FNV-1a of the block's cache key
+  uint64_t block_size;
+  uint64_t get_id;           // shared by the accesses of one Get/MultiGet
+  uint32_t cf_id;
+  uint32_t level;
+  uint8_t block_type;        // RocksDBTraceBlockType
+  uint8_t caller;            // RocksDB TableReaderCaller
+  uint8_t is_cache_hit;
+  uint8_t no_insert;         // a miss does not insert the block
+  uint8_t reserved[4];
+} RocksDBBlockCacheAccessRecord;
+
+// =============================================================================
+// MARK: - Query Tracing Types
+// =============================================================================
+
+// Operations left out of a query trace (RocksDB TraceFilterType bits)
+typedef enum {
+  RocksDBTraceFilterNone = 0,
+  RocksDBTraceFilterGet = 1 << 0,
+  RocksDBTraceFilterWrite = 1 << 1,
+  RocksDBTraceFilterIteratorSeek = 1 << 2,
+  RocksDBTraceFilterIteratorSeekForPrev = 1 << 3,
+  RocksDBTraceFilterMultiGet = 1 << 4
+} RocksDBQueryTraceFilter;
+
+// Replayed operations of one kind; latencies in microseconds
+typedef struct {
+  uint64_t count;
+  uint64_t errors;  // failed executions, not counting NotFound lookups
+  uint64_t total_us;
+  uint64_t p50_us;
+  uint64_t p95_us;
+  uint64_t p99_us;
+  uint64_t max_us;
+} RocksDBReplayLatencyValues;
+
+typedef struct {
+  uint64_t elapsed_us;
+  uint64_t failed_records;  // records that could not be executed at all
+  RocksDBReplayLatencyValues get;
+  RocksDBReplayLatencyValues multi_get;
+  RocksDBReplayLatencyValues write;
+  RocksDBReplayLatencyValues iterator_seek;  // Seek and SeekForPrev
+} RocksDBReplayValues;
+
+// =============================================================================
+// MARK: - Call Tracing Types
+// =============================================================================
+
+// Bridge entry points with call tracing
+typedef enum {
+  RocksDBTraceOpGet = 0,
+  RocksDBTraceOpPut = 1,
+  RocksDBTraceOpDelete = 2,
+  RocksDBTraceOpMerge = 3,
+  RocksDBTraceOpMultiGet = 4,
+  RocksDBTraceOpWriteBatch = 5,
+  RocksDBTraceOpIteratorNextBatch = 6,
+  RocksDBTraceOpCount = 7
+} RocksDBTraceOp;
+
+// Where a traced duration was measured. Swift spans the whole wrapper call,
+// bridge the C function, engine only the RocksDB call inside it.
+typedef enum {
+  RocksDBTraceLayerSwift = 0,
+  RocksDBTraceLayerBridge = 1,
+  RocksDBTraceLayerEngine = 2,
+  RocksDBTraceLayerCount = 3
+} RocksDBTraceLayer;
+
+// Latency buckets per histogram: bucket i counts calls that took
+// [2^i, 2^(i+1)) nanoseconds, bucket 0 includes 0 and the last bucket
+// everything slower
+#define ROCKSDB_TRACE_BUCKETS 32
+
+// =============================================================================
+// MARK: - Thread Status Types
+// =============================================================================
+
+// One thread known to the default Env, with its current operation.
+// Progress fields apply to flushes and compactions and are 0 otherwise.
+typedef struct {
+  uint64_t thread_id;
+  int thread_type;           // ThreadStatus::ThreadType: high, low, user, bottom
+  int operation_type;        // ThreadStatus::OperationType
+  int operation_stage;       // ThreadStatus::OperationStage
+  int state_type;            // ThreadStatus::StateType
+  uint64_t elapsed_micros;
+  char db_name[256];
+  char cf_name[128];
+  uint64_t job_id;
+  int input_level;           // compaction only, -1 otherwise
+  int output_level;          // compaction only, -1 otherwise
+  int is_manual;             // compaction only
+  uint64_t total_input_bytes;  // compaction input, or memtable bytes of a flush
+  uint64_t bytes_read;
+  uint64_t bytes_written;
+} RocksDBThreadStatusValues;
+
+// =============================================================================
+// MARK: - Open Timing Types
+// =============================================================================
+
+// Wall time of the phases of DB::Open, derived from the order files are
+// first opened in, so phases are approximate
+typedef struct {
+  uint64_t total_nanos;
+  // Reading the MANIFEST up to the first table file opened
+  uint64_t manifest_recovery_nanos;
+  // First to last table file opened while loading table handlers
+  uint64_t table_opening_nanos;
+  // From the first WAL file opened to the end, including the recovery flush
+  uint64_t wal_replay_nanos;
+  uint64_t tables_opened;
+  uint64_t wal_files_replayed;
+} RocksDBOpenTimingValues;
+
+// =============================================================================
+// MARK: - Change Data Capture Types
+// =============================================================================
+
+typedef enum {
+  RocksDBWalRecordPut = 0,
+  RocksDBWalRecordDelete = 1,
+  RocksDBWalRecordSingleDelete = 2,
+  // key is the range start, value the exclusive end
+  RocksDBWalRecordDeleteRange = 3,
+  RocksDBWalRecordMerge = 4,
+  // value is the serialized wide-column entity
+  RocksDBWalRecordPutEntity = 5,
+  // value is the blob; column family and key are empty
+  RocksDBWalRecordLogData = 6,
+  // value is a BlobDB blob index, not the value itself
+  RocksDBWalRecordPutBlobIndex = 7
+} RocksDBWalRecordType;
+
+// =============================================================================
+// MARK: - Backup Types
+// =============================================================================
+
+typedef struct {
+  uint32_t backup_id;
+  // Creation time in seconds since the epoch
+  int64_t timestamp;
+  // Bytes of file payloads, counting files shared with other backups
+  uint64_t size;
+  uint32_t number_files;
+} RocksDBBackupInfoValues;
+
+typedef struct {
+  // Deduplicate SST and blob files across backups (incremental backups)
+  int share_table_files;
+  // Name shared files by checksum and session id, so files of different
+  // databases or of a restored database are never confused
+  int share_files_with_checksum;
+  int sync;
+  // Delete existing backups in the directory on open
+  int destroy_old_data;
+  // Back up WAL files; off when the database is flushed before each backup
+  int backup_log_files;
+  // Bytes per second, 0 for unlimited
+  uint64_t backup_rate_limit;
+  uint64_t restore_rate_limit;
+  // Threads copying files during backup and restore
+  int max_background_operations;
+} RocksDBBackupEngineValues;
+
+// =============================================================================
+// MARK: - Memory Usage Types
+// =============================================================================
+
+typedef struct {
+  // All memtables, including flushed ones still pinned by readers
+  uint64_t memtable_total;
+  // Active and immutable memtables not flushed yet
+  uint64_t memtable_unflushed;
+  // Index and filter blocks held by table readers outside the block cache
+  uint64_t table_readers;
+  // Usage of every distinct cache, each counted once
+  uint64_t cache_total;
+  // Part of cache_total pinned by readers and unevictable
+  uint64_t cache_pinned;
+  uint64_t cache_capacity;
+} RocksDBMemoryUsageValues;
+
+// =============================================================================
+// MARK: - Aggregation Types
+// =============================================================================
+
+typedef enum {
+  RocksDBByteOrderLittleEndian = 0,
+  RocksDBByteOrderBigEndian = 1
+} RocksDBByteOrder;
+
+// Integer field at a fixed offset of every value
+typedef struct {
+  size_t offset;
+  // 1, 2, 4 or 8 bytes
+  size_t width;
+  RocksDBByteOrder byte_order;
+  int is_signed;
+} RocksDBAggregateFieldSpec;
+
+typedef struct {
+  uint64_t count;
+  uint64_t key_bytes;
+  uint64_t value_bytes;
+  // Entries whose value is long enough to hold the field
+  uint64_t field_count;
+  // Sum, minimum and maximum of the field as 64-bit patterns (int64 for
+  // signed fields); the sum wraps on overflow, min and max are 0 when
+  // field_count is 0
+  uint64_t sum;
+  uint64_t min;
+  uint64_t max;
+} RocksDBAggregateValues;
+
+// =============================================================================
+// MARK: - Scan Predicate Types
+// =============================================================================
+
+typedef enum {
+  RocksDBPredicateAnd = 0,
+  RocksDBPredicateOr = 1,
+  RocksDBPredicateNot = 2,
+  // Compare a window of the key or value with one operand
+  RocksDBPredicateBytes = 3,
+  // Compare an integer field of the key or value with a constant
+  RocksDBPredicateInteger = 4,
+  // Window of the key or value equals one of the operands
+  RocksDBPredicateBytesIn = 5
+} RocksDBPredicateKind;
+
+typedef enum {
+  RocksDBCompareEqual = 0,
+  RocksDBCompareNotEqual = 1,
+  RocksDBCompareLess = 2,
+  RocksDBCompareLessOrEqual = 3,
+  RocksDBCompareGreater = 4,
+  RocksDBCompareGreaterOrEqual = 5
+} RocksDBCompareOp;
+
+// One node of a predicate tree, stored in pre-order: an And, Or or Not node
+// is followed by its child_count subtrees (exactly one for Not). Byte
+// windows start `offset` bytes into the target, or end `offset` bytes
+// before its end with from_end, and are as long as the operand. Entries too
+// short for a window or field never match that node.
+typedef struct {
+  RocksDBPredicateKind kind;
+  size_t child_count;
+  // Test the value instead of the key
+  int on_value;
+  size_t offset;
+  int from_end;
+  RocksDBCompareOp op;
+  // Integer nodes: field to decode (its offset is used) and the constant,
+  // as a 64-bit pattern
+  RocksDBAggregateFieldSpec field;
+  uint64_t integer;
+  // Bytes nodes take one operand, BytesIn nodes any number
+  const char* const* operands;
+  const size_t* operand_lens;
+  size_t num_operands;
+} RocksDBPredicateNode;
+
+// =============================================================================
+// MARK: - Thread Pool Priorities
+// =============================================================================
+
+// Env background pools: flushes run in HIGH, compactions in LOW and, when
+// the BOTTOM pool has threads, bottommost-level compactions in BOTTOM
+typedef enum {
+  RocksDBThreadPoolBottom = 0,
+  RocksDBThreadPoolLow = 1,
+  RocksDBThreadPoolHigh = 2
+} RocksDBThreadPoolCode;
+
+typedef enum {
+  RocksDBCpuPriorityIdle = 0,
+  RocksDBCpuPriorityLow = 1,
+  RocksDBCpuPriorityNormal = 2,
+  RocksDBCpuPriorityHigh = 3
+} RocksDBCpuPriority;
+
 // =============================================================================
 // MARK: - Memory Management
 // =============================================================================
@@ -86,29 +679,427 @@ RocksDBOptionsRef rocksdb_options_create(void);
 void rocksdb_options_destroy(RocksDBOptionsRef opts);
 void rocksdb_options_set_create_if_missing(RocksDBOptionsRef opts, int value);
 void rocksdb_options_set_error_if_exists(RocksDBOptionsRef opts, int value);
+void rocksdb_options_set_create_missing_column_families(RocksDBOptionsRef opts, int value);
 void rocksdb_options_set_paranoid_checks(RocksDBOptionsRef opts, int value);
 void rocksdb_options_set_compression(RocksDBOptionsRef opts, int type);
+// Compression type of each level, overriding compression (count 0 clears)
+void rocksdb_options_set_compression_per_level(RocksDBOptionsRef opts, const int* types, size_t count);
+// Compression of the bottommost level, overriding the above (-1: same as its level)
+void rocksdb_options_set_bottommost_compression(RocksDBOptionsRef opts, int type);
+// CompressionOptions for compression (bottommost 0) or bottommost_compression
+// (bottommost 1, which also enables them). level is RocksDB's generic default
+// at 32767; a nonzero max_dict_bytes turns on dictionary compression, trained
+// with zstd from up to zstd_max_train_bytes of samples when that is nonzero.
+void rocksdb_options_set_compression_options(RocksDBOptionsRef opts, int bottommost, int level,
+                                             uint32_t max_dict_bytes, uint32_t zstd_max_train_bytes,
+                                             uint32_t parallel_threads, uint64_t max_dict_buffer_bytes,
+                                             int use_zstd_dict_trainer);
 void rocksdb_options_set_write_buffer_size(RocksDBOptionsRef opts, size_t size);
 void rocksdb_options_set_max_write_buffer_number(RocksDBOptionsRef opts, int value);
 void rocksdb_options_set_max_open_files(RocksDBOptionsRef opts, int value);
 void rocksdb_options_set_max_background_compactions(RocksDBOptionsRef opts, int value);
 void rocksdb_options_set_max_background_flushes(RocksDBOptionsRef opts, int value);
+// Combined flush and compaction job limit; only applies while
+// max_background_compactions and max_background_flushes are -1
+void rocksdb_options_set_max_background_jobs(RocksDBOptionsRef opts, int value);
+// Threads a single compaction job may split into (default: 1)
+void rocksdb_options_set_max_subcompactions(RocksDBOptionsRef opts, uint32_t value);
 void rocksdb_options_set_level0_file_num_compaction_trigger(RocksDBOptionsRef opts, int value);
 void rocksdb_options_set_level0_slowdown_writes_trigger(RocksDBOptionsRef opts, int value);
 void rocksdb_options_set_level0_stop_writes_trigger(RocksDBOptionsRef opts, int value);
 void rocksdb_options_set_target_file_size_base(RocksDBOptionsRef opts, uint64_t size);
 void rocksdb_options_set_max_bytes_for_level_base(RocksDBOptionsRef opts, uint64_t size);
+// Compaction style (RocksDBCompactionStyleType) and its tuning; only the
+// options of the chosen style are used
+void rocksdb_options_set_compaction_style(RocksDBOptionsRef opts, int style);
+// stop_style 0 compares each candidate with the next file's size, 1 with
+// the total size picked so far
+void rocksdb_options_set_universal_compaction_options(RocksDBOptionsRef opts, uint32_t size_ratio,
+                                                      uint32_t min_merge_width, uint32_t max_merge_width,
+                                                      uint32_t max_size_amplification_percent,
+                                                      int compression_size_percent, int stop_style,
+                                                      int allow_trivial_move);
+void rocksdb_options_set_fifo_compaction_options(RocksDBOptionsRef opts, uint64_t max_table_files_size,
+                                                 int allow_compaction);
+// Size levels from the last one up so the LSM keeps its shape as data grows
+void rocksdb_options_set_level_compaction_dynamic_level_bytes(RocksDBOptionsRef opts, int value);
+void rocksdb_options_set_max_bytes_for_level_multiplier(RocksDBOptionsRef opts, double multiplier);
+// File picking order within a level (rocksdb::CompactionPri value)
+void rocksdb_options_set_compaction_pri(RocksDBOptionsRef opts, int pri);
+// Recompact files older than this many seconds; 0 disables
+void rocksdb_options_set_periodic_compaction_seconds(RocksDBOptionsRef opts, uint64_t seconds);
+// Files with data older than this many seconds are compacted (leveled and
+// universal) or dropped (FIFO); 0 disables
+void rocksdb_options_set_ttl(RocksDBOptionsRef opts, uint64_t seconds);
+// Mark SST files for compaction as they are written when any window of
+// window_size consecutive entries holds at least deletion_trigger
+// tombstones, or when deletion_ratio (0 disables) of all entries are
+// tombstones. window_size 0 removes the collector; other table properties
+// collectors on opts are kept.
+void rocksdb_options_set_compact_on_deletion(RocksDBOptionsRef opts, size_t window_size,
+                                             size_t deletion_trigger, double deletion_ratio);
+// Cut compaction output files where the first prefix_len bytes of the key
+// change, so no file spans two prefixes; 0 removes the partitioner
+void rocksdb_options_set_sst_partitioner_fixed_prefix(RocksDBOptionsRef opts, size_t prefix_len);
+// Directories SST files are placed in, filled in order up to each target
+// size so upper levels land in the first paths and the bottom levels in the
+// last one; count 0 keeps everything in the database directory. cf_paths
+// overrides db_paths for a column family.
+void rocksdb_options_set_db_paths(RocksDBOptionsRef opts, const char* const* paths,
+                                  const uint64_t* target_sizes, size_t count);
+void rocksdb_options_set_cf_paths(RocksDBOptionsRef opts, const char* const* paths,
+                                  const uint64_t* target_sizes, size_t count);
+// Temperature (rocksdb::Temperature value) passed to the FileSystem for
+// last-level files; universal compaction only
+void rocksdb_options_set_last_level_temperature(RocksDBOptionsRef opts, int temperature);
+// Keep data written within this many seconds out of the last level; 0 disables
+void rocksdb_options_set_preclude_last_level_data_seconds(RocksDBOptionsRef opts, uint64_t seconds);
+// Memtable bloom filter sized as a fraction of write_buffer_size (0 disables,
+// capped at 0.25). It holds key prefixes, plus whole keys with
+// memtable_whole_key_filtering, which also works without a prefix extractor.
+void rocksdb_options_set_memtable_prefix_bloom_size_ratio(RocksDBOptionsRef opts, double ratio);
+void rocksdb_options_set_memtable_whole_key_filtering(RocksDBOptionsRef opts, int value);
+// Allocate memtable arenas from huge pages of this size (0: off); falls back
+// to normal pages when none are reserved
+void rocksdb_options_set_memtable_huge_page_size(RocksDBOptionsRef opts, size_t size);
+// Integrated BlobDB: values of at least min_blob_size bytes go to blob files
+// and are not rewritten by compaction (column family options)
+void rocksdb_options_set_enable_blob_files(RocksDBOptionsRef opts, int value);
+void rocksdb_options_set_min_blob_size(RocksDBOptionsRef opts, uint64_t size);
+void rocksdb_options_set_blob_file_size(RocksDBOptionsRef opts, uint64_t size);
+void rocksdb_options_set_blob_compression(RocksDBOptionsRef opts, int type);
+void rocksdb_options_set_enable_blob_garbage_collection(RocksDBOptionsRef opts, int value);
+// Fraction (0...1) of the oldest blob files whose live values are relocated
+void rocksdb_options_set_blob_garbage_collection_age_cutoff(RocksDBOptionsRef opts,
+                                                            double cutoff);
+// Cache for uncompressed blob values; may be the block cache (NULL: none)
+void rocksdb_options_set_blob_cache(RocksDBOptionsRef opts, RocksDBCacheRef cache);
+// Cache of whole rows found by Get in SST files, shareable between
+// databases (NULL: none). DeleteRange fails with NotSupported while it is set.
+void rocksdb_options_set_row_cache(RocksDBOptionsRef opts, RocksDBCacheRef cache);
+// WAL tuning. With manual_wal_flush, writes stay in the WAL buffer until
+// rocksdb_flush_wal; only kNoCompression and kZSTD are valid wal_compression types.
+void rocksdb_options_set_manual_wal_flush(RocksDBOptionsRef opts, int value);
+void rocksdb_options_set_wal_bytes_per_sync(RocksDBOptionsRef opts, uint64_t bytes);
+void rocksdb_options_set_bytes_per_sync(RocksDBOptionsRef opts, uint64_t bytes);
+// Bypass the OS page cache (O_DIRECT, F_NOCACHE on macOS) for user reads
+// and for flush and compaction I/O; open fails if the filesystem refuses it
+void rocksdb_options_set_use_direct_reads(RocksDBOptionsRef opts, int value);
+void rocksdb_options_set_use_direct_io_for_flush_and_compaction(RocksDBOptionsRef opts, int value);
+// Readahead for compaction inputs; matters most with direct I/O, where the
+// OS does no readahead of its own
+void rocksdb_options_set_compaction_readahead_size(RocksDBOptionsRef opts, size_t size);
+// Read SST files through mmap; pinned gets then point into the mapping
+void rocksdb_options_set_allow_mmap_reads(RocksDBOptionsRef opts, int value);
+void rocksdb_options_set_allow_mmap_writes(RocksDBOptionsRef opts, int value);
+// Probe whether files in an existing directory can be opened for direct
+// reads; OK if supported, NotSupported or IOError otherwise
+RocksDBStatus rocksdb_probe_direct_io(const char* dir);
+void rocksdb_options_set_wal_compression(RocksDBOptionsRef opts, int type);
+void rocksdb_options_set_recycle_log_file_num(RocksDBOptionsRef opts, size_t num);
+void rocksdb_options_set_max_total_wal_size(RocksDBOptionsRef opts, uint64_t size);
+// Values of rocksdb::WALRecoveryMode: 0 tolerate corrupted tail records,
+// 1 absolute consistency, 2 point in time (default), 3 skip any corrupted records
+void rocksdb_options_set_wal_recovery_mode(RocksDBOptionsRef opts, int mode);
+// Filter applied to WAL records replayed at open: records whose keys all
+// start with one of skip_prefixes are not replayed, and replay stops at the
+// first record past stop_after_sequence (UINT64_MAX for no limit; 0 replays
+// nothing); everything after it is discarded. Pass no prefixes and
+// UINT64_MAX to remove the filter.
+void rocksdb_options_set_wal_filter(RocksDBOptionsRef opts,
+                                    size_t num_prefixes,
+                                    const char* const* skip_prefixes,
+                                    const size_t* skip_prefix_lens,
+                                    uint64_t stop_after_sequence);
+// Keep obsolete WALs archived for this long or up to this size, so
+// rocksdb_get_updates_since can still read them (0 deletes them at once)
+void rocksdb_options_set_wal_ttl_seconds(RocksDBOptionsRef opts, uint64_t seconds);
+void rocksdb_options_set_wal_size_limit_mb(RocksDBOptionsRef opts, uint64_t megabytes);
+// Write path concurrency (unordered_write is incompatible with pipelined writes)
+void rocksdb_options_set_allow_concurrent_memtable_write(RocksDBOptionsRef opts, int value);
+void rocksdb_options_set_enable_pipelined_write(RocksDBOptionsRef opts, int value);
+void rocksdb_options_set_unordered_write(RocksDBOptionsRef opts, int value);
+void rocksdb_options_set_enable_write_thread_adaptive_yield(RocksDBOptionsRef opts, int value);
+void rocksdb_options_set_two_write_queues(RocksDBOptionsRef opts, int value);
+// Required for RocksDBIngestOptions ingest_behind
+void rocksdb_options_set_allow_ingest_behind(RocksDBOptionsRef opts, int value);
+// Open-time work: threads opening table files when max_open_files is -1,
+// per-file stats loading, the SST size check, the flush after WAL replay,
+// and recovering to the newest consistent state when files are missing
+void rocksdb_options_set_max_file_opening_threads(RocksDBOptionsRef opts, int threads);
+void rocksdb_options_set_skip_stats_update_on_db_open(RocksDBOptionsRef opts, int value);
+void rocksdb_options_set_skip_checking_sst_file_sizes_on_db_open(RocksDBOptionsRef opts, int value);
+void rocksdb_options_set_avoid_flush_during_recovery(RocksDBOptionsRef opts, int value);
+void rocksdb_options_set_best_efforts_recovery(RocksDBOptionsRef opts, int value);
+// Share one memtable memory budget across databases (NULL detaches)
+void rocksdb_options_set_write_buffer_manager(RocksDBOptionsRef opts,
+                                              RocksDBWriteBufferManagerRef manager);
+// Throttle background I/O (flush/compaction) through a shared limiter (NULL detaches)
+void rocksdb_options_set_rate_limiter(RocksDBOptionsRef opts, RocksDBRateLimiterRef limiter);
+void rocksdb_options_set_sst_file_manager(RocksDBOptionsRef opts, RocksDBSstFileManagerRef manager);
+// Install the built-in compaction filter rules (column family option, NULL removes)
+void rocksdb_options_set_compaction_filter(RocksDBOptionsRef opts,
+                                          RocksDBCompactionFilterRef filter);
 void rocksdb_options_enable_statistics(RocksDBOptionsRef opts);
+// RocksDBStatsLevelCode; applies once statistics are enabled
+void rocksdb_options_set_statistics_level(RocksDBOptionsRef opts, int level);
+// Report operation, stage and progress of background jobs to GetThreadList
+void rocksdb_options_set_enable_thread_tracking(RocksDBOptionsRef opts, int value);
 void rocksdb_options_optimize_for_point_lookup(RocksDBOptionsRef opts, uint64_t block_cache_size_mb);
 void rocksdb_options_optimize_level_style_compaction(RocksDBOptionsRef opts, uint64_t memtable_memory_budget);
+// Prefix SliceTransform used for prefix bloom filters and prefix seeks (type is RocksDBPrefixExtractorType)
+void rocksdb_options_set_prefix_extractor(RocksDBOptionsRef opts, int type, size_t length);
+// Memtable representation (type is RocksDBMemtableRepType). size is the
+// skiplist lookahead, the vector's initial capacity or the hash bucket
+// count; height and branching apply to hash skiplists. Every type but the
+// skiplist needs exclusive memtable writes, so this turns off
+// allow_concurrent_memtable_write for them; hash types need a prefix extractor.
+void rocksdb_options_set_memtable_rep(RocksDBOptionsRef opts, int type, size_t size,
+                                      int32_t height, int32_t branching);
+// Built-in merge operator (type is RocksDBMergeOperatorType); delimiter is used by string append
+// Key ordering (type is RocksDBComparatorType); must match on every open
+void rocksdb_options_set_comparator(RocksDBOptionsRef opts, int type);
+void rocksdb_options_set_merge_operator(RocksDBOptionsRef opts, int type,
+                                        const char* delimiter, size_t delimiter_len);
+// Installs a BlockBasedTableFactory built from a copy of table_opts
+void rocksdb_options_set_block_based_table_factory(RocksDBOptionsRef opts,
+                                                   RocksDBTableOptionsRef table_opts);
+// Installs a PlainTableFactory (user_key_len 0 for variable-length keys,
+// encoding 0 plain or 1 prefix). PlainTable files are read through mmap, so
+// this also turns on allow_mmap_reads.
+void rocksdb_options_set_plain_table_factory(RocksDBOptionsRef opts, uint32_t user_key_len,
+                                             int bloom_bits_per_key, double hash_table_ratio,
+                                             size_t index_sparseness, size_t huge_page_tlb_size,
+                                             int encoding, int full_scan_mode, int store_index_in_file);
+// Installs a CuckooTableFactory; also turns on allow_mmap_reads
+void rocksdb_options_set_cuckoo_table_factory(RocksDBOptionsRef opts, double hash_table_ratio,
+                                              uint32_t max_search_depth, uint32_t cuckoo_block_size,
+                                              int identity_as_first_hash, int use_module_hash);
+
+// Block-Based Table Options
+RocksDBTableOptionsRef rocksdb_table_options_create(void);
+void rocksdb_table_options_destroy(RocksDBTableOptionsRef opts);
+// Shares the cache with every table factory (and database) built from these options
+void rocksdb_table_options_set_block_cache(RocksDBTableOptionsRef opts, RocksDBCacheRef cache);
+// bits_per_key <= 0 disables the filter
+void rocksdb_table_options_set_bloom_filter(RocksDBTableOptionsRef opts, double bits_per_key);
+void rocksdb_table_options_set_ribbon_filter(RocksDBTableOptionsRef opts, double bits_per_key);
+// When disabled (with a prefix extractor), filters hold prefixes only
+void rocksdb_table_options_set_whole_key_filtering(RocksDBTableOptionsRef opts, int value);
+void rocksdb_table_options_set_block_size(RocksDBTableOptionsRef opts, uint64_t size);
+// Read blocks without caching them; for mmap reads, where blocks already live in memory
+void rocksdb_table_options_set_no_block_cache(RocksDBTableOptionsRef opts, int value);
+void rocksdb_table_options_set_metadata_block_size(RocksDBTableOptionsRef opts, uint64_t size);
+void rocksdb_table_options_set_cache_index_and_filter_blocks(RocksDBTableOptionsRef opts, int value);
+// Prefix-compress keys against the previous key in data blocks (default on)
+void rocksdb_table_options_set_use_delta_encoding(RocksDBTableOptionsRef opts, int value);
+void rocksdb_table_options_set_pin_l0_filter_and_index_blocks_in_cache(RocksDBTableOptionsRef opts, int value);
+void rocksdb_table_options_set_pin_top_level_index_and_filter(RocksDBTableOptionsRef opts, int value);
+void rocksdb_table_options_set_index_type(RocksDBTableOptionsRef opts, int type);
+// Partitioned filters require RocksDBIndexTwoLevelIndexSearch
+void rocksdb_table_options_set_partition_filters(RocksDBTableOptionsRef opts, int value);
+void rocksdb_table_options_set_format_version(RocksDBTableOptionsRef opts, int version);
+void rocksdb_table_options_set_data_block_hash_index(RocksDBTableOptionsRef opts, int enabled,
+                                                     double util_ratio);
+// Iterator auto-readahead: after num_file_reads sequential reads of a file,
+// prefetch initial_size bytes, doubling per read up to max_size (defaults:
+// 2 reads, 8KB, 256KB; max_size 0 disables auto-readahead)
+void rocksdb_table_options_set_auto_readahead(RocksDBTableOptionsRef opts,
+                                              uint64_t num_file_reads,
+                                              size_t initial_size, size_t max_size);
+
+// Block Cache
+// A cache handle holds one reference to the shared cache; databases using it keep
+// their own references, so the handle may be destroyed while they are open.
+// num_shard_bits < 0 picks a default based on capacity.
+RocksDBCacheRef rocksdb_cache_create_lru(size_t capacity, int num_shard_bits,
+                                         int strict_capacity_limit,
+                                         double high_pri_pool_ratio);
+// estimated_entry_charge == 0 selects the auto-sizing HyperClockCache variant
+RocksDBCacheRef rocksdb_cache_create_hyper_clock(size_t capacity, size_t estimated_entry_charge,
+                                                 int num_shard_bits,
+                                                 int strict_capacity_limit);
+// LRU cache with a compressed secondary cache of secondary_capacity bytes
+// attached; blocks evicted from the LRU are compressed into the secondary,
+// and rocksdb_cache_load_dump can warm it
+RocksDBCacheRef rocksdb_cache_create_lru_with_secondary(size_t capacity, int num_shard_bits,
+                                                        int strict_capacity_limit,
+                                                        double high_pri_pool_ratio,
+                                                        size_t secondary_capacity,
+                                                        int compression_type);
+// Primary uncompressed cache (primary_type 0 LRU, 1 HyperClockCache) backed by
+// a compressed in-memory secondary tier, splitting total_capacity between
+// them by compressed_secondary_ratio. adm_policy is a
+// rocksdb::TieredAdmissionPolicy value. NULL on invalid options.
+RocksDBCacheRef rocksdb_cache_create_tiered(size_t total_capacity, double compressed_secondary_ratio,
+                                           int primary_type, size_t estimated_entry_charge,
+                                           int num_shard_bits, double high_pri_pool_ratio,
+                                           int adm_policy, int compression_type);
+// Resize or rebalance a tiered cache; negative values keep the current setting
+RocksDBStatus rocksdb_cache_update_tiered(RocksDBCacheRef cache, int64_t total_capacity,
+                                          double compressed_secondary_ratio, int adm_policy);
+void rocksdb_cache_destroy(RocksDBCacheRef cache);
+// Write the blocks of db held in its block cache to file, stopping after
+// max_size_bytes (0 for no limit); load them after a restart with
+// rocksdb_cache_load_dump
+RocksDBStatus rocksdb_dump_block_cache(RocksDBRef db, const char* file, uint64_t max_size_bytes);
+// Load blocks written by rocksdb_dump_block_cache into the cache's secondary
+// cache, from where the first read of each block promotes it; NotSupported
+// for caches created without a secondary
+RocksDBStatus rocksdb_cache_load_dump(RocksDBCacheRef cache, const char* file);
+size_t rocksdb_cache_get_capacity(RocksDBCacheRef cache);
+void rocksdb_cache_set_capacity(RocksDBCacheRef cache, size_t capacity);
+size_t rocksdb_cache_get_usage(RocksDBCacheRef cache);
+size_t rocksdb_cache_get_pinned_usage(RocksDBCacheRef cache);
+
+// Write Buffer Manager
+// Caps total memtable memory of every database it is attached to. With a cache,
+// memtable memory is charged to that cache (via dummy entries) so block cache and
+// memtables share one budget. allow_stall blocks writers once the cap is reached.
+// Like caches, databases keep their own reference to the manager.
+RocksDBWriteBufferManagerRef rocksdb_write_buffer_manager_create(size_t buffer_size,
+                                                                 RocksDBCacheRef cache,
+                                                                 int allow_stall);
+void rocksdb_write_buffer_manager_destroy(RocksDBWriteBufferManagerRef manager);
+size_t rocksdb_write_buffer_manager_get_buffer_size(RocksDBWriteBufferManagerRef manager);
+void rocksdb_write_buffer_manager_set_buffer_size(RocksDBWriteBufferManagerRef manager,
+                                                  size_t buffer_size);
+void rocksdb_write_buffer_manager_set_allow_stall(RocksDBWriteBufferManagerRef manager,
+                                                  int allow_stall);
+size_t rocksdb_write_buffer_manager_get_memory_usage(RocksDBWriteBufferManagerRef manager);
+size_t rocksdb_write_buffer_manager_get_mutable_memtable_memory_usage(
+    RocksDBWriteBufferManagerRef manager);
+size_t rocksdb_write_buffer_manager_get_dummy_entries_in_cache_usage(
+    RocksDBWriteBufferManagerRef manager);
+
+// Rate Limiter
+// Generic token-bucket limiter (mode is RocksDBRateLimiterModeCode). With auto_tuned
+// the effective rate adapts between rate/20 and rate based on demand. Like caches,
+// databases keep their own reference to the limiter.
+RocksDBRateLimiterRef rocksdb_rate_limiter_create(int64_t rate_bytes_per_sec,
+                                                  int64_t refill_period_us,
+                                                  int32_t fairness, int mode,
+                                                  int auto_tuned);
+void rocksdb_rate_limiter_destroy(RocksDBRateLimiterRef limiter);
+// Ignored unless bytes_per_second > 0
+void rocksdb_rate_limiter_set_bytes_per_second(RocksDBRateLimiterRef limiter,
+                                               int64_t bytes_per_second);
+int64_t rocksdb_rate_limiter_get_bytes_per_second(RocksDBRateLimiterRef limiter);
+int64_t rocksdb_rate_limiter_get_total_bytes_through(RocksDBRateLimiterRef limiter);
+int64_t rocksdb_rate_limiter_get_total_requests(RocksDBRateLimiterRef limiter);
+
+// SST File Manager
+// Tracks the SST and blob files of every database it is installed in. With a
+// positive delete rate, obsolete files are renamed to trash and deleted in
+// chunks at that rate; with a space cap, flushes and compactions that would
+// exceed it fail with a space-limit error and the database turns read-only
+// instead of filling the disk. Returns NULL on failure.
+RocksDBSstFileManagerRef rocksdb_sst_file_manager_create(int64_t delete_rate_bytes_per_sec,
+                                                         double max_trash_db_ratio,
+                                                         uint64_t bytes_max_delete_chunk);
+void rocksdb_sst_file_manager_destroy(RocksDBSstFileManagerRef manager);
+// 0 disables rate limiting; files are then deleted immediately
+void rocksdb_sst_file_manager_set_delete_rate_bytes_per_second(RocksDBSstFileManagerRef manager,
+                                                               int64_t delete_rate);
+int64_t rocksdb_sst_file_manager_get_delete_rate_bytes_per_second(RocksDBSstFileManagerRef manager);
+// 0 removes the cap
+void rocksdb_sst_file_manager_set_max_allowed_space_usage(RocksDBSstFileManagerRef manager,
+                                                          uint64_t max_allowed_space);
+// Space kept free for compaction output when checking the cap
+void rocksdb_sst_file_manager_set_compaction_buffer_size(RocksDBSstFileManagerRef manager,
+                                                         uint64_t compaction_buffer_size);
+int rocksdb_sst_file_manager_is_max_allowed_space_reached(RocksDBSstFileManagerRef manager);
+int rocksdb_sst_file_manager_is_max_allowed_space_reached_including_compactions(
+    RocksDBSstFileManagerRef manager);
+uint64_t rocksdb_sst_file_manager_get_total_size(RocksDBSstFileManagerRef manager);
+uint64_t rocksdb_sst_file_manager_get_total_trash_size(RocksDBSstFileManagerRef manager);
+
+// Compaction Filter
+// Declarative rules evaluated in C++ during compaction. Rules can be changed
+// at any time and apply to compactions started afterwards; every database
+// the filter is installed in shares the same rules.
+RocksDBCompactionFilterRef rocksdb_compaction_filter_create(void);
+void rocksdb_compaction_filter_destroy(RocksDBCompactionFilterRef filter);
+// Drop keys (and merge operands) starting with any of the prefixes; replaces the set
+void rocksdb_compaction_filter_set_dropped_prefixes(RocksDBCompactionFilterRef filter,
+                                                    size_t num_prefixes,
+                                                    const char* const* prefixes,
+                                                    const size_t* prefix_lens);
+// Drop values whose unsigned width-byte field at offset is below threshold;
+// width 0 disables, shorter values are kept
+void rocksdb_compaction_filter_set_header_threshold(RocksDBCompactionFilterRef filter,
+                                                    size_t offset, size_t width,
+                                                    int big_endian, uint64_t threshold);
+// Keep the first max_versions keys of each prefix_len-byte key prefix, in key
+// order (encode versions newest-first); max_versions 0 disables. Versions are
+// counted per compaction, so older versions in files outside it survive.
+void rocksdb_compaction_filter_set_max_versions(RocksDBCompactionFilterRef filter,
+                                                size_t prefix_len, size_t max_versions);
+uint64_t rocksdb_compaction_filter_get_dropped_count(RocksDBCompactionFilterRef filter);
 
 // Read Options
+// Read and write option handles are referenced (not copied) by every call that
+// takes them and must not be modified while in use; passing NULL selects the
+// RocksDB defaults without any allocation.
 RocksDBReadOptionsRef rocksdb_read_options_create(void);
 void rocksdb_read_options_destroy(RocksDBReadOptionsRef opts);
 void rocksdb_read_options_set_verify_checksums(RocksDBReadOptionsRef opts, int value);
 void rocksdb_read_options_set_fill_cache(RocksDBReadOptionsRef opts, int value);
 void rocksdb_read_options_set_snapshot(RocksDBReadOptionsRef opts, RocksDBSnapshotRef snapshot);
 void rocksdb_read_options_set_prefix_same_as_start(RocksDBReadOptionsRef opts, int value);
+// Issue SST reads asynchronously (ReadAsync, io_uring on Linux): iterators
+// prefetch ahead, and MultiGet reads a batch's blocks concurrently in builds
+// with coroutine support (default: off)
+void rocksdb_read_options_set_async_io(RocksDBReadOptionsRef opts, int value);
+// With async_io, let MultiGet read all levels in parallel instead of one
+// level at a time (default: on)
+void rocksdb_read_options_set_optimize_multiget_for_io(RocksDBReadOptionsRef opts, int value);
+// Fixed iterator readahead in bytes, 0 for auto-readahead (default: 0)
+void rocksdb_read_options_set_readahead_size(RocksDBReadOptionsRef opts, size_t size);
+// Trim auto-readahead at iterate_upper_bound (default: on)
+void rocksdb_read_options_set_auto_readahead_size(RocksDBReadOptionsRef opts, int value);
+// Carry the grown auto-readahead size over to the next file (default: off)
+void rocksdb_read_options_set_adaptive_readahead(RocksDBReadOptionsRef opts, int value);
+// Deepest storage a read may touch (rocksdb::ReadTier value). Reads that
+// need data beyond it fail with RocksDBStatusIncomplete instead of doing I/O.
+void rocksdb_read_options_set_read_tier(RocksDBReadOptionsRef opts, int tier);
+// Point lookups past deadline_micros (microseconds since the Unix epoch, the
+// default Env clock; 0 = none) fail with RocksDBStatusTimedOut. io_timeout
+// bounds each file read the file system issues (0 = none).
+void rocksdb_read_options_set_deadline(RocksDBReadOptionsRef opts, uint64_t deadline_micros);
+void rocksdb_read_options_set_io_timeout(RocksDBReadOptionsRef opts, uint64_t timeout_micros);
+// MultiGet returns RocksDBStatusAborted for the remaining keys once the
+// values found add up to more than this many bytes
+void rocksdb_read_options_set_value_size_soft_limit(RocksDBReadOptionsRef opts, uint64_t limit);
+// Charge file reads to the database's rate limiter at this rocksdb::Env::IOPriority
+// (0 low ... 3 user); 4 (IO_TOTAL, the default) leaves them uncharged
+void rocksdb_read_options_set_rate_limiter_priority(RocksDBReadOptionsRef opts, int priority);
+// Iterators follow new writes: a seek after data was written sees it,
+// without a snapshot of their own. Backward iteration is not supported.
+void rocksdb_read_options_set_tailing(RocksDBReadOptionsRef opts, int value);
+// Keep the blocks and memtables an iterator read from alive until it is
+// destroyed, so its keys stay valid after it moves (see
+// rocksdb_iterator_is_key_pinned)
+void rocksdb_read_options_set_pin_data(RocksDBReadOptionsRef opts, int value);
+// Delete obsolete files an iterator held the last reference to on the
+// high-priority background pool instead of in rocksdb_iterator_destroy
+void rocksdb_read_options_set_background_purge_on_iterator_cleanup(RocksDBReadOptionsRef opts,
+                                                                   int value);
+// Iterator bounds (lower inclusive, upper exclusive); the key is copied into the
+// handle. Pass NULL to clear a bound.
+void rocksdb_read_options_set_iterate_lower_bound(RocksDBReadOptionsRef opts,
+                                                  const char* key, size_t key_len);
+void rocksdb_read_options_set_iterate_upper_bound(RocksDBReadOptionsRef opts,
+                                                  const char* key, size_t key_len);
+
+// User-defined timestamps (RocksDBComparatorBytewiseU64Timestamp): reads see
+// versions at or below timestamp, which is required on such databases.
+// iter_start_timestamp makes iterators return every version in
+// [iter_start_timestamp, timestamp]. has_timestamp 0 clears.
+void rocksdb_read_options_set_timestamp(RocksDBReadOptionsRef opts, int has_timestamp,
+                                        uint64_t timestamp);
+void rocksdb_read_options_set_iter_start_timestamp(RocksDBReadOptionsRef opts,
+                                                   int has_timestamp, uint64_t timestamp);
 
 // Write Options
 RocksDBWriteOptionsRef rocksdb_write_options_create(void);
@@ -116,19 +1107,146 @@ void rocksdb_write_options_destroy(RocksDBWriteOptionsRef opts);
 void rocksdb_write_options_set_sync(RocksDBWriteOptionsRef opts, int value);
 void rocksdb_write_options_disable_wal(RocksDBWriteOptionsRef opts, int value);
 
+// Transaction Database Options (rocksdb_open_transaction_db); mode is
+// RocksDBTransactionModeCode. Settings of the other mode are ignored.
+RocksDBTransactionDBOptionsRef rocksdb_transaction_db_options_create(int mode);
+void rocksdb_transaction_db_options_destroy(RocksDBTransactionDBOptionsRef opts);
+// How long a transaction waits for a row lock before failing with TimedOut
+// (milliseconds, -1 waits forever; default: 1000)
+void rocksdb_transaction_db_options_set_lock_timeout(RocksDBTransactionDBOptionsRef opts,
+                                                     int64_t timeout_ms);
+// Same for writes made outside a transaction (default: 1000)
+void rocksdb_transaction_db_options_set_default_lock_timeout(RocksDBTransactionDBOptionsRef opts,
+                                                             int64_t timeout_ms);
+// Lock table shards per column family; more stripes reduce mutex contention (default: 16)
+void rocksdb_transaction_db_options_set_num_stripes(RocksDBTransactionDBOptionsRef opts,
+                                                    size_t num_stripes);
+// Maximum row locks held per column family, -1 for unlimited (default: -1)
+void rocksdb_transaction_db_options_set_max_num_locks(RocksDBTransactionDBOptionsRef opts,
+                                                      int64_t max_num_locks);
+// Detect lock cycles up to depth waiters deep and fail one transaction with
+// Busy instead of waiting out the timeout (default: disabled, depth 50)
+void rocksdb_transaction_db_options_set_deadlock_detect(RocksDBTransactionDBOptionsRef opts,
+                                                        int enabled, int64_t depth);
+// When pessimistic writes reach the memtable (policy is RocksDBTxnWritePolicy;
+// default: committed). The policy is persistent: reopen with the same one.
+void rocksdb_transaction_db_options_set_write_policy(RocksDBTransactionDBOptionsRef opts,
+                                                     int policy);
+// Under write-unprepared, a transaction batch larger than this many bytes is
+// written to the memtable early (0 = never; default: 0)
+void rocksdb_transaction_db_options_set_write_batch_flush_threshold(RocksDBTransactionDBOptionsRef opts,
+                                                                    int64_t bytes);
+// Open pessimistic databases with allow_2pc, so transactions can be named and
+// prepared ones are recovered from the WAL (default: off)
+void rocksdb_transaction_db_options_set_two_phase_commit(RocksDBTransactionDBOptionsRef opts,
+                                                         int enabled);
+// Optimistic commit validation (policy is RocksDBOccValidationPolicy; default: parallel)
+void rocksdb_transaction_db_options_set_validate_policy(RocksDBTransactionDBOptionsRef opts,
+                                                        int policy);
+// Striped mutexes used by parallel validation (default: 2^20); ignored when
+// shared buckets are set
+void rocksdb_transaction_db_options_set_occ_lock_buckets(RocksDBTransactionDBOptionsRef opts,
+                                                         uint32_t bucket_count);
+// Validation mutex pool shared with other databases; NULL clears. The
+// database keeps the pool alive while it is open.
+void rocksdb_transaction_db_options_set_shared_occ_lock_buckets(RocksDBTransactionDBOptionsRef opts,
+                                                                RocksDBOccLockBucketsRef buckets);
+
+// Pool of validation mutexes for optimistic databases (MakeSharedOccLockBuckets);
+// cache_aligned trades memory for less false sharing
+RocksDBOccLockBucketsRef rocksdb_occ_lock_buckets_create(size_t bucket_count, int cache_aligned);
+void rocksdb_occ_lock_buckets_destroy(RocksDBOccLockBucketsRef buckets);
+
 // =============================================================================
 // MARK: - Database Operations
 // =============================================================================
 
 RocksDBStatus rocksdb_open(const char* path, RocksDBOptionsRef opts, RocksDBRef* db_out);
+// rocksdb_open that also breaks down where open time went. File opens are
+// observed through a FileSystem wrapper that stays installed, at the cost of
+// one atomic load per file open; with a custom Env only total_nanos is set.
+RocksDBStatus rocksdb_open_timed(const char* path, RocksDBOptionsRef opts,
+                                 RocksDBOpenTimingValues* timing_out, RocksDBRef* db_out);
 RocksDBStatus rocksdb_open_for_read_only(const char* path, RocksDBOptionsRef opts,
                                           int error_if_wal_exists, RocksDBRef* db_out);
+// Open a new, empty database whose files (SSTs, WAL, MANIFEST, info log)
+// live in a private in-memory Env, so writes and syncs never touch the disk.
+// path only names the database inside that Env; everything is freed by
+// rocksdb_close. A custom Env in opts is replaced.
+RocksDBStatus rocksdb_open_in_memory(const char* path, RocksDBOptionsRef opts, RocksDBRef* db_out);
+// Open a read-only secondary of the primary database at path, keeping its
+// own info logs in secondary_path. Unlike read-only opens, a secondary
+// follows the primary's new MANIFEST and WAL entries through
+// rocksdb_try_catch_up_with_primary. Only the default family is opened.
+RocksDBStatus rocksdb_open_as_secondary(const char* path, const char* secondary_path,
+                                        RocksDBOptionsRef opts, RocksDBRef* db_out);
+// Replay what the primary has written since the last catch-up
+RocksDBStatus rocksdb_try_catch_up_with_primary(RocksDBRef db);
+// Open with DBWithTTL: entries older than ttl_seconds (<= 0 means never) are
+// dropped during compaction. Expiry is lazy, so reads may still return expired
+// entries until their files are compacted. Values carry a 4-byte timestamp
+// suffix on disk, so TTL databases must always be opened this way.
+RocksDBStatus rocksdb_open_with_ttl(const char* path, RocksDBOptionsRef opts,
+                                   int32_t ttl_seconds, int read_only, RocksDBRef* db_out);
+// Change the TTL of a family (NULL for default) of a database opened with a TTL
+RocksDBStatus rocksdb_set_ttl(RocksDBRef db, RocksDBColumnFamilyRef cf, int32_t ttl_seconds);
 RocksDBStatus rocksdb_open_transactional(const char* path, RocksDBOptionsRef opts, RocksDBRef* db_out);
+// Open in the mode of txn_opts (NULL for optimistic with default settings)
+RocksDBStatus rocksdb_open_transaction_db(const char* path, RocksDBOptionsRef opts,
+                                          RocksDBTransactionDBOptionsRef txn_opts,
+                                          RocksDBRef* db_out);
 void rocksdb_close(RocksDBRef db);
 
 // Check if database was opened with transaction support
 int rocksdb_is_transactional(RocksDBRef db);
 
+// =============================================================================
+// MARK: - Column Families
+// =============================================================================
+
+// Column family refs are owned by the database: they stay valid (even after
+// a drop) until the database is deleted and must not be freed. Every *_cf
+// function treats a NULL family as the default column family.
+
+// Open with the given families (families_out must hold num_families entries).
+// family_opts[i] (or family_opts itself) may be NULL to use opts; only the
+// column family subset of each options handle is used. The default family is
+// opened implicitly when not listed.
+RocksDBStatus rocksdb_open_column_families(const char* path, RocksDBOptionsRef opts,
+                                           size_t num_families,
+                                           const char* const* names,
+                                           const RocksDBOptionsRef* family_opts,
+                                           RocksDBRef* db_out,
+                                           RocksDBColumnFamilyRef* families_out);
+RocksDBStatus rocksdb_open_transactional_column_families(const char* path, RocksDBOptionsRef opts,
+                                                         size_t num_families,
+                                                         const char* const* names,
+                                                         const RocksDBOptionsRef* family_opts,
+                                                         RocksDBRef* db_out,
+                                                         RocksDBColumnFamilyRef* families_out);
+RocksDBStatus rocksdb_open_transaction_db_column_families(const char* path, RocksDBOptionsRef opts,
+                                                          RocksDBTransactionDBOptionsRef txn_opts,
+                                                          size_t num_families,
+                                                          const char* const* names,
+                                                          const RocksDBOptionsRef* family_opts,
+                                                          RocksDBRef* db_out,
+                                                          RocksDBColumnFamilyRef* families_out);
+
+// Names of the families in an existing database; free with rocksdb_free_string_list
+RocksDBStatus rocksdb_list_column_families(const char* path, RocksDBOptionsRef opts,
+                                           char*** names_out, size_t* count_out);
+void rocksdb_free_string_list(char** names, size_t count);
+
+RocksDBStatus rocksdb_create_column_family(RocksDBRef db, RocksDBOptionsRef opts,
+                                           const char* name,
+                                           RocksDBColumnFamilyRef* cf_out);
+RocksDBStatus rocksdb_drop_column_family(RocksDBRef db, RocksDBColumnFamilyRef cf);
+// Explicit ref for the default family, for calls that require one (e.g. batch entities)
+RocksDBColumnFamilyRef rocksdb_default_column_family(RocksDBRef db);
+const char* rocksdb_column_family_name(RocksDBColumnFamilyRef cf);
+// Id recorded in WAL records of the family (0 for NULL, the default family)
+uint32_t rocksdb_column_family_id(RocksDBColumnFamilyRef cf);
+
 // =============================================================================
 // MARK: - Key-Value Operations
 // =============================================================================
@@ -136,47 +1254,434 @@ int rocksdb_is_transactional(RocksDBRef db);
 RocksDBStatus rocksdb_put(RocksDBRef db, RocksDBWriteOptionsRef opts,
                           const char* key, size_t key_len,
                           const char* value, size_t value_len);
+RocksDBStatus rocksdb_put_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                             RocksDBWriteOptionsRef opts,
+                             const char* key, size_t key_len,
+                             const char* value, size_t value_len);
+
+// Requires a merge operator configured in the database options
+RocksDBStatus rocksdb_merge(RocksDBRef db, RocksDBWriteOptionsRef opts,
+                            const char* key, size_t key_len,
+                            const char* value, size_t value_len);
+RocksDBStatus rocksdb_merge_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                               RocksDBWriteOptionsRef opts,
+                               const char* key, size_t key_len,
+                               const char* value, size_t value_len);
 
 RocksDBStatus rocksdb_get(RocksDBRef db, RocksDBReadOptionsRef opts,
                           const char* key, size_t key_len,
                           char** value_out, size_t* value_len_out);
 
+// Zero-copy read: the value stays pinned in the block or blob cache (or a
+// copy for memtable and uncached blob values) until the handle is released
+// with rocksdb_pinnable_slice_destroy. A pinned value keeps the database
+// alive even after rocksdb_close.
+RocksDBStatus rocksdb_get_pinned(RocksDBRef db, RocksDBReadOptionsRef opts,
+                                 const char* key, size_t key_len,
+                                 RocksDBPinnableSliceRef* pinned_out);
+RocksDBStatus rocksdb_get_pinned_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                    RocksDBReadOptionsRef opts,
+                                    const char* key, size_t key_len,
+                                    RocksDBPinnableSliceRef* pinned_out);
+
+// Returns pointer to pinned data - do NOT free, valid until the handle is destroyed
+const char* rocksdb_pinnable_slice_value(RocksDBPinnableSliceRef pinned, size_t* len_out);
+void rocksdb_pinnable_slice_destroy(RocksDBPinnableSliceRef pinned);
+
+// Batched lookup via DB::MultiGet. values_out and statuses_out must hold
+// num_keys entries; each found value is returned as a pinned handle and each
+// status message (if any) must be freed with rocksdb_free_string.
+// Set sorted_input when keys are already in comparator order.
+void rocksdb_multi_get(RocksDBRef db, RocksDBReadOptionsRef opts,
+                       size_t num_keys,
+                       const char* const* keys, const size_t* key_lens,
+                       int sorted_input,
+                       RocksDBPinnableSliceRef* values_out,
+                       RocksDBStatus* statuses_out);
+void rocksdb_multi_get_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                          RocksDBReadOptionsRef opts,
+                          size_t num_keys,
+                          const char* const* keys, const size_t* key_lens,
+                          int sorted_input,
+                          RocksDBPinnableSliceRef* values_out,
+                          RocksDBStatus* statuses_out);
+
 RocksDBStatus rocksdb_delete(RocksDBRef db, RocksDBWriteOptionsRef opts,
                              const char* key, size_t key_len);
+RocksDBStatus rocksdb_delete_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                RocksDBWriteOptionsRef opts,
+                                const char* key, size_t key_len);
+
+// Tombstone that cancels with the single put it covers as soon as the two
+// meet in compaction. Only valid for keys written once since their last
+// delete; overwritten or merged keys give undefined results.
+RocksDBStatus rocksdb_single_delete(RocksDBRef db, RocksDBWriteOptionsRef opts,
+                                    const char* key, size_t key_len);
+RocksDBStatus rocksdb_single_delete_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                       RocksDBWriteOptionsRef opts,
+                                       const char* key, size_t key_len);
+
+// Range tombstone over [start_key, end_key); cheap regardless of range size
+RocksDBStatus rocksdb_delete_range(RocksDBRef db, RocksDBWriteOptionsRef opts,
+                                   const char* start_key, size_t start_key_len,
+                                   const char* end_key, size_t end_key_len);
+RocksDBStatus rocksdb_delete_range_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                      RocksDBWriteOptionsRef opts,
+                                      const char* start_key, size_t start_key_len,
+                                      const char* end_key, size_t end_key_len);
 
 int rocksdb_key_may_exist(RocksDBRef db, RocksDBReadOptionsRef opts,
                           const char* key, size_t key_len);
 
+typedef enum {
+  RocksDBKeyAbsent = 0,
+  RocksDBKeyMaybePresent = 1,
+  RocksDBKeyPresent = 2
+} RocksDBKeyExistenceCode;
+
+// Bloom filter and memtable check that hands back the value when the lookup
+// found it without I/O (in a memtable or the block cache). Returns
+// RocksDBKeyPresent with *value_out set, released with
+// rocksdb_pinnable_slice_destroy; otherwise *value_out is NULL. Pass a NULL
+// value_out to only test for existence.
+RocksDBKeyExistenceCode rocksdb_key_may_exist_value_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                                       RocksDBReadOptionsRef opts,
+                                                       const char* key, size_t key_len,
+                                                       RocksDBPinnableSliceRef* value_out);
+
+// Batched existence check: one MultiGet restricted to memtables and the block
+// cache, so keys are ruled out by bloom/ribbon filters in MultiGet order and
+// no data block is read from disk. results_out holds num_keys entries; a key
+// whose filter or data block is not cached is reported RocksDBKeyMaybePresent.
+void rocksdb_keys_may_exist_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                               RocksDBReadOptionsRef opts,
+                               size_t num_keys,
+                               const char* const* keys, const size_t* key_lens,
+                               int sorted_input,
+                               RocksDBKeyExistenceCode* results_out);
+
+// =============================================================================
+// MARK: - Read Contexts
+// =============================================================================
+
+// Reusable per-thread lookup state: a copy of the read options plus the
+// value slices and scratch vectors lookups fill. Once the buffers have grown
+// to the working set, lookups through a context allocate nothing. A not-found
+// status carries no message. Values stay valid until the next lookup or
+// rocksdb_read_context_reset, which must run before the database is closed.
+// A context must not be used from two threads at once.
+RocksDBReadContextRef rocksdb_read_context_create(RocksDBReadOptionsRef opts);
+void rocksdb_read_context_destroy(RocksDBReadContextRef ctx);
+
+// Release pinned values held by the context
+void rocksdb_read_context_reset(RocksDBReadContextRef ctx);
+
+RocksDBStatus rocksdb_read_context_get(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                       RocksDBReadContextRef ctx,
+                                       const char* key, size_t key_len,
+                                       const char** value_out, size_t* value_len_out);
+
+// values_out, value_lens_out and statuses_out must hold num_keys entries;
+// values of missing keys are NULL
+void rocksdb_read_context_multi_get(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                    RocksDBReadContextRef ctx,
+                                    size_t num_keys,
+                                    const char* const* keys, const size_t* key_lens,
+                                    int sorted_input,
+                                    const char** values_out, size_t* value_lens_out,
+                                    RocksDBStatus* statuses_out);
+
+// =============================================================================
+// MARK: - User-Defined Timestamps
+// =============================================================================
+
+// For databases using RocksDBComparatorBytewiseU64Timestamp. Keys are passed
+// without their timestamp; every write carries one.
+RocksDBStatus rocksdb_put_with_timestamp_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                            RocksDBWriteOptionsRef opts,
+                                            const char* key, size_t key_len,
+                                            uint64_t timestamp,
+                                            const char* value, size_t value_len);
+RocksDBStatus rocksdb_delete_with_timestamp_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                               RocksDBWriteOptionsRef opts,
+                                               const char* key, size_t key_len,
+                                               uint64_t timestamp);
+// Newest version at or below read_timestamp (overrides the options' timestamp);
+// *timestamp_out receives that version's timestamp
+RocksDBStatus rocksdb_get_pinned_with_timestamp_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                                   RocksDBReadOptionsRef opts,
+                                                   uint64_t read_timestamp,
+                                                   const char* key, size_t key_len,
+                                                   RocksDBPinnableSliceRef* pinned_out,
+                                                   uint64_t* timestamp_out);
+// Versions older than the low watermark may be garbage collected by compaction;
+// reads below it fail. The watermark can only move forward.
+RocksDBStatus rocksdb_increase_full_history_ts_low(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                                   uint64_t timestamp);
+RocksDBStatus rocksdb_get_full_history_ts_low(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                              uint64_t* timestamp_out);
+
+// =============================================================================
+// MARK: - Wide Columns
+// =============================================================================
+
+// Columns are passed as parallel name/value pointer and length arrays in any
+// order; RocksDB stores them sorted by name.
+RocksDBStatus rocksdb_put_entity_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                    RocksDBWriteOptionsRef opts,
+                                    const char* key, size_t key_len,
+                                    size_t num_columns,
+                                    const char* const* names, const size_t* name_lens,
+                                    const char* const* values, const size_t* value_lens);
+
+// On success *columns_out pins the entity (like rocksdb_get_pinned) until
+// rocksdb_wide_columns_destroy. A plain value reads back as a single column
+// with an empty name.
+RocksDBStatus rocksdb_get_entity_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                    RocksDBReadOptionsRef opts,
+                                    const char* key, size_t key_len,
+                                    RocksDBWideColumnsRef* columns_out);
+size_t rocksdb_wide_columns_count(RocksDBWideColumnsRef columns);
+// Returned pointers are owned by the handle - do NOT free
+const char* rocksdb_wide_columns_name(RocksDBWideColumnsRef columns, size_t index,
+                                      size_t* len_out);
+const char* rocksdb_wide_columns_value(RocksDBWideColumnsRef columns, size_t index,
+                                       size_t* len_out);
+// Binary search by column name; NULL if the entity has no such column
+const char* rocksdb_wide_columns_find(RocksDBWideColumnsRef columns,
+                                      const char* name, size_t name_len,
+                                      size_t* len_out);
+void rocksdb_wide_columns_destroy(RocksDBWideColumnsRef columns);
+
+// =============================================================================
+// MARK: - Attribute Groups
+// =============================================================================
+
+// Store one entity split across column families. Group i belongs to
+// families[i] and owns the next column_counts[i] entries of the flattened
+// name/value arrays. Families must be explicit (not NULL).
+RocksDBStatus rocksdb_put_attribute_groups(RocksDBRef db, RocksDBWriteOptionsRef opts,
+                                           const char* key, size_t key_len,
+                                           size_t num_groups,
+                                           const RocksDBColumnFamilyRef* families,
+                                           const size_t* column_counts,
+                                           const char* const* names, const size_t* name_lens,
+                                           const char* const* values, const size_t* value_lens);
+
+// Read the entity's group from each of the given families in one call; only
+// those families are touched. Group i carries its own status (NotFound when
+// the key has no entity in families[i]) and stays pinned until
+// rocksdb_attribute_groups_destroy.
+RocksDBStatus rocksdb_get_attribute_groups(RocksDBRef db, RocksDBReadOptionsRef opts,
+                                           const char* key, size_t key_len,
+                                           size_t num_groups,
+                                           const RocksDBColumnFamilyRef* families,
+                                           RocksDBAttributeGroupsRef* groups_out);
+RocksDBStatus rocksdb_attribute_group_status(RocksDBAttributeGroupsRef groups, size_t group);
+size_t rocksdb_attribute_group_column_count(RocksDBAttributeGroupsRef groups, size_t group);
+const char* rocksdb_attribute_group_column_name(RocksDBAttributeGroupsRef groups, size_t group,
+                                                size_t index, size_t* len_out);
+const char* rocksdb_attribute_group_column_value(RocksDBAttributeGroupsRef groups, size_t group,
+                                                 size_t index, size_t* len_out);
+void rocksdb_attribute_groups_destroy(RocksDBAttributeGroupsRef groups);
+
+// Cross-family iterator yielding, per key, the groups of the families that
+// contain it (EXPERIMENTAL in RocksDB)
+RocksDBAttributeGroupIteratorRef rocksdb_attribute_group_iterator_create(
+    RocksDBRef db, RocksDBReadOptionsRef opts,
+    size_t num_families, const RocksDBColumnFamilyRef* families);
+void rocksdb_attribute_group_iterator_destroy(RocksDBAttributeGroupIteratorRef iter);
+int rocksdb_attribute_group_iterator_valid(RocksDBAttributeGroupIteratorRef iter);
+void rocksdb_attribute_group_iterator_seek_to_first(RocksDBAttributeGroupIteratorRef iter);
+void rocksdb_attribute_group_iterator_seek_to_last(RocksDBAttributeGroupIteratorRef iter);
+void rocksdb_attribute_group_iterator_seek(RocksDBAttributeGroupIteratorRef iter,
+                                           const char* key, size_t key_len);
+void rocksdb_attribute_group_iterator_seek_for_prev(RocksDBAttributeGroupIteratorRef iter,
+                                                    const char* key, size_t key_len);
+void rocksdb_attribute_group_iterator_next(RocksDBAttributeGroupIteratorRef iter);
+void rocksdb_attribute_group_iterator_prev(RocksDBAttributeGroupIteratorRef iter);
+// Same lifetime rules as rocksdb_iterator_key
+const char* rocksdb_attribute_group_iterator_key(RocksDBAttributeGroupIteratorRef iter,
+                                                 size_t* len_out);
+size_t rocksdb_attribute_group_iterator_group_count(RocksDBAttributeGroupIteratorRef iter);
+// Index into the families passed at creation (SIZE_MAX if unknown)
+size_t rocksdb_attribute_group_iterator_group_family(RocksDBAttributeGroupIteratorRef iter,
+                                                     size_t group);
+size_t rocksdb_attribute_group_iterator_column_count(RocksDBAttributeGroupIteratorRef iter,
+                                                     size_t group);
+const char* rocksdb_attribute_group_iterator_column_name(RocksDBAttributeGroupIteratorRef iter,
+                                                         size_t group, size_t index,
+                                                         size_t* len_out);
+const char* rocksdb_attribute_group_iterator_column_value(RocksDBAttributeGroupIteratorRef iter,
+                                                          size_t group, size_t index,
+                                                          size_t* len_out);
+RocksDBStatus rocksdb_attribute_group_iterator_status(RocksDBAttributeGroupIteratorRef iter);
+
 // =============================================================================
 // MARK: - Batch Operations
 // =============================================================================
 
 RocksDBBatchRef rocksdb_batch_create(void);
+// Preallocate reserved_bytes; appends that would grow the batch past
+// max_bytes (0 = unlimited) fail and are recorded in the batch status
+RocksDBBatchRef rocksdb_batch_create_with_capacity(size_t reserved_bytes, size_t max_bytes);
+// Batch holding a copy of a serialized WriteBatch (see rocksdb_batch_data or
+// rocksdb_wal_iterator_batch). Only the header is checked unless verify is
+// nonzero, which parses every operation without copying it; applying a
+// corrupt rep fails the write after it reached the WAL, so skip verify only
+// for bytes whose integrity the transport already checks.
+RocksDBStatus rocksdb_batch_create_from_data(const char* data, size_t len, int verify,
+                                             RocksDBBatchRef* batch_out);
 void rocksdb_batch_destroy(RocksDBBatchRef batch);
 
 void rocksdb_batch_put(RocksDBBatchRef batch,
                        const char* key, size_t key_len,
                        const char* value, size_t value_len);
 
+void rocksdb_batch_merge(RocksDBBatchRef batch,
+                         const char* key, size_t key_len,
+                         const char* value, size_t value_len);
+
 void rocksdb_batch_delete(RocksDBBatchRef batch,
                           const char* key, size_t key_len);
 
+// See rocksdb_single_delete
+void rocksdb_batch_single_delete(RocksDBBatchRef batch,
+                                 const char* key, size_t key_len);
+
 void rocksdb_batch_delete_range(RocksDBBatchRef batch,
                                 const char* start_key, size_t start_key_len,
                                 const char* end_key, size_t end_key_len);
 
+// Column family variants; the family must belong to the database the batch is written to
+void rocksdb_batch_put_cf(RocksDBBatchRef batch, RocksDBColumnFamilyRef cf,
+                          const char* key, size_t key_len,
+                          const char* value, size_t value_len);
+void rocksdb_batch_merge_cf(RocksDBBatchRef batch, RocksDBColumnFamilyRef cf,
+                            const char* key, size_t key_len,
+                            const char* value, size_t value_len);
+void rocksdb_batch_delete_cf(RocksDBBatchRef batch, RocksDBColumnFamilyRef cf,
+                             const char* key, size_t key_len);
+void rocksdb_batch_single_delete_cf(RocksDBBatchRef batch, RocksDBColumnFamilyRef cf,
+                                    const char* key, size_t key_len);
+void rocksdb_batch_delete_range_cf(RocksDBBatchRef batch, RocksDBColumnFamilyRef cf,
+                                   const char* start_key, size_t start_key_len,
+                                   const char* end_key, size_t end_key_len);
+
+// Bulk appends: one call for many entries; stop at the first failed append
+void rocksdb_batch_put_many(RocksDBBatchRef batch, size_t num_entries,
+                            const char* const* keys, const size_t* key_lens,
+                            const char* const* values, const size_t* value_lens);
+
+// Packed layout: entry i has key [offsets[2i], offsets[2i+1]) and value
+// [offsets[2i+1], offsets[2i+2]) in buffer (offsets has 2*num_entries+1 items);
+// offsets are not checked and must be non-decreasing and within buffer
+void rocksdb_batch_put_packed(RocksDBBatchRef batch, const char* buffer,
+                              const size_t* offsets, size_t num_entries);
+
+// Put one entry whose key and value are concatenations of the given parts
+void rocksdb_batch_put_parts(RocksDBBatchRef batch,
+                             size_t num_key_parts, const char* const* key_parts,
+                             const size_t* key_part_lens,
+                             size_t num_value_parts, const char* const* value_parts,
+                             const size_t* value_part_lens);
+
+void rocksdb_batch_delete_many(RocksDBBatchRef batch, size_t num_keys,
+                               const char* const* keys, const size_t* key_lens);
+
+// Timestamped writes require an explicit family (see rocksdb_default_column_family)
+void rocksdb_batch_put_with_timestamp_cf(RocksDBBatchRef batch, RocksDBColumnFamilyRef cf,
+                                         const char* key, size_t key_len,
+                                         uint64_t timestamp,
+                                         const char* value, size_t value_len);
+void rocksdb_batch_delete_with_timestamp_cf(RocksDBBatchRef batch, RocksDBColumnFamilyRef cf,
+                                            const char* key, size_t key_len,
+                                            uint64_t timestamp);
+
+// Requires an explicit family (see rocksdb_default_column_family)
+void rocksdb_batch_put_entity_cf(RocksDBBatchRef batch, RocksDBColumnFamilyRef cf,
+                                 const char* key, size_t key_len,
+                                 size_t num_columns,
+                                 const char* const* names, const size_t* name_lens,
+                                 const char* const* values, const size_t* value_lens);
+
+// Layout as for rocksdb_put_attribute_groups
+void rocksdb_batch_put_attribute_groups(RocksDBBatchRef batch,
+                                        const char* key, size_t key_len,
+                                        size_t num_groups,
+                                        const RocksDBColumnFamilyRef* families,
+                                        const size_t* column_counts,
+                                        const char* const* names, const size_t* name_lens,
+                                        const char* const* values, const size_t* value_lens);
+
+// Clears entries and status; the allocated capacity is kept for reuse
 void rocksdb_batch_clear(RocksDBBatchRef batch);
+// First failed append since creation or the last clear (OK if none);
+// rocksdb_write_batch refuses batches with a failed status
+RocksDBStatus rocksdb_batch_status(RocksDBBatchRef batch);
 size_t rocksdb_batch_count(RocksDBBatchRef batch);
 size_t rocksdb_batch_data_size(RocksDBBatchRef batch);
+// Serialized WriteBatch, for shipping to another database as is. Do NOT
+// free; valid until the batch is next modified, cleared or destroyed.
+const char* rocksdb_batch_data(RocksDBBatchRef batch, size_t* len_out);
 
 RocksDBStatus rocksdb_write_batch(RocksDBRef db, RocksDBWriteOptionsRef opts,
                                   RocksDBBatchRef batch);
 
+// =============================================================================
+// MARK: - Indexed Batch Operations
+// =============================================================================
+
+// WriteBatchWithIndex: a batch whose staged writes can be read back, alone or
+// merged with the database, before it is written. With overwrite_key, a later
+// update of a key replaces the earlier one in the index (required for reads
+// of merged keys to see every operand when they were staged more than once).
+// Entries of the NULL family are indexed bytewise; pass the family explicitly
+// when its comparator differs.
+RocksDBIndexedBatchRef rocksdb_indexed_batch_create(size_t reserved_bytes, int overwrite_key);
+void rocksdb_indexed_batch_destroy(RocksDBIndexedBatchRef batch);
+
+void rocksdb_indexed_batch_put_cf(RocksDBIndexedBatchRef batch, RocksDBColumnFamilyRef cf,
+                                  const char* key, size_t key_len,
+                                  const char* value, size_t value_len);
+void rocksdb_indexed_batch_merge_cf(RocksDBIndexedBatchRef batch, RocksDBColumnFamilyRef cf,
+                                    const char* key, size_t key_len,
+                                    const char* value, size_t value_len);
+void rocksdb_indexed_batch_delete_cf(RocksDBIndexedBatchRef batch, RocksDBColumnFamilyRef cf,
+                                     const char* key, size_t key_len);
+void rocksdb_indexed_batch_single_delete_cf(RocksDBIndexedBatchRef batch, RocksDBColumnFamilyRef cf,
+                                            const char* key, size_t key_len);
+void rocksdb_indexed_batch_clear(RocksDBIndexedBatchRef batch);
+
+// First failed append, if any; rocksdb_write_indexed_batch refuses failed batches
+RocksDBStatus rocksdb_indexed_batch_status(RocksDBIndexedBatchRef batch);
+size_t rocksdb_indexed_batch_count(RocksDBIndexedBatchRef batch);
+
+// Value of key as seen after the batch is applied on top of the database
+// (GetFromBatchAndDB); the pinned value retains the database
+RocksDBStatus rocksdb_indexed_batch_get_pinned_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                                  RocksDBReadOptionsRef opts,
+                                                  RocksDBIndexedBatchRef batch,
+                                                  const char* key, size_t key_len,
+                                                  RocksDBPinnableSliceRef* pinned_out);
+
+// Iterator over the database with the batch's staged writes overlaid
+// (NewIteratorWithBase). The batch must outlive the iterator and must not be
+// modified while the iterator is in use.
+RocksDBIteratorRef rocksdb_indexed_batch_create_iterator_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                                            RocksDBReadOptionsRef opts,
+                                                            RocksDBIndexedBatchRef batch);
+
+RocksDBStatus rocksdb_write_indexed_batch(RocksDBRef db, RocksDBWriteOptionsRef opts,
+                                          RocksDBIndexedBatchRef batch);
+
 // =============================================================================
 // MARK: - Iterator Operations
 // =============================================================================
 
 RocksDBIteratorRef rocksdb_iterator_create(RocksDBRef db, RocksDBReadOptionsRef opts);
+RocksDBIteratorRef rocksdb_iterator_create_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                              RocksDBReadOptionsRef opts);
 void rocksdb_iterator_destroy(RocksDBIteratorRef iter);
 
 int rocksdb_iterator_valid(RocksDBIteratorRef iter);
@@ -191,19 +1696,106 @@ void rocksdb_iterator_prev(RocksDBIteratorRef iter);
 const char* rocksdb_iterator_key(RocksDBIteratorRef iter, size_t* len_out);
 const char* rocksdb_iterator_value(RocksDBIteratorRef iter, size_t* len_out);
 
+// User timestamp of the current entry; returns 0 if there is none
+int rocksdb_iterator_timestamp(RocksDBIteratorRef iter, uint64_t* timestamp_out);
+
+// Wide columns of the current entry (one empty-named column for plain values);
+// same lifetime rules as rocksdb_iterator_key
+size_t rocksdb_iterator_columns_count(RocksDBIteratorRef iter);
+const char* rocksdb_iterator_column_name(RocksDBIteratorRef iter, size_t index,
+                                         size_t* len_out);
+const char* rocksdb_iterator_column_value(RocksDBIteratorRef iter, size_t index,
+                                          size_t* len_out);
+
+// Copy up to max_entries entries, starting at the current position, into buffer
+// and advance past them. Each entry is laid out as
+//   [uint32 key_len][uint32 value_len][key bytes][value bytes]
+// in native byte order, unaligned. Returns the number of entries written and
+// sets *bytes_used_out to the bytes used. If the next entry alone does not fit,
+// returns 0 and sets *bytes_used_out to the buffer size it requires.
+size_t rocksdb_iterator_next_batch(RocksDBIteratorRef iter,
+                                   char* buffer, size_t buffer_size,
+                                   size_t max_entries,
+                                   size_t* bytes_used_out);
+
 RocksDBStatus rocksdb_iterator_status(RocksDBIteratorRef iter);
 
+// Move a database iterator to the current state of the database, keeping
+// its memtable and SST references up to date instead of rebuilding it; the
+// position is lost, so seek afterwards. Iterators over transactions and
+// indexed batches return RocksDBStatusNotSupported.
+RocksDBStatus rocksdb_iterator_refresh(RocksDBIteratorRef iter);
+
+// Whether the current key stays valid until the iterator is destroyed or
+// refreshed, which pin_data guarantees for database iterators
+int rocksdb_iterator_is_key_pinned(RocksDBIteratorRef iter);
+
+// =============================================================================
+// MARK: - Range Aggregation
+// =============================================================================
+
+// Scan [start, end) (NULL bounds are open-ended) with a bounded iterator and
+// aggregate it without returning entries: row count, key and value bytes,
+// and, when field is not NULL, sum/min/max of an integer field of the
+// values. Values too short for the field are counted but not aggregated.
+RocksDBStatus rocksdb_aggregate_range_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                         RocksDBReadOptionsRef opts,
+                                         const char* start, size_t start_len,
+                                         const char* end, size_t end_len,
+                                         const RocksDBAggregateFieldSpec* field,
+                                         RocksDBAggregateValues* values_out);
+
 // =============================================================================
-// MARK: - Transaction Operations (OptimisticTransactionDB)
+// MARK: - Scan Predicates
+// =============================================================================
+
+// Compile a pre-order predicate tree; operands are copied. Returns NULL and
+// sets *error_out (free with rocksdb_free_string) when it is malformed.
+RocksDBScanPredicateRef rocksdb_scan_predicate_create(const RocksDBPredicateNode* nodes,
+                                                      size_t num_nodes,
+                                                      char** error_out);
+void rocksdb_scan_predicate_destroy(RocksDBScanPredicateRef predicate);
+
+// Like rocksdb_iterator_next_batch, but entries rejected by the predicate are
+// skipped inside the bridge and never copied out. A return of 0 with
+// *bytes_used_out == 0 means the iterator is exhausted.
+size_t rocksdb_iterator_next_batch_filtered(RocksDBIteratorRef iter,
+                                            RocksDBScanPredicateRef predicate,
+                                            char* buffer, size_t buffer_size,
+                                            size_t max_entries,
+                                            size_t* bytes_used_out);
+
+// =============================================================================
+// MARK: - Transaction Operations
 // =============================================================================
 
 RocksDBTransactionRef rocksdb_transaction_begin(RocksDBRef db, RocksDBWriteOptionsRef opts);
+// With set_snapshot, the transaction takes a snapshot at begin: conflicts are
+// checked against it and reads without an explicit snapshot read from it
+RocksDBTransactionRef rocksdb_transaction_begin_with_snapshot(RocksDBRef db,
+                                                              RocksDBWriteOptionsRef opts,
+                                                              int set_snapshot);
+// Begin by reinitializing old_txn (a finished transaction of the same
+// database) in place instead of allocating; returns old_txn, or a new
+// transaction when old_txn is NULL. While iterators of old_txn are still
+// open its write batch stays theirs: old_txn is destroyed (freed once the
+// last iterator closes) and a new transaction is returned instead
+RocksDBTransactionRef rocksdb_transaction_begin_reusing(RocksDBRef db,
+                                                        RocksDBWriteOptionsRef opts,
+                                                        int set_snapshot,
+                                                        RocksDBTransactionRef old_txn);
+// Each transaction keeps the database open until it is destroyed, so it may
+// outlive rocksdb_close; its iterators keep it alive in turn
 void rocksdb_transaction_destroy(RocksDBTransactionRef txn);
 
 RocksDBStatus rocksdb_transaction_put(RocksDBTransactionRef txn,
                                       const char* key, size_t key_len,
                                       const char* value, size_t value_len);
 
+RocksDBStatus rocksdb_transaction_merge(RocksDBTransactionRef txn,
+                                        const char* key, size_t key_len,
+                                        const char* value, size_t value_len);
+
 RocksDBStatus rocksdb_transaction_get(RocksDBTransactionRef txn, RocksDBReadOptionsRef opts,
                                       const char* key, size_t key_len,
                                       char** value_out, size_t* value_len_out);
@@ -212,24 +1804,159 @@ RocksDBStatus rocksdb_transaction_get_for_update(RocksDBTransactionRef txn, Rock
                                                   const char* key, size_t key_len,
                                                   char** value_out, size_t* value_len_out);
 
+// Pinned read within the transaction; the handle must be destroyed before the
+// transaction (it does not retain the database)
+RocksDBStatus rocksdb_transaction_get_pinned(RocksDBTransactionRef txn, RocksDBReadOptionsRef opts,
+                                             const char* key, size_t key_len,
+                                             RocksDBPinnableSliceRef* pinned_out);
+
 RocksDBStatus rocksdb_transaction_delete(RocksDBTransactionRef txn,
                                          const char* key, size_t key_len);
 
+// See rocksdb_single_delete
+RocksDBStatus rocksdb_transaction_single_delete(RocksDBTransactionRef txn,
+                                                const char* key, size_t key_len);
+
 RocksDBIteratorRef rocksdb_transaction_create_iterator(RocksDBTransactionRef txn,
                                                         RocksDBReadOptionsRef opts);
 
+// Column family variants
+RocksDBStatus rocksdb_transaction_put_cf(RocksDBTransactionRef txn, RocksDBColumnFamilyRef cf,
+                                         const char* key, size_t key_len,
+                                         const char* value, size_t value_len);
+RocksDBStatus rocksdb_transaction_merge_cf(RocksDBTransactionRef txn, RocksDBColumnFamilyRef cf,
+                                           const char* key, size_t key_len,
+                                           const char* value, size_t value_len);
+RocksDBStatus rocksdb_transaction_get_for_update_cf(RocksDBTransactionRef txn,
+                                                     RocksDBColumnFamilyRef cf,
+                                                     RocksDBReadOptionsRef opts,
+                                                     const char* key, size_t key_len,
+                                                     char** value_out, size_t* value_len_out);
+// Like rocksdb_get_pinned_cf, the pinned handle retains the database
+RocksDBStatus rocksdb_transaction_get_pinned_cf(RocksDBTransactionRef txn,
+                                                RocksDBColumnFamilyRef cf,
+                                                RocksDBReadOptionsRef opts,
+                                                const char* key, size_t key_len,
+                                                RocksDBPinnableSliceRef* pinned_out);
+
+// Batched reads within the transaction, with the same output contract as
+// rocksdb_multi_get_cf, except that the pinned handles must be destroyed
+// before the transaction; each handle retains the database. The _for_update
+// variant tracks (or, in pessimistic mode, locks) every key like
+// rocksdb_transaction_get_for_update.
+void rocksdb_transaction_multi_get_cf(RocksDBTransactionRef txn, RocksDBColumnFamilyRef cf,
+                                      RocksDBReadOptionsRef opts,
+                                      size_t num_keys,
+                                      const char* const* keys, const size_t* key_lens,
+                                      RocksDBPinnableSliceRef* values_out,
+                                      RocksDBStatus* statuses_out);
+void rocksdb_transaction_multi_get_for_update_cf(RocksDBTransactionRef txn,
+                                                 RocksDBColumnFamilyRef cf,
+                                                 RocksDBReadOptionsRef opts,
+                                                 size_t num_keys,
+                                                 const char* const* keys, const size_t* key_lens,
+                                                 RocksDBPinnableSliceRef* values_out,
+                                                 RocksDBStatus* statuses_out);
+RocksDBStatus rocksdb_transaction_delete_cf(RocksDBTransactionRef txn, RocksDBColumnFamilyRef cf,
+                                            const char* key, size_t key_len);
+RocksDBStatus rocksdb_transaction_single_delete_cf(RocksDBTransactionRef txn,
+                                                   RocksDBColumnFamilyRef cf,
+                                                   const char* key, size_t key_len);
+// Iterates the transaction's writes merged over the database, honoring the
+// iterate bounds of opts on both sides. The iterator turns invalid (with an
+// InvalidArgument status) at the next commit, rollback or savepoint rollback.
+RocksDBIteratorRef rocksdb_transaction_create_iterator_cf(RocksDBTransactionRef txn,
+                                                           RocksDBColumnFamilyRef cf,
+                                                           RocksDBReadOptionsRef opts);
+
+// Two-phase commit (pessimistic databases opened with two_phase_commit only):
+// name the transaction, then Prepare persists its writes to the WAL so Commit
+// only writes a marker.
+// Prepared transactions survive a crash; see rocksdb_get_prepared_transactions.
+RocksDBStatus rocksdb_transaction_set_name(RocksDBTransactionRef txn, const char* name);
+// Returns newly allocated string ("" if unnamed), caller must free with rocksdb_free_string
+char* rocksdb_transaction_get_name(RocksDBTransactionRef txn);
+RocksDBStatus rocksdb_transaction_prepare(RocksDBTransactionRef txn);
 RocksDBStatus rocksdb_transaction_commit(RocksDBTransactionRef txn);
 void rocksdb_transaction_rollback(RocksDBTransactionRef txn);
 
+// Transactions recovered in the prepared state at open, which still hold
+// their locks until committed or rolled back. Each is returned by the first
+// call only. Free the array with rocksdb_free_data and each transaction
+// with rocksdb_transaction_destroy.
+RocksDBStatus rocksdb_get_prepared_transactions(RocksDBRef db, RocksDBTransactionRef** txns_out,
+                                                size_t* count_out);
+
 void rocksdb_transaction_set_savepoint(RocksDBTransactionRef txn);
 RocksDBStatus rocksdb_transaction_rollback_to_savepoint(RocksDBTransactionRef txn);
 
+// =============================================================================
+// MARK: - External SST Files
+// =============================================================================
+
+// Ingest Options
+RocksDBIngestOptionsRef rocksdb_ingest_options_create(void);
+void rocksdb_ingest_options_destroy(RocksDBIngestOptionsRef opts);
+void rocksdb_ingest_options_set_move_files(RocksDBIngestOptionsRef opts, int value);
+void rocksdb_ingest_options_set_snapshot_consistency(RocksDBIngestOptionsRef opts, int value);
+void rocksdb_ingest_options_set_allow_global_seqno(RocksDBIngestOptionsRef opts, int value);
+void rocksdb_ingest_options_set_allow_blocking_flush(RocksDBIngestOptionsRef opts, int value);
+void rocksdb_ingest_options_set_ingest_behind(RocksDBIngestOptionsRef opts, int value);
+void rocksdb_ingest_options_set_verify_checksums_before_ingest(RocksDBIngestOptionsRef opts, int value);
+
+// SST File Writer - builds an SST from keys added in ascending order.
+// opts (may be NULL) should match the options of the database that will ingest the file.
+RocksDBSstFileWriterRef rocksdb_sst_file_writer_create(RocksDBOptionsRef opts);
+void rocksdb_sst_file_writer_destroy(RocksDBSstFileWriterRef writer);
+RocksDBStatus rocksdb_sst_file_writer_open(RocksDBSstFileWriterRef writer, const char* path);
+RocksDBStatus rocksdb_sst_file_writer_put(RocksDBSstFileWriterRef writer,
+                                          const char* key, size_t key_len,
+                                          const char* value, size_t value_len);
+RocksDBStatus rocksdb_sst_file_writer_merge(RocksDBSstFileWriterRef writer,
+                                            const char* key, size_t key_len,
+                                            const char* value, size_t value_len);
+RocksDBStatus rocksdb_sst_file_writer_delete(RocksDBSstFileWriterRef writer,
+                                             const char* key, size_t key_len);
+RocksDBStatus rocksdb_sst_file_writer_delete_range(RocksDBSstFileWriterRef writer,
+                                                   const char* start_key, size_t start_key_len,
+                                                   const char* end_key, size_t end_key_len);
+// Output pointers may be NULL
+RocksDBStatus rocksdb_sst_file_writer_finish(RocksDBSstFileWriterRef writer,
+                                             uint64_t* file_size_out,
+                                             uint64_t* num_entries_out);
+uint64_t rocksdb_sst_file_writer_file_size(RocksDBSstFileWriterRef writer);
+
+// Atomically ingest external SST files (opts may be NULL for defaults)
+RocksDBStatus rocksdb_ingest_external_file(RocksDBRef db,
+                                           const char* const* paths, size_t num_paths,
+                                           RocksDBIngestOptionsRef opts);
+
+// Write the live entries of [start, end) (NULL bounds are open-ended) into
+// export-000001.sst, export-000002.sst, ... in directory, created if
+// missing, starting a new file once one reaches target_file_size bytes
+// (0 = one file). One iterator reads the range, so the files are a
+// consistent view even without a snapshot in opts. Files are built with
+// the family's options for ingestion by any database with the same
+// comparator. *paths_out lists the files in key order (none for an empty
+// range; free with rocksdb_free_string_list); on failure the files written
+// so far are deleted.
+RocksDBStatus rocksdb_export_range_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                      RocksDBReadOptionsRef opts,
+                                      const char* start, size_t start_len,
+                                      const char* end, size_t end_len,
+                                      const char* directory, uint64_t target_file_size,
+                                      char*** paths_out, size_t* count_out);
+
 // =============================================================================
 // MARK: - Snapshot Operations
 // =============================================================================
 
 RocksDBSnapshotRef rocksdb_create_snapshot(RocksDBRef db);
 void rocksdb_release_snapshot(RocksDBRef db, RocksDBSnapshotRef snapshot);
+uint64_t rocksdb_snapshot_sequence_number(RocksDBSnapshotRef snapshot);
+// Live snapshots of the database and the creation time of the oldest one
+// (Unix seconds, 0 if there is none)
+void rocksdb_get_snapshot_stats(RocksDBRef db, uint64_t* count_out, uint64_t* oldest_time_out);
 
 // =============================================================================
 // MARK: - Maintenance Operations
@@ -239,10 +1966,121 @@ RocksDBStatus rocksdb_compact_range(RocksDBRef db,
                                     const char* start_key, size_t start_key_len,
                                     const char* end_key, size_t end_key_len);
 
+RocksDBStatus rocksdb_compact_range_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                       const char* start_key, size_t start_key_len,
+                                       const char* end_key, size_t end_key_len);
+
+// Manual compaction options; a NULL handle means the defaults (not
+// exclusive, bottommost level only with a compaction filter)
+RocksDBCompactRangeOptionsRef rocksdb_compact_range_options_create(void);
+void rocksdb_compact_range_options_destroy(RocksDBCompactRangeOptionsRef opts);
+void rocksdb_compact_range_options_set_exclusive_manual_compaction(RocksDBCompactRangeOptionsRef opts, int value);
+// 0 uses the database's max_subcompactions
+void rocksdb_compact_range_options_set_max_subcompactions(RocksDBCompactRangeOptionsRef opts, uint32_t value);
+void rocksdb_compact_range_options_set_bottommost_level_compaction(RocksDBCompactRangeOptionsRef opts, int value);
+// Move the compacted files to target_level (-1 for the lowest level that fits)
+void rocksdb_compact_range_options_set_change_level(RocksDBCompactRangeOptionsRef opts, int value);
+void rocksdb_compact_range_options_set_target_level(RocksDBCompactRangeOptionsRef opts, int level);
+void rocksdb_compact_range_options_set_allow_write_stall(RocksDBCompactRangeOptionsRef opts, int value);
+// Compactions using these options stop once flag is raised; the flag must
+// outlive the options
+void rocksdb_compact_range_options_set_canceled(RocksDBCompactRangeOptionsRef opts, RocksDBCancelFlagRef flag);
+
+// Thread-safe boolean shared between a running call and whoever cancels it
+RocksDBCancelFlagRef rocksdb_cancel_flag_create(void);
+void rocksdb_cancel_flag_destroy(RocksDBCancelFlagRef flag);
+void rocksdb_cancel_flag_set(RocksDBCancelFlagRef flag, int value);
+int rocksdb_cancel_flag_get(RocksDBCancelFlagRef flag);
+
+// A canceled compaction returns RocksDBStatusIncomplete
+RocksDBStatus rocksdb_compact_range_opt_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                           RocksDBCompactRangeOptionsRef opts,
+                                           const char* start_key, size_t start_key_len,
+                                           const char* end_key, size_t end_key_len);
+
+// CompactFiles options; a NULL handle means the defaults (the output level's
+// compression, one output file, the database's max_subcompactions)
+RocksDBCompactionOptionsRef rocksdb_compaction_options_create(void);
+void rocksdb_compaction_options_destroy(RocksDBCompactionOptionsRef opts);
+// -1 uses the column family's compression for the output level
+void rocksdb_compaction_options_set_compression(RocksDBCompactionOptionsRef opts, int type);
+// 0 writes a single output file
+void rocksdb_compaction_options_set_output_file_size_limit(RocksDBCompactionOptionsRef opts, uint64_t limit);
+// 0 uses the database's max_subcompactions
+void rocksdb_compaction_options_set_max_subcompactions(RocksDBCompactionOptionsRef opts, uint32_t value);
+
+// Compact exactly the named SST files (names as in RocksDBSstFileValues, or
+// full paths) into output_level, on the calling thread. The inputs must be
+// live, not being compacted, and grow with any overlapping files RocksDB
+// needs for a consistent result. output_files_out (optional) gets the full
+// paths of the files written; free with rocksdb_free_string_list.
+RocksDBStatus rocksdb_compact_files_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                       RocksDBCompactionOptionsRef opts,
+                                       const char* const* file_names, size_t num_files,
+                                       int output_level,
+                                       char*** output_files_out, size_t* output_count_out);
+
+// Drop SST files whose keys all fall inside one of the ranges, without
+// writing tombstones (keys in memtables or partially covered files stay).
+// bounds holds 2 * num_ranges entries (start, end per range); a NULL entry
+// leaves that side unbounded, so pass a non-NULL pointer for empty keys.
+RocksDBStatus rocksdb_delete_files_in_ranges(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                             size_t num_ranges,
+                                             const char* const* bounds,
+                                             const size_t* bound_lens,
+                                             int include_end);
+
 RocksDBStatus rocksdb_flush(RocksDBRef db, int wait);
+RocksDBStatus rocksdb_flush_cf(RocksDBRef db, RocksDBColumnFamilyRef cf, int wait);
+
+// Write buffered WAL data to the OS (required with manual_wal_flush); sync also fsyncs
+RocksDBStatus rocksdb_flush_wal(RocksDBRef db, int sync);
+// Fsync WAL data already written to the OS
+RocksDBStatus rocksdb_sync_wal(RocksDBRef db);
+
+// Stop all flushes and compactions (waiting for running ones) until the
+// matching continue; calls nest
+RocksDBStatus rocksdb_pause_background_work(RocksDBRef db);
+RocksDBStatus rocksdb_continue_background_work(RocksDBRef db);
+// Make running and new manual compactions return RocksDBStatusIncomplete
+// until the matching enable; calls nest
+void rocksdb_disable_manual_compaction(RocksDBRef db);
+void rocksdb_enable_manual_compaction(RocksDBRef db);
+// Toggle automatic compactions of a column family at runtime
+RocksDBStatus rocksdb_set_disable_auto_compactions_cf(RocksDBRef db, RocksDBColumnFamilyRef cf, int value);
+// Current level0_slowdown_writes_trigger of a column family (-1 if db is null)
+int rocksdb_get_level0_slowdown_writes_trigger_cf(RocksDBRef db, RocksDBColumnFamilyRef cf);
+// Change mutable column family options without reopening (DB::SetOptions);
+// names and values use the OPTIONS file format, e.g. "write_buffer_size"
+// and "67108864". Either all changes apply or none do.
+RocksDBStatus rocksdb_set_options_cf(RocksDBRef db, RocksDBColumnFamilyRef cf, size_t count,
+                                     const char* const* names, const char* const* values);
+// Change mutable DB options without reopening (DB::SetDBOptions)
+RocksDBStatus rocksdb_set_db_options(RocksDBRef db, size_t count,
+                                     const char* const* names, const char* const* values);
+// Current DB and column family options in the format of
+// rocksdb_options_get_string; free with rocksdb_free_string (NULL if db is null)
+char* rocksdb_get_options_string_cf(RocksDBRef db, RocksDBColumnFamilyRef cf);
+
+// Snapshot of a column family's write stall inputs and resulting condition
+RocksDBStatus rocksdb_get_write_stall_state_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                               RocksDBWriteStallValues* state_out);
 
 // Returns newly allocated string, caller must free with rocksdb_free_string
 char* rocksdb_get_property(RocksDBRef db, const char* property);
+char* rocksdb_get_property_cf(RocksDBRef db, RocksDBColumnFamilyRef cf, const char* property);
+
+// Numeric properties without string formatting; return 1 and set value_out
+// if the property exists and has an integer form, 0 otherwise
+int rocksdb_get_int_property_cf(RocksDBRef db, RocksDBColumnFamilyRef cf, const char* property,
+                                uint64_t* value_out);
+// Summed over all column families
+int rocksdb_get_aggregated_int_property(RocksDBRef db, const char* property, uint64_t* value_out);
+
+// Map form of a property as parallel key/value arrays in key order; returns
+// 1 on success. Free both arrays with rocksdb_free_string_list.
+int rocksdb_get_map_property_cf(RocksDBRef db, RocksDBColumnFamilyRef cf, const char* property,
+                                char*** keys_out, char*** values_out, size_t* count_out);
 
 // Approximate sizes
 void rocksdb_get_approximate_sizes(RocksDBRef db,
@@ -253,6 +2091,442 @@ void rocksdb_get_approximate_sizes(RocksDBRef db,
                                    const size_t* end_key_lens,
                                    uint64_t* sizes_out);
 
+// SizeApproximationOptions; a negative margin asks for RocksDB's exact
+// per-file estimate instead of trading precision for speed
+typedef struct {
+  int include_memtables;
+  int include_files;
+  double files_size_error_margin;
+} RocksDBSizeApproximationOptions;
+
+// Approximate bytes in each of num_ranges key ranges. bounds holds start
+// and end per range as for rocksdb_delete_files_in_ranges; NULL entries
+// resolve to the first key and just past the last key of the family.
+RocksDBStatus rocksdb_get_approximate_sizes_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                               const RocksDBSizeApproximationOptions* options,
+                                               size_t num_ranges,
+                                               const char* const* bounds,
+                                               const size_t* bound_lens,
+                                               uint64_t* sizes_out);
+
+// Approximate entry count and bytes of [start, end) in the memtables;
+// NULL bounds resolve as for rocksdb_get_approximate_sizes_cf
+RocksDBStatus rocksdb_get_approximate_memtable_stats_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                                        const char* start, size_t start_len,
+                                                        const char* end, size_t end_len,
+                                                        uint64_t* count_out, uint64_t* size_out);
+
+// Split [start, end) (NULL bounds are open-ended) into up to `partitions`
+// ranges holding roughly equal bytes of SST data, weighting the boundary
+// keys of the live files overlapping it. Returns the ascending interior
+// split keys (fewer when the data has fewer distinct boundaries); free the
+// keys with rocksdb_free_string_list and the lengths with rocksdb_free_data.
+RocksDBStatus rocksdb_split_range_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                     const char* start, size_t start_len,
+                                     const char* end, size_t end_len,
+                                     size_t partitions,
+                                     char*** keys_out, size_t** key_lens_out,
+                                     size_t* count_out);
+
+// =============================================================================
+// MARK: - SST File Metadata
+// =============================================================================
+
+// One live SST file; the strings and keys are owned by the array they are
+// returned in (see rocksdb_sst_files_destroy)
+typedef struct {
+  char* file_name;           // Relative to directory, e.g. "000012.sst"
+  char* directory;
+  char* column_family;
+  int level;
+  uint64_t file_number;
+  uint64_t size;
+  char* smallest_key;        // Smallest and largest user keys
+  size_t smallest_key_len;
+  char* largest_key;
+  size_t largest_key_len;
+  uint64_t smallest_seqno;
+  uint64_t largest_seqno;
+  uint64_t num_entries;      // Including deletions
+  uint64_t num_deletions;
+  uint64_t num_reads_sampled;
+  int being_compacted;
+  uint64_t file_creation_time;  // Seconds since the epoch, 0 if unknown
+} RocksDBSstFileValues;
+
+// Every live SST file of every column family, ordered by family name and
+// level, then by smallest key (L0: newest first)
+RocksDBStatus rocksdb_get_live_files_metadata(RocksDBRef db, RocksDBSstFileValues** files_out,
+                                              size_t* count_out);
+// SST files of one column family in the same order, plus its number of levels
+RocksDBStatus rocksdb_get_column_family_metadata(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                                 RocksDBSstFileValues** files_out, size_t* count_out,
+                                                 int* num_levels_out);
+void rocksdb_sst_files_destroy(RocksDBSstFileValues* files, size_t count);
+
+// TableProperties of one SST file; strings are owned by the array (see
+// rocksdb_table_properties_destroy)
+typedef struct {
+  char* file_path;
+  uint64_t data_size;
+  uint64_t index_size;
+  uint64_t filter_size;
+  uint64_t raw_key_size;
+  uint64_t raw_value_size;
+  uint64_t num_data_blocks;
+  uint64_t num_entries;
+  uint64_t num_deletions;
+  uint64_t num_merge_operands;
+  uint64_t num_range_deletions;
+  uint64_t creation_time;
+  uint64_t oldest_key_time;
+  char* compression_name;
+} RocksDBTablePropertiesValues;
+
+// Properties of the SST files overlapping any of num_ranges ranges, in file
+// path order; bounds are laid out as for rocksdb_get_approximate_sizes_cf
+RocksDBStatus rocksdb_get_properties_of_tables_in_range_cf(RocksDBRef db, RocksDBColumnFamilyRef cf,
+                                                           size_t num_ranges,
+                                                           const char* const* bounds,
+                                                           const size_t* bound_lens,
+                                                           RocksDBTablePropertiesValues** tables_out,
+                                                           size_t* count_out);
+void rocksdb_table_properties_destroy(RocksDBTablePropertiesValues* tables, size_t count);
+
+// =============================================================================
+// MARK: - Memory Usage
+// =============================================================================
+
+// Approximate memory of the given databases (all their column families)
+// and caches. The block caches of the databases are included, and a cache
+// shared by several databases or also listed in caches is counted once.
+RocksDBStatus rocksdb_approximate_memory_usage(const RocksDBRef* dbs, size_t num_dbs,
+                                               const RocksDBCacheRef* caches, size_t num_caches,
+                                               RocksDBMemoryUsageValues* usage_out);
+
+// =============================================================================
+// MARK: - Statistics
+// =============================================================================
+
+// Ticker and histogram ids are indices into the name tables of the linked
+// RocksDB build; look them up by name rather than hardcoding them. Returned
+// names are static strings.
+uint32_t rocksdb_statistics_ticker_count(void);
+const char* rocksdb_statistics_ticker_name(uint32_t ticker);
+uint32_t rocksdb_statistics_histogram_count(void);
+const char* rocksdb_statistics_histogram_name(uint32_t histogram);
+
+// All return 0 when the database was opened without statistics
+int rocksdb_statistics_enabled(RocksDBRef db);
+uint64_t rocksdb_statistics_get_ticker(RocksDBRef db, uint32_t ticker);
+// Fills values_out with up to capacity tickers, indexed by id; returns the
+// number written
+size_t rocksdb_statistics_get_all_tickers(RocksDBRef db, uint64_t* values_out, size_t capacity);
+int rocksdb_statistics_get_histogram(RocksDBRef db, uint32_t histogram, RocksDBHistogramValues* data_out);
+// Level is a RocksDBStatsLevelCode; get returns -1 without statistics
+void rocksdb_statistics_set_level(RocksDBRef db, int level);
+int rocksdb_statistics_get_level(RocksDBRef db);
+RocksDBStatus rocksdb_statistics_reset(RocksDBRef db);
+
+// =============================================================================
+// MARK: - Perf Context
+// =============================================================================
+
+// PerfContext and IOStatsContext are per thread: these calls configure,
+// read and clear the counters of the calling thread only.
+void rocksdb_set_perf_level(int level);
+int rocksdb_get_perf_level(void);
+void rocksdb_perf_context_reset(void);
+void rocksdb_perf_context_snapshot(RocksDBPerfContextValues* values_out);
+
+// =============================================================================
+// MARK: - Event Listener
+// =============================================================================
+
+// Listener that records flush, compaction, stall and background error
+// events into a lock-free ring of capacity slots (rounded up to a power of
+// two). Background threads never wait: events arriving while the ring is
+// full are counted as dropped. Attach with rocksdb_options_add_event_listener
+// before opening; the options and database keep the listener alive.
+RocksDBEventListenerRef rocksdb_event_listener_create(size_t capacity);
+void rocksdb_event_listener_destroy(RocksDBEventListenerRef listener);
+void rocksdb_options_add_event_listener(RocksDBOptionsRef opts, RocksDBEventListenerRef listener);
+// Move up to max_events pending events into events_out, oldest first;
+// returns the number written. Safe to call from any thread.
+size_t rocksdb_event_listener_poll(RocksDBEventListenerRef listener, RocksDBEventRecord* events_out,
+                                   size_t max_events);
+uint64_t rocksdb_event_listener_dropped(RocksDBEventListenerRef listener);
+
+// =============================================================================
+// MARK: - Block Cache Tracing
+// =============================================================================
+
+// Record one in sampling_frequency block cache accesses to path until
+// rocksdb_end_block_cache_trace; records past max_trace_size bytes are dropped
+RocksDBStatus rocksdb_start_block_cache_trace(RocksDBRef db, const char* path,
+                                              uint64_t sampling_frequency, uint64_t max_trace_size);
+RocksDBStatus rocksdb_end_block_cache_trace(RocksDBRef db);
+
+// =============================================================================
+// MARK: - Query Tracing
+// =============================================================================
+
+// Record one in sampling_frequency Get, MultiGet, Write and iterator seek
+// calls to path until rocksdb_end_trace; filter is a RocksDBQueryTraceFilter mask
+RocksDBStatus rocksdb_start_trace(RocksDBRef db, const char* path,
+                                  uint64_t sampling_frequency, uint64_t max_trace_size,
+                                  uint64_t filter, int preserve_write_order);
+RocksDBStatus rocksdb_end_trace(RocksDBRef db);
+// Execute a recorded trace against db on threads threads, with the recorded
+// gaps between operations divided by speedup; replays resolve column
+// families by ID, so db should be a copy of the traced database
+RocksDBStatus rocksdb_replay_trace(RocksDBRef db, const char* path, uint32_t threads, double speedup,
+                                   RocksDBReplayValues* values_out);
+
+// =============================================================================
+// MARK: - Call Tracing
+// =============================================================================
+
+// Runtime switch for call tracing, off by default; when off each traced call
+// costs one relaxed atomic load. Building with ROCKSDB_BRIDGE_DISABLE_TRACING
+// compiles the instrumentation out and makes enabling a no-op.
+void rocksdb_trace_set_enabled(int enabled);
+int rocksdb_trace_enabled(void);
+// Record a duration measured outside the bridge (the Swift layer) for op
+void rocksdb_trace_record(int op, int layer, uint64_t nanos);
+// Totals for op and layer over all threads since the last reset;
+// buckets_out receives ROCKSDB_TRACE_BUCKETS counts (may be NULL)
+void rocksdb_trace_get(int op, int layer, uint64_t* calls_out, uint64_t* nanos_out,
+                       uint64_t* buckets_out);
+void rocksdb_trace_reset(void);
+
+// =============================================================================
+// MARK: - Options Files
+// =============================================================================
+
+// Load the newest OPTIONS file of the database at path. db_opts_out gets the
+// DB options together with the default family's options; families_out gets
+// one handle per column family in file order, named by names_out. Free each
+// handle with rocksdb_options_destroy, the handle array with
+// rocksdb_free_data and the names with rocksdb_free_string_list. Custom
+// objects (comparators, merge operators, filters) are restored only when
+// RocksDB knows them by name.
+RocksDBStatus rocksdb_load_latest_options(const char* path, RocksDBOptionsRef* db_opts_out,
+                                          char*** names_out, RocksDBOptionsRef** families_out,
+                                          size_t* count_out);
+// Same as rocksdb_load_latest_options for a specific OPTIONS file
+RocksDBStatus rocksdb_load_options_from_file(const char* file, RocksDBOptionsRef* db_opts_out,
+                                             char*** names_out, RocksDBOptionsRef** families_out,
+                                             size_t* count_out);
+// Path of the newest OPTIONS file the database at path has written;
+// free with rocksdb_free_string
+RocksDBStatus rocksdb_get_latest_options_file(const char* path, char** file_out);
+
+// New options handle with "key=value;..." settings applied on top of base
+// (DB and column family options; table options nest as
+// "block_based_table_factory={block_size=16384}")
+RocksDBStatus rocksdb_options_create_from_string(RocksDBOptionsRef base, const char* opts_str,
+                                                 RocksDBOptionsRef* opts_out);
+// All DB and column family options in the format read by
+// rocksdb_options_create_from_string; free with rocksdb_free_string
+char* rocksdb_options_get_string(RocksDBOptionsRef opts);
+
+// =============================================================================
+// MARK: - Change Data Capture
+// =============================================================================
+
+// Sequence number of the most recent write
+uint64_t rocksdb_latest_sequence_number(RocksDBRef db);
+
+// Iterate the write batches in the WAL starting with the one that contains
+// `sequence`. Older WALs must still be retained (see
+// rocksdb_options_set_wal_ttl_seconds); the iterator retains the database.
+RocksDBStatus rocksdb_get_updates_since(RocksDBRef db, uint64_t sequence,
+                                        int verify_checksums,
+                                        RocksDBWalIteratorRef* iter_out);
+void rocksdb_wal_iterator_destroy(RocksDBWalIteratorRef iter);
+int rocksdb_wal_iterator_valid(RocksDBWalIteratorRef iter);
+void rocksdb_wal_iterator_next(RocksDBWalIteratorRef iter);
+// OK at the end of the retained WAL; an error such as a sequence gap means
+// the follower has to re-sync from a checkpoint or backup
+RocksDBStatus rocksdb_wal_iterator_status(RocksDBWalIteratorRef iter);
+
+// Current batch in its serialized WriteBatch form, with the sequence number
+// of its first operation and its operation count. Do NOT free; valid until
+// the iterator moves or is destroyed. NULL if the iterator is not valid.
+const char* rocksdb_wal_iterator_batch(RocksDBWalIteratorRef iter,
+                                       uint64_t* sequence_out, size_t* count_out,
+                                       size_t* len_out);
+
+// Decode the current batch into records laid out as
+//   [uint8 type][uint32 column family id][uint32 key_len][uint32 value_len]
+//   [key bytes][value bytes]
+// in native byte order, unaligned; types are RocksDBWalRecordType. The
+// buffer has the lifetime of rocksdb_wal_iterator_batch's.
+RocksDBStatus rocksdb_wal_iterator_decode(RocksDBWalIteratorRef iter,
+                                          const char** records_out, size_t* len_out,
+                                          size_t* count_out);
+
+// =============================================================================
+// MARK: - Checkpoints
+// =============================================================================
+
+// Openable copy of the database in dir, which must not exist yet. SST and
+// blob files are hard-linked when dir is on the same filesystem. Memtables
+// are flushed first unless the live WAL is smaller than log_size_for_flush,
+// in which case the WAL is copied instead. sequence_out (optional) gets a
+// sequence number contained in the checkpoint.
+RocksDBStatus rocksdb_create_checkpoint(RocksDBRef db, const char* dir, uint64_t log_size_for_flush,
+                                        uint64_t* sequence_out);
+// Flush the family and link its live SST files into dir, which must not
+// exist yet; metadata_out describes the files for
+// rocksdb_create_column_family_with_import
+RocksDBStatus rocksdb_export_column_family(RocksDBRef db, RocksDBColumnFamilyRef cf, const char* dir,
+                                           RocksDBExportMetadataRef* metadata_out);
+void rocksdb_export_metadata_destroy(RocksDBExportMetadataRef metadata);
+size_t rocksdb_export_metadata_file_count(RocksDBExportMetadataRef metadata);
+// Comparator name the files were written with; free with rocksdb_free_string
+char* rocksdb_export_metadata_comparator(RocksDBExportMetadataRef metadata);
+// Create a column family holding the exported files, copying them (or
+// moving them if move_files) into the database
+RocksDBStatus rocksdb_create_column_family_with_import(RocksDBRef db, RocksDBOptionsRef opts,
+                                                       const char* name, int move_files,
+                                                       RocksDBExportMetadataRef metadata,
+                                                       RocksDBColumnFamilyRef* cf_out);
+
+// =============================================================================
+// MARK: - Backups
+// =============================================================================
+
+// Open (or create) the backup directory dir; options must match those
+// previous engines used for dir
+RocksDBStatus rocksdb_backup_engine_open(const char* dir, const RocksDBBackupEngineValues* options,
+                                         RocksDBBackupEngineRef* engine_out);
+void rocksdb_backup_engine_close(RocksDBBackupEngineRef engine);
+// Back up db, copying only files the directory doesn't hold yet when table
+// files are shared. app_metadata may be NULL; id_out (optional) gets the new
+// backup's id.
+RocksDBStatus rocksdb_backup_engine_create_new_backup(RocksDBBackupEngineRef engine, RocksDBRef db,
+                                                      int flush_before_backup,
+                                                      const char* app_metadata,
+                                                      uint32_t* id_out);
+// Ask a running backup on another thread to stop; it returns Incomplete
+void rocksdb_backup_engine_stop_backup(RocksDBBackupEngineRef engine);
+RocksDBStatus rocksdb_backup_engine_purge_old_backups(RocksDBBackupEngineRef engine, uint32_t num_to_keep);
+RocksDBStatus rocksdb_backup_engine_delete_backup(RocksDBBackupEngineRef engine, uint32_t backup_id);
+// Delete files left behind by interrupted backups and deletions
+RocksDBStatus rocksdb_backup_engine_garbage_collect(RocksDBBackupEngineRef engine);
+RocksDBStatus rocksdb_backup_engine_verify_backup(RocksDBBackupEngineRef engine, uint32_t backup_id,
+                                                  int verify_with_checksum);
+// Valid backups, oldest first; free infos_out with rocksdb_free_data
+void rocksdb_backup_engine_get_backup_info(RocksDBBackupEngineRef engine,
+                                           RocksDBBackupInfoValues** infos_out, size_t* count_out);
+// Application metadata stored with a backup; free with rocksdb_free_string
+RocksDBStatus rocksdb_backup_engine_get_backup_metadata(RocksDBBackupEngineRef engine, uint32_t backup_id,
+                                                        char** metadata_out);
+// Restore a backup (backup_id 0 for the latest valid one) into db_dir, with
+// WAL files in wal_dir (NULL for db_dir). The database must be closed.
+RocksDBStatus rocksdb_backup_engine_restore(RocksDBBackupEngineRef engine, uint32_t backup_id,
+                                            const char* db_dir, const char* wal_dir,
+                                            int keep_log_files);
+
+// =============================================================================
+// MARK: - Environment
+// =============================================================================
+
+// Snapshot of the default Env's threads; free with rocksdb_free_data.
+// Operations are only reported for databases opened with thread tracking.
+RocksDBStatus rocksdb_env_get_thread_list(RocksDBThreadStatusValues** threads_out, size_t* count_out);
+// Static names for ThreadStatus enum values ("" when out of range)
+const char* rocksdb_thread_operation_name(int operation_type);
+const char* rocksdb_thread_stage_name(int operation_stage);
+
+// Background thread pools of the default Env, shared by every database in
+// the process. pool is a RocksDBThreadPoolCode value.
+void rocksdb_env_set_background_threads(int pool, int num_threads);
+int rocksdb_env_get_background_threads(int pool);
+// Lower the CPU (RocksDBCpuPriority) or I/O scheduling priority of a pool's
+// threads; priorities can only be lowered, and not all platforms support it
+RocksDBStatus rocksdb_env_lower_thread_pool_cpu_priority(int pool, int cpu_priority);
+void rocksdb_env_lower_thread_pool_io_priority(int pool);
+
+// =============================================================================
+// MARK: - Remote Compaction
+// =============================================================================
+
+// CompactionService: the primary hands each compaction to a scheduler,
+// which runs it elsewhere through rocksdb_open_and_compact and hands back
+// the result. Callbacks run on compaction threads and must not unwind into
+// the bridge.
+typedef enum {
+  RocksDBCompactionJobSuccess = 0,
+  RocksDBCompactionJobFailure = 1,
+  RocksDBCompactionJobUseLocal = 2
+} RocksDBCompactionJobStatusCode;
+
+typedef struct {
+  const char* db_name;
+  const char* db_id;
+  const char* db_session_id;
+  // Unique within the database session only
+  uint64_t job_id;
+  int priority;  // RocksDBThreadPoolCode
+  int compaction_reason;  // RocksDB CompactionReason value
+  int is_full_compaction;
+  int is_manual_compaction;
+  int bottommost_level;
+} RocksDBCompactionJobInfo;
+
+// Start a job for input, the serialized compaction to pass to the worker.
+// Returns a RocksDBCompactionJobStatusCode; on success *job_id_out is a
+// malloc'd NUL-terminated id the bridge frees, passed back to wait.
+typedef int (*RocksDBCompactionScheduleFn)(void* context, const RocksDBCompactionJobInfo* info,
+                                           const char* input, size_t input_len,
+                                           char** job_id_out);
+// Block until the job finishes. On success *result_out is the worker's
+// malloc'd output (see rocksdb_open_and_compact), freed by the bridge.
+typedef int (*RocksDBCompactionWaitFn)(void* context, const char* job_id,
+                                       char** result_out, size_t* result_len_out);
+// Job outputs were installed into the primary (or failed to be)
+typedef void (*RocksDBCompactionInstalledFn)(void* context, const char* job_id, int status);
+// The service is no longer referenced by any options or database
+typedef void (*RocksDBCompactionServiceDestroyFn)(void* context);
+
+// Install a compaction service; installed and destroy may be NULL
+void rocksdb_options_set_compaction_service(RocksDBOptionsRef opts, const char* name, void* context,
+                                            RocksDBCompactionScheduleFn schedule,
+                                            RocksDBCompactionWaitFn wait,
+                                            RocksDBCompactionInstalledFn installed,
+                                            RocksDBCompactionServiceDestroyFn destroy);
+
+// Worker side: open the primary at name read-only, run the compaction
+// described by input and write its files to output_directory, which the
+// primary must be able to read. The comparator, merge operator, compaction
+// filter, prefix extractor, table format and listeners come from opts and
+// must match the primary's. *output_out (malloc'd, free with
+// rocksdb_free_data) is the result for the primary's wait callback.
+// canceled may be NULL; a canceled job returns RocksDBStatusIncomplete.
+RocksDBStatus rocksdb_open_and_compact(const char* name, const char* output_directory,
+                                       const char* input, size_t input_len,
+                                       RocksDBOptionsRef opts, RocksDBCancelFlagRef canceled,
+                                       char** output_out, size_t* output_len_out);
+
+// =============================================================================
+// MARK: - I/O Thread Pool
+// =============================================================================
+
+// Bridge-owned threads that run blocking database calls for async callers,
+// so callers never block their own threads on disk I/O. Jobs run in
+// submission order as threads free up; job must not be NULL.
+typedef void (*RocksDBIOJob)(void* context);
+
+void rocksdb_io_pool_submit(RocksDBIOJob job, void* context);
+// Resize the pool (default: 8 threads); queued jobs are kept
+void rocksdb_io_pool_set_threads(int num_threads);
+int rocksdb_io_pool_get_threads(void);
+// Jobs waiting for a thread
+unsigned int rocksdb_io_pool_queue_length(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,48 @@
+//
+//  RocksDBMicrobench.h
+//  RocksDB.swift
+//
+//  Internal hooks for the rocksdb-microbench target; not part of the public
+//  bridge and available only through the CRocksDB.Microbench submodule
+//
+
+#ifndef RocksDBMicrobench_h
+#define RocksDBMicrobench_h
+
+#include "RocksDBBridge.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// =============================================================================
+// MARK: - Microbenchmark Types
+// =============================================================================
+
+// Operations rocksdb_microbench_raw runs directly against rocksdb::DB
+typedef enum {
+  RocksDBMicrobenchPut = 0,
+  RocksDBMicrobenchGet = 1,
+  RocksDBMicrobenchNext = 2,
+  RocksDBMicrobenchBatchAppend = 3
+} RocksDBMicrobenchOp;
+
+// =============================================================================
+// MARK: - Microbenchmarks
+// =============================================================================
+
+// Baseline for bridge overhead: run op iterations times straight against the
+// rocksdb::DB inside db, with no per-call status or handle conversion, and
+// store the elapsed wall time. keys holds key_count keys of key_len bytes
+// each, used round robin; Next wraps to the first key at the end, and
+// BatchAppend clears its batch every key_count appends.
+RocksDBStatus rocksdb_microbench_raw(RocksDBRef db, RocksDBColumnFamilyRef cf, int op,
+                                     const char* keys, size_t key_len, size_t key_count,
+                                     const char* value, size_t value_len,
+                                     uint64_t iterations, uint64_t* nanos_out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RocksDBMicrobench_h */
@@ -0,0 +1,26 @@
+//
+//  Allocator.swift
+//  RocksDBBench
+//
+//  malloc implementation serving the process, for comparing allocators
+//
+
+import Foundation
+
+enum Allocator {
+  /// Name of the allocator: jemalloc when linked in with `ROCKSDB_JEMALLOC=1`,
+  /// otherwise found from a symbol only a preloaded allocator exports
+  static var current: String {
+    #if ROCKSDB_JEMALLOC
+    return "jemalloc"
+    #else
+    let probes = [("mallctl", "jemalloc"), ("tc_malloc", "tcmalloc"), ("mi_malloc", "mimalloc")]
+    let process = dlopen(nil, RTLD_NOW)
+    defer { if let process { dlclose(process) } }
+    for (symbol, name) in probes where dlsym(process, symbol) != nil {
+      return name
+    }
+    return "system"
+    #endif
+  }
+}
@@ -0,0 +1,188 @@
+//
+//  BenchmarkConfig.swift
+//  RocksDBBench
+//
+//  Command-line settings of a benchmark run
+//
+
+import Foundation
+import RocksDBSwift
+
+/// Workloads, modelled on db_bench's benchmarks of the same names
+enum Workload: String, CaseIterable {
+  /// Write `num` keys in ascending order
+  case fillseq
+  /// Write `num` keys in random order
+  case fillrandom
+  /// Point lookups of random existing keys
+  case readrandom
+  /// `readrandom` on every thread while one extra thread keeps writing
+  case readwhilewriting
+  /// Seek to a random key and read `scanLength` entries
+  case seekrandom
+  /// Batched lookups of `batchSize` random keys per call
+  case multireadrandom
+  /// One full scan of the database per thread
+  case scan
+
+  /// Whether the workload needs the database filled first
+  var needsData: Bool {
+    self != .fillseq && self != .fillrandom
+  }
+}
+
+/// Wrapper a run goes through
+enum Wrapper: String, CaseIterable {
+  case swift
+  case lite
+}
+
+/// Option sets for the full wrapper; RocksDBSwiftLite always opens with defaults
+enum Preset: String, CaseIterable {
+  case `default`
+  case pointLookup
+  case bulkLoad
+  case nvmeReadHeavy
+  case nvmeWriteHeavy
+  case memoryConstrained
+  case largeValues
+  case timeSeries
+  case autoTune
+
+  var options: RocksDBOptions {
+    switch self {
+    case .default: return .default
+    case .pointLookup: return .pointLookup()
+    case .bulkLoad: return .bulkLoad
+    case .nvmeReadHeavy: return .nvmeReadHeavy
+    case .nvmeWriteHeavy: return .nvmeWriteHeavy
+    case .memoryConstrained: return .memoryConstrained(budget: 64 * 1024 * 1024)
+    case .largeValues: return .largeValues
+    case .timeSeries: return .timeSeries
+    case .autoTune: return .autoTune()
+    }
+  }
+}
+
+/// SST format for the full wrapper, to compare lookups on flushed data
+enum TableFormat: String, CaseIterable {
+  case blockBased
+  /// PlainTable hashing whole fixed-length keys
+  case plain
+  case cuckoo
+}
+
+struct BenchmarkConfig {
+  var workloads: [Workload] = [.fillseq, .readrandom]
+  var wrappers: [Wrapper] = Wrapper.allCases
+  var preset: Preset = .default
+  var tableFormat: TableFormat = .blockBased
+  /// Flush after filling so reads are served from table files, not the memtable
+  var flushAfterFill = false
+  var path = (NSTemporaryDirectory() as NSString).appendingPathComponent("rocksdb-bench")
+  var num = 100_000
+  var reads: Int?
+  var threads = 1
+  var keySize = 16
+  var valueSize = 100
+  var batchSize = 32
+  var scanLength = 100
+  var seed: UInt64 = 301
+
+  /// Options for the full wrapper: the preset with the table format applied
+  var options: RocksDBOptions {
+    var options = preset.options
+    switch tableFormat {
+    case .blockBased:
+      break
+    case .plain:
+      var plain = RocksDBPlainTableOptions()
+      plain.userKeyLength = keySize
+      options.tableFormat = .plain(plain)
+      options.prefixExtractor = .fixed(keySize)
+    case .cuckoo:
+      options.tableFormat = .cuckoo(RocksDBCuckooTableOptions())
+    }
+    return options
+  }
+
+  /// Operations each reading thread performs
+  var readsPerThread: Int {
+    max((reads ?? num) / max(threads, 1), 1)
+  }
+
+  static let usage = """
+    usage: rocksdb-bench [--benchmarks=fillseq,readrandom,...] [--wrapper=swift|lite|both]
+                         [--preset=NAME] [--table_format=blockBased|plain|cuckoo]
+                         [--flush=0|1] [--db=PATH] [--num=N]
+                         [--reads=N] [--threads=N] [--key_size=N] [--value_size=N]
+                         [--batch_size=N] [--scan_length=N] [--seed=N]
+    workloads: \(Workload.allCases.map(\.rawValue).joined(separator: ", "))
+    presets: \(Preset.allCases.map(\.rawValue).joined(separator: ", "))
+    """
+
+  /// Parse `--name=value` arguments
+  init(arguments: [String]) throws {
+    for argument in arguments {
+      let parts = argument.split(separator: "=", maxSplits: 1).map(String.init)
+      guard parts.count == 2, parts[0].hasPrefix("--") else {
+        throw ConfigError("Unrecognized argument \(argument)")
+      }
+      let value = parts[1]
+      switch parts[0] {
+      case "--benchmarks":
+        workloads = try value.split(separator: ",").map { name in
+          guard let workload = Workload(rawValue: String(name)) else {
+            throw ConfigError("Unknown benchmark \(name)")
+          }
+          return workload
+        }
+      case "--wrapper":
+        if value == "both" {
+          wrappers = Wrapper.allCases
+        } else if let wrapper = Wrapper(rawValue: value) {
+          wrappers = [wrapper]
+        } else {
+          throw ConfigError("Unknown wrapper \(value)")
+        }
+      case "--preset":
+        guard let preset = Preset(rawValue: value) else {
+          throw ConfigError("Unknown preset \(value)")
+        }
+        self.preset = preset
+      case "--table_format":
+        guard let format = TableFormat(rawValue: value) else {
+          throw ConfigError("Unknown table format \(value)")
+        }
+        tableFormat = format
+      case "--flush": flushAfterFill = value != "0"
+      case "--db": path = value
+      case "--num": num = try Self.integer(value, parts[0])
+      case "--reads": reads = try Self.integer(value, parts[0])
+      case "--threads": threads = try Self.integer(value, parts[0])
+      case "--key_size": keySize = try Self.integer(value, parts[0])
+      case "--value_size": valueSize = try Self.integer(value, parts[0])
+      case "--batch_size": batchSize = try Self.integer(value, parts[0])
+      case "--scan_length": scanLength = try Self.integer(value, parts[0])
+      case "--seed": seed = UInt64(try Self.integer(value, parts[0]))
+      default:
+        throw ConfigError("Unknown option \(parts[0])")
+      }
+    }
+  }
+
+  private static func integer(_ value: String, _ name: String) throws -> Int {
+    guard let number = Int(value), number > 0 else {
+      throw ConfigError("\(name) needs a positive integer")
+    }
+    return number
+  }
+}
+
+struct ConfigError: Error, CustomStringConvertible {
+  let description: String
+
+  init(_ description: String) {
+    self.description = description
+  }
+}
@@ -0,0 +1,298 @@
+//
+//  BenchmarkRunner.swift
+//  RocksDBBench
+//
+//  Workload execution and latency reporting
+//
+
+import Foundation
+
+/// Result of one workload through one wrapper
+struct BenchmarkReport {
+  let workload: Workload
+  let wrapper: Wrapper
+  let operations: Int
+  let seconds: Double
+  /// Sorted per-operation latencies in nanoseconds
+  let latencies: [UInt64]
+  let note: String?
+
+  var opsPerSecond: Double {
+    seconds > 0 ? Double(operations) / seconds : 0
+  }
+
+  /// Latency at a percentile in [0, 100], in microseconds
+  func percentile(_ p: Double) -> Double {
+    guard !latencies.isEmpty else { return 0 }
+    let rank = Int((p / 100 * Double(latencies.count)).rounded(.up)) - 1
+    return Double(latencies[min(max(rank, 0), latencies.count - 1)]) / 1_000
+  }
+
+  var line: String {
+    let name = "\(workload.rawValue) [\(wrapper.rawValue)]".padding(toLength: 28, withPad: " ", startingAt: 0)
+    if let note {
+      return "\(name) : skipped (\(note))"
+    }
+    return String(
+      format: "%@ : %12.0f ops/sec  p50 %8.2f us  p99 %8.2f us  p99.9 %8.2f us  (%d ops, %.3f s)",
+      name, opsPerSecond, percentile(50), percentile(99), percentile(99.9), operations, seconds)
+  }
+}
+
+/// Runs workloads against one open store
+final class BenchmarkRunner: @unchecked Sendable {
+  private let config: BenchmarkConfig
+  private let store: BenchmarkStore
+  private let wrapper: Wrapper
+  private let value: Data
+  /// Keys known to be present, for read workloads
+  private var loadedKeys = 0
+
+  init(config: BenchmarkConfig, store: BenchmarkStore, wrapper: Wrapper) {
+    self.config = config
+    self.store = store
+    self.wrapper = wrapper
+    value = Data((0..<config.valueSize).map { UInt8(truncatingIfNeeded: $0 &* 31 &+ 7) })
+  }
+
+  func run(_ workload: Workload) throws -> BenchmarkReport {
+    if workload.needsData && loadedKeys == 0 {
+      _ = try fill(sequential: true)
+    }
+
+    switch workload {
+    case .fillseq:
+      return try fill(sequential: true)
+    case .fillrandom:
+      return try fill(sequential: false)
+    case .readrandom:
+      return try measure(workload, threads: config.threads, operations: config.readsPerThread) { rng in
+        _ = try self.store.get(self.key(rng.next(below: self.loadedKeys)))
+      }
+    case .readwhilewriting:
+      return try readWhileWriting()
+    case .seekrandom:
+      guard store.supportsIteration else { return skipped(workload, "no iterators") }
+      return try measure(workload, threads: config.threads, operations: config.readsPerThread) { rng in
+        _ = try self.store.seek(to: self.key(rng.next(below: self.loadedKeys)), count: self.config.scanLength)
+      }
+    case .multireadrandom:
+      guard store.supportsMultiGet else { return skipped(workload, "no multiGet") }
+      let calls = max(config.readsPerThread / config.batchSize, 1)
+      let report = try measure(workload, threads: config.threads, operations: calls) { rng in
+        let keys = (0..<self.config.batchSize).map { _ in self.key(rng.next(below: self.loadedKeys)) }
+        _ = try self.store.multiGet(keys)
+      }
+      // Latencies stay per call; throughput is reported in keys
+      return BenchmarkReport(
+        workload: workload, wrapper: wrapper, operations: report.operations * config.batchSize,
+        seconds: report.seconds, latencies: report.latencies, note: nil)
+    case .scan:
+      guard store.supportsIteration else { return skipped(workload, "no iterators") }
+      let counter = EntryCounter()
+      let report = try measure(workload, threads: config.threads, operations: 1) { _ in
+        counter.add(try self.store.scan())
+      }
+      return BenchmarkReport(
+        workload: workload, wrapper: wrapper, operations: counter.total,
+        seconds: report.seconds, latencies: report.latencies, note: nil)
+    }
+  }
+
+  // MARK: - Workloads
+
+  private func fill(sequential: Bool) throws -> BenchmarkReport {
+    let total = config.num
+    let perThread = max(total / config.threads, 1)
+    let report = try measure(
+      sequential ? .fillseq : .fillrandom,
+      threads: sequential ? 1 : config.threads,
+      operations: sequential ? total : perThread
+    ) { rng in
+      let index = sequential ? rng.sequence() : rng.next(below: total)
+      try self.store.put(self.value, forKey: self.key(index))
+    }
+    loadedKeys = max(loadedKeys, total)
+    // Outside the timed loop: only the reads that follow should see it
+    if config.flushAfterFill {
+      try store.flush()
+    }
+    return report
+  }
+
+  private func readWhileWriting() throws -> BenchmarkReport {
+    let writer = BackgroundWriter()
+    let keyCount = loadedKeys
+    Thread {
+      var rng = BenchmarkRandom(seed: self.config.seed &+ 0xffff)
+      defer { writer.finished.signal() }
+      while !writer.isStopped {
+        do {
+          try self.store.put(self.value, forKey: self.key(rng.next(below: keyCount)))
+        } catch {
+          writer.fail(error)
+          return
+        }
+      }
+    }.start()
+
+    let report: BenchmarkReport
+    do {
+      report = try measure(.readwhilewriting, threads: config.threads, operations: config.readsPerThread) { rng in
+        _ = try self.store.get(self.key(rng.next(below: keyCount)))
+      }
+    } catch {
+      writer.stop()
+      throw error
+    }
+    writer.stop()
+    try writer.checkError()
+    return report
+  }
+
+  private func skipped(_ workload: Workload, _ reason: String) -> BenchmarkReport {
+    BenchmarkReport(workload: workload, wrapper: wrapper, operations: 0, seconds: 0, latencies: [], note: reason)
+  }
+
+  // MARK: - Measurement
+
+  /// Run `body` `operations` times on each of `threads` threads, timing every call
+  private func measure(
+    _ workload: Workload,
+    threads: Int,
+    operations: Int,
+    _ body: @escaping (inout BenchmarkRandom) throws -> Void
+  ) throws -> BenchmarkReport {
+    let results = LatencyCollector(threads: threads)
+    let seed = config.seed
+    let start = DispatchTime.now().uptimeNanoseconds
+    DispatchQueue.concurrentPerform(iterations: threads) { thread in
+      var rng = BenchmarkRandom(seed: seed &+ UInt64(thread), stride: threads, offset: thread)
+      var latencies = [UInt64]()
+      latencies.reserveCapacity(operations)
+      do {
+        for _ in 0..<operations {
+          let opStart = DispatchTime.now().uptimeNanoseconds
+          try body(&rng)
+          latencies.append(DispatchTime.now().uptimeNanoseconds - opStart)
+        }
+      } catch {
+        results.fail(error)
+      }
+      results.store(latencies, thread: thread)
+    }
+    let elapsed = Double(DispatchTime.now().uptimeNanoseconds - start) / 1_000_000_000
+
+    let latencies = try results.merged()
+    return BenchmarkReport(
+      workload: workload, wrapper: wrapper, operations: latencies.count,
+      seconds: elapsed, latencies: latencies, note: nil)
+  }
+
+  /// Fixed-width key for an index: zero-padded decimal, truncated or padded to `keySize`
+  private func key(_ index: Int) -> Data {
+    var digits = Array(String(index).utf8)
+    if digits.count < config.keySize {
+      digits.insert(contentsOf: repeatElement(UInt8(ascii: "0"), count: config.keySize - digits.count), at: 0)
+    }
+    return Data(digits.suffix(config.keySize))
+  }
+}
+
+// MARK: - Internal Helpers
+
+/// xorshift64* generator; cheap enough not to show up in latencies
+struct BenchmarkRandom {
+  private var state: UInt64
+  private var cursor: Int
+  private let stride: Int
+
+  init(seed: UInt64, stride: Int = 1, offset: Int = 0) {
+    state = seed == 0 ? 0x9e37_79b9_7f4a_7c15 : seed
+    cursor = offset
+    self.stride = stride
+  }
+
+  mutating func next(below bound: Int) -> Int {
+    guard bound > 0 else { return 0 }
+    state ^= state >> 12
+    state ^= state << 25
+    state ^= state >> 27
+    return Int((state &* 0x2545_f491_4f6c_dd1d) % UInt64(bound))
+  }
+
+  /// Next index of this thread's share of an ascending sequence
+  mutating func sequence() -> Int {
+    defer { cursor += stride }
+    return cursor
+  }
+}
+
+/// Per-thread latency arrays, merged and sorted once the run ends
+private final class LatencyCollector: @unchecked Sendable {
+  private let lock = NSLock()
+  private var perThread: [[UInt64]]
+  private var firstError: Error?
+
+  init(threads: Int) {
+    perThread = Array(repeating: [], count: threads)
+  }
+
+  func store(_ latencies: [UInt64], thread: Int) {
+    lock.withLock { perThread[thread] = latencies }
+  }
+
+  func fail(_ error: Error) {
+    lock.withLock {
+      if firstError == nil { firstError = error }
+    }
+  }
+
+  func merged() throws -> [UInt64] {
+    try lock.withLock {
+      if let firstError { throw firstError }
+      return perThread.flatMap { $0 }.sorted()
+    }
+  }
+}
+
+private final class EntryCounter: @unchecked Sendable {
+  private let lock = NSLock()
+  private var count = 0
+
+  func add(_ entries: Int) {
+    lock.withLock { count += entries }
+  }
+
+  var total: Int {
+    lock.withLock { count }
+  }
+}
+
+/// Stop flag and error slot of the readwhilewriting writer thread
+private final class BackgroundWriter: @unchecked Sendable {
+  let finished = DispatchSemaphore(value: 0)
+  private let lock = NSLock()
+  private var stopped = false
+  private var error: Error?
+
+  var isStopped: Bool {
+    lock.withLock { stopped }
+  }
+
+  /// Ask the writer to stop and wait until it has
+  func stop() {
+    lock.withLock { stopped = true }
+    finished.wait()
+  }
+
+  func fail(_ error: Error) {
+    lock.withLock { self.error = error }
+  }
+
+  func checkError() throws {
+    try lock.withLock {
+      if let error { throw error }
+    }
+  }
+}
@@ -0,0 +1,120 @@
+//
+//  BenchmarkStore.swift
+//  RocksDBBench
+//
+//  Common surface of the two wrappers under test
+//
+
+import Foundation
+import RocksDBSwift
+import RocksDBSwiftLite
+
+/// Operations a workload needs; iteration and batched reads are optional
+protocol BenchmarkStore: AnyObject, Sendable {
+  var supportsIteration: Bool { get }
+  var supportsMultiGet: Bool { get }
+
+  func put(_ value: Data, forKey key: Data) throws
+  func get(_ key: Data) throws -> Data?
+  func multiGet(_ keys: [Data]) throws -> [Data?]
+  /// Seek to `key` and read up to `count` entries, returning how many were read
+  func seek(to key: Data, count: Int) throws -> Int
+  /// Read every entry, returning how many were read
+  func scan() throws -> Int
+  /// Flush memtables to table files
+  func flush() throws
+  func close()
+}
+
+final class SwiftStore: BenchmarkStore, @unchecked Sendable {
+  private let db: RocksDB
+
+  init(path: String, options: RocksDBOptions) throws {
+    db = try RocksDB.open(at: path, options: options)
+  }
+
+  var supportsIteration: Bool { true }
+  var supportsMultiGet: Bool { true }
+
+  func put(_ value: Data, forKey key: Data) throws {
+    try db.put(value, forKey: key)
+  }
+
+  func get(_ key: Data) throws -> Data? {
+    try db.get(key)
+  }
+
+  func multiGet(_ keys: [Data]) throws -> [Data?] {
+    try db.multiGet(keys)
+  }
+
+  func seek(to key: Data, count: Int) throws -> Int {
+    let iterator = try db.makeIterator()
+    defer { iterator.close() }
+    iterator.seek(to: key)
+    var read = 0
+    while read < count {
+      let batch = iterator.nextBatch(maxEntries: count - read)
+      if batch.isEmpty { break }
+      read += batch.count
+    }
+    try iterator.checkStatus()
+    return read
+  }
+
+  func scan() throws -> Int {
+    let iterator = try db.makeIterator(options: .scan)
+    defer { iterator.close() }
+    iterator.seekToFirst()
+    var read = 0
+    while true {
+      let batch = iterator.nextBatch()
+      if batch.isEmpty { break }
+      read += batch.count
+    }
+    try iterator.checkStatus()
+    return read
+  }
+
+  func flush() throws {
+    try db.flush()
+  }
+
+  func close() {
+    db.close()
+  }
+}
+
+final class LiteStore: BenchmarkStore, @unchecked Sendable {
+  private let db: RocksDBLite
+
+  init(path: String) throws {
+    db = try RocksDBLite.open(at: path)
+  }
+
+  var supportsIteration: Bool { false }
+  var supportsMultiGet: Bool { false }
+
+  func put(_ value: Data, forKey key: Data) throws {
+    try db.put(value, forKey: key)
+  }
+
+  func get(_ key: Data) throws -> Data? {
+    try db.get(key)
+  }
+
+  func multiGet(_ keys: [Data]) throws -> [Data?] {
+    try keys.map { try db.get($0) }
+  }
+
+  func seek(to key: Data, count: Int) throws -> Int { 0 }
+
+  func scan() throws -> Int { 0 }
+
+  /// RocksDBLite has no flush; its reads stay on the memtable
+  func flush() throws {}
+
+  func close() {
+    db.close()
+  }
+}
@@ -0,0 +1,53 @@
+//
+//  main.swift
+//  RocksDBBench
+//
+//  db_bench-style throughput and latency benchmark for both wrappers
+//
+//  Usage: rocksdb-bench [--benchmarks=fillseq,readrandom] [--wrapper=both] ...
+//  Each wrapper runs the listed workloads in order against a fresh database
+//  under --db; read workloads fill it first when it is still empty.
+//
+
+import Foundation
+import RocksDBSwift
+
+let config: BenchmarkConfig
+do {
+  config = try BenchmarkConfig(arguments: Array(CommandLine.arguments.dropFirst()))
+} catch {
+  print("\(error)\n\(BenchmarkConfig.usage)")
+  exit(2)
+}
+
+print("""
+  keys: \(config.num)  key size: \(config.keySize)  value size: \(config.valueSize)  \
+  threads: \(config.threads)  preset: \(config.preset.rawValue)  table: \(config.tableFormat.rawValue)
+  allocator: \(Allocator.current)
+  """)
+
+do {
+  for wrapper in config.wrappers {
+    let path = (config.path as NSString).appendingPathComponent(wrapper.rawValue)
+    let fileManager = FileManager.default
+    if fileManager.fileExists(atPath: path) {
+      try fileManager.removeItem(atPath: path)
+    }
+    try fileManager.createDirectory(atPath: config.path, withIntermediateDirectories: true)
+
+    let store: BenchmarkStore
+    switch wrapper {
+    case .swift: store = try SwiftStore(path: path, options: config.options)
+    case .lite: store = try LiteStore(path: path)
+    }
+    defer { store.close() }
+
+    let runner = BenchmarkRunner(config: config, store: store, wrapper: wrapper)
+    for workload in config.workloads {
+      print(try runner.run(workload).line)
+    }
+  }
+} catch {
+  print("benchmark failed: \(error)")
+  exit(1)
+}
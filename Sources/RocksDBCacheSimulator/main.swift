@@ -0,0 +1,84 @@
+//
+//  main.swift
+//  RocksDBCacheSimulator
+//
+//  Replay a block cache trace against candidate cache sizes and policies
+//
+//  Usage: rocksdb-cache-sim <trace> [capacity ...] [--sampling N] [--policy lru|hyperClock]
+//  Capacities accept K, M and G suffixes (default: 16M 64M 256M 1G).
+//
+
+import Foundation
+import RocksDBSwift
+
+func parseBytes(_ text: String) -> Int? {
+  let units: [Character: Int] = ["K": 1 << 10, "M": 1 << 20, "G": 1 << 30]
+  guard let last = text.uppercased().last else { return nil }
+  if let unit = units[last] {
+    return Int(text.dropLast()).map { $0 * unit }
+  }
+  return Int(text)
+}
+
+func formatBytes(_ bytes: Int) -> String {
+  for (suffix, unit) in [("G", 1 << 30), ("M", 1 << 20), ("K", 1 << 10)] where bytes >= unit {
+    return String(format: "%.1f%@", Double(bytes) / Double(unit), suffix)
+  }
+  return "\(bytes)"
+}
+
+var arguments = Array(CommandLine.arguments.dropFirst())
+guard !arguments.isEmpty else {
+  print("usage: rocksdb-cache-sim <trace> [capacity ...] [--sampling N] [--policy lru|hyperClock]")
+  exit(2)
+}
+
+let tracePath = arguments.removeFirst()
+var capacities: [Int] = []
+var sampling = 1
+var policies = RocksDBCachePolicy.allCases
+
+while !arguments.isEmpty {
+  let argument = arguments.removeFirst()
+  switch argument {
+  case "--sampling":
+    sampling = arguments.isEmpty ? 1 : Int(arguments.removeFirst()) ?? 1
+  case "--policy":
+    guard !arguments.isEmpty, let policy = RocksDBCachePolicy(rawValue: arguments.removeFirst()) else {
+      print("unknown policy")
+      exit(2)
+    }
+    policies = [policy]
+  default:
+    guard let bytes = parseBytes(argument) else {
+      print("invalid capacity: \(argument)")
+      exit(2)
+    }
+    capacities.append(bytes)
+  }
+}
+if capacities.isEmpty {
+  capacities = [16 << 20, 64 << 20, 256 << 20, 1 << 30]
+}
+
+let trace: RocksDBBlockCacheTrace
+do {
+  trace = try RocksDBBlockCacheTrace(contentsOf: tracePath)
+} catch {
+  print("cannot load trace: \(error)")
+  exit(1)
+}
+
+print("accesses: \(trace.accesses.count)  observed hit rate: \(String(format: "%.2f%%", trace.observedHitRate * 100))")
+print("working set: \(formatBytes(Int(trace.workingSetBytes) * sampling)) (scaled by sampling \(sampling))")
+print("")
+print("policy      capacity    hit rate    inserted")
+
+// A trace sampled 1 in N sees about 1/N of the blocks, so shrink the
+// simulated cache by the same factor
+for result in trace.hitRateCurve(capacities: capacities.map { $0 / max(sampling, 1) }, policies: policies) {
+  let policy = result.policy.rawValue.padding(toLength: 12, withPad: " ", startingAt: 0)
+  let capacity = formatBytes(result.capacity * max(sampling, 1)).padding(toLength: 12, withPad: " ", startingAt: 0)
+  let rate = String(format: "%6.2f%%", result.hitRate * 100).padding(toLength: 12, withPad: " ", startingAt: 0)
+  print("\(policy)\(capacity)\(rate)\(formatBytes(Int(result.insertedBytes)))")
+}
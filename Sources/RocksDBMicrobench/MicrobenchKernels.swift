@@ -0,0 +1,258 @@
+//
+//  MicrobenchKernels.swift
+//  RocksDBMicrobench
+//
+//  The same cache-resident loops through each layer of the stack
+//
+
+import Foundation
+import CRocksDB
+import CRocksDB.Microbench
+import RocksDBSwift
+import RocksDBSwiftLite
+
+/// Operations measured at every layer
+enum MicrobenchOperation: String, CaseIterable {
+  case put
+  case get
+  case next
+  case batchAppend
+
+  var rawOp: RocksDBMicrobenchOp {
+    switch self {
+    case .put: return RocksDBMicrobenchPut
+    case .get: return RocksDBMicrobenchGet
+    case .next: return RocksDBMicrobenchNext
+    case .batchAppend: return RocksDBMicrobenchBatchAppend
+    }
+  }
+}
+
+/// Layer a loop runs through, from the engine outwards
+enum MicrobenchLayer: String, CaseIterable {
+  /// rocksdb::DB called from C++ inside the bridge
+  case raw
+  /// RocksDBBridge.h functions called from Swift
+  case bridge
+  /// RocksDB, RocksDBBatch and RocksDBIterator
+  case swift
+  /// RocksDBLite (put and get only)
+  case lite
+}
+
+struct MicrobenchFailure: Error, CustomStringConvertible {
+  let description: String
+}
+
+/// Fixed key set shared by every layer: packed for the C loops, as Data for
+/// the wrappers
+struct MicrobenchKeys {
+  let packed: [CChar]
+  let keys: [Data]
+  let keySize: Int
+  let value: Data
+
+  init(count: Int, keySize: Int, valueSize: Int) {
+    var packed = [CChar]()
+    packed.reserveCapacity(count * keySize)
+    var keys = [Data]()
+    keys.reserveCapacity(count)
+    for index in 0..<count {
+      var digits = Array(String(index).utf8)
+      if digits.count < keySize {
+        digits.insert(contentsOf: repeatElement(UInt8(ascii: "0"), count: keySize - digits.count), at: 0)
+      }
+      let key = digits.suffix(keySize)
+      packed.append(contentsOf: key.map { CChar(bitPattern: $0) })
+      keys.append(Data(key))
+    }
+    self.packed = packed
+    self.keys = keys
+    self.keySize = keySize
+    value = Data(repeating: 0x5a, count: valueSize)
+  }
+
+  var count: Int { keys.count }
+}
+
+/// Database opened through the C functions, shared by the raw and bridge layers
+final class BridgeDatabase {
+  let handle: RocksDBRef
+  let family: RocksDBColumnFamilyRef?
+  private let writeOptions = rocksdb_write_options_create()
+  private let readOptions = rocksdb_read_options_create()
+
+  init(path: String) throws {
+    let opts = rocksdb_options_create()
+    defer { rocksdb_options_destroy(opts) }
+    rocksdb_options_set_create_if_missing(opts, 1)
+
+    var db: RocksDBRef?
+    try check(rocksdb_open(path, opts, &db))
+    guard let db else { throw MicrobenchFailure(description: "Failed to open \(path)") }
+    handle = db
+    family = rocksdb_default_column_family(db)
+  }
+
+  deinit {
+    rocksdb_write_options_destroy(writeOptions)
+    rocksdb_read_options_destroy(readOptions)
+    rocksdb_close(handle)
+  }
+
+  /// Elapsed nanoseconds for the C++ loop inside the bridge
+  func raw(_ op: MicrobenchOperation, keys: MicrobenchKeys, iterations: Int) throws -> UInt64 {
+    var nanos: UInt64 = 0
+    let status = keys.packed.withUnsafeBufferPointer { keyBuffer in
+      keys.value.withUnsafeBytes { valueBuffer in
+        rocksdb_microbench_raw(
+          handle, family, Int32(op.rawOp.rawValue),
+          keyBuffer.baseAddress, keys.keySize, keys.count,
+          valueBuffer.baseAddress?.assumingMemoryBound(to: CChar.self), keys.value.count,
+          UInt64(iterations), &nanos)
+      }
+    }
+    try check(status)
+    return nanos
+  }
+
+  /// Elapsed nanoseconds for the same loop calling the C functions from Swift
+  func bridge(_ op: MicrobenchOperation, keys: MicrobenchKeys, iterations: Int) throws -> UInt64 {
+    try keys.packed.withUnsafeBufferPointer { keyBuffer in
+      try keys.value.withUnsafeBytes { valueBuffer in
+        let base = keyBuffer.baseAddress!
+        let value = valueBuffer.baseAddress?.assumingMemoryBound(to: CChar.self)
+        let keySize = keys.keySize
+        let count = keys.count
+        var checksum = 0
+
+        let start = DispatchTime.now().uptimeNanoseconds
+        switch op {
+        case .put:
+          for i in 0..<iterations {
+            try check(rocksdb_put_cf(handle, family, writeOptions,
+                                     base + (i % count) * keySize, keySize, value, keys.value.count))
+          }
+        case .get:
+          for i in 0..<iterations {
+            var pinned: RocksDBPinnableSliceRef?
+            let status = rocksdb_get_pinned_cf(handle, family, readOptions,
+                                               base + (i % count) * keySize, keySize, &pinned)
+            try check(status)
+            if let pinned {
+              var length = 0
+              _ = rocksdb_pinnable_slice_value(pinned, &length)
+              checksum &+= length
+              rocksdb_pinnable_slice_destroy(pinned)
+            }
+          }
+        case .next:
+          guard let iter = rocksdb_iterator_create_cf(handle, family, readOptions) else {
+            throw MicrobenchFailure(description: "Failed to create iterator")
+          }
+          defer { rocksdb_iterator_destroy(iter) }
+          rocksdb_iterator_seek_to_first(iter)
+          for _ in 0..<iterations where rocksdb_iterator_valid(iter) != 0 {
+            var keyLength = 0
+            var valueLength = 0
+            _ = rocksdb_iterator_key(iter, &keyLength)
+            _ = rocksdb_iterator_value(iter, &valueLength)
+            checksum &+= keyLength &+ valueLength
+            rocksdb_iterator_next(iter)
+            if rocksdb_iterator_valid(iter) == 0 {
+              rocksdb_iterator_seek_to_first(iter)
+            }
+          }
+        case .batchAppend:
+          let batch = rocksdb_batch_create()
+          defer { rocksdb_batch_destroy(batch) }
+          for i in 0..<iterations {
+            if i % count == 0 { rocksdb_batch_clear(batch) }
+            rocksdb_batch_put(batch, base + (i % count) * keySize, keySize, value, keys.value.count)
+          }
+          checksum &+= rocksdb_batch_count(batch)
+        }
+        let elapsed = DispatchTime.now().uptimeNanoseconds - start
+        blackHole(checksum)
+        return elapsed
+      }
+    }
+  }
+}
+
+/// Elapsed nanoseconds for the loop through the full Swift wrapper
+func swiftLoop(_ op: MicrobenchOperation, db: RocksDB, keys: MicrobenchKeys, iterations: Int) throws -> UInt64 {
+  let count = keys.count
+  var checksum = 0
+  let start = DispatchTime.now().uptimeNanoseconds
+  switch op {
+  case .put:
+    for i in 0..<iterations {
+      try db.put(keys.value, forKey: keys.keys[i % count])
+    }
+  case .get:
+    for i in 0..<iterations {
+      checksum &+= try db.get(keys.keys[i % count])?.count ?? 0
+    }
+  case .next:
+    let iterator = try db.makeIterator()
+    defer { iterator.close() }
+    iterator.seekToFirst()
+    for _ in 0..<iterations where iterator.isValid {
+      if let entry = iterator.keyValue {
+        checksum &+= entry.key.count &+ entry.value.count
+      }
+      iterator.next()
+      if !iterator.isValid { iterator.seekToFirst() }
+    }
+    try iterator.checkStatus()
+  case .batchAppend:
+    let batch = RocksDBBatch()
+    for i in 0..<iterations {
+      if i % count == 0 { batch.clear() }
+      batch.put(keys.value, forKey: keys.keys[i % count])
+    }
+    checksum &+= batch.count
+  }
+  let elapsed = DispatchTime.now().uptimeNanoseconds - start
+  blackHole(checksum)
+  return elapsed
+}
+
+/// Elapsed nanoseconds for the loop through RocksDBLite, nil where it has
+/// no equivalent
+func liteLoop(_ op: MicrobenchOperation, db: RocksDBLite, keys: MicrobenchKeys, iterations: Int) throws -> UInt64? {
+  let count = keys.count
+  var checksum = 0
+  let start = DispatchTime.now().uptimeNanoseconds
+  switch op {
+  case .put:
+    for i in 0..<iterations {
+      try db.put(keys.value, forKey: keys.keys[i % count])
+    }
+  case .get:
+    for i in 0..<iterations {
+      checksum &+= try db.get(keys.keys[i % count])?.count ?? 0
+    }
+  case .next, .batchAppend:
+    return nil
+  }
+  let elapsed = DispatchTime.now().uptimeNanoseconds - start
+  blackHole(checksum)
+  return elapsed
+}
+
+private func check(_ status: RocksDBStatus) throws {
+  guard status.code != RocksDBStatusOK else { return }
+  let message = status.message.map { String(cString: $0) } ?? "Operation failed"
+  if let msg = status.message {
+    rocksdb_free_string(msg)
+  }
+  throw MicrobenchFailure(description: message)
+}
+
+/// Keeps loop results alive so the optimizer cannot drop the reads
+@inline(never)
+private func blackHole(_ value: Int) {
+  if value == -1 { print("") }
+}
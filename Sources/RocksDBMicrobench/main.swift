@@ -0,0 +1,92 @@
+//
+//  main.swift
+//  RocksDBMicrobench
+//
+//  Per-operation cost of each layer over raw rocksdb::DB
+//
+//  Usage: rocksdb-microbench [--iterations N] [--keys N] [--key-size N] [--value-size N] [--db PATH]
+//  Every layer runs the same loop over a small key set that stays in the
+//  memtable, so the gaps between rows are wrapper cost, not I/O.
+//
+
+import Foundation
+import RocksDBSwift
+import RocksDBSwiftLite
+
+var arguments = Array(CommandLine.arguments.dropFirst())
+var iterations = 1_000_000
+var keyCount = 10_000
+var keySize = 16
+var valueSize = 100
+var root = (NSTemporaryDirectory() as NSString).appendingPathComponent("rocksdb-microbench")
+
+while !arguments.isEmpty {
+  let argument = arguments.removeFirst()
+  guard !arguments.isEmpty else {
+    print("missing value for \(argument)")
+    exit(2)
+  }
+  let value = arguments.removeFirst()
+  switch argument {
+  case "--iterations": iterations = Int(value) ?? iterations
+  case "--keys": keyCount = Int(value) ?? keyCount
+  case "--key-size": keySize = Int(value) ?? keySize
+  case "--value-size": valueSize = Int(value) ?? valueSize
+  case "--db": root = value
+  default:
+    print("unknown option: \(argument)")
+    exit(2)
+  }
+}
+
+let keys = MicrobenchKeys(count: keyCount, keySize: keySize, valueSize: valueSize)
+
+func databasePath(_ layer: String, under root: String) throws -> String {
+  let path = (root as NSString).appendingPathComponent(layer)
+  if FileManager.default.fileExists(atPath: path) {
+    try FileManager.default.removeItem(atPath: path)
+  }
+  try FileManager.default.createDirectory(atPath: root, withIntermediateDirectories: true)
+  return path
+}
+
+do {
+  // Raw and bridge loops share one database opened through the C functions
+  let bridgeDB = try BridgeDatabase(path: try databasePath("bridge", under: root))
+  let swiftDB = try RocksDB.open(at: try databasePath("swift", under: root))
+  let liteDB = try RocksDBLite.open(at: try databasePath("lite", under: root))
+  defer {
+    swiftDB.close()
+    liteDB.close()
+  }
+
+  // Load every key once so reads and scans hit, then warm each path
+  _ = try bridgeDB.raw(.put, keys: keys, iterations: keys.count)
+  _ = try swiftLoop(.put, db: swiftDB, keys: keys, iterations: keys.count)
+  _ = try liteLoop(.put, db: liteDB, keys: keys, iterations: keys.count)
+
+  print("\(iterations) iterations, \(keyCount) keys, \(keySize) B keys, \(valueSize) B values")
+  print("operation     layer     ns/op   over raw")
+  for op in MicrobenchOperation.allCases {
+    var rawNanos = 0.0
+    for layer in MicrobenchLayer.allCases {
+      let elapsed: UInt64?
+      switch layer {
+      case .raw: elapsed = try bridgeDB.raw(op, keys: keys, iterations: iterations)
+      case .bridge: elapsed = try bridgeDB.bridge(op, keys: keys, iterations: iterations)
+      case .swift: elapsed = try swiftLoop(op, db: swiftDB, keys: keys, iterations: iterations)
+      case .lite: elapsed = try liteLoop(op, db: liteDB, keys: keys, iterations: iterations)
+      }
+      guard let elapsed else { continue }
+
+      let perOp = Double(elapsed) / Double(iterations)
+      if layer == .raw { rawNanos = perOp }
+      let name = op.rawValue.padding(toLength: 13, withPad: " ", startingAt: 0)
+      let layerName = layer.rawValue.padding(toLength: 7, withPad: " ", startingAt: 0)
+      print(String(format: "%@ %@ %9.1f %+9.1f", name, layerName, perOp, perOp - rawNanos))
+    }
+  }
+} catch {
+  print("microbenchmark failed: \(error)")
+  exit(1)
+}
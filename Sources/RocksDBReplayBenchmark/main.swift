@@ -0,0 +1,82 @@
+//
+//  main.swift
+//  RocksDBReplayBenchmark
+//
+//  Replay a query trace against a database copy and report latencies
+//
+//  Usage: rocksdb-replay <db> <trace> [--copy-from <db>] [--threads N] [--speedup X]
+//  With --copy-from, the source database (closed, or a checkpoint) is copied
+//  to <db> first so the replay never writes to it.
+//
+
+import Foundation
+import RocksDBSwift
+
+var arguments = Array(CommandLine.arguments.dropFirst())
+guard arguments.count >= 2 else {
+  print("usage: rocksdb-replay <db> <trace> [--copy-from <db>] [--threads N] [--speedup X]")
+  exit(2)
+}
+
+let dbPath = arguments.removeFirst()
+let tracePath = arguments.removeFirst()
+var sourcePath: String?
+var threads = 1
+var speedup = 1.0
+
+while !arguments.isEmpty {
+  let argument = arguments.removeFirst()
+  guard !arguments.isEmpty else {
+    print("missing value for \(argument)")
+    exit(2)
+  }
+  let value = arguments.removeFirst()
+  switch argument {
+  case "--copy-from":
+    sourcePath = value
+  case "--threads":
+    threads = Int(value) ?? 1
+  case "--speedup":
+    speedup = Double(value) ?? 1
+  default:
+    print("unknown option: \(argument)")
+    exit(2)
+  }
+}
+
+do {
+  if let sourcePath {
+    let fileManager = FileManager.default
+    if fileManager.fileExists(atPath: dbPath) {
+      try fileManager.removeItem(atPath: dbPath)
+    }
+    try fileManager.copyItem(atPath: sourcePath, toPath: dbPath)
+  }
+
+  let families = try RocksDB.listColumnFamilies(at: dbPath).filter { $0 != "default" }
+  // Every family must be open: records address column families by ID
+  let db = try RocksDB.open(
+    at: dbPath,
+    columnFamilies: Dictionary(uniqueKeysWithValues: families.map { ($0, RocksDBColumnFamilyOptions()) }))
+  defer { db.close() }
+
+  let result = try db.replayTrace(from: tracePath, threads: threads, speedup: speedup)
+
+  print(String(format: "replayed %llu operations in %.2fs (%.0f ops/s), %llu failed records",
+               result.operations, result.elapsed, result.throughput, result.failedRecords))
+  print("")
+  print("operation        count     errors   avg us    p50 us    p95 us    p99 us    max us")
+  let rows: [(String, RocksDBReplayLatency)] = [
+    ("get", result.gets), ("multiGet", result.multiGets),
+    ("write", result.writes), ("iteratorSeek", result.iteratorSeeks),
+  ]
+  for (name, latency) in rows where latency.count > 0 {
+    print(name.padding(toLength: 14, withPad: " ", startingAt: 0)
+      + String(format: "%8llu %10llu %8.1f %9llu %9llu %9llu %9llu",
+               latency.count, latency.errors, latency.averageMicros,
+               latency.p50Micros, latency.p95Micros, latency.p99Micros, latency.maxMicros))
+  }
+} catch {
+  print("replay failed: \(error)")
+  exit(1)
+}
@@ -9,9 +9,12 @@ import Foundation
 import CRocksDB
 
 /// Thread-safe RocksDB database wrapper
+///
+/// `rocksdb::DB` is internally thread-safe, so operations run concurrently
+/// under the shared side of a reader/writer lock; only `close()` is exclusive.
 public final class RocksDB: @unchecked Sendable {
   private var handle: RocksDBRef?
-  private let lock = NSRecursiveLock()
+  private let lock = ReadWriteLock()
 
   /// Database path
   public let path: String
@@ -19,9 +22,28 @@ public final class RocksDB: @unchecked Sendable {
   /// Whether database supports transactions
   public let isTransactional: Bool
 
+  /// Pool of reusable batches used by `batch(options:_:)`
+  public let batchPool = RocksDBBatchPool()
+
+  /// Pool of reusable native transactions used by `transaction(options:snapshot:retry:_:)`
+  public let transactionPool = RocksDBTransactionPool()
+
+  private let transactionCounters = RocksDBTransactionCounters()
+
+  /// Snapshot handed out by `sharedSnapshot()`, alive while a reader holds it
+  private weak var currentSharedSnapshot: RocksDBSnapshot?
+  private var _snapshotSharingWindow: TimeInterval = 0.01
+  private var sharedSnapshotHits = 0
+  private let snapshotLock = NSLock()
+
+  /// Open column families by name (excluding dropped ones)
+  private var columnFamilies: [String: RocksDBColumnFamily] = [:]
+  private var defaultFamily: RocksDBColumnFamily?
+  private let familiesLock = NSLock()
+
   /// Whether database is open
   public var isOpen: Bool {
-    lock.withLock { handle != nil }
+    lock.withReadLock { handle != nil }
   }
 
   // MARK: - Initialization
@@ -59,6 +81,61 @@ public final class RocksDB: @unchecked Sendable {
     return RocksDB(handle: handle, path: path, isTransactional: false)
   }
 
+  /// Open a new database held entirely in memory
+  ///
+  /// Files, WAL and syncs go to a private in-memory file system, so nothing
+  /// touches the disk; for scratch stores and tests. The data is gone once
+  /// the database is closed. A shared `sstFileManager` in `options` tracks
+  /// real files only and should be left unset.
+  /// - Parameters:
+  ///   - options: Database options (`createIfMissing` is implied)
+  ///   - name: Name of the database inside the in-memory file system
+  /// - Returns: Open database instance
+  /// - Throws: RocksDBError on failure
+  public static func openInMemory(options: RocksDBOptions = .default, name: String = "/in-memory") throws -> RocksDB {
+    let opts = options.createHandle()
+    defer { rocksdb_options_destroy(opts) }
+
+    var dbHandle: RocksDBRef?
+    let status = rocksdb_open_in_memory(name, opts, &dbHandle)
+    try RocksDBError.check(status)
+
+    guard let handle = dbHandle else {
+      throw RocksDBError.ioError("Failed to open database")
+    }
+
+    return RocksDB(handle: handle, path: name, isTransactional: false)
+  }
+
+  /// Open a RocksDB database and report where the open time went
+  ///
+  /// Phases are told apart by the order RocksDB first opens MANIFEST, table
+  /// and WAL files in, so they are approximate. A custom `Env` only gets
+  /// the total.
+  /// - Parameters:
+  ///   - path: Path to database directory
+  ///   - options: Database options
+  /// - Returns: Open database instance and its open timing
+  /// - Throws: RocksDBError on failure
+  public static func openTimed(
+    at path: String,
+    options: RocksDBOptions = .default
+  ) throws -> (database: RocksDB, timing: RocksDBOpenTiming) {
+    let opts = options.createHandle()
+    defer { rocksdb_options_destroy(opts) }
+
+    var dbHandle: RocksDBRef?
+    var timing = RocksDBOpenTimingValues()
+    let status = rocksdb_open_timed(path, opts, &timing, &dbHandle)
+    try RocksDBError.check(status)
+
+    guard let handle = dbHandle else {
+      throw RocksDBError.ioError("Failed to open database")
+    }
+
+    return (RocksDB(handle: handle, path: path, isTransactional: false), RocksDBOpenTiming(timing))
+  }
+
   /// Open a RocksDB database in read-only mode
   /// - Parameters:
   ///   - path: Path to database directory
@@ -85,21 +162,100 @@ public final class RocksDB: @unchecked Sendable {
     return RocksDB(handle: handle, path: path, isTransactional: false)
   }
 
-  /// Open a RocksDB database with optimistic transaction support
+  /// Open a read-only secondary instance of a database another process writes
+  ///
+  /// Unlike `openReadOnly`, a secondary can follow the primary without
+  /// reopening: `tryCatchUpWithPrimary()` replays the primary's new MANIFEST
+  /// and WAL entries, keeping the block cache warm. Any number of
+  /// secondaries can tail one primary on shared storage. Only the default
+  /// column family is opened. Keep `maxOpenFiles` at -1, so files deleted
+  /// by the primary's compactions stay readable until the next catch-up.
+  /// - Parameters:
+  ///   - path: Primary database directory
+  ///   - secondaryPath: Directory for this instance's info logs, one per secondary
+  ///   - options: Database options
+  /// - Returns: Open database instance
+  /// - Throws: RocksDBError on failure
+  public static func openAsSecondary(
+    at path: String,
+    secondaryPath: String,
+    options: RocksDBOptions = .secondary
+  ) throws -> RocksDB {
+    let opts = options.createHandle()
+    defer { rocksdb_options_destroy(opts) }
+
+    var dbHandle: RocksDBRef?
+    let status = rocksdb_open_as_secondary(path, secondaryPath, opts, &dbHandle)
+    try RocksDBError.check(status)
+
+    guard let handle = dbHandle else {
+      throw RocksDBError.ioError("Failed to open database")
+    }
+
+    return RocksDB(handle: handle, path: path, isTransactional: false)
+  }
+
+  /// Open a RocksDB database whose entries expire after a time to live
+  ///
+  /// Expired entries are dropped by compaction, so no user deletes or
+  /// tombstones are needed. Expiry is lazy: reads may still see expired
+  /// entries until compaction reaches their files. A database created with
+  /// a TTL stores a timestamp with every value and must always be reopened
+  /// this way.
+  /// - Parameters:
+  ///   - path: Path to database directory
+  ///   - options: Database options
+  ///   - ttl: Time to live in seconds (zero or less: never expire)
+  ///   - readOnly: Open read-only (no compactions, so nothing expires)
+  /// - Returns: Open database instance
+  /// - Throws: RocksDBError on failure
+  public static func openWithTTL(
+    at path: String,
+    options: RocksDBOptions = .default,
+    ttl: TimeInterval,
+    readOnly: Bool = false
+  ) throws -> RocksDB {
+    let opts = options.createHandle()
+    defer { rocksdb_options_destroy(opts) }
+
+    var dbHandle: RocksDBRef?
+    let status = rocksdb_open_with_ttl(path, opts, RocksDB.ttlSeconds(ttl), readOnly ? 1 : 0, &dbHandle)
+    try RocksDBError.check(status)
+
+    guard let handle = dbHandle else {
+      throw RocksDBError.ioError("Failed to open database")
+    }
+
+    return RocksDB(handle: handle, path: path, isTransactional: false)
+  }
+
+  /// Clamp a TTL to the whole seconds DBWithTTL works in
+  private static func ttlSeconds(_ ttl: TimeInterval) -> Int32 {
+    ttl <= 0 ? 0 : Int32(min(ttl.rounded(.up), TimeInterval(Int32.max)))
+  }
+
+  /// Open a RocksDB database with transaction support
+  ///
+  /// `RocksDBTransaction` behaves the same in both modes; pessimistic mode
+  /// only changes when conflicts surface (lock waits instead of failed commits).
   /// - Parameters:
   ///   - path: Path to database directory
   ///   - options: Database options
+  ///   - transactionOptions: Concurrency control mode and its settings
   /// - Returns: Open database instance with transaction support
   /// - Throws: RocksDBError on failure
   public static func openWithTransactions(
     at path: String,
-    options: RocksDBOptions = .default
+    options: RocksDBOptions = .default,
+    transactionOptions: RocksDBTransactionDBOptions = .optimistic
   ) throws -> RocksDB {
     let opts = options.createHandle()
     defer { rocksdb_options_destroy(opts) }
+    let txnOpts = transactionOptions.createHandle()
+    defer { rocksdb_transaction_db_options_destroy(txnOpts) }
 
     var dbHandle: RocksDBRef?
-    let status = rocksdb_open_transactional(path, opts, &dbHandle)
+    let status = rocksdb_open_transaction_db(path, opts, txnOpts, &dbHandle)
     try RocksDBError.check(status)
 
     guard let handle = dbHandle else {
@@ -109,71 +265,373 @@ public final class RocksDB: @unchecked Sendable {
     return RocksDB(handle: handle, path: path, isTransactional: true)
   }
 
+  /// Open a RocksDB database with column families
+  ///
+  /// All existing column families must be listed (see `listColumnFamilies`);
+  /// missing ones are created when `createMissingColumnFamilies` is enabled.
+  /// The default family is always opened and is addressed with a nil family.
+  /// - Parameters:
+  ///   - path: Path to database directory
+  ///   - options: Database options (also used for the default family)
+  ///   - columnFamilies: Column family names and their options
+  ///   - transactional: Open with transaction support
+  ///   - transactionOptions: Transaction mode and settings when transactional
+  /// - Returns: Open database instance
+  /// - Throws: RocksDBError on failure
+  public static func open(
+    at path: String,
+    options: RocksDBOptions = .default,
+    columnFamilies: [String: RocksDBColumnFamilyOptions],
+    transactional: Bool = false,
+    transactionOptions: RocksDBTransactionDBOptions = .optimistic
+  ) throws -> RocksDB {
+    if columnFamilies.isEmpty {
+      return transactional
+        ? try openWithTransactions(at: path, options: options, transactionOptions: transactionOptions)
+        : try open(at: path, options: options)
+    }
+
+    let opts = options.createHandle()
+    defer { rocksdb_options_destroy(opts) }
+    let txnOpts = transactionOptions.createHandle()
+    defer { rocksdb_transaction_db_options_destroy(txnOpts) }
+
+    let names = Array(columnFamilies.keys)
+    let familyOpts: [RocksDBOptionsRef?] = names.map { columnFamilies[$0]!.createHandle() }
+    defer { familyOpts.forEach { rocksdb_options_destroy($0) } }
+
+    var dbHandle: RocksDBRef?
+    var familyHandles = [RocksDBColumnFamilyRef?](repeating: nil, count: names.count)
+
+    let status = names.withCStringPointers { namePtrs in
+      familyOpts.withUnsafeBufferPointer { optPtrs in
+        transactional
+          ? rocksdb_open_transaction_db_column_families(path, opts, txnOpts, names.count, namePtrs,
+                                                        optPtrs.baseAddress, &dbHandle, &familyHandles)
+          : rocksdb_open_column_families(path, opts, names.count, namePtrs,
+                                         optPtrs.baseAddress, &dbHandle, &familyHandles)
+      }
+    }
+    try RocksDBError.check(status)
+
+    guard let handle = dbHandle else {
+      throw RocksDBError.ioError("Failed to open database")
+    }
+
+    let db = RocksDB(handle: handle, path: path, isTransactional: transactional)
+    for (name, familyHandle) in zip(names, familyHandles) {
+      guard let familyHandle = familyHandle, name != RocksDBColumnFamily.defaultName else { continue }
+      db.columnFamilies[name] = RocksDBColumnFamily(handle: familyHandle, name: name, database: db)
+    }
+    return db
+  }
+
+  /// Open a database with a complete option set loaded from an OPTIONS file
+  ///
+  /// Opens every column family in `optionsFile`, each with its own options.
+  /// - Parameters:
+  ///   - path: Path to database directory
+  ///   - optionsFile: DB and column family options (see `RocksDBOptionsFile`)
+  /// - Returns: Open database instance
+  /// - Throws: RocksDBError on failure
+  public static func open(at path: String, optionsFile: RocksDBOptionsFile) throws -> RocksDB {
+    let names = optionsFile.columnFamilies
+    let familyOpts: [RocksDBOptionsRef?] = optionsFile.familyOptions
+    var dbHandle: RocksDBRef?
+    var familyHandles = [RocksDBColumnFamilyRef?](repeating: nil, count: names.count)
+
+    let status = names.withCStringPointers { namePtrs in
+      familyOpts.withUnsafeBufferPointer { optPtrs in
+        rocksdb_open_column_families(path, optionsFile.dbOptions, names.count, namePtrs,
+                                     optPtrs.baseAddress, &dbHandle, &familyHandles)
+      }
+    }
+    try RocksDBError.check(status)
+
+    guard let handle = dbHandle else {
+      throw RocksDBError.ioError("Failed to open database")
+    }
+
+    let db = RocksDB(handle: handle, path: path, isTransactional: false)
+    for (name, familyHandle) in zip(names, familyHandles) {
+      guard let familyHandle = familyHandle, name != RocksDBColumnFamily.defaultName else { continue }
+      db.columnFamilies[name] = RocksDBColumnFamily(handle: familyHandle, name: name, database: db)
+    }
+    return db
+  }
+
+  /// List the column families of an existing database
+  /// - Parameters:
+  ///   - path: Path to database directory
+  ///   - options: Database options
+  /// - Returns: Column family names, including "default"
+  /// - Throws: RocksDBError on failure
+  public static func listColumnFamilies(
+    at path: String,
+    options: RocksDBOptions = .default
+  ) throws -> [String] {
+    let opts = options.createHandle()
+    defer { rocksdb_options_destroy(opts) }
+
+    var namesPtr: UnsafeMutablePointer<UnsafeMutablePointer<CChar>?>?
+    var count: Int = 0
+    try RocksDBError.check(rocksdb_list_column_families(path, opts, &namesPtr, &count))
+    defer { rocksdb_free_string_list(namesPtr, count) }
+
+    return (0..<count).compactMap { i in
+      namesPtr?[i].map { String(cString: $0) }
+    }
+  }
+
   /// Close the database
+  ///
+  /// Later calls throw databaseClosed. Native state still referenced by
+  /// open transactions and WAL iterators is freed once the last of them is released; until then the
+  /// database keeps its LOCK file, and opening the same path again in this
+  /// process fails.
   public func close() {
-    lock.withLock {
+    lock.withWriteLock {
       if let h = handle {
+        // Native transactions must not outlive the database
+        transactionPool.drain()
         rocksdb_close(h)
         handle = nil
       }
     }
   }
 
-  // MARK: - Basic Operations
+  // MARK: - Column Families
 
-  /// Put a key-value pair
+  /// Look up an open column family
+  /// - Parameter name: Column family name
+  /// - Returns: Column family, or nil if not open (or dropped)
+  public func columnFamily(named name: String) -> RocksDBColumnFamily? {
+    familiesLock.withLock { columnFamilies[name] }
+  }
+
+  /// Names of the open column families (excluding the default family)
+  public var columnFamilyNames: [String] {
+    familiesLock.withLock { Array(columnFamilies.keys) }
+  }
+
+  /// Create a column family
   /// - Parameters:
-  ///   - value: Value data
-  ///   - key: Key data
-  ///   - options: Write options
+  ///   - name: Column family name
+  ///   - options: Column family options
+  /// - Returns: New column family
+  /// - Throws: RocksDBError on failure (e.g. the family already exists)
+  public func createColumnFamily(
+    named name: String,
+    options: RocksDBColumnFamilyOptions = .init()
+  ) throws -> RocksDBColumnFamily {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let opts = options.createHandle()
+      defer { rocksdb_options_destroy(opts) }
+
+      var familyHandle: RocksDBColumnFamilyRef?
+      try RocksDBError.check(rocksdb_create_column_family(h, opts, name, &familyHandle))
+
+      guard let created = familyHandle else {
+        throw RocksDBError.ioError("Failed to create column family")
+      }
+
+      let family = RocksDBColumnFamily(handle: created, name: name, database: self)
+      familiesLock.withLock { columnFamilies[name] = family }
+      return family
+    }
+  }
+
+  /// Drop a column family and all of its data
+  /// - Parameter columnFamily: Column family to drop
   /// - Throws: RocksDBError on failure
-  public func put(_ value: Data, forKey key: Data, options: RocksDBWriteOptions = .default) throws {
-    try lock.withLock {
+  public func dropColumnFamily(_ columnFamily: RocksDBColumnFamily) throws {
+    try lock.withReadLock {
       guard let h = handle else {
         throw RocksDBError.databaseClosed
       }
 
-      let writeOpts = options.createHandle()
-      defer { rocksdb_write_options_destroy(writeOpts) }
+      let cf = try familyHandle(columnFamily)
+      try RocksDBError.check(rocksdb_drop_column_family(h, cf))
+      familiesLock.withLock { _ = columnFamilies.removeValue(forKey: columnFamily.name) }
+    }
+  }
 
-      let status = key.withUnsafeBytes { keyPtr in
-        value.withUnsafeBytes { valuePtr in
-          rocksdb_put(h, writeOpts,
-                      keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
-                      key.count,
-                      valuePtr.baseAddress?.assumingMemoryBound(to: CChar.self),
-                      value.count)
+  /// The default column family, for APIs that need an explicit family
+  /// (such as `RocksDBBatch.putEntity`)
+  public var defaultColumnFamily: RocksDBColumnFamily {
+    get throws {
+      try lock.withReadLock {
+        guard let h = handle, let ref = rocksdb_default_column_family(h) else {
+          throw RocksDBError.databaseClosed
+        }
+        return familiesLock.withLock {
+          if let family = defaultFamily {
+            return family
+          }
+          let family = RocksDBColumnFamily(handle: ref, name: RocksDBColumnFamily.defaultName,
+                                           database: self)
+          defaultFamily = family
+          return family
         }
       }
-      try RocksDBError.check(status)
     }
   }
 
+  /// Validate that a column family belongs to this database
+  internal func familyHandle(_ columnFamily: RocksDBColumnFamily?) throws -> RocksDBColumnFamilyRef? {
+    guard let family = columnFamily else {
+      return nil
+    }
+    guard family.database === self else {
+      throw RocksDBError.invalidArgument("Column family \(family.name) belongs to another database")
+    }
+    return family.handle
+  }
+
+  /// Run `body`, which uses this database's native handles, while the
+  /// database is held open; `close()` waits for it to return
+  /// - Throws: RocksDBError.databaseClosed once the database is closed, or
+  ///   the error thrown by `body`
+  internal func whileOpen<R>(_ body: () throws -> R) throws -> R {
+    try lock.withReadLock {
+      guard handle != nil else {
+        throw RocksDBError.databaseClosed
+      }
+      return try body()
+    }
+  }
+
+  // MARK: - Basic Operations
+
+  /// Put a key-value pair
+  /// - Parameters:
+  ///   - value: Value data
+  ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Write options
+  /// - Throws: RocksDBError on failure
+  public func put(
+    _ value: Data,
+    forKey key: Data,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBWriteOptions = .default
+  ) throws {
+    try key.withUnsafeBytes { keyPtr in
+      try value.withUnsafeBytes { try putBytes($0, forKey: keyPtr, in: columnFamily, options: options) }
+    }
+  }
+
+  /// Merge an operand into the value for key
+  ///
+  /// Executes the configured `RocksDBOptions.mergeOperator` lazily inside
+  /// RocksDB, so no read is needed on the write path.
+  /// - Parameters:
+  ///   - value: Merge operand
+  ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Write options
+  /// - Throws: RocksDBError on failure (e.g. no merge operator configured)
+  public func merge(
+    _ value: Data,
+    forKey key: Data,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBWriteOptions = .default
+  ) throws {
+    try key.withUnsafeBytes { keyPtr in
+      try value.withUnsafeBytes { try mergeBytes($0, forKey: keyPtr, in: columnFamily, options: options) }
+    }
+  }
+
+  /// Atomically add delta to a counter (requires the `.uint64Add` merge operator)
+  public func increment(_ key: Data, by delta: UInt64 = 1, options: RocksDBWriteOptions = .default) throws {
+    try merge(RocksDBMergeOperator.encodeUInt64(delta), forKey: key, options: options)
+  }
+
+  /// Read a counter maintained with `increment` (nil if missing or malformed)
+  public func getUInt64(_ key: Data, options: RocksDBReadOptions = .default) throws -> UInt64? {
+    try withValue(forKey: key, options: options) { buffer in
+      RocksDBMergeOperator.decodeUInt64(Data(buffer))
+    } ?? nil
+  }
+
   /// Get value for key
+  ///
+  /// The value is copied out of RocksDB; use `withValue(forKey:in:options:_:)`
+  /// to read it in place instead.
   /// - Parameters:
   ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
   ///   - options: Read options
   /// - Returns: Value data or nil if not found
   /// - Throws: RocksDBError on failure
-  public func get(_ key: Data, options: RocksDBReadOptions = .default) throws -> Data? {
-    try lock.withLock {
+  public func get(
+    _ key: Data,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBReadOptions = .default
+  ) throws -> Data? {
+    let traceStart = RocksDBTracing.begin()
+    defer { RocksDBTracing.end(.get, traceStart) }
+
+    guard let slice = try key.withUnsafeBytes({ try getPinned($0, in: columnFamily, options: options) }) else {
+      return nil
+    }
+    return RocksDB.data(copyingPinned: slice)
+  }
+
+  /// Access the value for key in place, without materializing a `Data`
+  ///
+  /// The buffer points into the pinned RocksDB value and is only valid for
+  /// the duration of `body`; copy out anything that must outlive it.
+  /// - Parameters:
+  ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options
+  ///   - body: Closure receiving the value bytes
+  /// - Returns: Result of `body`, or nil if the key was not found
+  /// - Throws: RocksDBError on failure, or any error thrown by `body`
+  public func withValue<R>(
+    forKey key: Data,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBReadOptions = .default,
+    _ body: (UnsafeRawBufferPointer) throws -> R
+  ) throws -> R? {
+    guard let slice = try key.withUnsafeBytes({ try getPinned($0, in: columnFamily, options: options) }) else {
+      return nil
+    }
+    defer { rocksdb_pinnable_slice_destroy(slice) }
+
+    var valueLen: Int = 0
+    let ptr = rocksdb_pinnable_slice_value(slice, &valueLen)
+    return try body(UnsafeRawBufferPointer(start: ptr, count: ptr == nil ? 0 : valueLen))
+  }
+
+  /// Pinned lookup shared by `get` and `withValue`
+  ///
+  /// The lock is only held for the lookup itself: a pinned slice retains the
+  /// native database, so callers may use it after the lock is released.
+  private func getPinned(
+    _ key: UnsafeRawBufferPointer,
+    in columnFamily: RocksDBColumnFamily?,
+    options: RocksDBReadOptions
+  ) throws -> RocksDBPinnableSliceRef? {
+    try lock.withReadLock {
       guard let h = handle else {
         throw RocksDBError.databaseClosed
       }
 
-      let readOpts = options.createHandle()
-      defer { rocksdb_read_options_destroy(readOpts) }
+      let cf = try familyHandle(columnFamily)
+      let readOpts = options.handle
 
-      var valuePtr: UnsafeMutablePointer<CChar>?
-      var valueLen: Int = 0
+      var pinned: RocksDBPinnableSliceRef?
 
-      let status = key.withUnsafeBytes { keyPtr in
-        rocksdb_get(h, readOpts,
-                    keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
-                    key.count,
-                    &valuePtr,
-                    &valueLen)
-      }
+      let status = rocksdb_get_pinned_cf(h, cf, readOpts,
+                                         key.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                         key.count,
+                                         &pinned)
 
       // NotFound is not an error, just return nil
       if status.code == RocksDBStatusNotFound {
@@ -184,327 +642,3186 @@ public final class RocksDB: @unchecked Sendable {
       }
 
       try RocksDBError.check(status)
+      return pinned
+    }
+  }
 
-      guard let ptr = valuePtr else {
-        return nil
+  /// Copy a pinned slice into `Data` and release the pin
+  ///
+  /// Returned values must not hold pins: a pin retains the native database
+  /// (and its LOCK file) past `close()`, and keeps a whole cache block alive
+  /// for a value that may be a few bytes. `withValue` is the zero-copy path.
+  internal static func data(copyingPinned slice: RocksDBPinnableSliceRef) -> Data {
+    defer { rocksdb_pinnable_slice_destroy(slice) }
+
+    var valueLen: Int = 0
+    guard let ptr = rocksdb_pinnable_slice_value(slice, &valueLen), valueLen > 0 else {
+      return Data()
+    }
+    return Data(bytes: ptr, count: valueLen)
+  }
+
+  /// Get values for multiple keys in a single batched lookup
+  ///
+  /// Uses `DB::MultiGet`, which batches filter and index probes and coalesces
+  /// I/O across the keys. Values are copied, as with `get(_:options:)`.
+  /// - Parameters:
+  ///   - keys: Keys to look up
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options
+  ///   - sortedInput: Set when `keys` are already in ascending byte order
+  /// - Returns: Values in the same order as `keys`, nil for missing keys
+  /// - Throws: RocksDBError if any lookup fails with an error other than not found
+  public func multiGet(
+    _ keys: [Data],
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBReadOptions = .default,
+    sortedInput: Bool = false
+  ) throws -> [Data?] {
+    let traceStart = RocksDBTracing.begin()
+    defer { RocksDBTracing.end(.multiGet, traceStart) }
+
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      if keys.isEmpty {
+        return []
+      }
+
+      let cf = try familyHandle(columnFamily)
+      let readOpts = options.handle
+
+      var pinned = [RocksDBPinnableSliceRef?](repeating: nil, count: keys.count)
+      var statuses = [RocksDBStatus](repeating: RocksDBStatus(), count: keys.count)
+
+      keys.withPackedKeys { keyPtrs, keyLens in
+        rocksdb_multi_get_cf(h, cf, readOpts, keys.count, keyPtrs, keyLens,
+                             sortedInput ? 1 : 0, &pinned, &statuses)
+      }
+
+      var firstError: RocksDBError?
+      var results: [Data?] = []
+      results.reserveCapacity(keys.count)
+
+      for i in 0..<keys.count {
+        let status = statuses[i]
+        if status.code == RocksDBStatusOK, let slice = pinned[i] {
+          results.append(RocksDB.data(copyingPinned: slice))
+          continue
+        }
+
+        if status.code != RocksDBStatusNotFound && firstError == nil {
+          firstError = RocksDBError.from(status)
+        }
+        if let msg = status.message {
+          rocksdb_free_string(msg)
+        }
+        results.append(nil)
       }
-      defer { rocksdb_free_data(ptr) }
 
-      return Data(bytes: ptr, count: valueLen)
+      if let error = firstError {
+        throw error
+      }
+      return results
     }
   }
 
-  /// Delete a key
+  // MARK: - Read Context Operations
+
+  /// Access the value for key in place through a reusable read context
+  ///
+  /// The buffer is only valid for the duration of `body`, which must not
+  /// close the database.
   /// - Parameters:
   ///   - key: Key data
-  ///   - options: Write options
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - context: Read context owned by the calling thread or task
+  ///   - body: Closure receiving the value bytes
+  /// - Returns: Result of `body`, or nil if the key is not found
   /// - Throws: RocksDBError on failure
-  public func delete(_ key: Data, options: RocksDBWriteOptions = .default) throws {
-    try lock.withLock {
+  public func withValue<R>(
+    forKey key: Data,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    context: RocksDBReadContext,
+    _ body: (UnsafeRawBufferPointer) throws -> R
+  ) throws -> R? {
+    try lock.withReadLock {
       guard let h = handle else {
         throw RocksDBError.databaseClosed
       }
 
-      let writeOpts = options.createHandle()
-      defer { rocksdb_write_options_destroy(writeOpts) }
+      let cf = try familyHandle(columnFamily)
+      defer { rocksdb_read_context_reset(context.handle) }
 
+      var valuePtr: UnsafePointer<CChar>?
+      var valueLen: Int = 0
       let status = key.withUnsafeBytes { keyPtr in
-        rocksdb_delete(h, writeOpts,
-                       keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
-                       key.count)
+        rocksdb_read_context_get(h, cf, context.handle,
+                                 keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                 key.count, &valuePtr, &valueLen)
+      }
+
+      if status.code == RocksDBStatusNotFound {
+        return nil
       }
       try RocksDBError.check(status)
+      return try body(UnsafeRawBufferPointer(start: valuePtr, count: valuePtr == nil ? 0 : valueLen))
     }
   }
 
-  /// Check if key may exist (bloom filter check, may have false positives)
+  /// Get value for key through a reusable read context
   /// - Parameters:
   ///   - key: Key data
-  ///   - options: Read options
-  /// - Returns: true if key may exist
-  public func keyMayExist(_ key: Data, options: RocksDBReadOptions = .default) -> Bool {
-    lock.withLock {
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - context: Read context owned by the calling thread or task
+  /// - Returns: Copied value data or nil if not found
+  /// - Throws: RocksDBError on failure
+  public func get(
+    _ key: Data,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    context: RocksDBReadContext
+  ) throws -> Data? {
+    try withValue(forKey: key, in: columnFamily, context: context) { Data($0) }
+  }
+
+  /// Get values for many keys through a reusable read context
+  /// - Parameters:
+  ///   - keys: Keys to look up
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - context: Read context owned by the calling thread or task
+  ///   - sortedInput: Set when `keys` are already in ascending byte order
+  /// - Returns: Copied values in the same order as `keys`, nil for missing keys
+  /// - Throws: RocksDBError if any lookup fails with an error other than not found
+  public func multiGet(
+    _ keys: [Data],
+    in columnFamily: RocksDBColumnFamily? = nil,
+    context: RocksDBReadContext,
+    sortedInput: Bool = false
+  ) throws -> [Data?] {
+    try lock.withReadLock {
       guard let h = handle else {
-        return false
+        throw RocksDBError.databaseClosed
       }
 
-      let readOpts = options.createHandle()
-      defer { rocksdb_read_options_destroy(readOpts) }
+      if keys.isEmpty {
+        return []
+      }
 
-      return key.withUnsafeBytes { keyPtr in
-        rocksdb_key_may_exist(h, readOpts,
-                              keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
-                              key.count) != 0
+      let cf = try familyHandle(columnFamily)
+      defer { rocksdb_read_context_reset(context.handle) }
+
+      var values = [UnsafePointer<CChar>?](repeating: nil, count: keys.count)
+      var lengths = [Int](repeating: 0, count: keys.count)
+      var statuses = [RocksDBStatus](repeating: RocksDBStatus(), count: keys.count)
+
+      keys.withPackedKeys { keyPtrs, keyLens in
+        rocksdb_read_context_multi_get(h, cf, context.handle, keys.count, keyPtrs, keyLens,
+                                       sortedInput ? 1 : 0, &values, &lengths, &statuses)
+      }
+
+      var firstError: RocksDBError?
+      var results: [Data?] = []
+      results.reserveCapacity(keys.count)
+
+      for i in 0..<keys.count {
+        let status = statuses[i]
+        if status.code == RocksDBStatusOK {
+          results.append(values[i].map { Data(bytes: $0, count: lengths[i]) } ?? Data())
+          continue
+        }
+
+        if status.code != RocksDBStatusNotFound && firstError == nil {
+          firstError = RocksDBError.from(status)
+        }
+        if let msg = status.message {
+          rocksdb_free_string(msg)
+        }
+        results.append(nil)
+      }
+
+      if let error = firstError {
+        throw error
       }
+      return results
     }
   }
 
-  // MARK: - String Convenience Methods
+  /// Delete a key
+  /// - Parameters:
+  ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Write options
+  /// - Throws: RocksDBError on failure
+  public func delete(
+    _ key: Data,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBWriteOptions = .default
+  ) throws {
+    try key.withUnsafeBytes { try deleteBytes($0, in: columnFamily, options: options) }
+  }
 
-  /// Put string value for string key
-  public func put(_ value: String, forKey key: String, options: RocksDBWriteOptions = .default) throws {
-    guard let keyData = key.data(using: .utf8),
-          let valueData = value.data(using: .utf8) else {
-      throw RocksDBError.invalidArgument("Invalid UTF-8 encoding")
+  /// Put shared by the `Data`, `String` and typed-key overloads
+  private func putBytes(
+    _ value: UnsafeRawBufferPointer,
+    forKey key: UnsafeRawBufferPointer,
+    in columnFamily: RocksDBColumnFamily?,
+    options: RocksDBWriteOptions
+  ) throws {
+    let traceStart = RocksDBTracing.begin()
+    defer { RocksDBTracing.end(.put, traceStart) }
+
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let cf = try familyHandle(columnFamily)
+      try RocksDBError.check(rocksdb_put_cf(h, cf, options.handle,
+                                            key.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                            key.count,
+                                            value.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                            value.count))
     }
-    try put(valueData, forKey: keyData, options: options)
   }
 
-  /// Get string value for string key
-  public func getString(_ key: String, options: RocksDBReadOptions = .default) throws -> String? {
-    guard let keyData = key.data(using: .utf8) else {
-      throw RocksDBError.invalidArgument("Invalid key encoding")
-    }
-    guard let data = try get(keyData, options: options) else {
-      return nil
+  /// Merge shared by the `Data`, `String` and typed-key overloads
+  private func mergeBytes(
+    _ value: UnsafeRawBufferPointer,
+    forKey key: UnsafeRawBufferPointer,
+    in columnFamily: RocksDBColumnFamily?,
+    options: RocksDBWriteOptions
+  ) throws {
+    let traceStart = RocksDBTracing.begin()
+    defer { RocksDBTracing.end(.merge, traceStart) }
+
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let cf = try familyHandle(columnFamily)
+      try RocksDBError.check(rocksdb_merge_cf(h, cf, options.handle,
+                                              key.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                              key.count,
+                                              value.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                              value.count))
     }
-    return String(data: data, encoding: .utf8)
   }
 
-  /// Delete string key
-  public func delete(_ key: String, options: RocksDBWriteOptions = .default) throws {
-    guard let keyData = key.data(using: .utf8) else {
-      throw RocksDBError.invalidArgument("Invalid key encoding")
+  /// Delete shared by the `Data`, `String` and typed-key overloads
+  private func deleteBytes(
+    _ key: UnsafeRawBufferPointer,
+    in columnFamily: RocksDBColumnFamily?,
+    options: RocksDBWriteOptions
+  ) throws {
+    let traceStart = RocksDBTracing.begin()
+    defer { RocksDBTracing.end(.delete, traceStart) }
+
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let cf = try familyHandle(columnFamily)
+      try RocksDBError.check(rocksdb_delete_cf(h, cf, options.handle,
+                                               key.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                               key.count))
     }
-    try delete(keyData, options: options)
   }
 
-  // MARK: - Batch Operations
-
-  /// Execute a batch of operations atomically
+  /// Delete a key that was written exactly once since it was last deleted
+  ///
+  /// The tombstone and the put it covers cancel as soon as they meet in
+  /// compaction instead of surviving to the bottom level, which keeps scans
+  /// over write-once/delete-once tables free of tombstones. Using it on a
+  /// key that was overwritten or merged leaves the result undefined.
   /// - Parameters:
+  ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
   ///   - options: Write options
-  ///   - operations: Closure receiving a batch to add operations to
   /// - Throws: RocksDBError on failure
-  public func batch(
-    options: RocksDBWriteOptions = .default,
-    _ operations: (RocksDBBatch) throws -> Void
+  public func singleDelete(
+    _ key: Data,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBWriteOptions = .default
   ) throws {
-    let batch = RocksDBBatch()
-    try operations(batch)
-    try writeBatch(batch, options: options)
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let cf = try familyHandle(columnFamily)
+      let writeOpts = options.handle
+
+      let status = key.withUnsafeBytes { keyPtr in
+        rocksdb_single_delete_cf(h, cf, writeOpts,
+                                 keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                 key.count)
+      }
+      try RocksDBError.check(status)
+    }
   }
 
-  /// Write a batch to the database
+  /// Delete all keys in `[startKey, endKey)` with a single range tombstone
+  ///
+  /// The cost does not depend on the number of keys; space is reclaimed as
+  /// compaction drops the covered data (see `purgeRange` to do it now).
   /// - Parameters:
-  ///   - batch: Batch to write
+  ///   - startKey: Start of range (inclusive)
+  ///   - endKey: End of range (exclusive)
+  ///   - columnFamily: Column family (nil for the default family)
   ///   - options: Write options
   /// - Throws: RocksDBError on failure
-  public func writeBatch(_ batch: RocksDBBatch, options: RocksDBWriteOptions = .default) throws {
-    try lock.withLock {
+  public func deleteRange(
+    from startKey: Data,
+    to endKey: Data,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBWriteOptions = .default
+  ) throws {
+    try lock.withReadLock {
       guard let h = handle else {
         throw RocksDBError.databaseClosed
       }
 
-      let writeOpts = options.createHandle()
-      defer { rocksdb_write_options_destroy(writeOpts) }
+      let cf = try familyHandle(columnFamily)
+      let writeOpts = options.handle
 
-      let status = rocksdb_write_batch(h, writeOpts, batch.handle)
+      let status = startKey.withUnsafeBytes { startPtr in
+        endKey.withUnsafeBytes { endPtr in
+          rocksdb_delete_range_cf(h, cf, writeOpts,
+                                  startPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                  startKey.count,
+                                  endPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                  endKey.count)
+        }
+      }
       try RocksDBError.check(status)
     }
   }
 
-  // MARK: - Transaction Operations
+  /// Check if key may exist (bloom filter check, may have false positives)
+  /// - Parameters:
+  ///   - key: Key data
+  ///   - options: Read options
+  /// - Returns: true if key may exist
+  public func keyMayExist(_ key: Data, options: RocksDBReadOptions = .default) -> Bool {
+    lock.withReadLock {
+      guard let h = handle else {
+        return false
+      }
 
-  /// Execute a transaction with automatic commit/rollback
+      let readOpts = options.handle
+
+      return key.withUnsafeBytes { keyPtr in
+        rocksdb_key_may_exist(h, readOpts,
+                              keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                              key.count) != 0
+      }
+    }
+  }
+
+  /// Check if key may exist, returning its value when it is already in memory
+  ///
+  /// Costs about as much as `keyMayExist`, but a key found in a memtable or
+  /// the block cache comes back with its value instead of needing a `get`.
   /// - Parameters:
-  ///   - options: Write options for the transaction
-  ///   - operation: Closure receiving a transaction to perform operations
-  /// - Returns: Result of the operation closure
-  /// - Throws: RocksDBError on failure or if not a transactional database
-  public func transaction<T>(
-    options: RocksDBWriteOptions = .default,
-    _ operation: (RocksDBTransaction) throws -> T
-  ) throws -> T {
-    guard isTransactional else {
-      throw RocksDBError.notSupported("Database not opened with transaction support")
+  ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options
+  /// - Returns: Absent, maybe present, or present with a copy of the value
+  /// - Throws: RocksDBError if the database is closed
+  public func keyExistence(
+    _ key: Data,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBReadOptions = .default
+  ) throws -> RocksDBKeyExistence<Data> {
+    try withKeyExistence(key, in: columnFamily, options: options) { Data($0) }
+  }
+
+  /// Check if key may exist, lending its value to `body` when it is already in memory
+  /// - Parameters:
+  ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options
+  ///   - body: Closure reading the value; the bytes are only valid inside it
+  /// - Returns: Absent, maybe present, or present with the result of `body`
+  /// - Throws: RocksDBError if the database is closed, or the error thrown by `body`
+  public func withKeyExistence<R>(
+    _ key: Data,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBReadOptions = .default,
+    _ body: (UnsafeRawBufferPointer) throws -> R
+  ) throws -> RocksDBKeyExistence<R> {
+    // Like getPinned, the slice retains the native database, so body runs
+    // after the lock is released
+    let (existence, slice): (RocksDBKeyExistenceCode, RocksDBPinnableSliceRef?) = try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let cf = try familyHandle(columnFamily)
+      var slice: RocksDBPinnableSliceRef?
+      let existence = key.withUnsafeBytes { keyPtr in
+        rocksdb_key_may_exist_value_cf(h, cf, options.handle,
+                                       keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                       key.count, &slice)
+      }
+      return (existence, slice)
     }
 
-    let txn = try beginTransaction(options: options)
+    switch existence {
+    case RocksDBKeyAbsent:
+      return .absent
+    case RocksDBKeyPresent:
+      guard let slice else { return .maybePresent }
+      defer { rocksdb_pinnable_slice_destroy(slice) }
 
-    do {
-      let result = try operation(txn)
-      try txn.commit()
-      return result
-    } catch {
-      txn.rollback()
-      throw error
+      var valueLen: Int = 0
+      let ptr = rocksdb_pinnable_slice_value(slice, &valueLen)
+      return .present(try body(UnsafeRawBufferPointer(start: ptr, count: ptr == nil ? 0 : valueLen)))
+    default:
+      return .maybePresent
     }
   }
 
-  /// Begin a new transaction
-  /// - Parameter options: Write options for the transaction
-  /// - Returns: New transaction
+  /// Check many keys for existence from memtables, filters and the block cache
+  ///
+  /// Runs one batched lookup that never reads from disk, so keys ruled out
+  /// by bloom or ribbon filters cost only filter memory. With `verify`, the
+  /// keys that could not be decided are then looked up exactly with one
+  /// `multiGet`, which may read data blocks.
+  /// - Parameters:
+  ///   - keys: Keys to check
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options (the read tier is overridden for the first pass)
+  ///   - sortedInput: Keys are already in comparator order
+  ///   - verify: Resolve undecided keys with an exact lookup
+  /// - Returns: For each key, whether it may exist (whether it exists with `verify`)
   /// - Throws: RocksDBError on failure
-  public func beginTransaction(options: RocksDBWriteOptions = .default) throws -> RocksDBTransaction {
-    try lock.withLock {
+  public func keysMayExist(
+    _ keys: [Data],
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBReadOptions = .default,
+    sortedInput: Bool = false,
+    verify: Bool = false
+  ) throws -> [Bool] {
+    if keys.isEmpty {
+      return []
+    }
+
+    let codes: [RocksDBKeyExistenceCode] = try lock.withReadLock {
       guard let h = handle else {
         throw RocksDBError.databaseClosed
       }
 
-      guard isTransactional else {
-        throw RocksDBError.notSupported("Database not opened with transaction support")
+      let cf = try familyHandle(columnFamily)
+      var codes = [RocksDBKeyExistenceCode](repeating: RocksDBKeyMaybePresent, count: keys.count)
+      keys.withPackedKeys { keyPtrs, keyLens in
+        rocksdb_keys_may_exist_cf(h, cf, options.handle, keys.count, keyPtrs, keyLens,
+                                  sortedInput ? 1 : 0, &codes)
       }
+      return codes
+    }
 
-      let writeOpts = options.createHandle()
-      defer { rocksdb_write_options_destroy(writeOpts) }
+    var results = codes.map { $0 != RocksDBKeyAbsent }
+    guard verify else {
+      return results
+    }
 
-      guard let txnHandle = rocksdb_transaction_begin(h, writeOpts) else {
-        throw RocksDBError.ioError("Failed to begin transaction")
+    let undecided = codes.indices.filter { codes[$0] == RocksDBKeyMaybePresent }
+    if !undecided.isEmpty {
+      let values = try multiGet(undecided.map { keys[$0] }, in: columnFamily, options: options,
+                                sortedInput: sortedInput)
+      for (index, value) in zip(undecided, values) {
+        results[index] = value != nil
       }
-
-      return RocksDBTransaction(handle: txnHandle)
     }
+    return results
   }
 
-  // MARK: - Iterator Operations
+  /// Get values for many keys without blocking on disk
+  ///
+  /// Runs one `multiGet` limited to `options.readTier`, or to memtables and
+  /// the block cache when that is `.all`. Keys whose lookup would need I/O
+  /// come back `maybePresent`, so the caller can fetch them with `multiGet`
+  /// off the latency-critical thread.
+  /// - Parameters:
+  ///   - keys: Keys to look up
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options
+  ///   - sortedInput: Set when `keys` are already in ascending byte order
+  /// - Returns: Results in the same order as `keys`
+  /// - Throws: RocksDBError if any lookup fails with an error other than
+  ///   not found or needing I/O
+  public func multiGetCached(
+    _ keys: [Data],
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBReadOptions = .default,
+    sortedInput: Bool = false
+  ) throws -> [RocksDBKeyExistence<Data>] {
+    if keys.isEmpty {
+      return []
+    }
 
-  /// Create an iterator for the database
-  /// - Parameter options: Read options
-  /// - Returns: Database iterator
-  /// - Throws: RocksDBError on failure
-  public func makeIterator(options: RocksDBReadOptions = .default) throws -> RocksDBIterator {
-    try lock.withLock {
+    var tieredOptions = options
+    if options.isDefault {
+      tieredOptions = Self.blockCacheTierOptions
+    } else if options.readTier == .all {
+      tieredOptions.readTier = .blockCache
+    }
+
+    return try lock.withReadLock {
       guard let h = handle else {
         throw RocksDBError.databaseClosed
       }
 
-      let readOpts = options.createHandle()
-      defer { rocksdb_read_options_destroy(readOpts) }
+      let cf = try familyHandle(columnFamily)
+      var pinned = [RocksDBPinnableSliceRef?](repeating: nil, count: keys.count)
+      var statuses = [RocksDBStatus](repeating: RocksDBStatus(), count: keys.count)
+      keys.withPackedKeys { keyPtrs, keyLens in
+        rocksdb_multi_get_cf(h, cf, tieredOptions.handle, keys.count, keyPtrs, keyLens,
+                             sortedInput ? 1 : 0, &pinned, &statuses)
+      }
 
-      guard let iterHandle = rocksdb_iterator_create(h, readOpts) else {
-        throw RocksDBError.ioError("Failed to create iterator")
+      var firstError: RocksDBError?
+      var results: [RocksDBKeyExistence<Data>] = []
+      results.reserveCapacity(keys.count)
+
+      for i in 0..<keys.count {
+        let status = statuses[i]
+        switch status.code {
+        case RocksDBStatusOK:
+          results.append(pinned[i].map { .present(RocksDB.data(copyingPinned: $0)) } ?? .maybePresent)
+          continue
+        case RocksDBStatusNotFound:
+          results.append(.absent)
+        case RocksDBStatusIncomplete:
+          results.append(.maybePresent)
+        default:
+          if firstError == nil {
+            firstError = RocksDBError.from(status)
+          }
+          results.append(.maybePresent)
+        }
+        if let msg = status.message {
+          rocksdb_free_string(msg)
+        }
       }
 
-      return RocksDBIterator(handle: iterHandle)
+      if let error = firstError {
+        throw error
+      }
+      return results
     }
   }
 
-  /// Iterate over all key-value pairs
-  /// - Parameter body: Closure called for each key-value pair, return false to stop
+  /// Shared cache-only options for `multiGetCached` calls passing the defaults
+  private static let blockCacheTierOptions: RocksDBReadOptions = {
+    var options = RocksDBReadOptions()
+    options.readTier = .blockCache
+    return options
+  }()
+
+  // MARK: - User-Defined Timestamps
+
+  /// Write a version of key at a user timestamp
+  ///
+  /// Requires a family opened with `.bytewiseWithU64Timestamp`. Older
+  /// versions stay readable through `get(_:asOf:)` until compaction drops
+  /// them after `increaseFullHistoryTimestampLow(to:)`.
+  /// - Parameters:
+  ///   - value: Value data
+  ///   - key: Key data
+  ///   - timestamp: Version timestamp
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Write options
   /// - Throws: RocksDBError on failure
-  public func forEach(_ body: (Data, Data) throws -> Bool) throws {
-    let iter = try makeIterator()
-    defer { iter.close() }
+  public func put(
+    _ value: Data,
+    forKey key: Data,
+    timestamp: UInt64,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBWriteOptions = .default
+  ) throws {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
 
-    iter.seekToFirst()
-    while iter.isValid {
-      guard let key = iter.key, let value = iter.value else { break }
-      if try !body(key, value) { break }
-      iter.next()
+      let cf = try familyHandle(columnFamily)
+      let writeOpts = options.handle
+
+      let status = key.withUnsafeBytes { keyPtr in
+        value.withUnsafeBytes { valuePtr in
+          rocksdb_put_with_timestamp_cf(h, cf, writeOpts,
+                                        keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                        key.count,
+                                        timestamp,
+                                        valuePtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                        value.count)
+        }
+      }
+      try RocksDBError.check(status)
     }
-    try iter.checkStatus()
   }
 
-  /// Iterate over key-value pairs with a key prefix
+  /// Delete key as of a user timestamp; reads at older timestamps still see it
   /// - Parameters:
-  ///   - prefix: Key prefix to match
-  ///   - body: Closure called for each matching key-value pair, return false to stop
+  ///   - key: Key data
+  ///   - timestamp: Timestamp of the tombstone
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Write options
   /// - Throws: RocksDBError on failure
-  public func forEachWithPrefix(_ prefix: Data, _ body: (Data, Data) throws -> Bool) throws {
-    let iter = try makeIterator()
-    defer { iter.close() }
+  public func delete(
+    _ key: Data,
+    timestamp: UInt64,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBWriteOptions = .default
+  ) throws {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let cf = try familyHandle(columnFamily)
+      let writeOpts = options.handle
 
-    iter.seek(to: prefix)
-    while iter.isValid {
-      guard let key = iter.key, let value = iter.value else { break }
-      // Check prefix match
-      guard key.count >= prefix.count && key.prefix(prefix.count) == prefix else { break }
-      if try !body(key, value) { break }
-      iter.next()
+      let status = key.withUnsafeBytes { keyPtr in
+        rocksdb_delete_with_timestamp_cf(h, cf, writeOpts,
+                                         keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                         key.count,
+                                         timestamp)
+      }
+      try RocksDBError.check(status)
     }
-    try iter.checkStatus()
   }
 
-  // MARK: - Maintenance Operations
-
-  /// Compact a range of keys
+  /// Read the newest version of key written at or below a user timestamp
+  ///
+  /// Point-in-time reads need no snapshot, so long-running readers do not
+  /// pin memtables or SST files. `readTimestamp` overrides
+  /// `options.timestamp`.
   /// - Parameters:
-  ///   - startKey: Start of range (nil for beginning)
-  ///   - endKey: End of range (nil for end)
+  ///   - key: Key data
+  ///   - readTimestamp: Upper bound on version timestamps (`.max` for the newest)
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options
+  /// - Returns: Value and the timestamp it was written at, or nil if not found
   /// - Throws: RocksDBError on failure
-  public func compactRange(from startKey: Data? = nil, to endKey: Data? = nil) throws {
-    try lock.withLock {
+  public func get(
+    _ key: Data,
+    asOf readTimestamp: UInt64,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBReadOptions = .default
+  ) throws -> (value: Data, timestamp: UInt64)? {
+    try lock.withReadLock {
       guard let h = handle else {
         throw RocksDBError.databaseClosed
       }
 
-      let status: RocksDBStatus
+      let cf = try familyHandle(columnFamily)
+      let readOpts = options.handle
 
-      if let start = startKey, let end = endKey {
-        status = start.withUnsafeBytes { startPtr in
-          end.withUnsafeBytes { endPtr in
-            rocksdb_compact_range(h,
-                                  startPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
-                                  start.count,
-                                  endPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
-                                  end.count)
-          }
-        }
-      } else if let start = startKey {
-        status = start.withUnsafeBytes { startPtr in
-          rocksdb_compact_range(h,
-                                startPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
-                                start.count,
-                                nil, 0)
-        }
-      } else if let end = endKey {
-        status = end.withUnsafeBytes { endPtr in
-          rocksdb_compact_range(h, nil, 0,
-                                endPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
-                                end.count)
+      var pinned: RocksDBPinnableSliceRef?
+      var timestamp: UInt64 = 0
+
+      let status = key.withUnsafeBytes { keyPtr in
+        rocksdb_get_pinned_with_timestamp_cf(h, cf, readOpts, readTimestamp,
+                                             keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                             key.count,
+                                             &pinned, &timestamp)
+      }
+
+      // NotFound is not an error, just return nil
+      if status.code == RocksDBStatusNotFound {
+        if let msg = status.message {
+          rocksdb_free_string(msg)
         }
-      } else {
-        status = rocksdb_compact_range(h, nil, 0, nil, 0)
+        return nil
       }
 
       try RocksDBError.check(status)
+      guard let slice = pinned else { return nil }
+      return (RocksDB.data(copyingPinned: slice), timestamp)
     }
   }
 
-  /// Flush the database
-  /// - Parameter wait: Wait for flush to complete
-  /// - Throws: RocksDBError on failure
-  public func flush(wait: Bool = true) throws {
-    try lock.withLock {
+  /// Allow compaction to garbage collect versions older than timestamp
+  ///
+  /// Reads below the new low watermark fail afterwards. The watermark can
+  /// only move forward.
+  /// - Parameters:
+  ///   - timestamp: New low watermark
+  ///   - columnFamily: Column family (nil for the default family)
+  /// - Throws: RocksDBError on failure, including a lower timestamp than the current one
+  public func increaseFullHistoryTimestampLow(
+    to timestamp: UInt64,
+    in columnFamily: RocksDBColumnFamily? = nil
+  ) throws {
+    try lock.withReadLock {
       guard let h = handle else {
         throw RocksDBError.databaseClosed
       }
 
-      let status = rocksdb_flush(h, wait ? 1 : 0)
-      try RocksDBError.check(status)
+      let cf = try familyHandle(columnFamily)
+      try RocksDBError.check(rocksdb_increase_full_history_ts_low(h, cf, timestamp))
     }
   }
 
-  /// Get a database property value
-  /// - Parameter name: Property name (e.g., "rocksdb.estimate-num-keys")
-  /// - Returns: Property value or nil if not found
-  public func getProperty(_ name: String) -> String? {
-    lock.withLock {
+  /// Current low watermark below which versions may have been garbage collected
+  /// - Parameter columnFamily: Column family (nil for the default family)
+  /// - Returns: Watermark timestamp
+  /// - Throws: RocksDBError on failure
+  public func fullHistoryTimestampLow(in columnFamily: RocksDBColumnFamily? = nil) throws -> UInt64 {
+    try lock.withReadLock {
       guard let h = handle else {
-        return nil
-      }
-
-      guard let ptr = rocksdb_get_property(h, name) else {
-        return nil
+        throw RocksDBError.databaseClosed
       }
-      defer { rocksdb_free_string(ptr) }
 
-      return String(cString: ptr)
+      let cf = try familyHandle(columnFamily)
+      var timestamp: UInt64 = 0
+      try RocksDBError.check(rocksdb_get_full_history_ts_low(h, cf, &timestamp))
+      return timestamp
     }
   }
 
-  /// Estimated number of keys in the database
-  public var estimatedKeyCount: Int? {
-    guard let value = getProperty("rocksdb.estimate-num-keys"),
-          let count = Int(value) else {
-      return nil
+  // MARK: - Wide Columns
+
+  /// Store an entity made of named columns under key
+  ///
+  /// Columns may be given in any order; RocksDB stores them sorted by name.
+  /// A later `put` replaces the entity with a plain value and vice versa.
+  /// - Parameters:
+  ///   - columns: Column names and values
+  ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Write options
+  /// - Throws: RocksDBError on failure
+  public func putEntity(
+    _ columns: [(name: Data, value: Data)],
+    forKey key: Data,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBWriteOptions = .default
+  ) throws {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let cf = try familyHandle(columnFamily)
+      let writeOpts = options.handle
+
+      let status = key.withUnsafeBytes { keyPtr in
+        columns.map(\.name).withPackedKeys { namePtrs, nameLens in
+          columns.map(\.value).withPackedKeys { valuePtrs, valueLens in
+            rocksdb_put_entity_cf(h, cf, writeOpts,
+                                  keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                  key.count,
+                                  columns.count, namePtrs, nameLens, valuePtrs, valueLens)
+          }
+        }
+      }
+      try RocksDBError.check(status)
     }
-    return count
   }
 
-  /// Current memory usage statistics
-  public var memoryUsage: String? {
-    getProperty("rocksdb.cur-size-all-mem-tables")
+  /// Access the columns of an entity in place, without copying them
+  ///
+  /// The view is only valid for the duration of `body`. Use it to read a
+  /// few attributes of a wide entity without materializing the others.
+  /// - Parameters:
+  ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options
+  ///   - body: Closure receiving the column view
+  /// - Returns: Result of `body`, or nil if the key was not found
+  /// - Throws: RocksDBError on failure, or any error thrown by `body`
+  public func withEntity<R>(
+    forKey key: Data,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBReadOptions = .default,
+    _ body: (RocksDBWideColumns) throws -> R
+  ) throws -> R? {
+    // The pinned entity retains the native database, so the lock is only
+    // held for the lookup
+    let pinned: RocksDBWideColumnsRef? = try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let cf = try familyHandle(columnFamily)
+      let readOpts = options.handle
+
+      var columns: RocksDBWideColumnsRef?
+
+      let status = key.withUnsafeBytes { keyPtr in
+        rocksdb_get_entity_cf(h, cf, readOpts,
+                              keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                              key.count,
+                              &columns)
+      }
+
+      // NotFound is not an error, just return nil
+      if status.code == RocksDBStatusNotFound {
+        if let msg = status.message {
+          rocksdb_free_string(msg)
+        }
+        return nil
+      }
+
+      try RocksDBError.check(status)
+      return columns
+    }
+
+    guard let entity = pinned else {
+      return nil
+    }
+    defer { rocksdb_wide_columns_destroy(entity) }
+
+    return try body(RocksDBWideColumns(entity: entity))
+  }
+
+  /// Get all columns of an entity
+  /// - Parameters:
+  ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options
+  /// - Returns: Columns sorted by name, or nil if the key was not found
+  /// - Throws: RocksDBError on failure
+  public func getEntity(
+    _ key: Data,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBReadOptions = .default
+  ) throws -> [(name: Data, value: Data)]? {
+    try withEntity(forKey: key, in: columnFamily, options: options) { $0.copy() }
+  }
+
+  /// Get selected columns of an entity, copying only those
+  /// - Parameters:
+  ///   - names: Column names to fetch
+  ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options
+  /// - Returns: Values in the same order as `names` (nil for absent columns),
+  ///   or nil if the key was not found
+  /// - Throws: RocksDBError on failure
+  public func getColumns(
+    _ names: [Data],
+    forKey key: Data,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBReadOptions = .default
+  ) throws -> [Data?]? {
+    try withEntity(forKey: key, in: columnFamily, options: options) { columns in
+      names.map { name in columns.value(forColumn: name).map { Data($0) } }
+    }
+  }
+
+  // MARK: - Attribute Groups
+
+  /// Store one entity split into attribute groups across column families
+  ///
+  /// All groups are written atomically.
+  /// - Parameters:
+  ///   - groups: Groups, each with its family and columns
+  ///   - key: Key data
+  ///   - options: Write options
+  /// - Throws: RocksDBError on failure
+  public func putEntity(
+    groups: [RocksDBAttributeGroup],
+    forKey key: Data,
+    options: RocksDBWriteOptions = .default
+  ) throws {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      guard !groups.isEmpty else {
+        throw RocksDBError.invalidArgument("An entity needs at least one attribute group")
+      }
+      for group in groups {
+        _ = try familyHandle(group.columnFamily)
+      }
+      let writeOpts = options.handle
+
+      let status = key.withUnsafeBytes { keyPtr in
+        groups.withFlattenedColumns { families, counts, names, nameLens, values, valueLens in
+          rocksdb_put_attribute_groups(h, writeOpts,
+                                       keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                       key.count,
+                                       groups.count, families, counts,
+                                       names, nameLens, values, valueLens)
+        }
+      }
+      try RocksDBError.check(status)
+    }
+  }
+
+  /// Access the attribute groups of an entity in place
+  ///
+  /// Only the listed families are read, so a hot group in a small,
+  /// cache-resident family can be fetched without touching a cold one.
+  /// - Parameters:
+  ///   - key: Key data
+  ///   - columnFamilies: Families to read the key's groups from
+  ///   - options: Read options
+  ///   - body: Closure receiving one view per family, nil where the family
+  ///     has no entity for key; views are only valid inside `body`
+  /// - Returns: Result of `body`
+  /// - Throws: RocksDBError on failure, or any error thrown by `body`
+  public func withAttributeGroups<R>(
+    forKey key: Data,
+    in columnFamilies: [RocksDBColumnFamily],
+    options: RocksDBReadOptions = .default,
+    _ body: ([RocksDBWideColumns?]) throws -> R
+  ) throws -> R {
+    // Like pinned values, the groups retain the native database
+    let groups: RocksDBAttributeGroupsRef? = try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let families = try columnFamilies.map { try familyHandle($0) }
+      let readOpts = options.handle
+
+      var groups: RocksDBAttributeGroupsRef?
+
+      let status = key.withUnsafeBytes { keyPtr in
+        families.withUnsafeBufferPointer { familyPtrs in
+          rocksdb_get_attribute_groups(h, readOpts,
+                                       keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                       key.count,
+                                       families.count, familyPtrs.baseAddress,
+                                       &groups)
+        }
+      }
+      try RocksDBError.check(status)
+      return groups
+    }
+
+    guard let pinned = groups else {
+      return try body(Array(repeating: nil, count: columnFamilies.count))
+    }
+    defer { rocksdb_attribute_groups_destroy(pinned) }
+
+    var views: [RocksDBWideColumns?] = []
+    views.reserveCapacity(columnFamilies.count)
+    for group in 0..<columnFamilies.count {
+      let status = rocksdb_attribute_group_status(pinned, group)
+      if status.code == RocksDBStatusNotFound {
+        if let msg = status.message {
+          rocksdb_free_string(msg)
+        }
+        views.append(nil)
+        continue
+      }
+      try RocksDBError.check(status)
+      views.append(RocksDBWideColumns(groups: pinned, group: group))
+    }
+    return try body(views)
+  }
+
+  /// Get the attribute groups of an entity from the given families
+  /// - Parameters:
+  ///   - key: Key data
+  ///   - columnFamilies: Families to read the key's groups from
+  ///   - options: Read options
+  /// - Returns: Groups found, in the order of `columnFamilies`
+  /// - Throws: RocksDBError on failure
+  public func getAttributeGroups(
+    _ key: Data,
+    in columnFamilies: [RocksDBColumnFamily],
+    options: RocksDBReadOptions = .default
+  ) throws -> [RocksDBAttributeGroup] {
+    try withAttributeGroups(forKey: key, in: columnFamilies, options: options) { views in
+      zip(columnFamilies, views).compactMap { family, view in
+        view.map { RocksDBAttributeGroup(columnFamily: family, columns: $0.copy()) }
+      }
+    }
+  }
+
+  /// Create an iterator over several families that yields attribute groups per key
+  /// - Parameters:
+  ///   - columnFamilies: Families to iterate
+  ///   - options: Read options
+  /// - Returns: Attribute group iterator
+  /// - Throws: RocksDBError on failure
+  public func makeAttributeGroupIterator(
+    over columnFamilies: [RocksDBColumnFamily],
+    options: RocksDBReadOptions = .default
+  ) throws -> RocksDBAttributeGroupIterator {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let families = try columnFamilies.map { try familyHandle($0) }
+      let readOpts = options.handle
+
+      let iterHandle = families.withUnsafeBufferPointer { familyPtrs in
+        rocksdb_attribute_group_iterator_create(h, readOpts, families.count, familyPtrs.baseAddress)
+      }
+      guard let iterHandle = iterHandle else {
+        throw RocksDBError.ioError("Failed to create attribute group iterator")
+      }
+
+      return RocksDBAttributeGroupIterator(handle: iterHandle, columnFamilies: columnFamilies)
+    }
+  }
+
+  // MARK: - String Convenience Methods
+  //
+  // Strings reach the bridge as their UTF-8 storage and values decode
+  // straight from the pinned buffer, so no `Data` is built on either side.
+
+  /// Put string value for string key
+  public func put(_ value: String, forKey key: String, options: RocksDBWriteOptions = .default) throws {
+    try key.withUTF8Bytes { keyPtr in
+      try value.withUTF8Bytes { try putBytes($0, forKey: keyPtr, in: nil, options: options) }
+    }
+  }
+
+  /// Get string value for string key (nil if missing or not valid UTF-8)
+  public func getString(_ key: String, options: RocksDBReadOptions = .default) throws -> String? {
+    let traceStart = RocksDBTracing.begin()
+    defer { RocksDBTracing.end(.get, traceStart) }
+
+    return try withValue(forKey: key, options: options) { String(validatingUTF8Bytes: $0) } ?? nil
+  }
+
+  /// Access the value for a string key in place
+  public func withValue<R>(
+    forKey key: String,
+    options: RocksDBReadOptions = .default,
+    _ body: (UnsafeRawBufferPointer) throws -> R
+  ) throws -> R? {
+    guard let slice = try key.withUTF8Bytes({ try getPinned($0, in: nil, options: options) }) else {
+      return nil
+    }
+    defer { rocksdb_pinnable_slice_destroy(slice) }
+
+    var valueLen: Int = 0
+    let ptr = rocksdb_pinnable_slice_value(slice, &valueLen)
+    return try body(UnsafeRawBufferPointer(start: ptr, count: ptr == nil ? 0 : valueLen))
+  }
+
+  /// Merge string operand into the value for string key
+  public func merge(_ value: String, forKey key: String, options: RocksDBWriteOptions = .default) throws {
+    try key.withUTF8Bytes { keyPtr in
+      try value.withUTF8Bytes { try mergeBytes($0, forKey: keyPtr, in: nil, options: options) }
+    }
+  }
+
+  /// Delete string key
+  public func delete(_ key: String, options: RocksDBWriteOptions = .default) throws {
+    try key.withUTF8Bytes { try deleteBytes($0, in: nil, options: options) }
+  }
+
+  // MARK: - Typed Keys
+
+  /// Put a key-value pair under a typed key, encoded without allocating
+  /// - Parameters:
+  ///   - value: Value data
+  ///   - key: Key, written in its order-preserving encoding
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Write options
+  /// - Throws: RocksDBError on failure
+  public func put<Key: RocksDBKeyEncodable>(
+    _ value: Data,
+    forKey key: Key,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBWriteOptions = .default
+  ) throws {
+    try key.withEncodedKey { keyPtr in
+      try value.withUnsafeBytes { try putBytes($0, forKey: keyPtr, in: columnFamily, options: options) }
+    }
+  }
+
+  /// Merge an operand into the value for a typed key
+  /// - Throws: RocksDBError on failure (e.g. no merge operator configured)
+  public func merge<Key: RocksDBKeyEncodable>(
+    _ value: Data,
+    forKey key: Key,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBWriteOptions = .default
+  ) throws {
+    try key.withEncodedKey { keyPtr in
+      try value.withUnsafeBytes { try mergeBytes($0, forKey: keyPtr, in: columnFamily, options: options) }
+    }
+  }
+
+  /// Get the value for a typed key
+  /// - Returns: Value data or nil if not found
+  /// - Throws: RocksDBError on failure
+  public func get<Key: RocksDBKeyEncodable>(
+    _ key: Key,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBReadOptions = .default
+  ) throws -> Data? {
+    let traceStart = RocksDBTracing.begin()
+    defer { RocksDBTracing.end(.get, traceStart) }
+
+    guard let slice = try key.withEncodedKey({ try getPinned($0, in: columnFamily, options: options) }) else {
+      return nil
+    }
+    return RocksDB.data(copyingPinned: slice)
+  }
+
+  /// Access the value for a typed key in place; see `withValue(forKey:in:options:_:)`
+  /// - Returns: Result of `body`, or nil if the key was not found
+  /// - Throws: RocksDBError on failure, or any error thrown by `body`
+  public func withValue<Key: RocksDBKeyEncodable, R>(
+    forKey key: Key,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBReadOptions = .default,
+    _ body: (UnsafeRawBufferPointer) throws -> R
+  ) throws -> R? {
+    guard let slice = try key.withEncodedKey({ try getPinned($0, in: columnFamily, options: options) }) else {
+      return nil
+    }
+    defer { rocksdb_pinnable_slice_destroy(slice) }
+
+    var valueLen: Int = 0
+    let ptr = rocksdb_pinnable_slice_value(slice, &valueLen)
+    return try body(UnsafeRawBufferPointer(start: ptr, count: ptr == nil ? 0 : valueLen))
+  }
+
+  /// Delete a typed key
+  /// - Throws: RocksDBError on failure
+  public func delete<Key: RocksDBKeyEncodable>(
+    _ key: Key,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBWriteOptions = .default
+  ) throws {
+    try key.withEncodedKey { try deleteBytes($0, in: columnFamily, options: options) }
+  }
+
+  // MARK: - Batch Operations
+
+  /// Execute a batch of operations atomically
+  ///
+  /// The batch comes from `batchPool` and is returned to it afterwards, so
+  /// it must not be used outside the closure.
+  /// - Parameters:
+  ///   - options: Write options
+  ///   - operations: Closure receiving a batch to add operations to
+  /// - Throws: RocksDBError on failure
+  public func batch(
+    options: RocksDBWriteOptions = .default,
+    _ operations: (RocksDBBatch) throws -> Void
+  ) throws {
+    try batchPool.withBatch { batch in
+      try operations(batch)
+      try writeBatch(batch, options: options)
+    }
+  }
+
+  /// Write a batch to the database
+  /// - Parameters:
+  ///   - batch: Batch to write
+  ///   - options: Write options
+  /// - Throws: RocksDBError on failure
+  public func writeBatch(_ batch: RocksDBBatch, options: RocksDBWriteOptions = .default) throws {
+    let traceStart = RocksDBTracing.begin()
+    defer { RocksDBTracing.end(.writeBatch, traceStart) }
+
+    // Validated before taking the database lock: adding a family operation
+    // takes the batch lock and then this lock, so never nest them the other way
+    try batch.validate(writingTo: self)
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let writeOpts = options.handle
+
+      let status = rocksdb_write_batch(h, writeOpts, batch.handle)
+      try RocksDBError.check(status)
+    }
+  }
+
+  /// Write a builder's operations atomically, consuming the builder
+  ///
+  /// The builder is released whether or not the write succeeds.
+  /// - Parameters:
+  ///   - builder: Batch to write
+  ///   - options: Write options
+  /// - Throws: RocksDBError on failure
+  public func writeBatch(_ builder: consuming RocksDBBatchBuilder, options: RocksDBWriteOptions = .default) throws {
+    let traceStart = RocksDBTracing.begin()
+    defer { RocksDBTracing.end(.writeBatch, traceStart) }
+
+    let batchHandle = builder.handle
+    try builder.families.check(writingTo: self)
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let status = rocksdb_write_batch(h, options.handle, batchHandle)
+      try RocksDBError.check(status)
+    }
+  }
+
+  /// Write an indexed batch atomically
+  /// - Parameters:
+  ///   - batch: Batch to write
+  ///   - options: Write options
+  /// - Throws: RocksDBError on failure
+  public func writeBatch(_ batch: RocksDBIndexedBatch, options: RocksDBWriteOptions = .default) throws {
+    try batch.validate(writingTo: self)
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let writeOpts = options.handle
+
+      let status = rocksdb_write_indexed_batch(h, writeOpts, batch.handle)
+      try RocksDBError.check(status)
+    }
+  }
+
+  /// Read key as it will be once batch is written
+  ///
+  /// Staged puts, deletes and merge operands are applied on top of the
+  /// database value, so the batch can be consulted while it is being built.
+  /// - Parameters:
+  ///   - key: Key data
+  ///   - batch: Batch whose staged writes are overlaid
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options
+  /// - Returns: Value data or nil if not found
+  /// - Throws: RocksDBError on failure
+  public func get(
+    _ key: Data,
+    stagedIn batch: RocksDBIndexedBatch,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBReadOptions = .default
+  ) throws -> Data? {
+    try batch.validate(writingTo: self)
+    return try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let cf = try familyHandle(columnFamily)
+      let readOpts = options.handle
+
+      var pinned: RocksDBPinnableSliceRef?
+
+      let status = key.withUnsafeBytes { keyPtr in
+        rocksdb_indexed_batch_get_pinned_cf(h, cf, readOpts, batch.handle,
+                                            keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                            key.count,
+                                            &pinned)
+      }
+
+      // NotFound is not an error, just return nil
+      if status.code == RocksDBStatusNotFound {
+        if let msg = status.message {
+          rocksdb_free_string(msg)
+        }
+        return nil
+      }
+
+      try RocksDBError.check(status)
+      return pinned.map { RocksDB.data(copyingPinned: $0) }
+    }
+  }
+
+  // MARK: - External File Ingestion
+
+  /// Atomically ingest SST files built with `RocksDBSstFileWriter`
+  /// - Parameters:
+  ///   - paths: Paths of the SST files to ingest
+  ///   - options: Ingest options
+  /// - Throws: RocksDBError on failure
+  public func ingestExternalFiles(_ paths: [String], options: RocksDBIngestOptions = .default) throws {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let ingestOpts = options.createHandle()
+      defer { rocksdb_ingest_options_destroy(ingestOpts) }
+
+      let status = paths.withCStringPointers { pathPtrs in
+        rocksdb_ingest_external_file(h, pathPtrs, paths.count, ingestOpts)
+      }
+      try RocksDBError.check(status)
+    }
+  }
+
+  /// Write a key range to SST files another database can ingest
+  ///
+  /// Streams one bounded iterator into `SstFileWriter` outputs inside the
+  /// bridge, so moving a range costs a sequential read here and
+  /// `ingestExternalFiles(_:options:)` on the target instead of replaying
+  /// every put. The files are a consistent view of the range and hold only
+  /// live values; they are named `export-000001.sst`, ... and replace files
+  /// of the same name in `directory`.
+  /// - Parameters:
+  ///   - range: Half-open key range to export
+  ///   - directory: Output directory, created if missing
+  ///   - targetFileSize: Size at which a new file is started (0 = one file)
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options (iterator bounds are replaced by the range)
+  /// - Returns: Paths of the files in key order, empty for an empty range
+  /// - Throws: RocksDBError on failure, after deleting the files written so far
+  @discardableResult
+  public func exportRange(
+    _ range: RocksDBKeyRange,
+    to directory: String,
+    targetFileSize: UInt64 = 64 * 1024 * 1024,
+    of columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBReadOptions = .default
+  ) throws -> [String] {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let cf = try familyHandle(columnFamily)
+      var pathsPtr: UnsafeMutablePointer<UnsafeMutablePointer<CChar>?>?
+      var count = 0
+      let status = range.start.withOptionalBytes { startPtr, startLen in
+        range.end.withOptionalBytes { endPtr, endLen in
+          rocksdb_export_range_cf(h, cf, options.handle, startPtr, startLen, endPtr, endLen,
+                                  directory, targetFileSize, &pathsPtr, &count)
+        }
+      }
+      try RocksDBError.check(status)
+      defer { rocksdb_free_string_list(pathsPtr, count) }
+
+      return (0..<count).compactMap { i in
+        pathsPtr?[i].map { String(cString: $0) }
+      }
+    }
+  }
+
+  // MARK: - Transaction Operations
+
+  /// Execute a transaction with automatic commit/rollback
+  ///
+  /// The native transaction comes from `transactionPool` and is returned to
+  /// it afterwards, so the transaction must not be used outside the closure.
+  /// With a retry policy the closure reruns after each conflict, so it must
+  /// not have side effects outside the transaction.
+  /// - Parameters:
+  ///   - options: Write options for the transaction
+  ///   - snapshot: Take a snapshot at begin (see `beginTransaction(options:snapshot:)`)
+  ///   - retry: Conflict retry policy (default: never retry)
+  ///   - operation: Closure receiving a transaction to perform operations
+  /// - Returns: Result of the operation closure
+  /// - Throws: RocksDBError on failure or if not a transactional database
+  public func transaction<T>(
+    options: RocksDBWriteOptions = .default,
+    snapshot: Bool = false,
+    retry: RocksDBRetryPolicy = .none,
+    _ operation: (RocksDBTransaction) throws -> T
+  ) throws -> T {
+    guard isTransactional else {
+      throw RocksDBError.notSupported("Database not opened with transaction support")
+    }
+
+    let start = ProcessInfo.processInfo.systemUptime
+    var attempt = 1
+
+    while true {
+      transactionCounters.recordAttempt()
+      do {
+        let result = try runTransaction(options: options, snapshot: snapshot, operation)
+        transactionCounters.recordOutcome(
+          committed: true, attempts: attempt,
+          elapsed: ProcessInfo.processInfo.systemUptime - start)
+        return result
+      } catch let error where RocksDBRetryPolicy.isRetryable(error) {
+        let elapsed = ProcessInfo.processInfo.systemUptime - start
+        let delay = retry.backoff(afterAttempt: attempt)
+        let withinDeadline = retry.deadline.map { elapsed + delay <= $0 } ?? true
+
+        guard attempt < retry.maxAttempts, withinDeadline else {
+          transactionCounters.recordConflict(backoff: 0)
+          transactionCounters.recordOutcome(committed: false, attempts: attempt, elapsed: elapsed)
+          throw error
+        }
+
+        transactionCounters.recordConflict(backoff: delay)
+        if delay > 0 {
+          Thread.sleep(forTimeInterval: delay)
+        }
+        attempt += 1
+      }
+    }
+  }
+
+  /// Contention counters of `transaction(options:snapshot:retry:_:)` calls
+  public var transactionMetrics: RocksDBTransactionMetrics {
+    transactionCounters.snapshot
+  }
+
+  /// Reset `transactionMetrics` to zero
+  public func resetTransactionMetrics() {
+    transactionCounters.reset()
+  }
+
+  /// Run one attempt of a closure transaction on a pooled native transaction
+  private func runTransaction<T>(
+    options: RocksDBWriteOptions,
+    snapshot: Bool,
+    _ operation: (RocksDBTransaction) throws -> T
+  ) throws -> T {
+    let txn = try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      guard let txnHandle = transactionPool.begin(on: h, options: options.handle,
+                                                  snapshot: snapshot) else {
+        throw RocksDBError.ioError("Failed to begin transaction")
+      }
+
+      return RocksDBTransaction(handle: txnHandle, database: self)
+    }
+    defer {
+      if let txnHandle = txn.detachHandle() {
+        recycleTransaction(txnHandle)
+      }
+    }
+
+    do {
+      let result = try operation(txn)
+      try txn.commit()
+      return result
+    } catch {
+      txn.rollback()
+      throw error
+    }
+  }
+
+  /// Transactions recovered in the prepared state when the database opened
+  ///
+  /// They keep their locks until each is committed or rolled back; like any
+  /// transaction, one released without committing is rolled back, unless
+  /// the database has closed by then. Each is returned by the first call
+  /// only. Requires `RocksDBTransactionDBOptions.twoPhaseCommit`.
+  /// - Returns: Prepared transactions, identified by `name`
+  /// - Throws: RocksDBError if not a pessimistic transaction database
+  public func preparedTransactions() throws -> [RocksDBTransaction] {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      var txnsPtr: UnsafeMutablePointer<RocksDBTransactionRef?>?
+      var count = 0
+      let status = rocksdb_get_prepared_transactions(h, &txnsPtr, &count)
+      try RocksDBError.check(status)
+
+      guard let txns = txnsPtr else { return [] }
+      defer { rocksdb_free_data(txns) }
+      return (0..<count).compactMap {
+        txns[$0].map { RocksDBTransaction(handle: $0, database: self, prepared: true) }
+      }
+    }
+  }
+
+  /// Return a finished native transaction to the pool, unless the database closed
+  private func recycleTransaction(_ txnHandle: RocksDBTransactionRef) {
+    lock.withReadLock {
+      if handle != nil {
+        transactionPool.release(txnHandle)
+      } else {
+        rocksdb_transaction_destroy(txnHandle)
+      }
+    }
+  }
+
+  /// Execute a read-only transaction
+  ///
+  /// Reads inside the closure all see one snapshot, without the native
+  /// transaction, write batch and conflict tracking of `transaction(_:)`.
+  /// Works whether or not the database was opened with transaction support.
+  /// - Parameters:
+  ///   - shared: Serve reads from `sharedSnapshot()` instead of a new snapshot
+  ///   - operation: Closure receiving the read transaction
+  /// - Returns: Result of the operation closure
+  /// - Throws: RocksDBError on failure, or any error thrown by the closure
+  public func readTransaction<T>(
+    shared: Bool = false,
+    _ operation: (RocksDBReadTransaction) throws -> T
+  ) throws -> T {
+    try operation(beginReadTransaction(shared: shared))
+  }
+
+  /// Begin a read-only transaction
+  /// - Parameter shared: Serve reads from `sharedSnapshot()` instead of a new snapshot
+  /// - Returns: Read transaction, whose snapshot is released with it
+  /// - Throws: RocksDBError if the database is closed
+  public func beginReadTransaction(shared: Bool = false) throws -> RocksDBReadTransaction {
+    let snapshot = shared ? try sharedSnapshot() : try makeSnapshot()
+    return RocksDBReadTransaction(database: self, snapshot: snapshot)
+  }
+
+  /// Begin a new transaction
+  ///
+  /// With `snapshot`, the transaction pins a snapshot at begin: every read
+  /// that does not name its own snapshot sees the database as of begin, and
+  /// commit fails if a key the transaction wrote changed after it.
+  /// - Parameters:
+  ///   - options: Write options for the transaction
+  ///   - snapshot: Take a snapshot at begin (default: false)
+  /// - Returns: New transaction
+  /// - Throws: RocksDBError on failure
+  public func beginTransaction(
+    options: RocksDBWriteOptions = .default,
+    snapshot: Bool = false
+  ) throws -> RocksDBTransaction {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      guard isTransactional else {
+        throw RocksDBError.notSupported("Database not opened with transaction support")
+      }
+
+      let writeOpts = options.handle
+
+      guard let txnHandle = rocksdb_transaction_begin_with_snapshot(h, writeOpts, snapshot ? 1 : 0) else {
+        throw RocksDBError.ioError("Failed to begin transaction")
+      }
+
+      return RocksDBTransaction(handle: txnHandle, database: self)
+    }
+  }
+
+  // MARK: - Snapshot Operations
+
+  /// Take a new snapshot of the database
+  ///
+  /// Each snapshot costs a trip through the database mutex and a node in
+  /// its snapshot list; readers that only need some consistent view should
+  /// prefer `sharedSnapshot()`.
+  /// - Returns: Snapshot, released when the last reference goes away
+  /// - Throws: RocksDBError if the database is closed
+  public func makeSnapshot() throws -> RocksDBSnapshot {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      guard let snapshotHandle = rocksdb_create_snapshot(h) else {
+        throw RocksDBError.ioError("Failed to create snapshot")
+      }
+
+      return RocksDBSnapshot(handle: snapshotHandle, database: self)
+    }
+  }
+
+  /// Snapshot shared by all readers starting within `snapshotSharingWindow`
+  ///
+  /// Returns the most recent shared snapshot while it is younger than the
+  /// window and still held by some reader, and takes a new one otherwise,
+  /// so a burst of readers costs one snapshot instead of one each. A reader
+  /// may therefore see data up to the window old.
+  /// - Returns: Shared snapshot, released when the last reader drops it
+  /// - Throws: RocksDBError if the database is closed
+  public func sharedSnapshot() throws -> RocksDBSnapshot {
+    try snapshotLock.withLock {
+      if let snapshot = currentSharedSnapshot, snapshot.age < _snapshotSharingWindow {
+        sharedSnapshotHits += 1
+        return snapshot
+      }
+
+      let snapshot = try makeSnapshot()
+      currentSharedSnapshot = snapshot
+      return snapshot
+    }
+  }
+
+  /// How long `sharedSnapshot()` keeps handing out the same snapshot, in
+  /// seconds (default: 0.01; 0 disables sharing)
+  public var snapshotSharingWindow: TimeInterval {
+    get { snapshotLock.withLock { _snapshotSharingWindow } }
+    set { snapshotLock.withLock { _snapshotSharingWindow = newValue } }
+  }
+
+  /// Live snapshot count and age of the oldest snapshot
+  public var snapshotStats: RocksDBSnapshotStats {
+    let hits = snapshotLock.withLock { sharedSnapshotHits }
+    return lock.withReadLock {
+      guard let h = handle else { return RocksDBSnapshotStats(sharedHits: hits) }
+
+      var count: UInt64 = 0
+      var oldestTime: UInt64 = 0
+      rocksdb_get_snapshot_stats(h, &count, &oldestTime)
+
+      let oldestAge = oldestTime > 0
+        ? max(Date().timeIntervalSince1970 - TimeInterval(oldestTime), 0)
+        : nil
+      return RocksDBSnapshotStats(count: Int(count), oldestAge: oldestAge, sharedHits: hits)
+    }
+  }
+
+  /// Release a snapshot; after close the database already dropped it
+  internal func releaseSnapshot(_ snapshot: RocksDBSnapshotRef) {
+    lock.withReadLock {
+      rocksdb_release_snapshot(handle, snapshot)
+    }
+  }
+
+  // MARK: - Iterator Operations
+
+  /// Create an iterator for the database
+  /// - Parameters:
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options
+  /// - Returns: Database iterator
+  /// - Throws: RocksDBError on failure
+  public func makeIterator(
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBReadOptions = .default
+  ) throws -> RocksDBIterator {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let cf = try familyHandle(columnFamily)
+      let readOpts = options.handle
+
+      guard let iterHandle = rocksdb_iterator_create_cf(h, cf, readOpts) else {
+        throw RocksDBError.ioError("Failed to create iterator")
+      }
+
+      return RocksDBIterator(handle: iterHandle)
+    }
+  }
+
+  /// Create an iterator over the database with a batch's staged writes overlaid
+  ///
+  /// The iterator keeps the batch alive; do not modify the batch while the
+  /// iterator is in use.
+  /// - Parameters:
+  ///   - batch: Batch whose staged writes are overlaid
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options
+  /// - Returns: Merged iterator
+  /// - Throws: RocksDBError on failure
+  public func makeIterator(
+    stagedIn batch: RocksDBIndexedBatch,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBReadOptions = .default
+  ) throws -> RocksDBIterator {
+    try batch.validate(writingTo: self)
+    return try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let cf = try familyHandle(columnFamily)
+      let readOpts = options.handle
+
+      guard let iterHandle = rocksdb_indexed_batch_create_iterator_cf(h, cf, readOpts, batch.handle) else {
+        throw RocksDBError.ioError("Failed to create iterator")
+      }
+
+      return RocksDBIterator(handle: iterHandle, owner: batch)
+    }
+  }
+
+  /// Iterate over all key-value pairs
+  /// - Parameter body: Closure called for each key-value pair, return false to stop
+  /// - Throws: RocksDBError on failure
+  public func forEach(_ body: (Data, Data) throws -> Bool) throws {
+    try forEach(in: .all, body)
+  }
+
+  /// Iterate over key-value pairs with a key prefix
+  /// - Parameters:
+  ///   - prefix: Key prefix to match
+  ///   - options: Read options (iterator bounds are replaced by the prefix range)
+  ///   - body: Closure called for each matching key-value pair, return false to stop
+  /// - Throws: RocksDBError on failure
+  public func forEachWithPrefix(
+    _ prefix: Data,
+    options: RocksDBReadOptions = .default,
+    _ body: (Data, Data) throws -> Bool
+  ) throws {
+    let range = RocksDBKeyRange.prefix(prefix)
+    if range.end != nil {
+      try forEach(in: range, options: options, body)
+      return
+    }
+
+    // No finite upper bound for an all-0xFF prefix, so check matches in Swift
+    try forEach(in: range, options: options) { key, value in
+      guard key.count >= prefix.count && key.prefix(prefix.count) == prefix else { return false }
+      return try body(key, value)
+    }
+  }
+
+  /// Iterate over key-value pairs in a key range
+  ///
+  /// The range is pushed down as iterator bounds, so RocksDB stops at the end
+  /// of the range and skips files outside of it.
+  /// - Parameters:
+  ///   - range: Half-open key range to scan
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options (iterator bounds are replaced by the range)
+  ///   - body: Closure called for each key-value pair, return false to stop
+  /// - Throws: RocksDBError on failure
+  public func forEach(
+    in range: RocksDBKeyRange,
+    of columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBReadOptions = .default,
+    _ body: (Data, Data) throws -> Bool
+  ) throws {
+    var boundedOptions = options
+    boundedOptions.iterateLowerBound = range.start
+    boundedOptions.iterateUpperBound = range.end
+
+    let iter = try makeIterator(in: columnFamily, options: boundedOptions)
+    defer { iter.close() }
+
+    if let start = range.start {
+      iter.seek(to: start)
+    } else {
+      iter.seekToFirst()
+    }
+
+    scan: while true {
+      let entries = iter.nextBatch()
+      if entries.isEmpty { break }
+      for entry in entries {
+        if try !body(entry.key, entry.value) { break scan }
+      }
+    }
+    try iter.checkStatus()
+  }
+
+  /// Iterate over the key-value pairs of a key range that match a predicate
+  ///
+  /// The predicate is evaluated inside the bridge over a bounded iterator,
+  /// and only matching entries are copied out, in batches.
+  /// - Parameters:
+  ///   - range: Half-open key range to scan
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - filter: Compiled predicate entries must match
+  ///   - options: Read options (iterator bounds are replaced by the range)
+  ///   - body: Closure called for each matching key-value pair, return false to stop
+  /// - Throws: RocksDBError on failure
+  public func forEach(
+    in range: RocksDBKeyRange,
+    of columnFamily: RocksDBColumnFamily? = nil,
+    where filter: RocksDBScanFilter,
+    options: RocksDBReadOptions = .default,
+    _ body: (Data, Data) throws -> Bool
+  ) throws {
+    var boundedOptions = options
+    boundedOptions.iterateLowerBound = range.start
+    boundedOptions.iterateUpperBound = range.end
+
+    let iter = try makeIterator(in: columnFamily, options: boundedOptions)
+    defer { iter.close() }
+
+    if let start = range.start {
+      iter.seek(to: start)
+    } else {
+      iter.seekToFirst()
+    }
+
+    scan: while true {
+      let entries = iter.nextBatch(matching: filter)
+      if entries.isEmpty { break }
+      for entry in entries {
+        if try !body(entry.key, entry.value) { break scan }
+      }
+    }
+    try iter.checkStatus()
+  }
+
+  /// Iterate over the key-value pairs of a key range that match a predicate
+  ///
+  /// Compiles `predicate` for this scan; build a `RocksDBScanFilter` once to
+  /// reuse it.
+  /// - Throws: RocksDBError on failure or an invalid predicate
+  public func forEach(
+    in range: RocksDBKeyRange,
+    of columnFamily: RocksDBColumnFamily? = nil,
+    where predicate: RocksDBScanPredicate,
+    options: RocksDBReadOptions = .default,
+    _ body: (Data, Data) throws -> Bool
+  ) throws {
+    try forEach(in: range, of: columnFamily, where: RocksDBScanFilter(predicate), options: options, body)
+  }
+
+  /// Count the entries of a key range and aggregate an integer field of their values
+  ///
+  /// The scan runs entirely in the bridge with the range as iterator
+  /// bounds, so no entry crosses into Swift. Use `.prefix(_:)` to
+  /// aggregate the keys with a prefix.
+  /// - Parameters:
+  ///   - range: Half-open key range to scan
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - field: Integer field to sum and bound (nil for counts and sizes only)
+  ///   - options: Read options (iterator bounds are replaced by the range)
+  /// - Returns: Aggregates over the range
+  /// - Throws: RocksDBError on failure or an invalid field width
+  public func aggregate(
+    in range: RocksDBKeyRange = .all,
+    of columnFamily: RocksDBColumnFamily? = nil,
+    field: RocksDBAggregateField? = nil,
+    options: RocksDBReadOptions = .default
+  ) throws -> RocksDBAggregate {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let cf = try familyHandle(columnFamily)
+      var values = RocksDBAggregateValues()
+      let status = range.start.withOptionalBytes { startPtr, startLen in
+        range.end.withOptionalBytes { endPtr, endLen in
+          if var native = field?.native {
+            return rocksdb_aggregate_range_cf(h, cf, options.handle, startPtr, startLen,
+                                              endPtr, endLen, &native, &values)
+          }
+          return rocksdb_aggregate_range_cf(h, cf, options.handle, startPtr, startLen,
+                                            endPtr, endLen, nil, &values)
+        }
+      }
+      try RocksDBError.check(status)
+      return RocksDBAggregate(values)
+    }
+  }
+
+  // MARK: - Range Statistics
+
+  /// Approximate bytes stored in each key range
+  ///
+  /// Unlike the SST-only estimate `split(_:into:in:)` relies on, this counts
+  /// memtables by default, so ranges written since the last flush are sized
+  /// correctly. Open bounds resolve to the first and last key of the family
+  /// with one iterator, so fully bounded ranges are cheapest.
+  /// - Parameters:
+  ///   - ranges: Key ranges to size
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Which data to count, and how precisely
+  /// - Returns: Sizes in the same order as `ranges`
+  /// - Throws: RocksDBError on failure (e.g. neither memtables nor files included)
+  public func approximateSizes(
+    of ranges: [RocksDBKeyRange],
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBSizeApproximation = .default
+  ) throws -> [UInt64] {
+    guard !ranges.isEmpty else { return [] }
+
+    return try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let cf = try familyHandle(columnFamily)
+      var native = options.native
+      var sizes = [UInt64](repeating: 0, count: ranges.count)
+
+      let status = ranges.withPackedBounds { pointers, lengths in
+        rocksdb_get_approximate_sizes_cf(h, cf, &native, ranges.count, pointers, lengths, &sizes)
+      }
+      try RocksDBError.check(status)
+      return sizes
+    }
+  }
+
+  /// Approximate bytes stored in a key range, memtables included
+  public func approximateSize(
+    of range: RocksDBKeyRange,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBSizeApproximation = .default
+  ) throws -> UInt64 {
+    try approximateSizes(of: [range], in: columnFamily, options: options)[0]
+  }
+
+  /// Approximate number of entries and bytes of a key range in the memtables
+  ///
+  /// Estimated from the memtables' skiplist sampling without visiting the
+  /// entries; overwritten and deleted keys count once per version.
+  /// - Parameters:
+  ///   - range: Key range
+  ///   - columnFamily: Column family (nil for the default family)
+  /// - Returns: Entry count and size in bytes
+  /// - Throws: RocksDBError on failure
+  public func approximateMemtableStats(
+    of range: RocksDBKeyRange,
+    in columnFamily: RocksDBColumnFamily? = nil
+  ) throws -> (count: UInt64, size: UInt64) {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let cf = try familyHandle(columnFamily)
+      var count: UInt64 = 0
+      var size: UInt64 = 0
+
+      let status = range.start.withOptionalBytes { startPtr, startLen in
+        range.end.withOptionalBytes { endPtr, endLen in
+          rocksdb_get_approximate_memtable_stats_cf(h, cf, startPtr, startLen, endPtr, endLen,
+                                                    &count, &size)
+        }
+      }
+      try RocksDBError.check(status)
+      return (count, size)
+    }
+  }
+
+  // MARK: - SST File Metadata
+
+  /// Every live SST file of every column family, fetched in one call
+  ///
+  /// Files are ordered by column family and level, then by smallest key,
+  /// with overlapping L0 files newest first.
+  /// - Returns: File metadata, boundaries and entry counts
+  /// - Throws: RocksDBError on failure
+  public func liveFiles() throws -> [RocksDBSstFile] {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      var files: UnsafeMutablePointer<RocksDBSstFileValues>?
+      var count = 0
+      try RocksDBError.check(rocksdb_get_live_files_metadata(h, &files, &count))
+      return RocksDBSstFile.consume(files, count: count)
+    }
+  }
+
+  /// Level layout of a column family
+  /// - Parameter columnFamily: Column family (nil for the default family)
+  /// - Returns: Every level with its files, empty levels included
+  /// - Throws: RocksDBError on failure
+  public func columnFamilyMetadata(_ columnFamily: RocksDBColumnFamily? = nil) throws -> RocksDBColumnFamilyMetadata {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let cf = try familyHandle(columnFamily)
+      var filesPtr: UnsafeMutablePointer<RocksDBSstFileValues>?
+      var count = 0
+      var numLevels: Int32 = 0
+      try RocksDBError.check(rocksdb_get_column_family_metadata(h, cf, &filesPtr, &count, &numLevels))
+
+      let files = RocksDBSstFile.consume(filesPtr, count: count)
+      let byLevel = Dictionary(grouping: files, by: \.level)
+      let levels = (0..<Int(numLevels)).map { level in
+        let levelFiles = byLevel[level] ?? []
+        return RocksDBLevelMetadata(level: level, size: levelFiles.reduce(0) { $0 + $1.size },
+                                    files: levelFiles)
+      }
+      return RocksDBColumnFamilyMetadata(name: columnFamily?.name ?? RocksDBColumnFamily.defaultName,
+                                         levels: levels)
+    }
+  }
+
+  /// Properties of the SST files overlapping any of the ranges
+  ///
+  /// Reads each file's properties block, from the table cache when the file
+  /// is open, so it costs more than `liveFiles()` but reports sizes before
+  /// compression and counts of merges and range deletions.
+  /// - Parameters:
+  ///   - ranges: Key ranges the files must overlap
+  ///   - columnFamily: Column family (nil for the default family)
+  /// - Returns: Properties in file path order
+  /// - Throws: RocksDBError on failure
+  public func tableProperties(
+    in ranges: [RocksDBKeyRange] = [.all],
+    of columnFamily: RocksDBColumnFamily? = nil
+  ) throws -> [RocksDBTableProperties] {
+    guard !ranges.isEmpty else { return [] }
+
+    return try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let cf = try familyHandle(columnFamily)
+      var tables: UnsafeMutablePointer<RocksDBTablePropertiesValues>?
+      var count = 0
+
+      let status = ranges.withPackedBounds { pointers, lengths in
+        rocksdb_get_properties_of_tables_in_range_cf(h, cf, ranges.count, pointers, lengths,
+                                                     &tables, &count)
+      }
+      try RocksDBError.check(status)
+
+      guard let tables else { return [] }
+      defer { rocksdb_table_properties_destroy(tables, count) }
+      return (0..<count).map { RocksDBTableProperties(tables[$0]) }
+    }
+  }
+
+  // MARK: - Parallel Scan
+
+  /// Split a key range into ranges holding roughly equal bytes of data
+  ///
+  /// Weights the boundary keys of the live SST files overlapping the range,
+  /// so data still in memtables is not accounted for; flush first for an
+  /// even split of freshly written data.
+  /// - Parameters:
+  ///   - range: Key range to split
+  ///   - partitions: Maximum number of ranges
+  ///   - columnFamily: Column family (nil for the default family)
+  /// - Returns: Contiguous ranges covering `range` in key order (at least one)
+  /// - Throws: RocksDBError on failure
+  public func split(
+    _ range: RocksDBKeyRange,
+    into partitions: Int,
+    in columnFamily: RocksDBColumnFamily? = nil
+  ) throws -> [RocksDBKeyRange] {
+    let splits: [Data] = try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let cf = try familyHandle(columnFamily)
+      var keysPtr: UnsafeMutablePointer<UnsafeMutablePointer<CChar>?>?
+      var lensPtr: UnsafeMutablePointer<Int>?
+      var count = 0
+
+      let status = range.start.withOptionalBytes { startPtr, startLen in
+        range.end.withOptionalBytes { endPtr, endLen in
+          rocksdb_split_range_cf(h, cf, startPtr, startLen, endPtr, endLen, max(partitions, 1),
+                                 &keysPtr, &lensPtr, &count)
+        }
+      }
+      try RocksDBError.check(status)
+
+      guard let keys = keysPtr, let lens = lensPtr else { return [] }
+      defer {
+        rocksdb_free_string_list(keys, count)
+        rocksdb_free_data(lens)
+      }
+      return (0..<count).map { Data(bytes: keys[$0]!, count: lens[$0]) }
+    }
+
+    var bounds: [Data?] = [range.start]
+    bounds += splits.map { Optional($0) }
+    bounds.append(range.end)
+    return (0..<bounds.count - 1).map { RocksDBKeyRange(start: bounds[$0], end: bounds[$0 + 1]) }
+  }
+
+  /// Scan a key range on several threads at once
+  ///
+  /// The range is split into roughly equal-byte partitions (see
+  /// `split(_:into:in:)`), and each is scanned concurrently with a bounded
+  /// iterator. All partitions read one snapshot, so together they see a
+  /// consistent view. Keys are in order within a partition but partitions
+  /// interleave; `body` must be safe to call from several threads.
+  /// - Parameters:
+  ///   - range: Half-open key range to scan
+  ///   - partitions: Number of partitions and threads (default: active processors)
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options (bounds and snapshot are replaced)
+  ///   - body: Closure receiving the partition index, key and value; return
+  ///     false to stop the whole scan
+  /// - Throws: The first error thrown by a partition scan or by `body`
+  public func parallelScan(
+    range: RocksDBKeyRange = .all,
+    partitions: Int = ProcessInfo.processInfo.activeProcessorCount,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBReadOptions = .scan,
+    body: @Sendable (_ partition: Int, _ key: Data, _ value: Data) throws -> Bool
+  ) throws {
+    let ranges = try split(range, into: partitions, in: columnFamily)
+
+    var snapshotOptions = options
+    snapshotOptions.snapshot = try makeSnapshot()
+    let scanOptions = snapshotOptions
+
+    let state = ParallelScanState()
+    DispatchQueue.concurrentPerform(iterations: ranges.count) { partition in
+      do {
+        try forEach(in: ranges[partition], of: columnFamily, options: scanOptions) { key, value in
+          guard !state.isStopped else { return false }
+          if try body(partition, key, value) { return true }
+          state.stop()
+          return false
+        }
+      } catch {
+        state.fail(error)
+      }
+    }
+    if let error = state.error {
+      throw error
+    }
+  }
+
+  // MARK: - Maintenance Operations
+
+  /// Compact a range of keys
+  /// - Parameters:
+  ///   - startKey: Start of range (nil for beginning)
+  ///   - endKey: End of range (nil for end)
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Manual compaction options
+  /// - Throws: RocksDBError on failure, `.incomplete` if cancelled through
+  ///   `options.cancellation`
+  public func compactRange(
+    from startKey: Data? = nil,
+    to endKey: Data? = nil,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBCompactRangeOptions = .default
+  ) throws {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let cf = try familyHandle(columnFamily)
+      let compactOpts = options.createHandle()
+      defer { rocksdb_compact_range_options_destroy(compactOpts) }
+
+      let status = startKey.withOptionalBytes { startPtr, startLen in
+        endKey.withOptionalBytes { endPtr, endLen in
+          withExtendedLifetime(options.cancellation) {
+            rocksdb_compact_range_opt_cf(h, cf, compactOpts, startPtr, startLen, endPtr, endLen)
+          }
+        }
+      }
+      try RocksDBError.check(status)
+    }
+  }
+
+  /// Compact exactly the given SST files into one level
+  ///
+  /// Unlike `compactRange`, only the named files are rewritten, plus any
+  /// files RocksDB must add to keep the result consistent: older L0 files
+  /// overlapping an L0 input, and the files of `level` the inputs overlap.
+  /// Pick the inputs from `liveFiles()` or `columnFamilyMetadata(_:)`, e.g.
+  /// files full of tombstones. Runs on the calling thread alongside
+  /// automatic compactions, which must not already hold the files.
+  /// - Parameters:
+  ///   - files: Input file names, as in `RocksDBSstFile.fileName`, or full paths
+  ///   - level: Output level, at or below the lowest input level
+  ///   - columnFamily: Column family holding the files (nil for the default family)
+  ///   - options: Output compression, file size and subcompactions
+  /// - Returns: Full paths of the files written
+  /// - Throws: RocksDBError on failure (e.g. a file is not live or is being compacted)
+  @discardableResult
+  public func compactFiles(
+    _ files: [String],
+    toLevel level: Int,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBCompactionOptions = .default
+  ) throws -> [String] {
+    guard !files.isEmpty else { return [] }
+
+    return try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let cf = try familyHandle(columnFamily)
+      let compactOpts = options.createHandle()
+      defer { rocksdb_compaction_options_destroy(compactOpts) }
+
+      var outputs: UnsafeMutablePointer<UnsafeMutablePointer<CChar>?>?
+      var count = 0
+      let status = files.withCStringPointers { names in
+        rocksdb_compact_files_cf(h, cf, compactOpts, names, files.count, Int32(level), &outputs, &count)
+      }
+      try RocksDBError.check(status)
+
+      guard let outputs else { return [] }
+      defer { rocksdb_free_string_list(outputs, count) }
+      return (0..<count).map { String(cString: outputs[$0]!) }
+    }
+  }
+
+  /// Compact the given SST files into one level; see `compactFiles(_:toLevel:in:options:)`
+  @discardableResult
+  public func compactFiles(
+    _ files: [RocksDBSstFile],
+    toLevel level: Int,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBCompactionOptions = .default
+  ) throws -> [String] {
+    try compactFiles(files.map(\.fileName), toLevel: level, in: columnFamily, options: options)
+  }
+
+  /// Delete the SST files that lie entirely inside the given ranges
+  ///
+  /// Disk space is freed immediately and no tombstones are written, but keys
+  /// in memtables or in files that straddle a range boundary are kept, and
+  /// older versions of deleted keys may reappear from lower levels. Use
+  /// `purgeRange` for a complete, consistent delete.
+  /// - Parameters:
+  ///   - ranges: Key ranges (nil bounds are open-ended)
+  ///   - columnFamily: Column family (nil for the default family)
+  /// - Throws: RocksDBError on failure
+  public func deleteFiles(
+    in ranges: [RocksDBKeyRange],
+    of columnFamily: RocksDBColumnFamily? = nil
+  ) throws {
+    guard !ranges.isEmpty else { return }
+
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let cf = try familyHandle(columnFamily)
+
+      let status = ranges.withPackedBounds { pointers, lengths in
+        rocksdb_delete_files_in_ranges(h, cf, ranges.count, pointers, lengths, 0)
+      }
+      try RocksDBError.check(status)
+    }
+  }
+
+  /// Delete every key in a range and reclaim its disk space right away
+  ///
+  /// Drops whole files with `deleteFiles`, writes a range tombstone for the
+  /// remaining keys, then (with `compact`) compacts the span so the rest of
+  /// the space is freed without waiting for background compaction.
+  /// - Parameters:
+  ///   - range: Key range to delete (nil bounds are open-ended)
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - compact: Compact the range afterwards
+  /// - Throws: RocksDBError on failure
+  public func purgeRange(
+    _ range: RocksDBKeyRange,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    compact: Bool = true
+  ) throws {
+    try deleteFiles(in: [range], of: columnFamily)
+
+    // A range tombstone needs an end key: use just past the last key
+    var end = range.end
+    if end == nil {
+      let iterator = try makeIterator(in: columnFamily)
+      iterator.seekToLast()
+      end = iterator.key.map { $0 + Data([0]) }
+      try iterator.checkStatus()
+    }
+
+    let start = range.start ?? Data()
+    if let end = end, start.lexicographicallyPrecedes(end) {
+      try deleteRange(from: start, to: end, in: columnFamily)
+    }
+
+    if compact {
+      try compactRange(from: range.start, to: range.end, in: columnFamily)
+    }
+  }
+
+  /// Change the time to live of a database opened with `openWithTTL`
+  ///
+  /// Applies to existing entries as well, from the next compaction on.
+  /// - Parameters:
+  ///   - ttl: Time to live in seconds (zero or less: never expire)
+  ///   - columnFamily: Column family (nil for the default family)
+  /// - Throws: RocksDBError if the database was not opened with a TTL
+  public func setTTL(_ ttl: TimeInterval, for columnFamily: RocksDBColumnFamily? = nil) throws {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let cf = try familyHandle(columnFamily)
+      try RocksDBError.check(rocksdb_set_ttl(h, cf, RocksDB.ttlSeconds(ttl)))
+    }
+  }
+
+  /// Flush the database
+  /// - Parameters:
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - wait: Wait for flush to complete
+  /// - Throws: RocksDBError on failure
+  public func flush(_ columnFamily: RocksDBColumnFamily? = nil, wait: Bool = true) throws {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let cf = try familyHandle(columnFamily)
+      let status = rocksdb_flush_cf(h, cf, wait ? 1 : 0)
+      try RocksDBError.check(status)
+    }
+  }
+
+  /// Write buffered WAL data to the OS
+  ///
+  /// Required to persist writes when `manualWALFlush` is enabled.
+  /// - Parameter sync: Also fsync the WAL
+  /// - Throws: RocksDBError on failure
+  public func flushWAL(sync: Bool = false) throws {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let status = rocksdb_flush_wal(h, sync ? 1 : 0)
+      try RocksDBError.check(status)
+    }
+  }
+
+  /// Fsync WAL data already written to the OS
+  /// - Throws: RocksDBError on failure
+  public func syncWAL() throws {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let status = rocksdb_sync_wal(h)
+      try RocksDBError.check(status)
+    }
+  }
+
+  /// Copy the database's current OPTIONS file, which RocksDB rewrites on
+  /// every open and option change
+  ///
+  /// Load the copy with `RocksDBOptionsFile.load(from:)` to open another
+  /// database with the same options.
+  /// - Parameter file: Destination path (overwritten if present)
+  /// - Throws: RocksDBError on failure
+  public func exportOptionsFile(to file: String) throws {
+    try lock.withReadLock {
+      guard handle != nil else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let source = try RocksDBOptionsFile.latestFilePath(in: path)
+      let fileManager = FileManager.default
+      do {
+        if fileManager.fileExists(atPath: file) {
+          try fileManager.removeItem(atPath: file)
+        }
+        try fileManager.copyItem(atPath: source, toPath: file)
+      } catch {
+        throw RocksDBError.ioError("Failed to copy \(source): \(error.localizedDescription)")
+      }
+    }
+  }
+
+  // MARK: - Background Work Control
+
+  /// Stop all flushes and compactions until `continueBackgroundWork()`
+  ///
+  /// Waits for running jobs to finish. Calls nest. Writes stall once the
+  /// memtables fill up, so keep pauses short; to only hold off compaction,
+  /// use `setAutoCompactionsDisabled(_:for:)` instead.
+  /// - Throws: RocksDBError on failure
+  public func pauseBackgroundWork() throws {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      try RocksDBError.check(rocksdb_pause_background_work(h))
+    }
+  }
+
+  /// Resume background work stopped by `pauseBackgroundWork()`
+  /// - Throws: RocksDBError on failure
+  public func continueBackgroundWork() throws {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      try RocksDBError.check(rocksdb_continue_background_work(h))
+    }
+  }
+
+  /// Make running and new manual compactions fail with `.incomplete` until
+  /// `enableManualCompaction()`; calls nest
+  public func disableManualCompaction() {
+    lock.withReadLock {
+      if let h = handle {
+        rocksdb_disable_manual_compaction(h)
+      }
+    }
+  }
+
+  /// Allow manual compactions again after `disableManualCompaction()`
+  public func enableManualCompaction() {
+    lock.withReadLock {
+      if let h = handle {
+        rocksdb_enable_manual_compaction(h)
+      }
+    }
+  }
+
+  /// Turn automatic compactions of a column family off or back on
+  /// - Parameters:
+  ///   - disabled: Whether automatic compactions are disabled
+  ///   - columnFamily: Column family (nil for the default family)
+  /// - Throws: RocksDBError on failure
+  public func setAutoCompactionsDisabled(_ disabled: Bool, for columnFamily: RocksDBColumnFamily? = nil) throws {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let cf = try familyHandle(columnFamily)
+      try RocksDBError.check(rocksdb_set_disable_auto_compactions_cf(h, cf, disabled ? 1 : 0))
+    }
+  }
+
+  /// Flushes and compactions of this database that are running right now
+  ///
+  /// Requires `RocksDBOptions.enableThreadTracking`; without it the list is empty.
+  /// - Returns: Background jobs with their stage and bytes processed so far
+  /// - Throws: RocksDBError.notSupported if RocksDB was built without thread status
+  public func backgroundJobs() throws -> [RocksDBThreadStatus] {
+    try RocksDBEnvironment.threadList().filter { $0.isBackgroundJob && $0.databaseName == path }
+  }
+
+  /// Change mutable column family options without reopening
+  ///
+  /// Names and values use the OPTIONS file format (e.g. `"write_buffer_size"`
+  /// and `"67108864"`). Either all changes apply or none do; RocksDB writes
+  /// a new OPTIONS file afterwards.
+  /// - Parameters:
+  ///   - options: Option names and values
+  ///   - columnFamily: Column family (nil for the default family)
+  /// - Throws: RocksDBError.invalidArgument for unknown or immutable options
+  public func setOptions(_ options: [String: String], for columnFamily: RocksDBColumnFamily? = nil) throws {
+    guard !options.isEmpty else { return }
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let cf = try familyHandle(columnFamily)
+      let names = Array(options.keys)
+      let values = names.map { options[$0]! }
+      let status = names.withCStringPointers { namePtrs in
+        values.withCStringPointers { valuePtrs in
+          rocksdb_set_options_cf(h, cf, names.count, namePtrs, valuePtrs)
+        }
+      }
+      try RocksDBError.check(status)
+    }
+  }
+
+  /// Change typed mutable column family options without reopening
+  /// - Parameters:
+  ///   - options: Options to change (nil fields are left alone)
+  ///   - columnFamily: Column family (nil for the default family)
+  /// - Throws: RocksDBError on failure
+  public func setOptions(_ options: RocksDBMutableColumnFamilyOptions, for columnFamily: RocksDBColumnFamily? = nil) throws {
+    try setOptions(options.values, for: columnFamily)
+  }
+
+  /// Change mutable database-wide options without reopening
+  /// - Parameter options: Option names and values in OPTIONS file format
+  /// - Throws: RocksDBError.invalidArgument for unknown or immutable options
+  public func setDBOptions(_ options: [String: String]) throws {
+    guard !options.isEmpty else { return }
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let names = Array(options.keys)
+      let values = names.map { options[$0]! }
+      let status = names.withCStringPointers { namePtrs in
+        values.withCStringPointers { valuePtrs in
+          rocksdb_set_db_options(h, names.count, namePtrs, valuePtrs)
+        }
+      }
+      try RocksDBError.check(status)
+    }
+  }
+
+  /// Change typed mutable database-wide options without reopening
+  /// - Parameter options: Options to change (nil fields are left alone)
+  /// - Throws: RocksDBError on failure
+  public func setDBOptions(_ options: RocksDBMutableDBOptions) throws {
+    try setDBOptions(options.values)
+  }
+
+  /// Options a column family currently runs with, in options string format
+  /// (nil once closed)
+  public func currentOptions(of columnFamily: RocksDBColumnFamily? = nil) -> String? {
+    lock.withReadLock {
+      guard let h = handle else {
+        return nil
+      }
+      if let family = columnFamily, family.database !== self {
+        return nil
+      }
+      guard let cString = rocksdb_get_options_string_cf(h, columnFamily?.handle) else {
+        return nil
+      }
+      defer { rocksdb_free_string(cString) }
+      return String(cString: cString)
+    }
+  }
+
+  /// Current `level0SlowdownWritesTrigger` of a column family (nil once closed)
+  public func level0SlowdownWritesTrigger(of columnFamily: RocksDBColumnFamily? = nil) -> Int? {
+    lock.withReadLock {
+      guard let h = handle else {
+        return nil
+      }
+      if let family = columnFamily, family.database !== self {
+        return nil
+      }
+      return Int(rocksdb_get_level0_slowdown_writes_trigger_cf(h, columnFamily?.handle))
+    }
+  }
+
+  /// Current write stall condition of a column family and what drives it
+  /// - Parameter columnFamily: Column family (nil for the default family)
+  /// - Returns: Stall state, including the database-wide stop flag and delayed write rate
+  /// - Throws: RocksDBError on failure
+  public func writeStallState(of columnFamily: RocksDBColumnFamily? = nil) throws -> RocksDBWriteStallState {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let cf = try familyHandle(columnFamily)
+      var values = RocksDBWriteStallValues()
+      try RocksDBError.check(rocksdb_get_write_stall_state_cf(h, cf, &values))
+      return RocksDBWriteStallState(values)
+    }
+  }
+
+  /// Get a database property value
+  /// - Parameters:
+  ///   - name: Property name (e.g., "rocksdb.estimate-num-keys")
+  ///   - columnFamily: Column family (nil for the default family)
+  /// - Returns: Property value or nil if not found
+  public func getProperty(_ name: String, of columnFamily: RocksDBColumnFamily? = nil) -> String? {
+    lock.withReadLock {
+      guard let h = handle else {
+        return nil
+      }
+      if let family = columnFamily, family.database !== self {
+        return nil
+      }
+
+      guard let ptr = rocksdb_get_property_cf(h, columnFamily?.handle, name) else {
+        return nil
+      }
+      defer { rocksdb_free_string(ptr) }
+
+      return String(cString: ptr)
+    }
+  }
+
+  /// Get an integer property without formatting and parsing a string
+  /// - Parameters:
+  ///   - property: Property to read
+  ///   - columnFamily: Column family (nil for the default family)
+  /// - Returns: Property value or nil if unavailable
+  public func intProperty(_ property: RocksDBIntProperty, of columnFamily: RocksDBColumnFamily? = nil) -> UInt64? {
+    lock.withReadLock {
+      guard let h = handle else {
+        return nil
+      }
+      if let family = columnFamily, family.database !== self {
+        return nil
+      }
+
+      var value: UInt64 = 0
+      guard rocksdb_get_int_property_cf(h, columnFamily?.handle, property.rawValue, &value) != 0 else {
+        return nil
+      }
+      return value
+    }
+  }
+
+  /// Get an integer property summed over all column families
+  /// - Parameter property: Property to read
+  /// - Returns: Aggregated value or nil if unavailable
+  public func aggregatedIntProperty(_ property: RocksDBIntProperty) -> UInt64? {
+    lock.withReadLock {
+      guard let h = handle else {
+        return nil
+      }
+
+      var value: UInt64 = 0
+      guard rocksdb_get_aggregated_int_property(h, property.rawValue, &value) != 0 else {
+        return nil
+      }
+      return value
+    }
+  }
+
+  /// Get the key/value form of a structured property
+  /// - Parameters:
+  ///   - property: Property to read
+  ///   - columnFamily: Column family (nil for the default family)
+  /// - Returns: Property entries or nil if unavailable
+  public func mapProperty(
+    _ property: RocksDBMapProperty,
+    of columnFamily: RocksDBColumnFamily? = nil
+  ) -> [String: String]? {
+    lock.withReadLock {
+      guard let h = handle else {
+        return nil
+      }
+      if let family = columnFamily, family.database !== self {
+        return nil
+      }
+
+      var keysPtr: UnsafeMutablePointer<UnsafeMutablePointer<CChar>?>?
+      var valuesPtr: UnsafeMutablePointer<UnsafeMutablePointer<CChar>?>?
+      var count: Int = 0
+      guard rocksdb_get_map_property_cf(h, columnFamily?.handle, property.rawValue,
+                                        &keysPtr, &valuesPtr, &count) != 0 else {
+        return nil
+      }
+      defer {
+        rocksdb_free_string_list(keysPtr, count)
+        rocksdb_free_string_list(valuesPtr, count)
+      }
+
+      var entries: [String: String] = [:]
+      entries.reserveCapacity(count)
+      for i in 0..<count {
+        guard let key = keysPtr?[i], let value = valuesPtr?[i] else { continue }
+        entries[String(cString: key)] = String(cString: value)
+      }
+      return entries
+    }
+  }
+
+  // MARK: - Change Data Capture
+
+  /// Sequence number of the most recent write (0 if the database is closed)
+  public var latestSequenceNumber: UInt64 {
+    lock.withReadLock {
+      guard let h = handle else { return 0 }
+      return rocksdb_latest_sequence_number(h)
+    }
+  }
+
+  /// Read the write batches in the WAL, starting with the one that contains `sequence`
+  ///
+  /// Pass 0 or the `nextSequence` of the last batch a follower applied.
+  /// The iterator keeps the native database alive until it is closed.
+  /// - Parameters:
+  ///   - sequence: First sequence number of interest
+  ///   - verifyChecksums: Verify WAL record checksums while reading
+  /// - Returns: Iterator positioned at the first batch
+  /// - Throws: RocksDBError if the WAL holding `sequence` is no longer retained
+  public func updates(since sequence: UInt64, verifyChecksums: Bool = true) throws -> RocksDBChangeIterator {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      var iter: RocksDBWalIteratorRef?
+      try RocksDBError.check(rocksdb_get_updates_since(h, sequence, verifyChecksums ? 1 : 0, &iter))
+      guard let iter else {
+        throw RocksDBError.ioError("Failed to create WAL iterator")
+      }
+      return RocksDBChangeIterator(handle: iter)
+    }
+  }
+
+  // MARK: - Checkpoints
+
+  /// Save the blocks of this database held in its block cache to a file
+  ///
+  /// Call before closing on a planned shutdown, then warm the cache of the
+  /// restarted process with `RocksDBCache.loadDump(from:)`. Blocks of other
+  /// databases sharing the cache are not written.
+  /// - Parameters:
+  ///   - path: Dump file; replaced if it exists
+  ///   - maxSize: Stop after writing this many bytes (0 for no limit)
+  /// - Throws: RocksDBError.notSupported if the database has no block cache,
+  ///   or RocksDBError if the dump cannot be written
+  public func dumpBlockCache(to path: String, maxSize: UInt64 = 0) throws {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      try RocksDBError.check(rocksdb_dump_block_cache(h, path, maxSize))
+    }
+  }
+
+  /// Create an openable, consistent copy of the database
+  ///
+  /// SST and blob files are hard-linked when `path` is on the same
+  /// filesystem, so even large databases are checkpointed in milliseconds
+  /// without extra space; only the MANIFEST, OPTIONS and WAL files are
+  /// copied. Open the checkpoint like any database, or back it up while
+  /// this one keeps taking writes.
+  /// - Parameters:
+  ///   - path: Checkpoint directory; must not exist yet
+  ///   - logSizeForFlush: Copy the WAL instead of flushing memtables while
+  ///     it is smaller than this many bytes (0 always flushes)
+  /// - Returns: A sequence number contained in the checkpoint
+  /// - Throws: RocksDBError on failure
+  @discardableResult
+  public func createCheckpoint(at path: String, logSizeForFlush: UInt64 = 0) throws -> UInt64 {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      var sequence: UInt64 = 0
+      try RocksDBError.check(rocksdb_create_checkpoint(h, path, logSizeForFlush, &sequence))
+      return sequence
+    }
+  }
+
+  /// Flush a column family and hard-link its live SST files into a directory
+  /// - Parameters:
+  ///   - columnFamily: Family to export (nil for the default family)
+  ///   - path: Export directory; must not exist yet
+  /// - Returns: Export to pass to `importColumnFamily(named:from:options:moveFiles:)`
+  /// - Throws: RocksDBError on failure
+  public func exportColumnFamily(_ columnFamily: RocksDBColumnFamily? = nil, to path: String) throws -> RocksDBColumnFamilyExport {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let cf = try familyHandle(columnFamily)
+      var metadata: RocksDBExportMetadataRef?
+      try RocksDBError.check(rocksdb_export_column_family(h, cf, path, &metadata))
+      guard let exported = metadata else {
+        throw RocksDBError.ioError("Failed to export column family")
+      }
+      return RocksDBColumnFamilyExport(handle: exported, directory: path)
+    }
+  }
+
+  /// Create a column family from exported SST files
+  /// - Parameters:
+  ///   - name: New family name
+  ///   - export: Files exported with `exportColumnFamily(_:to:)`
+  ///   - options: Family options; the comparator must match the export's
+  ///   - moveFiles: Move the files into the database instead of copying them
+  /// - Returns: New column family
+  /// - Throws: RocksDBError on failure (e.g. the family already exists)
+  public func importColumnFamily(
+    named name: String,
+    from export: RocksDBColumnFamilyExport,
+    options: RocksDBColumnFamilyOptions = .init(),
+    moveFiles: Bool = false
+  ) throws -> RocksDBColumnFamily {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      let opts = options.createHandle()
+      defer { rocksdb_options_destroy(opts) }
+
+      var familyHandle: RocksDBColumnFamilyRef?
+      try RocksDBError.check(rocksdb_create_column_family_with_import(
+        h, opts, name, moveFiles ? 1 : 0, export.handle, &familyHandle))
+      guard let created = familyHandle else {
+        throw RocksDBError.ioError("Failed to import column family")
+      }
+
+      let family = RocksDBColumnFamily(handle: created, name: name, database: self)
+      familiesLock.withLock { columnFamilies[name] = family }
+      return family
+    }
+  }
+
+  // MARK: - Secondary Instances
+
+  /// Catch up with the primary of a database opened with `openAsSecondary`
+  ///
+  /// Reads after the call see the primary's writes up to its last WAL sync.
+  /// - Throws: RocksDBError on failure, `.notSupported` for other databases
+  public func tryCatchUpWithPrimary() throws {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      try RocksDBError.check(rocksdb_try_catch_up_with_primary(h))
+    }
+  }
+
+  // MARK: - Backups
+
+  /// Back up the database into a backup directory
+  ///
+  /// Runs while writes continue; files already in the directory from
+  /// earlier backups are not copied again.
+  /// - Parameters:
+  ///   - engine: Backup directory
+  ///   - flushBeforeBackup: Flush memtables first, instead of relying on backed-up WAL files
+  ///   - metadata: Application data stored with the backup
+  /// - Returns: New backup id
+  /// - Throws: RocksDBError on failure, `.incomplete` if stopped with `stopBackup()`
+  @discardableResult
+  public func createBackup(in engine: RocksDBBackupEngine, flushBeforeBackup: Bool = false,
+                           metadata: String? = nil) throws -> UInt32 {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      var backupID: UInt32 = 0
+      try RocksDBError.check(rocksdb_backup_engine_create_new_backup(
+        engine.handle, h, flushBeforeBackup ? 1 : 0, metadata, &backupID))
+      return backupID
+    }
+  }
+
+  // MARK: - Block Cache Tracing
+
+  /// Record block cache accesses to a file for offline cache sizing
+  ///
+  /// Load the result with `RocksDBBlockCacheTrace(contentsOf:)` and replay it
+  /// against candidate capacities with `hitRateCurve(capacities:policies:)`.
+  /// Only one block cache trace can run at a time.
+  /// - Parameters:
+  ///   - path: Trace file to create (overwritten if present)
+  ///   - samplingFrequency: Record one in this many accesses
+  ///   - maxTraceSize: Accesses past this many bytes of trace are dropped
+  /// - Throws: RocksDBError on failure (e.g. a trace is already running)
+  public func startBlockCacheTrace(
+    to path: String,
+    samplingFrequency: Int = 1,
+    maxTraceSize: UInt64 = 64 * 1024 * 1024 * 1024
+  ) throws {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      try RocksDBError.check(rocksdb_start_block_cache_trace(
+        h, path, UInt64(max(samplingFrequency, 1)), maxTraceSize))
+    }
+  }
+
+  /// Stop the running block cache trace and close its file
+  /// - Throws: RocksDBError on failure
+  public func endBlockCacheTrace() throws {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      try RocksDBError.check(rocksdb_end_block_cache_trace(h))
+    }
+  }
+
+  // MARK: - Query Tracing
+
+  /// Record Get, MultiGet, Write and iterator seek calls to a trace file
+  ///
+  /// Replay the trace against a copy of the database with
+  /// `replayTrace(from:threads:speedup:)` to compare option sets on real
+  /// traffic. Only one query trace can run at a time.
+  /// - Parameters:
+  ///   - path: Trace file to create
+  ///   - options: Sampling, size limit and filters
+  /// - Throws: RocksDBError on failure (e.g. a trace is already running)
+  public func startTrace(to path: String, options: RocksDBTraceOptions = .default) throws {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      try RocksDBError.check(rocksdb_start_trace(
+        h, path, UInt64(max(options.samplingFrequency, 1)), options.maxTraceSize,
+        options.excluded.rawValue, options.preserveWriteOrder ? 1 : 0))
+    }
+  }
+
+  /// Stop the running query trace and close its file
+  /// - Throws: RocksDBError on failure
+  public func endTrace() throws {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      try RocksDBError.check(rocksdb_end_trace(h))
+    }
+  }
+
+  /// Execute a recorded query trace against this database
+  ///
+  /// Writes in the trace are applied, so replay into a copy of the traced
+  /// database (e.g. a checkpoint) with the same column families open.
+  /// - Parameters:
+  ///   - path: Trace file recorded with `startTrace(to:options:)`
+  ///   - threads: Worker threads executing records
+  ///   - speedup: Divides the recorded gaps between operations (1 replays in real time)
+  /// - Returns: Wall-clock time and per-operation latency percentiles
+  /// - Throws: RocksDBError on failure
+  public func replayTrace(from path: String, threads: Int = 1, speedup: Double = 1) throws -> RocksDBReplayResult {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      var values = RocksDBReplayValues()
+      try RocksDBError.check(rocksdb_replay_trace(h, path, UInt32(clamping: max(threads, 1)), speedup, &values))
+      return RocksDBReplayResult(values)
+    }
+  }
+
+  // MARK: - Memory Usage
+
+  /// Approximate memory held by several databases and caches
+  ///
+  /// The block caches configured in the databases are included; pass
+  /// other caches, such as a row cache or one only shared through a write
+  /// buffer manager, in `caches`. Shared caches are counted once.
+  /// - Parameters:
+  ///   - databases: Databases to account for
+  ///   - caches: Additional caches to account for
+  /// - Returns: Memory breakdown
+  /// - Throws: RocksDBError.databaseClosed if any database is closed
+  public static func approximateMemoryUsage(
+    of databases: [RocksDB],
+    caches: [RocksDBCache] = []
+  ) throws -> RocksDBMemoryUsage {
+    var seen = Set<ObjectIdentifier>()
+    let distinct = databases.filter { seen.insert(ObjectIdentifier($0)).inserted }
+    let cacheHandles: [RocksDBCacheRef?] = caches.map { $0.handle }
+
+    return try withOpenHandles(distinct[...]) { handles in
+      var values = RocksDBMemoryUsageValues()
+      try RocksDBError.check(rocksdb_approximate_memory_usage(handles, handles.count,
+                                                              cacheHandles, cacheHandles.count,
+                                                              &values))
+      return RocksDBMemoryUsage(values)
+    }
+  }
+
+  /// Approximate memory held by this database and its block caches
+  /// - Throws: RocksDBError.databaseClosed if the database is closed
+  public func approximateMemoryUsage() throws -> RocksDBMemoryUsage {
+    try RocksDB.approximateMemoryUsage(of: [self])
+  }
+
+  /// Call `body` with the handles of all databases, holding each one's read
+  /// lock so none can close underneath it
+  private static func withOpenHandles<R>(
+    _ databases: ArraySlice<RocksDB>,
+    _ handles: [RocksDBRef?] = [],
+    _ body: ([RocksDBRef?]) throws -> R
+  ) throws -> R {
+    guard let database = databases.first else {
+      return try body(handles)
+    }
+    return try database.lock.withReadLock {
+      guard let h = database.handle else {
+        throw RocksDBError.databaseClosed
+      }
+      return try withOpenHandles(databases.dropFirst(), handles + [h], body)
+    }
+  }
+
+  // MARK: - Statistics
+
+  /// Whether the database was opened with `enableStatistics`
+  public var statisticsEnabled: Bool {
+    lock.withReadLock {
+      guard let h = handle else { return false }
+      return rocksdb_statistics_enabled(h) != 0
+    }
+  }
+
+  /// Current value of a ticker (0 without statistics)
+  public func tickerCount(_ ticker: RocksDBTicker) -> UInt64 {
+    lock.withReadLock {
+      guard let h = handle else { return 0 }
+      return rocksdb_statistics_get_ticker(h, ticker.id)
+    }
+  }
+
+  /// Every ticker's value, read in one call (empty without statistics)
+  public func tickerSnapshot() -> [RocksDBTicker: UInt64] {
+    lock.withReadLock {
+      guard let h = handle else { return [:] }
+
+      let tickers = RocksDBTicker.all
+      var values = [UInt64](repeating: 0, count: Int(rocksdb_statistics_ticker_count()))
+      let count = rocksdb_statistics_get_all_tickers(h, &values, values.count)
+
+      var snapshot: [RocksDBTicker: UInt64] = [:]
+      snapshot.reserveCapacity(count)
+      for ticker in tickers where Int(ticker.id) < count {
+        snapshot[ticker] = values[Int(ticker.id)]
+      }
+      return snapshot
+    }
+  }
+
+  /// Current summary of a histogram (nil without statistics)
+  public func histogramData(_ histogram: RocksDBHistogram) -> RocksDBHistogramData? {
+    lock.withReadLock {
+      guard let h = handle else { return nil }
+
+      var values = RocksDBHistogramValues()
+      guard rocksdb_statistics_get_histogram(h, histogram.id, &values) != 0 else {
+        return nil
+      }
+      return RocksDBHistogramData(values)
+    }
+  }
+
+  /// What the statistics object measures; may be changed at runtime
+  /// (nil without statistics)
+  public var statisticsLevel: RocksDBStatsLevel? {
+    get {
+      lock.withReadLock {
+        guard let h = handle else { return nil }
+        return RocksDBStatsLevel(rawValue: rocksdb_statistics_get_level(h))
+      }
+    }
+    set {
+      guard let level = newValue else { return }
+      lock.withReadLock {
+        if let h = handle {
+          rocksdb_statistics_set_level(h, level.rawValue)
+        }
+      }
+    }
+  }
+
+  /// Zero every ticker and histogram
+  /// - Throws: RocksDBError.notSupported without statistics
+  public func resetStatistics() throws {
+    try lock.withReadLock {
+      guard let h = handle else {
+        throw RocksDBError.databaseClosed
+      }
+
+      try RocksDBError.check(rocksdb_statistics_reset(h))
+    }
+  }
+
+  /// Estimated number of keys in the database
+  public var estimatedKeyCount: Int? {
+    intProperty(.estimateNumKeys).map { Int(clamping: $0) }
+  }
+
+  /// Current memory usage statistics (see `approximateMemoryUsage()` for a breakdown)
+  public var memoryUsage: String? {
+    getProperty("rocksdb.cur-size-all-mem-tables")
+  }
+}
+
+// MARK: - Internal Helpers
+
+/// Stop flag and first error shared by the partitions of a parallel scan
+private final class ParallelScanState: @unchecked Sendable {
+  private let lock = NSLock()
+  private var stopped = false
+  private var firstError: Error?
+
+  var isStopped: Bool {
+    lock.withLock { stopped }
+  }
+
+  var error: Error? {
+    lock.withLock { firstError }
+  }
+
+  func stop() {
+    lock.withLock { stopped = true }
+  }
+
+  func fail(_ error: Error) {
+    lock.withLock {
+      if firstError == nil {
+        firstError = error
+      }
+      stopped = true
+    }
+  }
+}
+
+extension Array where Element == Data {
+  /// Pack keys into one contiguous buffer and expose parallel pointer/length arrays
+  internal func withPackedKeys<R>(
+    _ body: (UnsafePointer<UnsafePointer<CChar>?>, UnsafePointer<Int>) throws -> R
+  ) rethrows -> R {
+    guard !isEmpty else {
+      // Array storage may have no base address when empty
+      let none: UnsafePointer<CChar>? = nil
+      return try withUnsafePointer(to: none) { ptrs in
+        try withUnsafePointer(to: 0) { lens in
+          try body(ptrs, lens)
+        }
+      }
+    }
+
+    var buffer = Data(capacity: reduce(0) { $0 + $1.count })
+    let lengths = map { $0.count }
+    for key in self {
+      buffer.append(key)
+    }
+
+    return try buffer.withUnsafeBytes { raw in
+      let base = raw.baseAddress?.assumingMemoryBound(to: CChar.self)
+      var pointers: [UnsafePointer<CChar>?] = []
+      pointers.reserveCapacity(count)
+
+      var offset = 0
+      for length in lengths {
+        pointers.append(base.map { $0 + offset })
+        offset += length
+      }
+
+      return try pointers.withUnsafeBufferPointer { ptrs in
+        try lengths.withUnsafeBufferPointer { lens in
+          try body(ptrs.baseAddress!, lens.baseAddress!)
+        }
+      }
+    }
+  }
+}
+
+extension Optional where Wrapped == Data {
+  /// Expose the bytes as a C pointer and length; nil passes NULL, while
+  /// empty data still passes a non-NULL pointer
+  internal func withOptionalBytes<R>(
+    _ body: (UnsafePointer<CChar>?, Int) throws -> R
+  ) rethrows -> R {
+    guard let data = self else {
+      return try body(nil, 0)
+    }
+    guard !data.isEmpty else {
+      var empty: CChar = 0
+      return try body(&empty, 0)
+    }
+    return try data.withUnsafeBytes { raw in
+      try body(raw.baseAddress!.assumingMemoryBound(to: CChar.self), data.count)
+    }
+  }
+}
+
+extension Array where Element == String {
+  /// Expose the strings as an array of NUL-terminated C strings
+  internal func withCStringPointers<R>(
+    _ body: (UnsafePointer<UnsafePointer<CChar>?>) throws -> R
+  ) rethrows -> R {
+    let cStrings: [UnsafeMutablePointer<CChar>?] = map { strdup($0) }
+    defer { cStrings.forEach { free($0) } }
+
+    let pointers = cStrings.map { UnsafePointer($0) }
+    return try pointers.withUnsafeBufferPointer { ptrs in
+      try body(ptrs.baseAddress!)
+    }
   }
 }
@@ -0,0 +1,108 @@
+//
+//  RocksDBAggregation.swift
+//  RocksDB.swift
+//
+//  Range aggregates computed inside the bridge
+//
+
+import Foundation
+import CRocksDB
+
+/// Integer field at a fixed offset of every value, aggregated by `RocksDB.aggregate`
+public struct RocksDBAggregateField: Sendable, Equatable {
+  /// Byte order of the field
+  public enum ByteOrder: Sendable {
+    case littleEndian
+    case bigEndian
+  }
+
+  /// Offset of the field in the value
+  public private(set) var offset: Int
+  /// Width in bytes: 1, 2, 4 or 8
+  public private(set) var width: Int
+  /// Byte order of the field
+  public var byteOrder: ByteOrder
+  /// Whether the field is a two's complement signed integer
+  public var isSigned: Bool
+
+  /// - Throws: RocksDBError.invalidArgument for a negative offset or a
+  ///   width other than 1, 2, 4 or 8
+  public init(offset: Int, width: Int, byteOrder: ByteOrder = .littleEndian, isSigned: Bool = false) throws {
+    guard offset >= 0 else {
+      throw RocksDBError.invalidArgument("Field offsets must not be negative")
+    }
+    guard [1, 2, 4, 8].contains(width) else {
+      throw RocksDBError.invalidArgument("Field width must be 1, 2, 4 or 8 bytes")
+    }
+    self.offset = offset
+    self.width = width
+    self.byteOrder = byteOrder
+    self.isSigned = isSigned
+  }
+
+  /// Field holding values of an integer type
+  /// - Throws: RocksDBError.invalidArgument for a negative offset
+  public static func integer<T: FixedWidthInteger>(
+    _ type: T.Type,
+    at offset: Int,
+    byteOrder: ByteOrder = .littleEndian
+  ) throws -> RocksDBAggregateField {
+    try RocksDBAggregateField(offset: offset, width: MemoryLayout<T>.size, byteOrder: byteOrder,
+                          isSigned: T.isSigned)
+  }
+
+  internal var native: RocksDBAggregateFieldSpec {
+    RocksDBAggregateFieldSpec(
+      offset: offset,
+      width: width,
+      byte_order: byteOrder == .bigEndian ? RocksDBByteOrderBigEndian : RocksDBByteOrderLittleEndian,
+      is_signed: isSigned ? 1 : 0)
+  }
+}
+
+/// Totals over a key range, computed without returning its entries
+///
+/// Field aggregates are 64-bit patterns: read `sum`, `min` and `max` for
+/// unsigned fields and the `signed` variants for signed ones. Sums wrap on
+/// overflow.
+public struct RocksDBAggregate: Sendable, Equatable {
+  /// Entries in the range
+  public var count: UInt64
+  /// Total key bytes
+  public var keyBytes: UInt64
+  /// Total value bytes
+  public var valueBytes: UInt64
+  /// Entries whose value is long enough to hold the field
+  public var fieldCount: UInt64
+  /// Sum of the field
+  public var sum: UInt64
+  /// Smallest field value (nil if no entry holds the field)
+  public var min: UInt64?
+  /// Largest field value (nil if no entry holds the field)
+  public var max: UInt64?
+
+  /// Sum of a signed field
+  public var signedSum: Int64 {
+    Int64(bitPattern: sum)
+  }
+
+  /// Smallest value of a signed field
+  public var signedMin: Int64? {
+    min.map { Int64(bitPattern: $0) }
+  }
+
+  /// Largest value of a signed field
+  public var signedMax: Int64? {
+    max.map { Int64(bitPattern: $0) }
+  }
+
+  internal init(_ values: RocksDBAggregateValues) {
+    count = values.count
+    keyBytes = values.key_bytes
+    valueBytes = values.value_bytes
+    fieldCount = values.field_count
+    sum = values.sum
+    min = values.field_count > 0 ? values.min : nil
+    max = values.field_count > 0 ? values.max : nil
+  }
+}
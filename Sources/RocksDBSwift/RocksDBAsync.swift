@@ -0,0 +1,158 @@
+//
+//  RocksDBAsync.swift
+//  RocksDB.swift
+//
+//  async/await operations run on the bridge I/O thread pool
+//
+
+import Foundation
+import CRocksDB
+
+/// Bridge-owned thread pool that runs the blocking work of async operations
+///
+/// Async calls suspend the calling task and run the synchronous operation on
+/// one of these C++ threads, so a read that misses the cache and waits on
+/// disk never occupies a thread of the Swift cooperative pool.
+public enum RocksDBIOPool {
+  /// Number of I/O threads (default: 8)
+  public static var threadCount: Int {
+    get { Int(rocksdb_io_pool_get_threads()) }
+    set { rocksdb_io_pool_set_threads(Int32(clamping: newValue)) }
+  }
+
+  /// Operations waiting for a free I/O thread
+  public static var queueLength: Int {
+    Int(rocksdb_io_pool_queue_length())
+  }
+
+  /// Run a blocking operation on the pool and resume with its result
+  /// - Parameter body: Operation to run on an I/O thread
+  /// - Returns: Result of `body`
+  /// - Throws: Any error thrown by `body`
+  public static func run<T: Sendable>(_ body: @escaping @Sendable () throws -> T) async throws -> T {
+    try await withCheckedThrowingContinuation { continuation in
+      submit {
+        continuation.resume(with: Result(catching: body))
+      }
+    }
+  }
+
+  /// Queue a job on the pool without waiting for it
+  /// - Parameter body: Job to run on an I/O thread
+  internal static func submit(_ body: @escaping @Sendable () -> Void) {
+    rocksdb_io_pool_submit({ context in
+      Unmanaged<Job>.fromOpaque(context!).takeRetainedValue().body()
+    }, Unmanaged.passRetained(Job(body)).toOpaque())
+  }
+
+  private final class Job: @unchecked Sendable {
+    let body: () -> Void
+
+    init(_ body: @escaping () -> Void) {
+      self.body = body
+    }
+  }
+}
+
+// MARK: - Async Operations
+
+// Named apart from the synchronous calls: with both overloads under one
+// name, async contexts resolve `db.get(key)` to the async one, and calls
+// that mean to block no longer compile without `await`.
+extension RocksDB {
+  /// Get value for key without blocking the calling thread
+  /// - Parameters:
+  ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options
+  /// - Returns: Value data or nil if not found
+  /// - Throws: RocksDBError on failure
+  public func getAsync(
+    _ key: Data,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBReadOptions = .default
+  ) async throws -> Data? {
+    try await RocksDBIOPool.run {
+      try self.get(key, in: columnFamily, options: options)
+    }
+  }
+
+  /// Get values for many keys without blocking the calling thread
+  /// - Parameters:
+  ///   - keys: Keys to look up
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options
+  ///   - sortedInput: Set when `keys` are already in ascending byte order
+  /// - Returns: Values in the same order as `keys`, nil for missing keys
+  /// - Throws: RocksDBError if any lookup fails with an error other than not found
+  public func multiGetAsync(
+    _ keys: [Data],
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBReadOptions = .default,
+    sortedInput: Bool = false
+  ) async throws -> [Data?] {
+    try await RocksDBIOPool.run {
+      try self.multiGet(keys, in: columnFamily, options: options, sortedInput: sortedInput)
+    }
+  }
+
+  /// Put a key-value pair without blocking the calling thread
+  /// - Parameters:
+  ///   - value: Value data
+  ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Write options
+  /// - Throws: RocksDBError on failure
+  public func putAsync(
+    _ value: Data,
+    forKey key: Data,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBWriteOptions = .default
+  ) async throws {
+    try await RocksDBIOPool.run {
+      try self.put(value, forKey: key, in: columnFamily, options: options)
+    }
+  }
+
+  /// Write a batch atomically without blocking the calling thread
+  ///
+  /// The batch must not be modified until the write finishes.
+  /// - Parameters:
+  ///   - batch: Batch to write
+  ///   - options: Write options
+  /// - Throws: RocksDBError on failure
+  public func writeBatchAsync(_ batch: RocksDBBatch, options: RocksDBWriteOptions = .default) async throws {
+    try await RocksDBIOPool.run {
+      try self.writeBatch(batch, options: options)
+    }
+  }
+
+  /// Flush memtables to disk without blocking the calling thread
+  /// - Parameters:
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - wait: Wait for flush to complete
+  /// - Throws: RocksDBError on failure
+  public func flushAsync(_ columnFamily: RocksDBColumnFamily? = nil, wait: Bool = true) async throws {
+    try await RocksDBIOPool.run {
+      try self.flush(columnFamily, wait: wait)
+    }
+  }
+
+  /// Compact a range of keys without blocking the calling thread
+  /// - Parameters:
+  ///   - startKey: Start of range (nil for beginning)
+  ///   - endKey: End of range (nil for end)
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Manual compaction options
+  /// - Throws: RocksDBError on failure
+  public func compactRangeAsync(
+    from startKey: Data? = nil,
+    to endKey: Data? = nil,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBCompactRangeOptions = .default
+  ) async throws {
+    try await RocksDBIOPool.run {
+      try self.compactRange(from: startKey, to: endKey, in: columnFamily, options: options)
+    }
+  }
+}
@@ -0,0 +1,208 @@
+//
+//  RocksDBAttributeGroups.swift
+//  RocksDB.swift
+//
+//  Entities split across column families
+//
+
+import Foundation
+import CRocksDB
+
+/// The columns of an entity that live in one column family
+///
+/// Splitting an entity into groups lets hot and cold attributes use
+/// families with different compression and caching, while still being
+/// written atomically and read back in one call.
+public struct RocksDBAttributeGroup: @unchecked Sendable {
+  /// Column family holding this group
+  public let columnFamily: RocksDBColumnFamily
+
+  /// Column names and values
+  public var columns: [(name: Data, value: Data)]
+
+  public init(columnFamily: RocksDBColumnFamily, columns: [(name: Data, value: Data)]) {
+    self.columnFamily = columnFamily
+    self.columns = columns
+  }
+}
+
+extension Array where Element == RocksDBAttributeGroup {
+  /// Flatten the groups into the layout the bridge expects
+  internal func withFlattenedColumns<R>(
+    _ body: (
+      _ families: UnsafePointer<RocksDBColumnFamilyRef?>,
+      _ columnCounts: UnsafePointer<Int>,
+      _ names: UnsafePointer<UnsafePointer<CChar>?>, _ nameLens: UnsafePointer<Int>,
+      _ values: UnsafePointer<UnsafePointer<CChar>?>, _ valueLens: UnsafePointer<Int>
+    ) throws -> R
+  ) rethrows -> R {
+    let families: [RocksDBColumnFamilyRef?] = map { $0.columnFamily.handle }
+    let columnCounts = map { $0.columns.count }
+    let columns = flatMap(\.columns)
+
+    return try families.withUnsafeBufferPointer { familyPtrs in
+      try columnCounts.withUnsafeBufferPointer { countPtrs in
+        try columns.map(\.name).withPackedKeys { namePtrs, nameLens in
+          try columns.map(\.value).withPackedKeys { valuePtrs, valueLens in
+            try body(familyPtrs.baseAddress!, countPtrs.baseAddress!,
+                     namePtrs, nameLens, valuePtrs, valueLens)
+          }
+        }
+      }
+    }
+  }
+}
+
+/// Iterator over keys of several column families, yielding per key the
+/// attribute groups of the families that contain it
+///
+/// Like `RocksDBIterator`, it must not outlive the database.
+public final class RocksDBAttributeGroupIterator: @unchecked Sendable {
+  private var handle: RocksDBAttributeGroupIteratorRef?
+  private let lock = NSRecursiveLock()
+
+  /// Families the iterator reads, in creation order
+  public let columnFamilies: [RocksDBColumnFamily]
+
+  internal init(handle: RocksDBAttributeGroupIteratorRef, columnFamilies: [RocksDBColumnFamily]) {
+    self.handle = handle
+    self.columnFamilies = columnFamilies
+  }
+
+  deinit {
+    close()
+  }
+
+  /// Close the iterator and release resources
+  public func close() {
+    lock.withLock {
+      if let h = handle {
+        rocksdb_attribute_group_iterator_destroy(h)
+        handle = nil
+      }
+    }
+  }
+
+  // MARK: - Positioning
+
+  /// Whether iterator is positioned at a valid entry
+  public var isValid: Bool {
+    lock.withLock {
+      guard let h = handle else { return false }
+      return rocksdb_attribute_group_iterator_valid(h) != 0
+    }
+  }
+
+  /// Seek to first key
+  public func seekToFirst() {
+    lock.withLock {
+      guard let h = handle else { return }
+      rocksdb_attribute_group_iterator_seek_to_first(h)
+    }
+  }
+
+  /// Seek to last key
+  public func seekToLast() {
+    lock.withLock {
+      guard let h = handle else { return }
+      rocksdb_attribute_group_iterator_seek_to_last(h)
+    }
+  }
+
+  /// Seek to first key >= target
+  public func seek(to key: Data) {
+    lock.withLock {
+      guard let h = handle else { return }
+      key.withUnsafeBytes { keyPtr in
+        rocksdb_attribute_group_iterator_seek(h,
+                                              keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                              key.count)
+      }
+    }
+  }
+
+  /// Seek to last key <= target
+  public func seekForPrev(to key: Data) {
+    lock.withLock {
+      guard let h = handle else { return }
+      key.withUnsafeBytes { keyPtr in
+        rocksdb_attribute_group_iterator_seek_for_prev(h,
+                                                       keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                                       key.count)
+      }
+    }
+  }
+
+  /// Move to next key
+  public func next() {
+    lock.withLock {
+      guard let h = handle else { return }
+      rocksdb_attribute_group_iterator_next(h)
+    }
+  }
+
+  /// Move to previous key
+  public func prev() {
+    lock.withLock {
+      guard let h = handle else { return }
+      rocksdb_attribute_group_iterator_prev(h)
+    }
+  }
+
+  // MARK: - Current Entry
+
+  /// Current key (nil if invalid)
+  public var key: Data? {
+    lock.withLock {
+      guard let h = handle else { return nil }
+      var keyLen: Int = 0
+      guard let keyPtr = rocksdb_attribute_group_iterator_key(h, &keyLen) else {
+        return nil
+      }
+      return Data(bytes: keyPtr, count: keyLen)
+    }
+  }
+
+  /// Access the current key's groups in place
+  ///
+  /// Only families that contain the key are passed; the views are valid
+  /// inside `body` only.
+  /// - Parameter body: Closure receiving (family, columns) pairs
+  /// - Returns: Result of `body`, or nil if the iterator is invalid
+  public func withGroups<R>(
+    _ body: ([(columnFamily: RocksDBColumnFamily, columns: RocksDBWideColumns)]) throws -> R
+  ) rethrows -> R? {
+    try lock.withLock {
+      guard let h = handle, rocksdb_attribute_group_iterator_valid(h) != 0 else { return nil }
+
+      let count = rocksdb_attribute_group_iterator_group_count(h)
+      var groups: [(columnFamily: RocksDBColumnFamily, columns: RocksDBWideColumns)] = []
+      groups.reserveCapacity(count)
+      for group in 0..<count {
+        let index = rocksdb_attribute_group_iterator_group_family(h, group)
+        guard index < columnFamilies.count else { continue }
+        groups.append((columnFamily: columnFamilies[index],
+                       columns: RocksDBWideColumns(groupIterator: h, group: group)))
+      }
+      return try body(groups)
+    }
+  }
+
+  /// Current key's groups, copied (nil if invalid)
+  public var groups: [RocksDBAttributeGroup]? {
+    withGroups { groups in
+      groups.map { RocksDBAttributeGroup(columnFamily: $0.columnFamily, columns: $0.columns.copy()) }
+    }
+  }
+
+  // MARK: - Status
+
+  /// Check iterator status for errors
+  /// - Throws: RocksDBError if iterator encountered an error
+  public func checkStatus() throws {
+    try lock.withLock {
+      guard let h = handle else { return }
+      try RocksDBError.check(rocksdb_attribute_group_iterator_status(h))
+    }
+  }
+}
@@ -12,10 +12,58 @@ import CRocksDB
 public final class RocksDBBatch: @unchecked Sendable {
   internal let handle: RocksDBBatchRef
   private let lock = NSRecursiveLock()
+  private var families = BatchFamilies()
+
+  /// Bytes preallocated for the batch representation
+  public let reservedBytes: Int
+
+  /// Maximum batch size in bytes (0 = unlimited)
+  public let maxBytes: Int
 
   /// Create a new empty batch
   public init() {
     self.handle = rocksdb_batch_create()
+    self.reservedBytes = 0
+    self.maxBytes = 0
+  }
+
+  /// Create a new empty batch with preallocated capacity
+  ///
+  /// Operations that would grow the batch past `maxBytes` are dropped and
+  /// the batch is marked failed: `validate()` and `RocksDB.writeBatch` throw
+  /// until the batch is cleared.
+  /// - Parameters:
+  ///   - reservedBytes: Bytes to preallocate
+  ///   - maxBytes: Maximum batch size in bytes (0 = unlimited)
+  public init(reservedBytes: Int, maxBytes: Int = 0) {
+    self.handle = rocksdb_batch_create_with_capacity(reservedBytes, maxBytes)
+    self.reservedBytes = reservedBytes
+    self.maxBytes = maxBytes
+  }
+
+  /// Rebuild a batch from its serialized form
+  ///
+  /// Takes the bytes of `serializedData` or `RocksDBChangeBatch.data` as
+  /// is, so a follower applies a shipped batch with one write and no
+  /// per-entry work. With `verify`, every operation is parsed (not copied)
+  /// first; a corrupt batch fails only after reaching the WAL, so pass
+  /// false only when the transport already checks the bytes.
+  /// - Parameters:
+  ///   - data: Serialized `WriteBatch`
+  ///   - verify: Check that every operation parses and the count matches
+  /// - Throws: RocksDBError.corruption if the data is not a valid batch
+  public init(serializedData data: Data, verify: Bool = true) throws {
+    var batch: RocksDBBatchRef?
+    try data.withUnsafeBytes { ptr in
+      try RocksDBError.check(rocksdb_batch_create_from_data(
+        ptr.baseAddress?.assumingMemoryBound(to: CChar.self), ptr.count, verify ? 1 : 0, &batch))
+    }
+    guard let batch else {
+      throw RocksDBError.corruption("Malformed WriteBatch")
+    }
+    self.handle = batch
+    self.reservedBytes = 0
+    self.maxBytes = 0
   }
 
   deinit {
@@ -28,15 +76,18 @@ public final class RocksDBBatch: @unchecked Sendable {
   /// - Parameters:
   ///   - value: Value data
   ///   - key: Key data
-  public func put(_ value: Data, forKey key: Data) {
+  ///   - columnFamily: Column family (nil for the default family)
+  public func put(_ value: Data, forKey key: Data, in columnFamily: RocksDBColumnFamily? = nil) {
     lock.withLock {
-      key.withUnsafeBytes { keyPtr in
-        value.withUnsafeBytes { valuePtr in
-          rocksdb_batch_put(handle,
-                            keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
-                            key.count,
-                            valuePtr.baseAddress?.assumingMemoryBound(to: CChar.self),
-                            value.count)
+      families.with(columnFamily) { cf in
+        key.withUnsafeBytes { keyPtr in
+          value.withUnsafeBytes { valuePtr in
+            rocksdb_batch_put_cf(handle, cf,
+                                 keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                 key.count,
+                                 valuePtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                 value.count)
+          }
         }
       }
     }
@@ -47,20 +98,321 @@ public final class RocksDBBatch: @unchecked Sendable {
   ///   - value: String value
   ///   - key: String key
   public func put(_ value: String, forKey key: String) {
-    if let keyData = key.data(using: .utf8),
-       let valueData = value.data(using: .utf8) {
-      put(valueData, forKey: keyData)
+    lock.withLock {
+      key.withUTF8Bytes { keyPtr in
+        value.withUTF8Bytes { valuePtr in
+          rocksdb_batch_put_cf(handle, nil,
+                               keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                               keyPtr.count,
+                               valuePtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                               valuePtr.count)
+        }
+      }
+    }
+  }
+
+  /// Add many put operations in a single native call
+  /// - Parameter entries: Key-value pairs to add, in order
+  public func put(contentsOf entries: [(key: Data, value: Data)]) {
+    guard !entries.isEmpty else { return }
+
+    lock.withLock {
+      entries.map(\.key).withPackedKeys { keyPtrs, keyLens in
+        entries.map(\.value).withPackedKeys { valuePtrs, valueLens in
+          rocksdb_batch_put_many(handle, entries.count, keyPtrs, keyLens, valuePtrs, valueLens)
+        }
+      }
+    }
+  }
+
+  /// Add many put operations from a caller-packed buffer
+  ///
+  /// Entry `i` has its key at `offsets[2i]..<offsets[2i+1]` and its value at
+  /// `offsets[2i+1]..<offsets[2i+2]`, so `offsets` holds `2 * count + 1` items.
+  /// - Parameters:
+  ///   - buffer: Concatenated keys and values
+  ///   - offsets: Entry boundaries within `buffer`, non-decreasing and no
+  ///     larger than `buffer.count`
+  /// - Throws: RocksDBError.invalidArgument if `offsets` is malformed; no
+  ///   entry is added in that case
+  public func put(packed buffer: Data, offsets: [Int]) throws {
+    guard offsets.count % 2 == 1 else {
+      throw RocksDBError.invalidArgument("offsets must hold 2 * count + 1 items")
+    }
+    var previous = 0
+    for offset in offsets {
+      guard offset >= previous, offset <= buffer.count else {
+        throw RocksDBError.invalidArgument("offset \(offset) is out of order or past the buffer")
+      }
+      previous = offset
+    }
+    let numEntries = offsets.count / 2
+    guard numEntries > 0 else { return }
+
+    lock.withLock {
+      buffer.withUnsafeBytes { bufferPtr in
+        offsets.withUnsafeBufferPointer { offsetPtr in
+          rocksdb_batch_put_packed(handle,
+                                   bufferPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                   offsetPtr.baseAddress,
+                                   numEntries)
+        }
+      }
+    }
+  }
+
+  /// Add a put operation whose key and value are concatenations of parts
+  ///
+  /// Composite keys are assembled natively, without concatenating them first.
+  /// - Parameters:
+  ///   - valueParts: Value segments
+  ///   - keyParts: Key segments
+  public func put(parts valueParts: [Data], forKeyParts keyParts: [Data]) {
+    lock.withLock {
+      keyParts.withPackedKeys { keyPtrs, keyLens in
+        valueParts.withPackedKeys { valuePtrs, valueLens in
+          rocksdb_batch_put_parts(handle,
+                                  keyParts.count, keyPtrs, keyLens,
+                                  valueParts.count, valuePtrs, valueLens)
+        }
+      }
+    }
+  }
+
+  /// Add a wide-column entity to the batch
+  ///
+  /// Unlike the other operations this needs an explicit family; use
+  /// `RocksDB.defaultColumnFamily` for the default family.
+  /// - Parameters:
+  ///   - columns: Column names and values
+  ///   - key: Key data
+  ///   - columnFamily: Column family
+  public func putEntity(
+    _ columns: [(name: Data, value: Data)],
+    forKey key: Data,
+    in columnFamily: RocksDBColumnFamily
+  ) {
+    lock.withLock {
+      families.with(columnFamily) { cf in
+        key.withUnsafeBytes { keyPtr in
+          columns.map(\.name).withPackedKeys { namePtrs, nameLens in
+            columns.map(\.value).withPackedKeys { valuePtrs, valueLens in
+              rocksdb_batch_put_entity_cf(handle, cf,
+                                          keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                          key.count,
+                                          columns.count, namePtrs, nameLens, valuePtrs, valueLens)
+            }
+          }
+        }
+      }
+    }
+  }
+
+  /// Add a timestamped put to the batch
+  ///
+  /// For families using `.bytewiseWithU64Timestamp`; needs an explicit
+  /// family (see `RocksDB.defaultColumnFamily`).
+  /// - Parameters:
+  ///   - value: Value data
+  ///   - key: Key data
+  ///   - timestamp: Version timestamp
+  ///   - columnFamily: Column family
+  public func put(
+    _ value: Data,
+    forKey key: Data,
+    timestamp: UInt64,
+    in columnFamily: RocksDBColumnFamily
+  ) {
+    lock.withLock {
+      families.with(columnFamily) { cf in
+        key.withUnsafeBytes { keyPtr in
+          value.withUnsafeBytes { valuePtr in
+            rocksdb_batch_put_with_timestamp_cf(handle, cf,
+                                                keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                                key.count,
+                                                timestamp,
+                                                valuePtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                                value.count)
+          }
+        }
+      }
+    }
+  }
+
+  /// Add a timestamped delete to the batch
+  /// - Parameters:
+  ///   - key: Key data
+  ///   - timestamp: Timestamp of the tombstone
+  ///   - columnFamily: Column family
+  public func delete(_ key: Data, timestamp: UInt64, in columnFamily: RocksDBColumnFamily) {
+    lock.withLock {
+      families.with(columnFamily) { cf in
+        key.withUnsafeBytes { keyPtr in
+          rocksdb_batch_delete_with_timestamp_cf(handle, cf,
+                                                 keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                                 key.count,
+                                                 timestamp)
+        }
+      }
+    }
+  }
+
+  /// Add an entity split into attribute groups across column families
+  /// - Parameters:
+  ///   - groups: Groups, each with its family and columns
+  ///   - key: Key data
+  public func putEntity(groups: [RocksDBAttributeGroup], forKey key: Data) {
+    guard !groups.isEmpty else { return }
+
+    lock.withLock {
+      families.with(groups.map(\.columnFamily)) {
+        key.withUnsafeBytes { keyPtr in
+          groups.withFlattenedColumns { families, counts, names, nameLens, values, valueLens in
+            rocksdb_batch_put_attribute_groups(handle,
+                                               keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                               key.count,
+                                               groups.count, families, counts,
+                                               names, nameLens, values, valueLens)
+          }
+        }
+      }
+    }
+  }
+
+  /// Add a merge operation to the batch
+  /// - Parameters:
+  ///   - value: Merge operand
+  ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
+  public func merge(_ value: Data, forKey key: Data, in columnFamily: RocksDBColumnFamily? = nil) {
+    lock.withLock {
+      families.with(columnFamily) { cf in
+        key.withUnsafeBytes { keyPtr in
+          value.withUnsafeBytes { valuePtr in
+            rocksdb_batch_merge_cf(handle, cf,
+                                   keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                   key.count,
+                                   valuePtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                   value.count)
+          }
+        }
+      }
     }
   }
 
+  /// Add a merge operation with string key and operand
+  public func merge(_ value: String, forKey key: String) {
+    lock.withLock {
+      key.withUTF8Bytes { keyPtr in
+        value.withUTF8Bytes { valuePtr in
+          rocksdb_batch_merge_cf(handle, nil,
+                                 keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                 keyPtr.count,
+                                 valuePtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                 valuePtr.count)
+        }
+      }
+    }
+  }
+
+  /// Add a put operation under a typed key, encoded without allocating
+  /// - Parameters:
+  ///   - value: Value data
+  ///   - key: Key, written in its order-preserving encoding
+  ///   - columnFamily: Column family (nil for the default family)
+  public func put<Key: RocksDBKeyEncodable>(_ value: Data, forKey key: Key,
+                                            in columnFamily: RocksDBColumnFamily? = nil) {
+    lock.withLock {
+      families.with(columnFamily) { cf in
+        key.withEncodedKey { keyPtr in
+          value.withUnsafeBytes { valuePtr in
+            rocksdb_batch_put_cf(handle, cf,
+                                 keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                 keyPtr.count,
+                                 valuePtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                 value.count)
+          }
+        }
+      }
+    }
+  }
+
+  /// Add a merge operation under a typed key
+  public func merge<Key: RocksDBKeyEncodable>(_ value: Data, forKey key: Key,
+                                              in columnFamily: RocksDBColumnFamily? = nil) {
+    lock.withLock {
+      families.with(columnFamily) { cf in
+        key.withEncodedKey { keyPtr in
+          value.withUnsafeBytes { valuePtr in
+            rocksdb_batch_merge_cf(handle, cf,
+                                   keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                   keyPtr.count,
+                                   valuePtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                   value.count)
+          }
+        }
+      }
+    }
+  }
+
+  /// Add a delete operation for a typed key
+  public func delete<Key: RocksDBKeyEncodable>(_ key: Key, in columnFamily: RocksDBColumnFamily? = nil) {
+    lock.withLock {
+      families.with(columnFamily) { cf in
+        key.withEncodedKey { keyPtr in
+          rocksdb_batch_delete_cf(handle, cf,
+                                  keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                  keyPtr.count)
+        }
+      }
+    }
+  }
+
+  /// Add a counter increment (requires the `.uint64Add` merge operator)
+  public func increment(_ key: Data, by delta: UInt64 = 1) {
+    merge(RocksDBMergeOperator.encodeUInt64(delta), forKey: key)
+  }
+
   /// Add a delete operation to the batch
-  /// - Parameter key: Key to delete
-  public func delete(_ key: Data) {
+  /// - Parameters:
+  ///   - key: Key to delete
+  ///   - columnFamily: Column family (nil for the default family)
+  public func delete(_ key: Data, in columnFamily: RocksDBColumnFamily? = nil) {
+    lock.withLock {
+      families.with(columnFamily) { cf in
+        key.withUnsafeBytes { keyPtr in
+          rocksdb_batch_delete_cf(handle, cf,
+                                  keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                  key.count)
+        }
+      }
+    }
+  }
+
+  /// Add a single-delete operation for a write-once key (see `RocksDB.singleDelete`)
+  /// - Parameters:
+  ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
+  public func singleDelete(_ key: Data, in columnFamily: RocksDBColumnFamily? = nil) {
+    lock.withLock {
+      families.with(columnFamily) { cf in
+        key.withUnsafeBytes { keyPtr in
+          rocksdb_batch_single_delete_cf(handle, cf,
+                                         keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                         key.count)
+        }
+      }
+    }
+  }
+
+  /// Add many delete operations in a single native call
+  /// - Parameter keys: Keys to delete
+  public func delete(contentsOf keys: [Data]) {
+    guard !keys.isEmpty else { return }
+
     lock.withLock {
-      key.withUnsafeBytes { keyPtr in
-        rocksdb_batch_delete(handle,
-                             keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
-                             key.count)
+      keys.withPackedKeys { keyPtrs, keyLens in
+        rocksdb_batch_delete_many(handle, keys.count, keyPtrs, keyLens)
       }
     }
   }
@@ -68,8 +420,12 @@ public final class RocksDBBatch: @unchecked Sendable {
   /// Add a delete operation with string key
   /// - Parameter key: String key to delete
   public func delete(_ key: String) {
-    if let keyData = key.data(using: .utf8) {
-      delete(keyData)
+    lock.withLock {
+      key.withUTF8Bytes { keyPtr in
+        rocksdb_batch_delete_cf(handle, nil,
+                                keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                keyPtr.count)
+      }
     }
   }
 
@@ -77,24 +433,48 @@ public final class RocksDBBatch: @unchecked Sendable {
   /// - Parameters:
   ///   - startKey: Start of range (inclusive)
   ///   - endKey: End of range (exclusive)
-  public func deleteRange(from startKey: Data, to endKey: Data) {
+  ///   - columnFamily: Column family (nil for the default family)
+  public func deleteRange(from startKey: Data, to endKey: Data,
+                          in columnFamily: RocksDBColumnFamily? = nil) {
     lock.withLock {
-      startKey.withUnsafeBytes { startPtr in
-        endKey.withUnsafeBytes { endPtr in
-          rocksdb_batch_delete_range(handle,
-                                     startPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
-                                     startKey.count,
-                                     endPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
-                                     endKey.count)
+      families.with(columnFamily) { cf in
+        startKey.withUnsafeBytes { startPtr in
+          endKey.withUnsafeBytes { endPtr in
+            rocksdb_batch_delete_range_cf(handle, cf,
+                                          startPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                          startKey.count,
+                                          endPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                          endKey.count)
+          }
         }
       }
     }
   }
 
-  /// Clear all operations from the batch
+  /// Throw if an operation could not be added (e.g. `maxBytes` exceeded,
+  /// or a column family of a closed or different database)
+  /// - Throws: RocksDBError describing the first failed operation
+  public func validate() throws {
+    try lock.withLock {
+      if let error = families.error {
+        throw error
+      }
+      try RocksDBError.check(rocksdb_batch_status(handle))
+    }
+  }
+
+  /// Throw if the batch cannot be written to `database`
+  internal func validate(writingTo database: RocksDB) throws {
+    try lock.withLock {
+      try families.check(writingTo: database)
+    }
+  }
+
+  /// Clear all operations from the batch, keeping its allocated capacity
   public func clear() {
     lock.withLock {
       rocksdb_batch_clear(handle)
+      families.reset()
     }
   }
 
@@ -114,6 +494,23 @@ public final class RocksDBBatch: @unchecked Sendable {
     }
   }
 
+  /// Serialized `WriteBatch`, for `init(serializedData:verify:)` on another database
+  public var serializedData: Data {
+    withSerializedData { Data($0) }
+  }
+
+  /// Call `body` with the serialized batch in place, without copying it
+  ///
+  /// The batch stays locked while `body` runs; the bytes are only valid
+  /// inside `body`.
+  public func withSerializedData<R>(_ body: (UnsafeRawBufferPointer) throws -> R) rethrows -> R {
+    try lock.withLock {
+      var length = 0
+      let ptr = rocksdb_batch_data(handle, &length)
+      return try body(UnsafeRawBufferPointer(start: ptr, count: length))
+    }
+  }
+
   /// Whether the batch is empty
   public var isEmpty: Bool {
     count == 0
@@ -0,0 +1,177 @@
+//
+//  RocksDBBatchBuilder.swift
+//  RocksDB.swift
+//
+//  Single-owner write batch built without locking
+//
+
+import Foundation
+import CRocksDB
+
+/// Write batch owned by one task, appended to without locking
+///
+/// `RocksDBBatch` takes a lock for every operation so it can be shared;
+/// most batches are built by one task and written once, and the builder
+/// drops that cost. It cannot be copied or sent to another task, and
+/// `RocksDB.writeBatch(_:options:)` consumes it:
+///
+///     var builder = RocksDBBatchBuilder(reservedBytes: 1 << 20)
+///     for (key, value) in entries {
+///       builder.put(value, forKey: key)
+///     }
+///     try db.writeBatch(builder)
+public struct RocksDBBatchBuilder: ~Copyable {
+  internal let handle: RocksDBBatchRef
+  internal var families = BatchFamilies()
+
+  /// Create an empty builder
+  /// - Parameters:
+  ///   - reservedBytes: Bytes to preallocate
+  ///   - maxBytes: Maximum batch size in bytes (0 = unlimited); operations
+  ///     past it are dropped and the write throws
+  public init(reservedBytes: Int = 0, maxBytes: Int = 0) {
+    self.handle = rocksdb_batch_create_with_capacity(reservedBytes, maxBytes)
+  }
+
+  deinit {
+    rocksdb_batch_destroy(handle)
+  }
+
+  // MARK: - Operations
+
+  /// Add a put operation
+  /// - Parameters:
+  ///   - value: Value data
+  ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
+  public mutating func put(_ value: Data, forKey key: Data, in columnFamily: RocksDBColumnFamily? = nil) {
+    let handle = self.handle
+    families.with(columnFamily) { cf in
+      key.withUnsafeBytes { keyPtr in
+        value.withUnsafeBytes { valuePtr in
+          rocksdb_batch_put_cf(handle, cf,
+                               keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                               key.count,
+                               valuePtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                               value.count)
+        }
+      }
+    }
+  }
+
+  /// Add a put operation under a typed key
+  public mutating func put<Key: RocksDBKeyEncodable>(_ value: Data, forKey key: Key,
+                                                     in columnFamily: RocksDBColumnFamily? = nil) {
+    let handle = self.handle
+    families.with(columnFamily) { cf in
+      key.withEncodedKey { keyPtr in
+        value.withUnsafeBytes { valuePtr in
+          rocksdb_batch_put_cf(handle, cf,
+                               keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                               keyPtr.count,
+                               valuePtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                               value.count)
+        }
+      }
+    }
+  }
+
+  /// Add a merge operation
+  public mutating func merge(_ value: Data, forKey key: Data, in columnFamily: RocksDBColumnFamily? = nil) {
+    let handle = self.handle
+    families.with(columnFamily) { cf in
+      key.withUnsafeBytes { keyPtr in
+        value.withUnsafeBytes { valuePtr in
+          rocksdb_batch_merge_cf(handle, cf,
+                                 keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                 key.count,
+                                 valuePtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                 value.count)
+        }
+      }
+    }
+  }
+
+  /// Add a delete operation
+  public mutating func delete(_ key: Data, in columnFamily: RocksDBColumnFamily? = nil) {
+    let handle = self.handle
+    families.with(columnFamily) { cf in
+      key.withUnsafeBytes { keyPtr in
+        rocksdb_batch_delete_cf(handle, cf,
+                                keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                key.count)
+      }
+    }
+  }
+
+  /// Add a delete operation for a typed key
+  public mutating func delete<Key: RocksDBKeyEncodable>(_ key: Key, in columnFamily: RocksDBColumnFamily? = nil) {
+    let handle = self.handle
+    families.with(columnFamily) { cf in
+      key.withEncodedKey { keyPtr in
+        rocksdb_batch_delete_cf(handle, cf,
+                                keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                keyPtr.count)
+      }
+    }
+  }
+
+  /// Add a single-delete operation for a write-once key (see `RocksDB.singleDelete`)
+  public mutating func singleDelete(_ key: Data, in columnFamily: RocksDBColumnFamily? = nil) {
+    let handle = self.handle
+    families.with(columnFamily) { cf in
+      key.withUnsafeBytes { keyPtr in
+        rocksdb_batch_single_delete_cf(handle, cf,
+                                       keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                       key.count)
+      }
+    }
+  }
+
+  /// Add a delete range operation
+  /// - Parameters:
+  ///   - startKey: Start of range (inclusive)
+  ///   - endKey: End of range (exclusive)
+  ///   - columnFamily: Column family (nil for the default family)
+  public mutating func deleteRange(from startKey: Data, to endKey: Data,
+                                   in columnFamily: RocksDBColumnFamily? = nil) {
+    let handle = self.handle
+    families.with(columnFamily) { cf in
+      startKey.withUnsafeBytes { startPtr in
+        endKey.withUnsafeBytes { endPtr in
+          rocksdb_batch_delete_range_cf(handle, cf,
+                                        startPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                        startKey.count,
+                                        endPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                        endKey.count)
+        }
+      }
+    }
+  }
+
+  /// Remove all operations, keeping the allocated capacity
+  public mutating func clear() {
+    rocksdb_batch_clear(handle)
+    families.reset()
+  }
+
+  // MARK: - Properties
+
+  /// Number of operations in the batch
+  public var count: Int {
+    rocksdb_batch_count(handle)
+  }
+
+  /// Size of batch data in bytes
+  public var dataSize: Int {
+    rocksdb_batch_data_size(handle)
+  }
+
+  /// Whether the batch is empty
+  public var isEmpty: Bool {
+    count == 0
+  }
+}
+
+@available(*, unavailable, message: "Build a batch within one task; use RocksDBBatch to share one")
+extension RocksDBBatchBuilder: Sendable {}
@@ -0,0 +1,97 @@
+//
+//  RocksDBBatchPool.swift
+//  RocksDB.swift
+//
+//  Reusable write batch pool
+//
+
+import Foundation
+import CRocksDB
+
+/// Thread-safe pool of cleared write batches
+///
+/// Reusing batches keeps the native `WriteBatch` buffer allocated between
+/// writes instead of regrowing it by repeated reallocation every time.
+public final class RocksDBBatchPool: @unchecked Sendable {
+  private let lock = NSLock()
+  private var available: [RocksDBBatch] = []
+  private var _reservedBytes: Int
+  private var _maxBatchBytes: Int
+
+  /// Maximum number of idle batches kept in the pool
+  public let maxPooledBatches: Int
+
+  /// Batches that grew past this size are released instead of pooled
+  public let maxRetainedBytes: Int
+
+  /// Create a batch pool
+  /// - Parameters:
+  ///   - reservedBytes: Bytes preallocated for each new batch
+  ///   - maxBatchBytes: Maximum size of a batch in bytes (0 = unlimited)
+  ///   - maxPooledBatches: Maximum number of idle batches kept
+  ///   - maxRetainedBytes: Largest batch returned to the pool
+  public init(
+    reservedBytes: Int = 4 * 1024,
+    maxBatchBytes: Int = 0,
+    maxPooledBatches: Int = 16,
+    maxRetainedBytes: Int = 4 * 1024 * 1024
+  ) {
+    self._reservedBytes = reservedBytes
+    self._maxBatchBytes = maxBatchBytes
+    self.maxPooledBatches = maxPooledBatches
+    self.maxRetainedBytes = maxRetainedBytes
+  }
+
+  /// Bytes preallocated for each new batch
+  public var reservedBytes: Int {
+    get { lock.withLock { _reservedBytes } }
+    set { lock.withLock { _reservedBytes = newValue; available.removeAll() } }
+  }
+
+  /// Maximum size of a batch in bytes (0 = unlimited)
+  ///
+  /// Operations past the limit are rejected, so a runaway batch cannot
+  /// blow up memtable usage; the write of such a batch throws.
+  public var maxBatchBytes: Int {
+    get { lock.withLock { _maxBatchBytes } }
+    set { lock.withLock { _maxBatchBytes = newValue; available.removeAll() } }
+  }
+
+  /// Number of idle batches in the pool
+  public var count: Int {
+    lock.withLock { available.count }
+  }
+
+  /// Take an empty batch from the pool, creating one if none is idle
+  public func acquire() -> RocksDBBatch {
+    lock.withLock {
+      if let batch = available.popLast() {
+        return batch
+      }
+      return RocksDBBatch(reservedBytes: _reservedBytes, maxBytes: _maxBatchBytes)
+    }
+  }
+
+  /// Clear a batch and return it to the pool
+  /// - Parameter batch: Batch obtained from `acquire()`; must not be used afterwards
+  public func release(_ batch: RocksDBBatch) {
+    guard batch.dataSize <= maxRetainedBytes else { return }
+    batch.clear()
+
+    lock.withLock {
+      guard available.count < maxPooledBatches,
+            batch.reservedBytes == _reservedBytes,
+            batch.maxBytes == _maxBatchBytes else { return }
+      available.append(batch)
+    }
+  }
+
+  /// Run a closure with a pooled batch, returning it to the pool afterwards
+  /// - Parameter body: Closure receiving the batch
+  /// - Returns: Result of the closure
+  public func withBatch<R>(_ body: (RocksDBBatch) throws -> R) rethrows -> R {
+    let batch = acquire()
+    defer { release(batch) }
+    return try body(batch)
+  }
+}
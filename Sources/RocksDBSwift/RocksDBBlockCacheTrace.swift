@@ -0,0 +1,327 @@
+//
+//  RocksDBBlockCacheTrace.swift
+//  RocksDB.swift
+//
+//  Block cache access traces and an offline cache simulator for sizing
+//
+
+import Foundation
+import CRocksDB
+
+/// Kind of block touched by a traced access
+public enum RocksDBBlockType: UInt8, Sendable {
+  case index = 7
+  case filter = 8
+  case data = 9
+  case uncompressionDict = 10
+  case rangeDeletion = 11
+}
+
+/// One sampled block cache lookup
+public struct RocksDBBlockCacheAccess: Sendable, Equatable {
+  /// Time of the access in microseconds
+  public var timestamp: UInt64
+
+  /// Hash identifying the block in the cache
+  public var blockKey: UInt64
+
+  /// Bytes the block charges to the cache
+  public var blockSize: UInt64
+
+  /// Shared by the accesses of one Get or MultiGet
+  public var getID: UInt64
+
+  public var columnFamilyID: UInt32
+  public var level: UInt32
+  public var blockType: RocksDBBlockType?
+
+  /// RocksDB `TableReaderCaller` that triggered the access
+  public var caller: UInt8
+
+  /// Whether the live cache had the block
+  public var isCacheHit: Bool
+
+  /// A miss does not insert the block into the cache
+  public var noInsert: Bool
+}
+
+/// Block cache trace recorded with `RocksDB.startBlockCacheTrace(to:samplingFrequency:maxTraceSize:)`
+public struct RocksDBBlockCacheTrace: Sendable {
+  /// Accesses in the order they were recorded
+  public let accesses: [RocksDBBlockCacheAccess]
+
+  public init(accesses: [RocksDBBlockCacheAccess]) {
+    self.accesses = accesses
+  }
+
+  /// Load a trace file
+  /// - Parameter path: Trace file path
+  /// - Throws: RocksDBError.corruption if the file is not a block cache trace
+  public init(contentsOf path: String) throws {
+    let data: Data
+    do {
+      data = try Data(contentsOf: URL(fileURLWithPath: path))
+    } catch {
+      throw RocksDBError.ioError("Cannot read block cache trace: \(error.localizedDescription)")
+    }
+
+    let headerSize = Int(ROCKSDB_BLOCK_CACHE_TRACE_HEADER_SIZE)
+    let recordSize = MemoryLayout<RocksDBBlockCacheAccessRecord>.size
+    let magic = Array("RDBBCT".utf8) + [0, 1]
+    guard data.count >= headerSize, Array(data.prefix(8)) == magic else {
+      throw RocksDBError.corruption("Not a block cache trace: \(path)")
+    }
+
+    accesses = try data.withUnsafeBytes { raw -> [RocksDBBlockCacheAccess] in
+      let storedSize = UInt32(littleEndian: raw.loadUnaligned(fromByteOffset: 8, as: UInt32.self))
+      guard storedSize == recordSize else {
+        throw RocksDBError.corruption("Unexpected block cache trace record size \(storedSize)")
+      }
+
+      let count = (raw.count - headerSize) / recordSize
+      var result: [RocksDBBlockCacheAccess] = []
+      result.reserveCapacity(count)
+      for i in 0..<count {
+        let record = raw.loadUnaligned(fromByteOffset: headerSize + i * recordSize,
+                                       as: RocksDBBlockCacheAccessRecord.self)
+        result.append(RocksDBBlockCacheAccess(
+          timestamp: record.timestamp_us,
+          blockKey: record.block_key_hash,
+          blockSize: record.block_size,
+          getID: record.get_id,
+          columnFamilyID: record.cf_id,
+          level: record.level,
+          blockType: RocksDBBlockType(rawValue: record.block_type),
+          caller: record.caller,
+          isCacheHit: record.is_cache_hit != 0,
+          noInsert: record.no_insert != 0))
+      }
+      return result
+    }
+  }
+
+  /// Hit rate the traced cache actually achieved
+  public var observedHitRate: Double {
+    guard !accesses.isEmpty else { return 0 }
+    return Double(accesses.filter(\.isCacheHit).count) / Double(accesses.count)
+  }
+
+  /// Distinct bytes touched, an upper bound on useful cache size
+  public var workingSetBytes: UInt64 {
+    var sizes: [UInt64: UInt64] = [:]
+    for access in accesses {
+      sizes[access.blockKey] = access.blockSize
+    }
+    return sizes.values.reduce(0, +)
+  }
+
+  // MARK: - Simulation
+
+  /// Replay the trace against a cache of `capacity` bytes
+  ///
+  /// The simulated cache starts empty. Scale capacities by the sampling
+  /// frequency the trace was recorded with: a trace of one in N accesses
+  /// sees roughly one in N blocks.
+  /// - Parameters:
+  ///   - policy: Eviction policy to simulate
+  ///   - capacity: Cache capacity in bytes
+  /// - Returns: Lookup and hit counts of the replay
+  public func simulate(policy: RocksDBCachePolicy, capacity: Int) -> RocksDBCacheSimulationResult {
+    var result = RocksDBCacheSimulationResult(policy: policy, capacity: capacity)
+    let bytes = UInt64(max(capacity, 0))
+    switch policy {
+    case .lru:
+      var cache = LRUSimulation(capacity: bytes)
+      replay(into: &cache, result: &result)
+    case .hyperClock:
+      var cache = ClockSimulation(capacity: bytes)
+      replay(into: &cache, result: &result)
+    }
+    return result
+  }
+
+  private func replay<Cache: SimulatedCache>(into cache: inout Cache, result: inout RocksDBCacheSimulationResult) {
+    for access in accesses {
+      result.lookups += 1
+      if cache.lookup(access.blockKey) {
+        result.hits += 1
+      } else if !access.noInsert {
+        cache.insert(access.blockKey, charge: access.blockSize, type: access.blockType)
+        result.insertedBytes += access.blockSize
+      }
+    }
+  }
+
+  /// Hit rates over several capacities and policies
+  /// - Parameters:
+  ///   - capacities: Cache capacities in bytes
+  ///   - policies: Eviction policies to compare
+  /// - Returns: One result per policy and capacity, grouped by policy
+  public func hitRateCurve(
+    capacities: [Int],
+    policies: [RocksDBCachePolicy] = RocksDBCachePolicy.allCases
+  ) -> [RocksDBCacheSimulationResult] {
+    policies.flatMap { policy in
+      capacities.map { simulate(policy: policy, capacity: $0) }
+    }
+  }
+}
+
+/// Eviction policies the simulator models
+public enum RocksDBCachePolicy: String, CaseIterable, Sendable {
+  /// Strict least-recently-used, as `RocksDBCache.lru` without a high-priority pool
+  case lru
+  /// CLOCK with per-entry countdowns, approximating `RocksDBCache.hyperClock`:
+  /// index and filter blocks start with a higher countdown than data blocks
+  case hyperClock
+}
+
+/// Outcome of replaying a trace against one simulated cache
+public struct RocksDBCacheSimulationResult: Sendable, Equatable {
+  public var policy: RocksDBCachePolicy
+  public var capacity: Int
+  public var lookups: Int = 0
+  public var hits: Int = 0
+
+  /// Bytes inserted after misses, i.e. blocks that would have been read
+  public var insertedBytes: UInt64 = 0
+
+  public var hitRate: Double {
+    lookups == 0 ? 0 : Double(hits) / Double(lookups)
+  }
+}
+
+// MARK: - Internal Helpers
+
+private protocol SimulatedCache {
+  mutating func lookup(_ key: UInt64) -> Bool
+  mutating func insert(_ key: UInt64, charge: UInt64, type: RocksDBBlockType?)
+}
+
+/// LRU list threaded through arrays, indexed by slot
+private struct LRUSimulation: SimulatedCache {
+  private let capacity: UInt64
+  private var usage: UInt64 = 0
+  private var slots: [UInt64: Int] = [:]
+  private var keys: [UInt64] = []
+  private var charges: [UInt64] = []
+  private var prev: [Int] = []
+  private var next: [Int] = []
+  private var free: [Int] = []
+  // Most and least recently used slots, -1 when empty
+  private var head = -1
+  private var tail = -1
+
+  init(capacity: UInt64) {
+    self.capacity = capacity
+  }
+
+  mutating func lookup(_ key: UInt64) -> Bool {
+    guard let slot = slots[key] else { return false }
+    unlink(slot)
+    pushFront(slot)
+    return true
+  }
+
+  mutating func insert(_ key: UInt64, charge: UInt64, type: RocksDBBlockType?) {
+    guard charge <= capacity else { return }
+    while usage + charge > capacity, tail >= 0 {
+      let victim = tail
+      unlink(victim)
+      slots[keys[victim]] = nil
+      usage -= charges[victim]
+      free.append(victim)
+    }
+
+    let slot: Int
+    if let reused = free.popLast() {
+      slot = reused
+      keys[slot] = key
+      charges[slot] = charge
+    } else {
+      slot = keys.count
+      keys.append(key)
+      charges.append(charge)
+      prev.append(-1)
+      next.append(-1)
+    }
+    slots[key] = slot
+    usage += charge
+    pushFront(slot)
+  }
+
+  private mutating func unlink(_ slot: Int) {
+    if prev[slot] >= 0 { next[prev[slot]] = next[slot] } else { head = next[slot] }
+    if next[slot] >= 0 { prev[next[slot]] = prev[slot] } else { tail = prev[slot] }
+    prev[slot] = -1
+    next[slot] = -1
+  }
+
+  private mutating func pushFront(_ slot: Int) {
+    next[slot] = head
+    prev[slot] = -1
+    if head >= 0 { prev[head] = slot }
+    head = slot
+    if tail < 0 { tail = slot }
+  }
+}
+
+/// CLOCK ring; a hit raises the entry's countdown, the sweeping hand lowers
+/// it and evicts entries that reached zero
+private struct ClockSimulation: SimulatedCache {
+  private static let maxCountdown: UInt8 = 3
+
+  private let capacity: UInt64
+  private var usage: UInt64 = 0
+  private var slots: [UInt64: Int] = [:]
+  private var keys: [UInt64?] = []
+  private var charges: [UInt64] = []
+  private var countdowns: [UInt8] = []
+  private var free: [Int] = []
+  private var hand = 0
+
+  init(capacity: UInt64) {
+    self.capacity = capacity
+  }
+
+  mutating func lookup(_ key: UInt64) -> Bool {
+    guard let slot = slots[key] else { return false }
+    countdowns[slot] = min(countdowns[slot] + 1, Self.maxCountdown)
+    return true
+  }
+
+  mutating func insert(_ key: UInt64, charge: UInt64, type: RocksDBBlockType?) {
+    guard charge <= capacity else { return }
+    while usage + charge > capacity, !slots.isEmpty {
+      if hand >= keys.count { hand = 0 }
+      if let victim = keys[hand] {
+        if countdowns[hand] == 0 {
+          slots[victim] = nil
+          keys[hand] = nil
+          usage -= charges[hand]
+          free.append(hand)
+        } else {
+          countdowns[hand] -= 1
+        }
+      }
+      hand += 1
+    }
+
+    // Metadata blocks are inserted at high priority, data blocks at low
+    let countdown: UInt8 = (type == .index || type == .filter) ? 3 : 2
+    let slot: Int
+    if let reused = free.popLast() {
+      slot = reused
+      keys[slot] = key
+      charges[slot] = charge
+      countdowns[slot] = countdown
+    } else {
+      slot = keys.count
+      keys.append(key)
+      charges.append(charge)
+      countdowns.append(countdown)
+    }
+    slots[key] = slot
+    usage += charge
+  }
+}
@@ -0,0 +1,247 @@
+//
+//  RocksDBBulkLoader.swift
+//  RocksDB.swift
+//
+//  Parallel SST builder for bulk loads
+//
+
+import Foundation
+import CRocksDB
+
+/// Bulk load progress snapshot
+public struct RocksDBBulkLoadProgress: Sendable {
+  /// Partitions whose SST file is finished
+  public let partitionsCompleted: Int
+
+  /// Total number of partitions
+  public let totalPartitions: Int
+
+  /// Entries written so far
+  public let entriesWritten: UInt64
+
+  /// Key and value bytes written so far
+  public let bytesWritten: UInt64
+
+  /// Time since the load started, in seconds
+  public let elapsed: TimeInterval
+
+  /// Input throughput in bytes per second
+  public var bytesPerSecond: Double {
+    elapsed > 0 ? Double(bytesWritten) / elapsed : 0
+  }
+}
+
+/// Bulk load result
+public struct RocksDBBulkLoadResult: Sendable {
+  /// Ingested SST files (empty partitions produce no file)
+  public let files: [RocksDBExternalFileInfo]
+
+  /// Total entries ingested
+  public let entriesWritten: UInt64
+
+  /// Total key and value bytes ingested
+  public let bytesWritten: UInt64
+
+  /// Time spent building SST files, in seconds
+  public let buildTime: TimeInterval
+
+  /// Time spent in `IngestExternalFile`, in seconds
+  public let ingestTime: TimeInterval
+
+  /// Build throughput in bytes per second
+  public var bytesPerSecond: Double {
+    buildTime > 0 ? Double(bytesWritten) / buildTime : 0
+  }
+}
+
+/// Builds one SST file per partition on a pool of worker threads, then
+/// ingests all of them in a single atomic `IngestExternalFile` call
+///
+/// Each partition must be sorted by key, and partitions must not overlap.
+/// SST building is CPU bound (mostly compression), so throughput scales
+/// with `maxConcurrency` up to the number of cores.
+public final class RocksDBBulkLoader: @unchecked Sendable {
+  /// Target database
+  public let database: RocksDB
+
+  /// Options used to build the SST files; should match the database
+  /// (comparator, compression, table options)
+  public let options: RocksDBOptions
+
+  /// Directory for intermediate SST files
+  public let directory: String
+
+  /// Maximum number of partitions built in parallel
+  public let maxConcurrency: Int
+
+  /// Create a bulk loader
+  /// - Parameters:
+  ///   - database: Target database
+  ///   - options: Options used to build the SST files
+  ///   - directory: Directory for intermediate SST files (default: next to the database)
+  ///   - maxConcurrency: Worker thread count (default: active processor count)
+  public init(
+    database: RocksDB,
+    options: RocksDBOptions = .default,
+    directory: String? = nil,
+    maxConcurrency: Int = ProcessInfo.processInfo.activeProcessorCount
+  ) {
+    self.database = database
+    self.options = options
+    self.directory = directory ?? (database.path + ".bulk-load")
+    self.maxConcurrency = max(1, maxConcurrency)
+  }
+
+  /// Default ingest options for bulk loads: move the built files instead of copying
+  public static var defaultIngestOptions: RocksDBIngestOptions {
+    var opts = RocksDBIngestOptions()
+    opts.moveFiles = true
+    return opts
+  }
+
+  /// Build and ingest the given partitions
+  /// - Parameters:
+  ///   - partitions: Sorted, non-overlapping key-value streams
+  ///   - ingestOptions: Options for the final ingestion
+  ///   - progress: Called after each partition is finished (serialized, on a worker thread)
+  /// - Returns: Load result
+  /// - Throws: RocksDBError on failure; nothing is ingested if any partition fails
+  @discardableResult
+  public func load<S: Sequence>(
+    _ partitions: [S],
+    ingestOptions: RocksDBIngestOptions = RocksDBBulkLoader.defaultIngestOptions,
+    progress: ((RocksDBBulkLoadProgress) -> Void)? = nil
+  ) throws -> RocksDBBulkLoadResult where S.Element == (key: Data, value: Data) {
+    let runDirectory = (directory as NSString).appendingPathComponent(UUID().uuidString)
+    try FileManager.default.createDirectory(atPath: runDirectory, withIntermediateDirectories: true)
+    defer { try? FileManager.default.removeItem(atPath: runDirectory) }
+
+    let state = LoadState(totalPartitions: partitions.count)
+    let start = Date()
+
+    DispatchQueue.concurrentPerform(iterations: min(maxConcurrency, partitions.count)) { _ in
+      while let index = state.nextPartition() {
+        let path = (runDirectory as NSString).appendingPathComponent(String(format: "%06d.sst", index))
+        do {
+          let built = try buildPartition(partitions[index], at: path, state: state)
+          let snapshot = state.complete(index, file: built, elapsed: Date().timeIntervalSince(start))
+          if let progress = progress {
+            state.reportLock.withLock { progress(snapshot) }
+          }
+        } catch {
+          state.fail(error)
+        }
+      }
+    }
+
+    let buildTime = Date().timeIntervalSince(start)
+    if let error = state.error {
+      throw error
+    }
+
+    let files = state.files.compactMap { $0 }
+    let ingestStart = Date()
+    if !files.isEmpty {
+      try database.ingestExternalFiles(files.map(\.path), options: ingestOptions)
+    }
+
+    return RocksDBBulkLoadResult(
+      files: files,
+      entriesWritten: state.entriesWritten,
+      bytesWritten: state.bytesWritten,
+      buildTime: buildTime,
+      ingestTime: Date().timeIntervalSince(ingestStart)
+    )
+  }
+
+  // MARK: - Private
+
+  private func buildPartition<S: Sequence>(
+    _ partition: S,
+    at path: String,
+    state: LoadState
+  ) throws -> RocksDBExternalFileInfo? where S.Element == (key: Data, value: Data) {
+    let writer = try RocksDBSstFileWriter.open(at: path, options: options)
+    var entries: UInt64 = 0
+    var bytes: UInt64 = 0
+
+    for (key, value) in partition {
+      // Poll for failures once per chunk rather than locking for every entry
+      if entries % LoadState.cancellationCheckInterval == 0, state.isFailed {
+        throw RocksDBError.aborted("Bulk load cancelled")
+      }
+      try writer.put(value, forKey: key)
+      entries += 1
+      bytes += UInt64(key.count + value.count)
+    }
+
+    state.add(entries: entries, bytes: bytes)
+
+    // SstFileWriter cannot finish an empty file
+    guard entries > 0 else { return nil }
+    return try writer.finish()
+  }
+
+  /// Shared state of one `load` call
+  private final class LoadState: @unchecked Sendable {
+    /// Entries a worker writes between checks for another worker's failure
+    static let cancellationCheckInterval: UInt64 = 4096
+
+    private let lock = NSLock()
+    let reportLock = NSLock()
+
+    private let totalPartitions: Int
+    private var next = 0
+    private var completed = 0
+    private(set) var files: [RocksDBExternalFileInfo?]
+    private(set) var entriesWritten: UInt64 = 0
+    private(set) var bytesWritten: UInt64 = 0
+    private(set) var error: Error?
+
+    init(totalPartitions: Int) {
+      self.totalPartitions = totalPartitions
+      self.files = Array(repeating: nil, count: totalPartitions)
+    }
+
+    var isFailed: Bool {
+      lock.withLock { error != nil }
+    }
+
+    func nextPartition() -> Int? {
+      lock.withLock {
+        guard error == nil, next < totalPartitions else { return nil }
+        defer { next += 1 }
+        return next
+      }
+    }
+
+    func add(entries: UInt64, bytes: UInt64) {
+      lock.withLock {
+        entriesWritten += entries
+        bytesWritten += bytes
+      }
+    }
+
+    func complete(_ index: Int, file: RocksDBExternalFileInfo?, elapsed: TimeInterval) -> RocksDBBulkLoadProgress {
+      lock.withLock {
+        files[index] = file
+        completed += 1
+        return RocksDBBulkLoadProgress(
+          partitionsCompleted: completed,
+          totalPartitions: totalPartitions,
+          entriesWritten: entriesWritten,
+          bytesWritten: bytesWritten,
+          elapsed: elapsed
+        )
+      }
+    }
+
+    func fail(_ error: Error) {
+      lock.withLock {
+        if self.error == nil {
+          self.error = error
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,215 @@
+//
+//  RocksDBCache.swift
+//  RocksDB.swift
+//
+//  Shared block cache for RocksDB databases
+//
+
+import Foundation
+import CRocksDB
+
+/// Block cache that can be shared by multiple databases
+///
+/// Assign the same cache to `RocksDBTableOptions.blockCache` of several
+/// databases to cap their combined block cache memory. Each database keeps
+/// the native cache alive for as long as it is open.
+public final class RocksDBCache: @unchecked Sendable {
+  internal let handle: RocksDBCacheRef
+
+  private init(handle: RocksDBCacheRef) {
+    self.handle = handle
+  }
+
+  deinit {
+    rocksdb_cache_destroy(handle)
+  }
+
+  // MARK: - Factory Methods
+
+  /// Create an LRU cache
+  /// - Parameters:
+  ///   - capacity: Capacity in bytes
+  ///   - numShardBits: Cache is sharded into 2^numShardBits shards (-1 for automatic)
+  ///   - strictCapacityLimit: Fail inserts instead of exceeding capacity
+  ///   - highPriorityPoolRatio: Fraction reserved for high-priority (index/filter) blocks
+  /// - Returns: New cache
+  public static func lru(
+    capacity: Int,
+    numShardBits: Int = -1,
+    strictCapacityLimit: Bool = false,
+    highPriorityPoolRatio: Double = 0.5
+  ) -> RocksDBCache {
+    let handle = rocksdb_cache_create_lru(capacity, Int32(numShardBits),
+                                          strictCapacityLimit ? 1 : 0,
+                                          highPriorityPoolRatio)!
+    return RocksDBCache(handle: handle)
+  }
+
+  /// Create an LRU cache with a compressed secondary cache behind it
+  ///
+  /// Blocks evicted from the LRU are kept compressed in the secondary cache.
+  /// It is also where `loadDump(from:)` puts blocks saved by
+  /// `RocksDB.dumpBlockCache(to:maxSize:)`, so use this cache to warm the
+  /// block cache after a restart.
+  /// - Parameters:
+  ///   - capacity: Capacity of the LRU in bytes
+  ///   - secondaryCapacity: Capacity of the compressed secondary cache in bytes
+  ///   - secondaryCompression: Compression of the secondary cache
+  ///   - numShardBits: Cache is sharded into 2^numShardBits shards (-1 for automatic)
+  ///   - strictCapacityLimit: Fail inserts instead of exceeding capacity
+  ///   - highPriorityPoolRatio: Fraction reserved for high-priority (index/filter) blocks
+  /// - Returns: New cache
+  public static func lru(
+    capacity: Int,
+    secondaryCapacity: Int,
+    secondaryCompression: RocksDBCompression = .lz4,
+    numShardBits: Int = -1,
+    strictCapacityLimit: Bool = false,
+    highPriorityPoolRatio: Double = 0.5
+  ) -> RocksDBCache {
+    let handle = rocksdb_cache_create_lru_with_secondary(capacity, Int32(numShardBits),
+                                                         strictCapacityLimit ? 1 : 0,
+                                                         highPriorityPoolRatio, secondaryCapacity,
+                                                         secondaryCompression.rawValue)!
+    return RocksDBCache(handle: handle)
+  }
+
+  /// Create a HyperClockCache, a lock-free cache that scales better than LRU
+  /// under highly concurrent reads
+  /// - Parameters:
+  ///   - capacity: Capacity in bytes
+  ///   - estimatedEntryCharge: Expected block size in bytes (0 for automatic sizing)
+  ///   - numShardBits: Cache is sharded into 2^numShardBits shards (-1 for automatic)
+  ///   - strictCapacityLimit: Fail inserts instead of exceeding capacity
+  /// - Returns: New cache
+  public static func hyperClock(
+    capacity: Int,
+    estimatedEntryCharge: Int = 0,
+    numShardBits: Int = -1,
+    strictCapacityLimit: Bool = false
+  ) -> RocksDBCache {
+    let handle = rocksdb_cache_create_hyper_clock(capacity, estimatedEntryCharge,
+                                                  Int32(numShardBits),
+                                                  strictCapacityLimit ? 1 : 0)!
+    return RocksDBCache(handle: handle)
+  }
+
+  /// Create a two-tier cache: an uncompressed primary cache in front of a
+  /// compressed in-memory secondary cache
+  ///
+  /// Blocks evicted from the primary tier are kept compressed in the
+  /// secondary one and decompressed back on a hit, so the same memory holds
+  /// two to three times more of the working set at the cost of CPU on
+  /// secondary hits. Track the tiers with `RocksDBTicker.blockCacheHit`
+  /// (primary) and `.compressedSecondaryCacheHits` (secondary).
+  /// - Parameters:
+  ///   - totalCapacity: Memory budget in bytes shared by both tiers
+  ///   - compressedSecondaryRatio: Fraction of the budget given to the compressed tier
+  ///   - primary: Primary cache implementation
+  ///   - admissionPolicy: Which blocks evicted from the primary tier are compressed
+  ///   - compression: Compression of the secondary tier
+  ///   - numShardBits: Cache is sharded into 2^numShardBits shards (-1 for automatic)
+  /// - Returns: New cache
+  /// - Throws: RocksDBError.invalidArgument if RocksDB rejects the configuration
+  public static func tiered(
+    totalCapacity: Int,
+    compressedSecondaryRatio: Double = 0.3,
+    primary: TieredPrimary = .lru(highPriorityPoolRatio: 0.5),
+    admissionPolicy: TieredAdmissionPolicy = .auto,
+    compression: RocksDBCompression = .lz4,
+    numShardBits: Int = -1
+  ) throws -> RocksDBCache {
+    let primaryType: Int32
+    let entryCharge: Int
+    let highPriorityPoolRatio: Double
+    switch primary {
+    case .lru(let ratio):
+      (primaryType, entryCharge, highPriorityPoolRatio) = (0, 0, ratio)
+    case .hyperClock(let estimatedEntryCharge):
+      (primaryType, entryCharge, highPriorityPoolRatio) = (1, estimatedEntryCharge, 0)
+    }
+    guard let handle = rocksdb_cache_create_tiered(
+      totalCapacity, compressedSecondaryRatio, primaryType, entryCharge, Int32(numShardBits),
+      highPriorityPoolRatio, admissionPolicy.rawValue, compression.rawValue) else {
+      throw RocksDBError.invalidArgument("Invalid tiered cache configuration")
+    }
+    return RocksDBCache(handle: handle)
+  }
+
+  /// Resize or rebalance a cache created by `tiered`; nil keeps a setting
+  /// - Throws: RocksDBError if this is not a tiered cache or the values are invalid
+  public func updateTiers(
+    totalCapacity: Int? = nil,
+    compressedSecondaryRatio: Double? = nil,
+    admissionPolicy: TieredAdmissionPolicy? = nil
+  ) throws {
+    try RocksDBError.check(rocksdb_cache_update_tiered(
+      handle, Int64(totalCapacity ?? -1), compressedSecondaryRatio ?? -1,
+      admissionPolicy?.rawValue ?? -1))
+  }
+
+  // MARK: - Warm Restarts
+
+  /// Load a block cache dump into the secondary cache
+  ///
+  /// Call after opening the databases that use this cache and before serving
+  /// traffic. The first read of each loaded block promotes it to the
+  /// primary tier instead of reading the SST file:
+  ///
+  ///     try db.dumpBlockCache(to: dumpPath)   // before close
+  ///     db.close()
+  ///     ...
+  ///     let cache = RocksDBCache.lru(capacity: size, secondaryCapacity: size / 2)
+  ///     let db = try RocksDB.open(at: path, options: options)  // uses cache
+  ///     try cache.loadDump(from: dumpPath)
+  ///
+  /// - Parameter path: Dump file written by `RocksDB.dumpBlockCache(to:maxSize:)`
+  /// - Throws: RocksDBError.notSupported if the cache has no secondary
+  ///   cache, or RocksDBError if the dump cannot be read
+  public func loadDump(from path: String) throws {
+    try RocksDBError.check(rocksdb_cache_load_dump(handle, path))
+  }
+
+  // MARK: - Properties
+
+  /// Capacity in bytes; may be changed at runtime
+  public var capacity: Int {
+    get { rocksdb_cache_get_capacity(handle) }
+    set { rocksdb_cache_set_capacity(handle, newValue) }
+  }
+
+  /// Memory currently used by entries in the cache, in bytes
+  public var usage: Int {
+    rocksdb_cache_get_usage(handle)
+  }
+
+  /// Memory used by entries currently pinned (in use) in the cache, in bytes
+  public var pinnedUsage: Int {
+    rocksdb_cache_get_pinned_usage(handle)
+  }
+}
+
+// MARK: - Tiered Cache Types
+
+extension RocksDBCache {
+  /// Primary tier of a tiered cache
+  public enum TieredPrimary: Sendable {
+    /// LRU cache reserving a fraction for high-priority (index/filter) blocks
+    case lru(highPriorityPoolRatio: Double)
+    /// HyperClockCache; pass the expected block size, or 0 for automatic sizing
+    case hyperClock(estimatedEntryCharge: Int)
+  }
+
+  /// Which blocks move between the tiers
+  public enum TieredAdmissionPolicy: Int32, Sendable {
+    /// Let RocksDB pick (default: placeholder)
+    case auto = 0
+    /// Compress an evicted block the second time it is evicted, so one-off
+    /// reads don't churn the secondary tier
+    case placeholder = 1
+    /// As `placeholder`, but blocks hit in the primary tier are always admitted
+    case allowCacheHits = 2
+    /// Compress every evicted block
+    case allowAll = 4
+  }
+}
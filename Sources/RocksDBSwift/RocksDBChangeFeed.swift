@@ -0,0 +1,152 @@
+//
+//  RocksDBChangeFeed.swift
+//  RocksDB.swift
+//
+//  Change data capture by tailing the write-ahead log
+//
+
+import Foundation
+import CRocksDB
+
+/// One operation of a write batch read back from the WAL
+public struct RocksDBWriteRecord: Sendable, Equatable {
+  /// Kind of operation
+  public enum Kind: Sendable, Equatable {
+    case put
+    case delete
+    case singleDelete
+    /// `key` is the range start and `value` the exclusive end
+    case deleteRange
+    case merge
+    /// `value` is the serialized wide-column entity
+    case putEntity
+    /// `value` is a log-only blob written with the batch; the key is empty
+    case logData
+    /// `value` is a BlobDB blob index, not the value itself
+    case putBlobIndex
+  }
+
+  public var kind: Kind
+  /// Column family id (see `RocksDBColumnFamily.id`; 0 is the default family)
+  public var columnFamilyID: UInt32
+  public var key: Data
+  public var value: Data
+}
+
+/// Write batch read back from the WAL with the sequence number of its first operation
+public struct RocksDBChangeBatch: Sendable {
+  /// Sequence number of the first operation; later operations follow on
+  public var sequence: UInt64
+  /// Number of sequence numbers the batch uses
+  public var count: Int
+  /// Serialized `WriteBatch`, for forwarding as is
+  public var data: Data
+  /// Decoded operations in batch order
+  public var records: [RocksDBWriteRecord]
+
+  /// Sequence number to resume from after this batch
+  public var nextSequence: UInt64 {
+    sequence + UInt64(count)
+  }
+}
+
+/// Iterator over the write batches in the WAL, from `RocksDB.updates(since:)`
+///
+/// Stops at the end of the WAL written so far; to tail it, call
+/// `RocksDB.updates(since:)` again with `nextSequence` of the last batch.
+/// WAL files the database no longer needs are only kept for this if
+/// `walTTLSeconds` or `walSizeLimitMB` is set. A follower that falls
+/// behind the retained WAL gets an error and has to re-sync from a
+/// checkpoint or backup.
+public final class RocksDBChangeIterator: @unchecked Sendable {
+  private var handle: RocksDBWalIteratorRef?
+  private let lock = NSLock()
+
+  internal init(handle: RocksDBWalIteratorRef) {
+    self.handle = handle
+  }
+
+  deinit {
+    close()
+  }
+
+  /// Close the iterator
+  public func close() {
+    lock.withLock {
+      if let h = handle {
+        rocksdb_wal_iterator_destroy(h)
+        handle = nil
+      }
+    }
+  }
+
+  /// Read the next batch
+  /// - Returns: Next batch, or nil at the end of the WAL written so far
+  /// - Throws: RocksDBError if the WAL cannot be read, e.g. after a gap in
+  ///   the retained files
+  public func next() throws -> RocksDBChangeBatch? {
+    try lock.withLock {
+      guard let h = handle else { return nil }
+      guard rocksdb_wal_iterator_valid(h) != 0 else {
+        try RocksDBError.check(rocksdb_wal_iterator_status(h))
+        return nil
+      }
+
+      var sequence: UInt64 = 0
+      var count = 0
+      var length = 0
+      guard let ptr = rocksdb_wal_iterator_batch(h, &sequence, &count, &length) else {
+        return nil
+      }
+      let data = Data(bytes: ptr, count: length)
+
+      var records: UnsafePointer<CChar>?
+      var recordsLength = 0
+      var recordCount = 0
+      try RocksDBError.check(rocksdb_wal_iterator_decode(h, &records, &recordsLength, &recordCount))
+      let decoded = Self.unpack(UnsafeRawPointer(records), count: recordCount)
+
+      rocksdb_wal_iterator_next(h)
+      return RocksDBChangeBatch(sequence: sequence, count: count, data: data, records: decoded)
+    }
+  }
+
+  /// Unpack `[type][cf][key_len][value_len][key][value]` records
+  private static func unpack(_ base: UnsafeRawPointer?, count: Int) -> [RocksDBWriteRecord] {
+    guard let base, count > 0 else { return [] }
+
+    var records: [RocksDBWriteRecord] = []
+    records.reserveCapacity(count)
+    var offset = 0
+    for _ in 0..<count {
+      let type = base.load(fromByteOffset: offset, as: UInt8.self)
+      let cf = base.loadUnaligned(fromByteOffset: offset + 1, as: UInt32.self)
+      let keyLen = Int(base.loadUnaligned(fromByteOffset: offset + 5, as: UInt32.self))
+      let valueLen = Int(base.loadUnaligned(fromByteOffset: offset + 9, as: UInt32.self))
+      offset += 13
+      let key = Data(bytes: base + offset, count: keyLen)
+      offset += keyLen
+      let value = Data(bytes: base + offset, count: valueLen)
+      offset += valueLen
+      records.append(RocksDBWriteRecord(kind: Kind(type), columnFamilyID: cf, key: key, value: value))
+    }
+    return records
+  }
+
+  private typealias Kind = RocksDBWriteRecord.Kind
+}
+
+extension RocksDBWriteRecord.Kind {
+  fileprivate init(_ type: UInt8) {
+    switch RocksDBWalRecordType(rawValue: UInt32(type)) {
+    case RocksDBWalRecordDelete: self = .delete
+    case RocksDBWalRecordSingleDelete: self = .singleDelete
+    case RocksDBWalRecordDeleteRange: self = .deleteRange
+    case RocksDBWalRecordMerge: self = .merge
+    case RocksDBWalRecordPutEntity: self = .putEntity
+    case RocksDBWalRecordLogData: self = .logData
+    case RocksDBWalRecordPutBlobIndex: self = .putBlobIndex
+    default: self = .put
+    }
+  }
+}
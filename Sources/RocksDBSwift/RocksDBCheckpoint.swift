@@ -0,0 +1,43 @@
+//
+//  RocksDBCheckpoint.swift
+//  RocksDB.swift
+//
+//  Column family exports produced alongside checkpoints
+//
+
+import Foundation
+import CRocksDB
+
+/// Live SST files of one column family, exported to a directory
+///
+/// Created by `RocksDB.exportColumnFamily(_:to:)`. Pass it to
+/// `RocksDB.importColumnFamily(named:from:options:moveFiles:)` of the same
+/// or another database to recreate the family from the exported files.
+/// The directory stays in place after the export is released.
+public final class RocksDBColumnFamilyExport: @unchecked Sendable {
+  internal let handle: RocksDBExportMetadataRef
+
+  /// Directory holding the exported files
+  public let directory: String
+
+  internal init(handle: RocksDBExportMetadataRef, directory: String) {
+    self.handle = handle
+    self.directory = directory
+  }
+
+  deinit {
+    rocksdb_export_metadata_destroy(handle)
+  }
+
+  /// Number of exported SST files
+  public var fileCount: Int {
+    rocksdb_export_metadata_file_count(handle)
+  }
+
+  /// Comparator the files were written with; the importing family must use the same one
+  public var comparatorName: String {
+    guard let name = rocksdb_export_metadata_comparator(handle) else { return "" }
+    defer { rocksdb_free_string(name) }
+    return String(cString: name)
+  }
+}
@@ -0,0 +1,305 @@
+//
+//  RocksDBColumnFamily.swift
+//  RocksDB.swift
+//
+//  Column families for RocksDB
+//
+
+import Foundation
+import CRocksDB
+
+/// Column family of an open database
+///
+/// Families share the database's WAL, background threads and file handles
+/// while having their own memtables, SST files and options. Pass a family
+/// to the `in:` parameter of database, batch and transaction operations;
+/// a nil family addresses the default family.
+public final class RocksDBColumnFamily: @unchecked Sendable {
+  /// The column family every database has
+  public static let defaultName = "default"
+
+  /// Owned by the native database and valid until it is closed
+  internal let handle: RocksDBColumnFamilyRef
+
+  /// Column family name
+  public let name: String
+
+  /// Id the family's records carry in the WAL (see `RocksDBWriteRecord`)
+  public let id: UInt32
+
+  internal weak var database: RocksDB?
+
+  internal init(handle: RocksDBColumnFamilyRef, name: String, database: RocksDB) {
+    self.handle = handle
+    self.name = name
+    self.id = rocksdb_column_family_id(handle)
+    self.database = database
+  }
+}
+
+/// Column families a batch has been given, checked as operations are added
+///
+/// Batches are built without a database, so the first family fixes the
+/// database the batch may be written to and every later family must
+/// belong to it. A family that cannot be used drops its operation and is
+/// remembered, so `validate()` and `RocksDB.writeBatch` throw instead of
+/// writing a partial batch.
+internal struct BatchFamilies {
+  private weak var database: RocksDB?
+  private var isBound = false
+
+  /// First family that could not be used since creation or the last reset
+  private(set) var error: RocksDBError?
+
+  /// Call `body` with the native handle of `family` (nil for the default
+  /// family) while its database is held open; skipped if it can't be used
+  mutating func with(_ family: RocksDBColumnFamily?, _ body: (RocksDBColumnFamilyRef?) -> Void) {
+    guard let family else {
+      return body(nil)
+    }
+    with([family]) { body(family.handle) }
+  }
+
+  /// Call `body` while the database of `families` is held open; skipped
+  /// if any of them can't be used
+  mutating func with(_ families: [RocksDBColumnFamily], _ body: () -> Void) {
+    guard let first = families.first else {
+      return body()
+    }
+    guard let owner = first.database else {
+      return fail(.databaseClosed)
+    }
+    let stranger = isBound && database !== owner ? first : families.first { $0.database !== owner }
+    if let stranger {
+      return fail(.invalidArgument("Column family \(stranger.name) belongs to another database"))
+    }
+    isBound = true
+    database = owner
+    do {
+      try owner.whileOpen(body)
+    } catch {
+      fail(error as? RocksDBError ?? .databaseClosed)
+    }
+  }
+
+  /// Throw the first recorded failure, or if the batch's families belong
+  /// to a database other than `target`
+  func check(writingTo target: RocksDB) throws {
+    if let error {
+      throw error
+    }
+    guard !isBound || database === target else {
+      throw RocksDBError.invalidArgument("Batch column families belong to another database")
+    }
+  }
+
+  mutating func reset() {
+    database = nil
+    isBound = false
+    error = nil
+  }
+
+  private mutating func fail(_ failure: RocksDBError) {
+    if error == nil {
+      error = failure
+    }
+  }
+}
+
+/// Per-family subset of `RocksDBOptions`
+public struct RocksDBColumnFamilyOptions: Sendable {
+  /// Compression algorithm (default: lz4)
+  public var compression: RocksDBCompression = .lz4
+
+  /// Compression of each level from L0 down, overriding `compression` (default: empty)
+  public var compressionPerLevel: [RocksDBCompression] = []
+
+  /// Compression of the bottommost level (default: nil, same as its level)
+  public var bottommostCompression: RocksDBCompression? = nil
+
+  /// Tuning of `compression` and `compressionPerLevel` (default: algorithm defaults)
+  public var compressionOptions = RocksDBCompressionOptions()
+
+  /// Tuning of `bottommostCompression` (default: nil, same as `compressionOptions`)
+  public var bottommostCompressionOptions: RocksDBCompressionOptions? = nil
+
+  /// Write buffer size in bytes (default: 64MB)
+  public var writeBufferSize: Int = 64 * 1024 * 1024
+
+  /// Maximum number of write buffers (default: 3)
+  public var maxWriteBufferNumber: Int = 3
+
+  /// Level-0 file number compaction trigger (default: 4)
+  public var level0FileNumCompactionTrigger: Int = 4
+
+  /// Target file size base in bytes (default: 64MB)
+  public var targetFileSizeBase: UInt64 = 64 * 1024 * 1024
+
+  /// Max bytes for level base (default: 256MB)
+  public var maxBytesForLevelBase: UInt64 = 256 * 1024 * 1024
+
+  /// Size levels from the bottom up (default: true)
+  public var levelCompactionDynamicLevelBytes: Bool = true
+
+  /// Size ratio between adjacent levels (default: 10)
+  public var maxBytesForLevelMultiplier: Double = 10
+
+  /// Order leveled compaction picks files in (default: minOverlappingRatio)
+  public var compactionPriority: RocksDBCompactionPriority = .minOverlappingRatio
+
+  /// Rewrite files older than this many seconds, 0 to disable (default: nil, RocksDB's choice)
+  public var periodicCompactionSeconds: UInt64? = nil
+
+  /// Compact files with data older than this many seconds, 0 to disable (default: nil, RocksDB's choice)
+  public var ttl: UInt64? = nil
+
+  /// How SST files are merged over time (default: leveled)
+  public var compactionStyle: RocksDBCompactionStyle = .level
+
+  /// Directories this family's SST files are spread over (default: empty,
+  /// `RocksDBOptions.dbPaths`)
+  public var columnFamilyPaths: [RocksDBStoragePath] = []
+
+  /// Temperature passed to the file system for last-level files (default: unknown)
+  public var lastLevelTemperature: RocksDBTemperature = .unknown
+
+  /// Keep data written within this many seconds out of the last level, 0 to disable (default: 0)
+  public var precludeLastLevelDataSeconds: UInt64 = 0
+
+  /// Prefix extractor for prefix bloom filters and prefix seeks (default: nil)
+  public var prefixExtractor: RocksDBPrefixExtractor? = nil
+
+  /// Memtable structure; all but the skiplist need
+  /// `RocksDBOptions.allowConcurrentMemtableWrite` off (default: skiplist)
+  public var memtableRep: RocksDBMemtableRep = .skipList(lookahead: 0)
+
+  /// Merge operator used by `merge` (default: nil)
+  public var mergeOperator: RocksDBMergeOperator? = nil
+
+  /// Key ordering; cannot change once the family exists (default: bytewise)
+  public var comparator: RocksDBComparator = .bytewise
+
+  /// Memtable bloom filter size as a fraction of `writeBufferSize`, 0 to disable (default: 0)
+  public var memtablePrefixBloomSizeRatio: Double = 0
+
+  /// Add whole keys to the memtable bloom filter (default: false)
+  public var memtableWholeKeyFiltering: Bool = false
+
+  /// Allocate memtable arenas from huge pages of this size in bytes, 0 to disable (default: 0)
+  public var memtableHugePageSize: Int = 0
+
+  /// Block-based table configuration (default: nil, RocksDB defaults)
+  public var tableOptions: RocksDBTableOptions? = nil
+
+  /// SST file format; PlainTable and CuckooTable are read through mmap, so
+  /// give the database options the same format (default: block-based)
+  public var tableFormat: RocksDBTableFormat = .blockBased
+
+  /// Built-in compaction filter rules (default: nil)
+  public var compactionFilter: RocksDBCompactionFilter? = nil
+
+  /// Store large values in blob files that compaction does not rewrite (default: false)
+  public var enableBlobFiles: Bool = false
+
+  /// Values at least this large go to blob files (default: 0, all values)
+  public var minBlobSize: UInt64 = 0
+
+  /// Target blob file size in bytes (default: 256MB)
+  public var blobFileSize: UInt64 = 256 * 1024 * 1024
+
+  /// Blob file compression (default: none)
+  public var blobCompression: RocksDBCompression = .none
+
+  /// Relocate live values out of old blob files during compaction (default: false)
+  public var enableBlobGarbageCollection: Bool = false
+
+  /// Fraction of the oldest blob files eligible for garbage collection (default: 0.25)
+  public var blobGarbageCollectionAgeCutoff: Double = 0.25
+
+  /// Cache for blob values; may be shared with the block cache (default: nil)
+  public var blobCache: RocksDBCache? = nil
+
+  public init() {}
+
+  /// Take the column family settings of database options
+  public init(_ options: RocksDBOptions) {
+    compression = options.compression
+    compressionPerLevel = options.compressionPerLevel
+    bottommostCompression = options.bottommostCompression
+    compressionOptions = options.compressionOptions
+    bottommostCompressionOptions = options.bottommostCompressionOptions
+    writeBufferSize = options.writeBufferSize
+    maxWriteBufferNumber = options.maxWriteBufferNumber
+    level0FileNumCompactionTrigger = options.level0FileNumCompactionTrigger
+    targetFileSizeBase = options.targetFileSizeBase
+    maxBytesForLevelBase = options.maxBytesForLevelBase
+    levelCompactionDynamicLevelBytes = options.levelCompactionDynamicLevelBytes
+    maxBytesForLevelMultiplier = options.maxBytesForLevelMultiplier
+    compactionPriority = options.compactionPriority
+    periodicCompactionSeconds = options.periodicCompactionSeconds
+    ttl = options.ttl
+    compactionStyle = options.compactionStyle
+    columnFamilyPaths = options.columnFamilyPaths
+    lastLevelTemperature = options.lastLevelTemperature
+    precludeLastLevelDataSeconds = options.precludeLastLevelDataSeconds
+    prefixExtractor = options.prefixExtractor
+    memtableRep = options.memtableRep
+    memtablePrefixBloomSizeRatio = options.memtablePrefixBloomSizeRatio
+    memtableWholeKeyFiltering = options.memtableWholeKeyFiltering
+    memtableHugePageSize = options.memtableHugePageSize
+    mergeOperator = options.mergeOperator
+    comparator = options.comparator
+    tableOptions = options.tableOptions
+    tableFormat = options.tableFormat
+    compactionFilter = options.compactionFilter
+    enableBlobFiles = options.enableBlobFiles
+    minBlobSize = options.minBlobSize
+    blobFileSize = options.blobFileSize
+    blobCompression = options.blobCompression
+    enableBlobGarbageCollection = options.enableBlobGarbageCollection
+    blobGarbageCollectionAgeCutoff = options.blobGarbageCollectionAgeCutoff
+    blobCache = options.blobCache
+  }
+
+  /// Create C handle from options; the bridge only reads its column family fields
+  internal func createHandle() -> RocksDBOptionsRef {
+    var opts = RocksDBOptions()
+    opts.compression = compression
+    opts.compressionPerLevel = compressionPerLevel
+    opts.bottommostCompression = bottommostCompression
+    opts.compressionOptions = compressionOptions
+    opts.bottommostCompressionOptions = bottommostCompressionOptions
+    opts.writeBufferSize = writeBufferSize
+    opts.maxWriteBufferNumber = maxWriteBufferNumber
+    opts.level0FileNumCompactionTrigger = level0FileNumCompactionTrigger
+    opts.targetFileSizeBase = targetFileSizeBase
+    opts.maxBytesForLevelBase = maxBytesForLevelBase
+    opts.levelCompactionDynamicLevelBytes = levelCompactionDynamicLevelBytes
+    opts.maxBytesForLevelMultiplier = maxBytesForLevelMultiplier
+    opts.compactionPriority = compactionPriority
+    opts.periodicCompactionSeconds = periodicCompactionSeconds
+    opts.ttl = ttl
+    opts.compactionStyle = compactionStyle
+    opts.columnFamilyPaths = columnFamilyPaths
+    opts.lastLevelTemperature = lastLevelTemperature
+    opts.precludeLastLevelDataSeconds = precludeLastLevelDataSeconds
+    opts.prefixExtractor = prefixExtractor
+    opts.memtableRep = memtableRep
+    opts.memtablePrefixBloomSizeRatio = memtablePrefixBloomSizeRatio
+    opts.memtableWholeKeyFiltering = memtableWholeKeyFiltering
+    opts.memtableHugePageSize = memtableHugePageSize
+    opts.mergeOperator = mergeOperator
+    opts.comparator = comparator
+    opts.tableOptions = tableOptions
+    opts.tableFormat = tableFormat
+    opts.compactionFilter = compactionFilter
+    opts.enableBlobFiles = enableBlobFiles
+    opts.minBlobSize = minBlobSize
+    opts.blobFileSize = blobFileSize
+    opts.blobCompression = blobCompression
+    opts.enableBlobGarbageCollection = enableBlobGarbageCollection
+    opts.blobGarbageCollectionAgeCutoff = blobGarbageCollectionAgeCutoff
+    opts.blobCache = blobCache
+    return opts.createHandle()
+  }
+}
@@ -0,0 +1,113 @@
+//
+//  RocksDBCompactionFilter.swift
+//  RocksDB.swift
+//
+//  Built-in declarative compaction filters
+//
+
+import Foundation
+import CRocksDB
+
+/// Rules for dropping data during compaction, evaluated natively
+///
+/// Assign to `RocksDBOptions.compactionFilter` (or a column family's
+/// options). Rules can be changed while the database is open and apply to
+/// compactions that start afterwards, so e.g. adding a retired tenant's
+/// prefix reclaims its space without a delete pass. Call `compactRange`
+/// to apply a change right away.
+public final class RocksDBCompactionFilter: @unchecked Sendable {
+  internal let handle: RocksDBCompactionFilterRef
+
+  private let lock = NSLock()
+  private var prefixes: Set<Data> = []
+
+  /// Create a filter with no rules
+  public init() {
+    self.handle = rocksdb_compaction_filter_create()!
+  }
+
+  deinit {
+    rocksdb_compaction_filter_destroy(handle)
+  }
+
+  // MARK: - Prefix Rule
+
+  /// Key prefixes whose keys are dropped
+  public var droppedPrefixes: Set<Data> {
+    get { lock.withLock { prefixes } }
+    set {
+      lock.withLock {
+        prefixes = newValue
+        applyPrefixes()
+      }
+    }
+  }
+
+  /// Start dropping keys with prefix
+  public func addDroppedPrefix(_ prefix: Data) {
+    lock.withLock {
+      if prefixes.insert(prefix).inserted {
+        applyPrefixes()
+      }
+    }
+  }
+
+  /// Stop dropping keys with prefix
+  public func removeDroppedPrefix(_ prefix: Data) {
+    lock.withLock {
+      if prefixes.remove(prefix) != nil {
+        applyPrefixes()
+      }
+    }
+  }
+
+  private func applyPrefixes() {
+    let list = Array(prefixes)
+    list.withPackedKeys { prefixPtrs, prefixLens in
+      rocksdb_compaction_filter_set_dropped_prefixes(handle, list.count, prefixPtrs, prefixLens)
+    }
+  }
+
+  // MARK: - Value Header Rule
+
+  /// Drop values whose unsigned header field is below a threshold
+  ///
+  /// Values too short to hold the field are kept.
+  /// - Parameters:
+  ///   - offset: Byte offset of the field in the value
+  ///   - width: Field width in bytes (1...8)
+  ///   - bigEndian: Field byte order
+  ///   - threshold: Values with a smaller field are dropped
+  public func dropValues(headerOffset offset: Int = 0, width: Int, bigEndian: Bool = true,
+                         below threshold: UInt64) {
+    precondition((1...8).contains(width), "width must be between 1 and 8")
+    rocksdb_compaction_filter_set_header_threshold(handle, offset, width, bigEndian ? 1 : 0,
+                                                   threshold)
+  }
+
+  /// Remove the value header rule
+  public func keepAllValueHeaders() {
+    rocksdb_compaction_filter_set_header_threshold(handle, 0, 0, 1, 0)
+  }
+
+  // MARK: - Version Rule
+
+  /// Keep only the first `count` keys sharing each key prefix
+  ///
+  /// Encode version suffixes so that newer versions sort first (e.g. an
+  /// inverted big-endian timestamp). Versions are counted per compaction,
+  /// so the limit is exact only after a full `compactRange`.
+  /// - Parameters:
+  ///   - count: Versions to keep per prefix (0 removes the rule)
+  ///   - prefixLength: Length of the key prefix that identifies a record
+  public func keepNewestVersions(_ count: Int, prefixLength: Int) {
+    rocksdb_compaction_filter_set_max_versions(handle, prefixLength, count)
+  }
+
+  // MARK: - Statistics
+
+  /// Entries dropped by this filter so far
+  public var droppedCount: UInt64 {
+    rocksdb_compaction_filter_get_dropped_count(handle)
+  }
+}
@@ -0,0 +1,157 @@
+//
+//  RocksDBCompactionScheduler.swift
+//  RocksDB.swift
+//
+//  Hold off compactions during latency-sensitive time windows
+//
+
+import Foundation
+import CRocksDB
+
+/// Daily time window in a calendar's time zone
+public struct RocksDBTimeWindow: Sendable, Equatable {
+  /// Hour the window opens (0-23)
+  public var startHour: Int
+
+  /// Minute the window opens (0-59)
+  public var startMinute: Int
+
+  /// Length of the window; a window may run past midnight
+  public var duration: TimeInterval
+
+  public init(startHour: Int, startMinute: Int = 0, duration: TimeInterval) {
+    self.startHour = startHour
+    self.startMinute = startMinute
+    self.duration = duration
+  }
+
+  /// Whether `date` falls inside the window
+  public func contains(_ date: Date, calendar: Calendar = .current) -> Bool {
+    let parts = calendar.dateComponents([.hour, .minute, .second], from: date)
+    let secondsOfDay = (parts.hour ?? 0) * 3600 + (parts.minute ?? 0) * 60 + (parts.second ?? 0)
+    let start = startHour * 3600 + startMinute * 60
+    let offset = ((secondsOfDay - start) % 86_400 + 86_400) % 86_400
+    return Double(offset) < duration
+  }
+}
+
+/// Disables compactions while a quiet window is open
+///
+/// Inside a window, automatic compactions of the watched column families
+/// are switched off (and manual ones blocked, if requested) so their I/O
+/// does not compete with foreground reads. Flushes keep running. If any
+/// family's L0 file count comes within `safetyMargin` files of its
+/// `level0SlowdownWritesTrigger`, compactions resume at once, even inside
+/// a window, so the quiet period never turns into a write stall.
+public final class RocksDBCompactionScheduler: @unchecked Sendable {
+  /// Database being scheduled
+  public let database: RocksDB
+
+  /// Windows during which compactions are held off
+  public let windows: [RocksDBTimeWindow]
+
+  /// Column families to watch and toggle (nil for the default family)
+  public let columnFamilies: [RocksDBColumnFamily?]
+
+  /// Compactions resume once L0 holds `level0SlowdownWritesTrigger - safetyMargin` files
+  public let safetyMargin: Int
+
+  /// Also block manual compactions inside a window
+  public let blocksManualCompaction: Bool
+
+  private let lock = NSLock()
+  private var quiet = false
+  private var timer: DispatchSourceTimer?
+
+  /// Create a scheduler; call `start(checkInterval:)` to begin
+  public init(
+    database: RocksDB,
+    windows: [RocksDBTimeWindow],
+    columnFamilies: [RocksDBColumnFamily?] = [nil],
+    safetyMargin: Int = 4,
+    blocksManualCompaction: Bool = true
+  ) {
+    self.database = database
+    self.windows = windows
+    self.columnFamilies = columnFamilies
+    self.safetyMargin = safetyMargin
+    self.blocksManualCompaction = blocksManualCompaction
+  }
+
+  deinit {
+    stop()
+  }
+
+  /// Whether compactions are currently held off
+  public var isQuiet: Bool {
+    lock.withLock { quiet }
+  }
+
+  /// Evaluate now and then every `checkInterval` seconds
+  public func start(checkInterval: TimeInterval = 30) {
+    let source = DispatchSource.makeTimerSource(queue: DispatchQueue(label: "RocksDBCompactionScheduler"))
+    source.schedule(deadline: .now(), repeating: checkInterval)
+    source.setEventHandler { [weak self] in
+      _ = try? self?.evaluate()
+    }
+
+    lock.withLock {
+      timer?.cancel()
+      timer = source
+    }
+    source.resume()
+  }
+
+  /// Stop evaluating and re-enable compactions
+  public func stop() {
+    let source = lock.withLock { () -> DispatchSourceTimer? in
+      defer { timer = nil }
+      return timer
+    }
+    source?.cancel()
+    try? transition(toQuiet: false)
+  }
+
+  /// Apply the schedule for `date`
+  /// - Parameter date: Time to evaluate the windows at
+  /// - Returns: Whether compactions are held off afterwards
+  /// - Throws: RocksDBError if the options cannot be changed
+  @discardableResult
+  public func evaluate(at date: Date = Date()) throws -> Bool {
+    let inWindow = windows.contains { $0.contains(date) }
+    let wantQuiet = inWindow && !nearWriteSlowdown()
+    try transition(toQuiet: wantQuiet)
+    return wantQuiet
+  }
+
+  /// Whether any watched family is close to the L0 slowdown trigger
+  private func nearWriteSlowdown() -> Bool {
+    columnFamilies.contains { family in
+      guard let trigger = database.level0SlowdownWritesTrigger(of: family),
+            let value = database.getProperty("rocksdb.num-files-at-level0", of: family),
+            let files = Int(value) else {
+        return false
+      }
+      return files >= trigger - safetyMargin
+    }
+  }
+
+  private func transition(toQuiet: Bool) throws {
+    try lock.withLock {
+      guard quiet != toQuiet else { return }
+
+      for family in columnFamilies {
+        try database.setAutoCompactionsDisabled(toQuiet, for: family)
+      }
+      if blocksManualCompaction {
+        // Disable and enable nest, so only toggle on a state change
+        if toQuiet {
+          database.disableManualCompaction()
+        } else {
+          database.enableManualCompaction()
+        }
+      }
+      quiet = toQuiet
+    }
+  }
+}
@@ -0,0 +1,201 @@
+//
+//  RocksDBCompactionService.swift
+//  RocksDB.swift
+//
+//  Run compactions on other processes or machines
+//
+
+import Foundation
+import CRocksDB
+
+/// Compaction handed to a `RocksDBCompactionService`
+public struct RocksDBCompactionJob: Sendable {
+  /// Path of the primary database, to open on the worker
+  public var databaseName: String
+  public var databaseID: String
+  public var sessionID: String
+  /// Unique within the database session only; combine with `databaseID`
+  /// and `sessionID` for a global id
+  public var jobID: UInt64
+  /// Thread pool the compaction would have run in
+  public var threadPool: RocksDBThreadPool
+  /// RocksDB `CompactionReason` value, as in `RocksDBCompactionEvent.reason`
+  public var reason: Int
+  public var isFullCompaction: Bool
+  public var isManualCompaction: Bool
+  public var isBottommostLevel: Bool
+}
+
+/// Outcome of a remote compaction job as seen by the primary
+public enum RocksDBCompactionJobStatus: Int32, Sendable {
+  case success = 0
+  /// The compaction fails and is retried later like any failed compaction
+  case failure = 1
+  /// Run the compaction locally instead
+  case useLocal = 2
+}
+
+/// Scheduler that runs a primary's compactions elsewhere
+///
+/// Assign to `RocksDBOptions.compactionService`. For each compaction the
+/// primary calls `schedule(_:input:)` and then `wait(forJob:)` on one of
+/// its compaction threads. The scheduler ships `input` to a worker, which
+/// calls `RocksDB.openAndCompact` against the primary's files and returns
+/// its output; `wait` hands that output back and the primary installs the
+/// new files. Worker and primary must share storage: the worker reads the
+/// primary's directory and the primary moves files out of the worker's
+/// output directory. Returning `.useLocal` at either step runs the
+/// compaction on the primary as usual.
+///
+///     final class Offloader: RocksDBCompactionService {
+///       func schedule(_ job: RocksDBCompactionJob, input: Data) -> RocksDBCompactionSchedule {
+///         .scheduled(jobID: queue.submit(job.databaseName, input))
+///       }
+///       func wait(forJob id: String) -> RocksDBCompactionResult {
+///         queue.result(of: id).map { .completed($0) } ?? .failure
+///       }
+///     }
+public protocol RocksDBCompactionService: AnyObject, Sendable {
+  /// Service name recorded in the options file
+  var name: String { get }
+
+  /// Start a job for `input`, the serialized compaction for the worker
+  func schedule(_ job: RocksDBCompactionJob, input: Data) -> RocksDBCompactionSchedule
+
+  /// Block until the job finishes
+  func wait(forJob id: String) -> RocksDBCompactionResult
+
+  /// The job's files were installed into the primary, or failed to be;
+  /// the worker's output directory can be removed
+  func installed(job id: String, status: RocksDBCompactionJobStatus)
+}
+
+extension RocksDBCompactionService {
+  public var name: String {
+    "RocksDBSwiftCompactionService"
+  }
+
+  public func installed(job id: String, status: RocksDBCompactionJobStatus) {}
+}
+
+/// Answer to `RocksDBCompactionService.schedule(_:input:)`
+public enum RocksDBCompactionSchedule: Sendable {
+  /// Job started; `jobID` is passed to `wait(forJob:)`
+  case scheduled(jobID: String)
+  case failure
+  case useLocal
+}
+
+/// Answer to `RocksDBCompactionService.wait(forJob:)`
+public enum RocksDBCompactionResult: Sendable {
+  /// Output returned by the worker's `RocksDB.openAndCompact`
+  case completed(Data)
+  case failure
+  case useLocal
+}
+
+// MARK: - Bridge Callbacks
+
+/// Retains the service for as long as the bridge references it
+private final class CompactionServiceBox {
+  let service: any RocksDBCompactionService
+
+  init(_ service: any RocksDBCompactionService) {
+    self.service = service
+  }
+
+  static func from(_ context: UnsafeMutableRawPointer?) -> any RocksDBCompactionService {
+    Unmanaged<CompactionServiceBox>.fromOpaque(context!).takeUnretainedValue().service
+  }
+}
+
+extension RocksDBOptions {
+  internal static func installCompactionService(_ service: any RocksDBCompactionService,
+                                                on opts: RocksDBOptionsRef) {
+    let context = Unmanaged.passRetained(CompactionServiceBox(service)).toOpaque()
+    rocksdb_options_set_compaction_service(opts, service.name, context, { context, info, input, inputLength, jobIDOut in
+      let info = info!.pointee
+      let job = RocksDBCompactionJob(
+        databaseName: String(cString: info.db_name),
+        databaseID: String(cString: info.db_id),
+        sessionID: String(cString: info.db_session_id),
+        jobID: info.job_id,
+        threadPool: RocksDBThreadPool(rawValue: info.priority) ?? .low,
+        reason: Int(info.compaction_reason),
+        isFullCompaction: info.is_full_compaction != 0,
+        isManualCompaction: info.is_manual_compaction != 0,
+        isBottommostLevel: info.bottommost_level != 0)
+      let data = input.map { Data(bytes: $0, count: inputLength) } ?? Data()
+
+      switch CompactionServiceBox.from(context).schedule(job, input: data) {
+      case .scheduled(let jobID):
+        jobIDOut!.pointee = strdup(jobID)
+        return Int32(RocksDBCompactionJobSuccess.rawValue)
+      case .failure:
+        return Int32(RocksDBCompactionJobFailure.rawValue)
+      case .useLocal:
+        return Int32(RocksDBCompactionJobUseLocal.rawValue)
+      }
+    }, { context, jobID, resultOut, resultLengthOut in
+      switch CompactionServiceBox.from(context).wait(forJob: String(cString: jobID!)) {
+      case .completed(let output):
+        let buffer = malloc(max(output.count, 1))!
+        output.copyBytes(to: buffer.assumingMemoryBound(to: UInt8.self), count: output.count)
+        resultOut!.pointee = buffer.assumingMemoryBound(to: CChar.self)
+        resultLengthOut!.pointee = output.count
+        return Int32(RocksDBCompactionJobSuccess.rawValue)
+      case .failure:
+        return Int32(RocksDBCompactionJobFailure.rawValue)
+      case .useLocal:
+        return Int32(RocksDBCompactionJobUseLocal.rawValue)
+      }
+    }, { context, jobID, status in
+      CompactionServiceBox.from(context).installed(
+        job: String(cString: jobID!), status: RocksDBCompactionJobStatus(rawValue: status) ?? .failure)
+    }, { context in
+      Unmanaged<CompactionServiceBox>.fromOpaque(context!).release()
+    })
+  }
+}
+
+// MARK: - Worker
+
+extension RocksDB {
+  /// Run a compaction scheduled by a primary's `RocksDBCompactionService`
+  ///
+  /// Opens the primary's files read-only, without taking its lock,
+  /// compacts the input files into `outputDirectory` and returns the result
+  /// for the primary's `wait(forJob:)`. The primary keeps running and
+  /// installs the files itself.
+  /// - Parameters:
+  ///   - path: Primary database directory, as in `RocksDBCompactionJob.databaseName`
+  ///   - outputDirectory: Directory for the new files, created if missing;
+  ///     the primary must be able to read it
+  ///   - input: Input passed to the service's `schedule(_:input:)`
+  ///   - options: Comparator, merge operator, compaction filter, prefix
+  ///     extractor, table format and listeners, matching the primary's
+  ///   - cancellationToken: Token that stops the compaction when cancelled
+  /// - Returns: Output to return from `wait(forJob:)` as `.completed`
+  /// - Throws: RocksDBError on failure; RocksDBError.incomplete if cancelled
+  public static func openAndCompact(
+    at path: String,
+    outputDirectory: String,
+    input: Data,
+    options: RocksDBOptions = .default,
+    cancellationToken: RocksDBCancellationToken? = nil
+  ) throws -> Data {
+    let opts = options.createHandle()
+    defer { rocksdb_options_destroy(opts) }
+
+    var output: UnsafeMutablePointer<CChar>?
+    var outputLength = 0
+    try input.withUnsafeBytes { inputPtr in
+      try RocksDBError.check(rocksdb_open_and_compact(
+        path, outputDirectory, inputPtr.baseAddress?.assumingMemoryBound(to: CChar.self), input.count,
+        opts, cancellationToken?.handle, &output, &outputLength))
+    }
+    guard let output else { return Data() }
+    defer { rocksdb_free_data(output) }
+    return Data(bytes: output, count: outputLength)
+  }
+}
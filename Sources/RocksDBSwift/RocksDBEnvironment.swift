@@ -0,0 +1,79 @@
+//
+//  RocksDBEnvironment.swift
+//  RocksDB.swift
+//
+//  Background thread pools of the default RocksDB environment
+//
+
+import Foundation
+import CRocksDB
+
+/// Background thread pool of the default environment
+public enum RocksDBThreadPool: Int32, Sendable {
+  /// Bottommost-level compactions, once given threads (default: 0 threads)
+  case bottom = 0
+  /// Compactions (default: 1 thread)
+  case low = 1
+  /// Flushes (default: 1 thread)
+  case high = 2
+}
+
+/// CPU scheduling priority for a background thread pool
+public enum RocksDBCPUPriority: Int32, Sendable {
+  case idle = 0
+  case low = 1
+  case normal = 2
+  case high = 3
+}
+
+/// Background threads of the default environment
+///
+/// The pools are process-wide: every open database schedules its flushes
+/// and compactions on them, so size them for the sum of the databases'
+/// `maxBackgroundJobs`. Giving the bottom pool threads moves bottommost
+/// compactions, the largest and least urgent, off the low pool, where they
+/// can then run at a lower priority without delaying the rest.
+public enum RocksDBEnvironment {
+  /// Set the number of threads in a pool
+  /// - Parameters:
+  ///   - count: Thread count
+  ///   - pool: Pool to resize
+  public static func setBackgroundThreads(_ count: Int, for pool: RocksDBThreadPool) {
+    rocksdb_env_set_background_threads(pool.rawValue, Int32(clamping: count))
+  }
+
+  /// Number of threads in a pool
+  public static func backgroundThreads(for pool: RocksDBThreadPool) -> Int {
+    Int(rocksdb_env_get_background_threads(pool.rawValue))
+  }
+
+  /// Lower the CPU priority of a pool's threads
+  ///
+  /// Priorities can only be lowered; a higher value than the current one
+  /// is ignored.
+  /// - Parameters:
+  ///   - pool: Pool to adjust
+  ///   - priority: New CPU priority
+  /// - Throws: RocksDBError.notSupported on platforms without support
+  public static func lowerCPUPriority(of pool: RocksDBThreadPool, to priority: RocksDBCPUPriority) throws {
+    try RocksDBError.check(rocksdb_env_lower_thread_pool_cpu_priority(pool.rawValue, priority.rawValue))
+  }
+
+  /// Lower the I/O priority of a pool's threads (Linux only; a no-op elsewhere)
+  public static func lowerIOPriority(of pool: RocksDBThreadPool) {
+    rocksdb_env_lower_thread_pool_io_priority(pool.rawValue)
+  }
+
+  /// Snapshot of every thread of the default environment, across all databases
+  /// - Returns: Thread states, including idle pool threads
+  /// - Throws: RocksDBError.notSupported if RocksDB was built without thread status
+  public static func threadList() throws -> [RocksDBThreadStatus] {
+    var threads: UnsafeMutablePointer<RocksDBThreadStatusValues>?
+    var count: Int = 0
+    try RocksDBError.check(rocksdb_env_get_thread_list(&threads, &count))
+    defer { rocksdb_free_data(threads) }
+
+    guard let threads else { return [] }
+    return (0..<count).map { RocksDBThreadStatus(threads[$0]) }
+  }
+}
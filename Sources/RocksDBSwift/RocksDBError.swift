@@ -18,15 +18,49 @@ public enum RocksDBError: Error, LocalizedError, Sendable {
   case mergeInProgress(String)
   case incomplete(String)
   case shutdownInProgress
-  case timedOut
+  /// Lock waits report `.lockTimeout` or `.mutexTimeout`; an expired
+  /// read deadline reports `.none`
+  case timedOut(Subcode)
   case aborted(String)
-  case busy
+  /// Deadlocks detected by pessimistic transactions report `.deadlock`
+  case busy(Subcode)
   case expired
   case tryAgain
   case compactionTooLarge(String)
   case databaseClosed
   case transactionConflict(String)
 
+  /// Reason RocksDB gives alongside a status code (`rocksdb::Status::SubCode`)
+  public enum Subcode: Int32, Sendable {
+    case none = 0
+    case mutexTimeout = 1
+    case lockTimeout = 2
+    case lockLimit = 3
+    case noSpace = 4
+    case deadlock = 5
+    case staleFile = 6
+    case memoryLimit = 7
+    case spaceLimit = 8
+    case pathNotFound = 9
+    case mergeOperandsInsufficientCapacity = 10
+    case manualCompactionPaused = 11
+    case overwritten = 12
+    case transactionNotPrepared = 13
+    case ioFenced = 14
+    case mergeOperatorFailed = 15
+    case mergeOperandThresholdExceeded = 16
+  }
+
+  /// Subcode of a timed out or busy status; `.none` for other errors
+  public var subcode: Subcode {
+    switch self {
+    case .timedOut(let subcode), .busy(let subcode):
+      return subcode
+    default:
+      return .none
+    }
+  }
+
   public var errorDescription: String? {
     switch self {
     case .notFound:
@@ -45,10 +79,16 @@ public enum RocksDBError: Error, LocalizedError, Sendable {
       return "Operation incomplete: \(msg)"
     case .shutdownInProgress:
       return "Database shutdown in progress"
+    case .timedOut(.lockTimeout):
+      return "Operation timed out waiting for a lock"
+    case .timedOut(.mutexTimeout):
+      return "Operation timed out waiting for a mutex"
     case .timedOut:
       return "Operation timed out"
     case .aborted(let msg):
       return "Operation aborted: \(msg)"
+    case .busy(.deadlock):
+      return "Database busy: deadlock detected"
     case .busy:
       return "Database busy"
     case .expired:
@@ -67,6 +107,10 @@ public enum RocksDBError: Error, LocalizedError, Sendable {
   /// Create error from RocksDB C status
   static func from(_ status: RocksDBStatus) -> RocksDBError? {
     guard status.code != RocksDBStatusOK else { return nil }
+    // The hot negative-lookup case; no message to decode
+    if status.code == RocksDBStatusNotFound && status.message == nil {
+      return .notFound
+    }
 
     let message: String
     if let msg = status.message {
@@ -93,11 +137,11 @@ public enum RocksDBError: Error, LocalizedError, Sendable {
     case RocksDBStatusShutdownInProgress:
       return .shutdownInProgress
     case RocksDBStatusTimedOut:
-      return .timedOut
+      return .timedOut(Subcode(rawValue: Int32(status.subcode)) ?? .none)
     case RocksDBStatusAborted:
       return .aborted(message)
     case RocksDBStatusBusy:
-      return .busy
+      return .busy(Subcode(rawValue: Int32(status.subcode)) ?? .none)
     case RocksDBStatusExpired:
       return .expired
     case RocksDBStatusTryAgain:
@@ -0,0 +1,167 @@
+//
+//  RocksDBEventListener.swift
+//  RocksDB.swift
+//
+//  Flush, compaction, write stall and background error events
+//
+
+import Foundation
+import CRocksDB
+
+/// Write stall state of a column family
+public enum RocksDBWriteStallCondition: Int32, Sendable {
+  case normal = 0
+  /// Writes are slowed down
+  case delayed = 1
+  /// Writes are stopped
+  case stopped = 2
+}
+
+/// Completed memtable flush
+public struct RocksDBFlushEvent: Sendable {
+  public var columnFamily: String
+  public var jobID: Int
+  /// Bytes written to the new SST file
+  public var outputBytes: UInt64
+  /// RocksDB `FlushReason` value
+  public var reason: Int
+  /// Writes were slowed down, or stopped, when the flush completed
+  public var triggeredWritesSlowdown: Bool
+  public var triggeredWritesStop: Bool
+  public var timestamp: Date
+}
+
+/// Completed compaction
+public struct RocksDBCompactionEvent: Sendable {
+  public var columnFamily: String
+  public var jobID: Int
+  public var inputLevel: Int
+  public var outputLevel: Int
+  public var inputBytes: UInt64
+  public var outputBytes: UInt64
+  public var inputFiles: Int
+  public var outputFiles: Int
+  public var duration: TimeInterval
+  /// RocksDB `CompactionReason` value
+  public var reason: Int
+  /// Failure of the compaction, nil if it succeeded
+  public var error: RocksDBError?
+  public var timestamp: Date
+}
+
+/// Event recorded by a `RocksDBEventListener`
+public enum RocksDBEvent: Sendable {
+  case flushCompleted(RocksDBFlushEvent)
+  case compactionCompleted(RocksDBCompactionEvent)
+  case stallConditionsChanged(columnFamily: String, from: RocksDBWriteStallCondition,
+                              to: RocksDBWriteStallCondition, timestamp: Date)
+  /// `reason` is a RocksDB `BackgroundErrorReason` value
+  case backgroundError(reason: Int, error: RocksDBError?, timestamp: Date)
+
+  internal init?(_ event: RocksDBEventRecord) {
+    let timestamp = Date(timeIntervalSince1970: TimeInterval(event.timestamp_micros) / 1_000_000)
+    let columnFamily = withUnsafeBytes(of: event.column_family) { String(cString: $0.bindMemory(to: CChar.self).baseAddress!) }
+
+    switch event.type {
+    case Int32(RocksDBEventFlushCompleted.rawValue):
+      self = .flushCompleted(RocksDBFlushEvent(
+        columnFamily: columnFamily,
+        jobID: Int(event.job_id),
+        outputBytes: event.output_bytes,
+        reason: Int(event.reason),
+        triggeredWritesSlowdown: event.triggered_writes_slowdown != 0,
+        triggeredWritesStop: event.triggered_writes_stop != 0,
+        timestamp: timestamp))
+    case Int32(RocksDBEventCompactionCompleted.rawValue):
+      self = .compactionCompleted(RocksDBCompactionEvent(
+        columnFamily: columnFamily,
+        jobID: Int(event.job_id),
+        inputLevel: Int(event.input_level),
+        outputLevel: Int(event.output_level),
+        inputBytes: event.input_bytes,
+        outputBytes: event.output_bytes,
+        inputFiles: Int(event.input_files),
+        outputFiles: Int(event.output_files),
+        duration: TimeInterval(event.duration_micros) / 1_000_000,
+        reason: Int(event.reason),
+        error: RocksDBEvent.error(code: event.status_code, message: "Compaction failed"),
+        timestamp: timestamp))
+    case Int32(RocksDBEventStallConditionsChanged.rawValue):
+      self = .stallConditionsChanged(
+        columnFamily: columnFamily,
+        from: RocksDBWriteStallCondition(rawValue: event.stall_previous) ?? .normal,
+        to: RocksDBWriteStallCondition(rawValue: event.stall_current) ?? .normal,
+        timestamp: timestamp)
+    case Int32(RocksDBEventBackgroundError.rawValue):
+      let message = withUnsafeBytes(of: event.message) { String(cString: $0.bindMemory(to: CChar.self).baseAddress!) }
+      self = .backgroundError(reason: Int(event.reason),
+                              error: RocksDBEvent.error(code: event.status_code, message: message),
+                              timestamp: timestamp)
+    default:
+      return nil
+    }
+  }
+
+  private static func error(code: Int32, message: String) -> RocksDBError? {
+    message.withCString { ptr in
+      RocksDBError.from(RocksDBStatus(code: RocksDBStatusCode(rawValue: UInt32(bitPattern: code)),
+                                      subcode: 0, message: UnsafeMutablePointer(mutating: ptr)))
+    }
+  }
+}
+
+/// Records background events into a bounded lock-free buffer
+///
+/// RocksDB calls the listener on its background threads, which only copy a
+/// fixed-size record into the buffer and never wait on Swift. Drain it with
+/// `poll(maxEvents:)` or `events(pollInterval:)`. Events arriving while the
+/// buffer is full are dropped and counted in `droppedCount`.
+///
+/// Attach listeners through `RocksDBOptions.eventListeners` before opening.
+public final class RocksDBEventListener: @unchecked Sendable {
+  internal let handle: RocksDBEventListenerRef
+
+  /// Create a listener
+  /// - Parameter capacity: Events buffered before new ones are dropped
+  public init(capacity: Int = 1024) {
+    handle = rocksdb_event_listener_create(max(capacity, 2))!
+  }
+
+  deinit {
+    rocksdb_event_listener_destroy(handle)
+  }
+
+  /// Events dropped because the buffer was full
+  public var droppedCount: UInt64 {
+    rocksdb_event_listener_dropped(handle)
+  }
+
+  /// Take pending events, oldest first
+  /// - Parameter maxEvents: Maximum number of events to return
+  /// - Returns: Up to `maxEvents` events
+  public func poll(maxEvents: Int = 256) -> [RocksDBEvent] {
+    guard maxEvents > 0 else { return [] }
+
+    var raw = [RocksDBEventRecord](repeating: RocksDBEventRecord(), count: maxEvents)
+    let count = rocksdb_event_listener_poll(handle, &raw, maxEvents)
+    return raw.prefix(count).compactMap(RocksDBEvent.init)
+  }
+
+  /// Stream of events, drained every `pollInterval` seconds
+  ///
+  /// The stream ends when the consuming task is cancelled.
+  public func events(pollInterval: TimeInterval = 0.1) -> AsyncStream<RocksDBEvent> {
+    AsyncStream { continuation in
+      let task = Task {
+        while !Task.isCancelled {
+          for event in self.poll() {
+            continuation.yield(event)
+          }
+          try? await Task.sleep(nanoseconds: UInt64(pollInterval * 1_000_000_000))
+        }
+        continuation.finish()
+      }
+      continuation.onTermination = { _ in task.cancel() }
+    }
+  }
+}
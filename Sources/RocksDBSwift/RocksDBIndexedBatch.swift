@@ -0,0 +1,184 @@
+//
+//  RocksDBIndexedBatch.swift
+//  RocksDB.swift
+//
+//  Write batch with a searchable index for RocksDB
+//
+
+import Foundation
+import CRocksDB
+
+/// Write batch whose staged operations can be read back before it is written
+///
+/// Backed by `WriteBatchWithIndex`: `RocksDB.get(_:stagedIn:)` and
+/// `RocksDB.makeIterator(stagedIn:)` see the database as if the batch had
+/// already been applied, giving read-your-own-writes without a transaction.
+/// The batch is committed with `RocksDB.writeBatch(_:options:)` like a plain
+/// `RocksDBBatch`. Entries for the default family are indexed bytewise; pass
+/// the family explicitly when it uses another comparator.
+public final class RocksDBIndexedBatch: @unchecked Sendable {
+  internal let handle: RocksDBIndexedBatchRef
+  private let lock = NSRecursiveLock()
+  private var families = BatchFamilies()
+
+  /// Whether a later update of a key replaces the earlier one in the index
+  public let overwritesKeys: Bool
+
+  /// Create a new empty batch
+  /// - Parameters:
+  ///   - reservedBytes: Bytes to preallocate
+  ///   - overwriteKeys: Keep only the latest update of each key in the index
+  ///     (default: true); required to read back keys merged more than once
+  public init(reservedBytes: Int = 0, overwriteKeys: Bool = true) {
+    self.handle = rocksdb_indexed_batch_create(reservedBytes, overwriteKeys ? 1 : 0)
+    self.overwritesKeys = overwriteKeys
+  }
+
+  deinit {
+    rocksdb_indexed_batch_destroy(handle)
+  }
+
+  // MARK: - Operations
+
+  /// Stage a put operation
+  /// - Parameters:
+  ///   - value: Value data
+  ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
+  public func put(_ value: Data, forKey key: Data, in columnFamily: RocksDBColumnFamily? = nil) {
+    lock.withLock {
+      families.with(columnFamily) { cf in
+        key.withUnsafeBytes { keyPtr in
+          value.withUnsafeBytes { valuePtr in
+            rocksdb_indexed_batch_put_cf(handle, cf,
+                                         keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                         key.count,
+                                         valuePtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                         value.count)
+          }
+        }
+      }
+    }
+  }
+
+  /// Stage a put operation with string key and value
+  public func put(_ value: String, forKey key: String) {
+    lock.withLock {
+      key.withUTF8Bytes { keyPtr in
+        value.withUTF8Bytes { valuePtr in
+          rocksdb_indexed_batch_put_cf(handle, nil,
+                                       keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                       keyPtr.count,
+                                       valuePtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                       valuePtr.count)
+        }
+      }
+    }
+  }
+
+  /// Stage a merge operation
+  /// - Parameters:
+  ///   - value: Merge operand
+  ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
+  public func merge(_ value: Data, forKey key: Data, in columnFamily: RocksDBColumnFamily? = nil) {
+    lock.withLock {
+      families.with(columnFamily) { cf in
+        key.withUnsafeBytes { keyPtr in
+          value.withUnsafeBytes { valuePtr in
+            rocksdb_indexed_batch_merge_cf(handle, cf,
+                                           keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                           key.count,
+                                           valuePtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                           value.count)
+          }
+        }
+      }
+    }
+  }
+
+  /// Stage a delete operation
+  /// - Parameters:
+  ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
+  public func delete(_ key: Data, in columnFamily: RocksDBColumnFamily? = nil) {
+    lock.withLock {
+      families.with(columnFamily) { cf in
+        key.withUnsafeBytes { keyPtr in
+          rocksdb_indexed_batch_delete_cf(handle, cf,
+                                          keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                          key.count)
+        }
+      }
+    }
+  }
+
+  /// Stage a delete operation with string key
+  public func delete(_ key: String) {
+    lock.withLock {
+      key.withUTF8Bytes { keyPtr in
+        rocksdb_indexed_batch_delete_cf(handle, nil,
+                                        keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                        keyPtr.count)
+      }
+    }
+  }
+
+  /// Stage a single-delete for a write-once key (see `RocksDB.singleDelete`)
+  /// - Parameters:
+  ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
+  public func singleDelete(_ key: Data, in columnFamily: RocksDBColumnFamily? = nil) {
+    lock.withLock {
+      families.with(columnFamily) { cf in
+        key.withUnsafeBytes { keyPtr in
+          rocksdb_indexed_batch_single_delete_cf(handle, cf,
+                                                 keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                                 key.count)
+        }
+      }
+    }
+  }
+
+  /// Throw if an operation could not be staged
+  /// - Throws: RocksDBError describing the first failed operation
+  public func validate() throws {
+    try lock.withLock {
+      if let error = families.error {
+        throw error
+      }
+      try RocksDBError.check(rocksdb_indexed_batch_status(handle))
+    }
+  }
+
+  /// Throw if the batch cannot be written to or read through `database`
+  internal func validate(writingTo database: RocksDB) throws {
+    try lock.withLock {
+      try families.check(writingTo: database)
+    }
+  }
+
+  /// Clear all staged operations
+  ///
+  /// Iterators created over the batch must be closed first.
+  public func clear() {
+    lock.withLock {
+      rocksdb_indexed_batch_clear(handle)
+      families.reset()
+    }
+  }
+
+  // MARK: - Properties
+
+  /// Number of staged operations
+  public var count: Int {
+    lock.withLock {
+      rocksdb_indexed_batch_count(handle)
+    }
+  }
+
+  /// Whether the batch is empty
+  public var isEmpty: Bool {
+    count == 0
+  }
+}
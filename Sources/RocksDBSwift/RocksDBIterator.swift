@@ -13,12 +13,27 @@ public final class RocksDBIterator: @unchecked Sendable {
   private var handle: RocksDBIteratorRef?
   private let lock = NSRecursiveLock()
 
-  internal init(handle: RocksDBIteratorRef) {
+  /// Reusable buffer filled by `nextBatch`
+  private var arena: UnsafeMutableRawPointer?
+  private var arenaCapacity: Int = 0
+
+  /// Default number of entries fetched per bridge call when scanning
+  public static let defaultBatchSize = 256
+
+  /// Default byte budget per bridge call when scanning
+  public static let defaultBatchByteBudget = 256 * 1024
+
+  /// Object the native iterator reads from (e.g. an indexed batch), kept alive with it
+  private let owner: AnyObject?
+
+  internal init(handle: RocksDBIteratorRef, owner: AnyObject? = nil) {
     self.handle = handle
+    self.owner = owner
   }
 
   deinit {
     close()
+    arena?.deallocate()
   }
 
   /// Close the iterator
@@ -75,8 +90,13 @@ public final class RocksDBIterator: @unchecked Sendable {
   /// Seek to a specific string key
   /// - Parameter key: Target key string
   public func seek(to key: String) {
-    if let keyData = key.data(using: .utf8) {
-      seek(to: keyData)
+    lock.withLock {
+      guard let h = handle else { return }
+      key.withUTF8Bytes { keyPtr in
+        rocksdb_iterator_seek(h,
+                              keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                              keyPtr.count)
+      }
     }
   }
 
@@ -93,6 +113,32 @@ public final class RocksDBIterator: @unchecked Sendable {
     }
   }
 
+  /// Seek to a typed key (or first key >= target)
+  /// - Parameter key: Target key, in its order-preserving encoding
+  public func seek<Key: RocksDBKeyEncodable>(to key: Key) {
+    lock.withLock {
+      guard let h = handle else { return }
+      key.withEncodedKey { keyPtr in
+        rocksdb_iterator_seek(h,
+                              keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                              keyPtr.count)
+      }
+    }
+  }
+
+  /// Seek for previous typed key (last key <= target)
+  /// - Parameter key: Target key, in its order-preserving encoding
+  public func seekForPrev<Key: RocksDBKeyEncodable>(to key: Key) {
+    lock.withLock {
+      guard let h = handle else { return }
+      key.withEncodedKey { keyPtr in
+        rocksdb_iterator_seek_for_prev(h,
+                                       keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                       keyPtr.count)
+      }
+    }
+  }
+
   // MARK: - Navigation
 
   /// Move to the next key
@@ -139,16 +185,40 @@ public final class RocksDBIterator: @unchecked Sendable {
     }
   }
 
+  /// User timestamp of the current entry (nil if invalid or the family has none)
+  ///
+  /// With `RocksDBReadOptions.iterStartTimestamp` set, the iterator visits
+  /// each version of a key, newest first.
+  public var timestamp: UInt64? {
+    lock.withLock {
+      guard let h = handle else { return nil }
+      var timestamp: UInt64 = 0
+      return rocksdb_iterator_timestamp(h, &timestamp) != 0 ? timestamp : nil
+    }
+  }
+
   /// Current key as string (nil if invalid or not valid UTF-8)
   public var keyString: String? {
-    guard let keyData = key else { return nil }
-    return String(data: keyData, encoding: .utf8)
+    lock.withLock {
+      guard let h = handle else { return nil }
+      var keyLen: Int = 0
+      guard let keyPtr = rocksdb_iterator_key(h, &keyLen) else {
+        return nil
+      }
+      return String(validatingUTF8Bytes: UnsafeRawBufferPointer(start: keyPtr, count: keyLen))
+    }
   }
 
   /// Current value as string (nil if invalid or not valid UTF-8)
   public var valueString: String? {
-    guard let valueData = value else { return nil }
-    return String(data: valueData, encoding: .utf8)
+    lock.withLock {
+      guard let h = handle else { return nil }
+      var valueLen: Int = 0
+      guard let valuePtr = rocksdb_iterator_value(h, &valueLen) else {
+        return nil
+      }
+      return String(validatingUTF8Bytes: UnsafeRawBufferPointer(start: valuePtr, count: valueLen))
+    }
   }
 
   /// Current key-value pair (nil if invalid)
@@ -172,6 +242,168 @@ public final class RocksDBIterator: @unchecked Sendable {
     }
   }
 
+  /// Access the wide columns of the current entry in place
+  ///
+  /// The view is only valid inside `body`; a plain value shows up as a
+  /// single column with an empty name.
+  /// - Parameter body: Closure receiving the column view
+  /// - Returns: Result of `body`, or nil if the iterator is invalid
+  public func withColumns<R>(_ body: (RocksDBWideColumns) throws -> R) rethrows -> R? {
+    try lock.withLock {
+      guard let h = handle, rocksdb_iterator_valid(h) != 0 else { return nil }
+      return try body(RocksDBWideColumns(iterator: h))
+    }
+  }
+
+  /// Current entry's wide columns, copied (nil if invalid)
+  public var columns: [(name: Data, value: Data)]? {
+    withColumns { $0.copy() }
+  }
+
+  // MARK: - Batched Reads
+
+  /// Read up to `maxEntries` entries starting at the current position and
+  /// advance past them, using a single bridge call
+  ///
+  /// Returns an empty array once the iterator is no longer valid. An entry
+  /// larger than `byteBudget` is still returned, on its own.
+  /// - Parameters:
+  ///   - maxEntries: Maximum number of entries to return
+  ///   - byteBudget: Approximate maximum key + value bytes per call
+  /// - Returns: Key-value pairs in iteration order
+  public func nextBatch(
+    maxEntries: Int = RocksDBIterator.defaultBatchSize,
+    byteBudget: Int = RocksDBIterator.defaultBatchByteBudget
+  ) -> [(key: Data, value: Data)] {
+    readBatch(maxEntries: maxEntries, byteBudget: byteBudget) { h, buffer, capacity, limit, bytesUsed in
+      rocksdb_iterator_next_batch(h, buffer, capacity, limit, &bytesUsed)
+    }
+  }
+
+  /// Read up to `maxEntries` entries matching a filter and advance past them
+  ///
+  /// The filter runs inside the bridge, so rejected entries are skipped
+  /// without being copied; a call may step over many of them before it
+  /// returns. Returns an empty array once the iterator is no longer valid.
+  /// - Parameters:
+  ///   - filter: Compiled predicate entries must match
+  ///   - maxEntries: Maximum number of entries to return
+  ///   - byteBudget: Approximate maximum key + value bytes per call
+  /// - Returns: Matching key-value pairs in iteration order
+  public func nextBatch(
+    matching filter: RocksDBScanFilter,
+    maxEntries: Int = RocksDBIterator.defaultBatchSize,
+    byteBudget: Int = RocksDBIterator.defaultBatchByteBudget
+  ) -> [(key: Data, value: Data)] {
+    readBatch(maxEntries: maxEntries, byteBudget: byteBudget) { h, buffer, capacity, limit, bytesUsed in
+      rocksdb_iterator_next_batch_filtered(h, filter.handle, buffer, capacity, limit, &bytesUsed)
+    }
+  }
+
+  /// Shared body of the batched reads: fill the arena through `fetch` and
+  /// unpack the entries
+  private func readBatch(
+    maxEntries: Int,
+    byteBudget: Int,
+    _ fetch: (RocksDBIteratorRef, UnsafeMutablePointer<CChar>?, Int, Int, inout Int) -> Int
+  ) -> [(key: Data, value: Data)] {
+    let traceStart = RocksDBTracing.begin()
+    defer { RocksDBTracing.end(.iteratorNextBatch, traceStart) }
+
+    return lock.withLock {
+      guard let h = handle, maxEntries > 0 else { return [] }
+
+      reserveArena(byteBudget)
+
+      var bytesUsed: Int = 0
+      var count = fetch(h, arena?.assumingMemoryBound(to: CChar.self), arenaCapacity, maxEntries, &bytesUsed)
+      if count == 0 && bytesUsed > 0 {
+        // Next entry exceeds the buffer; grow it and fetch that entry alone
+        reserveArena(bytesUsed)
+        count = fetch(h, arena?.assumingMemoryBound(to: CChar.self), arenaCapacity, 1, &bytesUsed)
+      }
+
+      guard count > 0, let base = arena else { return [] }
+
+      var entries: [(key: Data, value: Data)] = []
+      entries.reserveCapacity(count)
+
+      var offset = 0
+      for _ in 0..<count {
+        let keyLen = Int(base.loadUnaligned(fromByteOffset: offset, as: UInt32.self))
+        let valueLen = Int(base.loadUnaligned(fromByteOffset: offset + 4, as: UInt32.self))
+        offset += 8
+        let key = Data(bytes: base + offset, count: keyLen)
+        offset += keyLen
+        let value = Data(bytes: base + offset, count: valueLen)
+        offset += valueLen
+        entries.append((key: key, value: value))
+      }
+
+      return entries
+    }
+  }
+
+  /// Grow the batch arena to at least `size` bytes
+  private func reserveArena(_ size: Int) {
+    let needed = Swift.max(size, 64)
+    guard needed > arenaCapacity else { return }
+    arena?.deallocate()
+    arena = UnsafeMutableRawPointer.allocate(byteCount: needed, alignment: 8)
+    arenaCapacity = needed
+  }
+
+  // MARK: - Cursor
+
+  /// Scan with a cursor that reads entries in place
+  ///
+  /// The iterator's lock is taken once for the whole scope instead of on
+  /// every step, and keys and values are handed out as views into the
+  /// native iterator, so skipped entries cost no allocation. The cursor
+  /// starts at the current position: seek first, then loop:
+  ///
+  ///     iter.seek(to: start)
+  ///     try iter.withCursor { cursor in
+  ///       while cursor.next() {
+  ///         guard cursor.withValue({ $0.first == 0x01 }) else { continue }
+  ///         matches.append(Data(cursor.key))
+  ///       }
+  ///     }
+  ///
+  /// - Parameter body: Closure driving the cursor; it must not use the
+  ///   iterator itself
+  /// - Returns: Result of `body`
+  /// - Throws: Any error thrown by `body`, or RocksDBError if iteration failed
+  public func withCursor<R>(_ body: (inout RocksDBCursor) throws -> R) throws -> R {
+    try lock.withLock {
+      var cursor = RocksDBCursor(handle: handle)
+      let result = try body(&cursor)
+      if let h = handle {
+        try RocksDBError.check(rocksdb_iterator_status(h))
+      }
+      return result
+    }
+  }
+
+  // MARK: - Refresh
+
+  /// Rebase the iterator on the current state of the database
+  ///
+  /// Cheaper than closing it and creating a new one. The position is lost,
+  /// so seek afterwards. Iterators over transactions and indexed batches
+  /// cannot be refreshed.
+  /// - Throws: RocksDBError.notSupported for those iterators, or on failure
+  public func refresh() throws {
+    let status = lock.withLock { () -> RocksDBStatus? in
+      guard let h = handle else { return nil }
+      return rocksdb_iterator_refresh(h)
+    }
+
+    if let status = status {
+      try RocksDBError.check(status)
+    }
+  }
+
   // MARK: - Status
 
   /// Check for errors during iteration
@@ -188,12 +420,93 @@ public final class RocksDBIterator: @unchecked Sendable {
   }
 }
 
+// MARK: - Cursor
+
+/// Single-owner view of an iterator used inside `RocksDBIterator.withCursor`
+///
+/// `key` and `value` point into the native iterator and stay valid until the
+/// cursor moves; copy them (e.g. `Data(cursor.key)`) to keep them longer.
+public struct RocksDBCursor: ~Copyable {
+  private let handle: RocksDBIteratorRef?
+  private var started = false
+
+  fileprivate init(handle: RocksDBIteratorRef?) {
+    self.handle = handle
+  }
+
+  /// Whether the cursor is at an entry
+  public var isValid: Bool {
+    guard let h = handle else { return false }
+    return rocksdb_iterator_valid(h) != 0
+  }
+
+  /// Step to the next entry; the first call stays on the starting position
+  /// - Returns: Whether the cursor is at an entry
+  public mutating func next() -> Bool {
+    guard let h = handle else { return false }
+    if started {
+      rocksdb_iterator_next(h)
+    } else {
+      started = true
+    }
+    return rocksdb_iterator_valid(h) != 0
+  }
+
+  /// Seek to the first key >= target; the following `next()` stays there
+  public mutating func seek(to key: Data) {
+    guard let h = handle else { return }
+    key.withUnsafeBytes { keyPtr in
+      rocksdb_iterator_seek(h, keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self), key.count)
+    }
+    started = false
+  }
+
+  /// Current key, valid until the cursor moves (empty if invalid)
+  public var key: UnsafeRawBufferPointer {
+    guard let h = handle else { return UnsafeRawBufferPointer(start: nil, count: 0) }
+    var keyLen: Int = 0
+    let keyPtr = rocksdb_iterator_key(h, &keyLen)
+    return UnsafeRawBufferPointer(start: keyPtr, count: keyPtr == nil ? 0 : keyLen)
+  }
+
+  /// Whether `key` stays valid until the `withCursor` scope ends instead
+  /// of until the cursor moves, as `RocksDBReadOptions.pinData` provides
+  public var isKeyPinned: Bool {
+    guard let h = handle else { return false }
+    return rocksdb_iterator_is_key_pinned(h) != 0
+  }
+
+  /// Current value, valid until the cursor moves (empty if invalid)
+  public var value: UnsafeRawBufferPointer {
+    guard let h = handle else { return UnsafeRawBufferPointer(start: nil, count: 0) }
+    var valueLen: Int = 0
+    let valuePtr = rocksdb_iterator_value(h, &valueLen)
+    return UnsafeRawBufferPointer(start: valuePtr, count: valuePtr == nil ? 0 : valueLen)
+  }
+
+  /// Access the current key in place
+  public func withKey<R>(_ body: (UnsafeRawBufferPointer) throws -> R) rethrows -> R {
+    try body(key)
+  }
+
+  /// Access the current value in place
+  public func withValue<R>(_ body: (UnsafeRawBufferPointer) throws -> R) rethrows -> R {
+    try body(value)
+  }
+}
+
+@available(*, unavailable, message: "A cursor belongs to the withCursor scope that created it")
+extension RocksDBCursor: Sendable {}
+
 // MARK: - Sequence Conformance
 
 extension RocksDBIterator: Sequence {
+  /// Iterator that scans from the first key, fetching entries in batches
   public struct Iterator: IteratorProtocol {
     private let rocksIterator: RocksDBIterator
     private var started = false
+    private var buffered: [(key: Data, value: Data)] = []
+    private var index = 0
 
     init(_ iterator: RocksDBIterator) {
       self.rocksIterator = iterator
@@ -203,11 +516,18 @@ extension RocksDBIterator: Sequence {
       if !started {
         started = true
         rocksIterator.seekToFirst()
-      } else {
-        rocksIterator.next()
       }
 
-      return rocksIterator.keyValue
+      if index == buffered.count {
+        buffered = rocksIterator.nextBatch()
+        index = 0
+        if buffered.isEmpty {
+          return nil
+        }
+      }
+
+      defer { index += 1 }
+      return buffered[index]
     }
   }
 
@@ -0,0 +1,161 @@
+//
+//  RocksDBKeyEncoding.swift
+//  RocksDB.swift
+//
+//  Allocation-free, order-preserving key encodings
+//
+
+import Foundation
+
+/// Key type that can hand RocksDB its encoding without building a `Data`
+///
+/// Conformers write an encoding whose bytewise order matches the order of
+/// the values, so range scans and `seek` follow the natural order of the
+/// keys. The encoding goes into a temporary buffer that stays on the stack
+/// for ordinary key sizes, so typed keys reach the bridge with no heap
+/// allocation.
+///
+/// Integers encode big-endian with the sign bit flipped, so negative values
+/// sort before positive ones; UUIDs encode their 16 bytes as is. Combine
+/// them with `RocksDBCompositeKey`:
+///
+///     let key = RocksDBCompositeKey(tenantID, UInt64(timestamp), eventID)
+///     try db.put(payload, forKey: key)
+public protocol RocksDBKeyEncodable {
+  /// Length of the encoded key in bytes
+  var encodedKeyLength: Int { get }
+
+  /// Write the encoded key into `buffer`, which holds `encodedKeyLength` bytes
+  func encodeKey(into buffer: UnsafeMutableRawBufferPointer)
+
+  /// Call `body` with the encoded key; the bytes are only valid inside `body`
+  func withEncodedKey<R>(_ body: (UnsafeRawBufferPointer) throws -> R) rethrows -> R
+}
+
+extension RocksDBKeyEncodable {
+  public func withEncodedKey<R>(_ body: (UnsafeRawBufferPointer) throws -> R) rethrows -> R {
+    try withUnsafeTemporaryAllocation(byteCount: encodedKeyLength, alignment: 1) { buffer in
+      encodeKey(into: buffer)
+      return try body(UnsafeRawBufferPointer(buffer))
+    }
+  }
+
+  /// Encoded key as `Data`, for APIs that only take `Data` keys
+  public var encodedKey: Data {
+    withEncodedKey { Data($0) }
+  }
+}
+
+// MARK: - Integers
+
+extension RocksDBKeyEncodable where Self: FixedWidthInteger {
+  public var encodedKeyLength: Int {
+    MemoryLayout<Self>.size
+  }
+
+  public func encodeKey(into buffer: UnsafeMutableRawBufferPointer) {
+    buffer.storeBytes(of: orderPreservingBigEndian, as: Self.self)
+  }
+
+  public func withEncodedKey<R>(_ body: (UnsafeRawBufferPointer) throws -> R) rethrows -> R {
+    try withUnsafeBytes(of: orderPreservingBigEndian, body)
+  }
+
+  /// Big-endian bytes with the sign bit flipped (`min` is zero for unsigned types)
+  private var orderPreservingBigEndian: Self {
+    (self ^ Self.min).bigEndian
+  }
+}
+
+extension UInt8: RocksDBKeyEncodable {}
+extension UInt16: RocksDBKeyEncodable {}
+extension UInt32: RocksDBKeyEncodable {}
+extension UInt64: RocksDBKeyEncodable {}
+extension UInt: RocksDBKeyEncodable {}
+extension Int8: RocksDBKeyEncodable {}
+extension Int16: RocksDBKeyEncodable {}
+extension Int32: RocksDBKeyEncodable {}
+extension Int64: RocksDBKeyEncodable {}
+extension Int: RocksDBKeyEncodable {}
+
+// MARK: - UUID
+
+extension UUID: RocksDBKeyEncodable {
+  public var encodedKeyLength: Int {
+    16
+  }
+
+  public func encodeKey(into buffer: UnsafeMutableRawBufferPointer) {
+    withUnsafeBytes(of: uuid) { buffer.copyMemory(from: $0) }
+  }
+
+  /// Raw 16 bytes, which sort by creation time for version 7 UUIDs only
+  public func withEncodedKey<R>(_ body: (UnsafeRawBufferPointer) throws -> R) rethrows -> R {
+    try withUnsafeBytes(of: uuid, body)
+  }
+}
+
+// MARK: - Composite Keys
+
+/// Tuple of typed keys encoded back to back
+///
+/// Swift tuples cannot conform to protocols, so this variadic wrapper
+/// stands in for them. Keys sort by the first part, then the second, and so
+/// on; every built-in part has a fixed width, so the parts never run into
+/// each other.
+public struct RocksDBCompositeKey<each Part: RocksDBKeyEncodable>: RocksDBKeyEncodable {
+  /// Parts in encoding order
+  public let parts: (repeat each Part)
+
+  public init(_ parts: repeat each Part) {
+    self.parts = (repeat each parts)
+  }
+
+  public var encodedKeyLength: Int {
+    var length = 0
+    for part in repeat each parts {
+      length += part.encodedKeyLength
+    }
+    return length
+  }
+
+  public func encodeKey(into buffer: UnsafeMutableRawBufferPointer) {
+    var offset = 0
+    for part in repeat each parts {
+      let length = part.encodedKeyLength
+      part.encodeKey(into: UnsafeMutableRawBufferPointer(rebasing: buffer[offset..<offset + length]))
+      offset += length
+    }
+  }
+}
+
+// MARK: - Strings
+
+extension String {
+  /// Call `body` with the UTF-8 bytes of the string
+  ///
+  /// Native Swift strings are already contiguous UTF-8, so their storage is
+  /// passed as is; only bridged or lazily decoded strings are copied once.
+  internal func withUTF8Bytes<R>(_ body: (UnsafeRawBufferPointer) throws -> R) rethrows -> R {
+    var string = self
+    return try string.withUTF8 { try body(UnsafeRawBufferPointer($0)) }
+  }
+
+  /// Decode a string straight from a native buffer, nil if it is not valid UTF-8
+  internal init?(validatingUTF8Bytes bytes: UnsafeRawBufferPointer) {
+    if #available(macOS 15, *) {
+      self.init(validating: bytes, as: UTF8.self)
+    } else {
+      var decoder = UTF8()
+      var iterator = bytes.makeIterator()
+      decoding: while true {
+        switch decoder.decode(&iterator) {
+        case .scalarValue: continue
+        case .emptyInput: break decoding
+        case .error: return nil
+        }
+      }
+      self.init(decoding: bytes, as: UTF8.self)
+    }
+  }
+}
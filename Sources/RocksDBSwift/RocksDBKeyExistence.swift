@@ -0,0 +1,38 @@
+//
+//  RocksDBKeyExistence.swift
+//  RocksDB.swift
+//
+//  Result of an existence check that may already have the value
+//
+
+import Foundation
+
+/// What `RocksDB.keyExistence(_:in:options:)` learned without doing I/O
+///
+/// The check consults bloom filters, memtables and the block cache only.
+/// `absent` is definite; `present` carries the value found on the way, so
+/// no second lookup is needed; `maybePresent` means the filters could not
+/// rule the key out and only a `get` can tell.
+public enum RocksDBKeyExistence<Value> {
+  /// Key definitely does not exist
+  case absent
+  /// Key may exist; its value was not in memory
+  case maybePresent
+  /// Key exists with this value
+  case present(Value)
+
+  /// Whether the key may exist
+  public var mayExist: Bool {
+    if case .absent = self { return false }
+    return true
+  }
+
+  /// Value, when the check found it
+  public var value: Value? {
+    if case .present(let value) = self { return value }
+    return nil
+  }
+}
+
+extension RocksDBKeyExistence: Sendable where Value: Sendable {}
+extension RocksDBKeyExistence: Equatable where Value: Equatable {}
@@ -0,0 +1,123 @@
+//
+//  RocksDBKeyRange.swift
+//  RocksDB.swift
+//
+//  Half-open key range used to bound scans
+//
+
+import Foundation
+import CRocksDB
+
+/// Half-open range of keys `[start, end)` in byte order
+public struct RocksDBKeyRange: Sendable, Equatable {
+  /// Inclusive start key (nil for the beginning of the keyspace)
+  public var start: Data?
+
+  /// Exclusive end key (nil for the end of the keyspace)
+  public var end: Data?
+
+  public init(start: Data? = nil, end: Data? = nil) {
+    self.start = start
+    self.end = end
+  }
+
+  /// Range covering every key in the database
+  public static var all: RocksDBKeyRange {
+    RocksDBKeyRange()
+  }
+
+  /// Range covering exactly the keys that begin with prefix
+  public static func prefix(_ prefix: Data) -> RocksDBKeyRange {
+    RocksDBKeyRange(start: prefix, end: prefixSuccessor(prefix))
+  }
+
+  /// Whether key falls inside the range
+  public func contains(_ key: Data) -> Bool {
+    if let start = start, key.lexicographicallyPrecedes(start) {
+      return false
+    }
+    if let end = end, !key.lexicographicallyPrecedes(end) {
+      return false
+    }
+    return true
+  }
+
+  /// Smallest key greater than every key with the given prefix, or nil if
+  /// the prefix is empty or consists only of 0xFF bytes
+  internal static func prefixSuccessor(_ prefix: Data) -> Data? {
+    var bytes = [UInt8](prefix)
+    while let last = bytes.last {
+      if last < 0xFF {
+        bytes[bytes.count - 1] = last + 1
+        return Data(bytes)
+      }
+      bytes.removeLast()
+    }
+    return nil
+  }
+}
+
+/// What `RocksDB.approximateSizes(of:in:options:)` counts
+public struct RocksDBSizeApproximation: Sendable, Equatable {
+  /// Count data still in memtables, so ranges written since the last flush
+  /// are not underestimated
+  public var includeMemtables: Bool
+
+  /// Count data in SST files
+  public var includeFiles: Bool
+
+  /// Error tolerated on the file part, as a fraction of the range's size;
+  /// files near the bounds are then counted without reading their index.
+  /// Negative for RocksDB's exact per-file estimate
+  public var filesSizeErrorMargin: Double
+
+  public init(includeMemtables: Bool = true, includeFiles: Bool = true,
+              filesSizeErrorMargin: Double = -1) {
+    self.includeMemtables = includeMemtables
+    self.includeFiles = includeFiles
+    self.filesSizeErrorMargin = filesSizeErrorMargin
+  }
+
+  /// Memtables and files, exact per-file estimate
+  public static var `default`: RocksDBSizeApproximation {
+    RocksDBSizeApproximation()
+  }
+
+  internal var native: RocksDBSizeApproximationOptions {
+    RocksDBSizeApproximationOptions(include_memtables: includeMemtables ? 1 : 0,
+                                    include_files: includeFiles ? 1 : 0,
+                                    files_size_error_margin: filesSizeErrorMargin)
+  }
+}
+
+extension Array where Element == RocksDBKeyRange {
+  /// Call `body` with the start and end of every range, back to back; nil
+  /// bounds become NULL pointers and empty keys non-NULL ones
+  internal func withPackedBounds<R>(
+    _ body: ([UnsafePointer<CChar>?], [Int]) throws -> R
+  ) rethrows -> R {
+    var buffer = Data()
+    var bounds: [(offset: Int, length: Int)?] = []
+    bounds.reserveCapacity(2 * count)
+    for range in self {
+      for bound in [range.start, range.end] {
+        if let key = bound {
+          bounds.append((offset: buffer.count, length: key.count))
+          buffer.append(key)
+        } else {
+          bounds.append(nil)
+        }
+      }
+    }
+    // Guarantees a base address even when every key is empty
+    buffer.append(0)
+
+    return try buffer.withUnsafeBytes { raw in
+      let base = raw.baseAddress!.assumingMemoryBound(to: CChar.self)
+      let pointers: [UnsafePointer<CChar>?] = bounds.map { bound in
+        bound.map { UnsafePointer(base + $0.offset) }
+      }
+      return try body(pointers, bounds.map { $0?.length ?? 0 })
+    }
+  }
+}
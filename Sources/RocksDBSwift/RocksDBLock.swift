@@ -0,0 +1,45 @@
+//
+//  RocksDBLock.swift
+//  RocksDB.swift
+//
+//  Reader/writer lock guarding native handle lifetime
+//
+
+import Foundation
+
+/// Reader/writer lock used to guard a native handle's lifetime.
+///
+/// Operations that only use the handle take the read side and run
+/// concurrently; `close()` takes the write side and waits for in-flight
+/// operations to finish before the handle is destroyed. Read locks must not
+/// be taken recursively.
+internal final class ReadWriteLock: @unchecked Sendable {
+  private let rwlock: UnsafeMutablePointer<pthread_rwlock_t>
+
+  init() {
+    rwlock = UnsafeMutablePointer<pthread_rwlock_t>.allocate(capacity: 1)
+    rwlock.initialize(to: pthread_rwlock_t())
+    let result = pthread_rwlock_init(rwlock, nil)
+    precondition(result == 0, "pthread_rwlock_init failed: \(result)")
+  }
+
+  deinit {
+    pthread_rwlock_destroy(rwlock)
+    rwlock.deinitialize(count: 1)
+    rwlock.deallocate()
+  }
+
+  /// Run body while holding the shared (read) side of the lock
+  func withReadLock<R>(_ body: () throws -> R) rethrows -> R {
+    pthread_rwlock_rdlock(rwlock)
+    defer { pthread_rwlock_unlock(rwlock) }
+    return try body()
+  }
+
+  /// Run body while holding the exclusive (write) side of the lock
+  func withWriteLock<R>(_ body: () throws -> R) rethrows -> R {
+    pthread_rwlock_wrlock(rwlock)
+    defer { pthread_rwlock_unlock(rwlock) }
+    return try body()
+  }
+}
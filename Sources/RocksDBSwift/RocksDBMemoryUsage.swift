@@ -0,0 +1,46 @@
+//
+//  RocksDBMemoryUsage.swift
+//  RocksDB.swift
+//
+//  Approximate memory held by databases and their caches
+//
+
+import Foundation
+import CRocksDB
+
+/// Where the memory of a set of databases and caches goes
+///
+/// Returned by `RocksDB.approximateMemoryUsage(of:caches:)`. Memtables and
+/// table readers are summed over every database; caches are counted once
+/// each however many databases share them, so one report over all open
+/// instances gives the process-wide RocksDB footprint. Memory charged to a
+/// cache by a write buffer manager or `cacheIndexAndFilterBlocks` shows up
+/// in `cacheTotal`, not in `memtableTotal` or `tableReaders`.
+public struct RocksDBMemoryUsage: Sendable, Equatable {
+  /// All memtables, including flushed ones still pinned by iterators
+  public var memtableTotal: UInt64
+  /// Active and immutable memtables not flushed yet
+  public var memtableUnflushed: UInt64
+  /// Index and filter blocks held by table readers outside the block cache
+  public var tableReaders: UInt64
+  /// Usage of every distinct cache
+  public var cacheTotal: UInt64
+  /// Part of `cacheTotal` pinned by readers, which cannot be evicted
+  public var cachePinned: UInt64
+  /// Combined capacity of every distinct cache
+  public var cacheCapacity: UInt64
+
+  /// Sum of memtable, table reader and cache usage
+  public var total: UInt64 {
+    memtableTotal + tableReaders + cacheTotal
+  }
+
+  internal init(_ values: RocksDBMemoryUsageValues) {
+    memtableTotal = values.memtable_total
+    memtableUnflushed = values.memtable_unflushed
+    tableReaders = values.table_readers
+    cacheTotal = values.cache_total
+    cachePinned = values.cache_pinned
+    cacheCapacity = values.cache_capacity
+  }
+}
@@ -0,0 +1,121 @@
+//
+//  RocksDBMutableOptions.swift
+//  RocksDB.swift
+//
+//  Options that can change while the database is open
+//
+
+import Foundation
+import CRocksDB
+
+/// Column family options `RocksDB.setOptions(_:for:)` can change at runtime
+///
+/// Only non-nil fields are changed. New memtable sizes apply from the next
+/// memtable; compaction settings from the next compaction picked.
+public struct RocksDBMutableColumnFamilyOptions: Sendable {
+  public var writeBufferSize: Int?
+  public var maxWriteBufferNumber: Int?
+  public var level0FileNumCompactionTrigger: Int?
+  public var level0SlowdownWritesTrigger: Int?
+  public var level0StopWritesTrigger: Int?
+  public var targetFileSizeBase: UInt64?
+  public var maxBytesForLevelBase: UInt64?
+  public var maxBytesForLevelMultiplier: Double?
+  public var periodicCompactionSeconds: UInt64?
+  public var ttl: UInt64?
+  public var lastLevelTemperature: RocksDBTemperature?
+  public var softPendingCompactionBytesLimit: UInt64?
+  public var hardPendingCompactionBytesLimit: UInt64?
+  public var disableAutoCompactions: Bool?
+  public var compression: RocksDBCompression?
+  public var memtablePrefixBloomSizeRatio: Double?
+  public var memtableWholeKeyFiltering: Bool?
+  public var memtableHugePageSize: Int?
+  public var enableBlobFiles: Bool?
+  public var minBlobSize: UInt64?
+  public var enableBlobGarbageCollection: Bool?
+
+  public init() {}
+
+  /// Changes as OPTIONS file names and values
+  internal var values: [String: String] {
+    var values: [String: String] = [:]
+    values["write_buffer_size"] = writeBufferSize.map(String.init)
+    values["max_write_buffer_number"] = maxWriteBufferNumber.map(String.init)
+    values["level0_file_num_compaction_trigger"] = level0FileNumCompactionTrigger.map(String.init)
+    values["level0_slowdown_writes_trigger"] = level0SlowdownWritesTrigger.map(String.init)
+    values["level0_stop_writes_trigger"] = level0StopWritesTrigger.map(String.init)
+    values["target_file_size_base"] = targetFileSizeBase.map(String.init)
+    values["max_bytes_for_level_base"] = maxBytesForLevelBase.map(String.init)
+    values["max_bytes_for_level_multiplier"] = maxBytesForLevelMultiplier.map { String($0) }
+    values["periodic_compaction_seconds"] = periodicCompactionSeconds.map(String.init)
+    values["ttl"] = ttl.map(String.init)
+    values["last_level_temperature"] = lastLevelTemperature?.optionName
+    values["soft_pending_compaction_bytes_limit"] = softPendingCompactionBytesLimit.map(String.init)
+    values["hard_pending_compaction_bytes_limit"] = hardPendingCompactionBytesLimit.map(String.init)
+    values["disable_auto_compactions"] = disableAutoCompactions.map(String.init)
+    values["compression"] = compression?.optionName
+    values["memtable_prefix_bloom_size_ratio"] = memtablePrefixBloomSizeRatio.map { String($0) }
+    values["memtable_whole_key_filtering"] = memtableWholeKeyFiltering.map(String.init)
+    values["memtable_huge_page_size"] = memtableHugePageSize.map(String.init)
+    values["enable_blob_files"] = enableBlobFiles.map(String.init)
+    values["min_blob_size"] = minBlobSize.map(String.init)
+    values["enable_blob_garbage_collection"] = enableBlobGarbageCollection.map(String.init)
+    return values
+  }
+}
+
+/// Database-wide options `RocksDB.setDBOptions(_:)` can change at runtime
+///
+/// Only non-nil fields are changed. Background job limits resize the
+/// scheduling budget immediately; running jobs are not interrupted. For
+/// compaction throughput, adjust `RocksDBRateLimiter.bytesPerSecond` as well.
+public struct RocksDBMutableDBOptions: Sendable {
+  public var maxBackgroundJobs: Int?
+  public var maxBackgroundCompactions: Int?
+  public var maxSubcompactions: Int?
+  public var maxOpenFiles: Int?
+  public var maxTotalWALSize: UInt64?
+  public var bytesPerSync: UInt64?
+  public var walBytesPerSync: UInt64?
+  /// Write rate in bytes per second once writes are delayed
+  public var delayedWriteRate: UInt64?
+  /// Readahead size for compaction inputs in bytes
+  public var compactionReadaheadSize: Int?
+  /// Interval of statistics dumps to the info log in seconds (0 to disable)
+  public var statsDumpPeriodSeconds: Int?
+
+  public init() {}
+
+  /// Changes as OPTIONS file names and values
+  internal var values: [String: String] {
+    var values: [String: String] = [:]
+    values["max_background_jobs"] = maxBackgroundJobs.map(String.init)
+    values["max_background_compactions"] = maxBackgroundCompactions.map(String.init)
+    values["max_subcompactions"] = maxSubcompactions.map(String.init)
+    values["max_open_files"] = maxOpenFiles.map(String.init)
+    values["max_total_wal_size"] = maxTotalWALSize.map(String.init)
+    values["bytes_per_sync"] = bytesPerSync.map(String.init)
+    values["wal_bytes_per_sync"] = walBytesPerSync.map(String.init)
+    values["delayed_write_rate"] = delayedWriteRate.map(String.init)
+    values["compaction_readahead_size"] = compactionReadaheadSize.map(String.init)
+    values["stats_dump_period_sec"] = statsDumpPeriodSeconds.map(String.init)
+    return values
+  }
+}
+
+extension RocksDBCompression {
+  /// Name used in options strings and OPTIONS files
+  internal var optionName: String {
+    switch self {
+    case .none: return "kNoCompression"
+    case .snappy: return "kSnappyCompression"
+    case .zlib: return "kZlibCompression"
+    case .bz2: return "kBZip2Compression"
+    case .lz4: return "kLZ4Compression"
+    case .lz4hc: return "kLZ4HCCompression"
+    case .xpress: return "kXpressCompression"
+    case .zstd: return "kZSTD"
+    }
+  }
+}
@@ -0,0 +1,36 @@
+//
+//  RocksDBOccLockBuckets.swift
+//  RocksDB.swift
+//
+//  Shared validation locks for optimistic transaction databases
+//
+
+import Foundation
+import CRocksDB
+
+/// Pool of striped mutexes used to validate optimistic commits in parallel
+///
+/// Assign the same pool to `RocksDBTransactionDBOptions.sharedLockBuckets`
+/// of several databases to bound the memory their validation locks use.
+/// Each database keeps the native pool alive for as long as it is open.
+public final class RocksDBOccLockBuckets: @unchecked Sendable {
+  internal let handle: RocksDBOccLockBucketsRef
+
+  /// Number of mutexes in the pool
+  public let bucketCount: Int
+
+  /// Create a lock bucket pool
+  /// - Parameters:
+  ///   - bucketCount: Number of mutexes; more reduce contention between
+  ///     commits touching unrelated keys
+  ///   - cacheAligned: Pad each mutex to a cache line, trading memory for
+  ///     less false sharing between cores
+  public init(bucketCount: Int, cacheAligned: Bool = false) {
+    self.handle = rocksdb_occ_lock_buckets_create(bucketCount, cacheAligned ? 1 : 0)!
+    self.bucketCount = bucketCount
+  }
+
+  deinit {
+    rocksdb_occ_lock_buckets_destroy(handle)
+  }
+}
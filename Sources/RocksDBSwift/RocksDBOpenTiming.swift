@@ -0,0 +1,38 @@
+//
+//  RocksDBOpenTiming.swift
+//  RocksDB.swift
+//
+//  Breakdown of database open time
+//
+
+import Foundation
+import CRocksDB
+
+/// Where the time of `RocksDB.openTimed(at:options:)` went
+///
+/// Long opens usually come from opening tens of thousands of table files
+/// (raise `maxFileOpeningThreads`, set `skipStatsUpdateOnDBOpen`) or from
+/// replaying large WALs (flush before shutdown, lower `maxTotalWALSize`).
+public struct RocksDBOpenTiming: Sendable, Equatable {
+  /// Wall time of the whole open
+  public var total: TimeInterval
+  /// Reading the MANIFEST, up to the first table file opened
+  public var manifestRecovery: TimeInterval
+  /// Opening table files (index, filter and properties blocks)
+  public var tableOpening: TimeInterval
+  /// Replaying WAL files into memtables, including the recovery flush
+  public var walReplay: TimeInterval
+  /// Table files opened before WAL replay
+  public var tablesOpened: Int
+  /// WAL files replayed
+  public var walFilesReplayed: Int
+
+  internal init(_ values: RocksDBOpenTimingValues) {
+    total = TimeInterval(values.total_nanos) / 1_000_000_000
+    manifestRecovery = TimeInterval(values.manifest_recovery_nanos) / 1_000_000_000
+    tableOpening = TimeInterval(values.table_opening_nanos) / 1_000_000_000
+    walReplay = TimeInterval(values.wal_replay_nanos) / 1_000_000_000
+    tablesOpened = Int(values.tables_opened)
+    walFilesReplayed = Int(values.wal_files_replayed)
+  }
+}
@@ -22,6 +22,177 @@ public enum RocksDBCompression: Int32, Sendable {
   case zstd = 7
 }
 
+// MARK: - Compression Options
+
+/// Tuning of a compression algorithm
+public struct RocksDBCompressionOptions: Sendable, Equatable {
+  /// Algorithm-specific level, nil for the algorithm's default (default: nil)
+  public var level: Int? = nil
+
+  /// Dictionary size in bytes, 0 to disable dictionary compression (default: 0)
+  ///
+  /// A dictionary sampled from each file's first blocks lets small blocks
+  /// compress like large ones; 16 KB is a common choice.
+  public var maxDictBytes: Int = 0
+
+  /// Bytes of samples to train a zstd dictionary from, 0 to use the raw
+  /// samples as the dictionary (default: 0)
+  ///
+  /// Training usually needs about 100x `maxDictBytes`.
+  public var zstdMaxTrainBytes: Int = 0
+
+  /// Threads compressing one file's blocks in parallel (default: 1)
+  public var parallelThreads: Int = 1
+
+  /// Cap on data buffered to build the dictionary, 0 for unlimited (default: 0)
+  public var maxDictBufferBytes: Int = 0
+
+  /// Train zstd dictionaries with `ZDICT_trainFromBuffer` rather than the
+  /// faster finalizer (default: true)
+  public var useZstdDictTrainer: Bool = true
+
+  public init() {}
+
+  /// Zstd dictionary compression with a trained 16 KB dictionary
+  public static var zstdDictionary: RocksDBCompressionOptions {
+    var opts = RocksDBCompressionOptions()
+    opts.maxDictBytes = 16 * 1024
+    opts.zstdMaxTrainBytes = 100 * 16 * 1024
+    return opts
+  }
+
+  /// Apply to the primary (bottommost false) or bottommost options of a handle
+  internal func apply(to opts: RocksDBOptionsRef, bottommost: Bool) {
+    rocksdb_options_set_compression_options(
+      opts, bottommost ? 1 : 0, Int32(level ?? 32767), UInt32(maxDictBytes), UInt32(zstdMaxTrainBytes),
+      UInt32(max(parallelThreads, 1)), UInt64(maxDictBufferBytes), useZstdDictTrainer ? 1 : 0)
+  }
+}
+
+// MARK: - Prefix Extractor
+
+/// Key prefix transform used for prefix bloom filters and prefix seeks
+public enum RocksDBPrefixExtractor: Sendable, Equatable {
+  /// First `length` bytes of each key (keys shorter than length are out of domain)
+  case fixed(Int)
+  /// First `length` bytes of each key, or the whole key if it is shorter
+  case capped(Int)
+}
+
+// MARK: - Memtable Representation
+
+/// In-memory structure that buffers writes until a flush
+///
+/// All but the skiplist need exclusive memtable writes and turn
+/// `allowConcurrentMemtableWrite` off.
+public enum RocksDBMemtableRep: Sendable, Equatable {
+  /// Sorted skiplist (default); `lookahead` lets iterators probe nearby
+  /// nodes before a full search, for mostly sequential seeks
+  case skipList(lookahead: Int)
+  /// Unsorted vector, sorted once when read or flushed
+  ///
+  /// Much cheaper inserts for loads that do not read until they finish;
+  /// any read or iterator during the load sorts the whole memtable.
+  case vector(reserve: Int)
+  /// Hash table of skiplists keyed by prefix (requires a prefix extractor)
+  ///
+  /// Prefix seeks only search one bucket; total-order iteration is slow.
+  /// RocksDB's defaults are 1,000,000 buckets, height 4 and branching factor 4.
+  case hashSkipList(bucketCount: Int, height: Int, branchingFactor: Int)
+  /// Hash table of sorted linked lists keyed by prefix (requires a prefix
+  /// extractor), for few keys per prefix; RocksDB's default is 50,000 buckets
+  case hashLinkList(bucketCount: Int)
+}
+
+// MARK: - Comparator
+
+/// Key ordering of a database or column family
+///
+/// The comparator is persisted with the data: reopening with a different
+/// one fails, so it cannot be changed after the first open.
+public enum RocksDBComparator: Int32, Sendable {
+  /// Lexicographic byte order
+  case bytewise = 0
+  /// Bytewise order with a `UInt64` user timestamp attached to every write
+  ///
+  /// Enables multi-version reads by timestamp (`put(_:forKey:timestamp:)`,
+  /// `get(_:asOf:)`) without holding snapshots. Every read must carry a
+  /// timestamp, either through `get(_:asOf:)` or `RocksDBReadOptions.timestamp`.
+  case bytewiseWithU64Timestamp = 1
+  /// Descending byte order, so "latest first" scans use `seekToFirst` and `next`
+  ///
+  /// Forward iteration is considerably faster than `prev()` in RocksDB.
+  /// Iterator bounds follow the comparator: the lower bound is the
+  /// bytewise-largest key of the range.
+  case reverseBytewise = 2
+  /// First 8 bytes as a big-endian `UInt64` in descending order, remaining
+  /// bytes ascending
+  ///
+  /// For keys prefixed with a timestamp or sequence number: the newest
+  /// prefix sorts first while entries sharing a prefix keep bytewise order.
+  case descendingUInt64Prefix = 3
+}
+
+// MARK: - Merge Operator
+
+/// Built-in merge operators, executed natively inside RocksDB
+public enum RocksDBMergeOperator: Sendable, Equatable {
+  /// Adds 8-byte little-endian unsigned integers (see `encodeUInt64`)
+  case uint64Add
+  /// Appends each operand to the existing value, separated by delimiter
+  case stringAppend(delimiter: String)
+  /// Keeps the bytewise-largest value
+  case max
+
+  /// Encode a value in the format used by `uint64Add`
+  public static func encodeUInt64(_ value: UInt64) -> Data {
+    withUnsafeBytes(of: value.littleEndian) { Data($0) }
+  }
+
+  /// Decode a value written by `uint64Add`, nil if it is not 8 bytes long
+  public static func decodeUInt64(_ data: Data) -> UInt64? {
+    guard data.count == MemoryLayout<UInt64>.size else { return nil }
+    var value: UInt64 = 0
+    withUnsafeMutableBytes(of: &value) { _ = data.copyBytes(to: $0) }
+    return UInt64(littleEndian: value)
+  }
+}
+
+// MARK: - WAL Recovery
+
+/// How WAL replay at open treats corrupted records
+public enum RocksDBWALRecoveryMode: Int32, Sendable {
+  /// Tolerate an incomplete last record in any WAL, fail on other corruption
+  case tolerateCorruptedTailRecords = 0
+  /// Fail on any corruption
+  case absoluteConsistency = 1
+  /// Stop replay at the first corruption, recovering to a consistent point
+  case pointInTime = 2
+  /// Skip corrupted records and keep replaying; may lose acknowledged writes
+  case skipAnyCorruptedRecords = 3
+}
+
+/// Records to leave out of WAL replay at open
+///
+/// A replayed record is a whole write batch: it is skipped only when every
+/// put, delete and merge in it has a key with one of `skipKeyPrefixes`, so
+/// data written apart (such as expiring cache entries) is dropped without
+/// touching batches that mix it with data to keep. Skipped writes and
+/// everything past `stopAfterSequence` are lost for good, as if never made.
+public struct RocksDBWALFilter: Sendable, Equatable {
+  /// Key prefixes of writes not worth recovering
+  public var skipKeyPrefixes: [Data]
+
+  /// Stop replay at the first batch past this sequence number (nil for no
+  /// limit; 0 replays nothing)
+  public var stopAfterSequence: UInt64?
+
+  public init(skipKeyPrefixes: [Data] = [], stopAfterSequence: UInt64? = nil) {
+    self.skipKeyPrefixes = skipKeyPrefixes
+    self.stopAfterSequence = stopAfterSequence
+  }
+}
+
 // MARK: - Database Options
 
 /// Configuration options for opening a RocksDB database
@@ -32,12 +203,33 @@ public struct RocksDBOptions: Sendable {
   /// Error if database already exists (default: false)
   public var errorIfExists: Bool = false
 
+  /// Create column families passed to `open(at:options:columnFamilies:)` that don't exist yet (default: true)
+  public var createMissingColumnFamilies: Bool = true
+
   /// Enable paranoid checks (default: false)
   public var paranoidChecks: Bool = false
 
   /// Compression algorithm (default: lz4)
   public var compression: RocksDBCompression = .lz4
 
+  /// Compression of each level from L0 down, overriding `compression`
+  /// (default: empty); levels past the end use the last entry
+  ///
+  /// A common setup keeps L0 and L1 uncompressed or on LZ4, where data is
+  /// short-lived, and compresses lower levels harder.
+  public var compressionPerLevel: [RocksDBCompression] = []
+
+  /// Compression of the bottommost level, which holds most of the data
+  /// (default: nil, same as its level)
+  public var bottommostCompression: RocksDBCompression? = nil
+
+  /// Tuning of `compression` and `compressionPerLevel` (default: algorithm defaults)
+  public var compressionOptions = RocksDBCompressionOptions()
+
+  /// Tuning of `bottommostCompression`, e.g. `.zstdDictionary`
+  /// (default: nil, same as `compressionOptions`)
+  public var bottommostCompressionOptions: RocksDBCompressionOptions? = nil
+
   /// Write buffer size in bytes (default: 64MB)
   public var writeBufferSize: Int = 64 * 1024 * 1024
 
@@ -53,6 +245,17 @@ public struct RocksDBOptions: Sendable {
   /// Maximum background flush threads (default: 1)
   public var maxBackgroundFlushes: Int = 1
 
+  /// Combined limit on concurrent flushes and compactions (nil to use the
+  /// separate limits above)
+  ///
+  /// When set, `maxBackgroundCompactions` and `maxBackgroundFlushes` are
+  /// ignored and RocksDB gives roughly a quarter of the jobs to flushes.
+  /// Size the `RocksDBEnvironment` thread pools to match.
+  public var maxBackgroundJobs: Int? = nil
+
+  /// Threads a single compaction may be split into (default: 1)
+  public var maxSubcompactions: Int = 1
+
   /// Level-0 file number compaction trigger (default: 4)
   public var level0FileNumCompactionTrigger: Int = 4
 
@@ -68,15 +271,292 @@ public struct RocksDBOptions: Sendable {
   /// Max bytes for level base (default: 256MB)
   public var maxBytesForLevelBase: UInt64 = 256 * 1024 * 1024
 
+  /// Size levels from the bottom up, deriving each level's target from the
+  /// size of the last one (default: true)
+  ///
+  /// Keeps space amplification near 1.1x whatever the database size, where
+  /// fixed targets from `maxBytesForLevelBase` leave the upper levels
+  /// oversized while the database is small and too few levels once it is
+  /// large. `maxBytesForLevelBase` then only bounds the first non-empty level.
+  public var levelCompactionDynamicLevelBytes: Bool = true
+
+  /// Size ratio between adjacent levels (default: 10)
+  public var maxBytesForLevelMultiplier: Double = 10
+
+  /// Order leveled compaction picks files in (default: minOverlappingRatio)
+  public var compactionPriority: RocksDBCompactionPriority = .minOverlappingRatio
+
+  /// Rewrite files older than this many seconds so compaction filters and
+  /// format upgrades reach cold data; 0 to disable (default: nil, RocksDB's
+  /// choice of 30 days when a compaction filter is set)
+  public var periodicCompactionSeconds: UInt64? = nil
+
+  /// Compact files whose newest data is older than this many seconds
+  /// towards the bottom level, so deletes reclaim space; 0 to disable
+  /// (default: nil, RocksDB's choice of 30 days)
+  ///
+  /// Ignored with `.fifo` compaction, which uses its own `ttl`.
+  public var ttl: UInt64? = nil
+
+  /// Compact SST files dense with tombstones as soon as they are written
+  /// (default: nil, only when size targets ask for it)
+  public var compactOnDeletion: RocksDBCompactOnDeletion? = nil
+
+  /// Cut compaction output where the first this many key bytes change, so
+  /// every SST file holds one key prefix, e.g. one tenant (default: nil)
+  ///
+  /// `deleteFiles(in:of:)` over a prefix then frees all of its compacted
+  /// data at once and prefix scans open fewer files, at the cost of more,
+  /// smaller files when prefixes are small. Flushes are not partitioned.
+  public var sstPartitionerPrefixLength: Int? = nil
+
+  /// How SST files are merged over time (default: leveled)
+  ///
+  /// Cannot be changed on an existing database without a full compaction;
+  /// `targetFileSizeBase` and `maxBytesForLevelBase` only apply to `.level`.
+  public var compactionStyle: RocksDBCompactionStyle = .level
+
+  /// Directories SST files are spread over, e.g. a fast and a slow drive
+  /// (default: empty, the database directory)
+  ///
+  /// Compaction fills the paths in order up to each target size, so the
+  /// small upper levels stay on the first paths and the bottom levels land
+  /// on the last one, whose target size is ignored. Use `placeLevels` for
+  /// the common two-drive layout.
+  public var dbPaths: [RocksDBStoragePath] = []
+
+  /// Paths of the default column family, overriding `dbPaths` (default: empty)
+  public var columnFamilyPaths: [RocksDBStoragePath] = []
+
+  /// Temperature passed to the file system for last-level files
+  /// (default: unknown)
+  ///
+  /// Only honoured with `.universal` compaction, and only by file systems
+  /// that place files by temperature; the default one records it in file
+  /// metadata and I/O statistics.
+  public var lastLevelTemperature: RocksDBTemperature = .unknown
+
+  /// Keep data written within this many seconds out of the last level,
+  /// 0 to disable (default: 0)
+  ///
+  /// With `lastLevelTemperature`, recent data stays on the hot tier until it
+  /// ages; same compaction style requirement.
+  public var precludeLastLevelDataSeconds: UInt64 = 0
+
+  /// Memtable bloom filter size as a fraction of `writeBufferSize`, 0 to disable (default: 0)
+  ///
+  /// Lets lookups of keys absent from a memtable skip it after one probe
+  /// instead of a skiplist search. The filter holds prefixes when a prefix
+  /// extractor is set, and whole keys with `memtableWholeKeyFiltering`.
+  /// RocksDB caps the ratio at 0.25; 0.02 to 0.1 is typical.
+  public var memtablePrefixBloomSizeRatio: Double = 0
+
+  /// Add whole keys to the memtable bloom filter, for point lookups (default: false)
+  public var memtableWholeKeyFiltering: Bool = false
+
+  /// Allocate memtable arenas from huge pages of this size in bytes, 0 to disable (default: 0)
+  ///
+  /// Cuts TLB misses on large memtables. Needs huge pages reserved by the
+  /// OS (e.g. `vm.nr_hugepages`); RocksDB falls back to normal pages otherwise.
+  public var memtableHugePageSize: Int = 0
+
+  /// Store large values in blob files that compaction does not rewrite (default: false)
+  public var enableBlobFiles: Bool = false
+
+  /// Values at least this large go to blob files (default: 0, all values)
+  public var minBlobSize: UInt64 = 0
+
+  /// Target blob file size in bytes (default: 256MB)
+  public var blobFileSize: UInt64 = 256 * 1024 * 1024
+
+  /// Blob file compression (default: none)
+  public var blobCompression: RocksDBCompression = .none
+
+  /// Relocate live values out of old blob files during compaction (default: false)
+  public var enableBlobGarbageCollection: Bool = false
+
+  /// Fraction of the oldest blob files eligible for garbage collection (default: 0.25)
+  public var blobGarbageCollectionAgeCutoff: Double = 0.25
+
+  /// Cache for blob values; may be shared with the block cache (default: nil)
+  public var blobCache: RocksDBCache? = nil
+
+  /// Cache of whole rows read from SST files (default: nil)
+  ///
+  /// A `get` of a cached key costs one hash lookup after the memtables,
+  /// skipping filter, index and data block reads and the block decode, so
+  /// it pays off for skewed point-lookup traffic. Use an `.lru` cache, which
+  /// several databases may share; track it with `RocksDBTicker.rowCacheHit`
+  /// and `rowCacheMiss`. Iterators and `multiGet` do not use it, and
+  /// `deleteRange` throws notSupported while it is set.
+  public var rowCache: RocksDBCache? = nil
+
+  /// Buffer WAL writes in memory until `RocksDB.flushWAL(sync:)` (default: false)
+  ///
+  /// Lets applications batch WAL syncs themselves (e.g. every few milliseconds)
+  /// instead of paying an fsync per `sync` write.
+  public var manualWALFlush: Bool = false
+
+  /// Incrementally sync the WAL every this many bytes (default: 0, off)
+  public var walBytesPerSync: UInt64 = 0
+
+  /// Incrementally sync SST files every this many bytes (default: 0, off)
+  public var bytesPerSync: UInt64 = 0
+
+  /// Read SST files through mmap instead of `pread` (default: false)
+  ///
+  /// For databases that fit in RAM: with `tableOptions.noBlockCache`,
+  /// uncompressed blocks are read in place, and pinned gets return `Data`
+  /// pointing straight into the mapping. Incompatible with `useDirectReads`.
+  /// PlainTable and CuckooTable formats turn it on themselves.
+  public var allowMmapReads: Bool = false
+
+  /// Write SST files through mmap (default: false)
+  ///
+  /// Rarely faster than buffered writes; incompatible with
+  /// `useDirectIOForFlushAndCompaction`.
+  public var allowMmapWrites: Bool = false
+
+  /// Read SST files for gets and iterators with direct I/O, bypassing the
+  /// OS page cache (default: false)
+  ///
+  /// Blocks are then cached once, in the block cache, instead of twice;
+  /// size the block cache to take the memory the page cache used to. Open
+  /// fails on filesystems without O_DIRECT (e.g. tmpfs), so check with
+  /// `supportsDirectIO(at:)` or use `enableDirectIO(at:)`.
+  public var useDirectReads: Bool = false
+
+  /// Use direct I/O for flush and compaction, so background reads and
+  /// writes don't evict hot pages (default: false)
+  public var useDirectIOForFlushAndCompaction: Bool = false
+
+  /// Readahead size for compaction inputs in bytes (default: 2MB)
+  ///
+  /// With direct I/O the OS does no readahead, so keep this at 2MB or more.
+  public var compactionReadaheadSize: Int = 2 * 1024 * 1024
+
+  /// WAL record compression; only `.none` and `.zstd` are supported (default: none)
+  public var walCompression: RocksDBCompression = .none
+
+  /// Number of WAL files to keep for reuse instead of deleting (default: 0)
+  public var recycleLogFileNum: Int = 0
+
+  /// Flush column families holding the oldest WAL once total WAL size exceeds
+  /// this many bytes (default: 0, automatic)
+  public var maxTotalWALSize: UInt64 = 0
+
+  /// Keep obsolete WAL files archived for this many seconds, so
+  /// `RocksDB.updates(since:)` can still read them (default: 0, not archived)
+  public var walTTLSeconds: UInt64 = 0
+
+  /// Keep archived WAL files up to this many megabytes in total (default: 0, no limit)
+  public var walSizeLimitMB: UInt64 = 0
+
+  /// Treatment of corrupted WAL records at open (default: pointInTime)
+  public var walRecoveryMode: RocksDBWALRecoveryMode = .pointInTime
+
+  /// Records to leave out of WAL replay at open (default: nil, replay everything)
+  public var walFilter: RocksDBWALFilter? = nil
+
+  /// Let concurrent writers insert into the memtable in parallel (default: true)
+  public var allowConcurrentMemtableWrite: Bool = true
+
+  /// Pipeline WAL and memtable writes across write groups (default: false)
+  public var enablePipelinedWrite: Bool = false
+
+  /// Skip the memtable write ordering step for higher write throughput, at
+  /// the cost of snapshot immutability guarantees (default: false)
+  ///
+  /// Incompatible with `enablePipelinedWrite`.
+  public var unorderedWrite: Bool = false
+
+  /// Spin-then-yield while waiting for the write thread leader (default: true)
+  public var enableWriteThreadAdaptiveYield: Bool = true
+
+  /// Use a second write queue for WAL-only writes (default: false)
+  public var twoWriteQueues: Bool = false
+
+  /// Reserve the bottommost level for files ingested with `ingestBehind` (default: false)
+  public var allowIngestBehind: Bool = false
+
+  /// Threads opening table files at open when `maxOpenFiles` is -1 (default: 16)
+  public var maxFileOpeningThreads: Int = 16
+
+  /// Don't read every file's first block at open to refresh deletion
+  /// statistics (default: false)
+  ///
+  /// Saves a random read per table file at open, which dominates open time
+  /// for databases with tens of thousands of files. Compaction then weighs
+  /// deletions slightly less accurately until files are rewritten.
+  public var skipStatsUpdateOnDBOpen: Bool = false
+
+  /// Don't check every table file's size against the MANIFEST at open (default: false)
+  public var skipCheckingSSTFileSizesOnDBOpen: Bool = false
+
+  /// Keep recovered WAL data in memtables instead of flushing it at open (default: false)
+  public var avoidFlushDuringRecovery: Bool = false
+
+  /// Recover to the newest consistent state when files are missing or
+  /// corrupt, instead of failing to open (default: false)
+  ///
+  /// Data in the missing files is lost; incompatible with WAL recovery modes
+  /// other than point-in-time.
+  public var bestEffortsRecovery: Bool = false
+
+  /// Shared memtable memory budget (default: nil, per-database limits only)
+  public var writeBufferManager: RocksDBWriteBufferManager? = nil
+
+  /// Shared background I/O rate limiter (default: nil, unlimited)
+  public var rateLimiter: RocksDBRateLimiter? = nil
+
+  /// Shared SST file tracking, deletion pacing and space cap (default: nil)
+  public var sstFileManager: RocksDBSstFileManager? = nil
+
+  /// Listeners recording flush, compaction, stall and error events (default: none)
+  public var eventListeners: [RocksDBEventListener] = []
+
+  /// Built-in compaction filter rules (default: nil)
+  public var compactionFilter: RocksDBCompactionFilter? = nil
+
+  /// Scheduler that runs compactions on workers instead of this process
+  /// (default: nil, compactions run locally)
+  public var compactionService: (any RocksDBCompactionService)? = nil
+
   /// Enable statistics collection (default: false)
   public var enableStatistics: Bool = false
 
+  /// What the statistics object measures (default: all but detailed timers)
+  public var statisticsLevel: RocksDBStatsLevel = .exceptDetailedTimers
+
+  /// Track what background threads work on, for `RocksDBEnvironment.threadList()` (default: false)
+  public var enableThreadTracking: Bool = false
+
   /// Optimize for point lookups with given block cache size in MB
   public var optimizeForPointLookup: UInt64? = nil
 
   /// Optimize for level-style compaction with given memtable memory budget
   public var optimizeLevelStyleCompaction: UInt64? = nil
 
+  /// Prefix extractor for prefix bloom filters and prefix seeks (default: nil)
+  public var prefixExtractor: RocksDBPrefixExtractor? = nil
+
+  /// Memtable structure (default: skiplist)
+  public var memtableRep: RocksDBMemtableRep = .skipList(lookahead: 0)
+
+  /// Merge operator used by `merge` (default: nil)
+  public var mergeOperator: RocksDBMergeOperator? = nil
+
+  /// Key ordering; cannot change once the database exists (default: bytewise)
+  public var comparator: RocksDBComparator = .bytewise
+
+  /// Block-based table configuration (default: nil, RocksDB defaults)
+  ///
+  /// Replaces the table configuration installed by `optimizeForPointLookup`.
+  public var tableOptions: RocksDBTableOptions? = nil
+
+  /// SST file format (default: block-based, configured by `tableOptions`)
+  public var tableFormat: RocksDBTableFormat = .blockBased
+
   public init() {}
 
   /// Default options
@@ -91,9 +571,60 @@ public struct RocksDBOptions: Sendable {
     return opts
   }
 
+  /// Options for static, RAM-resident data opened with `openReadOnly`
+  ///
+  /// Reads SST files through mmap with open file handles unlimited, so
+  /// mappings stay in place. Block-based tables skip the block cache, which
+  /// would only copy blocks already in memory; write the data uncompressed
+  /// for reads to avoid decompression. Passing `.plain` or `.cuckoo` uses
+  /// that format instead, with its hash index.
+  /// - Parameter format: SST format the data was written with
+  public static func mmapReadOnly(format: RocksDBTableFormat = .blockBased) -> RocksDBOptions {
+    var opts = RocksDBOptions()
+    opts.createIfMissing = false
+    opts.allowMmapReads = true
+    opts.maxOpenFiles = -1
+    opts.compression = .none
+    opts.tableFormat = format
+    if case .blockBased = format {
+      var table = RocksDBTableOptions()
+      table.noBlockCache = true
+      opts.tableOptions = table
+    }
+    return opts
+  }
+
+  /// Options that shorten the open of databases with many table files
+  ///
+  /// Opens table files on 32 threads and skips the per-file stats read and
+  /// size check. Measure with `RocksDB.openTimed(at:options:)`.
+  public static var fastOpen: RocksDBOptions {
+    var opts = RocksDBOptions()
+    opts.maxOpenFiles = -1
+    opts.maxFileOpeningThreads = 32
+    opts.skipStatsUpdateOnDBOpen = true
+    opts.skipCheckingSSTFileSizesOnDBOpen = true
+    return opts
+  }
+
+  /// Options for instances opened with `RocksDB.openAsSecondary`
+  ///
+  /// Keeps every SST file open, so files the primary deletes stay readable
+  /// by the secondary until its next catch-up.
+  public static var secondary: RocksDBOptions {
+    var opts = RocksDBOptions()
+    opts.createIfMissing = false
+    opts.maxOpenFiles = -1
+    return opts
+  }
+
   /// Options optimized for bulk loading
+  ///
+  /// Uses the vector memtable, so reads during the load are slow; reopen
+  /// or switch presets once it finishes.
   public static var bulkLoad: RocksDBOptions {
     var opts = RocksDBOptions()
+    opts.memtableRep = .vector(reserve: 0)
     opts.writeBufferSize = 256 * 1024 * 1024
     opts.maxWriteBufferNumber = 6
     opts.level0FileNumCompactionTrigger = 8
@@ -102,29 +633,345 @@ public struct RocksDBOptions: Sendable {
     return opts
   }
 
+  /// Options for read-mostly workloads on NVMe SSDs
+  ///
+  /// Spends memory to avoid I/O on lookups: a 1 GB HyperClock block cache,
+  /// ribbon filters, partitioned index and filters in the cache with their
+  /// top levels and L0 blocks pinned, and a data block hash index. All file
+  /// handles stay open, since table opens cost more than NVMe reads.
+  public static var nvmeReadHeavy: RocksDBOptions {
+    var opts = RocksDBOptions()
+    opts.maxOpenFiles = -1
+    opts.maxBackgroundJobs = 4
+    var table = RocksDBTableOptions.partitionedPointLookup
+    table.blockCache = .hyperClock(capacity: 1024 * 1024 * 1024, estimatedEntryCharge: Int(table.blockSize))
+    opts.tableOptions = table
+    return opts
+  }
+
+  /// Options for ingest-heavy workloads on NVMe SSDs
+  ///
+  /// Larger memtables and level sizes cut write amplification, enough
+  /// background jobs and subcompactions keep L0 drained before writes
+  /// stall, and incremental syncs smooth out the device's write bursts.
+  /// Pipelined writes overlap WAL and memtable work across write groups.
+  public static var nvmeWriteHeavy: RocksDBOptions {
+    var opts = RocksDBOptions()
+    opts.writeBufferSize = 128 * 1024 * 1024
+    opts.maxWriteBufferNumber = 4
+    opts.maxBackgroundJobs = 8
+    opts.maxSubcompactions = 4
+    opts.level0FileNumCompactionTrigger = 4
+    opts.level0SlowdownWritesTrigger = 30
+    opts.level0StopWritesTrigger = 48
+    opts.targetFileSizeBase = 128 * 1024 * 1024
+    opts.maxBytesForLevelBase = 512 * 1024 * 1024
+    opts.bytesPerSync = 1024 * 1024
+    opts.walBytesPerSync = 1024 * 1024
+    opts.enablePipelinedWrite = true
+    return opts
+  }
+
+  /// Options that keep block cache and memtables within a memory budget
+  ///
+  /// Memtables are charged to the block cache through a write buffer
+  /// manager, so the two together stay near `budget`; index and filter
+  /// blocks are cached and partitioned instead of held outside the cache.
+  /// Table readers and iterators still use some memory beyond the budget.
+  /// - Parameter budget: Bytes for block cache and memtables together
+  public static func memoryConstrained(budget: Int) -> RocksDBOptions {
+    let budget = max(budget, 16 * 1024 * 1024)
+    let cache = RocksDBCache.lru(capacity: budget)
+
+    var opts = RocksDBOptions()
+    opts.writeBufferSize = min(max(budget / 16, 1024 * 1024), 64 * 1024 * 1024)
+    opts.maxWriteBufferNumber = 2
+    opts.maxOpenFiles = 256
+    opts.maxBackgroundJobs = 2
+    opts.writeBufferManager = RocksDBWriteBufferManager(bufferSize: budget / 4, cache: cache)
+
+    var table = RocksDBTableOptions()
+    table.blockCache = cache
+    table.filterPolicy = .ribbon(bitsPerKey: 10)
+    table.indexType = .twoLevelIndexSearch
+    table.partitionFilters = true
+    table.cacheIndexAndFilterBlocks = true
+    table.pinL0FilterAndIndexBlocksInCache = true
+    opts.tableOptions = table
+    return opts
+  }
+
+  /// Options for values of several kilobytes or more
+  ///
+  /// Values of 4 KB and up go to compressed blob files that compaction
+  /// does not rewrite; the LSM tree holds only keys and blob references.
+  /// Blob garbage collection relocates live values out of the oldest
+  /// quarter of blob files.
+  public static var largeValues: RocksDBOptions {
+    var opts = RocksDBOptions()
+    opts.enableBlobFiles = true
+    opts.minBlobSize = 4 * 1024
+    opts.blobCompression = .lz4
+    opts.enableBlobGarbageCollection = true
+    opts.blobGarbageCollectionAgeCutoff = 0.25
+    opts.writeBufferSize = 128 * 1024 * 1024
+    return opts
+  }
+
+  /// Options for append-mostly, time-ordered keys read back as ranges
+  ///
+  /// Recent levels stay on LZ4 while the bottommost level, which holds
+  /// most samples, uses zstd with a trained dictionary; together with 16 KB
+  /// blocks this compresses repetitive samples well. Filters are left out
+  /// because range scans cannot use them, and auto-readahead starts on the
+  /// first sequential read.
+  public static var timeSeries: RocksDBOptions {
+    var opts = RocksDBOptions()
+    opts.compression = .lz4
+    opts.bottommostCompression = .zstd
+    opts.bottommostCompressionOptions = .zstdDictionary
+    opts.writeBufferSize = 128 * 1024 * 1024
+    opts.targetFileSizeBase = 128 * 1024 * 1024
+    opts.maxBytesForLevelBase = 512 * 1024 * 1024
+    var table = RocksDBTableOptions.sequentialScan
+    table.blockSize = 16 * 1024
+    table.filterPolicy = nil
+    opts.tableOptions = table
+    return opts
+  }
+
+  /// Options sized from the machine's resources
+  ///
+  /// A quarter of `memory` goes to memtables and the rest to the block
+  /// cache (HyperClock from 8 cores up, where LRU's shard locks start to
+  /// contend). Background jobs follow the core count; size the
+  /// `RocksDBEnvironment` thread pools to match when sharing a process
+  /// with other databases.
+  /// - Parameters:
+  ///   - cores: Cores available to RocksDB (default: all active cores)
+  ///   - memory: Bytes available to this database (default: a quarter of physical memory)
+  public static func autoTune(
+    cores: Int = ProcessInfo.processInfo.activeProcessorCount,
+    memory: Int = Int(clamping: ProcessInfo.processInfo.physicalMemory / 4)
+  ) -> RocksDBOptions {
+    let cores = max(cores, 1)
+    let memory = max(memory, 64 * 1024 * 1024)
+    let memtableBudget = memory / 4
+
+    var opts = RocksDBOptions()
+    opts.maxBackgroundJobs = max(cores, 2)
+    opts.maxSubcompactions = max(cores / 4, 1)
+    opts.maxWriteBufferNumber = 4
+    opts.writeBufferSize = min(max(memtableBudget / opts.maxWriteBufferNumber, 16 * 1024 * 1024),
+                               256 * 1024 * 1024)
+    opts.writeBufferManager = RocksDBWriteBufferManager(bufferSize: memtableBudget)
+    opts.targetFileSizeBase = UInt64(opts.writeBufferSize)
+    opts.maxBytesForLevelBase = UInt64(opts.writeBufferSize * opts.level0FileNumCompactionTrigger)
+
+    var table = RocksDBTableOptions()
+    let cacheCapacity = memory - memtableBudget
+    table.blockCache = cores >= 8
+      ? .hyperClock(capacity: cacheCapacity, estimatedEntryCharge: Int(table.blockSize))
+      : .lru(capacity: cacheCapacity)
+    table.cacheIndexAndFilterBlocks = true
+    table.pinL0FilterAndIndexBlocksInCache = true
+    opts.tableOptions = table
+    return opts
+  }
+
+  /// Keep the upper levels on fast storage and the bottom levels on slow storage
+  ///
+  /// Compaction places the levels in `fast` until their combined size
+  /// reaches `fastCapacity`; the levels below go to `slow`. With the default
+  /// 10x level multiplier, the last level holds about 90% of the data, so
+  /// a fast drive of a tenth of the data size keeps all other levels fast.
+  /// - Parameters:
+  ///   - fast: Directory on fast storage
+  ///   - fastCapacity: Bytes of SST files to keep on fast storage
+  ///   - slow: Directory on slow storage
+  public mutating func placeLevels(onFast fast: String, fastCapacity: UInt64, slow: String) {
+    dbPaths = [RocksDBStoragePath(fast, targetSize: fastCapacity), RocksDBStoragePath(slow)]
+  }
+
+  /// Whether the filesystem holding `path` supports direct I/O
+  ///
+  /// Opens a probe file in the directory with O_DIRECT, creating the
+  /// directory if needed.
+  /// - Parameter path: Database directory
+  /// - Returns: True if `useDirectReads` and `useDirectIOForFlushAndCompaction` will work
+  public static func supportsDirectIO(at path: String) -> Bool {
+    do {
+      try FileManager.default.createDirectory(atPath: path, withIntermediateDirectories: true)
+      try RocksDBError.check(rocksdb_probe_direct_io(path))
+      return true
+    } catch {
+      return false
+    }
+  }
+
+  /// Turn on direct I/O for reads, flushes and compactions if the
+  /// filesystem holding `path` supports it
+  /// - Parameter path: Database directory
+  /// - Returns: False if direct I/O is unsupported and buffered I/O stays on
+  @discardableResult
+  public mutating func enableDirectIO(at path: String) -> Bool {
+    guard RocksDBOptions.supportsDirectIO(at: path) else { return false }
+    useDirectReads = true
+    useDirectIOForFlushAndCompaction = true
+    return true
+  }
+
   /// Create C handle from options
   internal func createHandle() -> RocksDBOptionsRef {
     let opts = rocksdb_options_create()!
 
     rocksdb_options_set_create_if_missing(opts, createIfMissing ? 1 : 0)
     rocksdb_options_set_error_if_exists(opts, errorIfExists ? 1 : 0)
+    rocksdb_options_set_create_missing_column_families(opts, createMissingColumnFamilies ? 1 : 0)
     rocksdb_options_set_paranoid_checks(opts, paranoidChecks ? 1 : 0)
     rocksdb_options_set_compression(opts, compression.rawValue)
+    let levelCompression = compressionPerLevel.map { Int32($0.rawValue) }
+    levelCompression.withUnsafeBufferPointer { types in
+      rocksdb_options_set_compression_per_level(opts, types.baseAddress, types.count)
+    }
+    rocksdb_options_set_bottommost_compression(opts, bottommostCompression?.rawValue ?? -1)
+    compressionOptions.apply(to: opts, bottommost: false)
+    bottommostCompressionOptions?.apply(to: opts, bottommost: true)
+    rocksdb_options_set_comparator(opts, comparator.rawValue)
     rocksdb_options_set_write_buffer_size(opts, writeBufferSize)
     rocksdb_options_set_max_write_buffer_number(opts, Int32(maxWriteBufferNumber))
     rocksdb_options_set_max_open_files(opts, Int32(maxOpenFiles))
-    rocksdb_options_set_max_background_compactions(opts, Int32(maxBackgroundCompactions))
-    rocksdb_options_set_max_background_flushes(opts, Int32(maxBackgroundFlushes))
+    if let jobs = maxBackgroundJobs {
+      rocksdb_options_set_max_background_jobs(opts, Int32(jobs))
+      rocksdb_options_set_max_background_compactions(opts, -1)
+      rocksdb_options_set_max_background_flushes(opts, -1)
+    } else {
+      rocksdb_options_set_max_background_compactions(opts, Int32(maxBackgroundCompactions))
+      rocksdb_options_set_max_background_flushes(opts, Int32(maxBackgroundFlushes))
+    }
+    rocksdb_options_set_max_subcompactions(opts, UInt32(max(maxSubcompactions, 1)))
     rocksdb_options_set_level0_file_num_compaction_trigger(opts, Int32(level0FileNumCompactionTrigger))
     rocksdb_options_set_level0_slowdown_writes_trigger(opts, Int32(level0SlowdownWritesTrigger))
     rocksdb_options_set_level0_stop_writes_trigger(opts, Int32(level0StopWritesTrigger))
     rocksdb_options_set_target_file_size_base(opts, targetFileSizeBase)
     rocksdb_options_set_max_bytes_for_level_base(opts, maxBytesForLevelBase)
+    rocksdb_options_set_level_compaction_dynamic_level_bytes(opts, levelCompactionDynamicLevelBytes ? 1 : 0)
+    rocksdb_options_set_max_bytes_for_level_multiplier(opts, maxBytesForLevelMultiplier)
+    rocksdb_options_set_compaction_pri(opts, compactionPriority.rawValue)
+    if let seconds = periodicCompactionSeconds {
+      rocksdb_options_set_periodic_compaction_seconds(opts, seconds)
+    }
+    if let seconds = ttl {
+      rocksdb_options_set_ttl(opts, seconds)
+    }
+    if let trigger = compactOnDeletion {
+      rocksdb_options_set_compact_on_deletion(opts, max(trigger.windowSize, 1),
+                                              trigger.deletionTrigger, trigger.deletionRatio)
+    }
+    if let length = sstPartitionerPrefixLength {
+      rocksdb_options_set_sst_partitioner_fixed_prefix(opts, max(length, 0))
+    }
+    switch compactionStyle {
+    case .level:
+      rocksdb_options_set_compaction_style(opts, Int32(RocksDBCompactionStyleLevel.rawValue))
+    case .universal(let universal):
+      rocksdb_options_set_compaction_style(opts, Int32(RocksDBCompactionStyleUniversal.rawValue))
+      rocksdb_options_set_universal_compaction_options(
+        opts, UInt32(universal.sizeRatio), UInt32(universal.minMergeWidth),
+        UInt32(clamping: universal.maxMergeWidth), UInt32(universal.maxSizeAmplificationPercent),
+        Int32(universal.compressionSizePercent ?? -1), universal.stopStyle.rawValue,
+        universal.allowTrivialMove ? 1 : 0)
+    case .fifo(let fifo):
+      rocksdb_options_set_compaction_style(opts, Int32(RocksDBCompactionStyleFIFO.rawValue))
+      rocksdb_options_set_fifo_compaction_options(opts, fifo.maxTableFilesSize, fifo.allowCompaction ? 1 : 0)
+      rocksdb_options_set_ttl(opts, fifo.ttl)
+    }
+    dbPaths.withPathArrays { paths, sizes, count in
+      rocksdb_options_set_db_paths(opts, paths, sizes, count)
+    }
+    columnFamilyPaths.withPathArrays { paths, sizes, count in
+      rocksdb_options_set_cf_paths(opts, paths, sizes, count)
+    }
+    rocksdb_options_set_last_level_temperature(opts, Int32(lastLevelTemperature.rawValue))
+    rocksdb_options_set_preclude_last_level_data_seconds(opts, precludeLastLevelDataSeconds)
+    rocksdb_options_set_memtable_prefix_bloom_size_ratio(opts, memtablePrefixBloomSizeRatio)
+    rocksdb_options_set_memtable_whole_key_filtering(opts, memtableWholeKeyFiltering ? 1 : 0)
+    rocksdb_options_set_memtable_huge_page_size(opts, memtableHugePageSize)
+    rocksdb_options_set_manual_wal_flush(opts, manualWALFlush ? 1 : 0)
+    rocksdb_options_set_wal_bytes_per_sync(opts, walBytesPerSync)
+    rocksdb_options_set_bytes_per_sync(opts, bytesPerSync)
+    rocksdb_options_set_allow_mmap_reads(opts, allowMmapReads ? 1 : 0)
+    rocksdb_options_set_allow_mmap_writes(opts, allowMmapWrites ? 1 : 0)
+    rocksdb_options_set_use_direct_reads(opts, useDirectReads ? 1 : 0)
+    rocksdb_options_set_use_direct_io_for_flush_and_compaction(opts, useDirectIOForFlushAndCompaction ? 1 : 0)
+    rocksdb_options_set_compaction_readahead_size(opts, compactionReadaheadSize)
+    rocksdb_options_set_enable_blob_files(opts, enableBlobFiles ? 1 : 0)
+    rocksdb_options_set_min_blob_size(opts, minBlobSize)
+    rocksdb_options_set_blob_file_size(opts, blobFileSize)
+    rocksdb_options_set_blob_compression(opts, blobCompression.rawValue)
+    rocksdb_options_set_enable_blob_garbage_collection(opts, enableBlobGarbageCollection ? 1 : 0)
+    rocksdb_options_set_blob_garbage_collection_age_cutoff(opts, blobGarbageCollectionAgeCutoff)
+    if let cache = blobCache {
+      rocksdb_options_set_blob_cache(opts, cache.handle)
+    }
+    if let cache = rowCache {
+      rocksdb_options_set_row_cache(opts, cache.handle)
+    }
+    rocksdb_options_set_wal_compression(opts, walCompression.rawValue)
+    rocksdb_options_set_recycle_log_file_num(opts, recycleLogFileNum)
+    rocksdb_options_set_max_total_wal_size(opts, maxTotalWALSize)
+    rocksdb_options_set_wal_ttl_seconds(opts, walTTLSeconds)
+    rocksdb_options_set_wal_size_limit_mb(opts, walSizeLimitMB)
+    rocksdb_options_set_wal_recovery_mode(opts, walRecoveryMode.rawValue)
+    if let filter = walFilter {
+      filter.skipKeyPrefixes.withPackedKeys { prefixPtrs, prefixLens in
+        rocksdb_options_set_wal_filter(opts, filter.skipKeyPrefixes.count, prefixPtrs, prefixLens,
+                                       filter.stopAfterSequence ?? .max)
+      }
+    }
+    rocksdb_options_set_allow_concurrent_memtable_write(opts, allowConcurrentMemtableWrite ? 1 : 0)
+    rocksdb_options_set_enable_pipelined_write(opts, enablePipelinedWrite ? 1 : 0)
+    rocksdb_options_set_unordered_write(opts, unorderedWrite ? 1 : 0)
+    rocksdb_options_set_enable_write_thread_adaptive_yield(opts, enableWriteThreadAdaptiveYield ? 1 : 0)
+    rocksdb_options_set_two_write_queues(opts, twoWriteQueues ? 1 : 0)
+    rocksdb_options_set_allow_ingest_behind(opts, allowIngestBehind ? 1 : 0)
+    rocksdb_options_set_max_file_opening_threads(opts, Int32(maxFileOpeningThreads))
+    rocksdb_options_set_skip_stats_update_on_db_open(opts, skipStatsUpdateOnDBOpen ? 1 : 0)
+    rocksdb_options_set_skip_checking_sst_file_sizes_on_db_open(opts, skipCheckingSSTFileSizesOnDBOpen ? 1 : 0)
+    rocksdb_options_set_avoid_flush_during_recovery(opts, avoidFlushDuringRecovery ? 1 : 0)
+    rocksdb_options_set_best_efforts_recovery(opts, bestEffortsRecovery ? 1 : 0)
+
+    if let manager = writeBufferManager {
+      rocksdb_options_set_write_buffer_manager(opts, manager.handle)
+    }
+
+    if let limiter = rateLimiter {
+      rocksdb_options_set_rate_limiter(opts, limiter.handle)
+    }
+
+    if let manager = sstFileManager {
+      rocksdb_options_set_sst_file_manager(opts, manager.handle)
+    }
+
+    for listener in eventListeners {
+      rocksdb_options_add_event_listener(opts, listener.handle)
+    }
+
+    if let filter = compactionFilter {
+      rocksdb_options_set_compaction_filter(opts, filter.handle)
+    }
+
+    if let service = compactionService {
+      Self.installCompactionService(service, on: opts)
+    }
 
     if enableStatistics {
       rocksdb_options_enable_statistics(opts)
+      rocksdb_options_set_statistics_level(opts, statisticsLevel.rawValue)
     }
 
+    rocksdb_options_set_enable_thread_tracking(opts, enableThreadTracking ? 1 : 0)
+
     if let pointLookupSize = optimizeForPointLookup {
       rocksdb_options_optimize_for_point_lookup(opts, pointLookupSize)
     }
@@ -133,22 +980,797 @@ public struct RocksDBOptions: Sendable {
       rocksdb_options_optimize_level_style_compaction(opts, levelStyleBudget)
     }
 
+    switch prefixExtractor {
+    case .fixed(let length):
+      rocksdb_options_set_prefix_extractor(opts, Int32(RocksDBPrefixExtractorFixed.rawValue), length)
+    case .capped(let length):
+      rocksdb_options_set_prefix_extractor(opts, Int32(RocksDBPrefixExtractorCapped.rawValue), length)
+    case nil:
+      break
+    }
+
+    switch memtableRep {
+    case .skipList(let lookahead):
+      rocksdb_options_set_memtable_rep(opts, Int32(RocksDBMemtableRepSkipList.rawValue), lookahead, 0, 0)
+    case .vector(let reserve):
+      rocksdb_options_set_memtable_rep(opts, Int32(RocksDBMemtableRepVector.rawValue), reserve, 0, 0)
+    case .hashSkipList(let bucketCount, let height, let branchingFactor):
+      rocksdb_options_set_memtable_rep(opts, Int32(RocksDBMemtableRepHashSkipList.rawValue), bucketCount,
+                                       Int32(height), Int32(branchingFactor))
+    case .hashLinkList(let bucketCount):
+      rocksdb_options_set_memtable_rep(opts, Int32(RocksDBMemtableRepHashLinkList.rawValue), bucketCount, 0, 0)
+    }
+
+    switch mergeOperator {
+    case .uint64Add:
+      rocksdb_options_set_merge_operator(opts, Int32(RocksDBMergeOperatorUInt64Add.rawValue), nil, 0)
+    case .stringAppend(let delimiter):
+      var delimiter = delimiter
+      delimiter.withUTF8 { ptr in
+        ptr.withMemoryRebound(to: CChar.self) { chars in
+          rocksdb_options_set_merge_operator(opts, Int32(RocksDBMergeOperatorStringAppend.rawValue),
+                                             chars.baseAddress, chars.count)
+        }
+      }
+    case .max:
+      rocksdb_options_set_merge_operator(opts, Int32(RocksDBMergeOperatorMax.rawValue), nil, 0)
+    case nil:
+      break
+    }
+
+    switch tableFormat {
+    case .blockBased:
+      if let table = tableOptions {
+        let tableOpts = table.createHandle()
+        defer { rocksdb_table_options_destroy(tableOpts) }
+        rocksdb_options_set_block_based_table_factory(opts, tableOpts)
+      }
+    case .plain(let plain):
+      rocksdb_options_set_plain_table_factory(
+        opts, UInt32(plain.userKeyLength ?? 0), Int32(plain.bloomBitsPerKey), plain.hashTableRatio,
+        plain.indexSparseness, plain.hugePageTLBSize, plain.prefixEncoding ? 1 : 0,
+        plain.fullScanMode ? 1 : 0, plain.storeIndexInFile ? 1 : 0)
+    case .cuckoo(let cuckoo):
+      rocksdb_options_set_cuckoo_table_factory(
+        opts, cuckoo.hashTableRatio, UInt32(cuckoo.maxSearchDepth), UInt32(cuckoo.cuckooBlockSize),
+        cuckoo.identityAsFirstHash ? 1 : 0, cuckoo.useModuleHash ? 1 : 0)
+    }
+
     return opts
   }
 }
 
+// MARK: - Compaction Styles
+
+/// Order leveled compaction picks files of a level in
+public enum RocksDBCompactionPriority: Int32, Sendable {
+  /// Largest files first, counting deletions extra
+  case byCompensatedSize = 0
+  /// Files whose data was updated longest ago first, for hot key ranges
+  case oldestLargestSeqFirst = 1
+  /// Files holding the oldest data first, for uniformly spread updates
+  case oldestSmallestSeqFirst = 2
+  /// Files overlapping the next level least first, minimizing write amplification
+  case minOverlappingRatio = 3
+  /// Cycle through the key space, giving even write amplification across keys
+  case roundRobin = 4
+}
+
+/// Strategy compaction uses to merge SST files
+///
+/// Leveled compaction keeps space and read amplification low at the cost
+/// of rewriting data once per level. Universal compaction merges sorted
+/// runs of similar size, writing each byte fewer times but needing up to
+/// twice the space during a full merge. FIFO never merges: it drops the
+/// oldest files once the data outgrows a size or age limit, which fits
+/// caches and time-bounded logs.
+public enum RocksDBCompactionStyle: Sendable, Equatable {
+  /// Leveled compaction (default)
+  case level
+  /// Size-tiered compaction of sorted runs, for write-heavy workloads
+  case universal(RocksDBUniversalCompactionOptions)
+  /// Drop the oldest files beyond a size or TTL limit
+  case fifo(RocksDBFIFOCompactionOptions)
+}
+
+/// Configuration of universal compaction
+public struct RocksDBUniversalCompactionOptions: Sendable, Equatable {
+  /// How the size of runs picked for a merge is compared
+  public enum StopStyle: Int32, Sendable {
+    /// Stop picking runs once the next is larger than the last picked one
+    case similarSize = 0
+    /// Stop picking runs once the next is larger than all picked so far
+    case totalSize = 1
+  }
+
+  /// Percentage a run may be larger than the runs before it and still be
+  /// merged with them (default: 1)
+  public var sizeRatio: Int = 1
+
+  /// Fewest runs merged in one compaction (default: 2)
+  public var minMergeWidth: Int = 2
+
+  /// Most runs merged in one compaction (default: unlimited)
+  public var maxMergeWidth: Int = Int(UInt32.max)
+
+  /// Space overhead, in percent of the last run, that triggers a full
+  /// merge (default: 200)
+  public var maxSizeAmplificationPercent: Int = 200
+
+  /// Percentage of data, counted from the oldest, kept compressed; nil to
+  /// compress everything (default: nil)
+  public var compressionSizePercent: Int? = nil
+
+  /// Size comparison used when picking runs (default: totalSize)
+  public var stopStyle: StopStyle = .totalSize
+
+  /// Move files instead of rewriting them when their ranges don't overlap (default: false)
+  public var allowTrivialMove: Bool = false
+
+  public init() {}
+}
+
+/// Configuration of FIFO compaction
+public struct RocksDBFIFOCompactionOptions: Sendable, Equatable {
+  /// Drop the oldest files once all SST files together exceed this many
+  /// bytes (default: 1GB)
+  public var maxTableFilesSize: UInt64 = 1024 * 1024 * 1024
+
+  /// Merge small L0 files into larger ones before they age out (default: false)
+  public var allowCompaction: Bool = false
+
+  /// Drop files whose newest data is older than this many seconds, 0 to
+  /// only enforce `maxTableFilesSize` (default: 0)
+  ///
+  /// Needs the block-based table format, which records file creation times.
+  public var ttl: UInt64 = 0
+
+  public init() {}
+}
+
+/// When a freshly written SST file holds enough tombstones to be compacted right away
+///
+/// Queue-like workloads delete what they read, leaving runs of tombstones
+/// that scans and seeks must step over until compaction drops them, which
+/// size-based triggers may not schedule for a long time. Files matching
+/// either condition are marked as they are flushed or compacted, and the
+/// next compaction picks them first.
+public struct RocksDBCompactOnDeletion: Sendable, Equatable {
+  /// Consecutive entries the sliding window spans
+  public var windowSize: Int
+
+  /// Tombstones within one window that mark the file
+  public var deletionTrigger: Int
+
+  /// Fraction of all entries being tombstones that marks the file (0 disables)
+  public var deletionRatio: Double
+
+  public init(windowSize: Int = 128, deletionTrigger: Int = 64, deletionRatio: Double = 0) {
+    self.windowSize = windowSize
+    self.deletionTrigger = deletionTrigger
+    self.deletionRatio = deletionRatio
+  }
+}
+
+// MARK: - Storage Tiers
+
+/// Temperature hint attached to SST files for tiered storage
+public enum RocksDBTemperature: UInt8, Sendable {
+  case unknown = 0x00
+  case hot = 0x04
+  case warm = 0x08
+  case cold = 0x0C
+
+  /// Name used in options strings and OPTIONS files
+  internal var optionName: String {
+    switch self {
+    case .unknown: return "kUnknown"
+    case .hot: return "kHot"
+    case .warm: return "kWarm"
+    case .cold: return "kCold"
+    }
+  }
+}
+
+/// Directory SST files are placed in, with the bytes it should hold
+public struct RocksDBStoragePath: Sendable, Equatable {
+  /// Directory path
+  public var path: String
+
+  /// Bytes of SST files to place here before moving on to the next path
+  /// (ignored for the last path)
+  public var targetSize: UInt64
+
+  public init(_ path: String, targetSize: UInt64 = 0) {
+    self.path = path
+    self.targetSize = targetSize
+  }
+}
+
+extension Array where Element == RocksDBStoragePath {
+  /// Expose the paths and target sizes as parallel C arrays
+  internal func withPathArrays<R>(
+    _ body: (UnsafePointer<UnsafePointer<CChar>?>, UnsafePointer<UInt64>, Int) throws -> R
+  ) rethrows -> R {
+    // A trailing sentinel keeps both arrays non-empty, so their base addresses exist
+    let sizes = map(\.targetSize) + [0]
+    return try (map(\.path) + [""]).withCStringPointers { paths in
+      try sizes.withUnsafeBufferPointer { sizes in
+        try body(paths, sizes.baseAddress!, count)
+      }
+    }
+  }
+}
+
+// MARK: - Table Formats
+
+/// SST file format
+///
+/// PlainTable and CuckooTable trade features for lookup cost on data that
+/// stays in memory: both are read through mmap and never use the block
+/// cache, so they suit read-only shards opened with `openReadOnly` on RAM
+/// or tmpfs-backed storage. Neither supports compression and both ignore
+/// `tableOptions`.
+public enum RocksDBTableFormat: Sendable {
+  /// Block-based tables (default), configured by `RocksDBOptions.tableOptions`
+  case blockBased
+  /// Unblocked key-value records with an in-memory hash index on key prefixes
+  ///
+  /// Set `RocksDBOptions.prefixExtractor` as well: prefixes are what the
+  /// index hashes, and without an extractor every lookup binary-searches a
+  /// single index bucket. Only prefix seeks are efficient.
+  case plain(RocksDBPlainTableOptions)
+  /// Cuckoo hash tables: at most a couple of memory probes per get
+  ///
+  /// Point lookups only: iteration sorts the file in memory first. Each
+  /// file holds one version per key, so merge operands and snapshots that
+  /// keep older versions alive are not supported. Every key and every
+  /// value in a file must have the same length, as the table stores them
+  /// in fixed-size slots; a flush of mixed lengths fails.
+  case cuckoo(RocksDBCuckooTableOptions)
+}
+
+/// Configuration of the PlainTable format
+public struct RocksDBPlainTableOptions: Sendable {
+  /// Fixed key length in bytes, nil for variable-length keys
+  public var userKeyLength: Int? = nil
+
+  /// Bloom filter bits per prefix, 0 to disable (default: 10)
+  public var bloomBitsPerKey: Int = 10
+
+  /// Prefixes per hash bucket, 0 for binary search only (default: 0.75)
+  public var hashTableRatio: Double = 0.75
+
+  /// Keys per index entry within a prefix (default: 16)
+  public var indexSparseness: Int = 16
+
+  /// Back the index and bloom filter with huge pages of this size, 0 to disable (default: 0)
+  public var hugePageTLBSize: Int = 0
+
+  /// Encode keys relative to their prefix, smaller for long shared prefixes (default: false)
+  public var prefixEncoding: Bool = false
+
+  /// Skip building an index; only full scans work (default: false)
+  public var fullScanMode: Bool = false
+
+  /// Persist the index and filter in the file instead of rebuilding them at open (default: false)
+  public var storeIndexInFile: Bool = false
+
+  public init() {}
+}
+
+/// Configuration of the CuckooTable format
+public struct RocksDBCuckooTableOptions: Sendable {
+  /// Fraction of hash table slots filled (default: 0.9)
+  public var hashTableRatio: Double = 0.9
+
+  /// Displacement search depth when inserting at build time (default: 100)
+  public var maxSearchDepth: Int = 100
+
+  /// Consecutive slots probed per hash, for cache locality (default: 5)
+  public var cuckooBlockSize: Int = 5
+
+  /// Use the key's first 8 bytes as its first hash, for already-uniform keys (default: false)
+  public var identityAsFirstHash: Bool = false
+
+  /// Map hashes with modulo instead of bit masks; false needs fewer
+  /// instructions but rounds the table up to a power of two (default: true)
+  public var useModuleHash: Bool = true
+
+  public init() {}
+}
+
+// MARK: - Table Options
+
+/// Filter policy for SST files
+public enum RocksDBFilterPolicy: Sendable, Equatable {
+  /// Classic bloom filter
+  case bloom(bitsPerKey: Double)
+  /// Ribbon filter: ~30% smaller than bloom at the same false-positive rate,
+  /// at somewhat higher construction CPU cost
+  case ribbon(bitsPerKey: Double)
+}
+
+/// Index structure for SST files
+public enum RocksDBIndexType: Int32, Sendable {
+  /// Binary search index (default)
+  case binarySearch = 0
+  /// Hash index (requires a prefix extractor)
+  case hashSearch = 1
+  /// Partitioned two-level index; only the top level needs to stay in memory
+  case twoLevelIndexSearch = 2
+  /// Binary search index that also stores the first key of each block
+  case binarySearchWithFirstKey = 3
+}
+
+/// Configuration for the block-based SST table format
+public struct RocksDBTableOptions: Sendable {
+  /// Block cache shared with other databases (default: nil, private 32MB cache)
+  public var blockCache: RocksDBCache? = nil
+
+  /// Filter policy, nil to disable filters (default: bloom, 10 bits per key)
+  public var filterPolicy: RocksDBFilterPolicy? = .bloom(bitsPerKey: 10)
+
+  /// Add whole keys to filters (default: true)
+  ///
+  /// Disable together with a prefix extractor to build prefix-only filters,
+  /// which are smaller and serve prefix seeks.
+  public var wholeKeyFiltering: Bool = true
+
+  /// Approximate uncompressed data block size in bytes (default: 4KB)
+  public var blockSize: UInt64 = 4 * 1024
+
+  /// Read blocks without caching them (default: false)
+  ///
+  /// Only sensible with `RocksDBOptions.allowMmapReads` and compression
+  /// off, where blocks are used straight from the mapped file.
+  public var noBlockCache: Bool = false
+
+  /// Target size of partitioned index/filter blocks in bytes (default: 4KB)
+  public var metadataBlockSize: UInt64 = 4 * 1024
+
+  /// Store index and filter blocks in the block cache (default: false)
+  public var cacheIndexAndFilterBlocks: Bool = false
+
+  /// Pin level-0 index and filter blocks in the block cache (default: false)
+  public var pinL0FilterAndIndexBlocksInCache: Bool = false
+
+  /// Pin the top level of partitioned indexes/filters in the block cache (default: true)
+  public var pinTopLevelIndexAndFilter: Bool = true
+
+  /// Index structure (default: binary search)
+  public var indexType: RocksDBIndexType = .binarySearch
+
+  /// Partition filters alongside a two-level index (default: false)
+  public var partitionFilters: Bool = false
+
+  /// SST format version (default: 6)
+  public var formatVersion: Int = 6
+
+  /// Add a hash index to data blocks for faster point lookups (default: false)
+  public var dataBlockHashIndex: Bool = false
+
+  /// Hash table utilization ratio for the data block hash index (default: 0.75)
+  public var dataBlockHashTableUtilRatio: Double = 0.75
+
+  /// Sequential reads of a file before iterators start auto-readahead (default: 2)
+  public var numFileReadsForAutoReadahead: UInt64 = 2
+
+  /// First auto-readahead size in bytes, doubled per read (default: 8KB)
+  public var initialAutoReadaheadSize: Int = 8 * 1024
+
+  /// Largest auto-readahead size in bytes, 0 to disable (default: 256KB)
+  public var maxAutoReadaheadSize: Int = 256 * 1024
+
+  /// Store keys in data blocks as suffixes of the previous key (default: true)
+  ///
+  /// Disable so every key of files written from then on can be pinned in
+  /// place by `RocksDBReadOptions.pinData`, at the cost of larger blocks.
+  public var useDeltaEncoding: Bool = true
+
+  public init() {}
+
+  /// Table options tuned for point lookups on large datasets: ribbon filters,
+  /// partitioned index/filters cached with pinned top levels, and block hash index
+  public static var partitionedPointLookup: RocksDBTableOptions {
+    var opts = RocksDBTableOptions()
+    opts.filterPolicy = .ribbon(bitsPerKey: 10)
+    opts.indexType = .twoLevelIndexSearch
+    opts.partitionFilters = true
+    opts.cacheIndexAndFilterBlocks = true
+    opts.pinL0FilterAndIndexBlocksInCache = true
+    opts.dataBlockHashIndex = true
+    return opts
+  }
+
+  /// Table options for scan-heavy workloads on high-latency storage:
+  /// auto-readahead starts on the first sequential read and grows to 2MB
+  public static var sequentialScan: RocksDBTableOptions {
+    var opts = RocksDBTableOptions()
+    opts.numFileReadsForAutoReadahead = 1
+    opts.initialAutoReadaheadSize = 64 * 1024
+    opts.maxAutoReadaheadSize = 2 * 1024 * 1024
+    return opts
+  }
+
+  /// Create C handle from options
+  internal func createHandle() -> RocksDBTableOptionsRef {
+    let opts = rocksdb_table_options_create()!
+
+    if let cache = blockCache {
+      rocksdb_table_options_set_block_cache(opts, cache.handle)
+    }
+
+    switch filterPolicy {
+    case .bloom(let bitsPerKey):
+      rocksdb_table_options_set_bloom_filter(opts, bitsPerKey)
+    case .ribbon(let bitsPerKey):
+      rocksdb_table_options_set_ribbon_filter(opts, bitsPerKey)
+    case nil:
+      rocksdb_table_options_set_bloom_filter(opts, 0)
+    }
+
+    rocksdb_table_options_set_whole_key_filtering(opts, wholeKeyFiltering ? 1 : 0)
+    rocksdb_table_options_set_block_size(opts, blockSize)
+    rocksdb_table_options_set_no_block_cache(opts, noBlockCache ? 1 : 0)
+    rocksdb_table_options_set_metadata_block_size(opts, metadataBlockSize)
+    rocksdb_table_options_set_cache_index_and_filter_blocks(opts, cacheIndexAndFilterBlocks ? 1 : 0)
+    rocksdb_table_options_set_pin_l0_filter_and_index_blocks_in_cache(opts, pinL0FilterAndIndexBlocksInCache ? 1 : 0)
+    rocksdb_table_options_set_pin_top_level_index_and_filter(opts, pinTopLevelIndexAndFilter ? 1 : 0)
+    rocksdb_table_options_set_index_type(opts, indexType.rawValue)
+    rocksdb_table_options_set_partition_filters(opts, partitionFilters ? 1 : 0)
+    rocksdb_table_options_set_format_version(opts, Int32(formatVersion))
+    rocksdb_table_options_set_data_block_hash_index(opts, dataBlockHashIndex ? 1 : 0, dataBlockHashTableUtilRatio)
+    rocksdb_table_options_set_auto_readahead(opts, numFileReadsForAutoReadahead,
+                                             initialAutoReadaheadSize, maxAutoReadaheadSize)
+    rocksdb_table_options_set_use_delta_encoding(opts, useDeltaEncoding ? 1 : 0)
+    return opts
+  }
+}
+
+// MARK: - Ingest Options
+
+/// Options for ingesting external SST files
+public struct RocksDBIngestOptions: Sendable {
+  /// Move (hard link) files instead of copying them (default: false)
+  public var moveFiles: Bool = false
+
+  /// Keep existing snapshots consistent with the ingested data (default: true)
+  public var snapshotConsistency: Bool = true
+
+  /// Allow assigning a global sequence number to overlapping files (default: true)
+  public var allowGlobalSeqno: Bool = true
+
+  /// Allow flushing overlapping memtables before ingesting (default: true)
+  public var allowBlockingFlush: Bool = true
+
+  /// Ingest into the bottommost level, below all existing data
+  /// (requires `RocksDBOptions.allowIngestBehind`, default: false)
+  public var ingestBehind: Bool = false
+
+  /// Verify block checksums before ingesting (default: false)
+  public var verifyChecksumsBeforeIngest: Bool = false
+
+  public init() {}
+
+  /// Default ingest options
+  public static var `default`: RocksDBIngestOptions {
+    RocksDBIngestOptions()
+  }
+
+  /// Create C handle from options
+  internal func createHandle() -> RocksDBIngestOptionsRef {
+    let opts = rocksdb_ingest_options_create()!
+    rocksdb_ingest_options_set_move_files(opts, moveFiles ? 1 : 0)
+    rocksdb_ingest_options_set_snapshot_consistency(opts, snapshotConsistency ? 1 : 0)
+    rocksdb_ingest_options_set_allow_global_seqno(opts, allowGlobalSeqno ? 1 : 0)
+    rocksdb_ingest_options_set_allow_blocking_flush(opts, allowBlockingFlush ? 1 : 0)
+    rocksdb_ingest_options_set_ingest_behind(opts, ingestBehind ? 1 : 0)
+    rocksdb_ingest_options_set_verify_checksums_before_ingest(opts, verifyChecksumsBeforeIngest ? 1 : 0)
+    return opts
+  }
+}
+
+// MARK: - Compact Range Options
+
+/// How a manual compaction treats the bottommost level
+public enum RocksDBBottommostLevelCompaction: Int32, Sendable {
+  /// Leave the bottommost level alone
+  case skip = 0
+  /// Rewrite it only when a compaction filter is configured (default)
+  case ifHaveCompactionFilter = 1
+  /// Always rewrite it
+  case force = 2
+  /// Always rewrite it, skipping files this compaction already produced
+  case forceOptimized = 3
+}
+
+/// Options for a manual `compactRange`
+public struct RocksDBCompactRangeOptions: Sendable {
+  /// Block automatic compactions while this one runs (default: false)
+  public var exclusiveManualCompaction: Bool = false
+
+  /// Threads the compaction may be split into (default: 0, the database's
+  /// `maxSubcompactions`)
+  public var maxSubcompactions: Int = 0
+
+  /// Bottommost level handling (default: only with a compaction filter)
+  public var bottommostLevelCompaction: RocksDBBottommostLevelCompaction = .ifHaveCompactionFilter
+
+  /// Move the result to `targetLevel` (default: false)
+  public var changeLevel: Bool = false
+
+  /// Level the result moves to with `changeLevel` (-1 for the lowest that fits)
+  public var targetLevel: Int = -1
+
+  /// Run even if it causes a write stall, instead of waiting (default: false)
+  public var allowWriteStall: Bool = false
+
+  /// Token that stops the compaction early once cancelled
+  public var cancellation: RocksDBCancellationToken? = nil
+
+  public init() {}
+
+  /// Default compact range options
+  public static var `default`: RocksDBCompactRangeOptions {
+    RocksDBCompactRangeOptions()
+  }
+
+  /// Create C handle from options
+  internal func createHandle() -> RocksDBCompactRangeOptionsRef {
+    let opts = rocksdb_compact_range_options_create()!
+    rocksdb_compact_range_options_set_exclusive_manual_compaction(opts, exclusiveManualCompaction ? 1 : 0)
+    rocksdb_compact_range_options_set_max_subcompactions(opts, UInt32(clamping: maxSubcompactions))
+    rocksdb_compact_range_options_set_bottommost_level_compaction(opts, bottommostLevelCompaction.rawValue)
+    rocksdb_compact_range_options_set_change_level(opts, changeLevel ? 1 : 0)
+    rocksdb_compact_range_options_set_target_level(opts, Int32(targetLevel))
+    rocksdb_compact_range_options_set_allow_write_stall(opts, allowWriteStall ? 1 : 0)
+    rocksdb_compact_range_options_set_canceled(opts, cancellation?.handle)
+    return opts
+  }
+}
+
+/// Options for `RocksDB.compactFiles(_:toLevel:in:options:)`
+public struct RocksDBCompactionOptions: Sendable {
+  /// Output compression, nil for the family's compression of the output
+  /// level (default: nil); always paired with the family's compression options
+  public var compression: RocksDBCompression? = nil
+
+  /// Split the output into files of about this size, nil for a single
+  /// file (default: nil)
+  public var outputFileSizeLimit: UInt64? = nil
+
+  /// Threads the compaction may be split into (default: 0, the database's
+  /// `maxSubcompactions`)
+  public var maxSubcompactions: Int = 0
+
+  public init() {}
+
+  /// Default compaction options
+  public static var `default`: RocksDBCompactionOptions {
+    RocksDBCompactionOptions()
+  }
+
+  /// Create C handle from options
+  internal func createHandle() -> RocksDBCompactionOptionsRef {
+    let opts = rocksdb_compaction_options_create()!
+    rocksdb_compaction_options_set_compression(opts, compression?.rawValue ?? -1)
+    rocksdb_compaction_options_set_output_file_size_limit(opts, outputFileSizeLimit ?? 0)
+    rocksdb_compaction_options_set_max_subcompactions(opts, UInt32(clamping: maxSubcompactions))
+    return opts
+  }
+}
+
+/// Flag that cancels a long-running call, such as a manual compaction,
+/// from another thread
+public final class RocksDBCancellationToken: @unchecked Sendable {
+  internal let handle: RocksDBCancelFlagRef
+
+  public init() {
+    handle = rocksdb_cancel_flag_create()!
+  }
+
+  deinit {
+    rocksdb_cancel_flag_destroy(handle)
+  }
+
+  /// Ask calls using this token to stop
+  public func cancel() {
+    rocksdb_cancel_flag_set(handle, 1)
+  }
+
+  /// Clear the flag so the token can be reused
+  public func reset() {
+    rocksdb_cancel_flag_set(handle, 0)
+  }
+
+  /// Whether `cancel()` has been called since the last reset
+  public var isCancelled: Bool {
+    rocksdb_cancel_flag_get(handle) != 0
+  }
+}
+
 // MARK: - Read Options
 
+/// Deepest storage a read may touch
+///
+/// Reads that would need data from further down fail with
+/// `RocksDBError.incomplete` instead of blocking on the device, so a
+/// latency-critical caller can defer them to a thread that may block.
+/// `RocksDB.multiGetCached(_:in:options:sortedInput:)` reports those keys
+/// as `maybePresent` instead of throwing.
+public enum RocksDBReadTier: Int32, Sendable {
+  /// Memtables, block cache and SST files
+  case all = 0
+  /// Memtables and the block cache only
+  case blockCache = 1
+  /// Memtables only
+  case memtable = 3
+}
+
 /// Options for read operations
+///
+/// The native handle is built once per distinct value and shared by all
+/// copies, so passing the same options to many reads performs no allocation.
 public struct RocksDBReadOptions: Sendable {
   /// Verify checksums on read (default: true)
-  public var verifyChecksums: Bool = true
+  public var verifyChecksums: Bool = true {
+    didSet { storage = HandleStorage(self) }
+  }
 
   /// Fill block cache on read (default: true)
-  public var fillCache: Bool = true
+  public var fillCache: Bool = true {
+    didSet { storage = HandleStorage(self) }
+  }
 
   /// Use prefix same as start for iteration (default: false)
-  public var prefixSameAsStart: Bool = false
+  public var prefixSameAsStart: Bool = false {
+    didSet { storage = HandleStorage(self) }
+  }
+
+  /// Issue SST reads asynchronously (default: false)
+  ///
+  /// Iterators prefetch ahead of the scan, and `multiGet` reads the blocks
+  /// of a batch concurrently (io_uring on Linux), so a cache-cold batch
+  /// costs about one device latency instead of one per key. Concurrent
+  /// `multiGet` reads require a RocksDB build with coroutine support.
+  public var asyncIO: Bool = false {
+    didSet { storage = HandleStorage(self) }
+  }
+
+  /// With `asyncIO`, let `multiGet` read all levels in parallel instead of
+  /// one level at a time (default: true)
+  public var optimizeMultiGetForIO: Bool = true {
+    didSet { storage = HandleStorage(self) }
+  }
+
+  /// Fixed iterator readahead in bytes, 0 for auto-readahead (default: 0)
+  ///
+  /// Auto-readahead starts small after a few sequential reads of a file and
+  /// grows (see `RocksDBTableOptions.maxAutoReadaheadSize`); a fixed size of
+  /// 2MB or more suits scans on storage with high per-request latency.
+  public var readaheadSize: Int = 0 {
+    didSet { storage = HandleStorage(self) }
+  }
+
+  /// Trim auto-readahead at `iterateUpperBound` instead of reading past it (default: true)
+  public var autoReadaheadSize: Bool = true {
+    didSet { storage = HandleStorage(self) }
+  }
+
+  /// Carry the grown auto-readahead size over to the next file instead of
+  /// starting small again (default: false)
+  public var adaptiveReadahead: Bool = false {
+    didSet { storage = HandleStorage(self) }
+  }
+
+  /// Deepest storage reads may touch (default: all)
+  public var readTier: RocksDBReadTier = .all {
+    didSet { storage = HandleStorage(self) }
+  }
+
+  /// Time after which `get` and `multiGet` give up with
+  /// `RocksDBError.timedOut` (default: nil, no deadline)
+  ///
+  /// The deadline is absolute, so set it per request, e.g.
+  /// `Date(timeIntervalSinceNow: 0.005)`; that builds a new native handle.
+  /// It is checked before each file read and passed on to file systems
+  /// that support timeouts; a read already blocked in a file system
+  /// without that support can still overrun it.
+  public var deadline: Date? = nil {
+    didSet { storage = HandleStorage(self) }
+  }
+
+  /// Longest a single file read may take before the read fails with
+  /// `RocksDBError.timedOut`, for file systems that support it (default: nil)
+  public var ioTimeout: TimeInterval? = nil {
+    didSet { storage = HandleStorage(self) }
+  }
+
+  /// Bytes of values `multiGet` returns before failing the remaining keys
+  /// with `RocksDBError.aborted` (default: nil, no limit)
+  public var valueSizeSoftLimit: UInt64? = nil {
+    didSet { storage = HandleStorage(self) }
+  }
+
+  /// Charge SST reads to `RocksDBOptions.rateLimiter` at this priority
+  /// (default: nil, reads are not charged)
+  ///
+  /// Needs a limiter in `.readsOnly` or `.allIo` mode. At `.low`, a bulk
+  /// scan queues behind compaction and interactive reads charged higher
+  /// instead of saturating the device; uncharged reads are never throttled.
+  public var rateLimiterPriority: RocksDBIOPriority? = nil {
+    didSet { storage = HandleStorage(self) }
+  }
+
+  /// Create iterators that see data written after they were created (default: false)
+  ///
+  /// Keep one iterator open and seek again from the last key read to pick
+  /// up new entries, instead of building an iterator per poll. Tailing
+  /// iterators read the latest data, so `snapshot` is ignored, and they
+  /// cannot move backwards.
+  public var tailing: Bool = false {
+    didSet { storage = HandleStorage(self) }
+  }
+
+  /// Keep everything an iterator read pinned until it is closed (default: false)
+  ///
+  /// Keys then stay valid after the iterator moves, so a
+  /// `RocksDBIterator.withCursor` scan can collect `cursor.key` views
+  /// without copying them (check `RocksDBCursor.isKeyPinned`; every key is
+  /// pinned in files written with `RocksDBTableOptions.useDeltaEncoding`
+  /// off). The pinned blocks and memtables are held for the iterator's
+  /// whole lifetime.
+  public var pinData: Bool = false {
+    didSet { storage = HandleStorage(self) }
+  }
+
+  /// Delete obsolete files released by closing an iterator on a background
+  /// thread instead of in `close()` (default: false)
+  ///
+  /// An iterator may hold the last reference to SST files and memtables
+  /// compacted or flushed away since it was created; this keeps that
+  /// cleanup off the thread closing it.
+  public var backgroundPurgeOnIteratorCleanup: Bool = false {
+    didSet { storage = HandleStorage(self) }
+  }
+
+  /// Inclusive lower bound for iterators created with these options (default: nil)
+  public var iterateLowerBound: Data? = nil {
+    didSet { storage = HandleStorage(self) }
+  }
+
+  /// Exclusive upper bound for iterators created with these options (default: nil)
+  ///
+  /// Lets RocksDB stop at the bound instead of scanning into the next range,
+  /// and skip SST files that lie entirely outside of it.
+  public var iterateUpperBound: Data? = nil {
+    didSet { storage = HandleStorage(self) }
+  }
+
+  /// Read the database as of this snapshot (default: nil)
+  ///
+  /// The options keep the snapshot alive while they are.
+  public var snapshot: RocksDBSnapshot? = nil {
+    didSet { storage = HandleStorage(self) }
+  }
+
+  /// Read the newest version at or below this user timestamp (default: nil)
+  ///
+  /// Required for every read on a database using `.bytewiseWithU64Timestamp`;
+  /// must be nil otherwise.
+  public var timestamp: UInt64? = nil {
+    didSet { storage = HandleStorage(self) }
+  }
+
+  /// Make iterators return every version with a timestamp in
+  /// `[iterStartTimestamp, timestamp]` instead of only the newest (default: nil)
+  public var iterStartTimestamp: UInt64? = nil {
+    didSet { storage = HandleStorage(self) }
+  }
+
+  /// Prebuilt native handle, nil while all fields hold their defaults
+  private var storage: HandleStorage?
 
   public init() {}
 
@@ -157,25 +1779,124 @@ public struct RocksDBReadOptions: Sendable {
     RocksDBReadOptions()
   }
 
+  /// Options for long sequential scans
+  ///
+  /// Reads ahead adaptively and asynchronously, and leaves the block cache
+  /// alone so a full-table scan does not evict the working set of point
+  /// lookups. Pair with `RocksDBTableOptions.sequentialScan` for larger
+  /// readahead on high-latency storage.
+  public static var scan: RocksDBReadOptions {
+    var opts = RocksDBReadOptions()
+    opts.fillCache = false
+    opts.adaptiveReadahead = true
+    opts.autoReadaheadSize = true
+    opts.asyncIO = true
+    return opts
+  }
+
+  /// Native handle shared by the default options value
+  private static let defaultStorage = HandleStorage(RocksDBReadOptions())
+
+  /// Cached C handle, valid for as long as these options are alive
+  internal var handle: RocksDBReadOptionsRef {
+    (storage ?? Self.defaultStorage).handle
+  }
+
+  /// Whether no field was ever changed, so the shared default handle is used
+  internal var isDefault: Bool {
+    storage == nil
+  }
+
   /// Create C handle from options
   internal func createHandle() -> RocksDBReadOptionsRef {
     let opts = rocksdb_read_options_create()!
     rocksdb_read_options_set_verify_checksums(opts, verifyChecksums ? 1 : 0)
     rocksdb_read_options_set_fill_cache(opts, fillCache ? 1 : 0)
     rocksdb_read_options_set_prefix_same_as_start(opts, prefixSameAsStart ? 1 : 0)
+    rocksdb_read_options_set_async_io(opts, asyncIO ? 1 : 0)
+    rocksdb_read_options_set_optimize_multiget_for_io(opts, optimizeMultiGetForIO ? 1 : 0)
+    rocksdb_read_options_set_readahead_size(opts, readaheadSize)
+    rocksdb_read_options_set_auto_readahead_size(opts, autoReadaheadSize ? 1 : 0)
+    rocksdb_read_options_set_adaptive_readahead(opts, adaptiveReadahead ? 1 : 0)
+    rocksdb_read_options_set_read_tier(opts, readTier.rawValue)
+    if let deadline {
+      rocksdb_read_options_set_deadline(opts, UInt64(max(deadline.timeIntervalSince1970 * 1_000_000, 1)))
+    }
+    if let ioTimeout {
+      rocksdb_read_options_set_io_timeout(opts, UInt64(max(ioTimeout * 1_000_000, 1)))
+    }
+    if let limit = valueSizeSoftLimit {
+      rocksdb_read_options_set_value_size_soft_limit(opts, limit)
+    }
+    if let priority = rateLimiterPriority {
+      rocksdb_read_options_set_rate_limiter_priority(opts, priority.rawValue)
+    }
+    rocksdb_read_options_set_tailing(opts, tailing ? 1 : 0)
+    rocksdb_read_options_set_pin_data(opts, pinData ? 1 : 0)
+    rocksdb_read_options_set_background_purge_on_iterator_cleanup(opts, backgroundPurgeOnIteratorCleanup ? 1 : 0)
+    if let snapshot {
+      rocksdb_read_options_set_snapshot(opts, snapshot.handle)
+    }
+    if let lower = iterateLowerBound {
+      Self.withBoundBytes(lower) { rocksdb_read_options_set_iterate_lower_bound(opts, $0, lower.count) }
+    }
+    if let upper = iterateUpperBound {
+      Self.withBoundBytes(upper) { rocksdb_read_options_set_iterate_upper_bound(opts, $0, upper.count) }
+    }
+    if let timestamp {
+      rocksdb_read_options_set_timestamp(opts, 1, timestamp)
+    }
+    if let iterStartTimestamp {
+      rocksdb_read_options_set_iter_start_timestamp(opts, 1, iterStartTimestamp)
+    }
     return opts
   }
+
+  /// Call body with a non-null pointer to the bound bytes (NULL clears a bound)
+  private static func withBoundBytes(_ bound: Data, _ body: (UnsafePointer<CChar>) -> Void) {
+    if bound.isEmpty {
+      var empty: CChar = 0
+      body(&empty)
+      return
+    }
+    bound.withUnsafeBytes { ptr in
+      body(ptr.baseAddress!.assumingMemoryBound(to: CChar.self))
+    }
+  }
+
+  /// Immutable owner of a native read options handle
+  private final class HandleStorage: @unchecked Sendable {
+    let handle: RocksDBReadOptionsRef
+
+    init(_ options: RocksDBReadOptions) {
+      handle = options.createHandle()
+    }
+
+    deinit {
+      rocksdb_read_options_destroy(handle)
+    }
+  }
 }
 
 // MARK: - Write Options
 
 /// Options for write operations
+///
+/// The native handle is built once per distinct value and shared by all
+/// copies, so passing the same options to many writes performs no allocation.
 public struct RocksDBWriteOptions: Sendable {
   /// Sync write to disk (default: false)
-  public var sync: Bool = false
+  public var sync: Bool = false {
+    didSet { storage = HandleStorage(self) }
+  }
 
   /// Disable write-ahead log (default: false)
-  public var disableWAL: Bool = false
+  public var disableWAL: Bool = false {
+    didSet { storage = HandleStorage(self) }
+  }
+
+  /// Prebuilt native handle, nil while all fields hold their defaults
+  private var storage: HandleStorage?
 
   public init() {}
 
@@ -186,9 +1907,21 @@ public struct RocksDBWriteOptions: Sendable {
 
   /// Sync write options (fsync after write)
   public static var sync: RocksDBWriteOptions {
+    syncOptions
+  }
+
+  private static let syncOptions: RocksDBWriteOptions = {
     var opts = RocksDBWriteOptions()
     opts.sync = true
     return opts
+  }()
+
+  /// Native handle shared by the default options value
+  private static let defaultStorage = HandleStorage(RocksDBWriteOptions())
+
+  /// Cached C handle, valid for as long as these options are alive
+  internal var handle: RocksDBWriteOptionsRef {
+    (storage ?? Self.defaultStorage).handle
   }
 
   /// Create C handle from options
@@ -198,4 +1931,149 @@ public struct RocksDBWriteOptions: Sendable {
     rocksdb_write_options_disable_wal(opts, disableWAL ? 1 : 0)
     return opts
   }
+
+  /// Immutable owner of a native write options handle
+  private final class HandleStorage: @unchecked Sendable {
+    let handle: RocksDBWriteOptionsRef
+
+    init(_ options: RocksDBWriteOptions) {
+      handle = options.createHandle()
+    }
+
+    deinit {
+      rocksdb_write_options_destroy(handle)
+    }
+  }
+}
+
+// MARK: - Transaction Database Options
+
+/// Concurrency control used by a transactional database
+public enum RocksDBTransactionMode: Int32, Sendable {
+  /// Conflicts are detected at commit, which fails with `transactionConflict`
+  ///
+  /// Cheapest when transactions rarely touch the same keys.
+  case optimistic = 0
+  /// Writes and `getForUpdate` lock rows, so conflicting transactions wait
+  /// instead of failing at commit
+  ///
+  /// Suited to hot keys, where optimistic commits keep failing and retrying.
+  case pessimistic = 1
+}
+
+/// How optimistic transactions check for conflicts at commit
+public enum RocksDBValidationPolicy: Int32, Sendable {
+  /// Validate inside the write group, serialized behind the database mutex
+  case serial = 0
+  /// Validate before entering the write group under striped per-key locks,
+  /// so unrelated commits validate concurrently
+  case parallel = 1
+}
+
+/// When pessimistic transactions write to the memtable
+///
+/// The policy is persistent: a database must be reopened with the policy
+/// it was created with.
+public enum RocksDBTransactionWritePolicy: Int32, Sendable {
+  /// Writes are buffered in the transaction until commit
+  case writeCommitted = 0
+  /// Writes reach the memtable at `prepare()`, so commit only writes a marker
+  case writePrepared = 1
+  /// Large transactions also spill to the memtable before `prepare()`,
+  /// bounding their memory (see `writeBatchFlushThreshold`)
+  case writeUnprepared = 2
+}
+
+/// Options for opening a transactional database
+///
+/// The lock settings only apply to `.pessimistic` mode and the validation
+/// settings only to `.optimistic` mode.
+public struct RocksDBTransactionDBOptions: Sendable {
+  /// Concurrency control (default: optimistic)
+  public var mode: RocksDBTransactionMode = .optimistic
+
+  /// Commit validation of optimistic transactions (default: parallel)
+  public var validationPolicy: RocksDBValidationPolicy = .parallel
+
+  /// Validation mutexes created for this database under `.parallel`
+  /// validation, unless `sharedLockBuckets` is set (default: 2^20)
+  public var occLockBuckets: UInt32 = 1 << 20
+
+  /// Validation mutex pool shared with other databases (default: nil)
+  public var sharedLockBuckets: RocksDBOccLockBuckets? = nil
+
+  /// How long a transaction waits for a row lock before failing with
+  /// `timedOut`, nil to wait forever (default: 1s)
+  public var lockTimeout: TimeInterval? = 1
+
+  /// Lock wait for writes made outside a transaction, nil to wait forever (default: 1s)
+  public var defaultLockTimeout: TimeInterval? = 1
+
+  /// Lock table shards per column family; more reduce contention (default: 16)
+  public var numStripes: Int = 16
+
+  /// Maximum row locks held per column family, nil for unlimited (default: nil)
+  public var maxNumLocks: Int64? = nil
+
+  /// Fail one transaction of a lock cycle with `busy` right away instead of
+  /// letting both wait out the lock timeout (default: false)
+  public var deadlockDetection: Bool = false
+
+  /// How many waiters deep deadlock detection follows a cycle (default: 50)
+  public var deadlockDetectionDepth: Int64 = 50
+
+  /// When pessimistic transactions write to the memtable (default: writeCommitted)
+  public var writePolicy: RocksDBTransactionWritePolicy = .writeCommitted
+
+  /// Under `.writeUnprepared`, bytes a transaction buffers before writing
+  /// them to the memtable early, 0 for never (default: 0)
+  public var writeBatchFlushThreshold: Int64 = 0
+
+  /// Allow named, prepared transactions in pessimistic mode (default: false)
+  ///
+  /// Two-phase commit writes a prepare record to the WAL and recovers
+  /// prepared transactions at open, at the cost of an extra WAL write per
+  /// commit. A database whose WAL still holds prepared transactions must
+  /// be reopened with it enabled.
+  public var twoPhaseCommit: Bool = false
+
+  public init() {}
+
+  /// Default optimistic options
+  public static var optimistic: RocksDBTransactionDBOptions {
+    RocksDBTransactionDBOptions()
+  }
+
+  /// Pessimistic options with the default lock settings
+  public static var pessimistic: RocksDBTransactionDBOptions {
+    var opts = RocksDBTransactionDBOptions()
+    opts.mode = .pessimistic
+    return opts
+  }
+
+  /// Create C handle from options
+  internal func createHandle() -> RocksDBTransactionDBOptionsRef {
+    let opts = rocksdb_transaction_db_options_create(mode.rawValue)!
+    rocksdb_transaction_db_options_set_lock_timeout(opts, Self.milliseconds(lockTimeout))
+    rocksdb_transaction_db_options_set_default_lock_timeout(opts, Self.milliseconds(defaultLockTimeout))
+    rocksdb_transaction_db_options_set_num_stripes(opts, numStripes)
+    rocksdb_transaction_db_options_set_max_num_locks(opts, maxNumLocks ?? -1)
+    rocksdb_transaction_db_options_set_deadlock_detect(opts, deadlockDetection ? 1 : 0,
+                                                       deadlockDetectionDepth)
+    rocksdb_transaction_db_options_set_write_policy(opts, writePolicy.rawValue)
+    rocksdb_transaction_db_options_set_write_batch_flush_threshold(opts, writeBatchFlushThreshold)
+    rocksdb_transaction_db_options_set_two_phase_commit(opts, twoPhaseCommit ? 1 : 0)
+    rocksdb_transaction_db_options_set_validate_policy(opts, validationPolicy.rawValue)
+    rocksdb_transaction_db_options_set_occ_lock_buckets(opts, occLockBuckets)
+    if let buckets = sharedLockBuckets {
+      rocksdb_transaction_db_options_set_shared_occ_lock_buckets(opts, buckets.handle)
+    }
+    return opts
+  }
+
+  /// Lock timeout in the milliseconds TransactionDB expects, -1 for no timeout
+  private static func milliseconds(_ timeout: TimeInterval?) -> Int64 {
+    guard let timeout else { return -1 }
+    return timeout <= 0 ? 0 : Int64(min((timeout * 1000).rounded(.up), Double(Int64.max)))
+  }
 }
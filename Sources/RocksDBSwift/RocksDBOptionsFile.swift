@@ -0,0 +1,179 @@
+//
+//  RocksDBOptionsFile.swift
+//  RocksDB.swift
+//
+//  Complete option sets in RocksDB's OPTIONS file format
+//
+
+import Foundation
+import CRocksDB
+
+/// Complete DB, column family and table option set as RocksDB stores it
+///
+/// Covers every option RocksDB knows, including those `RocksDBOptions` does
+/// not model, so a database can open with the exact set tuned with db_bench
+/// or ldb. RocksDB writes an OPTIONS file into the database directory on
+/// every open and option change; `RocksDB.exportOptionsFile(to:)` keeps a
+/// copy of the current one. Custom objects (comparators, merge operators,
+/// filters) are restored only when RocksDB knows them by name.
+public final class RocksDBOptionsFile: @unchecked Sendable {
+  /// DB options together with the default family's options
+  internal let dbOptions: RocksDBOptionsRef
+
+  /// Options of each column family, in `columnFamilies` order
+  internal let familyOptions: [RocksDBOptionsRef]
+
+  /// Column family names, including "default"
+  public let columnFamilies: [String]
+
+  private init(dbOptions: RocksDBOptionsRef, columnFamilies: [String], familyOptions: [RocksDBOptionsRef]) {
+    self.dbOptions = dbOptions
+    self.columnFamilies = columnFamilies
+    self.familyOptions = familyOptions
+  }
+
+  deinit {
+    rocksdb_options_destroy(dbOptions)
+    familyOptions.forEach { rocksdb_options_destroy($0) }
+  }
+
+  // MARK: - Factory Methods
+
+  /// Load the newest OPTIONS file of a database
+  /// - Parameter path: Path to database directory
+  /// - Returns: Option set of the database and all its column families
+  /// - Throws: RocksDBError on failure (e.g. no OPTIONS file)
+  public static func latest(in path: String) throws -> RocksDBOptionsFile {
+    try load { dbOut, namesOut, familiesOut, countOut in
+      rocksdb_load_latest_options(path, &dbOut, &namesOut, &familiesOut, &countOut)
+    }
+  }
+
+  /// Load a specific OPTIONS file
+  /// - Parameter file: Path to the OPTIONS file
+  /// - Returns: Option set of the database and all its column families
+  /// - Throws: RocksDBError on failure
+  public static func load(from file: String) throws -> RocksDBOptionsFile {
+    try load { dbOut, namesOut, familiesOut, countOut in
+      rocksdb_load_options_from_file(file, &dbOut, &namesOut, &familiesOut, &countOut)
+    }
+  }
+
+  /// Build a single-family option set from an options string
+  ///
+  /// Accepts DB and column family options as `key=value;` pairs, with table
+  /// options nested as `block_based_table_factory={block_size=16384}`.
+  /// - Parameters:
+  ///   - string: Options string
+  ///   - base: Options the string is applied on top of
+  /// - Returns: Option set with only the default family
+  /// - Throws: RocksDBError.invalidArgument for unknown or malformed options
+  public static func parse(_ string: String, base: RocksDBOptions = .default) throws -> RocksDBOptionsFile {
+    let baseOpts = base.createHandle()
+    defer { rocksdb_options_destroy(baseOpts) }
+
+    let opts = try apply(string, to: baseOpts)
+    let family = try apply("", to: opts)
+    return RocksDBOptionsFile(dbOptions: opts, columnFamilies: [RocksDBColumnFamily.defaultName],
+                              familyOptions: [family])
+  }
+
+  // MARK: - Derived Option Sets
+
+  /// Copy of the option set with an options string applied to one family
+  ///
+  /// DB options in `string` take effect only when applied to the default family.
+  /// - Parameters:
+  ///   - string: Options string (see `parse(_:base:)`)
+  ///   - family: Column family to change
+  /// - Returns: New option set
+  /// - Throws: RocksDBError.invalidArgument for unknown families or options
+  public func applying(_ string: String, to family: String = RocksDBColumnFamily.defaultName) throws -> RocksDBOptionsFile {
+    guard columnFamilies.contains(family) else {
+      throw RocksDBError.invalidArgument("Unknown column family \(family)")
+    }
+
+    var created: [RocksDBOptionsRef] = []
+    do {
+      let isDefault = family == RocksDBColumnFamily.defaultName
+      let db = try Self.apply(isDefault ? string : "", to: dbOptions)
+      created.append(db)
+      var families: [RocksDBOptionsRef] = []
+      for (name, opts) in zip(columnFamilies, familyOptions) {
+        let copy = try Self.apply(name == family ? string : "", to: opts)
+        created.append(copy)
+        families.append(copy)
+      }
+      return RocksDBOptionsFile(dbOptions: db, columnFamilies: columnFamilies, familyOptions: families)
+    } catch {
+      created.forEach { rocksdb_options_destroy($0) }
+      throw error
+    }
+  }
+
+  // MARK: - Properties
+
+  /// All options of a column family in options string format
+  /// - Parameter family: Column family name
+  /// - Returns: Options string, nil for unknown families
+  public func optionsString(for family: String = RocksDBColumnFamily.defaultName) -> String? {
+    guard let index = columnFamilies.firstIndex(of: family),
+          let cString = rocksdb_options_get_string(familyOptions[index]) else {
+      return nil
+    }
+    defer { rocksdb_free_string(cString) }
+    return String(cString: cString)
+  }
+
+  /// Path of the newest OPTIONS file a database has written
+  /// - Parameter path: Path to database directory
+  /// - Returns: OPTIONS file path
+  /// - Throws: RocksDBError on failure
+  public static func latestFilePath(in path: String) throws -> String {
+    var file: UnsafeMutablePointer<CChar>?
+    try RocksDBError.check(rocksdb_get_latest_options_file(path, &file))
+    guard let file else {
+      throw RocksDBError.ioError("No OPTIONS file in \(path)")
+    }
+    defer { rocksdb_free_string(file) }
+    return String(cString: file)
+  }
+
+  // MARK: - Internal Helpers
+
+  private static func load(
+    _ loader: (
+      inout RocksDBOptionsRef?,
+      inout UnsafeMutablePointer<UnsafeMutablePointer<CChar>?>?,
+      inout UnsafeMutablePointer<RocksDBOptionsRef?>?,
+      inout Int
+    ) -> RocksDBStatus
+  ) throws -> RocksDBOptionsFile {
+    var dbOptions: RocksDBOptionsRef?
+    var names: UnsafeMutablePointer<UnsafeMutablePointer<CChar>?>?
+    var families: UnsafeMutablePointer<RocksDBOptionsRef?>?
+    var count = 0
+    try RocksDBError.check(loader(&dbOptions, &names, &families, &count))
+    defer {
+      rocksdb_free_string_list(names, count)
+      rocksdb_free_data(families)
+    }
+
+    guard let dbOptions else {
+      throw RocksDBError.ioError("Failed to load options")
+    }
+    let familyNames = (0..<count).map { names?[$0].map { String(cString: $0) } ?? "" }
+    let familyOptions = (0..<count).compactMap { families?[$0] }
+    return RocksDBOptionsFile(dbOptions: dbOptions, columnFamilies: familyNames, familyOptions: familyOptions)
+  }
+
+  /// New handle with `string` applied on top of `base`
+  private static func apply(_ string: String, to base: RocksDBOptionsRef) throws -> RocksDBOptionsRef {
+    var opts: RocksDBOptionsRef?
+    try RocksDBError.check(rocksdb_options_create_from_string(base, string, &opts))
+    guard let opts else {
+      throw RocksDBError.invalidArgument("Failed to parse options")
+    }
+    return opts
+  }
+}
@@ -0,0 +1,316 @@
+//
+//  RocksDBPerfContext.swift
+//  RocksDB.swift
+//
+//  Per-thread breakdown of where an operation spends its time
+//
+
+import Foundation
+import CRocksDB
+
+/// What the per-thread perf context measures
+public enum RocksDBPerfLevel: Int32, Sendable {
+  /// Measure nothing
+  case disable = 1
+  /// Counters only (default)
+  case enableCount = 2
+  /// Counters and time spent blocked in RocksDB
+  case enableWait = 3
+  /// Counters and timers, except mutex waits
+  case enableTimeExceptForMutex = 4
+  /// Counters, timers and CPU time, except mutex waits
+  case enableTimeAndCPUTimeExceptForMutex = 5
+  /// Everything, including mutex waits
+  case enableTime = 6
+}
+
+/// PerfContext and IOStatsContext counters of one thread (times in nanoseconds)
+public struct RocksDBPerfStats: Sendable, Equatable {
+  /// Key comparisons
+  public var userKeyComparisonCount: UInt64 = 0
+
+  /// Block cache hits
+  public var blockCacheHitCount: UInt64 = 0
+
+  /// Blocks read from disk
+  public var blockReadCount: UInt64 = 0
+
+  /// Bytes of blocks read from disk
+  public var blockReadBytes: UInt64 = 0
+
+  /// Time reading blocks from disk
+  public var blockReadTime: UInt64 = 0
+
+  /// Time verifying block checksums
+  public var blockChecksumTime: UInt64 = 0
+
+  /// Time decompressing blocks
+  public var blockDecompressTime: UInt64 = 0
+
+  /// Index blocks read from disk
+  public var indexBlockReadCount: UInt64 = 0
+
+  /// Filter blocks read from disk
+  public var filterBlockReadCount: UInt64 = 0
+
+  /// Value bytes returned by point reads
+  public var getReadBytes: UInt64 = 0
+
+  /// Bytes returned by iterators
+  public var iterReadBytes: UInt64 = 0
+
+  /// Obsolete internal keys skipped by iterators
+  public var internalKeySkippedCount: UInt64 = 0
+
+  /// Tombstones skipped by iterators
+  public var internalDeleteSkippedCount: UInt64 = 0
+
+  /// Merge operands processed
+  public var internalMergeCount: UInt64 = 0
+
+  /// Time acquiring the read snapshot
+  public var getSnapshotTime: UInt64 = 0
+
+  /// Time looking up memtables
+  public var getFromMemtableTime: UInt64 = 0
+
+  /// Memtables looked up
+  public var getFromMemtableCount: UInt64 = 0
+
+  /// Time after the lookup found its value
+  public var getPostProcessTime: UInt64 = 0
+
+  /// Time looking up SST files
+  public var getFromOutputFilesTime: UInt64 = 0
+
+  /// Time seeking memtables
+  public var seekOnMemtableTime: UInt64 = 0
+
+  /// Time seeking child iterators
+  public var seekChildSeekTime: UInt64 = 0
+
+  /// Time in internal seeks
+  public var seekInternalSeekTime: UInt64 = 0
+
+  /// Time skipping to the next user key
+  public var findNextUserEntryTime: UInt64 = 0
+
+  /// Time writing the WAL
+  public var writeWALTime: UInt64 = 0
+
+  /// Time inserting into memtables
+  public var writeMemtableTime: UInt64 = 0
+
+  /// Time delayed by write throttling
+  public var writeDelayTime: UInt64 = 0
+
+  /// Time before and after the write itself
+  public var writePreAndPostProcessTime: UInt64 = 0
+
+  /// Time waiting to join a write group
+  public var writeThreadWaitNanos: UInt64 = 0
+
+  /// Time waiting for the DB mutex
+  public var dbMutexLockNanos: UInt64 = 0
+
+  /// Time waiting on the DB condition variable
+  public var dbConditionWaitNanos: UInt64 = 0
+
+  /// Time in merge operators
+  public var mergeOperatorTimeNanos: UInt64 = 0
+
+  /// Time finding or opening table readers
+  public var findTableNanos: UInt64 = 0
+
+  /// Memtable bloom filter passes
+  public var bloomMemtableHitCount: UInt64 = 0
+
+  /// Memtable bloom filter rejections
+  public var bloomMemtableMissCount: UInt64 = 0
+
+  /// SST bloom filter passes
+  public var bloomSstHitCount: UInt64 = 0
+
+  /// SST bloom filter rejections
+  public var bloomSstMissCount: UInt64 = 0
+
+  /// Time waiting for transaction key locks
+  public var keyLockWaitTime: UInt64 = 0
+
+  /// CPU time in point reads
+  public var getCPUNanos: UInt64 = 0
+
+  /// Bytes read from files
+  public var ioBytesRead: UInt64 = 0
+
+  /// Bytes written to files
+  public var ioBytesWritten: UInt64 = 0
+
+  /// Time opening files
+  public var ioOpenNanos: UInt64 = 0
+
+  /// Time reading files
+  public var ioReadNanos: UInt64 = 0
+
+  /// Time writing files
+  public var ioWriteNanos: UInt64 = 0
+
+  /// Time in fsync
+  public var ioFsyncNanos: UInt64 = 0
+
+  /// Time in range sync
+  public var ioRangeSyncNanos: UInt64 = 0
+
+  /// Time writing the info log
+  public var ioLoggerNanos: UInt64 = 0
+
+  public init() {}
+
+  internal init(_ values: RocksDBPerfContextValues) {
+    userKeyComparisonCount = values.user_key_comparison_count
+    blockCacheHitCount = values.block_cache_hit_count
+    blockReadCount = values.block_read_count
+    blockReadBytes = values.block_read_byte
+    blockReadTime = values.block_read_time
+    blockChecksumTime = values.block_checksum_time
+    blockDecompressTime = values.block_decompress_time
+    indexBlockReadCount = values.index_block_read_count
+    filterBlockReadCount = values.filter_block_read_count
+    getReadBytes = values.get_read_bytes
+    iterReadBytes = values.iter_read_bytes
+    internalKeySkippedCount = values.internal_key_skipped_count
+    internalDeleteSkippedCount = values.internal_delete_skipped_count
+    internalMergeCount = values.internal_merge_count
+    getSnapshotTime = values.get_snapshot_time
+    getFromMemtableTime = values.get_from_memtable_time
+    getFromMemtableCount = values.get_from_memtable_count
+    getPostProcessTime = values.get_post_process_time
+    getFromOutputFilesTime = values.get_from_output_files_time
+    seekOnMemtableTime = values.seek_on_memtable_time
+    seekChildSeekTime = values.seek_child_seek_time
+    seekInternalSeekTime = values.seek_internal_seek_time
+    findNextUserEntryTime = values.find_next_user_entry_time
+    writeWALTime = values.write_wal_time
+    writeMemtableTime = values.write_memtable_time
+    writeDelayTime = values.write_delay_time
+    writePreAndPostProcessTime = values.write_pre_and_post_process_time
+    writeThreadWaitNanos = values.write_thread_wait_nanos
+    dbMutexLockNanos = values.db_mutex_lock_nanos
+    dbConditionWaitNanos = values.db_condition_wait_nanos
+    mergeOperatorTimeNanos = values.merge_operator_time_nanos
+    findTableNanos = values.find_table_nanos
+    bloomMemtableHitCount = values.bloom_memtable_hit_count
+    bloomMemtableMissCount = values.bloom_memtable_miss_count
+    bloomSstHitCount = values.bloom_sst_hit_count
+    bloomSstMissCount = values.bloom_sst_miss_count
+    keyLockWaitTime = values.key_lock_wait_time
+    getCPUNanos = values.get_cpu_nanos
+    ioBytesRead = values.io_bytes_read
+    ioBytesWritten = values.io_bytes_written
+    ioOpenNanos = values.io_open_nanos
+    ioReadNanos = values.io_read_nanos
+    ioWriteNanos = values.io_write_nanos
+    ioFsyncNanos = values.io_fsync_nanos
+    ioRangeSyncNanos = values.io_range_sync_nanos
+    ioLoggerNanos = values.io_logger_nanos
+  }
+
+  /// Counter-wise difference, for the work done between two snapshots
+  public static func - (lhs: RocksDBPerfStats, rhs: RocksDBPerfStats) -> RocksDBPerfStats {
+    var delta = RocksDBPerfStats()
+    delta.userKeyComparisonCount = lhs.userKeyComparisonCount &- rhs.userKeyComparisonCount
+    delta.blockCacheHitCount = lhs.blockCacheHitCount &- rhs.blockCacheHitCount
+    delta.blockReadCount = lhs.blockReadCount &- rhs.blockReadCount
+    delta.blockReadBytes = lhs.blockReadBytes &- rhs.blockReadBytes
+    delta.blockReadTime = lhs.blockReadTime &- rhs.blockReadTime
+    delta.blockChecksumTime = lhs.blockChecksumTime &- rhs.blockChecksumTime
+    delta.blockDecompressTime = lhs.blockDecompressTime &- rhs.blockDecompressTime
+    delta.indexBlockReadCount = lhs.indexBlockReadCount &- rhs.indexBlockReadCount
+    delta.filterBlockReadCount = lhs.filterBlockReadCount &- rhs.filterBlockReadCount
+    delta.getReadBytes = lhs.getReadBytes &- rhs.getReadBytes
+    delta.iterReadBytes = lhs.iterReadBytes &- rhs.iterReadBytes
+    delta.internalKeySkippedCount = lhs.internalKeySkippedCount &- rhs.internalKeySkippedCount
+    delta.internalDeleteSkippedCount = lhs.internalDeleteSkippedCount &- rhs.internalDeleteSkippedCount
+    delta.internalMergeCount = lhs.internalMergeCount &- rhs.internalMergeCount
+    delta.getSnapshotTime = lhs.getSnapshotTime &- rhs.getSnapshotTime
+    delta.getFromMemtableTime = lhs.getFromMemtableTime &- rhs.getFromMemtableTime
+    delta.getFromMemtableCount = lhs.getFromMemtableCount &- rhs.getFromMemtableCount
+    delta.getPostProcessTime = lhs.getPostProcessTime &- rhs.getPostProcessTime
+    delta.getFromOutputFilesTime = lhs.getFromOutputFilesTime &- rhs.getFromOutputFilesTime
+    delta.seekOnMemtableTime = lhs.seekOnMemtableTime &- rhs.seekOnMemtableTime
+    delta.seekChildSeekTime = lhs.seekChildSeekTime &- rhs.seekChildSeekTime
+    delta.seekInternalSeekTime = lhs.seekInternalSeekTime &- rhs.seekInternalSeekTime
+    delta.findNextUserEntryTime = lhs.findNextUserEntryTime &- rhs.findNextUserEntryTime
+    delta.writeWALTime = lhs.writeWALTime &- rhs.writeWALTime
+    delta.writeMemtableTime = lhs.writeMemtableTime &- rhs.writeMemtableTime
+    delta.writeDelayTime = lhs.writeDelayTime &- rhs.writeDelayTime
+    delta.writePreAndPostProcessTime = lhs.writePreAndPostProcessTime &- rhs.writePreAndPostProcessTime
+    delta.writeThreadWaitNanos = lhs.writeThreadWaitNanos &- rhs.writeThreadWaitNanos
+    delta.dbMutexLockNanos = lhs.dbMutexLockNanos &- rhs.dbMutexLockNanos
+    delta.dbConditionWaitNanos = lhs.dbConditionWaitNanos &- rhs.dbConditionWaitNanos
+    delta.mergeOperatorTimeNanos = lhs.mergeOperatorTimeNanos &- rhs.mergeOperatorTimeNanos
+    delta.findTableNanos = lhs.findTableNanos &- rhs.findTableNanos
+    delta.bloomMemtableHitCount = lhs.bloomMemtableHitCount &- rhs.bloomMemtableHitCount
+    delta.bloomMemtableMissCount = lhs.bloomMemtableMissCount &- rhs.bloomMemtableMissCount
+    delta.bloomSstHitCount = lhs.bloomSstHitCount &- rhs.bloomSstHitCount
+    delta.bloomSstMissCount = lhs.bloomSstMissCount &- rhs.bloomSstMissCount
+    delta.keyLockWaitTime = lhs.keyLockWaitTime &- rhs.keyLockWaitTime
+    delta.getCPUNanos = lhs.getCPUNanos &- rhs.getCPUNanos
+    delta.ioBytesRead = lhs.ioBytesRead &- rhs.ioBytesRead
+    delta.ioBytesWritten = lhs.ioBytesWritten &- rhs.ioBytesWritten
+    delta.ioOpenNanos = lhs.ioOpenNanos &- rhs.ioOpenNanos
+    delta.ioReadNanos = lhs.ioReadNanos &- rhs.ioReadNanos
+    delta.ioWriteNanos = lhs.ioWriteNanos &- rhs.ioWriteNanos
+    delta.ioFsyncNanos = lhs.ioFsyncNanos &- rhs.ioFsyncNanos
+    delta.ioRangeSyncNanos = lhs.ioRangeSyncNanos &- rhs.ioRangeSyncNanos
+    delta.ioLoggerNanos = lhs.ioLoggerNanos &- rhs.ioLoggerNanos
+    return delta
+  }
+}
+
+/// Per-thread instrumentation of individual operations
+///
+/// RocksDB keeps these counters in thread-local storage, so they only see
+/// work done synchronously on the calling thread: measure blocking calls,
+/// not the async overloads that hop to the I/O pool. Timers cost a clock
+/// read per step, so enable them for a sample of requests only.
+public enum RocksDBPerfContext {
+  /// Perf level of the calling thread
+  public static var level: RocksDBPerfLevel {
+    get { RocksDBPerfLevel(rawValue: rocksdb_get_perf_level()) ?? .disable }
+    set { rocksdb_set_perf_level(newValue.rawValue) }
+  }
+
+  /// Zero the calling thread's counters
+  public static func reset() {
+    rocksdb_perf_context_reset()
+  }
+
+  /// Current counters of the calling thread
+  public static func snapshot() -> RocksDBPerfStats {
+    var values = RocksDBPerfContextValues()
+    rocksdb_perf_context_snapshot(&values)
+    return RocksDBPerfStats(values)
+  }
+
+  /// Run `body` at `level` and return the counters it accumulated
+  ///
+  /// Counters are diffed rather than reset, so measurements can nest; the
+  /// thread's previous level is restored afterwards.
+  /// - Parameters:
+  ///   - level: Perf level to measure at
+  ///   - body: Work to measure, run synchronously on this thread
+  /// - Returns: Result of `body` and the counters it accumulated
+  public static func measure<R>(
+    level: RocksDBPerfLevel = .enableTimeExceptForMutex,
+    _ body: () throws -> R
+  ) rethrows -> (result: R, stats: RocksDBPerfStats) {
+    let previous = self.level
+    self.level = level
+    defer { self.level = previous }
+
+    let before = snapshot()
+    let result = try body()
+    return (result, snapshot() - before)
+  }
+}
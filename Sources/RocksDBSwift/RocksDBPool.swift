@@ -0,0 +1,261 @@
+//
+//  RocksDBPool.swift
+//  RocksDB.swift
+//
+//  Lazily opened, LRU-bounded set of databases sharing one memory budget
+//
+
+import Foundation
+import CRocksDB
+
+/// Databases opened on first use and closed when idle, within fixed budgets
+///
+/// Built for hosts with many more tenant databases than are active at
+/// once. At most `maxOpenDatabases` are open; opening another closes the
+/// least recently used one no caller is using. All databases share one
+/// block cache, one write buffer manager and the process-wide default
+/// environment with its background thread pools, and split the
+/// `maxOpenFiles` budget evenly so the table caches together stay within
+/// it. Concurrent requests for a database that is still opening wait for
+/// that open instead of racing it for the LOCK file.
+///
+/// Use a database inside `withDatabase(at:_:)`, which keeps it from being
+/// closed until the closure returns:
+///
+///     let pool = try RocksDBPool(maxOpenDatabases: 200)
+///     let value = try pool.withDatabase(at: tenantPath) { db in
+///       try db.get(key)
+///     }
+public final class RocksDBPool: @unchecked Sendable {
+  /// Options every database is opened with
+  public let options: RocksDBOptions
+
+  /// Block cache shared by all databases
+  public let blockCache: RocksDBCache
+
+  /// Memtable budget shared by all databases
+  public let writeBufferManager: RocksDBWriteBufferManager
+
+  /// Maximum number of databases open at once
+  public let maxOpenDatabases: Int
+
+  private let condition = NSCondition()
+  private var entries: [String: Entry] = [:]
+  private var closed = false
+
+  /// Create an empty pool
+  ///
+  /// A cache or write buffer manager already set in `options` is shared as
+  /// given; otherwise the pool creates a 256 MB LRU cache and a manager
+  /// capped at a quarter of it, charged to that cache.
+  /// - Parameters:
+  ///   - options: Options applied to every database (`maxOpenFiles` is replaced)
+  ///   - maxOpenDatabases: Maximum number of databases open at once
+  ///   - maxOpenFiles: Table files all open databases may hold open together
+  /// - Throws: RocksDBError.invalidArgument if the budgets leave a database
+  ///   fewer than 20 open files, the minimum RocksDB accepts
+  public init(options: RocksDBOptions = .default, maxOpenDatabases: Int = 256,
+              maxOpenFiles: Int = 65536) throws {
+    guard maxOpenDatabases > 0 else {
+      throw RocksDBError.invalidArgument("Pool must allow at least one open database")
+    }
+    let filesPerDatabase = maxOpenFiles / maxOpenDatabases
+    guard filesPerDatabase >= 20 else {
+      throw RocksDBError.invalidArgument(
+        "maxOpenFiles \(maxOpenFiles) leaves fewer than 20 files per database")
+    }
+
+    var tableOptions = options.tableOptions ?? RocksDBTableOptions()
+    let cache = tableOptions.blockCache ?? .lru(capacity: 256 * 1024 * 1024)
+    tableOptions.blockCache = cache
+
+    var poolOptions = options
+    poolOptions.tableOptions = tableOptions
+    poolOptions.maxOpenFiles = filesPerDatabase
+    let manager = options.writeBufferManager
+      ?? RocksDBWriteBufferManager(bufferSize: cache.capacity / 4, cache: cache)
+    poolOptions.writeBufferManager = manager
+
+    self.options = poolOptions
+    self.blockCache = cache
+    self.writeBufferManager = manager
+    self.maxOpenDatabases = maxOpenDatabases
+  }
+
+  deinit {
+    close()
+  }
+
+  // MARK: - Access
+
+  /// Run `body` with the database at `path`, opening it first if needed
+  ///
+  /// Blocks while the database is being opened or closed by another
+  /// caller, and while every slot is held by a running `withDatabase`;
+  /// don't nest calls for different databases on a full pool.
+  /// - Parameters:
+  ///   - path: Database directory, created if missing when `createIfMissing` is set
+  ///   - body: Closure using the database; it stays open until the closure returns
+  /// - Returns: Value returned by `body`
+  /// - Throws: RocksDBError if the database cannot be opened, or the error thrown by `body`
+  public func withDatabase<R>(at path: String, _ body: (RocksDB) throws -> R) throws -> R {
+    let key = (path as NSString).standardizingPath
+    let database = try acquire(key)
+    defer { release(key) }
+    return try body(database)
+  }
+
+  /// Number of open databases
+  public var openCount: Int {
+    condition.withLock { entries.values.filter { $0.database != nil }.count }
+  }
+
+  /// Whether the database at `path` is open
+  public func isOpen(at path: String) -> Bool {
+    let key = (path as NSString).standardizingPath
+    return condition.withLock { entries[key]?.database != nil }
+  }
+
+  // MARK: - Closing
+
+  /// Close every database no caller is using that has been idle at least `interval`
+  /// - Parameter interval: Minimum idle time
+  /// - Returns: Number of databases closed
+  @discardableResult
+  public func closeIdle(olderThan interval: TimeInterval) -> Int {
+    let cutoff = DispatchTime.now().uptimeNanoseconds &- UInt64(max(interval, 0) * 1_000_000_000)
+    let victims: [(String, RocksDB)] = condition.withLock {
+      entries.compactMap { key, entry in
+        guard let database = entry.database, entry.leases == 0, !entry.closing,
+              entry.lastUsed <= cutoff else { return nil }
+        entry.closing = true
+        return (key, database)
+      }
+    }
+    victims.forEach { finishClosing($0.0, $0.1) }
+    return victims.count
+  }
+
+  /// Close every database; later `withDatabase` calls throw databaseClosed
+  ///
+  /// Waits for running `withDatabase` calls to return and for opens in
+  /// progress to finish, so it must not be called from inside one.
+  public func close() {
+    let databases: [RocksDB] = condition.withLock {
+      closed = true
+      condition.broadcast()
+      while entries.values.contains(where: { $0.leases > 0 || $0.database == nil || $0.closing }) {
+        condition.wait()
+      }
+      defer { entries.removeAll() }
+      return entries.values.compactMap(\.database)
+    }
+    databases.forEach { $0.close() }
+  }
+
+  // MARK: - Internal Helpers
+
+  /// Pool slot of one database
+  private final class Entry {
+    /// Open database, nil while opening
+    var database: RocksDB?
+    /// Running `withDatabase` calls
+    var leases = 0
+    /// Uptime of the last release, for LRU order and idle closing
+    var lastUsed = DispatchTime.now().uptimeNanoseconds
+    /// Being closed; no new leases are handed out
+    var closing = false
+  }
+
+  private func acquire(_ key: String) throws -> RocksDB {
+    condition.lock()
+    while true {
+      if closed {
+        condition.unlock()
+        throw RocksDBError.databaseClosed
+      }
+      if let entry = entries[key] {
+        if let database = entry.database, !entry.closing {
+          entry.leases += 1
+          condition.unlock()
+          return database
+        }
+        condition.wait()
+        continue
+      }
+      if entries.count < maxOpenDatabases {
+        break
+      }
+      if let (victimKey, victim) = leastRecentlyUsedIdle() {
+        entries[victimKey]?.closing = true
+        condition.unlock()
+        finishClosing(victimKey, victim)
+        condition.lock()
+        continue
+      }
+      condition.wait()
+    }
+
+    let entry = Entry()
+    entries[key] = entry
+    condition.unlock()
+
+    do {
+      let database = try RocksDB.open(at: key, options: options)
+      let poolClosed = condition.withLock {
+        defer { condition.broadcast() }
+        // The pool closed while the database was opening
+        guard !closed else {
+          entries[key] = nil
+          return true
+        }
+        entry.database = database
+        entry.leases = 1
+        return false
+      }
+      if poolClosed {
+        database.close()
+        throw RocksDBError.databaseClosed
+      }
+      return database
+    } catch {
+      condition.withLock {
+        entries[key] = nil
+        condition.broadcast()
+      }
+      throw error
+    }
+  }
+
+  private func release(_ key: String) {
+    condition.withLock {
+      guard let entry = entries[key] else { return }
+      entry.leases -= 1
+      entry.lastUsed = DispatchTime.now().uptimeNanoseconds
+      if entry.leases == 0 {
+        condition.broadcast()
+      }
+    }
+  }
+
+  /// Open database with no leases that was used longest ago; caller holds the lock
+  private func leastRecentlyUsedIdle() -> (String, RocksDB)? {
+    var oldest: (key: String, database: RocksDB, lastUsed: UInt64)?
+    for (key, entry) in entries {
+      guard let database = entry.database, entry.leases == 0, !entry.closing else { continue }
+      if oldest == nil || entry.lastUsed < oldest!.lastUsed {
+        oldest = (key, database, entry.lastUsed)
+      }
+    }
+    return oldest.map { ($0.key, $0.database) }
+  }
+
+  /// Close a database marked as closing, outside the lock, and free its slot
+  private func finishClosing(_ key: String, _ database: RocksDB) {
+    database.close()
+    condition.withLock {
+      entries[key] = nil
+      condition.broadcast()
+    }
+  }
+}
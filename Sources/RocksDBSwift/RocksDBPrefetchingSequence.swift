@@ -0,0 +1,292 @@
+//
+//  RocksDBPrefetchingSequence.swift
+//  RocksDB.swift
+//
+//  AsyncSequence over an iterator that reads ahead on the I/O thread pool
+//
+
+import Foundation
+import CRocksDB
+
+/// Async sequence of key-value pairs that fetches batches ahead of the consumer
+///
+/// Batches are read with `RocksDBIterator.nextBatch` on the bridge I/O
+/// thread pool, so while the consumer processes one batch the next is
+/// already being read. At most `bufferedBatches` batches are held
+/// unconsumed; a slow consumer pauses the read-ahead rather than letting
+/// it grow without bound. Cancelling the consuming task, or dropping its
+/// iterator, stops the read-ahead once the batch being read completes.
+public struct RocksDBPrefetchingSequence: AsyncSequence, Sendable {
+  public typealias Element = (key: Data, value: Data)
+
+  private let iterator: RocksDBIterator
+  private let database: RocksDB?
+  private let start: Data?
+  private let batchSize: Int
+  private let byteBudget: Int
+  private let bufferedBatches: Int
+
+  internal init(
+    iterator: RocksDBIterator,
+    database: RocksDB? = nil,
+    start: Data?,
+    batchSize: Int,
+    byteBudget: Int,
+    bufferedBatches: Int
+  ) {
+    self.iterator = iterator
+    self.database = database
+    self.start = start
+    self.batchSize = Swift.max(batchSize, 1)
+    self.byteBudget = byteBudget
+    self.bufferedBatches = Swift.max(bufferedBatches, 1)
+  }
+
+  /// Iterator handing out buffered entries and awaiting the next batch
+  public struct AsyncIterator: AsyncIteratorProtocol {
+    private let reader: Reader
+    private var batch: [Element] = []
+    private var index = 0
+
+    fileprivate init(_ prefetcher: Prefetcher) {
+      self.reader = Reader(prefetcher)
+    }
+
+    public mutating func next() async throws -> Element? {
+      if index == batch.count {
+        try Task.checkCancellation()
+        let prefetcher = reader.prefetcher
+        let next = try await withTaskCancellationHandler {
+          try await prefetcher.take()
+        } onCancel: {
+          prefetcher.cancel()
+        }
+        guard let next else { return nil }
+        batch = next
+        index = 0
+      }
+
+      defer { index += 1 }
+      return batch[index]
+    }
+  }
+
+  public func makeAsyncIterator() -> AsyncIterator {
+    AsyncIterator(Prefetcher(iterator: iterator, database: database, start: start,
+                             batchSize: batchSize, byteBudget: byteBudget,
+                             capacity: bufferedBatches))
+  }
+
+  /// Stops the read-ahead when the last copy of an iterator is gone
+  private final class Reader {
+    let prefetcher: Prefetcher
+
+    init(_ prefetcher: Prefetcher) {
+      self.prefetcher = prefetcher
+    }
+
+    deinit {
+      prefetcher.cancelAndJoin()
+    }
+  }
+}
+
+// MARK: - Prefetcher
+
+/// Read-ahead state shared by the consumer and the pool job filling batches
+///
+/// Only one fetch job runs at a time, so the native iterator is never
+/// stepped concurrently. Each read holds the database open, so `close()`
+/// waits for it and later reads fail with databaseClosed.
+private final class Prefetcher: @unchecked Sendable {
+  typealias Batch = [RocksDBPrefetchingSequence.Element]
+
+  private let iterator: RocksDBIterator
+  private let database: RocksDB?
+  private let start: Data?
+  private let batchSize: Int
+  private let byteBudget: Int
+  private let capacity: Int
+
+  private let lock = NSCondition()
+  private var ready: [Batch] = []
+  private var fetching = false
+  private var positioned = false
+  private var finished = false
+  private var cancelled = false
+  private var failure: Error?
+  private var waiter: CheckedContinuation<Batch?, Error>?
+
+  init(iterator: RocksDBIterator, database: RocksDB?, start: Data?, batchSize: Int,
+       byteBudget: Int, capacity: Int) {
+    self.iterator = iterator
+    self.database = database
+    self.start = start
+    self.batchSize = batchSize
+    self.byteBudget = byteBudget
+    self.capacity = capacity
+  }
+
+  /// Next batch, waiting for the fetch in flight if none is buffered
+  /// - Returns: Entries in iteration order, or nil at the end of the scan
+  func take() async throws -> Batch? {
+    try await withCheckedThrowingContinuation { continuation in
+      let result: Result<Batch?, Error>? = lock.withLock {
+        defer { scheduleLocked() }
+        if let outcome = outcomeLocked() {
+          return outcome
+        }
+        waiter = continuation
+        return nil
+      }
+      if let result {
+        continuation.resume(with: result)
+      }
+    }
+  }
+
+  /// Stop reading ahead; a waiting or later `take()` throws CancellationError
+  func cancel() {
+    let waiting: CheckedContinuation<Batch?, Error>? = lock.withLock {
+      cancelled = true
+      defer { waiter = nil }
+      return waiter
+    }
+    waiting?.resume(throwing: CancellationError())
+  }
+
+  /// Cancel and wait for the fetch in flight to return
+  func cancelAndJoin() {
+    cancel()
+    lock.withLock {
+      while fetching {
+        lock.wait()
+      }
+    }
+  }
+
+  /// Buffered batch, error or end of scan, if the consumer need not wait
+  private func outcomeLocked() -> Result<Batch?, Error>? {
+    if cancelled {
+      return .failure(CancellationError())
+    }
+    if !ready.isEmpty {
+      return .success(ready.removeFirst())
+    }
+    if let failure {
+      return .failure(failure)
+    }
+    return finished ? .success(nil) : nil
+  }
+
+  /// Start a fetch if none is running and the buffer has room
+  private func scheduleLocked() {
+    guard !fetching, !finished, !cancelled, ready.count < capacity else { return }
+    fetching = true
+    RocksDBIOPool.submit { self.fetch() }
+  }
+
+  /// Read one batch on an I/O thread and hand it to a waiting consumer
+  private func fetch() {
+    var batch: Batch = []
+    var error: Error?
+    if !lock.withLock({ cancelled }) {
+      do {
+        batch = try database.map { try $0.whileOpen(readBatch) } ?? readBatch()
+      } catch let readError {
+        error = readError
+      }
+    }
+
+    let resumption: (CheckedContinuation<Batch?, Error>, Result<Batch?, Error>)? = lock.withLock {
+      fetching = false
+      lock.broadcast()
+      if cancelled {
+        return nil
+      }
+      if batch.isEmpty {
+        finished = true
+        failure = error
+      } else {
+        ready.append(batch)
+      }
+      defer { scheduleLocked() }
+
+      guard let waiting = waiter, let outcome = outcomeLocked() else { return nil }
+      waiter = nil
+      return (waiting, outcome)
+    }
+
+    if case let (continuation, result)? = resumption {
+      continuation.resume(with: result)
+    }
+  }
+
+  /// Next batch of the native iterator; empty at the end of the scan
+  private func readBatch() throws -> Batch {
+    if !positioned {
+      positioned = true
+      if let start {
+        iterator.seek(to: start)
+      } else {
+        iterator.seekToFirst()
+      }
+    }
+
+    let batch = iterator.nextBatch(maxEntries: batchSize, byteBudget: byteBudget)
+    if batch.isEmpty {
+      try iterator.checkStatus()
+    }
+    return batch
+  }
+}
+
+// MARK: - Factories
+
+extension RocksDBIterator {
+  /// Scan from the first key with batches read ahead on the I/O thread pool
+  ///
+  /// Do not move the iterator while the sequence is being consumed.
+  /// - Parameters:
+  ///   - batchSize: Entries fetched per batch
+  ///   - byteBudget: Approximate key + value bytes per batch
+  ///   - bufferedBatches: Batches held ahead of the consumer (default: 2)
+  /// - Returns: Async sequence of key-value pairs
+  public func prefetching(
+    batchSize: Int = RocksDBIterator.defaultBatchSize,
+    byteBudget: Int = RocksDBIterator.defaultBatchByteBudget,
+    bufferedBatches: Int = 2
+  ) -> RocksDBPrefetchingSequence {
+    RocksDBPrefetchingSequence(iterator: self, start: nil, batchSize: batchSize,
+                               byteBudget: byteBudget, bufferedBatches: bufferedBatches)
+  }
+}
+
+extension RocksDB {
+  /// Scan a key range with batches read ahead on the I/O thread pool
+  /// - Parameters:
+  ///   - range: Half-open key range to scan
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options (bounds are replaced by `range`)
+  ///   - batchSize: Entries fetched per batch
+  ///   - bufferedBatches: Batches held ahead of the consumer (default: 2)
+  /// - Returns: Async sequence of key-value pairs in key order
+  /// - Throws: RocksDBError if the iterator cannot be created
+  public func prefetchingScan(
+    _ range: RocksDBKeyRange = .all,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBReadOptions = .scan,
+    batchSize: Int = RocksDBIterator.defaultBatchSize,
+    bufferedBatches: Int = 2
+  ) throws -> RocksDBPrefetchingSequence {
+    var boundedOptions = options
+    boundedOptions.iterateLowerBound = range.start
+    boundedOptions.iterateUpperBound = range.end
+
+    let iter = try makeIterator(in: columnFamily, options: boundedOptions)
+    return RocksDBPrefetchingSequence(iterator: iter, database: self, start: range.start,
+                                      batchSize: batchSize,
+                                      byteBudget: RocksDBIterator.defaultBatchByteBudget,
+                                      bufferedBatches: bufferedBatches)
+  }
+}
@@ -0,0 +1,85 @@
+//
+//  RocksDBProperties.swift
+//  RocksDB.swift
+//
+//  Typed names of RocksDB's integer and map properties
+//
+
+import Foundation
+
+/// Properties with an integer form, read without string formatting
+public enum RocksDBIntProperty: String, CaseIterable, Sendable {
+  case numImmutableMemTables = "rocksdb.num-immutable-mem-table"
+  case numImmutableMemTablesFlushed = "rocksdb.num-immutable-mem-table-flushed"
+  case memTableFlushPending = "rocksdb.mem-table-flush-pending"
+  case numRunningFlushes = "rocksdb.num-running-flushes"
+  case compactionPending = "rocksdb.compaction-pending"
+  case numRunningCompactions = "rocksdb.num-running-compactions"
+  case backgroundErrors = "rocksdb.background-errors"
+
+  /// Bytes of the active memtable
+  case curSizeActiveMemTable = "rocksdb.cur-size-active-mem-table"
+  /// Bytes of the active and unflushed immutable memtables
+  case curSizeAllMemTables = "rocksdb.cur-size-all-mem-tables"
+  /// Bytes of all memtables, including flushed ones still pinned
+  case sizeAllMemTables = "rocksdb.size-all-mem-tables"
+  case numEntriesActiveMemTable = "rocksdb.num-entries-active-mem-table"
+  case numEntriesImmMemTables = "rocksdb.num-entries-imm-mem-tables"
+  case numDeletesActiveMemTable = "rocksdb.num-deletes-active-mem-table"
+  case numDeletesImmMemTables = "rocksdb.num-deletes-imm-mem-tables"
+
+  case estimateNumKeys = "rocksdb.estimate-num-keys"
+  /// Memory held by table readers outside the block cache
+  case estimateTableReadersMem = "rocksdb.estimate-table-readers-mem"
+  case estimateLiveDataSize = "rocksdb.estimate-live-data-size"
+  case estimatePendingCompactionBytes = "rocksdb.estimate-pending-compaction-bytes"
+  case estimateOldestKeyTime = "rocksdb.estimate-oldest-key-time"
+
+  case isFileDeletionsEnabled = "rocksdb.is-file-deletions-enabled"
+  case numSnapshots = "rocksdb.num-snapshots"
+  case oldestSnapshotTime = "rocksdb.oldest-snapshot-time"
+  case oldestSnapshotSequence = "rocksdb.oldest-snapshot-sequence"
+  case numLiveVersions = "rocksdb.num-live-versions"
+  case currentSuperVersionNumber = "rocksdb.current-super-version-number"
+  case minLogNumberToKeep = "rocksdb.min-log-number-to-keep"
+  case minObsoleteSstNumberToKeep = "rocksdb.min-obsolete-sst-number-to-keep"
+  case baseLevel = "rocksdb.base-level"
+
+  case totalSstFilesSize = "rocksdb.total-sst-files-size"
+  case liveSstFilesSize = "rocksdb.live-sst-files-size"
+  case obsoleteSstFilesSize = "rocksdb.obsolete-sst-files-size"
+
+  /// Bytes per second writes are throttled to, 0 when not delayed
+  case actualDelayedWriteRate = "rocksdb.actual-delayed-write-rate"
+  case isWriteStopped = "rocksdb.is-write-stopped"
+
+  case blockCacheCapacity = "rocksdb.block-cache-capacity"
+  case blockCacheUsage = "rocksdb.block-cache-usage"
+  case blockCachePinnedUsage = "rocksdb.block-cache-pinned-usage"
+
+  case numBlobFiles = "rocksdb.num-blob-files"
+  case totalBlobFileSize = "rocksdb.total-blob-file-size"
+  case liveBlobFileSize = "rocksdb.live-blob-file-size"
+  case liveBlobFileGarbageSize = "rocksdb.live-blob-file-garbage-size"
+  case blobCacheCapacity = "rocksdb.blob-cache-capacity"
+  case blobCacheUsage = "rocksdb.blob-cache-usage"
+  case blobCachePinnedUsage = "rocksdb.blob-cache-pinned-usage"
+}
+
+/// Properties with a structured key/value form
+public enum RocksDBMapProperty: String, CaseIterable, Sendable {
+  /// Per-level compaction stats and write stall counters of a column family
+  case cfStats = "rocksdb.cfstats"
+  /// Write stall counts of a column family, by cause
+  case cfWriteStallStats = "rocksdb.cf-write-stall-stats"
+  /// Database-wide write stall counts, by cause
+  case dbWriteStallStats = "rocksdb.db-write-stall-stats"
+  /// Database-wide write, WAL and stall stats
+  case dbStats = "rocksdb.dbstats"
+  /// Block cache usage by entry role (data, filter, index, ...)
+  case blockCacheEntryStats = "rocksdb.block-cache-entry-stats"
+  /// Same as `blockCacheEntryStats`, refreshed less eagerly
+  case fastBlockCacheEntryStats = "rocksdb.fast-block-cache-entry-stats"
+  /// Table properties summed over all live SST files
+  case aggregatedTableProperties = "rocksdb.aggregated-table-properties"
+}
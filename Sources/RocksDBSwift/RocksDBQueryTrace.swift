@@ -0,0 +1,104 @@
+//
+//  RocksDBQueryTrace.swift
+//  RocksDB.swift
+//
+//  Options and results for capturing and replaying query traces
+//
+
+import Foundation
+import CRocksDB
+
+/// Operations to leave out of a query trace
+public struct RocksDBTraceFilter: OptionSet, Sendable {
+  public let rawValue: UInt64
+
+  public init(rawValue: UInt64) {
+    self.rawValue = rawValue
+  }
+
+  public static let gets = RocksDBTraceFilter(rawValue: UInt64(RocksDBTraceFilterGet.rawValue))
+  public static let writes = RocksDBTraceFilter(rawValue: UInt64(RocksDBTraceFilterWrite.rawValue))
+  public static let iteratorSeeks = RocksDBTraceFilter(rawValue: UInt64(RocksDBTraceFilterIteratorSeek.rawValue))
+  public static let iteratorSeeksForPrev = RocksDBTraceFilter(
+    rawValue: UInt64(RocksDBTraceFilterIteratorSeekForPrev.rawValue))
+  public static let multiGets = RocksDBTraceFilter(rawValue: UInt64(RocksDBTraceFilterMultiGet.rawValue))
+}
+
+/// Options for `RocksDB.startTrace(to:options:)`
+public struct RocksDBTraceOptions: Sendable {
+  /// Record one in this many operations
+  public var samplingFrequency: Int = 1
+
+  /// Tracing stops once the trace file reaches this many bytes
+  public var maxTraceSize: UInt64 = 64 * 1024 * 1024 * 1024
+
+  /// Operations that are not recorded (applied before sampling)
+  public var excluded: RocksDBTraceFilter = []
+
+  /// Record writes in WAL order, at some cost to write throughput
+  public var preserveWriteOrder: Bool = false
+
+  public init() {}
+
+  public static let `default` = RocksDBTraceOptions()
+}
+
+/// Latency of one kind of replayed operation, in microseconds
+public struct RocksDBReplayLatency: Sendable, Equatable {
+  public var count: UInt64
+  /// Executions that failed, not counting lookups that found nothing
+  public var errors: UInt64
+  public var totalMicros: UInt64
+  public var p50Micros: UInt64
+  public var p95Micros: UInt64
+  public var p99Micros: UInt64
+  public var maxMicros: UInt64
+
+  init(_ values: RocksDBReplayLatencyValues) {
+    count = values.count
+    errors = values.errors
+    totalMicros = values.total_us
+    p50Micros = values.p50_us
+    p95Micros = values.p95_us
+    p99Micros = values.p99_us
+    maxMicros = values.max_us
+  }
+
+  public var averageMicros: Double {
+    count == 0 ? 0 : Double(totalMicros) / Double(count)
+  }
+}
+
+/// Outcome of `RocksDB.replayTrace(from:threads:speedup:)`
+public struct RocksDBReplayResult: Sendable, Equatable {
+  /// Wall-clock duration of the replay
+  public var elapsed: TimeInterval
+
+  /// Records that could not be executed at all
+  public var failedRecords: UInt64
+
+  public var gets: RocksDBReplayLatency
+  public var multiGets: RocksDBReplayLatency
+  public var writes: RocksDBReplayLatency
+  /// Seek and SeekForPrev
+  public var iteratorSeeks: RocksDBReplayLatency
+
+  init(_ values: RocksDBReplayValues) {
+    elapsed = TimeInterval(values.elapsed_us) / 1_000_000
+    failedRecords = values.failed_records
+    gets = RocksDBReplayLatency(values.get)
+    multiGets = RocksDBReplayLatency(values.multi_get)
+    writes = RocksDBReplayLatency(values.write)
+    iteratorSeeks = RocksDBReplayLatency(values.iterator_seek)
+  }
+
+  /// Operations executed
+  public var operations: UInt64 {
+    gets.count + multiGets.count + writes.count + iteratorSeeks.count
+  }
+
+  /// Operations per second of wall-clock time
+  public var throughput: Double {
+    elapsed > 0 ? Double(operations) / elapsed : 0
+  }
+}
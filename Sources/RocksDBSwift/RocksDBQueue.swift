@@ -0,0 +1,257 @@
+//
+//  RocksDBQueue.swift
+//  RocksDB.swift
+//
+//  Durable FIFO queue over a RocksDB database
+//
+
+import Foundation
+
+/// Durable work queue with constant-cost dequeues
+///
+/// Items are stored under monotonically increasing sequence numbers and
+/// read back through one long-lived tailing iterator bounded to the item
+/// keys, so a dequeue seeks straight to the head instead of building a new
+/// view of the database. Consumed items are never deleted one by one:
+/// every `trimInterval` dequeued items, the queue persists the head and
+/// drops everything before it with a single range tombstone, then deletes
+/// the SST files that held only consumed items. Seeks never cross
+/// tombstone runs, so dequeue latency does not grow with the history
+/// consumed.
+///
+/// Delivery is at least once: items dequeued since the last trim are
+/// dequeued again after a crash. Call `trim()` to commit progress sooner.
+///
+///     let queue = try RocksDBQueue.open(at: path)
+///     try queue.enqueue(jobs.map(\.payload))
+///     for item in try queue.dequeue(max: 64) {
+///       try process(item.value)
+///     }
+public final class RocksDBQueue: @unchecked Sendable {
+  /// Database holding the queue
+  public let database: RocksDB
+
+  /// Dequeued items between automatic trims (0 trims only on `trim()`)
+  public let trimInterval: Int
+
+  private let enqueueLock = NSLock()
+  private let dequeueLock = NSLock()
+  private let iterator: RocksDBIterator
+
+  /// Sequence number of the next enqueued item (guarded by enqueueLock)
+  private var tail: UInt64
+  /// Sequence number of the next dequeued item (guarded by dequeueLock)
+  private var head: UInt64
+  /// Head as of the last trim (guarded by dequeueLock)
+  private var trimmedHead: UInt64
+
+  private init(database: RocksDB, trimInterval: Int, iterator: RocksDBIterator, head: UInt64, tail: UInt64) {
+    self.database = database
+    self.trimInterval = trimInterval
+    self.iterator = iterator
+    self.head = head
+    self.trimmedHead = head
+    self.tail = tail
+  }
+
+  deinit {
+    iterator.close()
+  }
+
+  // MARK: - Factory Methods
+
+  /// Options for queue workloads
+  ///
+  /// The database defaults: `trim()` drops consumed items with one range
+  /// tombstone and deletes the files they filled, so no point tombstones
+  /// build up for deletion-triggered compaction to collect.
+  public static var defaultOptions: RocksDBOptions {
+    RocksDBOptions.default
+  }
+
+  /// Open or create a queue
+  /// - Parameters:
+  ///   - path: Database directory
+  ///   - options: Database options (bytewise comparator only)
+  ///   - trimInterval: Dequeued items between automatic trims
+  /// - Returns: Open queue, positioned after the last trimmed item
+  /// - Throws: RocksDBError on failure
+  public static func open(
+    at path: String,
+    options: RocksDBOptions = RocksDBQueue.defaultOptions,
+    trimInterval: Int = 1024
+  ) throws -> RocksDBQueue {
+    guard options.comparator == .bytewise else {
+      throw RocksDBError.invalidArgument("Queues require the bytewise comparator")
+    }
+
+    let database = try RocksDB.open(at: path, options: options)
+    do {
+      let head = try database.get(headKey).flatMap(decodeSequence) ?? 0
+
+      // The last item, if any, fixes where enqueueing resumes
+      var lastOptions = RocksDBReadOptions()
+      lastOptions.iterateLowerBound = itemKey(head)
+      lastOptions.iterateUpperBound = itemsEnd
+      let last = try database.makeIterator(options: lastOptions)
+      defer { last.close() }
+      last.seekToLast()
+      try last.checkStatus()
+      let tail = last.key.flatMap(decodeItemKey).map { $0 + 1 } ?? head
+
+      var tailingOptions = RocksDBReadOptions()
+      tailingOptions.tailing = true
+      tailingOptions.iterateLowerBound = itemsStart
+      tailingOptions.iterateUpperBound = itemsEnd
+      let iterator = try database.makeIterator(options: tailingOptions)
+
+      return RocksDBQueue(database: database, trimInterval: max(trimInterval, 0),
+                          iterator: iterator, head: head, tail: tail)
+    } catch {
+      database.close()
+      throw error
+    }
+  }
+
+  /// Trim consumed items and close the database
+  public func close() {
+    try? trim()
+    iterator.close()
+    database.close()
+  }
+
+  // MARK: - Enqueue
+
+  /// Append one item
+  /// - Parameters:
+  ///   - value: Item payload
+  ///   - options: Write options
+  /// - Returns: Sequence number of the item
+  /// - Throws: RocksDBError on failure
+  @discardableResult
+  public func enqueue(_ value: Data, options: RocksDBWriteOptions = .default) throws -> UInt64 {
+    try enqueue([value], options: options).lowerBound
+  }
+
+  /// Append items in order with one atomic write
+  ///
+  /// Enqueues are serialized so sequence numbers become visible in order
+  /// and a consumer never skips over an item still being written; batch
+  /// items to amortize that.
+  /// - Parameters:
+  ///   - values: Item payloads
+  ///   - options: Write options
+  /// - Returns: Sequence numbers of the items (empty for no items)
+  /// - Throws: RocksDBError on failure
+  @discardableResult
+  public func enqueue(_ values: [Data], options: RocksDBWriteOptions = .default) throws -> Range<UInt64> {
+    try enqueueLock.withLock {
+      let first = tail
+      guard !values.isEmpty else { return first..<first }
+
+      var builder = RocksDBBatchBuilder()
+      for (offset, value) in values.enumerated() {
+        builder.put(value, forKey: Self.itemKey(first + UInt64(offset)))
+      }
+      try database.writeBatch(builder, options: options)
+      tail = first + UInt64(values.count)
+      return first..<tail
+    }
+  }
+
+  // MARK: - Dequeue
+
+  /// Remove up to `max` items from the head
+  /// - Parameter max: Maximum number of items to return
+  /// - Returns: Items in enqueue order, empty when the queue is empty
+  /// - Throws: RocksDBError on failure
+  public func dequeue(max: Int = 1) throws -> [(sequence: UInt64, value: Data)] {
+    guard max > 0 else { return [] }
+
+    let items: [(sequence: UInt64, value: Data)] = try dequeueLock.withLock {
+      iterator.seek(to: Self.itemKey(head))
+      let entries = iterator.nextBatch(maxEntries: max)
+      try iterator.checkStatus()
+
+      let items = entries.compactMap { entry in
+        Self.decodeItemKey(entry.key).map { (sequence: $0, value: entry.value) }
+      }
+      if let last = items.last {
+        head = last.sequence + 1
+      }
+      return items
+    }
+
+    if trimInterval > 0, pendingTrim >= UInt64(trimInterval) {
+      try trim()
+    }
+    return items
+  }
+
+  /// Items enqueued and not yet dequeued
+  ///
+  /// A snapshot: items being enqueued can be dequeued before `tail` moves
+  /// past them, so a racing dequeue briefly puts the head ahead of the
+  /// tail, which counts as empty.
+  public var count: Int {
+    let head = dequeueLock.withLock { self.head }
+    let tail = enqueueLock.withLock { self.tail }
+    return tail > head ? Int(tail - head) : 0
+  }
+
+  // MARK: - Trimming
+
+  /// Persist the head and drop every dequeued item
+  ///
+  /// Writes the new head together with one range tombstone over the
+  /// consumed items, then deletes the SST files that hold only those items
+  /// so their space is freed without waiting for compaction.
+  /// - Throws: RocksDBError on failure
+  public func trim() throws {
+    let range: (from: UInt64, to: UInt64)? = try dequeueLock.withLock {
+      guard head > trimmedHead else { return nil }
+      let range = (from: trimmedHead, to: head)
+      try database.batch { batch in
+        batch.put(Self.encodeSequence(range.to), forKey: Self.headKey)
+        batch.deleteRange(from: Self.itemKey(range.from), to: Self.itemKey(range.to))
+      }
+      trimmedHead = range.to
+      return range
+    }
+
+    if let range {
+      try database.deleteFiles(in: [RocksDBKeyRange(start: Self.itemsStart, end: Self.itemKey(range.to))])
+    }
+  }
+
+  // MARK: - Internal Helpers
+
+  private var pendingTrim: UInt64 {
+    dequeueLock.withLock { head - trimmedHead }
+  }
+
+  /// Key of the persisted head, ordered before every item
+  private static let headKey = Data([0x00]) + Data("head".utf8)
+
+  /// Item keys are 0x01 followed by the big-endian sequence number
+  private static let itemsStart = Data([0x01])
+  private static let itemsEnd = Data([0x02])
+
+  private static func itemKey(_ sequence: UInt64) -> Data {
+    itemsStart + encodeSequence(sequence)
+  }
+
+  private static func decodeItemKey(_ key: Data) -> UInt64? {
+    guard key.first == 0x01 else { return nil }
+    return decodeSequence(key.dropFirst())
+  }
+
+  private static func encodeSequence(_ sequence: UInt64) -> Data {
+    withUnsafeBytes(of: sequence.bigEndian) { Data($0) }
+  }
+
+  private static func decodeSequence(_ data: Data) -> UInt64? {
+    guard data.count == MemoryLayout<UInt64>.size else { return nil }
+    return data.reduce(0) { $0 << 8 | UInt64($1) }
+  }
+}
@@ -0,0 +1,82 @@
+//
+//  RocksDBRateLimiter.swift
+//  RocksDB.swift
+//
+//  Shared background I/O rate limiter for RocksDB databases
+//
+
+import Foundation
+import CRocksDB
+
+/// Which I/O a rate limiter throttles
+public enum RocksDBRateLimiterMode: Int32, Sendable {
+  /// Throttle reads only
+  case readsOnly = 0
+  /// Throttle writes only (flush and compaction output, default)
+  case writesOnly = 1
+  /// Throttle both reads and writes
+  case allIo = 2
+}
+
+/// Priority a rate-limited request is queued at
+public enum RocksDBIOPriority: Int32, Sendable {
+  /// Compaction reads and writes
+  case low = 0
+  case mid = 1
+  /// Flush writes
+  case high = 2
+  /// Foreground requests, served before all others
+  case user = 3
+}
+
+/// Token-bucket limiter for background flush and compaction I/O
+///
+/// Assign the same limiter to `RocksDBOptions.rateLimiter` of several
+/// databases to cap their combined background I/O. Each database keeps the
+/// native limiter alive for as long as it is open. Reads made with
+/// `RocksDBReadOptions.rateLimiterPriority` set are charged too, in modes
+/// that throttle reads.
+public final class RocksDBRateLimiter: @unchecked Sendable {
+  internal let handle: RocksDBRateLimiterRef
+
+  /// Create a rate limiter
+  /// - Parameters:
+  ///   - bytesPerSecond: Maximum background I/O rate
+  ///   - refillPeriod: Token refill period in microseconds
+  ///   - fairness: Low-priority requests get 1/fairness of the chances of high-priority ones
+  ///   - mode: Which I/O is throttled
+  ///   - autoTuned: Adapt the effective rate (up to `bytesPerSecond`) to demand
+  public init(
+    bytesPerSecond: Int64,
+    refillPeriod: Int64 = 100 * 1000,
+    fairness: Int32 = 10,
+    mode: RocksDBRateLimiterMode = .writesOnly,
+    autoTuned: Bool = false
+  ) {
+    self.handle = rocksdb_rate_limiter_create(bytesPerSecond, refillPeriod, fairness,
+                                              mode.rawValue, autoTuned ? 1 : 0)!
+  }
+
+  deinit {
+    rocksdb_rate_limiter_destroy(handle)
+  }
+
+  // MARK: - Properties
+
+  /// Rate limit in bytes per second; may be changed at runtime
+  /// (e.g. to throttle harder during peak hours). Must be positive.
+  public var bytesPerSecond: Int64 {
+    get { rocksdb_rate_limiter_get_bytes_per_second(handle) }
+    set { rocksdb_rate_limiter_set_bytes_per_second(handle, newValue) }
+  }
+
+  /// Total bytes that passed through the limiter
+  public var totalBytesThrough: Int64 {
+    rocksdb_rate_limiter_get_total_bytes_through(handle)
+  }
+
+  /// Total requests that passed through the limiter
+  public var totalRequests: Int64 {
+    rocksdb_rate_limiter_get_total_requests(handle)
+  }
+}
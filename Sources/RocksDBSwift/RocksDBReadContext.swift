@@ -0,0 +1,37 @@
+//
+//  RocksDBReadContext.swift
+//  RocksDB.swift
+//
+//  Reusable lookup state for allocation-free point reads
+//
+
+import Foundation
+import CRocksDB
+
+/// Lookup state a thread or task creates once and reuses for every read
+///
+/// Owns a copy of the read options, the value slice `get` fills and the
+/// scratch vectors `multiGet` fills, so steady-state lookups through a
+/// context do no heap allocation in the bridge. Values are copied out (or
+/// lent to `withValue`) before the call returns.
+///
+/// A context is not thread-safe: give each thread or task its own.
+public final class RocksDBReadContext {
+  internal let handle: RocksDBReadContextRef
+
+  /// Read options every lookup through this context uses
+  public let options: RocksDBReadOptions
+
+  /// Create a read context
+  /// - Parameter options: Read options for lookups through this context
+  public init(options: RocksDBReadOptions = .default) {
+    // The native copy references bounds and snapshot held by the options
+    // storage, which `options` keeps alive
+    self.options = options
+    self.handle = rocksdb_read_context_create(options.handle)!
+  }
+
+  deinit {
+    rocksdb_read_context_destroy(handle)
+  }
+}
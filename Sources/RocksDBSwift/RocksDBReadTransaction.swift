@@ -0,0 +1,105 @@
+//
+//  RocksDBReadTransaction.swift
+//  RocksDB.swift
+//
+//  Snapshot-backed read-only transactions
+//
+
+import Foundation
+import CRocksDB
+
+/// Read-only transaction: consistent multi-key reads without write tracking
+///
+/// Every read sees the database as of one snapshot. There is no native
+/// transaction object, write batch or conflict tracking behind it, so it
+/// costs a snapshot plus the reads themselves, and it works on databases
+/// opened without transaction support. Writes are not offered at all.
+public final class RocksDBReadTransaction: @unchecked Sendable {
+  /// Database read from
+  public let database: RocksDB
+
+  /// Snapshot every read is served from
+  public let snapshot: RocksDBSnapshot
+
+  /// Default options bound to the snapshot, built once for all plain reads
+  private let snapshotOptions: RocksDBReadOptions
+
+  internal init(database: RocksDB, snapshot: RocksDBSnapshot) {
+    self.database = database
+    self.snapshot = snapshot
+    var options = RocksDBReadOptions()
+    options.snapshot = snapshot
+    self.snapshotOptions = options
+  }
+
+  // MARK: - Read Operations
+
+  /// Get value for key as of the snapshot
+  /// - Parameters:
+  ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options (their snapshot is replaced)
+  /// - Returns: Value data or nil if not found
+  /// - Throws: RocksDBError on failure
+  public func get(_ key: Data, in columnFamily: RocksDBColumnFamily? = nil,
+                  options: RocksDBReadOptions = .default) throws -> Data? {
+    try database.get(key, in: columnFamily, options: pinned(options))
+  }
+
+  /// Get string value for string key as of the snapshot (nil if missing or not valid UTF-8)
+  public func getString(_ key: String, options: RocksDBReadOptions = .default) throws -> String? {
+    try database.getString(key, options: pinned(options))
+  }
+
+  /// Get values for many keys as of the snapshot in one batched lookup
+  /// - Parameters:
+  ///   - keys: Keys to look up
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options (their snapshot is replaced)
+  /// - Returns: Values in the same order as `keys`, nil for missing keys
+  /// - Throws: RocksDBError if any lookup fails with an error other than not found
+  public func multiGet(_ keys: [Data], in columnFamily: RocksDBColumnFamily? = nil,
+                       options: RocksDBReadOptions = .default) throws -> [Data?] {
+    try database.multiGet(keys, in: columnFamily, options: pinned(options))
+  }
+
+  // MARK: - Iterator
+
+  /// Create an iterator over the database as of the snapshot
+  /// - Parameters:
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options (their snapshot is replaced)
+  /// - Returns: Database iterator
+  /// - Throws: RocksDBError on failure
+  public func makeIterator(in columnFamily: RocksDBColumnFamily? = nil,
+                           options: RocksDBReadOptions = .default) throws -> RocksDBIterator {
+    try database.makeIterator(in: columnFamily, options: pinned(options))
+  }
+
+  /// Iterate over key-value pairs in a key range as of the snapshot
+  /// - Parameters:
+  ///   - range: Half-open key range to scan
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options (bounds and snapshot are replaced)
+  ///   - body: Closure called for each key-value pair, return false to stop
+  /// - Throws: RocksDBError on failure
+  public func forEach(
+    in range: RocksDBKeyRange,
+    of columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBReadOptions = .default,
+    _ body: (Data, Data) throws -> Bool
+  ) throws {
+    try database.forEach(in: range, of: columnFamily, options: pinned(options), body)
+  }
+
+  // MARK: - Private
+
+  private func pinned(_ options: RocksDBReadOptions) -> RocksDBReadOptions {
+    if options.isDefault {
+      return snapshotOptions
+    }
+    var readOptions = options
+    readOptions.snapshot = snapshot
+    return readOptions
+  }
+}
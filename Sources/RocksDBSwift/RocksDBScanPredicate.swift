@@ -0,0 +1,192 @@
+//
+//  RocksDBScanPredicate.swift
+//  RocksDB.swift
+//
+//  Declarative scan filters evaluated inside the bridge
+//
+
+import Foundation
+import CRocksDB
+
+/// Condition on a key-value pair that a scan evaluates without leaving C++
+///
+/// Byte windows start `offset` bytes into the key or value, or end `offset`
+/// bytes before its end with `fromEnd`, and are as long as the operand.
+/// Entries too short for a window or field never match that condition, so
+/// `.not` of it does.
+///
+///     // Events of type 0x02 in a time window, from two regions
+///     let predicate: RocksDBScanPredicate = try .and([
+///       .bytes(.value, .equal, Data([0x02])),
+///       .integer(.value, .integer(UInt64.self, at: 1, byteOrder: .bigEndian),
+///                .greaterOrEqual, Int64(from)),
+///       .bytesIn(.key, fromEnd: true, [Data("eu".utf8), Data("us".utf8)]),
+///     ])
+public indirect enum RocksDBScanPredicate: Sendable, Equatable {
+  /// Part of the entry a condition tests
+  public enum Part: Sendable {
+    case key
+    case value
+  }
+
+  /// Comparison of the entry's bytes or field with the operand
+  public enum Comparison: Sendable {
+    case equal
+    case notEqual
+    case less
+    case lessOrEqual
+    case greater
+    case greaterOrEqual
+  }
+
+  /// Compare a window of the key or value with `operand` in byte order
+  case bytes(Part, at: Int = 0, fromEnd: Bool = false, Comparison, Data)
+
+  /// Compare an integer field with a constant, using the field's signedness
+  /// (pass `Int64(bitPattern:)` of large unsigned constants)
+  case integer(Part, RocksDBAggregateField, Comparison, Int64)
+
+  /// Window of the key or value equals one of the operands, which may have
+  /// different lengths; at offset 0 this is a prefix-in-set test, and with
+  /// `fromEnd` a suffix-in-set test
+  case bytesIn(Part, at: Int = 0, fromEnd: Bool = false, Set<Data>)
+
+  /// Every condition holds (true when empty)
+  case and([RocksDBScanPredicate])
+
+  /// At least one condition holds (false when empty)
+  case or([RocksDBScanPredicate])
+
+  /// The condition does not hold
+  case not(RocksDBScanPredicate)
+
+  /// Key starts with one of the prefixes
+  public static func keyPrefix(in prefixes: Set<Data>) -> RocksDBScanPredicate {
+    .bytesIn(.key, prefixes)
+  }
+
+  /// Key ends with one of the suffixes
+  public static func keySuffix(in suffixes: Set<Data>) -> RocksDBScanPredicate {
+    .bytesIn(.key, fromEnd: true, suffixes)
+  }
+}
+
+/// Predicate compiled once for the bridge and reusable across scans and threads
+public final class RocksDBScanFilter: @unchecked Sendable {
+  internal let handle: RocksDBScanPredicateRef
+
+  /// Predicate the filter evaluates
+  public let predicate: RocksDBScanPredicate
+
+  /// Compile a predicate
+  /// - Throws: RocksDBError.invalidArgument for negative offsets, invalid
+  ///   field widths or predicates nested too deeply
+  public init(_ predicate: RocksDBScanPredicate) throws {
+    var nodes: [Node] = []
+    try Self.flatten(predicate, into: &nodes)
+
+    // Operand pointers for every node, laid out back to back
+    let operands = nodes.flatMap(\.operands)
+    let handle: RocksDBScanPredicateRef? = try operands.withPackedKeys { operandPtrs, operandLens in
+      var error: UnsafeMutablePointer<CChar>?
+      var first = 0
+      var native: [RocksDBPredicateNode] = []
+      native.reserveCapacity(nodes.count)
+      for node in nodes {
+        var spec = node.spec
+        spec.operands = operandPtrs + first
+        spec.operand_lens = operandLens + first
+        spec.num_operands = node.operands.count
+        first += node.operands.count
+        native.append(spec)
+      }
+
+      let handle = rocksdb_scan_predicate_create(native, native.count, &error)
+      if let error {
+        defer { rocksdb_free_string(error) }
+        throw RocksDBError.invalidArgument(String(cString: error))
+      }
+      return handle
+    }
+    guard let handle else {
+      throw RocksDBError.invalidArgument("Invalid scan predicate")
+    }
+
+    self.handle = handle
+    self.predicate = predicate
+  }
+
+  deinit {
+    rocksdb_scan_predicate_destroy(handle)
+  }
+
+  // MARK: - Internal Helpers
+
+  /// Native node without its operand pointers, and the operands it owns
+  private struct Node {
+    var spec: RocksDBPredicateNode
+    var operands: [Data]
+  }
+
+  private static func flatten(_ predicate: RocksDBScanPredicate, into nodes: inout [Node]) throws {
+    var spec = RocksDBPredicateNode()
+    var operands: [Data] = []
+    var children: [RocksDBScanPredicate] = []
+
+    switch predicate {
+    case .bytes(let part, let offset, let fromEnd, let comparison, let operand):
+      spec.kind = RocksDBPredicateBytes
+      try window(&spec, part, offset, fromEnd)
+      spec.op = comparison.native
+      operands = [operand]
+    case .integer(let part, let field, let comparison, let value):
+      spec.kind = RocksDBPredicateInteger
+      spec.on_value = part == .value ? 1 : 0
+      spec.field = field.native
+      spec.op = comparison.native
+      spec.integer = UInt64(bitPattern: value)
+    case .bytesIn(let part, let offset, let fromEnd, let members):
+      spec.kind = RocksDBPredicateBytesIn
+      try window(&spec, part, offset, fromEnd)
+      operands = Array(members)
+    case .and(let conditions):
+      spec.kind = RocksDBPredicateAnd
+      children = conditions
+    case .or(let conditions):
+      spec.kind = RocksDBPredicateOr
+      children = conditions
+    case .not(let condition):
+      spec.kind = RocksDBPredicateNot
+      children = [condition]
+    }
+
+    spec.child_count = children.count
+    nodes.append(Node(spec: spec, operands: operands))
+    for child in children {
+      try flatten(child, into: &nodes)
+    }
+  }
+
+  private static func window(_ spec: inout RocksDBPredicateNode, _ part: RocksDBScanPredicate.Part,
+                             _ offset: Int, _ fromEnd: Bool) throws {
+    guard offset >= 0 else {
+      throw RocksDBError.invalidArgument("Predicate offsets must not be negative")
+    }
+    spec.on_value = part == .value ? 1 : 0
+    spec.offset = offset
+    spec.from_end = fromEnd ? 1 : 0
+  }
+}
+
+extension RocksDBScanPredicate.Comparison {
+  internal var native: RocksDBCompareOp {
+    switch self {
+    case .equal: return RocksDBCompareEqual
+    case .notEqual: return RocksDBCompareNotEqual
+    case .less: return RocksDBCompareLess
+    case .lessOrEqual: return RocksDBCompareLessOrEqual
+    case .greater: return RocksDBCompareGreater
+    case .greaterOrEqual: return RocksDBCompareGreaterOrEqual
+    }
+  }
+}
@@ -0,0 +1,84 @@
+//
+//  RocksDBSecondaryFollower.swift
+//  RocksDB.swift
+//
+//  Periodic catch-up of secondary instances
+//
+
+import Foundation
+import CRocksDB
+
+/// Keeps a secondary instance caught up with its primary
+///
+/// Calls `RocksDB.tryCatchUpWithPrimary()` on a timer, so a database opened
+/// with `openAsSecondary` lags the primary by at most about one interval.
+/// Each catch-up only replays what changed since the previous one.
+public final class RocksDBSecondaryFollower: @unchecked Sendable {
+  /// Secondary database being caught up
+  public let database: RocksDB
+
+  private let lock = NSLock()
+  private var timer: DispatchSourceTimer?
+  private var catchUps = 0
+  private var error: Error?
+
+  /// Create a follower; call `start(interval:)` to begin
+  public init(database: RocksDB) {
+    self.database = database
+  }
+
+  deinit {
+    stop()
+  }
+
+  /// Successful catch-ups so far
+  public var catchUpCount: Int {
+    lock.withLock { catchUps }
+  }
+
+  /// Error of the most recent catch-up, nil once one succeeds again
+  public var lastError: Error? {
+    lock.withLock { error }
+  }
+
+  /// Catch up now and then every `interval` seconds
+  public func start(interval: TimeInterval = 1) {
+    let source = DispatchSource.makeTimerSource(queue: DispatchQueue(label: "RocksDBSecondaryFollower"))
+    source.schedule(deadline: .now(), repeating: interval)
+    source.setEventHandler { [weak self] in
+      self?.catchUp()
+    }
+
+    lock.withLock {
+      timer?.cancel()
+      timer = source
+    }
+    source.resume()
+  }
+
+  /// Stop catching up
+  public func stop() {
+    let source = lock.withLock { () -> DispatchSourceTimer? in
+      defer { timer = nil }
+      return timer
+    }
+    source?.cancel()
+  }
+
+  /// Catch up once, recording the outcome
+  /// - Returns: Whether the catch-up succeeded
+  @discardableResult
+  public func catchUp() -> Bool {
+    do {
+      try database.tryCatchUpWithPrimary()
+      lock.withLock {
+        catchUps += 1
+        error = nil
+      }
+      return true
+    } catch {
+      lock.withLock { self.error = error }
+      return false
+    }
+  }
+}
@@ -0,0 +1,304 @@
+//
+//  RocksDBShardedStore.swift
+//  RocksDB.swift
+//
+//  Hash-sharded facade over several RocksDB instances
+//
+
+import Foundation
+import CRocksDB
+
+/// Key-value store spread over several RocksDB instances by key hash
+///
+/// Every shard has its own WAL and write thread, so ingest scales past the
+/// single-leader write path of one instance. Memory budgets stay global:
+/// all shards share one block cache and one write buffer manager, and
+/// background flushes and compactions run on the process-wide default
+/// thread pools. Writes are atomic per key but not across shards.
+///
+/// Shards live in `shard-000`, `shard-001`, ... under the store directory.
+/// The shard count is fixed once the store is created, since it decides
+/// where every key lives.
+public final class RocksDBShardedStore: @unchecked Sendable {
+  /// Open shard databases, indexed by shard number
+  public let shards: [RocksDB]
+
+  /// Block cache shared by all shards
+  public let blockCache: RocksDBCache
+
+  /// Memtable budget shared by all shards
+  public let writeBufferManager: RocksDBWriteBufferManager
+
+  private init(shards: [RocksDB], blockCache: RocksDBCache, writeBufferManager: RocksDBWriteBufferManager) {
+    self.shards = shards
+    self.blockCache = blockCache
+    self.writeBufferManager = writeBufferManager
+  }
+
+  deinit {
+    close()
+  }
+
+  // MARK: - Factory Methods
+
+  /// Open or create a sharded store
+  ///
+  /// A cache or write buffer manager already set in `options` is shared as
+  /// given; otherwise the store creates a 128 MB LRU cache and a manager
+  /// capped at `writeBufferSize * shardCount`, charged to that cache.
+  /// - Parameters:
+  ///   - path: Store directory
+  ///   - shardCount: Number of shards (must match an existing store)
+  ///   - options: Options applied to every shard (bytewise comparator only)
+  /// - Returns: Open store
+  /// - Throws: RocksDBError on failure or a shard count mismatch
+  public static func open(
+    at path: String,
+    shardCount: Int,
+    options: RocksDBOptions = .default
+  ) throws -> RocksDBShardedStore {
+    guard shardCount > 0 else {
+      throw RocksDBError.invalidArgument("Shard count must be positive")
+    }
+    guard options.comparator == .bytewise else {
+      throw RocksDBError.invalidArgument("Sharded stores require the bytewise comparator")
+    }
+
+    let fileManager = FileManager.default
+    try fileManager.createDirectory(atPath: path, withIntermediateDirectories: true)
+    let existing = try fileManager.contentsOfDirectory(atPath: path).filter { $0.hasPrefix("shard-") }
+    if !existing.isEmpty && existing.count != shardCount {
+      throw RocksDBError.invalidArgument(
+        "Store has \(existing.count) shards, cannot open with \(shardCount)")
+    }
+
+    var tableOptions = options.tableOptions ?? RocksDBTableOptions()
+    let cache = tableOptions.blockCache ?? .lru(capacity: 128 * 1024 * 1024)
+    tableOptions.blockCache = cache
+
+    var shardOptions = options
+    shardOptions.tableOptions = tableOptions
+    let manager = options.writeBufferManager
+      ?? RocksDBWriteBufferManager(bufferSize: options.writeBufferSize * shardCount, cache: cache)
+    shardOptions.writeBufferManager = manager
+
+    var shards: [RocksDB] = []
+    do {
+      for index in 0..<shardCount {
+        let shardPath = (path as NSString).appendingPathComponent(String(format: "shard-%03d", index))
+        shards.append(try RocksDB.open(at: shardPath, options: shardOptions))
+      }
+    } catch {
+      shards.forEach { $0.close() }
+      throw error
+    }
+
+    return RocksDBShardedStore(shards: shards, blockCache: cache, writeBufferManager: manager)
+  }
+
+  /// Close every shard
+  public func close() {
+    shards.forEach { $0.close() }
+  }
+
+  // MARK: - Routing
+
+  /// Shard a key is stored in
+  ///
+  /// Uses 64-bit FNV-1a, which is stable across processes and releases.
+  /// - Parameter key: Key data
+  /// - Returns: Shard index
+  public func shardIndex(for key: Data) -> Int {
+    var hash: UInt64 = 0xcbf2_9ce4_8422_2325
+    for byte in key {
+      hash ^= UInt64(byte)
+      hash = hash &* 0x0000_0100_0000_01b3
+    }
+    return Int(hash % UInt64(shards.count))
+  }
+
+  /// Shard database a key is stored in
+  public func shard(for key: Data) -> RocksDB {
+    shards[shardIndex(for: key)]
+  }
+
+  // MARK: - Point Operations
+
+  /// Put a key-value pair
+  /// - Throws: RocksDBError on failure
+  public func put(_ value: Data, forKey key: Data, options: RocksDBWriteOptions = .default) throws {
+    try shard(for: key).put(value, forKey: key, options: options)
+  }
+
+  /// Merge an operand into the value for key
+  /// - Throws: RocksDBError on failure (e.g. no merge operator configured)
+  public func merge(_ value: Data, forKey key: Data, options: RocksDBWriteOptions = .default) throws {
+    try shard(for: key).merge(value, forKey: key, options: options)
+  }
+
+  /// Get value for key
+  /// - Returns: Value data or nil if not found
+  /// - Throws: RocksDBError on failure
+  public func get(_ key: Data, options: RocksDBReadOptions = .default) throws -> Data? {
+    try shard(for: key).get(key, options: options)
+  }
+
+  /// Delete a key
+  /// - Throws: RocksDBError on failure
+  public func delete(_ key: Data, options: RocksDBWriteOptions = .default) throws {
+    try shard(for: key).delete(key, options: options)
+  }
+
+  /// Get values for many keys, looking up each shard's keys concurrently
+  /// - Parameters:
+  ///   - keys: Keys to look up
+  ///   - options: Read options
+  /// - Returns: Values in the same order as `keys`, nil for missing keys
+  /// - Throws: The first error raised by a shard
+  public func multiGet(_ keys: [Data], options: RocksDBReadOptions = .default) throws -> [Data?] {
+    var positions = [[Int]](repeating: [], count: shards.count)
+    for (position, key) in keys.enumerated() {
+      positions[shardIndex(for: key)].append(position)
+    }
+
+    let results = ShardResults(count: keys.count)
+    DispatchQueue.concurrentPerform(iterations: shards.count) { index in
+      let shardPositions = positions[index]
+      guard !shardPositions.isEmpty else { return }
+      do {
+        let values = try shards[index].multiGet(shardPositions.map { keys[$0] }, options: options)
+        results.store(values, at: shardPositions)
+      } catch {
+        results.fail(error)
+      }
+    }
+    return try results.values()
+  }
+
+  // MARK: - Ordered Iteration
+
+  /// Iterate key-value pairs of all shards in key order
+  ///
+  /// Merges one bounded iterator per shard. Each shard is read at its own
+  /// implicit snapshot, so writes made during the scan may show up in some
+  /// shards and not others.
+  /// - Parameters:
+  ///   - range: Half-open key range to scan
+  ///   - options: Read options (bounds are replaced by `range`)
+  ///   - body: Closure called for each key-value pair, return false to stop
+  /// - Throws: RocksDBError on failure
+  public func forEach(
+    in range: RocksDBKeyRange = .all,
+    options: RocksDBReadOptions = .default,
+    _ body: (Data, Data) throws -> Bool
+  ) throws {
+    var boundedOptions = options
+    boundedOptions.iterateLowerBound = range.start
+    boundedOptions.iterateUpperBound = range.end
+
+    var cursors: [MergeCursor] = []
+    defer { cursors.forEach { $0.iterator.close() } }
+    for shard in shards {
+      let iter = try shard.makeIterator(options: boundedOptions)
+      if let start = range.start {
+        iter.seek(to: start)
+      } else {
+        iter.seekToFirst()
+      }
+      cursors.append(MergeCursor(iterator: iter))
+    }
+
+    // Linear scan for the smallest head; shard counts are small enough
+    // that a heap would not pay for itself
+    while true {
+      var smallest: Int?
+      for index in cursors.indices {
+        guard let head = try cursors[index].head() else { continue }
+        if let current = smallest, let best = try cursors[current].head(),
+           !head.key.lexicographicallyPrecedes(best.key) {
+          continue
+        }
+        smallest = index
+      }
+
+      guard let index = smallest, let entry = try cursors[index].head() else { return }
+      cursors[index].advance()
+      if try !body(entry.key, entry.value) { return }
+    }
+  }
+
+  // MARK: - Maintenance Operations
+
+  /// Flush the memtables of every shard
+  /// - Throws: RocksDBError on failure
+  public func flush() throws {
+    for shard in shards {
+      try shard.flush()
+    }
+  }
+}
+
+// MARK: - Internal Helpers
+
+/// Buffered head of one shard's iterator during a merged scan
+private struct MergeCursor {
+  let iterator: RocksDBIterator
+  private var buffered: [(key: Data, value: Data)] = []
+  private var index = 0
+  private var exhausted = false
+
+  init(iterator: RocksDBIterator) {
+    self.iterator = iterator
+  }
+
+  /// Current entry, refilling the buffer as needed (nil once exhausted)
+  mutating func head() throws -> (key: Data, value: Data)? {
+    guard !exhausted else { return nil }
+    if index == buffered.count {
+      buffered = iterator.nextBatch()
+      index = 0
+      if buffered.isEmpty {
+        exhausted = true
+        try iterator.checkStatus()
+        return nil
+      }
+    }
+    return buffered[index]
+  }
+
+  mutating func advance() {
+    index += 1
+  }
+}
+
+/// Result slots filled by concurrent per-shard lookups
+private final class ShardResults: @unchecked Sendable {
+  private let lock = NSLock()
+  private var slots: [Data?]
+  private var firstError: Error?
+
+  init(count: Int) {
+    slots = [Data?](repeating: nil, count: count)
+  }
+
+  func store(_ values: [Data?], at positions: [Int]) {
+    lock.withLock {
+      for (value, position) in zip(values, positions) {
+        slots[position] = value
+      }
+    }
+  }
+
+  func fail(_ error: Error) {
+    lock.withLock {
+      if firstError == nil { firstError = error }
+    }
+  }
+
+  func values() throws -> [Data?] {
+    try lock.withLock {
+      if let firstError { throw firstError }
+      return slots
+    }
+  }
+}
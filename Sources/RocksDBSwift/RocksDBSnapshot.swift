@@ -0,0 +1,60 @@
+//
+//  RocksDBSnapshot.swift
+//  RocksDB.swift
+//
+//  Point-in-time database snapshots
+//
+
+import Foundation
+import CRocksDB
+
+/// Consistent point-in-time view of a database
+///
+/// Pass it as `RocksDBReadOptions.snapshot` to read the database as of its
+/// creation. The snapshot is released when the last reference goes away;
+/// until then it pins every key version it can see, so keep it short-lived.
+public final class RocksDBSnapshot: @unchecked Sendable {
+  internal let handle: RocksDBSnapshotRef
+  private let database: RocksDB
+
+  /// Sequence number the snapshot reads at
+  public let sequenceNumber: UInt64
+
+  /// System uptime at creation, in seconds
+  internal let createdAt: TimeInterval
+
+  internal init(handle: RocksDBSnapshotRef, database: RocksDB) {
+    self.handle = handle
+    self.database = database
+    self.sequenceNumber = rocksdb_snapshot_sequence_number(handle)
+    self.createdAt = ProcessInfo.processInfo.systemUptime
+  }
+
+  deinit {
+    database.releaseSnapshot(handle)
+  }
+
+  /// Seconds since the snapshot was taken
+  public var age: TimeInterval {
+    ProcessInfo.processInfo.systemUptime - createdAt
+  }
+}
+
+/// Snapshot usage of a database
+public struct RocksDBSnapshotStats: Sendable, Equatable {
+  /// Live snapshots, including those held by transactions
+  public var count: Int
+
+  /// Age of the oldest live snapshot in seconds (whole-second resolution),
+  /// nil if there is none
+  public var oldestAge: TimeInterval?
+
+  /// Calls to `sharedSnapshot()` answered with an existing snapshot
+  public var sharedHits: Int
+
+  public init(count: Int = 0, oldestAge: TimeInterval? = nil, sharedHits: Int = 0) {
+    self.count = count
+    self.oldestAge = oldestAge
+    self.sharedHits = sharedHits
+  }
+}
@@ -0,0 +1,88 @@
+//
+//  RocksDBSstFileManager.swift
+//  RocksDB.swift
+//
+//  Shared SST file tracking, paced deletion and disk space caps
+//
+
+import Foundation
+import CRocksDB
+
+/// Tracks the SST and blob files of the databases it is installed in
+///
+/// Assign the same manager to `RocksDBOptions.sstFileManager` of several
+/// databases to pace their file deletions and cap their combined disk
+/// usage. With a delete rate set, obsolete files are moved to trash and
+/// removed in chunks at that rate, so the deletions after a large compaction
+/// or a dropped column family don't cause TRIM storms. With a space cap,
+/// flushes and compactions that would exceed it fail with a space-limit
+/// error and the database turns read-only instead of filling the disk.
+/// Each database keeps the native manager alive for as long as it is open.
+public final class RocksDBSstFileManager: @unchecked Sendable {
+  internal let handle: RocksDBSstFileManagerRef
+
+  /// Create an SST file manager
+  /// - Parameters:
+  ///   - deleteRateBytesPerSecond: Deletion rate (0 deletes files immediately)
+  ///   - maxTrashDBRatio: Delete files immediately, unpaced, once trash
+  ///     exceeds this fraction of the tracked size
+  ///   - bytesMaxDeleteChunk: Truncate large files in chunks of this size
+  ///     while deleting them (0 deletes whole files)
+  /// - Throws: RocksDBError.invalidArgument if the manager cannot be created
+  public init(
+    deleteRateBytesPerSecond: Int64 = 0,
+    maxTrashDBRatio: Double = 0.25,
+    bytesMaxDeleteChunk: UInt64 = 64 * 1024 * 1024
+  ) throws {
+    guard let handle = rocksdb_sst_file_manager_create(deleteRateBytesPerSecond, maxTrashDBRatio,
+                                                       bytesMaxDeleteChunk) else {
+      throw RocksDBError.invalidArgument("Invalid SST file manager configuration")
+    }
+    self.handle = handle
+  }
+
+  deinit {
+    rocksdb_sst_file_manager_destroy(handle)
+  }
+
+  // MARK: - Limits
+
+  /// Deletion rate in bytes per second (0 for unpaced); may be changed at runtime
+  public var deleteRateBytesPerSecond: Int64 {
+    get { rocksdb_sst_file_manager_get_delete_rate_bytes_per_second(handle) }
+    set { rocksdb_sst_file_manager_set_delete_rate_bytes_per_second(handle, newValue) }
+  }
+
+  /// Cap the total size of tracked files; 0 removes the cap
+  public func setMaxAllowedSpaceUsage(_ bytes: UInt64) {
+    rocksdb_sst_file_manager_set_max_allowed_space_usage(handle, bytes)
+  }
+
+  /// Space held back for compaction output when checking the cap, so
+  /// compactions are refused before flushes are
+  public func setCompactionBufferSize(_ bytes: UInt64) {
+    rocksdb_sst_file_manager_set_compaction_buffer_size(handle, bytes)
+  }
+
+  // MARK: - Properties
+
+  /// Total size in bytes of the tracked SST and blob files
+  public var totalSize: UInt64 {
+    rocksdb_sst_file_manager_get_total_size(handle)
+  }
+
+  /// Size in bytes of files waiting in trash for paced deletion
+  public var totalTrashSize: UInt64 {
+    rocksdb_sst_file_manager_get_total_trash_size(handle)
+  }
+
+  /// Whether the tracked files have reached the space cap
+  public var isMaxAllowedSpaceReached: Bool {
+    rocksdb_sst_file_manager_is_max_allowed_space_reached(handle) != 0
+  }
+
+  /// Whether the tracked files plus running compaction output have reached the space cap
+  public var isMaxAllowedSpaceReachedIncludingCompactions: Bool {
+    rocksdb_sst_file_manager_is_max_allowed_space_reached_including_compactions(handle) != 0
+  }
+}
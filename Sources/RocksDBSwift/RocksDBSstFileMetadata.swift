@@ -0,0 +1,157 @@
+//
+//  RocksDBSstFileMetadata.swift
+//  RocksDB.swift
+//
+//  Live SST files, level layout and table properties
+//
+
+import Foundation
+import CRocksDB
+
+/// One live SST file, from `RocksDB.liveFiles()` or `columnFamilyMetadata(_:)`
+public struct RocksDBSstFile: Sendable, Equatable {
+  /// File name relative to `directory`, e.g. "000012.sst"
+  public var fileName: String
+  public var directory: String
+  public var columnFamily: String
+  public var level: Int
+  public var fileNumber: UInt64
+  /// File size in bytes
+  public var size: UInt64
+
+  /// Smallest and largest user keys, both inclusive
+  public var smallestKey: Data
+  public var largestKey: Data
+
+  public var smallestSequence: UInt64
+  public var largestSequence: UInt64
+
+  /// Entries in the file, deletions included
+  public var numEntries: UInt64
+  /// Point deletions in the file
+  public var numDeletions: UInt64
+  /// Reads sampled from the file since it was opened
+  public var numReadsSampled: UInt64
+
+  /// Whether a compaction holds the file as input
+  public var isBeingCompacted: Bool
+  /// When the file was written, nil if unknown
+  public var creationTime: Date?
+
+  /// Full path of the file
+  public var path: String {
+    (directory as NSString).appendingPathComponent(fileName)
+  }
+
+  /// Fraction of entries that are deletions, for picking files to compact
+  public var deletionRatio: Double {
+    numEntries == 0 ? 0 : Double(numDeletions) / Double(numEntries)
+  }
+
+  /// Whether the file may hold keys in `range`
+  public func overlaps(_ range: RocksDBKeyRange) -> Bool {
+    if let start = range.start, largestKey.lexicographicallyPrecedes(start) {
+      return false
+    }
+    if let end = range.end, !smallestKey.lexicographicallyPrecedes(end) {
+      return false
+    }
+    return true
+  }
+
+  init(_ values: RocksDBSstFileValues) {
+    fileName = String(cString: values.file_name)
+    directory = String(cString: values.directory)
+    columnFamily = String(cString: values.column_family)
+    level = Int(values.level)
+    fileNumber = values.file_number
+    size = values.size
+    smallestKey = Data(bytes: values.smallest_key, count: values.smallest_key_len)
+    largestKey = Data(bytes: values.largest_key, count: values.largest_key_len)
+    smallestSequence = values.smallest_seqno
+    largestSequence = values.largest_seqno
+    numEntries = values.num_entries
+    numDeletions = values.num_deletions
+    numReadsSampled = values.num_reads_sampled
+    isBeingCompacted = values.being_compacted != 0
+    creationTime = values.file_creation_time == 0
+      ? nil : Date(timeIntervalSince1970: TimeInterval(values.file_creation_time))
+  }
+
+  /// Copy a bridge file array and free it
+  internal static func consume(_ files: UnsafeMutablePointer<RocksDBSstFileValues>?, count: Int) -> [RocksDBSstFile] {
+    guard let files else { return [] }
+    defer { rocksdb_sst_files_destroy(files, count) }
+    return (0..<count).map { RocksDBSstFile(files[$0]) }
+  }
+}
+
+/// Files of one level of a column family
+public struct RocksDBLevelMetadata: Sendable, Equatable {
+  public var level: Int
+  /// Total bytes of the level's files
+  public var size: UInt64
+  /// Files in key order (L0: newest first, and they may overlap)
+  public var files: [RocksDBSstFile]
+}
+
+/// Level layout of a column family
+public struct RocksDBColumnFamilyMetadata: Sendable, Equatable {
+  public var name: String
+  /// Every configured level, empty ones included
+  public var levels: [RocksDBLevelMetadata]
+
+  /// Total bytes of the family's SST files
+  public var size: UInt64 {
+    levels.reduce(0) { $0 + $1.size }
+  }
+
+  public var fileCount: Int {
+    levels.reduce(0) { $0 + $1.files.count }
+  }
+
+  /// Every file, level by level
+  public var files: [RocksDBSstFile] {
+    levels.flatMap(\.files)
+  }
+}
+
+/// Properties recorded in an SST file when it was written
+public struct RocksDBTableProperties: Sendable, Equatable {
+  public var filePath: String
+  public var dataSize: UInt64
+  public var indexSize: UInt64
+  public var filterSize: UInt64
+  /// Key and value bytes before compression and encoding
+  public var rawKeySize: UInt64
+  public var rawValueSize: UInt64
+  public var numDataBlocks: UInt64
+  public var numEntries: UInt64
+  public var numDeletions: UInt64
+  public var numMergeOperands: UInt64
+  public var numRangeDeletions: UInt64
+  /// When the file was written, nil if unknown
+  public var creationTime: Date?
+  /// Oldest time an entry of the file was written, nil if unknown
+  public var oldestKeyTime: Date?
+  public var compressionName: String
+
+  init(_ values: RocksDBTablePropertiesValues) {
+    filePath = String(cString: values.file_path)
+    dataSize = values.data_size
+    indexSize = values.index_size
+    filterSize = values.filter_size
+    rawKeySize = values.raw_key_size
+    rawValueSize = values.raw_value_size
+    numDataBlocks = values.num_data_blocks
+    numEntries = values.num_entries
+    numDeletions = values.num_deletions
+    numMergeOperands = values.num_merge_operands
+    numRangeDeletions = values.num_range_deletions
+    creationTime = values.creation_time == 0
+      ? nil : Date(timeIntervalSince1970: TimeInterval(values.creation_time))
+    oldestKeyTime = values.oldest_key_time == 0
+      ? nil : Date(timeIntervalSince1970: TimeInterval(values.oldest_key_time))
+    compressionName = String(cString: values.compression_name)
+  }
+}
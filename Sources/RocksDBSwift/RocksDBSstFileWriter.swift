@@ -0,0 +1,193 @@
+//
+//  RocksDBSstFileWriter.swift
+//  RocksDB.swift
+//
+//  External SST file writer for bulk loading
+//
+
+import Foundation
+import CRocksDB
+
+/// Metadata for a finished external SST file
+public struct RocksDBExternalFileInfo: Sendable {
+  /// Path of the SST file
+  public let path: String
+
+  /// File size in bytes
+  public let fileSize: UInt64
+
+  /// Number of entries in the file
+  public let numEntries: UInt64
+}
+
+/// Writes sorted key-value pairs directly into an SST file
+///
+/// Keys must be added in ascending order. Finished files are loaded with
+/// `RocksDB.ingestExternalFiles`, bypassing the WAL, memtables and L0.
+public final class RocksDBSstFileWriter: @unchecked Sendable {
+  private var handle: RocksDBSstFileWriterRef?
+  private let lock = NSRecursiveLock()
+  private var finished = false
+
+  /// Path of the SST file being written
+  public let path: String
+
+  private init(handle: RocksDBSstFileWriterRef, path: String) {
+    self.handle = handle
+    self.path = path
+  }
+
+  deinit {
+    if let h = handle {
+      rocksdb_sst_file_writer_destroy(h)
+    }
+  }
+
+  // MARK: - Factory Methods
+
+  /// Create an SST file for writing
+  /// - Parameters:
+  ///   - path: Path of the SST file to create
+  ///   - options: Options matching the database the file will be ingested into
+  /// - Returns: Open writer
+  /// - Throws: RocksDBError on failure
+  public static func open(at path: String, options: RocksDBOptions = .default) throws -> RocksDBSstFileWriter {
+    let opts = options.createHandle()
+    defer { rocksdb_options_destroy(opts) }
+
+    guard let writerHandle = rocksdb_sst_file_writer_create(opts) else {
+      throw RocksDBError.ioError("Failed to create SST file writer")
+    }
+
+    let writer = RocksDBSstFileWriter(handle: writerHandle, path: path)
+    try RocksDBError.check(rocksdb_sst_file_writer_open(writerHandle, path))
+    return writer
+  }
+
+  // MARK: - Operations
+
+  /// Add a key-value pair (keys must be strictly ascending)
+  /// - Parameters:
+  ///   - value: Value data
+  ///   - key: Key data
+  /// - Throws: RocksDBError on failure (e.g. out-of-order key)
+  public func put(_ value: Data, forKey key: Data) throws {
+    try lock.withLock {
+      let h = try openHandle()
+
+      let status = key.withUnsafeBytes { keyPtr in
+        value.withUnsafeBytes { valuePtr in
+          rocksdb_sst_file_writer_put(h,
+                                      keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                      key.count,
+                                      valuePtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                      value.count)
+        }
+      }
+      try RocksDBError.check(status)
+    }
+  }
+
+  /// Add a string key-value pair (keys must be strictly ascending)
+  public func put(_ value: String, forKey key: String) throws {
+    guard let keyData = key.data(using: .utf8),
+          let valueData = value.data(using: .utf8) else {
+      throw RocksDBError.invalidArgument("Invalid UTF-8 encoding")
+    }
+    try put(valueData, forKey: keyData)
+  }
+
+  /// Add a merge operand (keys must be strictly ascending)
+  /// - Parameters:
+  ///   - value: Merge operand
+  ///   - key: Key data
+  /// - Throws: RocksDBError on failure
+  public func merge(_ value: Data, forKey key: Data) throws {
+    try lock.withLock {
+      let h = try openHandle()
+
+      let status = key.withUnsafeBytes { keyPtr in
+        value.withUnsafeBytes { valuePtr in
+          rocksdb_sst_file_writer_merge(h,
+                                        keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                        key.count,
+                                        valuePtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                        value.count)
+        }
+      }
+      try RocksDBError.check(status)
+    }
+  }
+
+  /// Add a deletion tombstone (keys must be strictly ascending)
+  /// - Parameter key: Key data
+  /// - Throws: RocksDBError on failure
+  public func delete(_ key: Data) throws {
+    try lock.withLock {
+      let h = try openHandle()
+
+      let status = key.withUnsafeBytes { keyPtr in
+        rocksdb_sst_file_writer_delete(h,
+                                       keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                       key.count)
+      }
+      try RocksDBError.check(status)
+    }
+  }
+
+  /// Add a range deletion tombstone
+  /// - Parameters:
+  ///   - startKey: Start of range (inclusive)
+  ///   - endKey: End of range (exclusive)
+  /// - Throws: RocksDBError on failure
+  public func deleteRange(from startKey: Data, to endKey: Data) throws {
+    try lock.withLock {
+      let h = try openHandle()
+
+      let status = startKey.withUnsafeBytes { startPtr in
+        endKey.withUnsafeBytes { endPtr in
+          rocksdb_sst_file_writer_delete_range(h,
+                                               startPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                               startKey.count,
+                                               endPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                               endKey.count)
+        }
+      }
+      try RocksDBError.check(status)
+    }
+  }
+
+  /// Finish writing and close the file
+  /// - Returns: Metadata of the finished file
+  /// - Throws: RocksDBError on failure
+  @discardableResult
+  public func finish() throws -> RocksDBExternalFileInfo {
+    try lock.withLock {
+      let h = try openHandle()
+
+      var fileSize: UInt64 = 0
+      var numEntries: UInt64 = 0
+      try RocksDBError.check(rocksdb_sst_file_writer_finish(h, &fileSize, &numEntries))
+      finished = true
+
+      return RocksDBExternalFileInfo(path: path, fileSize: fileSize, numEntries: numEntries)
+    }
+  }
+
+  // MARK: - Properties
+
+  /// Current size of the file being written, in bytes
+  public var fileSize: UInt64 {
+    lock.withLock {
+      guard let h = handle else { return 0 }
+      return rocksdb_sst_file_writer_file_size(h)
+    }
+  }
+
+  private func openHandle() throws -> RocksDBSstFileWriterRef {
+    guard let h = handle, !finished else {
+      throw RocksDBError.invalidArgument("SST file writer is finished")
+    }
+    return h
+  }
+}
@@ -0,0 +1,146 @@
+//
+//  RocksDBStatistics.swift
+//  RocksDB.swift
+//
+//  Typed access to RocksDB tickers and histograms
+//
+
+import Foundation
+import CRocksDB
+
+/// How much the statistics object measures; each level adds cost
+public enum RocksDBStatsLevel: Int32, Sendable {
+  /// Collect nothing
+  case disableAll = 0
+  /// Tickers only
+  case exceptHistogramOrTimers = 1
+  /// Tickers and histograms, but no timers
+  case exceptTimers = 2
+  /// Everything except detailed timers such as per-level read times (default)
+  case exceptDetailedTimers = 3
+  /// Everything except mutex wait times
+  case exceptTimeForMutex = 4
+  /// Everything
+  case all = 5
+}
+
+/// Counter tracked by the statistics object
+///
+/// Identified by name, which is stable across RocksDB versions; the
+/// numeric id is resolved against the linked build.
+public struct RocksDBTicker: Hashable, Sendable {
+  /// Ticker name (e.g. "rocksdb.block.cache.hit")
+  public let name: String
+
+  internal let id: UInt32
+
+  private init(name: String, id: UInt32) {
+    self.name = name
+    self.id = id
+  }
+
+  /// Look up a ticker by name
+  public init?(named name: String) {
+    guard let ticker = RocksDBTicker.all.first(where: { $0.name == name }) else {
+      return nil
+    }
+    self = ticker
+  }
+
+  /// Every ticker of the linked RocksDB build, in id order
+  public static let all: [RocksDBTicker] = (0..<rocksdb_statistics_ticker_count()).compactMap { id in
+    rocksdb_statistics_ticker_name(id).map { RocksDBTicker(name: String(cString: $0), id: id) }
+  }
+
+  private static func known(_ name: String) -> RocksDBTicker {
+    guard let ticker = RocksDBTicker(named: name) else {
+      preconditionFailure("Unknown ticker \(name)")
+    }
+    return ticker
+  }
+
+  public static let blockCacheHit = known("rocksdb.block.cache.hit")
+  public static let blockCacheMiss = known("rocksdb.block.cache.miss")
+  public static let rowCacheHit = known("rocksdb.row.cache.hit")
+  public static let rowCacheMiss = known("rocksdb.row.cache.miss")
+  public static let memtableHit = known("rocksdb.memtable.hit")
+  public static let memtableMiss = known("rocksdb.memtable.miss")
+  public static let bloomFilterUseful = known("rocksdb.bloom.filter.useful")
+  public static let keysWritten = known("rocksdb.number.keys.written")
+  public static let keysRead = known("rocksdb.number.keys.read")
+  public static let bytesWritten = known("rocksdb.bytes.written")
+  public static let bytesRead = known("rocksdb.bytes.read")
+  public static let stallMicros = known("rocksdb.stall.micros")
+  public static let compactReadBytes = known("rocksdb.compact.read.bytes")
+  public static let compactWriteBytes = known("rocksdb.compact.write.bytes")
+  public static let flushWriteBytes = known("rocksdb.flush.write.bytes")
+  public static let secondaryCacheHits = known("rocksdb.secondary.cache.hits")
+  public static let compressedSecondaryCacheHits = known("rocksdb.compressed.secondary.cache.hits")
+  public static let compressedSecondaryCacheDummyHits = known("rocksdb.compressed.secondary.cache.dummy.hits")
+  public static let compressedSecondaryCachePromotions = known("rocksdb.compressed.secondary.cache.promotions")
+}
+
+/// Distribution tracked by the statistics object
+public struct RocksDBHistogram: Hashable, Sendable {
+  /// Histogram name (e.g. "rocksdb.db.get.micros")
+  public let name: String
+
+  internal let id: UInt32
+
+  private init(name: String, id: UInt32) {
+    self.name = name
+    self.id = id
+  }
+
+  /// Look up a histogram by name
+  public init?(named name: String) {
+    guard let histogram = RocksDBHistogram.all.first(where: { $0.name == name }) else {
+      return nil
+    }
+    self = histogram
+  }
+
+  /// Every histogram of the linked RocksDB build, in id order
+  public static let all: [RocksDBHistogram] = (0..<rocksdb_statistics_histogram_count()).compactMap { id in
+    rocksdb_statistics_histogram_name(id).map { RocksDBHistogram(name: String(cString: $0), id: id) }
+  }
+
+  private static func known(_ name: String) -> RocksDBHistogram {
+    guard let histogram = RocksDBHistogram(named: name) else {
+      preconditionFailure("Unknown histogram \(name)")
+    }
+    return histogram
+  }
+
+  public static let getMicros = known("rocksdb.db.get.micros")
+  public static let writeMicros = known("rocksdb.db.write.micros")
+  public static let multiGetMicros = known("rocksdb.db.multiget.micros")
+  public static let seekMicros = known("rocksdb.db.seek.micros")
+  public static let compactionMicros = known("rocksdb.compaction.times.micros")
+  public static let sstReadMicros = known("rocksdb.sst.read.micros")
+}
+
+/// Summary of a histogram (latencies in microseconds)
+public struct RocksDBHistogramData: Sendable, Equatable {
+  public var p50: Double
+  public var p95: Double
+  public var p99: Double
+  public var average: Double
+  public var standardDeviation: Double
+  public var max: Double
+  public var min: Double
+  public var count: UInt64
+  public var sum: UInt64
+
+  internal init(_ data: RocksDBHistogramValues) {
+    p50 = data.median
+    p95 = data.percentile95
+    p99 = data.percentile99
+    average = data.average
+    standardDeviation = data.standard_deviation
+    max = data.max
+    min = data.min
+    count = data.count
+    sum = data.sum
+  }
+}
@@ -0,0 +1,95 @@
+//
+//  RocksDBThreadStatus.swift
+//  RocksDB.swift
+//
+//  What each RocksDB thread is working on
+//
+
+import Foundation
+import CRocksDB
+
+/// One thread of the default environment and its current operation
+///
+/// Operations are only reported for databases opened with
+/// `RocksDBOptions.enableThreadTracking`; other threads show `.unknown`.
+public struct RocksDBThreadStatus: Sendable, Equatable {
+  /// Kind of thread
+  public enum ThreadType: Int32, Sendable {
+    /// Flush pool thread
+    case highPriority = 0
+    /// Compaction pool thread
+    case lowPriority = 1
+    /// Application thread inside a RocksDB call
+    case user = 2
+    /// Bottommost compaction pool thread
+    case bottomPriority = 3
+  }
+
+  /// Operation a thread is running
+  public enum Operation: Int32, Sendable {
+    case unknown = 0
+    case compaction = 1
+    case flush = 2
+    case dbOpen = 3
+    case get = 4
+    case multiGet = 5
+    case dbIterator = 6
+    case verifyDBChecksum = 7
+    case verifyFileChecksums = 8
+    case getEntity = 9
+    case multiGetEntity = 10
+  }
+
+  public var threadID: UInt64
+  public var threadType: ThreadType?
+  public var operation: Operation?
+
+  /// RocksDB's name of the operation stage (e.g. "CompactionJob::ProcessKeyValueCompaction")
+  public var stage: String
+
+  /// Whether the thread is waiting on a mutex
+  public var isWaitingOnMutex: Bool
+
+  /// Time spent in the current operation
+  public var elapsed: TimeInterval
+
+  /// Database path, empty for idle threads
+  public var databaseName: String
+  public var columnFamilyName: String
+
+  /// Flush or compaction job ID (0 for other operations)
+  public var jobID: UInt64
+
+  /// Compaction levels, nil for other operations
+  public var inputLevel: Int?
+  public var outputLevel: Int?
+  public var isManualCompaction: Bool
+
+  /// Compaction input bytes, or the memtable bytes being flushed
+  public var totalInputBytes: UInt64
+  public var bytesRead: UInt64
+  public var bytesWritten: UInt64
+
+  init(_ values: RocksDBThreadStatusValues) {
+    threadID = values.thread_id
+    threadType = ThreadType(rawValue: values.thread_type)
+    operation = Operation(rawValue: values.operation_type)
+    stage = String(cString: rocksdb_thread_stage_name(values.operation_stage))
+    isWaitingOnMutex = values.state_type == 1
+    elapsed = TimeInterval(values.elapsed_micros) / 1_000_000
+    databaseName = withUnsafeBytes(of: values.db_name) { String(cString: $0.bindMemory(to: CChar.self).baseAddress!) }
+    columnFamilyName = withUnsafeBytes(of: values.cf_name) { String(cString: $0.bindMemory(to: CChar.self).baseAddress!) }
+    jobID = values.job_id
+    inputLevel = values.input_level >= 0 ? Int(values.input_level) : nil
+    outputLevel = values.output_level >= 0 ? Int(values.output_level) : nil
+    isManualCompaction = values.is_manual != 0
+    totalInputBytes = values.total_input_bytes
+    bytesRead = values.bytes_read
+    bytesWritten = values.bytes_written
+  }
+
+  /// Whether the thread is running a flush or compaction
+  public var isBackgroundJob: Bool {
+    operation == .flush || operation == .compaction
+  }
+}
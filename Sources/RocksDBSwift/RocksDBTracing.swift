@@ -0,0 +1,135 @@
+//
+//  RocksDBTracing.swift
+//  RocksDB.swift
+//
+//  Per-operation latency of the Swift wrapper, the C bridge and RocksDB itself
+//
+
+import Foundation
+import CRocksDB
+
+/// Wrapper operations covered by call tracing
+public enum RocksDBTraceOperation: Int32, CaseIterable, Sendable {
+  case get = 0
+  case put = 1
+  case delete = 2
+  case merge = 3
+  case multiGet = 4
+  case writeBatch = 5
+  case iteratorNextBatch = 6
+}
+
+/// Call count, total time and log2 latency buckets of one traced layer
+public struct RocksDBLatencyHistogram: Sendable, Equatable {
+  public var calls: UInt64 = 0
+  public var totalNanos: UInt64 = 0
+
+  /// `buckets[i]` counts calls that took [2^i, 2^(i+1)) nanoseconds; the
+  /// first bucket also holds 0 and the last one everything slower
+  public var buckets: [UInt64] = []
+
+  public var averageNanos: Double {
+    calls == 0 ? 0 : Double(totalNanos) / Double(calls)
+  }
+
+  /// Upper bound in nanoseconds of the bucket holding the `p`th percentile
+  /// - Parameter p: Percentile in 0...100
+  public func percentile(_ p: Double) -> UInt64 {
+    guard calls > 0 else { return 0 }
+    let rank = UInt64((Double(calls) * p / 100).rounded(.up))
+    var seen: UInt64 = 0
+    for (index, count) in buckets.enumerated() {
+      seen += count
+      if seen >= Swift.max(rank, 1) {
+        return UInt64(1) << UInt64(index + 1)
+      }
+    }
+    return UInt64(1) << UInt64(buckets.count)
+  }
+}
+
+/// Latency of one operation at each layer, aggregated over all threads
+public struct RocksDBTraceStats: Sendable, Equatable {
+  public var operation: RocksDBTraceOperation
+
+  /// Whole wrapper call: locking, handle lookups, buffer setup and result conversion
+  public var swift: RocksDBLatencyHistogram
+
+  /// The C bridge function: argument marshalling and status conversion
+  public var bridge: RocksDBLatencyHistogram
+
+  /// The RocksDB call inside the bridge function
+  public var engine: RocksDBLatencyHistogram
+
+  /// Time spent in Swift outside the bridge
+  public var wrapperNanos: UInt64 {
+    swift.totalNanos > bridge.totalNanos ? swift.totalNanos - bridge.totalNanos : 0
+  }
+
+  /// Time spent in the bridge outside RocksDB
+  public var bridgeOverheadNanos: UInt64 {
+    bridge.totalNanos > engine.totalNanos ? bridge.totalNanos - engine.totalNanos : 0
+  }
+}
+
+/// Process-wide call tracing of the wrapper's hot paths
+///
+/// Off by default. While enabled, every traced call records its duration
+/// in per-thread counters at three layers, so RocksDB's own time can be
+/// told apart from the cost of the wrapper around it. Counters are only
+/// summed when read. Calls are counted where they are made: a batched
+/// iterator fetch that grows its buffer is one Swift call but two bridge
+/// calls.
+public enum RocksDBTracing {
+  /// Whether calls are being traced (always false when the bridge was
+  /// built with `ROCKSDB_BRIDGE_DISABLE_TRACING`)
+  public static var isEnabled: Bool {
+    get { rocksdb_trace_enabled() != 0 }
+    set { rocksdb_trace_set_enabled(newValue ? 1 : 0) }
+  }
+
+  /// Stats of one operation since the last reset
+  public static func stats(for operation: RocksDBTraceOperation) -> RocksDBTraceStats {
+    RocksDBTraceStats(
+      operation: operation,
+      swift: histogram(operation, RocksDBTraceLayerSwift),
+      bridge: histogram(operation, RocksDBTraceLayerBridge),
+      engine: histogram(operation, RocksDBTraceLayerEngine))
+  }
+
+  /// Stats of every operation that was called since the last reset
+  public static func snapshot() -> [RocksDBTraceStats] {
+    RocksDBTraceOperation.allCases.map { stats(for: $0) }.filter {
+      $0.swift.calls > 0 || $0.bridge.calls > 0
+    }
+  }
+
+  /// Start counting from zero on every thread
+  public static func reset() {
+    rocksdb_trace_reset()
+  }
+
+  /// Start time of a traced Swift call, 0 while tracing is off
+  ///
+  /// Pair with `end` in a `defer` at the top of the traced method.
+  @inline(__always)
+  internal static func begin() -> UInt64 {
+    rocksdb_trace_enabled() != 0 ? DispatchTime.now().uptimeNanoseconds : 0
+  }
+
+  /// Record the Swift layer of `operation` for a call started with `begin`
+  @inline(__always)
+  internal static func end(_ operation: RocksDBTraceOperation, _ start: UInt64) {
+    guard start != 0 else { return }
+    rocksdb_trace_record(operation.rawValue, Int32(RocksDBTraceLayerSwift.rawValue),
+                         DispatchTime.now().uptimeNanoseconds - start)
+  }
+
+  private static func histogram(_ operation: RocksDBTraceOperation, _ layer: RocksDBTraceLayer) -> RocksDBLatencyHistogram {
+    var calls: UInt64 = 0
+    var nanos: UInt64 = 0
+    var buckets = [UInt64](repeating: 0, count: Int(ROCKSDB_TRACE_BUCKETS))
+    rocksdb_trace_get(operation.rawValue, Int32(layer.rawValue), &calls, &nanos, &buckets)
+    return RocksDBLatencyHistogram(calls: calls, totalNanos: nanos, buckets: buckets)
+  }
+}
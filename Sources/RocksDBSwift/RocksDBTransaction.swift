@@ -2,30 +2,57 @@
 //  RocksDBTransaction.swift
 //  RocksDB.swift
 //
-//  Optimistic transaction for RocksDB
+//  Optimistic and pessimistic transactions for RocksDB
 //
 
 import Foundation
 import CRocksDB
 
-/// Optimistic transaction providing snapshot isolation
+/// Transaction providing snapshot isolation
+///
+/// In optimistic mode conflicts fail the commit with `transactionConflict`;
+/// in pessimistic mode writes and `getForUpdate` lock their rows and fail
+/// with `timedOut` (lock wait exceeded) or `busy` (deadlock) instead.
 public final class RocksDBTransaction: @unchecked Sendable {
   private var handle: RocksDBTransactionRef?
   private let lock = NSRecursiveLock()
   private var committed = false
+  private var prepared = false
+  /// Database the transaction runs against, for checking column families
+  private weak var database: RocksDB?
 
-  internal init(handle: RocksDBTransactionRef) {
+  internal init(handle: RocksDBTransactionRef, database: RocksDB, prepared: Bool = false) {
     self.handle = handle
+    self.database = database
+    self.prepared = prepared
   }
 
   deinit {
-    // If not committed, rollback
-    if !committed {
+    // If not committed, rollback; a prepared transaction released after its
+    // database closed stays prepared, as if it had been open at the close,
+    // and is recovered at the next open
+    if !committed && !(prepared && database?.isOpen != true) {
       rollback()
     }
     destroy()
   }
 
+  /// Take the native transaction out of this object for reuse
+  ///
+  /// An uncommitted transaction is rolled back first; afterwards every
+  /// operation on this object throws as if it were closed.
+  /// - Returns: Finished native transaction, or nil if already closed
+  internal func detachHandle() -> RocksDBTransactionRef? {
+    lock.withLock {
+      guard let h = handle else { return nil }
+      if !committed {
+        rocksdb_transaction_rollback(h)
+      }
+      handle = nil
+      return h
+    }
+  }
+
   private func destroy() {
     lock.withLock {
       if let h = handle {
@@ -35,22 +62,38 @@ public final class RocksDBTransaction: @unchecked Sendable {
     }
   }
 
+  /// Native handle of a column family, which must belong to the transaction's database
+  private func familyHandle(_ columnFamily: RocksDBColumnFamily?) throws -> RocksDBColumnFamilyRef? {
+    guard let family = columnFamily else {
+      return nil
+    }
+    guard let database, family.database === database else {
+      throw RocksDBError.invalidArgument("Column family \(family.name) belongs to another database")
+    }
+    return family.handle
+  }
+
   // MARK: - Read Operations
 
   /// Get value for key within the transaction
   /// - Parameters:
   ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
   ///   - options: Read options
   /// - Returns: Value data or nil if not found
   /// - Throws: RocksDBError on failure
-  public func get(_ key: Data, options: RocksDBReadOptions = .default) throws -> Data? {
-    try lock.withLock {
+  public func get(_ key: Data, in columnFamily: RocksDBColumnFamily? = nil,
+                  options: RocksDBReadOptions = .default) throws -> Data? {
+    if let family = columnFamily {
+      return try withValue(forKey: key, in: family, options: options) { Data($0) }
+    }
+
+    return try lock.withLock {
       guard let h = handle else {
         throw RocksDBError.invalidArgument("Transaction is closed")
       }
 
-      let readOpts = options.createHandle()
-      defer { rocksdb_read_options_destroy(readOpts) }
+      let readOpts = options.handle
 
       var valuePtr: UnsafeMutablePointer<CChar>?
       var valueLen: Int = 0
@@ -82,30 +125,95 @@ public final class RocksDBTransaction: @unchecked Sendable {
     }
   }
 
+  /// Access the value for key within the transaction, without copying
+  ///
+  /// The buffer points into the pinned value and is only valid for the
+  /// duration of `body`.
+  /// - Parameters:
+  ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options
+  ///   - body: Closure receiving the value bytes
+  /// - Returns: Result of `body`, or nil if the key was not found
+  /// - Throws: RocksDBError on failure, or any error thrown by `body`
+  public func withValue<R>(
+    forKey key: Data,
+    in columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBReadOptions = .default,
+    _ body: (UnsafeRawBufferPointer) throws -> R
+  ) throws -> R? {
+    try key.withUnsafeBytes { try withPinnedValue(forKey: $0, in: columnFamily, options: options, body) }
+  }
+
+  /// Pinned lookup shared by the `withValue` overloads
+  private func withPinnedValue<R>(
+    forKey key: UnsafeRawBufferPointer,
+    in columnFamily: RocksDBColumnFamily?,
+    options: RocksDBReadOptions,
+    _ body: (UnsafeRawBufferPointer) throws -> R
+  ) throws -> R? {
+    try lock.withLock {
+      guard let h = handle else {
+        throw RocksDBError.invalidArgument("Transaction is closed")
+      }
+      let cf = try familyHandle(columnFamily)
+
+      let readOpts = options.handle
+
+      var pinned: RocksDBPinnableSliceRef?
+
+      let status = rocksdb_transaction_get_pinned_cf(h, cf, readOpts,
+                                                     key.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                                     key.count,
+                                                     &pinned)
+
+      // NotFound is not an error
+      if status.code == RocksDBStatusNotFound {
+        if let msg = status.message {
+          rocksdb_free_string(msg)
+        }
+        return nil
+      }
+
+      try RocksDBError.check(status)
+
+      guard let slice = pinned else {
+        return nil
+      }
+      defer { rocksdb_pinnable_slice_destroy(slice) }
+
+      var valueLen: Int = 0
+      let ptr = rocksdb_pinnable_slice_value(slice, &valueLen)
+      return try body(UnsafeRawBufferPointer(start: ptr, count: ptr == nil ? 0 : valueLen))
+    }
+  }
+
   /// Get value for key with exclusive lock (for read-modify-write patterns)
   /// - Parameters:
   ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
   ///   - options: Read options
   /// - Returns: Value data or nil if not found
   /// - Throws: RocksDBError on failure
-  public func getForUpdate(_ key: Data, options: RocksDBReadOptions = .default) throws -> Data? {
+  public func getForUpdate(_ key: Data, in columnFamily: RocksDBColumnFamily? = nil,
+                           options: RocksDBReadOptions = .default) throws -> Data? {
     try lock.withLock {
       guard let h = handle else {
         throw RocksDBError.invalidArgument("Transaction is closed")
       }
+      let cf = try familyHandle(columnFamily)
 
-      let readOpts = options.createHandle()
-      defer { rocksdb_read_options_destroy(readOpts) }
+      let readOpts = options.handle
 
       var valuePtr: UnsafeMutablePointer<CChar>?
       var valueLen: Int = 0
 
       let status = key.withUnsafeBytes { keyPtr in
-        rocksdb_transaction_get_for_update(h, readOpts,
-                                           keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
-                                           key.count,
-                                           &valuePtr,
-                                           &valueLen)
+        rocksdb_transaction_get_for_update_cf(h, cf, readOpts,
+                                              keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                              key.count,
+                                              &valuePtr,
+                                              &valueLen)
       }
 
       // NotFound is not an error
@@ -127,54 +235,208 @@ public final class RocksDBTransaction: @unchecked Sendable {
     }
   }
 
+  /// Get values for multiple keys in a single batched lookup
+  /// - Parameters:
+  ///   - keys: Keys to look up
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options
+  /// - Returns: Values in key order, nil for keys that were not found
+  /// - Throws: RocksDBError for the first lookup that failed other than NotFound
+  public func multiGet(_ keys: [Data], in columnFamily: RocksDBColumnFamily? = nil,
+                       options: RocksDBReadOptions = .default) throws -> [Data?] {
+    try batchedRead(keys, in: columnFamily, options: options, rocksdb_transaction_multi_get_cf)
+  }
+
+  /// Get values for multiple keys, tracking each for conflicts like `getForUpdate`
+  ///
+  /// In pessimistic mode every key is locked, in one bridge call.
+  /// - Parameters:
+  ///   - keys: Keys to look up
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options
+  /// - Returns: Values in key order, nil for keys that were not found
+  /// - Throws: RocksDBError for the first lookup that failed other than NotFound
+  public func multiGetForUpdate(_ keys: [Data], in columnFamily: RocksDBColumnFamily? = nil,
+                                options: RocksDBReadOptions = .default) throws -> [Data?] {
+    try batchedRead(keys, in: columnFamily, options: options,
+                    rocksdb_transaction_multi_get_for_update_cf)
+  }
+
+  /// Shared body of the batched reads; values are copied because transaction
+  /// pins do not outlive the transaction
+  private func batchedRead(
+    _ keys: [Data],
+    in columnFamily: RocksDBColumnFamily?,
+    options: RocksDBReadOptions,
+    _ read: (RocksDBTransactionRef?, RocksDBColumnFamilyRef?, RocksDBReadOptionsRef?, Int,
+             UnsafePointer<UnsafePointer<CChar>?>?, UnsafePointer<Int>?,
+             UnsafeMutablePointer<RocksDBPinnableSliceRef?>?, UnsafeMutablePointer<RocksDBStatus>?) -> Void
+  ) throws -> [Data?] {
+    try lock.withLock {
+      guard let h = handle else {
+        throw RocksDBError.invalidArgument("Transaction is closed")
+      }
+      let cf = try familyHandle(columnFamily)
+
+      if keys.isEmpty {
+        return []
+      }
+
+      let readOpts = options.handle
+
+      var pinned = [RocksDBPinnableSliceRef?](repeating: nil, count: keys.count)
+      var statuses = [RocksDBStatus](repeating: RocksDBStatus(), count: keys.count)
+
+      keys.withPackedKeys { keyPtrs, keyLens in
+        read(h, cf, readOpts, keys.count, keyPtrs, keyLens, &pinned, &statuses)
+      }
+
+      var firstError: RocksDBError?
+      var results: [Data?] = []
+      results.reserveCapacity(keys.count)
+
+      for i in 0..<keys.count {
+        let status = statuses[i]
+        if status.code == RocksDBStatusOK, let slice = pinned[i] {
+          var valueLen: Int = 0
+          let ptr = rocksdb_pinnable_slice_value(slice, &valueLen)
+          results.append(ptr.map { Data(bytes: $0, count: valueLen) } ?? Data())
+          rocksdb_pinnable_slice_destroy(slice)
+          continue
+        }
+
+        if status.code != RocksDBStatusNotFound && firstError == nil {
+          firstError = RocksDBError.from(status)
+        }
+        if let msg = status.message {
+          rocksdb_free_string(msg)
+        }
+        results.append(nil)
+      }
+
+      if let error = firstError {
+        throw error
+      }
+      return results
+    }
+  }
+
   // MARK: - Write Operations
 
   /// Put a key-value pair within the transaction
   /// - Parameters:
   ///   - value: Value data
   ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
   /// - Throws: RocksDBError on failure
-  public func put(_ value: Data, forKey key: Data) throws {
+  public func put(_ value: Data, forKey key: Data, in columnFamily: RocksDBColumnFamily? = nil) throws {
     try lock.withLock {
       guard let h = handle else {
         throw RocksDBError.invalidArgument("Transaction is closed")
       }
+      let cf = try familyHandle(columnFamily)
 
       let status = key.withUnsafeBytes { keyPtr in
         value.withUnsafeBytes { valuePtr in
-          rocksdb_transaction_put(h,
-                                  keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
-                                  key.count,
-                                  valuePtr.baseAddress?.assumingMemoryBound(to: CChar.self),
-                                  value.count)
+          rocksdb_transaction_put_cf(h, cf,
+                                     keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                     key.count,
+                                     valuePtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                     value.count)
         }
       }
       try RocksDBError.check(status)
     }
   }
 
-  /// Put string value for string key within the transaction
+  /// Put string value for string key within the transaction, passing both in place
   public func put(_ value: String, forKey key: String) throws {
-    guard let keyData = key.data(using: .utf8),
-          let valueData = value.data(using: .utf8) else {
-      throw RocksDBError.invalidArgument("Invalid UTF-8 encoding")
+    try lock.withLock {
+      guard let h = handle else {
+        throw RocksDBError.invalidArgument("Transaction is closed")
+      }
+
+      let status = key.withUTF8Bytes { keyPtr in
+        value.withUTF8Bytes { valuePtr in
+          rocksdb_transaction_put_cf(h, nil,
+                                     keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                     keyPtr.count,
+                                     valuePtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                     valuePtr.count)
+        }
+      }
+      try RocksDBError.check(status)
     }
-    try put(valueData, forKey: keyData)
+  }
+
+  /// Merge an operand into the value for key within the transaction
+  /// - Parameters:
+  ///   - value: Merge operand
+  ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
+  /// - Throws: RocksDBError on failure
+  public func merge(_ value: Data, forKey key: Data, in columnFamily: RocksDBColumnFamily? = nil) throws {
+    try lock.withLock {
+      guard let h = handle else {
+        throw RocksDBError.invalidArgument("Transaction is closed")
+      }
+      let cf = try familyHandle(columnFamily)
+
+      let status = key.withUnsafeBytes { keyPtr in
+        value.withUnsafeBytes { valuePtr in
+          rocksdb_transaction_merge_cf(h, cf,
+                                       keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                       key.count,
+                                       valuePtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                       value.count)
+        }
+      }
+      try RocksDBError.check(status)
+    }
+  }
+
+  /// Add delta to a counter within the transaction (requires `.uint64Add`)
+  public func increment(_ key: Data, by delta: UInt64 = 1) throws {
+    try merge(RocksDBMergeOperator.encodeUInt64(delta), forKey: key)
   }
 
   /// Delete a key within the transaction
-  /// - Parameter key: Key data
+  /// - Parameters:
+  ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
   /// - Throws: RocksDBError on failure
-  public func delete(_ key: Data) throws {
+  public func delete(_ key: Data, in columnFamily: RocksDBColumnFamily? = nil) throws {
     try lock.withLock {
       guard let h = handle else {
         throw RocksDBError.invalidArgument("Transaction is closed")
       }
+      let cf = try familyHandle(columnFamily)
 
       let status = key.withUnsafeBytes { keyPtr in
-        rocksdb_transaction_delete(h,
-                                   keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
-                                   key.count)
+        rocksdb_transaction_delete_cf(h, cf,
+                                      keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                      key.count)
+      }
+      try RocksDBError.check(status)
+    }
+  }
+
+  /// Delete a write-once key within the transaction (see `RocksDB.singleDelete`)
+  /// - Parameters:
+  ///   - key: Key data
+  ///   - columnFamily: Column family (nil for the default family)
+  /// - Throws: RocksDBError on failure
+  public func singleDelete(_ key: Data, in columnFamily: RocksDBColumnFamily? = nil) throws {
+    try lock.withLock {
+      guard let h = handle else {
+        throw RocksDBError.invalidArgument("Transaction is closed")
+      }
+      let cf = try familyHandle(columnFamily)
+
+      let status = key.withUnsafeBytes { keyPtr in
+        rocksdb_transaction_single_delete_cf(h, cf,
+                                             keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                             key.count)
       }
       try RocksDBError.check(status)
     }
@@ -182,48 +444,213 @@ public final class RocksDBTransaction: @unchecked Sendable {
 
   /// Delete string key within the transaction
   public func delete(_ key: String) throws {
-    guard let keyData = key.data(using: .utf8) else {
-      throw RocksDBError.invalidArgument("Invalid key encoding")
+    try lock.withLock {
+      guard let h = handle else {
+        throw RocksDBError.invalidArgument("Transaction is closed")
+      }
+
+      let status = key.withUTF8Bytes { keyPtr in
+        rocksdb_transaction_delete_cf(h, nil,
+                                      keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                      keyPtr.count)
+      }
+      try RocksDBError.check(status)
     }
-    try delete(keyData)
   }
 
-  // MARK: - String Convenience Methods
+  // MARK: - Typed Keys
 
-  /// Get string value for string key
-  public func getString(_ key: String, options: RocksDBReadOptions = .default) throws -> String? {
-    guard let keyData = key.data(using: .utf8) else {
-      throw RocksDBError.invalidArgument("Invalid key encoding")
+  /// Get the value for a typed key within the transaction
+  /// - Parameters:
+  ///   - key: Key, in its order-preserving encoding
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options
+  /// - Returns: Value data or nil if not found
+  /// - Throws: RocksDBError on failure
+  public func get<Key: RocksDBKeyEncodable>(_ key: Key, in columnFamily: RocksDBColumnFamily? = nil,
+                                            options: RocksDBReadOptions = .default) throws -> Data? {
+    try lock.withLock {
+      guard let h = handle else {
+        throw RocksDBError.invalidArgument("Transaction is closed")
+      }
+      let cf = try familyHandle(columnFamily)
+
+      let readOpts = options.handle
+
+      var pinned: RocksDBPinnableSliceRef?
+
+      let status = key.withEncodedKey { keyPtr in
+        rocksdb_transaction_get_pinned_cf(h, cf, readOpts,
+                                          keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                          keyPtr.count,
+                                          &pinned)
+      }
+
+      // NotFound is not an error
+      if status.code == RocksDBStatusNotFound {
+        if let msg = status.message {
+          rocksdb_free_string(msg)
+        }
+        return nil
+      }
+
+      try RocksDBError.check(status)
+
+      guard let slice = pinned else {
+        return nil
+      }
+      defer { rocksdb_pinnable_slice_destroy(slice) }
+
+      var valueLen: Int = 0
+      let ptr = rocksdb_pinnable_slice_value(slice, &valueLen)
+      return ptr.map { Data(bytes: $0, count: valueLen) } ?? Data()
     }
-    guard let data = try get(keyData, options: options) else {
-      return nil
+  }
+
+  /// Put a key-value pair under a typed key within the transaction
+  /// - Throws: RocksDBError on failure
+  public func put<Key: RocksDBKeyEncodable>(_ value: Data, forKey key: Key,
+                                            in columnFamily: RocksDBColumnFamily? = nil) throws {
+    try lock.withLock {
+      guard let h = handle else {
+        throw RocksDBError.invalidArgument("Transaction is closed")
+      }
+      let cf = try familyHandle(columnFamily)
+
+      let status = key.withEncodedKey { keyPtr in
+        value.withUnsafeBytes { valuePtr in
+          rocksdb_transaction_put_cf(h, cf,
+                                     keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                     keyPtr.count,
+                                     valuePtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                     value.count)
+        }
+      }
+      try RocksDBError.check(status)
+    }
+  }
+
+  /// Merge an operand into the value for a typed key within the transaction
+  /// - Throws: RocksDBError on failure
+  public func merge<Key: RocksDBKeyEncodable>(_ value: Data, forKey key: Key,
+                                              in columnFamily: RocksDBColumnFamily? = nil) throws {
+    try lock.withLock {
+      guard let h = handle else {
+        throw RocksDBError.invalidArgument("Transaction is closed")
+      }
+      let cf = try familyHandle(columnFamily)
+
+      let status = key.withEncodedKey { keyPtr in
+        value.withUnsafeBytes { valuePtr in
+          rocksdb_transaction_merge_cf(h, cf,
+                                       keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                       keyPtr.count,
+                                       valuePtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                       value.count)
+        }
+      }
+      try RocksDBError.check(status)
     }
-    return String(data: data, encoding: .utf8)
+  }
+
+  /// Delete a typed key within the transaction
+  /// - Throws: RocksDBError on failure
+  public func delete<Key: RocksDBKeyEncodable>(_ key: Key, in columnFamily: RocksDBColumnFamily? = nil) throws {
+    try lock.withLock {
+      guard let h = handle else {
+        throw RocksDBError.invalidArgument("Transaction is closed")
+      }
+      let cf = try familyHandle(columnFamily)
+
+      let status = key.withEncodedKey { keyPtr in
+        rocksdb_transaction_delete_cf(h, cf,
+                                      keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                      keyPtr.count)
+      }
+      try RocksDBError.check(status)
+    }
+  }
+
+  // MARK: - String Convenience Methods
+
+  /// Get string value for string key (nil if missing or not valid UTF-8),
+  /// decoded straight from the pinned value
+  public func getString(_ key: String, options: RocksDBReadOptions = .default) throws -> String? {
+    try key.withUTF8Bytes { keyPtr in
+      try withPinnedValue(forKey: keyPtr, in: nil, options: options) { String(validatingUTF8Bytes: $0) }
+    } ?? nil
   }
 
   // MARK: - Iterator
 
   /// Create an iterator within the transaction
-  /// - Parameter options: Read options
+  ///
+  /// The iterator merges the transaction's writes over the database and
+  /// applies the bounds in `options` to both. It keeps the transaction
+  /// alive, and stops iterating once the transaction commits, rolls back or
+  /// rolls back to a savepoint; `status()` then reports the invalidation.
+  /// - Parameters:
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options
   /// - Returns: Transaction iterator
   /// - Throws: RocksDBError on failure
-  public func makeIterator(options: RocksDBReadOptions = .default) throws -> RocksDBIterator {
+  public func makeIterator(in columnFamily: RocksDBColumnFamily? = nil,
+                           options: RocksDBReadOptions = .default) throws -> RocksDBIterator {
     try lock.withLock {
       guard let h = handle else {
         throw RocksDBError.invalidArgument("Transaction is closed")
       }
+      let cf = try familyHandle(columnFamily)
 
-      let readOpts = options.createHandle()
-      defer { rocksdb_read_options_destroy(readOpts) }
+      let readOpts = options.handle
 
-      guard let iterHandle = rocksdb_transaction_create_iterator(h, readOpts) else {
+      guard let iterHandle = rocksdb_transaction_create_iterator_cf(h, cf, readOpts) else {
         throw RocksDBError.ioError("Failed to create transaction iterator")
       }
 
-      return RocksDBIterator(handle: iterHandle)
+      return RocksDBIterator(handle: iterHandle, owner: self)
     }
   }
 
+  /// Iterate over key-value pairs in a key range within the transaction
+  ///
+  /// The range is pushed down as iterator bounds, so both the transaction's
+  /// writes and the database stop at the end of the range.
+  /// - Parameters:
+  ///   - range: Half-open key range to scan
+  ///   - columnFamily: Column family (nil for the default family)
+  ///   - options: Read options (iterator bounds are replaced by the range)
+  ///   - body: Closure called for each key-value pair, return false to stop
+  /// - Throws: RocksDBError on failure
+  public func forEach(
+    in range: RocksDBKeyRange,
+    of columnFamily: RocksDBColumnFamily? = nil,
+    options: RocksDBReadOptions = .default,
+    _ body: (Data, Data) throws -> Bool
+  ) throws {
+    var boundedOptions = options
+    boundedOptions.iterateLowerBound = range.start
+    boundedOptions.iterateUpperBound = range.end
+
+    let iter = try makeIterator(in: columnFamily, options: boundedOptions)
+    defer { iter.close() }
+
+    if let start = range.start {
+      iter.seek(to: start)
+    } else {
+      iter.seekToFirst()
+    }
+
+    scan: while true {
+      let entries = iter.nextBatch()
+      if entries.isEmpty { break }
+      for entry in entries {
+        if try !body(entry.key, entry.value) { break scan }
+      }
+    }
+    try iter.checkStatus()
+  }
+
   // MARK: - Commit / Rollback
 
   /// Commit the transaction
@@ -250,11 +677,63 @@ public final class RocksDBTransaction: @unchecked Sendable {
     }
   }
 
+  // MARK: - Two-Phase Commit
+
+  /// Name of the transaction ("" until named)
+  public var name: String {
+    lock.withLock {
+      guard let h = handle, let cName = rocksdb_transaction_get_name(h) else { return "" }
+      defer { rocksdb_free_string(cName) }
+      return String(cString: cName)
+    }
+  }
+
+  /// Name the transaction for two-phase commit
+  ///
+  /// Names must be unique among the database's live transactions and can
+  /// only be set before the first write. Only pessimistic databases opened
+  /// with `RocksDBTransactionDBOptions.twoPhaseCommit` can name transactions.
+  /// - Parameter name: Transaction name
+  /// - Throws: RocksDBError on failure
+  public func setName(_ name: String) throws {
+    try lock.withLock {
+      guard let h = handle else {
+        throw RocksDBError.invalidArgument("Transaction is closed")
+      }
+
+      let status = rocksdb_transaction_set_name(h, name)
+      try RocksDBError.check(status)
+    }
+  }
+
+  /// Prepare a named transaction: the first phase of two-phase commit
+  ///
+  /// The transaction's writes are persisted to the WAL, so after a crash it
+  /// is recovered in the prepared state (see `RocksDB.preparedTransactions()`)
+  /// and `commit()` only has to write a commit marker. Under
+  /// `.writePrepared` and `.writeUnprepared` the writes also reach the
+  /// memtable here instead of at commit.
+  /// - Throws: RocksDBError on failure
+  public func prepare() throws {
+    try lock.withLock {
+      guard let h = handle else {
+        throw RocksDBError.invalidArgument("Transaction is closed")
+      }
+
+      let status = rocksdb_transaction_prepare(h)
+      try RocksDBError.check(status)
+      prepared = true
+    }
+  }
+
   /// Rollback the transaction
+  ///
+  /// Also rolls back a prepared transaction.
   public func rollback() {
     lock.withLock {
       guard let h = handle else { return }
       rocksdb_transaction_rollback(h)
+      prepared = false
     }
   }
 
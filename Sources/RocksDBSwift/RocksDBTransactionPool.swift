@@ -0,0 +1,80 @@
+//
+//  RocksDBTransactionPool.swift
+//  RocksDB.swift
+//
+//  Reusable native transaction pool
+//
+
+import Foundation
+import CRocksDB
+
+/// Thread-safe pool of finished native transactions
+///
+/// Beginning a transaction on a pooled handle reinitializes it in place
+/// (`BeginTransaction` with `old_txn`), so its write batch, tracked keys
+/// and lock bookkeeping keep their allocations between transactions.
+/// Pooled handles belong to one database and are destroyed when it closes.
+public final class RocksDBTransactionPool: @unchecked Sendable {
+  private let lock = NSLock()
+  private var available: [RocksDBTransactionRef] = []
+
+  /// Maximum number of idle transactions kept in the pool
+  public let maxPooledTransactions: Int
+
+  /// Create a transaction pool
+  /// - Parameter maxPooledTransactions: Maximum number of idle transactions kept
+  public init(maxPooledTransactions: Int = 16) {
+    self.maxPooledTransactions = maxPooledTransactions
+  }
+
+  deinit {
+    drain()
+  }
+
+  /// Number of idle transactions in the pool
+  public var count: Int {
+    lock.withLock { available.count }
+  }
+
+  /// Begin a transaction, reusing an idle native handle when one is pooled
+  /// - Parameters:
+  ///   - db: Open transactional database handle
+  ///   - options: Write options handle
+  ///   - snapshot: Take a snapshot at begin
+  /// - Returns: Native transaction, or nil if it could not be begun
+  internal func begin(on db: RocksDBRef, options: RocksDBWriteOptionsRef,
+                      snapshot: Bool) -> RocksDBTransactionRef? {
+    let old = lock.withLock { available.popLast() }
+    if let txn = rocksdb_transaction_begin_reusing(db, options, snapshot ? 1 : 0, old) {
+      return txn
+    }
+    if let old = old {
+      rocksdb_transaction_destroy(old)
+    }
+    return nil
+  }
+
+  /// Return a finished native transaction to the pool
+  /// - Parameter txn: Committed or rolled back transaction; must not be used afterwards
+  internal func release(_ txn: RocksDBTransactionRef) {
+    let pooled = lock.withLock {
+      guard available.count < maxPooledTransactions else { return false }
+      available.append(txn)
+      return true
+    }
+    if !pooled {
+      rocksdb_transaction_destroy(txn)
+    }
+  }
+
+  /// Destroy all idle transactions; must run before the database closes
+  internal func drain() {
+    let idle = lock.withLock {
+      defer { available.removeAll() }
+      return available
+    }
+    for txn in idle {
+      rocksdb_transaction_destroy(txn)
+    }
+  }
+}
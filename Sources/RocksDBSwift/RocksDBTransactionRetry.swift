@@ -0,0 +1,161 @@
+//
+//  RocksDBTransactionRetry.swift
+//  RocksDB.swift
+//
+//  Conflict retry policy and transaction contention metrics
+//
+
+import Foundation
+import CRocksDB
+
+/// Retry policy for `RocksDB.transaction(options:snapshot:retry:_:)`
+///
+/// A transaction failing with a conflict (`transactionConflict`, `busy`,
+/// `tryAgain`, or `timedOut` waiting for a lock) is rolled back and rerun
+/// after an exponentially growing, jittered delay, until it commits, runs
+/// out of attempts, or the next attempt would start past the deadline.
+public struct RocksDBRetryPolicy: Sendable {
+  /// Total attempts including the first (1 = never retry)
+  public var maxAttempts: Int
+
+  /// Delay before the first retry, in seconds
+  public var initialBackoff: TimeInterval
+
+  /// Upper bound of a single delay, in seconds
+  public var maxBackoff: TimeInterval
+
+  /// Growth factor of the delay per retry
+  public var multiplier: Double
+
+  /// Fraction of each delay that is randomized (0 = fixed, 1 = full jitter)
+  public var jitter: Double
+
+  /// Time budget measured from the first attempt, in seconds (nil = unlimited)
+  public var deadline: TimeInterval?
+
+  /// Create a retry policy
+  /// - Parameters:
+  ///   - maxAttempts: Total attempts including the first
+  ///   - initialBackoff: Delay before the first retry, in seconds
+  ///   - maxBackoff: Upper bound of a single delay, in seconds
+  ///   - multiplier: Growth factor of the delay per retry
+  ///   - jitter: Randomized fraction of each delay
+  ///   - deadline: Time budget from the first attempt, in seconds
+  public init(
+    maxAttempts: Int = 8,
+    initialBackoff: TimeInterval = 0.001,
+    maxBackoff: TimeInterval = 0.1,
+    multiplier: Double = 2,
+    jitter: Double = 0.5,
+    deadline: TimeInterval? = nil
+  ) {
+    self.maxAttempts = maxAttempts
+    self.initialBackoff = initialBackoff
+    self.maxBackoff = maxBackoff
+    self.multiplier = multiplier
+    self.jitter = jitter
+    self.deadline = deadline
+  }
+
+  /// Never retry; conflicts are thrown to the caller
+  public static let none = RocksDBRetryPolicy(maxAttempts: 1)
+
+  /// Up to 8 attempts with 1 ms to 100 ms of jittered backoff
+  public static let `default` = RocksDBRetryPolicy()
+
+  /// Whether an error is a conflict worth retrying
+  /// - Parameter error: Error thrown by the transaction
+  /// - Returns: True for conflict, busy, try-again and lock timeout errors
+  public static func isRetryable(_ error: Error) -> Bool {
+    switch error {
+    case RocksDBError.transactionConflict, RocksDBError.busy, RocksDBError.tryAgain,
+         RocksDBError.timedOut(.lockTimeout), RocksDBError.timedOut(.mutexTimeout):
+      return true
+    default:
+      return false
+    }
+  }
+
+  /// Delay before a retry
+  /// - Parameter attempt: Number of the attempt that just failed (1-based)
+  /// - Returns: Delay in seconds
+  public func backoff(afterAttempt attempt: Int) -> TimeInterval {
+    let exponent = Double(max(attempt - 1, 0))
+    let base = min(initialBackoff * pow(multiplier, exponent), maxBackoff)
+    let fixed = base * (1 - min(max(jitter, 0), 1))
+    return fixed + Double.random(in: 0...1) * (base - fixed)
+  }
+}
+
+/// Contention counters of a database's closure transactions
+public struct RocksDBTransactionMetrics: Sendable, Equatable {
+  /// Transaction attempts started, including retries
+  public var attempts: Int = 0
+
+  /// Transactions committed
+  public var commits: Int = 0
+
+  /// Attempts that failed with a retryable conflict
+  public var conflicts: Int = 0
+
+  /// Transactions that gave up after their last conflicting attempt
+  public var exhausted: Int = 0
+
+  /// Transactions that needed more than one attempt
+  public var retried: Int = 0
+
+  /// Total time slept between attempts, in seconds
+  public var backoffTime: TimeInterval = 0
+
+  /// Total time from first attempt to final outcome of retried transactions, in seconds
+  public var retryLatency: TimeInterval = 0
+
+  /// Longest such time of a single transaction, in seconds
+  public var maxRetryLatency: TimeInterval = 0
+
+  public init() {}
+}
+
+/// Thread-safe accumulator behind `RocksDB.transactionMetrics`
+internal final class RocksDBTransactionCounters: @unchecked Sendable {
+  private let lock = NSLock()
+  private var metrics = RocksDBTransactionMetrics()
+
+  var snapshot: RocksDBTransactionMetrics {
+    lock.withLock { metrics }
+  }
+
+  func reset() {
+    lock.withLock { metrics = RocksDBTransactionMetrics() }
+  }
+
+  func recordAttempt() {
+    lock.withLock { metrics.attempts += 1 }
+  }
+
+  func recordConflict(backoff: TimeInterval) {
+    lock.withLock {
+      metrics.conflicts += 1
+      metrics.backoffTime += backoff
+    }
+  }
+
+  /// Record the final outcome of a transaction
+  /// - Parameters:
+  ///   - committed: Whether it committed (false = gave up on a conflict)
+  ///   - attempts: Attempts it took
+  ///   - elapsed: Time since its first attempt, in seconds
+  func recordOutcome(committed: Bool, attempts: Int, elapsed: TimeInterval) {
+    lock.withLock {
+      if committed {
+        metrics.commits += 1
+      } else {
+        metrics.exhausted += 1
+      }
+      guard attempts > 1 else { return }
+      metrics.retried += 1
+      metrics.retryLatency += elapsed
+      metrics.maxRetryLatency = max(metrics.maxRetryLatency, elapsed)
+    }
+  }
+}
@@ -0,0 +1,130 @@
+//
+//  RocksDBWideColumns.swift
+//  RocksDB.swift
+//
+//  Zero-copy view of wide-column entities
+//
+
+import Foundation
+import CRocksDB
+
+/// Borrowed view of the columns of one wide-column entity
+///
+/// Column names and values point into memory owned by RocksDB (a pinned
+/// entity or attribute group, or an iterator position) and are only valid inside the closure
+/// that received the view. Columns are sorted by name; a plain value shows
+/// up as a single column with an empty name.
+public struct RocksDBWideColumns {
+  private enum Source {
+    case entity(RocksDBWideColumnsRef)
+    case iterator(RocksDBIteratorRef)
+    case attributeGroup(RocksDBAttributeGroupsRef, Int)
+    case attributeGroupIterator(RocksDBAttributeGroupIteratorRef, Int)
+  }
+
+  private let source: Source
+
+  /// Number of columns
+  public let count: Int
+
+  internal init(entity: RocksDBWideColumnsRef) {
+    source = .entity(entity)
+    count = rocksdb_wide_columns_count(entity)
+  }
+
+  internal init(iterator: RocksDBIteratorRef) {
+    source = .iterator(iterator)
+    count = rocksdb_iterator_columns_count(iterator)
+  }
+
+  internal init(groups: RocksDBAttributeGroupsRef, group: Int) {
+    source = .attributeGroup(groups, group)
+    count = rocksdb_attribute_group_column_count(groups, group)
+  }
+
+  internal init(groupIterator: RocksDBAttributeGroupIteratorRef, group: Int) {
+    source = .attributeGroupIterator(groupIterator, group)
+    count = rocksdb_attribute_group_iterator_column_count(groupIterator, group)
+  }
+
+  /// Name of the column at `index`
+  public func name(at index: Int) -> UnsafeRawBufferPointer {
+    precondition(index >= 0 && index < count, "Column index out of range")
+    var len: Int = 0
+    let ptr: UnsafePointer<CChar>?
+    switch source {
+    case .entity(let ref):
+      ptr = rocksdb_wide_columns_name(ref, index, &len)
+    case .iterator(let ref):
+      ptr = rocksdb_iterator_column_name(ref, index, &len)
+    case .attributeGroup(let ref, let group):
+      ptr = rocksdb_attribute_group_column_name(ref, group, index, &len)
+    case .attributeGroupIterator(let ref, let group):
+      ptr = rocksdb_attribute_group_iterator_column_name(ref, group, index, &len)
+    }
+    return UnsafeRawBufferPointer(start: ptr, count: ptr == nil ? 0 : len)
+  }
+
+  /// Value of the column at `index`
+  public func value(at index: Int) -> UnsafeRawBufferPointer {
+    precondition(index >= 0 && index < count, "Column index out of range")
+    var len: Int = 0
+    let ptr: UnsafePointer<CChar>?
+    switch source {
+    case .entity(let ref):
+      ptr = rocksdb_wide_columns_value(ref, index, &len)
+    case .iterator(let ref):
+      ptr = rocksdb_iterator_column_value(ref, index, &len)
+    case .attributeGroup(let ref, let group):
+      ptr = rocksdb_attribute_group_column_value(ref, group, index, &len)
+    case .attributeGroupIterator(let ref, let group):
+      ptr = rocksdb_attribute_group_iterator_column_value(ref, group, index, &len)
+    }
+    return UnsafeRawBufferPointer(start: ptr, count: ptr == nil ? 0 : len)
+  }
+
+  /// Value of the column with the given name (nil if absent)
+  public func value(forColumn name: Data) -> UnsafeRawBufferPointer? {
+    if case .entity(let ref) = source {
+      var len: Int = 0
+      let ptr = name.withUnsafeBytes { namePtr in
+        rocksdb_wide_columns_find(ref,
+                                  namePtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                                  name.count,
+                                  &len)
+      }
+      return ptr.map { UnsafeRawBufferPointer(start: $0, count: len) }
+    }
+
+    // Columns are sorted by name, so binary search them
+    var low = 0
+    var high = count
+    while low < high {
+      let mid = (low + high) / 2
+      let candidate = self.name(at: mid)
+      if candidate.elementsEqual(name) {
+        return value(at: mid)
+      }
+      if candidate.lexicographicallyPrecedes(name) {
+        low = mid + 1
+      } else {
+        high = mid
+      }
+    }
+    return nil
+  }
+
+  /// Visit every column in name order
+  public func forEach(
+    _ body: (_ name: UnsafeRawBufferPointer, _ value: UnsafeRawBufferPointer) throws -> Void
+  ) rethrows {
+    for i in 0..<count {
+      try body(name(at: i), value(at: i))
+    }
+  }
+
+  /// Copy all columns out of the view
+  public func copy() -> [(name: Data, value: Data)] {
+    (0..<count).map { (name: Data(name(at: $0)), value: Data(value(at: $0))) }
+  }
+}
@@ -0,0 +1,61 @@
+//
+//  RocksDBWriteBufferManager.swift
+//  RocksDB.swift
+//
+//  Shared memtable memory budget for RocksDB databases
+//
+
+import Foundation
+import CRocksDB
+
+/// Memtable memory budget that can be shared by multiple databases
+///
+/// Assign the same manager to `RocksDBOptions.writeBufferManager` of several
+/// databases to cap their combined memtable memory. Once usage approaches the
+/// limit, the largest memtables are flushed early. Each database keeps the
+/// native manager alive for as long as it is open.
+public final class RocksDBWriteBufferManager: @unchecked Sendable {
+  internal let handle: RocksDBWriteBufferManagerRef
+
+  /// Create a write buffer manager
+  /// - Parameters:
+  ///   - bufferSize: Total memtable memory limit in bytes
+  ///   - cache: Block cache to charge memtable memory to, so both share one budget
+  ///   - allowStall: Stall writes once memory usage exceeds the limit
+  public init(bufferSize: Int, cache: RocksDBCache? = nil, allowStall: Bool = false) {
+    self.handle = rocksdb_write_buffer_manager_create(bufferSize, cache?.handle,
+                                                      allowStall ? 1 : 0)!
+  }
+
+  deinit {
+    rocksdb_write_buffer_manager_destroy(handle)
+  }
+
+  // MARK: - Properties
+
+  /// Memory limit in bytes; may be changed at runtime
+  public var bufferSize: Int {
+    get { rocksdb_write_buffer_manager_get_buffer_size(handle) }
+    set { rocksdb_write_buffer_manager_set_buffer_size(handle, newValue) }
+  }
+
+  /// Stall writes once memory usage exceeds the limit
+  public func setAllowStall(_ allowStall: Bool) {
+    rocksdb_write_buffer_manager_set_allow_stall(handle, allowStall ? 1 : 0)
+  }
+
+  /// Memory used by all memtables, in bytes
+  public var memoryUsage: Int {
+    rocksdb_write_buffer_manager_get_memory_usage(handle)
+  }
+
+  /// Memory used by mutable (not yet flushing) memtables, in bytes
+  public var mutableMemtableMemoryUsage: Int {
+    rocksdb_write_buffer_manager_get_mutable_memtable_memory_usage(handle)
+  }
+
+  /// Memory charged to the block cache, in bytes (0 without a cache)
+  public var cacheChargedUsage: Int {
+    rocksdb_write_buffer_manager_get_dummy_entries_in_cache_usage(handle)
+  }
+}
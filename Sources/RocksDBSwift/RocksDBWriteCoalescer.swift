@@ -0,0 +1,187 @@
+//
+//  RocksDBWriteCoalescer.swift
+//  RocksDB.swift
+//
+//  Group commit for many concurrent writers
+//
+
+import Foundation
+import CRocksDB
+
+/// Coalesces small writes from many concurrent callers into shared batches
+///
+/// Each write is appended to a pending batch and its caller suspended. The
+/// batch is written (with a single WAL sync when `options.sync` is set) once
+/// it reaches `maxBatchBytes` or `maxBatchEntries`, or `maxLatency` after its
+/// first write, and every caller is then resumed with the shared result.
+/// Writes in one group commit atomically together, so one failing write
+/// fails the whole group.
+public final class RocksDBWriteCoalescer: @unchecked Sendable {
+  /// Target database
+  public let database: RocksDB
+
+  /// Write options used for every group
+  public let options: RocksDBWriteOptions
+
+  /// Flush once the pending batch holds this many bytes
+  public let maxBatchBytes: Int
+
+  /// Flush once the pending batch holds this many caller writes
+  public let maxBatchEntries: Int
+
+  /// Longest time a write waits for more writes to join its group, in seconds
+  public let maxLatency: TimeInterval
+
+  private let lock = NSLock()
+  private let queue = DispatchQueue(label: "RocksDBSwift.WriteCoalescer", qos: .userInitiated)
+  private var pending: RocksDBBatch
+  private var waiters: [CheckedContinuation<Void, Error>] = []
+  private var deadlineArmed = false
+  /// Bumped whenever a group is taken, so a deadline armed for an earlier
+  /// group does not cut the current one short
+  private var generation: UInt64 = 0
+  private var _writesCompleted = 0
+  private var _groupsWritten = 0
+
+  /// Create a write coalescer
+  /// - Parameters:
+  ///   - database: Target database
+  ///   - options: Write options for each group (default: synced writes)
+  ///   - maxBatchBytes: Flush threshold in bytes
+  ///   - maxBatchEntries: Flush threshold in caller writes
+  ///   - maxLatency: Deadline after the first write of a group, in seconds
+  public init(
+    database: RocksDB,
+    options: RocksDBWriteOptions = .sync,
+    maxBatchBytes: Int = 1024 * 1024,
+    maxBatchEntries: Int = 1024,
+    maxLatency: TimeInterval = 0.002
+  ) {
+    self.database = database
+    self.options = options
+    self.maxBatchBytes = maxBatchBytes
+    self.maxBatchEntries = maxBatchEntries
+    self.maxLatency = maxLatency
+    self.pending = database.batchPool.acquire()
+  }
+
+  deinit {
+    // Every queued flush retains the coalescer, so nothing waits on `pending`
+    database.batchPool.release(pending)
+  }
+
+  // MARK: - Operations
+
+  /// Queue a put and wait for its group to commit
+  /// - Parameters:
+  ///   - value: Value data
+  ///   - key: Key data
+  /// - Throws: RocksDBError if the group write fails
+  public func put(_ value: Data, forKey key: Data) async throws {
+    try await write { $0.put(value, forKey: key) }
+  }
+
+  /// Queue a string put and wait for its group to commit
+  public func put(_ value: String, forKey key: String) async throws {
+    guard let keyData = key.data(using: .utf8),
+          let valueData = value.data(using: .utf8) else {
+      throw RocksDBError.invalidArgument("Invalid UTF-8 encoding")
+    }
+    try await put(valueData, forKey: keyData)
+  }
+
+  /// Queue a merge and wait for its group to commit
+  public func merge(_ value: Data, forKey key: Data) async throws {
+    try await write { $0.merge(value, forKey: key) }
+  }
+
+  /// Queue a delete and wait for its group to commit
+  public func delete(_ key: Data) async throws {
+    try await write { $0.delete(key) }
+  }
+
+  /// Queue several operations that commit in the same group
+  /// - Parameter operations: Closure adding operations to the shared batch;
+  ///   runs synchronously and must not retain the batch
+  /// - Throws: RocksDBError if the group write fails
+  public func write(_ operations: (RocksDBBatch) -> Void) async throws {
+    try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Void, Error>) in
+      let (flushNow, armDeadline, group) = lock.withLock { () -> (Bool, Bool, UInt64) in
+        operations(pending)
+        waiters.append(continuation)
+
+        let full = pending.dataSize >= maxBatchBytes || waiters.count >= maxBatchEntries
+        let arm = !full && !deadlineArmed
+        if arm {
+          deadlineArmed = true
+        }
+        return (full, arm, generation)
+      }
+
+      if flushNow {
+        queue.async { self.flushPending() }
+      } else if armDeadline {
+        queue.asyncAfter(deadline: .now() + maxLatency) { self.flushPending(expiring: group) }
+      }
+    }
+  }
+
+  /// Write the pending group now and wait for it to finish
+  ///
+  /// Must not be called from the coalescer's own queue, which it waits on.
+  public func flush() {
+    dispatchPrecondition(condition: .notOnQueue(queue))
+    queue.sync { flushPending() }
+  }
+
+  // MARK: - Statistics
+
+  /// Caller writes committed so far
+  public var writesCompleted: Int {
+    lock.withLock { _writesCompleted }
+  }
+
+  /// Groups written so far
+  public var groupsWritten: Int {
+    lock.withLock { _groupsWritten }
+  }
+
+  // MARK: - Private
+
+  /// Runs on `queue`, so groups are written one at a time and the next
+  /// group fills while the current one syncs
+  /// - Parameter expiring: Generation whose deadline fired; the flush is
+  ///   skipped if that group has already been written
+  private func flushPending(expiring: UInt64? = nil) {
+    let (batch, group) = lock.withLock { () -> (RocksDBBatch, [CheckedContinuation<Void, Error>]) in
+      if let expiring, expiring != generation {
+        return (pending, [])
+      }
+      let batch = pending
+      let group = waiters
+      if !group.isEmpty {
+        pending = database.batchPool.acquire()
+        waiters = []
+        generation &+= 1
+      }
+      deadlineArmed = false
+      return (batch, group)
+    }
+
+    guard !group.isEmpty else { return }
+
+    let result = Result { try database.writeBatch(batch, options: options) }
+    database.batchPool.release(batch)
+
+    lock.withLock {
+      if case .success = result {
+        _writesCompleted += group.count
+      }
+      _groupsWritten += 1
+    }
+
+    for continuation in group {
+      continuation.resume(with: result)
+    }
+  }
+}
@@ -0,0 +1,174 @@
+//
+//  RocksDBWriteStall.swift
+//  RocksDB.swift
+//
+//  Write stall state and a monitor for throttling writers ahead of a stall
+//
+
+import Foundation
+import CRocksDB
+
+/// What is holding writes back
+public enum RocksDBWriteStallCause: Int32, Sendable {
+  case none = 0
+  /// Too many unflushed memtables
+  case memtableLimit = 1
+  /// Too many L0 files
+  case l0FileCount = 2
+  /// Too many bytes waiting to be compacted
+  case pendingCompactionBytes = 3
+}
+
+/// Write stall inputs of one column family and the condition they imply
+///
+/// The condition is derived with RocksDB's own thresholds, in the same order
+/// RocksDB applies them, so it changes as soon as the next write would see
+/// the new condition. `isWriteStopped` and `delayedWriteRate` are what the
+/// write controller actually enforces database-wide.
+public struct RocksDBWriteStallState: Sendable, Equatable {
+  public var condition: RocksDBWriteStallCondition
+  public var cause: RocksDBWriteStallCause
+
+  /// Writes to the database are currently stopped
+  public var isWriteStopped: Bool
+
+  /// Rate writes are throttled to in bytes per second, 0 when not delayed
+  public var delayedWriteRate: UInt64
+
+  public var l0Files: Int
+  public var l0SlowdownTrigger: Int
+  public var l0StopTrigger: Int
+  public var immutableMemtables: Int
+  public var maxWriteBufferNumber: Int
+  public var pendingCompactionBytes: UInt64
+  public var softPendingCompactionBytesLimit: UInt64
+  public var hardPendingCompactionBytesLimit: UInt64
+
+  init(_ state: RocksDBWriteStallValues) {
+    condition = RocksDBWriteStallCondition(rawValue: Int32(state.condition)) ?? .normal
+    cause = RocksDBWriteStallCause(rawValue: Int32(state.cause)) ?? .none
+    isWriteStopped = state.is_write_stopped != 0
+    delayedWriteRate = state.delayed_write_rate
+    l0Files = Int(state.l0_files)
+    l0SlowdownTrigger = Int(state.l0_slowdown_trigger)
+    l0StopTrigger = Int(state.l0_stop_trigger)
+    immutableMemtables = Int(state.immutable_memtables)
+    maxWriteBufferNumber = Int(state.max_write_buffer_number)
+    pendingCompactionBytes = state.pending_compaction_bytes
+    softPendingCompactionBytesLimit = state.soft_pending_compaction_bytes_limit
+    hardPendingCompactionBytesLimit = state.hard_pending_compaction_bytes_limit
+  }
+
+  /// How close the family is to its first slowdown, from 0 (idle) upwards
+  ///
+  /// The largest of L0 files over the slowdown trigger, pending compaction
+  /// bytes over the soft limit and immutable memtables over the memtable
+  /// slowdown point. Values at or above 1 mean writes are already delayed;
+  /// throttling producers from around 0.8 usually avoids reaching it.
+  public var pressure: Double {
+    var ratios: [Double] = []
+    if l0SlowdownTrigger > 0 {
+      ratios.append(Double(l0Files) / Double(l0SlowdownTrigger))
+    }
+    if softPendingCompactionBytesLimit > 0 {
+      ratios.append(Double(pendingCompactionBytes) / Double(softPendingCompactionBytesLimit))
+    }
+    if maxWriteBufferNumber > 1 {
+      // Memtables only delay writes with more than three buffers
+      let slowdown = maxWriteBufferNumber > 3 ? maxWriteBufferNumber - 1 : maxWriteBufferNumber
+      ratios.append(Double(immutableMemtables) / Double(slowdown))
+    }
+    return ratios.max() ?? 0
+  }
+}
+
+/// Polls write stall state and reports changes before writes stall
+///
+/// The handler runs on the monitor's queue whenever the condition changes or
+/// `pressure` crosses `warningThreshold` in either direction, so producers
+/// can back off ahead of a slowdown and resume once compactions catch up.
+/// For the exact moments RocksDB changes condition, use the stall events of
+/// `RocksDBEventListener` instead.
+public final class RocksDBWriteStallMonitor: @unchecked Sendable {
+  /// Database being watched
+  public let database: RocksDB
+
+  /// Column family being watched (nil for the default family)
+  public let columnFamily: RocksDBColumnFamily?
+
+  /// Pressure at which the state counts as approaching a stall
+  public let warningThreshold: Double
+
+  private let handler: @Sendable (RocksDBWriteStallState) -> Void
+  private let lock = NSLock()
+  private var lastCondition: RocksDBWriteStallCondition?
+  private var lastWarning = false
+  private var timer: DispatchSourceTimer?
+
+  /// Create a monitor; call `start(pollInterval:)` to begin
+  public init(
+    database: RocksDB,
+    columnFamily: RocksDBColumnFamily? = nil,
+    warningThreshold: Double = 0.8,
+    handler: @escaping @Sendable (RocksDBWriteStallState) -> Void
+  ) {
+    self.database = database
+    self.columnFamily = columnFamily
+    self.warningThreshold = warningThreshold
+    self.handler = handler
+  }
+
+  deinit {
+    stop()
+  }
+
+  /// Whether the last evaluated state was at or above the warning threshold
+  public var isApproachingStall: Bool {
+    lock.withLock { lastWarning }
+  }
+
+  /// Evaluate now and then every `pollInterval` seconds
+  public func start(pollInterval: TimeInterval = 1) {
+    let source = DispatchSource.makeTimerSource(queue: DispatchQueue(label: "RocksDBWriteStallMonitor"))
+    source.schedule(deadline: .now(), repeating: pollInterval)
+    source.setEventHandler { [weak self] in
+      _ = try? self?.evaluate()
+    }
+
+    lock.withLock {
+      timer?.cancel()
+      timer = source
+    }
+    source.resume()
+  }
+
+  /// Stop polling
+  public func stop() {
+    let source = lock.withLock { () -> DispatchSourceTimer? in
+      defer { timer = nil }
+      return timer
+    }
+    source?.cancel()
+  }
+
+  /// Read the current state and call the handler if it changed
+  /// - Returns: Current state
+  /// - Throws: RocksDBError if the state cannot be read
+  @discardableResult
+  public func evaluate() throws -> RocksDBWriteStallState {
+    let state = try database.writeStallState(of: columnFamily)
+    let warning = state.condition != .normal || state.pressure >= warningThreshold
+
+    let changed = lock.withLock { () -> Bool in
+      defer {
+        lastCondition = state.condition
+        lastWarning = warning
+      }
+      return lastCondition != state.condition || lastWarning != warning
+    }
+    if changed {
+      handler(state)
+    }
+    return state
+  }
+}
@@ -64,6 +64,35 @@ public final class RocksDBLite: @unchecked Sendable {
     return RocksDBLite(handle: handle, path: path)
   }
 
+  /// Open a new database held entirely in memory
+  ///
+  /// Nothing touches the disk, and the data is gone once the database is
+  /// closed; for per-request scratch stores and tests.
+  /// - Returns: Open database instance
+  /// - Throws: RocksDBLiteError on failure
+  public static func openInMemory() throws -> RocksDBLite {
+    let opts = rocksdb_options_create()
+    defer { rocksdb_options_destroy(opts) }
+
+    let path = "/in-memory"
+    var dbHandle: RocksDBRef?
+    let status = rocksdb_open_in_memory(path, opts, &dbHandle)
+
+    if status.code != RocksDBStatusOK {
+      let message = status.message.map { String(cString: $0) } ?? "Unknown error"
+      if let msg = status.message {
+        rocksdb_free_string(msg)
+      }
+      throw RocksDBLiteError.openFailed(message)
+    }
+
+    guard let handle = dbHandle else {
+      throw RocksDBLiteError.openFailed("Failed to open database")
+    }
+
+    return RocksDBLite(handle: handle, path: path)
+  }
+
   /// Open a RocksDB database in read-only mode
   /// - Parameter path: Path to database directory
   /// - Returns: Open database instance
@@ -113,12 +142,9 @@ public final class RocksDBLite: @unchecked Sendable {
         throw RocksDBLiteError.databaseClosed
       }
 
-      let writeOpts = rocksdb_write_options_create()
-      defer { rocksdb_write_options_destroy(writeOpts) }
-
       let status = key.withUnsafeBytes { keyPtr in
         value.withUnsafeBytes { valuePtr in
-          rocksdb_put(h, writeOpts,
+          rocksdb_put(h, nil,
                       keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
                       key.count,
                       valuePtr.baseAddress?.assumingMemoryBound(to: CChar.self),
@@ -146,14 +172,11 @@ public final class RocksDBLite: @unchecked Sendable {
         throw RocksDBLiteError.databaseClosed
       }
 
-      let readOpts = rocksdb_read_options_create()
-      defer { rocksdb_read_options_destroy(readOpts) }
-
       var valuePtr: UnsafeMutablePointer<CChar>?
       var valueLen: Int = 0
 
       let status = key.withUnsafeBytes { keyPtr in
-        rocksdb_get(h, readOpts,
+        rocksdb_get(h, nil,
                     keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
                     key.count,
                     &valuePtr,
@@ -184,6 +207,59 @@ public final class RocksDBLite: @unchecked Sendable {
     }
   }
 
+  /// Access the value for key in place, without materializing a `Data`
+  ///
+  /// The buffer points into the pinned RocksDB value and is only valid for
+  /// the duration of `body`.
+  /// - Parameters:
+  ///   - key: Key data
+  ///   - body: Closure receiving the value bytes
+  /// - Returns: Result of `body`, or nil if the key was not found
+  /// - Throws: RocksDBLiteError on failure, or any error thrown by `body`
+  public func withValue<R>(forKey key: Data, _ body: (UnsafeRawBufferPointer) throws -> R) throws -> R? {
+    // The pinned slice retains the native database, so body runs unlocked
+    let pinned: RocksDBPinnableSliceRef? = try lock.withLock {
+      guard let h = handle else {
+        throw RocksDBLiteError.databaseClosed
+      }
+
+      var result: RocksDBPinnableSliceRef?
+
+      let status = key.withUnsafeBytes { keyPtr in
+        rocksdb_get_pinned(h, nil,
+                           keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
+                           key.count,
+                           &result)
+      }
+
+      if status.code == RocksDBStatusNotFound {
+        if let msg = status.message {
+          rocksdb_free_string(msg)
+        }
+        return nil
+      }
+
+      if status.code != RocksDBStatusOK {
+        let message = status.message.map { String(cString: $0) } ?? "Get failed"
+        if let msg = status.message {
+          rocksdb_free_string(msg)
+        }
+        throw RocksDBLiteError.operationFailed(message)
+      }
+
+      return result
+    }
+
+    guard let slice = pinned else {
+      return nil
+    }
+    defer { rocksdb_pinnable_slice_destroy(slice) }
+
+    var valueLen: Int = 0
+    let ptr = rocksdb_pinnable_slice_value(slice, &valueLen)
+    return try body(UnsafeRawBufferPointer(start: ptr, count: ptr == nil ? 0 : valueLen))
+  }
+
   /// Delete a key
   /// - Parameter key: Key data
   /// - Throws: RocksDBLiteError on failure
@@ -193,11 +269,8 @@ public final class RocksDBLite: @unchecked Sendable {
         throw RocksDBLiteError.databaseClosed
       }
 
-      let writeOpts = rocksdb_write_options_create()
-      defer { rocksdb_write_options_destroy(writeOpts) }
-
       let status = key.withUnsafeBytes { keyPtr in
-        rocksdb_delete(h, writeOpts,
+        rocksdb_delete(h, nil,
                        keyPtr.baseAddress?.assumingMemoryBound(to: CChar.self),
                        key.count)
       }
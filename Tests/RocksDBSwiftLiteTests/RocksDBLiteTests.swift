@@ -34,6 +34,13 @@ final class RocksDBLiteTests: XCTestCase {
     XCTAssertFalse(db.isOpen)
   }
 
+  func testOpenInMemory() throws {
+    let db = try RocksDBLite.openInMemory()
+    defer { db.close() }
+    try db.put("value", forKey: "key")
+    XCTAssertEqual(try db.getString("key"), "value")
+  }
+
   func testOpenReadOnly() throws {
     let dbPath = tempDirectory.appendingPathComponent("test.db").path
 
@@ -83,6 +90,18 @@ final class RocksDBLiteTests: XCTestCase {
     XCTAssertNil(result)
   }
 
+  func testWithValue() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDBLite.open(at: dbPath)
+    defer { db.close() }
+
+    let key = "bytes".data(using: .utf8)!
+    try db.put(Data([7, 8, 9]), forKey: key)
+
+    XCTAssertEqual(try db.withValue(forKey: key) { Array($0) }, [7, 8, 9])
+    XCTAssertNil(try db.withValue(forKey: "missing".data(using: .utf8)!) { $0.count })
+  }
+
   func testDelete() throws {
     let dbPath = tempDirectory.appendingPathComponent("test.db").path
     let db = try RocksDBLite.open(at: dbPath)
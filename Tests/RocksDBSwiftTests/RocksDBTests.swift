@@ -34,6 +34,19 @@ final class RocksDBTests: XCTestCase {
     XCTAssertFalse(db.isOpen)
   }
 
+  func testOpenInMemory() throws {
+    let db = try RocksDB.openInMemory()
+    try db.put("value", forKey: "key")
+    try db.flush()
+    XCTAssertEqual(try db.getString("key"), "value")
+    XCTAssertFalse(FileManager.default.fileExists(atPath: db.path))
+    db.close()
+
+    let fresh = try RocksDB.openInMemory()
+    defer { fresh.close() }
+    XCTAssertNil(try fresh.getString("key"))
+  }
+
   func testPutAndGet() throws {
     let dbPath = tempDirectory.appendingPathComponent("test.db").path
     let db = try RocksDB.open(at: dbPath)
@@ -48,279 +61,3781 @@ final class RocksDBTests: XCTestCase {
     XCTAssertEqual(retrieved, value)
   }
 
-  func testStringConvenience() throws {
+  func testStringConvenience() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    try db.put("hello", forKey: "greeting")
+    let result = try db.getString("greeting")
+
+    XCTAssertEqual(result, "hello")
+  }
+
+  func testStringPathsWithoutData() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.openWithTransactions(at: dbPath)
+    defer { db.close() }
+
+    // Native, bridged and empty strings all pass their UTF-8 bytes as is
+    let bridged = NSString(string: "bridged-ключ") as String
+    try db.put("значение 🔑", forKey: "ключ")
+    try db.put("bridged", forKey: bridged)
+    try db.put("", forKey: "empty")
+    XCTAssertEqual(try db.get(Data("ключ".utf8)), Data("значение 🔑".utf8))
+    XCTAssertEqual(try db.getString(bridged), "bridged")
+    XCTAssertEqual(try db.getString("empty"), "")
+    XCTAssertNil(try db.getString("missing"))
+
+    // Values that are not UTF-8 decode to nil rather than garbage
+    try db.put(Data([0xFF, 0xFE]), forKey: Data("binary".utf8))
+    XCTAssertNil(try db.getString("binary"))
+
+    let batch = RocksDBBatch()
+    batch.put("from-batch", forKey: "batch")
+    batch.delete("empty")
+    try db.writeBatch(batch)
+    XCTAssertEqual(try db.getString("batch"), "from-batch")
+    XCTAssertNil(try db.getString("empty"))
+
+    let txn = try db.beginTransaction()
+    try txn.put("from-txn", forKey: "txn")
+    XCTAssertEqual(try txn.getString("txn"), "from-txn")
+    try txn.delete("batch")
+    try txn.commit()
+    XCTAssertEqual(try db.getString("txn"), "from-txn")
+    XCTAssertNil(try db.getString("batch"))
+
+    let iterator = try db.makeIterator()
+    defer { iterator.close() }
+    iterator.seek(to: "txn")
+    XCTAssertEqual(iterator.keyString, "txn")
+    XCTAssertEqual(iterator.valueString, "from-txn")
+  }
+
+  func testGetLargeValue() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    let key = "large".data(using: .utf8)!
+    let value = Data((0..<(64 * 1024)).map { UInt8(truncatingIfNeeded: $0) })
+
+    try db.put(value, forKey: key)
+    try db.flush()
+
+    XCTAssertEqual(try db.get(key), value)
+  }
+
+  func testValueOutlivesClose() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+
+    try db.put("pinned-value", forKey: "pinned")
+    try db.flush()
+
+    let value = try db.get("pinned".data(using: .utf8)!)
+    db.close()
+
+    // Values are copied, so holding one does not keep the LOCK file
+    let reopened = try RocksDB.open(at: dbPath)
+    XCTAssertEqual(value.flatMap { String(data: $0, encoding: .utf8) }, "pinned-value")
+    defer { reopened.close() }
+    XCTAssertEqual(try reopened.getString("pinned"), "pinned-value")
+  }
+
+  func testGetNonExistent() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    let result = try db.get("nonexistent".data(using: .utf8)!)
+    XCTAssertNil(result)
+  }
+
+  func testWithValue() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    try db.put(Data([1, 2, 3, 4]), forKey: "bytes".data(using: .utf8)!)
+
+    let sum = try db.withValue(forKey: "bytes") { buffer in
+      buffer.reduce(0) { $0 + Int($1) }
+    }
+    XCTAssertEqual(sum, 10)
+
+    let missing = try db.withValue(forKey: "missing") { $0.count }
+    XCTAssertNil(missing)
+  }
+
+  func testMultiGet() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    try db.put("value-a", forKey: "a")
+    try db.put("value-c", forKey: "c")
+
+    let keys = ["a", "b", "c"].map { $0.data(using: .utf8)! }
+    let results = try db.multiGet(keys, sortedInput: true)
+
+    XCTAssertEqual(results.count, 3)
+    XCTAssertEqual(results[0], "value-a".data(using: .utf8)!)
+    XCTAssertNil(results[1])
+    XCTAssertEqual(results[2], "value-c".data(using: .utf8)!)
+    XCTAssertEqual(try db.multiGet([]), [])
+  }
+
+  func testDelete() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    let key = "to-delete".data(using: .utf8)!
+    let value = "some-value".data(using: .utf8)!
+
+    try db.put(value, forKey: key)
+    XCTAssertNotNil(try db.get(key))
+
+    try db.delete(key)
+    XCTAssertNil(try db.get(key))
+  }
+
+  func testKeyMayExist() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    let key = "exists".data(using: .utf8)!
+    try db.put("value".data(using: .utf8)!, forKey: key)
+
+    // Note: keyMayExist can have false positives but should return true for existing keys
+    XCTAssertTrue(db.keyMayExist(key))
+  }
+
+  func testKeyExistenceReturnsValue() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    let key = "exists".data(using: .utf8)!
+    let value = "value".data(using: .utf8)!
+    try db.put(value, forKey: key)
+
+    // Still in the memtable, so the value comes back with the check
+    XCTAssertEqual(try db.keyExistence(key).value, value)
+    XCTAssertEqual(try db.withKeyExistence(key) { $0.count }, .present(value.count))
+  }
+
+  func testRangeAggregation() throws {
+    let db = try RocksDB.open(at: tempDirectory.appendingPathComponent("test.db").path)
+    defer { db.close() }
+
+    for (i, amount) in [Int64(5), -3, 40, 12].enumerated() {
+      var value = Data([0xAB])
+      withUnsafeBytes(of: amount.bigEndian) { value.append(contentsOf: $0) }
+      try db.put(value, forKey: Data("tenant-a:\(i)".utf8))
+    }
+    try db.put(Data([0xAB]), forKey: Data("tenant-a:short".utf8))
+    try db.put(Data(repeating: 0, count: 9), forKey: Data("tenant-b:0".utf8))
+
+    let field = try RocksDBAggregateField.integer(Int64.self, at: 1, byteOrder: .bigEndian)
+    let tenant = try db.aggregate(in: .prefix(Data("tenant-a:".utf8)), field: field)
+    XCTAssertEqual(tenant.count, 5)
+    XCTAssertEqual(tenant.valueBytes, 4 * 9 + 1)
+    XCTAssertEqual(tenant.fieldCount, 4)
+    XCTAssertEqual(tenant.signedSum, 54)
+    XCTAssertEqual(tenant.signedMin, -3)
+    XCTAssertEqual(tenant.signedMax, 40)
+
+    let all = try db.aggregate()
+    XCTAssertEqual(all.count, 6)
+    XCTAssertNil(all.min)
+    XCTAssertThrowsError(try db.aggregate(field: RocksDBAggregateField(offset: 0, width: 3)))
+    XCTAssertThrowsError(try RocksDBAggregateField(offset: -1, width: 4))
+    XCTAssertThrowsError(try RocksDBAggregateField.integer(UInt16.self, at: -8))
+  }
+
+  func testFilteredScan() throws {
+    let db = try RocksDB.open(at: tempDirectory.appendingPathComponent("test.db").path)
+    defer { db.close() }
+
+    // Value: [type byte][big-endian UInt32 timestamp]
+    for i in 0..<100 {
+      var value = Data([UInt8(i % 4)])
+      withUnsafeBytes(of: UInt32(i * 10).bigEndian) { value.append(contentsOf: $0) }
+      let region = i % 3 == 0 ? "eu" : i % 3 == 1 ? "us" : "ap"
+      try db.put(value, forKey: Data("event-\(String(format: "%03d", i))-\(region)".utf8))
+    }
+
+    let predicate: RocksDBScanPredicate = try .and([
+      .bytes(.value, .equal, Data([2])),
+      .integer(.value, .integer(UInt32.self, at: 1, byteOrder: .bigEndian), .less, 500),
+      .or([.keySuffix(in: [Data("eu".utf8), Data("us".utf8)]), .not(.keyPrefix(in: [Data("event-".utf8)]))]),
+    ])
+
+    var matched: [Data] = []
+    try db.forEach(in: .all, where: predicate) { key, _ in
+      matched.append(key)
+      return true
+    }
+    let expected = (0..<50).filter { $0 % 4 == 2 && $0 % 3 != 2 }
+      .map { Data("event-\(String(format: "%03d", $0))-\($0 % 3 == 0 ? "eu" : "us")".utf8) }
+    XCTAssertEqual(matched, expected)
+
+    XCTAssertThrowsError(try RocksDBScanFilter(.integer(.value, RocksDBAggregateField(offset: 0, width: 3), .equal, 0)))
+    XCTAssertThrowsError(try RocksDBScanFilter(.bytes(.key, at: -1, .equal, Data())))
+  }
+
+  func testKeysMayExist() throws {
+    // Default table options build 10-bit bloom filters
+    var options = RocksDBOptions()
+    options.enableStatistics = true
+    let db = try RocksDB.open(at: tempDirectory.appendingPathComponent("test.db").path, options: options)
+    defer { db.close() }
+
+    for i in stride(from: 0, to: 200, by: 2) {
+      try db.put(Data("value".utf8), forKey: Data("key-\(i)".utf8))
+    }
+    try db.flush()
+    try db.put(Data("value".utf8), forKey: Data("key-memtable".utf8))
+
+    let keys = (0..<200).map { Data("key-\($0)".utf8) } + [Data("key-memtable".utf8)]
+    let mayExist = try db.keysMayExist(keys)
+    XCTAssertTrue(stride(from: 0, to: 200, by: 2).allSatisfy { mayExist[$0] })
+    XCTAssertTrue(mayExist[200])
+
+    // The filter rules out nearly all absent keys (about 1% false positives)
+    let ruledOut = stride(from: 1, to: 200, by: 2).filter { !mayExist[$0] }.count
+    XCTAssertGreaterThanOrEqual(ruledOut, 90)
+    XCTAssertGreaterThanOrEqual(db.tickerCount(.bloomFilterUseful), UInt64(ruledOut))
+
+    let exact = try db.keysMayExist(keys, verify: true)
+    XCTAssertEqual(exact, (0..<200).map { $0 % 2 == 0 } + [true])
+  }
+
+  func testCacheOnlyReads() throws {
+    let db = try RocksDB.open(at: tempDirectory.appendingPathComponent("test.db").path)
+    defer { db.close() }
+
+    try db.put(Data("on-disk".utf8), forKey: Data("flushed".utf8))
+    try db.flush()
+    try db.put(Data("in-memory".utf8), forKey: Data("fresh".utf8))
+
+    var memtableOnly = RocksDBReadOptions()
+    memtableOnly.readTier = .memtable
+    XCTAssertEqual(try db.get(Data("fresh".utf8), options: memtableOnly), Data("in-memory".utf8))
+    XCTAssertThrowsError(try db.get(Data("flushed".utf8), options: memtableOnly)) { error in
+      guard case RocksDBError.incomplete = error else {
+        return XCTFail("Expected incomplete, got \(error)")
+      }
+    }
+
+    // Flushing does not populate the block cache, so the SST read is deferred
+    let keys = [Data("fresh".utf8), Data("flushed".utf8)]
+    let cold = try db.multiGetCached(keys)
+    XCTAssertEqual(cold[0], .present(Data("in-memory".utf8)))
+    XCTAssertEqual(cold[1], .maybePresent)
+
+    XCTAssertEqual(try db.get(Data("flushed".utf8)), Data("on-disk".utf8))
+    let warm = try db.multiGetCached(keys)
+    XCTAssertEqual(warm[1], .present(Data("on-disk".utf8)))
+  }
+
+  func testReadDeadlineAndValueSizeLimit() throws {
+    let db = try RocksDB.open(at: tempDirectory.appendingPathComponent("test.db").path)
+    defer { db.close() }
+
+    try db.put("on-disk", forKey: "flushed")
+    try db.flush()
+    try db.put("in-memory", forKey: "fresh")
+
+    // An expired deadline fails the first file read, not memtable hits
+    var expired = RocksDBReadOptions()
+    expired.deadline = Date(timeIntervalSinceNow: -1)
+    XCTAssertEqual(try db.getString("fresh", options: expired), "in-memory")
+    XCTAssertThrowsError(try db.getString("flushed", options: expired)) { error in
+      guard case RocksDBError.timedOut(.none) = error else {
+        return XCTFail("Expected timedOut, got \(error)")
+      }
+      XCTAssertFalse(RocksDBRetryPolicy.isRetryable(error))
+    }
+
+    var generous = RocksDBReadOptions()
+    generous.deadline = Date(timeIntervalSinceNow: 60)
+    generous.ioTimeout = 10
+    XCTAssertEqual(try db.getString("flushed", options: generous), "on-disk")
+
+    let keys = (0..<4).map { Data("big-\($0)".utf8) }
+    for key in keys {
+      try db.put(Data(repeating: 1, count: 1000), forKey: key)
+    }
+    var limited = RocksDBReadOptions()
+    limited.valueSizeSoftLimit = 1500
+    XCTAssertThrowsError(try db.multiGet(keys, options: limited)) { error in
+      guard case RocksDBError.aborted = error else {
+        return XCTFail("Expected aborted, got \(error)")
+      }
+    }
+    limited.valueSizeSoftLimit = 4000
+    XCTAssertEqual(try db.multiGet(keys, options: limited).compactMap { $0 }.count, 4)
+  }
+
+  func testRateLimitedReads() throws {
+    let limiter = RocksDBRateLimiter(bytesPerSecond: 64 * 1024 * 1024, mode: .readsOnly)
+    var options = RocksDBOptions.default
+    options.rateLimiter = limiter
+    let db = try RocksDB.open(at: tempDirectory.appendingPathComponent("test.db").path, options: options)
+    defer { db.close() }
+
+    for i in 0..<500 {
+      try db.put(Data(repeating: UInt8(i % 256), count: 256), forKey: Data(String(format: "row-%04d", i).utf8))
+    }
+    try db.flush()
+
+    // Uncharged reads leave the limiter alone
+    var uncharged = RocksDBReadOptions()
+    uncharged.fillCache = false
+    let before = limiter.totalBytesThrough
+    var count = 0
+    try db.forEach(in: .all, options: uncharged) { _, _ in
+      count += 1
+      return true
+    }
+    XCTAssertEqual(count, 500)
+    XCTAssertEqual(limiter.totalBytesThrough, before)
+
+    var lowPriority = uncharged
+    lowPriority.rateLimiterPriority = .low
+    count = 0
+    try db.forEach(in: .all, options: lowPriority) { _, _ in
+      count += 1
+      return true
+    }
+    XCTAssertEqual(count, 500)
+    XCTAssertGreaterThan(limiter.totalBytesThrough, before)
+  }
+
+  // MARK: - Concurrency
+
+  func testConcurrentReadsAndWrites() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    let threads = 8
+    let perThread = 500
+
+    DispatchQueue.concurrentPerform(iterations: threads) { t in
+      for i in 0..<perThread {
+        let key = "t\(t)-k\(i)"
+        XCTAssertNoThrow(try db.put("v\(i)", forKey: key))
+        XCTAssertEqual(try? db.getString(key), "v\(i)")
+      }
+    }
+
+    XCTAssertEqual(try db.getString("t\(threads - 1)-k\(perThread - 1)"), "v\(perThread - 1)")
+  }
+
+  func testCloseWaitsForInFlightOperations() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    try db.put("value", forKey: "key")
+
+    DispatchQueue.concurrentPerform(iterations: 4) { t in
+      if t == 0 {
+        db.close()
+        return
+      }
+      for _ in 0..<1000 {
+        do {
+          XCTAssertEqual(try db.getString("key"), "value")
+        } catch RocksDBError.databaseClosed {
+          return
+        } catch {
+          XCTFail("Unexpected error: \(error)")
+          return
+        }
+      }
+    }
+
+    XCTAssertFalse(db.isOpen)
+  }
+
+  func testConcurrentReadThroughput() throws {
+    let dbPath = tempDirectory.appendingPathComponent("perf.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    let count = 1000
+    try db.batch { batch in
+      for i in 0..<count {
+        batch.put("value-\(i)", forKey: "key-\(i)")
+      }
+    }
+
+    let keys = (0..<count).map { "key-\($0)".data(using: .utf8)! }
+    let threads = ProcessInfo.processInfo.activeProcessorCount
+
+    // Throughput should scale with threads now that reads share the lock
+    measure {
+      DispatchQueue.concurrentPerform(iterations: threads) { _ in
+        for key in keys {
+          _ = try? db.get(key)
+        }
+      }
+    }
+  }
+
+  // MARK: - Batch Operations
+
+  func testTypedKeys() throws {
+    XCTAssertEqual(UInt32(0x0102_0304).encodedKey, Data([1, 2, 3, 4]))
+    XCTAssertEqual(Int16(-1).encodedKey, Data([0x7F, 0xFF]))
+    XCTAssertTrue(Int64(-5).encodedKey.lexicographicallyPrecedes(Int64(3).encodedKey))
+
+    let db = try RocksDB.open(at: tempDirectory.appendingPathComponent("test.db").path)
+    defer { db.close() }
+
+    let tenant = UUID()
+    for id in [UInt64(300), 2, 10] {
+      try db.put(Data("event-\(id)".utf8), forKey: RocksDBCompositeKey(tenant, id))
+    }
+    XCTAssertEqual(try db.get(RocksDBCompositeKey(tenant, UInt64(10))), Data("event-10".utf8))
+    XCTAssertEqual(RocksDBCompositeKey(tenant, UInt64(10)).encodedKeyLength, 24)
+
+    let iter = try db.makeIterator()
+    defer { iter.close() }
+    iter.seek(to: RocksDBCompositeKey(tenant, UInt64(3)))
+    XCTAssertEqual(iter.key, RocksDBCompositeKey(tenant, UInt64(10)).encodedKey)
+
+    try db.batch { batch in
+      batch.delete(RocksDBCompositeKey(tenant, UInt64(2)))
+      batch.put(Data("answer".utf8), forKey: Int32(42))
+    }
+    XCTAssertNil(try db.get(RocksDBCompositeKey(tenant, UInt64(2))))
+    XCTAssertEqual(try db.get(Int32(42)), Data("answer".utf8))
+
+    try db.delete(Int32(42))
+    XCTAssertNil(try db.get(Int32(42)))
+  }
+
+  func testBatch() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    try db.batch { batch in
+      batch.put("value1", forKey: "key1")
+      batch.put("value2", forKey: "key2")
+      batch.put("value3", forKey: "key3")
+    }
+
+    XCTAssertEqual(try db.getString("key1"), "value1")
+    XCTAssertEqual(try db.getString("key2"), "value2")
+    XCTAssertEqual(try db.getString("key3"), "value3")
+  }
+
+  func testBatchBuilder() throws {
+    let db = try RocksDB.open(at: tempDirectory.appendingPathComponent("test.db").path)
+    defer { db.close() }
+    try db.put(Data("old".utf8), forKey: Data("gone".utf8))
+
+    var builder = RocksDBBatchBuilder(reservedBytes: 64 * 1024)
+    for i in 0..<1000 {
+      builder.put(Data("value-\(i)".utf8), forKey: UInt32(i))
+    }
+    builder.delete(Data("gone".utf8))
+    XCTAssertEqual(builder.count, 1001)
+    try db.writeBatch(builder)
+
+    XCTAssertEqual(try db.get(UInt32(999)), Data("value-999".utf8))
+    XCTAssertNil(try db.get(Data("gone".utf8)))
+
+    var tooLarge = RocksDBBatchBuilder(maxBytes: 64)
+    tooLarge.put(Data(count: 128), forKey: UInt32(0))
+    XCTAssertThrowsError(try db.writeBatch(tooLarge))
+  }
+
+  func testBatchWithDelete() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    // First add some data
+    try db.put("initial", forKey: "delete-me")
+
+    // Batch with both put and delete
+    try db.batch { batch in
+      batch.put("new-value", forKey: "new-key")
+      batch.delete("delete-me")
+    }
+
+    XCTAssertEqual(try db.getString("new-key"), "new-value")
+    XCTAssertNil(try db.getString("delete-me"))
+  }
+
+  func testBatchBulkAppend() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    let entries = (0..<100).map { i in
+      (key: Data("key\(i)".utf8), value: Data("value\(i)".utf8))
+    }
+
+    let batch = RocksDBBatch()
+    batch.put(contentsOf: entries)
+    try batch.put(packed: Data("pkpv".utf8), offsets: [0, 2, 4])
+    XCTAssertThrowsError(try batch.put(packed: Data("pkpv".utf8), offsets: [0, 3, 2]))
+    XCTAssertThrowsError(try batch.put(packed: Data("pkpv".utf8), offsets: [0, 2, 5]))
+    XCTAssertThrowsError(try batch.put(packed: Data("pkpv".utf8), offsets: [0, 2]))
+    batch.put(parts: [Data("v".utf8), Data("1".utf8)], forKeyParts: [Data("user:".utf8), Data("42".utf8)])
+    batch.delete(contentsOf: [Data("key0".utf8), Data("key1".utf8)])
+    XCTAssertEqual(batch.count, 104)
+    try db.writeBatch(batch)
+
+    XCTAssertNil(try db.getString("key0"))
+    XCTAssertEqual(try db.getString("key99"), "value99")
+    XCTAssertEqual(try db.getString("pk"), "pv")
+    XCTAssertEqual(try db.getString("user:42"), "v1")
+  }
+
+  func testBatchMaxBytes() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    let batch = RocksDBBatch(reservedBytes: 256, maxBytes: 512)
+    batch.put("small", forKey: "a")
+    XCTAssertNoThrow(try batch.validate())
+
+    batch.put(String(repeating: "x", count: 1024), forKey: "b")
+    XCTAssertThrowsError(try batch.validate())
+    XCTAssertThrowsError(try db.writeBatch(batch))
+    XCTAssertNil(try db.getString("a"))
+
+    batch.clear()
+    batch.put("again", forKey: "a")
+    try db.writeBatch(batch)
+    XCTAssertEqual(try db.getString("a"), "again")
+  }
+
+  func testBatchPoolReusesBatches() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    var first: RocksDBBatch?
+    try db.batch { batch in
+      first = batch
+      batch.put("value1", forKey: "key1")
+    }
+    try db.batch { batch in
+      XCTAssertTrue(batch === first)
+      XCTAssertTrue(batch.isEmpty)
+      batch.put("value2", forKey: "key2")
+    }
+
+    XCTAssertEqual(db.batchPool.count, 1)
+    XCTAssertEqual(try db.getString("key1"), "value1")
+    XCTAssertEqual(try db.getString("key2"), "value2")
+  }
+
+  func testWriteCoalescerGroupsConcurrentWrites() async throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    let coalescer = RocksDBWriteCoalescer(database: db, maxLatency: 0.005)
+    try await withThrowingTaskGroup(of: Void.self) { group in
+      for i in 0..<500 {
+        group.addTask {
+          try await coalescer.put("value\(i)", forKey: "key\(i)")
+        }
+      }
+      try await group.waitForAll()
+    }
+
+    XCTAssertEqual(coalescer.writesCompleted, 500)
+    XCTAssertLessThan(coalescer.groupsWritten, 500)
+    XCTAssertEqual(try db.getString("key0"), "value0")
+    XCTAssertEqual(try db.getString("key499"), "value499")
+  }
+
+  func testWriteCoalescerIgnoresStaleDeadline() async throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    let coalescer = RocksDBWriteCoalescer(database: db, maxLatency: 1.0)
+    // The first group is flushed by hand long before its deadline...
+    let first = Task { try await coalescer.put("value1", forKey: "key1") }
+    try await Task.sleep(nanoseconds: 50_000_000)
+    coalescer.flush()
+    try await first.value
+    XCTAssertEqual(coalescer.groupsWritten, 1)
+
+    // ...so that deadline must not flush the second group early
+    try await Task.sleep(nanoseconds: 450_000_000)
+    let second = Task { try await coalescer.put("value2", forKey: "key2") }
+    try await Task.sleep(nanoseconds: 700_000_000)
+    XCTAssertEqual(coalescer.groupsWritten, 1)
+    XCTAssertNil(try db.getString("key2"))
+
+    try await second.value
+    XCTAssertEqual(coalescer.groupsWritten, 2)
+    XCTAssertEqual(try db.getString("key2"), "value2")
+  }
+
+  func testAsyncOperations() async throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    let keys = (0..<50).map { "key\($0)".data(using: .utf8)! }
+    try await withThrowingTaskGroup(of: Void.self) { group in
+      for key in keys {
+        group.addTask {
+          try await db.putAsync(key, forKey: key)
+        }
+      }
+      try await group.waitForAll()
+    }
+
+    let batch = RocksDBBatch()
+    batch.put("batched".data(using: .utf8)!, forKey: "key0".data(using: .utf8)!)
+    try await db.writeBatchAsync(batch)
+    try await db.flushAsync()
+    try await db.compactRangeAsync()
+
+    let first = try await db.getAsync(keys[0])
+    XCTAssertEqual(first, "batched".data(using: .utf8))
+    // The blocking calls stay usable from async code
+    XCTAssertEqual(try db.get(keys[1]), keys[1])
+    let values = try await db.multiGetAsync(keys + ["missing".data(using: .utf8)!])
+    XCTAssertEqual(values.compactMap { $0 }.count, 50)
+    XCTAssertGreaterThan(RocksDBIOPool.threadCount, 0)
+  }
+
+  func testPrefetchingScan() async throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    for i in 0..<500 {
+      try db.put("value-\(i)", forKey: String(format: "key-%03d", i))
+    }
+
+    // Small batches and buffer force many refills
+    var keys: [String] = []
+    for try await entry in try db.prefetchingScan(batchSize: 16, bufferedBatches: 2) {
+      keys.append(String(data: entry.key, encoding: .utf8)!)
+    }
+    XCTAssertEqual(keys.count, 500)
+    XCTAssertEqual(keys, keys.sorted())
+
+    let range = RocksDBKeyRange(start: "key-100".data(using: .utf8), end: "key-200".data(using: .utf8))
+    var count = 0
+    for try await _ in try db.prefetchingScan(range, batchSize: 7) {
+      count += 1
+    }
+    XCTAssertEqual(count, 100)
+
+    // Stopping early leaves the read-ahead bounded
+    let iter = try db.makeIterator()
+    var seen = 0
+    for try await _ in iter.prefetching(batchSize: 8, bufferedBatches: 1) {
+      seen += 1
+      if seen == 10 { break }
+    }
+    XCTAssertEqual(seen, 10)
+  }
+
+  func testPrefetchingScanStopsWithDatabase() async throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+
+    for i in 0..<500 {
+      try db.put("value-\(i)", forKey: String(format: "key-%03d", i))
+    }
+
+    // Reads after close fail instead of touching the freed iterator
+    var iterator = try db.prefetchingScan(batchSize: 16, bufferedBatches: 1).makeAsyncIterator()
+    XCTAssertNotNil(try await iterator.next())
+    db.close()
+    var read = 1
+    do {
+      while try await iterator.next() != nil {
+        read += 1
+      }
+      XCTFail("Expected databaseClosed")
+    } catch RocksDBError.databaseClosed {
+      XCTAssertLessThan(read, 500)
+    }
+
+    // A cancelled consumer stops the read-ahead
+    let reopened = try RocksDB.open(at: dbPath)
+    defer { reopened.close() }
+    let sequence = try reopened.prefetchingScan(batchSize: 16, bufferedBatches: 1)
+    let consumer = Task {
+      var count = 0
+      for try await _ in sequence {
+        count += 1
+        if count == 20 {
+          withUnsafeCurrentTask { $0?.cancel() }
+        }
+      }
+      return count
+    }
+    do {
+      _ = try await consumer.value
+      XCTFail("Expected cancellation")
+    } catch is CancellationError {
+    }
+  }
+
+  // MARK: - Merge Tests
+
+  func testUInt64AddMerge() throws {
+    var options = RocksDBOptions()
+    options.mergeOperator = .uint64Add
+
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath, options: options)
+    defer { db.close() }
+
+    let key = "counter".data(using: .utf8)!
+    try db.increment(key)
+    try db.increment(key, by: 41)
+    try db.batch { batch in
+      batch.increment(key, by: 8)
+    }
+
+    XCTAssertEqual(try db.getUInt64(key), 50)
+    XCTAssertNil(try db.getUInt64("missing".data(using: .utf8)!))
+  }
+
+  func testStringAppendAndMaxMerge() throws {
+    var options = RocksDBOptions()
+    options.mergeOperator = .stringAppend(delimiter: ",")
+
+    let appendDB = try RocksDB.open(at: tempDirectory.appendingPathComponent("append").path, options: options)
+    defer { appendDB.close() }
+
+    try appendDB.merge("a", forKey: "list")
+    try appendDB.merge("b", forKey: "list")
+    try appendDB.merge("c", forKey: "list")
+    XCTAssertEqual(try appendDB.getString("list"), "a,b,c")
+
+    options.mergeOperator = .max
+    let maxDB = try RocksDB.open(at: tempDirectory.appendingPathComponent("max").path, options: options)
+    defer { maxDB.close() }
+
+    try maxDB.merge("m", forKey: "high")
+    try maxDB.merge("z", forKey: "high")
+    try maxDB.merge("q", forKey: "high")
+    XCTAssertEqual(try maxDB.getString("high"), "z")
+  }
+
+  func testTransactionMerge() throws {
+    var options = RocksDBOptions()
+    options.mergeOperator = .uint64Add
+
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.openWithTransactions(at: dbPath, options: options)
+    defer { db.close() }
+
+    let key = "txn-counter".data(using: .utf8)!
+    try db.transaction { txn in
+      try txn.increment(key, by: 3)
+      try txn.increment(key, by: 4)
+    }
+
+    XCTAssertEqual(try db.getUInt64(key), 7)
+  }
+
+  // MARK: - Iterator Tests
+
+  func testIterator() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    // Insert sorted data
+    try db.put("a-value", forKey: "a")
+    try db.put("b-value", forKey: "b")
+    try db.put("c-value", forKey: "c")
+
+    let iter = try db.makeIterator()
+    defer { iter.close() }
+
+    var keys: [String] = []
+    iter.seekToFirst()
+    while iter.isValid {
+      if let key = iter.keyString {
+        keys.append(key)
+      }
+      iter.next()
+    }
+    try iter.checkStatus()
+
+    XCTAssertEqual(keys, ["a", "b", "c"])
+  }
+
+  func testPinnedIteratorKeys() throws {
+    var tableOptions = RocksDBTableOptions()
+    tableOptions.useDeltaEncoding = false
+    var options = RocksDBOptions()
+    options.tableOptions = tableOptions
+    let db = try RocksDB.open(at: tempDirectory.appendingPathComponent("test.db").path, options: options)
+    defer { db.close() }
+
+    for i in 0..<100 {
+      try db.put("value", forKey: String(format: "key-%03d", i))
+    }
+    try db.flush()
+
+    var readOptions = RocksDBReadOptions()
+    readOptions.pinData = true
+    readOptions.backgroundPurgeOnIteratorCleanup = true
+    let iter = try db.makeIterator(options: readOptions)
+    defer { iter.close() }
+
+    // Views collected across next() still hold their keys at the end of the scan
+    iter.seekToFirst()
+    let keys: [String] = try iter.withCursor { cursor in
+      var views: [UnsafeRawBufferPointer] = []
+      while cursor.next() {
+        XCTAssertTrue(cursor.isKeyPinned)
+        views.append(cursor.key)
+      }
+      return views.map { String(decoding: $0, as: UTF8.self) }
+    }
+    XCTAssertEqual(keys.count, 100)
+    XCTAssertEqual(keys.first, "key-000")
+    XCTAssertEqual(keys.last, "key-099")
+  }
+
+  func testTailingIteratorAndRefresh() throws {
+    let db = try RocksDB.open(at: tempDirectory.appendingPathComponent("test.db").path)
+    defer { db.close() }
+
+    try db.put("first", forKey: "log-1")
+
+    var tailingOptions = RocksDBReadOptions()
+    tailingOptions.tailing = true
+    let tail = try db.makeIterator(options: tailingOptions)
+    defer { tail.close() }
+    tail.seekToFirst()
+    XCTAssertEqual(tail.keyString, "log-1")
+    tail.next()
+    XCTAssertFalse(tail.isValid)
+
+    // Seeking past the last key read picks up entries written since, even flushed ones
+    try db.put("second", forKey: "log-2")
+    try db.flush()
+    try db.put("third", forKey: "log-3")
+    tail.seek(to: "log-1")
+    tail.next()
+    XCTAssertEqual(tail.keyString, "log-2")
+    tail.next()
+    XCTAssertEqual(tail.keyString, "log-3")
+    try tail.checkStatus()
+
+    // A regular iterator keeps its view until refreshed
+    let iter = try db.makeIterator()
+    defer { iter.close() }
+    try db.put("fourth", forKey: "log-4")
+    iter.seek(to: "log-4")
+    XCTAssertFalse(iter.isValid)
+    try iter.refresh()
+    iter.seek(to: "log-4")
+    XCTAssertEqual(iter.valueString, "fourth")
+  }
+
+  func testIteratorCursor() throws {
+    let db = try RocksDB.open(at: tempDirectory.appendingPathComponent("test.db").path)
+    defer { db.close() }
+    for i in 0..<100 {
+      try db.put(Data([UInt8(i % 10)]), forKey: UInt32(i))
+    }
+
+    let iter = try db.makeIterator()
+    defer { iter.close() }
+    iter.seekToFirst()
+    let matches = try iter.withCursor { cursor -> [Data] in
+      var matches: [Data] = []
+      while cursor.next() {
+        guard cursor.withValue({ $0.first == 7 }) else { continue }
+        matches.append(Data(cursor.key))
+      }
+      return matches
+    }
+    XCTAssertEqual(matches.count, 10)
+    XCTAssertEqual(matches.first, UInt32(7).encodedKey)
+
+    let last = try iter.withCursor { cursor -> Data? in
+      cursor.seek(to: UInt32(98).encodedKey)
+      guard cursor.next(), cursor.next() else { return nil }
+      return Data(cursor.key)
+    }
+    XCTAssertEqual(last, UInt32(99).encodedKey)
+  }
+
+  func testIteratorSequence() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    try db.put("1", forKey: "key1")
+    try db.put("2", forKey: "key2")
+    try db.put("3", forKey: "key3")
+
+    let iter = try db.makeIterator()
+    defer { iter.close() }
+
+    var count = 0
+    for _ in iter {
+      count += 1
+    }
+
+    XCTAssertEqual(count, 3)
+  }
+
+  func testIteratorNextBatch() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    for i in 0..<10 {
+      try db.put("value-\(i)", forKey: "key-\(i)")
+    }
+    let large = Data(repeating: 0xAB, count: 4096)
+    try db.put(large, forKey: "key-9-large".data(using: .utf8)!)
+
+    let iter = try db.makeIterator()
+    defer { iter.close() }
+
+    iter.seekToFirst()
+    let first = iter.nextBatch(maxEntries: 4)
+    XCTAssertEqual(first.map { String(decoding: $0.key, as: UTF8.self) },
+                   ["key-0", "key-1", "key-2", "key-3"])
+    XCTAssertEqual(first.first.map { String(decoding: $0.value, as: UTF8.self) }, "value-0")
+
+    // A tiny budget still makes progress one (possibly oversized) entry at a time
+    var rest: [(key: Data, value: Data)] = []
+    while true {
+      let batch = iter.nextBatch(maxEntries: 100, byteBudget: 16)
+      if batch.isEmpty { break }
+      rest.append(contentsOf: batch)
+    }
+    XCTAssertEqual(rest.count, 7)
+    XCTAssertEqual(rest.last?.value, large)
+    try iter.checkStatus()
+  }
+
+  func testForEach() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    try db.put("1", forKey: "a")
+    try db.put("2", forKey: "b")
+    try db.put("3", forKey: "c")
+
+    var count = 0
+    try db.forEach { _, _ in
+      count += 1
+      return true
+    }
+
+    XCTAssertEqual(count, 3)
+  }
+
+  func testForEachWithPrefix() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    try db.put("val1", forKey: "prefix:1")
+    try db.put("val2", forKey: "prefix:2")
+    try db.put("val3", forKey: "other:1")
+
+    var prefixedKeys: [String] = []
+    let prefix = "prefix:".data(using: .utf8)!
+
+    try db.forEachWithPrefix(prefix) { key, _ in
+      if let keyStr = String(data: key, encoding: .utf8) {
+        prefixedKeys.append(keyStr)
+      }
+      return true
+    }
+
+    XCTAssertEqual(prefixedKeys.count, 2)
+    XCTAssertTrue(prefixedKeys.allSatisfy { $0.hasPrefix("prefix:") })
+  }
+
+  func testForEachWithPrefixStopsAtBound() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    try db.put("a", forKey: "prefix:1")
+    try db.put("b", forKey: "prefix:2")
+    try db.put("c", forKey: "prefiy")
+    try db.put("d", forKey: "prefix;")
+
+    var keys: [String] = []
+    try db.forEachWithPrefix("prefix:".data(using: .utf8)!) { key, _ in
+      keys.append(String(decoding: key, as: UTF8.self))
+      return true
+    }
+
+    XCTAssertEqual(keys, ["prefix:1", "prefix:2"])
+  }
+
+  func testForEachInRange() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    for key in ["a", "b", "c", "d", "e"] {
+      try db.put("v", forKey: key)
+    }
+
+    let range = RocksDBKeyRange(start: "b".data(using: .utf8)!, end: "d".data(using: .utf8)!)
+    var keys: [String] = []
+    try db.forEach(in: range) { key, _ in
+      keys.append(String(decoding: key, as: UTF8.self))
+      return true
+    }
+
+    XCTAssertEqual(keys, ["b", "c"])
+    XCTAssertTrue(range.contains("c".data(using: .utf8)!))
+    XCTAssertFalse(range.contains("d".data(using: .utf8)!))
+    XCTAssertNil(RocksDBKeyRange.prefix(Data([0xFF, 0xFF])).end)
+    XCTAssertEqual(RocksDBKeyRange.prefix(Data([0x01, 0xFF])).end, Data([0x02]))
+  }
+
+  func testIteratorUpperBound() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    for key in ["a", "b", "c"] {
+      try db.put("v", forKey: key)
+    }
+
+    var options = RocksDBReadOptions()
+    options.iterateUpperBound = "c".data(using: .utf8)!
+
+    let iter = try db.makeIterator(options: options)
+    defer { iter.close() }
+
+    var count = 0
+    for _ in iter {
+      count += 1
+    }
+    XCTAssertEqual(count, 2)
+  }
+
+  func testIteratorOutlivesReadOptions() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    for key in ["a", "b", "c", "d"] {
+      try db.put("v", forKey: key)
+    }
+
+    // The options and their native handle are released before iterating
+    let iter: RocksDBIterator = try {
+      var options = RocksDBReadOptions()
+      options.iterateLowerBound = Data("b".utf8)
+      options.iterateUpperBound = Data("d".utf8)
+      return try db.makeIterator(options: options)
+    }()
+    defer { iter.close() }
+
+    var keys: [String] = []
+    iter.seekToFirst()
+    while iter.isValid {
+      keys.append(iter.keyString ?? "")
+      iter.next()
+    }
+    XCTAssertEqual(keys, ["b", "c"])
+  }
+
+  // MARK: - External File Tests
+
+  func testSstFileWriterAndIngest() throws {
+    let sstPath = tempDirectory.appendingPathComponent("bulk.sst").path
+    let writer = try RocksDBSstFileWriter.open(at: sstPath)
+    for i in 0..<100 {
+      try writer.put("value-\(i)", forKey: String(format: "key-%03d", i))
+    }
+    XCTAssertThrowsError(try writer.put("late", forKey: "key-000"))
+    let info = try writer.finish()
+    XCTAssertEqual(info.numEntries, 100)
+    XCTAssertGreaterThan(info.fileSize, 0)
+
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    var ingestOptions = RocksDBIngestOptions()
+    ingestOptions.moveFiles = true
+    try db.ingestExternalFiles([sstPath], options: ingestOptions)
+
+    XCTAssertEqual(try db.getString("key-042"), "value-42")
+    XCTAssertEqual(try db.getString("key-099"), "value-99")
+  }
+
+  func testExportRangeAndIngest() throws {
+    let source = try RocksDB.open(at: tempDirectory.appendingPathComponent("source.db").path)
+    defer { source.close() }
+    let payload = Data(repeating: 0x5A, count: 512)
+    for i in 0..<2000 {
+      try source.put(payload, forKey: Data(String(format: "key-%05d", i).utf8))
+    }
+    try source.flush()
+    try source.put(Data("fresh".utf8), forKey: Data("key-01000".utf8))
+    try source.delete(Data("key-01001".utf8))
+
+    let exportDir = tempDirectory.appendingPathComponent("export").path
+    let range = RocksDBKeyRange(start: Data("key-00500".utf8), end: Data("key-01500".utf8))
+    let files = try source.exportRange(range, to: exportDir, targetFileSize: 128 * 1024)
+    XCTAssertGreaterThan(files.count, 1)
+    XCTAssertEqual(files, files.sorted())
+
+    let target = try RocksDB.open(at: tempDirectory.appendingPathComponent("target.db").path)
+    defer { target.close() }
+    try target.ingestExternalFiles(files)
+
+    XCTAssertEqual(try target.aggregate().count, 999)
+    XCTAssertNil(try target.get(Data("key-00499".utf8)))
+    XCTAssertEqual(try target.get(Data("key-00500".utf8)), payload)
+    XCTAssertEqual(try target.getString("key-01000"), "fresh")
+    XCTAssertNil(try target.get(Data("key-01001".utf8)))
+    XCTAssertNil(try target.get(Data("key-01500".utf8)))
+
+    let empty = RocksDBKeyRange(start: Data("zzz".utf8), end: nil)
+    XCTAssertEqual(try source.exportRange(empty, to: exportDir), [])
+  }
+
+  func testBulkLoaderParallelPartitions() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    let partitions: [[(key: Data, value: Data)]] = (0..<4).map { p in
+      (0..<250).map { i in
+        (key: Data(String(format: "p%d-%04d", p, i).utf8), value: Data("v\(p)-\(i)".utf8))
+      }
+    } + [[]]
+
+    var reports: [RocksDBBulkLoadProgress] = []
+    let loader = RocksDBBulkLoader(database: db, maxConcurrency: 4)
+    let result = try loader.load(partitions) { reports.append($0) }
+
+    XCTAssertEqual(result.files.count, 4)
+    XCTAssertEqual(result.entriesWritten, 1000)
+    XCTAssertEqual(reports.count, 5)
+    XCTAssertEqual(reports.last?.partitionsCompleted, 5)
+    XCTAssertEqual(try db.getString("p0-0000"), "v0-0")
+    XCTAssertEqual(try db.getString("p3-0249"), "v3-249")
+  }
+
+  // MARK: - Transaction Tests
+
+  func testTransaction() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.openWithTransactions(at: dbPath)
+    defer { db.close() }
+
+    XCTAssertTrue(db.isTransactional)
+
+    let result = try db.transaction { txn in
+      try txn.put("txn-value", forKey: "txn-key")
+      return try txn.getString("txn-key")
+    }
+
+    XCTAssertEqual(result, "txn-value")
+
+    // Verify committed
+    XCTAssertEqual(try db.getString("txn-key"), "txn-value")
+  }
+
+  func testTransactionWithValue() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.openWithTransactions(at: dbPath)
+    defer { db.close() }
+
+    try db.put("committed", forKey: "a")
+
+    try db.transaction { txn in
+      try txn.put("pending", forKey: "b")
+      let a = try txn.withValue(forKey: "a".data(using: .utf8)!) { String(decoding: $0, as: UTF8.self) }
+      let b = try txn.withValue(forKey: "b".data(using: .utf8)!) { String(decoding: $0, as: UTF8.self) }
+      XCTAssertEqual(a, "committed")
+      XCTAssertEqual(b, "pending")
+    }
+  }
+
+  func testTransactionRollback() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.openWithTransactions(at: dbPath)
+    defer { db.close() }
+
+    // Put initial value
+    try db.put("initial", forKey: "rollback-test")
+
+    // Transaction that fails
+    do {
+      _ = try db.transaction { txn in
+        try txn.put("new-value", forKey: "rollback-test")
+        throw RocksDBError.invalidArgument("Intentional failure")
+      }
+      XCTFail("Should have thrown")
+    } catch {
+      // Expected
+    }
+
+    // Value should be unchanged
+    XCTAssertEqual(try db.getString("rollback-test"), "initial")
+  }
+
+  func testTransactionSavepoint() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.openWithTransactions(at: dbPath)
+    defer { db.close() }
+
+    let txn = try db.beginTransaction()
+
+    try txn.put("value1", forKey: "key1")
+    txn.setSavepoint()
+
+    try txn.put("value2", forKey: "key2")
+
+    // Rollback to savepoint
+    try txn.rollbackToSavepoint()
+
+    // key2 should be gone, key1 should remain
+    try txn.commit()
+
+    XCTAssertEqual(try db.getString("key1"), "value1")
+    XCTAssertNil(try db.getString("key2"))
+  }
+
+  func testSnapshotTransactionBatchedReads() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.openWithTransactions(at: dbPath)
+    defer { db.close() }
+
+    let keys = ["a", "b", "c"].map { $0.data(using: .utf8)! }
+    try db.put("1", forKey: "a")
+    try db.put("2", forKey: "b")
+
+    let txn = try db.beginTransaction(snapshot: true)
+    try db.put("changed", forKey: "a")
+
+    // Reads see the database as of begin, plus the transaction's own writes
+    try txn.put("3", forKey: "c")
+    XCTAssertEqual(try txn.multiGet(keys).map { $0.map { String(decoding: $0, as: UTF8.self) } },
+                   ["1", "2", "3"])
+
+    let locked = try txn.multiGetForUpdate(Array(keys.prefix(2)))
+    XCTAssertEqual(locked.compactMap { $0 }.count, 2)
+    try txn.put("updated", forKey: "a")
+
+    // "a" changed after the snapshot, so the commit conflicts
+    XCTAssertThrowsError(try txn.commit()) { error in
+      guard case RocksDBError.transactionConflict = error else {
+        return XCTFail("Expected transactionConflict, got \(error)")
+      }
+    }
+    XCTAssertEqual(try db.getString("a"), "changed")
+  }
+
+  func testSharedSnapshots() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    try db.put("before", forKey: "key")
+    db.snapshotSharingWindow = 60
+
+    var readOptions = RocksDBReadOptions()
+    readOptions.snapshot = try db.sharedSnapshot()
+    var second: RocksDBSnapshot? = try db.sharedSnapshot()
+    XCTAssertTrue(readOptions.snapshot === second)
+
+    try db.put("after", forKey: "key")
+    XCTAssertEqual(try db.get("key".data(using: .utf8)!, options: readOptions),
+                   "before".data(using: .utf8))
+
+    var stats = db.snapshotStats
+    XCTAssertEqual(stats.count, 1)
+    XCTAssertEqual(stats.sharedHits, 1)
+    XCTAssertNotNil(stats.oldestAge)
+
+    // The snapshot is released with its last reference
+    readOptions.snapshot = nil
+    XCTAssertEqual(db.snapshotStats.count, 1)
+    second = nil
+    stats = db.snapshotStats
+    XCTAssertEqual(stats.count, 0)
+    XCTAssertNil(stats.oldestAge)
+  }
+
+  func testTransactionBoundedIteration() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.openWithTransactions(at: dbPath)
+    defer { db.close() }
+
+    for key in ["a1", "b1", "b3", "c1"] {
+      try db.put("db", forKey: key)
+    }
+
+    let txn = try db.beginTransaction()
+    try txn.put("txn", forKey: "b2")
+    try txn.put("txn", forKey: "c0")
+
+    // Both the staged writes and the database stop at the range end
+    var seen: [String] = []
+    let range = RocksDBKeyRange(start: "b".data(using: .utf8)!, end: "c".data(using: .utf8)!)
+    try txn.forEach(in: range) { key, _ in
+      seen.append(String(decoding: key, as: UTF8.self))
+      return true
+    }
+    XCTAssertEqual(seen, ["b1", "b2", "b3"])
+
+    // Rolling back to a savepoint invalidates open iterators
+    txn.setSavepoint()
+    try txn.put("txn", forKey: "b4")
+    let iter = try txn.makeIterator()
+    iter.seekToFirst()
+    XCTAssertTrue(iter.isValid)
+    try txn.rollbackToSavepoint()
+    XCTAssertFalse(iter.isValid)
+    XCTAssertThrowsError(try iter.checkStatus())
+    iter.close()
+
+    try txn.commit()
+    XCTAssertNil(try db.getString("b4"))
+    XCTAssertEqual(try db.getString("b2"), "txn")
+  }
+
+  func testReadOnlyTransaction() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    try db.put("1", forKey: "a")
+    try db.put("2", forKey: "b")
+
+    try db.readTransaction { txn in
+      try db.put("changed", forKey: "a")
+      try db.put("3", forKey: "c")
+
+      XCTAssertEqual(try txn.getString("a"), "1")
+      XCTAssertEqual(try txn.multiGet(["a", "b", "c"].map { $0.data(using: .utf8)! }).compactMap { $0 }.count, 2)
+
+      var keys: [String] = []
+      try txn.forEach(in: .all) { key, _ in
+        keys.append(String(decoding: key, as: UTF8.self))
+        return true
+      }
+      XCTAssertEqual(keys, ["a", "b"])
+    }
+    XCTAssertEqual(db.snapshotStats.count, 0)
+    XCTAssertEqual(try db.getString("a"), "changed")
+  }
+
+  func testTransactionHandleReuse() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.openWithTransactions(at: dbPath)
+    defer { db.close() }
+
+    var escaped: RocksDBTransaction?
+    for i in 0..<5 {
+      try db.transaction { txn in
+        try txn.put("\(i)", forKey: "key\(i)")
+        escaped = txn
+      }
+    }
+    XCTAssertEqual(db.transactionPool.count, 1)
+
+    // A failed transaction is rolled back before its handle is pooled
+    XCTAssertThrowsError(try db.transaction { txn in
+      try txn.put("discarded", forKey: "key0")
+      throw RocksDBError.invalidArgument("abort")
+    })
+    XCTAssertEqual(try db.getString("key0"), "0")
+    XCTAssertEqual(try db.getString("key4"), "4")
+
+    // A transaction kept past its closure no longer owns the pooled handle
+    XCTAssertThrowsError(try escaped?.put("late", forKey: "key1"))
+    XCTAssertEqual(db.transactionPool.count, 1)
+  }
+
+  func testTransactionIteratorOutlivesPooling() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.openWithTransactions(at: dbPath)
+    defer { db.close() }
+
+    var escaped: RocksDBIterator?
+    try db.transaction { txn in
+      try txn.put("first", forKey: "a")
+      let iter = try txn.makeIterator()
+      iter.seekToFirst()
+      XCTAssertEqual(iter.keyString, "a")
+      escaped = iter
+    }
+    XCTAssertEqual(db.transactionPool.count, 1)
+
+    // The open iterator keeps the pooled transaction, so the next one
+    // begins on a fresh handle instead of resetting that write batch
+    try db.transaction { txn in
+      try txn.put("second", forKey: "b")
+    }
+    XCTAssertEqual(try db.getString("b"), "second")
+
+    XCTAssertFalse(escaped?.isValid ?? true)
+    XCTAssertThrowsError(try escaped?.checkStatus())
+    escaped = nil
+
+    try db.transaction { txn in
+      try txn.put("third", forKey: "c")
+    }
+    XCTAssertEqual(try db.getString("c"), "third")
+  }
+
+  func testTransactionOutlivesClose() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.openWithTransactions(at: dbPath)
+
+    var txn: RocksDBTransaction? = try db.beginTransaction()
+    try txn?.put("uncommitted", forKey: "key")
+    db.close()
+
+    // The open transaction keeps the native database, and its lock, alive
+    XCTAssertThrowsError(try RocksDB.openWithTransactions(at: dbPath))
+
+    // Releasing it rolls back and frees the database
+    txn = nil
+    let reopened = try RocksDB.openWithTransactions(at: dbPath)
+    defer { reopened.close() }
+    XCTAssertNil(try reopened.getString("key"))
+  }
+
+  func testTransactionConflictRetry() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.openWithTransactions(at: dbPath)
+    defer { db.close() }
+
+    try db.put("0", forKey: "counter")
+    let policy = RocksDBRetryPolicy(maxAttempts: 3, initialBackoff: 0.001)
+
+    // The first two attempts race a concurrent write and conflict
+    var runs = 0
+    try db.transaction(retry: policy) { txn in
+      runs += 1
+      let current = try txn.getForUpdate("counter".data(using: .utf8)!)
+      if runs < 3 {
+        try db.put("\(runs * 10)", forKey: "counter")
+      }
+      let value = Int(String(decoding: current ?? Data(), as: UTF8.self)) ?? 0
+      try txn.put("\(value + 1)", forKey: "counter")
+    }
+    XCTAssertEqual(runs, 3)
+    XCTAssertEqual(try db.getString("counter"), "21")
+
+    var metrics = db.transactionMetrics
+    XCTAssertEqual(metrics.attempts, 3)
+    XCTAssertEqual(metrics.conflicts, 2)
+    XCTAssertEqual(metrics.commits, 1)
+    XCTAssertEqual(metrics.retried, 1)
+    XCTAssertGreaterThan(metrics.retryLatency, 0)
+
+    // Without retries the conflict reaches the caller
+    XCTAssertThrowsError(try db.transaction { txn in
+      _ = try txn.getForUpdate("counter".data(using: .utf8)!)
+      try db.put("external", forKey: "counter")
+      try txn.put("lost", forKey: "counter")
+    })
+    metrics = db.transactionMetrics
+    XCTAssertEqual(metrics.exhausted, 1)
+    XCTAssertEqual(metrics.conflicts, 3)
+
+    db.resetTransactionMetrics()
+    XCTAssertEqual(db.transactionMetrics, RocksDBTransactionMetrics())
+  }
+
+  func testTwoPhaseCommit() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    var txnOptions = RocksDBTransactionDBOptions.pessimistic
+    txnOptions.writePolicy = .writePrepared
+    txnOptions.twoPhaseCommit = true
+    let db = try RocksDB.openWithTransactions(at: dbPath, transactionOptions: txnOptions)
+    defer { db.close() }
+
+    let txn = try db.beginTransaction()
+    try txn.setName("xid-1")
+    XCTAssertEqual(txn.name, "xid-1")
+
+    for i in 0..<100 {
+      try txn.put("value\(i)", forKey: "key\(i)")
+    }
+    try txn.prepare()
+
+    // Prepared writes stay invisible until the commit marker
+    XCTAssertNil(try db.getString("key0"))
+    XCTAssertTrue(try db.preparedTransactions().isEmpty)
+
+    try txn.commit()
+    XCTAssertEqual(try db.getString("key99"), "value99")
+
+    // Optimistic transactions cannot take part in two-phase commit
+    let optimistic = try RocksDB.openWithTransactions(
+      at: tempDirectory.appendingPathComponent("occ.db").path)
+    defer { optimistic.close() }
+    XCTAssertThrowsError(try optimistic.beginTransaction().setName("xid-2"))
+
+    // Neither can pessimistic ones unless two-phase commit is enabled
+    let onePhase = try RocksDB.openWithTransactions(
+      at: tempDirectory.appendingPathComponent("1pc.db").path, transactionOptions: .pessimistic)
+    defer { onePhase.close() }
+    XCTAssertThrowsError(try onePhase.beginTransaction().setName("xid-3"))
+  }
+
+  func testPreparedTransactionRecovery() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    var txnOptions = RocksDBTransactionDBOptions.pessimistic
+    txnOptions.twoPhaseCommit = true
+
+    let db = try RocksDB.openWithTransactions(at: dbPath, transactionOptions: txnOptions)
+    var pending: [RocksDBTransaction] = []
+    for name in ["xid-commit", "xid-rollback"] {
+      let txn = try db.beginTransaction()
+      try txn.setName(name)
+      try txn.put("from-\(name)", forKey: name)
+      try txn.prepare()
+      pending.append(txn)
+    }
+
+    // Released after the close, the transactions stay prepared in the WAL
+    db.close()
+    pending.removeAll()
+
+    let reopened = try RocksDB.openWithTransactions(at: dbPath, transactionOptions: txnOptions)
+    defer { reopened.close() }
+    let recovered = try reopened.preparedTransactions()
+    XCTAssertEqual(Set(recovered.map(\.name)), ["xid-commit", "xid-rollback"])
+    XCTAssertNil(try reopened.getString("xid-commit"))
+
+    for txn in recovered {
+      if txn.name == "xid-commit" {
+        try txn.commit()
+      } else {
+        txn.rollback()
+      }
+    }
+    XCTAssertEqual(try reopened.getString("xid-commit"), "from-xid-commit")
+    XCTAssertNil(try reopened.getString("xid-rollback"))
+    XCTAssertTrue(try reopened.preparedTransactions().isEmpty)
+  }
+
+  func testPessimisticTransactions() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    var txnOptions = RocksDBTransactionDBOptions.pessimistic
+    txnOptions.lockTimeout = 0.05
+    txnOptions.deadlockDetection = true
+    let db = try RocksDB.openWithTransactions(at: dbPath, transactionOptions: txnOptions)
+    defer { db.close() }
+
+    XCTAssertTrue(db.isTransactional)
+
+    let first = try db.beginTransaction()
+    try first.put("reserved", forKey: "sku-1")
+
+    // The row lock makes the second writer wait, then time out
+    let second = try db.beginTransaction()
+    XCTAssertThrowsError(try second.put("oversold", forKey: "sku-1")) { error in
+      guard case RocksDBError.timedOut(.lockTimeout) = error else {
+        return XCTFail("Expected a lock timeout, got \(error)")
+      }
+      XCTAssertEqual((error as? RocksDBError)?.subcode, .lockTimeout)
+      XCTAssertTrue(RocksDBRetryPolicy.isRetryable(error))
+    }
+    second.rollback()
+
+    try first.commit()
+    XCTAssertEqual(try db.getString("sku-1"), "reserved")
+
+    // Same API as optimistic mode once the lock is free
+    try db.transaction { txn in
+      try txn.put("restocked", forKey: "sku-1")
+    }
+    XCTAssertEqual(try db.getString("sku-1"), "restocked")
+  }
+
+  func testOptimisticValidationPolicies() throws {
+    var serial = RocksDBTransactionDBOptions.optimistic
+    serial.validationPolicy = .serial
+
+    let shared = RocksDBOccLockBuckets(bucketCount: 1 << 16)
+    var sharedParallel = RocksDBTransactionDBOptions.optimistic
+    sharedParallel.sharedLockBuckets = shared
+
+    let policies: [(String, RocksDBTransactionDBOptions)] = [
+      ("serial", serial),
+      ("parallel", .optimistic),
+      ("parallel-shared", sharedParallel),
+    ]
+
+    let threads = 4
+    let perThread = 100
+    for (name, transactionOptions) in policies {
+      let dbPath = tempDirectory.appendingPathComponent("occ-\(name).db").path
+      let db = try RocksDB.openWithTransactions(at: dbPath, transactionOptions: transactionOptions)
+      defer { db.close() }
+
+      // Disjoint keys per thread: every commit validates on its first attempt
+      let failures = PartitionCounts()
+      DispatchQueue.concurrentPerform(iterations: threads) { t in
+        for i in 0..<perThread {
+          do {
+            try db.transaction { txn in
+              try txn.put("value-\(i)", forKey: "t\(t)-k\(i)")
+            }
+          } catch {
+            failures.add(t)
+          }
+        }
+      }
+      XCTAssertEqual(failures.total, 0, name)
+      XCTAssertEqual(db.transactionMetrics.commits, threads * perThread, name)
+      XCTAssertEqual(db.transactionMetrics.conflicts, 0, name)
+      XCTAssertEqual(try db.getString("t\(threads - 1)-k\(perThread - 1)"), "value-\(perThread - 1)")
+
+      // A write committed after a transaction read the key fails its validation
+      let txn = try db.beginTransaction(snapshot: true)
+      _ = try txn.getForUpdate(Data("t0-k0".utf8))
+      try db.put("outside", forKey: "t0-k0")
+      try txn.put("inside", forKey: "t0-k0")
+      XCTAssertThrowsError(try txn.commit(), name) { error in
+        guard case RocksDBError.transactionConflict = error else {
+          return XCTFail("Expected transactionConflict, got \(error)")
+        }
+      }
+      XCTAssertEqual(try db.getString("t0-k0"), "outside")
+    }
+  }
+
+  // MARK: - Options Tests
+
+  func testCustomOptions() throws {
+    var options = RocksDBOptions()
+    options.compression = .zstd
+    options.writeBufferSize = 128 * 1024 * 1024
+    options.maxOpenFiles = 500
+
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath, options: options)
+    defer { db.close() }
+
+    try db.put("test", forKey: "key")
+    XCTAssertEqual(try db.getString("key"), "test")
+  }
+
+  func testPointLookupOptions() throws {
+    let options = RocksDBOptions.pointLookup(blockCacheSizeMB: 64)
+
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath, options: options)
+    defer { db.close() }
+
+    try db.put("test", forKey: "key")
+    XCTAssertEqual(try db.getString("key"), "test")
+  }
+
+  func testOptionHandlesAreCached() throws {
+    XCTAssertEqual(RocksDBReadOptions.default.handle, RocksDBReadOptions().handle)
+    XCTAssertEqual(RocksDBWriteOptions.default.handle, RocksDBWriteOptions().handle)
+
+    var readOptions = RocksDBReadOptions()
+    readOptions.fillCache = false
+    let copy = readOptions
+    XCTAssertNotEqual(readOptions.handle, RocksDBReadOptions.default.handle)
+    XCTAssertEqual(readOptions.handle, copy.handle)
+
+    var writeOptions = RocksDBWriteOptions()
+    writeOptions.disableWAL = true
+
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    try db.put("value", forKey: "key", options: writeOptions)
+    XCTAssertEqual(try db.getString("key", options: readOptions), "value")
+  }
+
+  func testPrefixExtractorWithPrefixFilter() throws {
+    var options = RocksDBOptions()
+    options.prefixExtractor = .fixed(4)
+    var table = RocksDBTableOptions()
+    table.wholeKeyFiltering = false
+    options.tableOptions = table
+
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath, options: options)
+    defer { db.close() }
+
+    for tenant in ["aaaa", "bbbb", "cccc"] {
+      for i in 0..<10 {
+        try db.put("v\(i)", forKey: "\(tenant)|\(i)")
+      }
+    }
+    try db.flush()
+
+    var readOptions = RocksDBReadOptions()
+    readOptions.prefixSameAsStart = true
+
+    var count = 0
+    try db.forEachWithPrefix("bbbb".data(using: .utf8)!, options: readOptions) { key, _ in
+      XCTAssertTrue(key.starts(with: "bbbb".data(using: .utf8)!))
+      count += 1
+      return true
+    }
+    XCTAssertEqual(count, 10)
+    XCTAssertEqual(try db.getString("cccc|3"), "v3")
+  }
+
+  func testTableOptions() throws {
+    var options = RocksDBOptions()
+    options.tableOptions = .partitionedPointLookup
+    options.tableOptions?.blockSize = 16 * 1024
+
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath, options: options)
+    defer { db.close() }
+
+    for i in 0..<100 {
+      try db.put("value-\(i)", forKey: "key-\(i)")
+    }
+    try db.flush()
+
+    XCTAssertEqual(try db.getString("key-42"), "value-42")
+    XCTAssertNil(try db.getString("key-missing"))
+  }
+
+  func testScanReadahead() throws {
+    var options = RocksDBOptions()
+    options.tableOptions = .sequentialScan
+
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath, options: options)
+    defer { db.close() }
+
+    for i in 0..<1000 {
+      try db.put(String(repeating: "v", count: 100), forKey: String(format: "key-%04d", i))
+    }
+    try db.flush()
+
+    var scanOptions = RocksDBReadOptions.scan
+    scanOptions.readaheadSize = 2 * 1024 * 1024
+    var count = 0
+    try db.forEach(in: .all, options: scanOptions) { _, _ in
+      count += 1
+      return true
+    }
+    XCTAssertEqual(count, 1000)
+  }
+
+  func testParallelScan() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    // Several flushes leave several files to split on
+    for file in 0..<4 {
+      for i in 0..<250 {
+        let n = file * 250 + i
+        try db.put(String(repeating: "v", count: 200), forKey: String(format: "key-%04d", n))
+      }
+      try db.flush()
+    }
+
+    let ranges = try db.split(.all, into: 4)
+    XCTAssertGreaterThan(ranges.count, 1)
+    XCTAssertNil(ranges.first?.start)
+    XCTAssertNil(ranges.last?.end)
+
+    let counts = PartitionCounts()
+    try db.parallelScan(partitions: 4) { partition, _, _ in
+      counts.add(partition)
+      return true
+    }
+    XCTAssertEqual(counts.total, 1000)
+    XCTAssertEqual(counts.partitions, ranges.count)
+  }
+
+  func testSstFileMetadata() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    // Two L0 files with disjoint keys, the second with some deletions
+    for i in 0..<100 {
+      try db.put("value", forKey: String(format: "a-%03d", i))
+    }
+    try db.flush()
+    for i in 0..<100 {
+      try db.put("value", forKey: String(format: "b-%03d", i))
+    }
+    for i in 0..<10 {
+      try db.delete(String(format: "a-%03d", i))
+    }
+    try db.flush()
+
+    let files = try db.liveFiles()
+    XCTAssertEqual(files.count, 2)
+    XCTAssertTrue(files.allSatisfy { $0.level == 0 && $0.columnFamily == "default" && $0.size > 0 })
+    XCTAssertTrue(files.allSatisfy { FileManager.default.fileExists(atPath: $0.path) })
+
+    // L0 is newest first
+    let newest = files[0], oldest = files[1]
+    XCTAssertGreaterThan(newest.largestSequence, oldest.largestSequence)
+    XCTAssertEqual(oldest.smallestKey, Data("a-000".utf8))
+    XCTAssertEqual(oldest.largestKey, Data("a-099".utf8))
+    XCTAssertEqual(oldest.numEntries, 100)
+    XCTAssertEqual(oldest.numDeletions, 0)
+    XCTAssertEqual(newest.numEntries, 110)
+    XCTAssertEqual(newest.numDeletions, 10)
+    XCTAssertTrue(newest.overlaps(.prefix(Data("b-".utf8))))
+    XCTAssertFalse(oldest.overlaps(.prefix(Data("b-".utf8))))
+
+    let metadata = try db.columnFamilyMetadata()
+    XCTAssertEqual(metadata.name, "default")
+    XCTAssertEqual(metadata.levels.count, 7)
+    XCTAssertEqual(metadata.levels[0].files, files)
+    XCTAssertEqual(metadata.fileCount, 2)
+    XCTAssertEqual(metadata.size, files.reduce(0) { $0 + $1.size })
+
+    let properties = try db.tableProperties(in: [.prefix(Data("b-".utf8))])
+    XCTAssertEqual(properties.count, 1)
+    XCTAssertEqual(properties.first?.filePath, newest.path)
+    XCTAssertEqual(properties.first?.numEntries, 110)
+    XCTAssertEqual(properties.first?.numDeletions, 10)
+    XCTAssertEqual(try db.tableProperties().count, 2)
+  }
+
+  func testRemoteCompactionService() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let service = InProcessCompactionService(outputRoot: tempDirectory.appendingPathComponent("jobs").path)
+    var options = RocksDBOptions()
+    options.compactionService = service
+    let db = try RocksDB.open(at: dbPath, options: options)
+    defer { db.close() }
+
+    for round in 0..<2 {
+      for i in 0..<100 {
+        try db.put("value-\(round)", forKey: String(format: "key-%03d", i))
+      }
+      try db.flush()
+    }
+    try db.compactRange()
+
+    // The worker wrote the output and the primary installed it
+    XCTAssertGreaterThan(service.finished.count, 0)
+    XCTAssertEqual(service.installations.map(\.status),
+                   [RocksDBCompactionJobStatus](repeating: .success, count: service.finished.count))
+    XCTAssertEqual(service.finished.first?.databaseName, dbPath)
+    XCTAssertTrue(try db.columnFamilyMetadata().levels[0].files.isEmpty)
+    XCTAssertEqual(try db.getString("key-000"), "value-1")
+    XCTAssertEqual(try db.getString("key-099"), "value-1")
+  }
+
+  func testCompactFilesFullOfTombstones() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    // Two bottommost files with disjoint keys
+    for prefix in ["a", "b"] {
+      for i in 0..<200 {
+        try db.put("value", forKey: String(format: "\(prefix)-%03d", i))
+      }
+      try db.flush()
+      let flushed = try db.columnFamilyMetadata().levels[0].files
+      try db.compactFiles(flushed, toLevel: 6)
+    }
+    XCTAssertEqual(try db.columnFamilyMetadata().levels[6].files.count, 2)
+
+    // Compacting the tombstone file pulls in only the bottommost file it
+    // overlaps, and the result drops both the values and the tombstones
+    for i in 0..<200 {
+      try db.delete(String(format: "a-%03d", i))
+    }
+    try db.flush()
+    let tombstones = try db.liveFiles().filter { $0.deletionRatio > 0.5 }
+    XCTAssertEqual(tombstones.count, 1)
+
+    var compaction = RocksDBCompactionOptions()
+    compaction.compression = RocksDBCompression.none
+    let outputs = try db.compactFiles(tombstones, toLevel: 6, options: compaction)
+    XCTAssertTrue(outputs.allSatisfy { FileManager.default.fileExists(atPath: $0) })
+
+    let levels = try db.columnFamilyMetadata().levels
+    XCTAssertTrue(levels[0].files.isEmpty)
+    XCTAssertEqual(levels[6].files.map(\.smallestKey), [Data("b-000".utf8)])
+    XCTAssertNil(try db.getString("a-000"))
+    XCTAssertEqual(try db.getString("b-000"), "value")
+
+    XCTAssertThrowsError(try db.compactFiles(["999999.sst"], toLevel: 6)) { error in
+      guard case RocksDBError.invalidArgument = error else {
+        return XCTFail("Expected invalidArgument, got \(error)")
+      }
+    }
+  }
+
+  func testApproximateRangeSizes() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    for i in 0..<1000 {
+      try db.put(String(repeating: "v", count: 200), forKey: String(format: "key-%04d", i))
+    }
+    let firstHalf = RocksDBKeyRange(start: Data("key-0000".utf8), end: Data("key-0500".utf8))
+
+    // Unflushed writes are only visible with memtables included
+    XCTAssertGreaterThan(try db.approximateSize(of: firstHalf), 0)
+    XCTAssertEqual(try db.approximateSize(of: firstHalf, options: .init(includeMemtables: false)), 0)
+    let stats = try db.approximateMemtableStats(of: .all)
+    XCTAssertGreaterThan(stats.count, 0)
+    XCTAssertGreaterThan(stats.size, 0)
+
+    try db.flush()
+    XCTAssertEqual(try db.approximateMemtableStats(of: .all).count, 0)
+    let sizes = try db.approximateSizes(of: [firstHalf, .all, .prefix(Data("other".utf8))],
+                                        options: .init(includeMemtables: false))
+    XCTAssertGreaterThan(sizes[0], 0)
+    XCTAssertGreaterThanOrEqual(sizes[1], sizes[0])
+    XCTAssertEqual(sizes[2], 0)
+
+    XCTAssertThrowsError(try db.approximateSize(of: .all, options: .init(includeMemtables: false,
+                                                                        includeFiles: false))) { error in
+      guard case RocksDBError.invalidArgument = error else {
+        return XCTFail("Expected invalidArgument, got \(error)")
+      }
+    }
+  }
+
+  func testShardedStore() throws {
+    let storePath = tempDirectory.appendingPathComponent("sharded").path
+    let store = try RocksDBShardedStore.open(at: storePath, shardCount: 4)
+
+    let keys = (0..<200).map { String(format: "key-%03d", $0).data(using: .utf8)! }
+    for key in keys {
+      try store.put(key, forKey: key)
+    }
+    try store.delete(keys[0])
+
+    XCTAssertNil(try store.get(keys[0]))
+    XCTAssertEqual(try store.get(keys[1]), keys[1])
+    XCTAssertTrue(store.shards.allSatisfy { (try? $0.get(keys[1])) == nil || $0 === store.shard(for: keys[1]) })
+
+    let values = try store.multiGet(keys)
+    XCTAssertNil(values[0])
+    XCTAssertEqual(values.dropFirst().map { $0 }, keys.dropFirst().map { $0 })
+
+    var scanned: [Data] = []
+    try store.forEach { key, _ in
+      scanned.append(key)
+      return true
+    }
+    XCTAssertEqual(scanned, Array(keys.dropFirst()))
+    store.close()
+
+    XCTAssertThrowsError(try RocksDBShardedStore.open(at: storePath, shardCount: 3))
+    let reopened = try RocksDBShardedStore.open(at: storePath, shardCount: 4)
+    XCTAssertEqual(try reopened.get(keys[199]), keys[199])
+    reopened.close()
+  }
+
+  func testDatabasePool() throws {
+    let pool = try RocksDBPool(maxOpenDatabases: 2, maxOpenFiles: 200)
+    defer { pool.close() }
+    XCTAssertEqual(pool.options.maxOpenFiles, 100)
+    XCTAssertThrowsError(try RocksDBPool(maxOpenDatabases: 100, maxOpenFiles: 200))
+
+    let paths = (0..<3).map { tempDirectory.appendingPathComponent("tenant-\($0)").path }
+    for (i, path) in paths.enumerated() {
+      try pool.withDatabase(at: path) { db in
+        try db.put(Data("tenant-\(i)".utf8), forKey: Data("name".utf8))
+      }
+    }
+
+    // Opening the third tenant closed the least recently used one
+    XCTAssertEqual(pool.openCount, 2)
+    XCTAssertFalse(pool.isOpen(at: paths[0]))
+    XCTAssertEqual(try pool.withDatabase(at: paths[0]) { try $0.get(Data("name".utf8)) },
+                   Data("tenant-0".utf8))
+    XCTAssertFalse(pool.isOpen(at: paths[1]))
+
+    // Concurrent requests for one database share a single open
+    let failures = PartitionCounts()
+    DispatchQueue.concurrentPerform(iterations: 8) { _ in
+      do {
+        _ = try pool.withDatabase(at: paths[1]) { try $0.get(Data("name".utf8)) }
+      } catch {
+        failures.add(0)
+      }
+    }
+    XCTAssertEqual(failures.total, 0)
+    XCTAssertEqual(pool.openCount, 2)
+
+    XCTAssertEqual(pool.closeIdle(olderThan: 0), 2)
+    XCTAssertEqual(pool.openCount, 0)
+  }
+
+  func testDatabasePoolCloseWaitsForLeases() throws {
+    let pool = try RocksDBPool(maxOpenDatabases: 2, maxOpenFiles: 200)
+    let path = tempDirectory.appendingPathComponent("tenant").path
+
+    let entered = DispatchSemaphore(value: 0)
+    let proceed = DispatchSemaphore(value: 0)
+    let failures = PartitionCounts()
+    let worker = DispatchGroup()
+    DispatchQueue.global().async(group: worker) {
+      do {
+        try pool.withDatabase(at: path) { db in
+          entered.signal()
+          proceed.wait()
+          try db.put(Data("written".utf8), forKey: Data("key".utf8))
+        }
+      } catch {
+        failures.add(0)
+      }
+    }
+    entered.wait()
+
+    // close() blocks until the running withDatabase returns
+    let closer = DispatchGroup()
+    DispatchQueue.global().async(group: closer) { pool.close() }
+    XCTAssertEqual(closer.wait(timeout: .now() + 0.2), .timedOut)
+    proceed.signal()
+    worker.wait()
+    closer.wait()
+
+    XCTAssertEqual(failures.total, 0)
+    XCTAssertEqual(pool.openCount, 0)
+    XCTAssertThrowsError(try pool.withDatabase(at: path) { _ in })
+
+    let db = try RocksDB.open(at: path)
+    defer { db.close() }
+    XCTAssertEqual(try db.get(Data("key".utf8)), Data("written".utf8))
+  }
+
+  func testQueue() throws {
+    let path = tempDirectory.appendingPathComponent("queue.db").path
+    let queue = try RocksDBQueue.open(at: path, trimInterval: 4)
+
+    let sequences = try queue.enqueue((0..<10).map { Data("job-\($0)".utf8) })
+    XCTAssertEqual(sequences, 0..<10)
+    XCTAssertEqual(queue.count, 10)
+
+    let first = try queue.dequeue(max: 3)
+    XCTAssertEqual(first.map(\.sequence), [0, 1, 2])
+    XCTAssertEqual(first.first?.value, Data("job-0".utf8))
+
+    // The tailing iterator sees items enqueued after it was created
+    try queue.enqueue(Data("job-10".utf8))
+    let rest = try queue.dequeue(max: 100)
+    XCTAssertEqual(rest.map(\.sequence), Array(3...10))
+    XCTAssertTrue(try queue.dequeue().isEmpty)
+    XCTAssertEqual(queue.count, 0)
+
+    // Trimming dropped the consumed items with a range tombstone
+    XCTAssertNil(try queue.database.get(Data([0x01]) + withUnsafeBytes(of: UInt64(5).bigEndian) { Data($0) }))
+
+    try queue.enqueue(Data("after-restart".utf8))
+    queue.close()
+
+    let reopened = try RocksDBQueue.open(at: path)
+    defer { reopened.close() }
+    XCTAssertEqual(reopened.count, 1)
+    let resumed = try reopened.dequeue(max: 10)
+    XCTAssertEqual(resumed.map(\.sequence), [11])
+    XCTAssertEqual(resumed.first?.value, Data("after-restart".utf8))
+    XCTAssertEqual(try reopened.enqueue(Data("next".utf8)), 12)
+  }
+
+  func testReadContext() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    try db.put("memtable", forKey: "a")
+    try db.put("flushed", forKey: "b")
+    try db.flush()
+    try db.put("", forKey: "empty")
+
+    let context = RocksDBReadContext()
+    for _ in 0..<3 {
+      XCTAssertEqual(try db.get("a".data(using: .utf8)!, context: context), "memtable".data(using: .utf8))
+      XCTAssertEqual(try db.get("b".data(using: .utf8)!, context: context), "flushed".data(using: .utf8))
+      XCTAssertEqual(try db.get("empty".data(using: .utf8)!, context: context), Data())
+      XCTAssertNil(try db.get("missing".data(using: .utf8)!, context: context))
+    }
+
+    let length = try db.withValue(forKey: "b".data(using: .utf8)!, context: context) { $0.count }
+    XCTAssertEqual(length, 7)
+
+    let keys = ["a", "missing", "b"].map { $0.data(using: .utf8)! }
+    let values = try db.multiGet(keys, context: context)
+    XCTAssertEqual(values, ["memtable".data(using: .utf8), nil, "flushed".data(using: .utf8)])
+    XCTAssertEqual(try db.multiGet([keys[2]], context: context), ["flushed".data(using: .utf8)])
+  }
+
+  func testBackgroundJobs() throws {
+    let previous = RocksDBEnvironment.backgroundThreads(for: .high)
+    RocksDBEnvironment.setBackgroundThreads(2, for: .high)
+    XCTAssertEqual(RocksDBEnvironment.backgroundThreads(for: .high), 2)
+    RocksDBEnvironment.setBackgroundThreads(previous, for: .high)
+
+    var options = RocksDBOptions()
+    options.maxBackgroundJobs = 4
+    options.maxSubcompactions = 2
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath, options: options)
+    defer { db.close() }
+
+    try db.put("value", forKey: "key")
+    try db.flush()
+    try db.compactRange()
+    XCTAssertEqual(try db.getString("key"), "value")
+  }
+
+  func testCompactRangeOptions() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    for i in 0..<100 {
+      try db.put("value\(i)", forKey: "key\(i)")
+    }
+    try db.flush()
+
+    var options = RocksDBCompactRangeOptions()
+    options.maxSubcompactions = 2
+    options.bottommostLevelCompaction = .force
+    options.changeLevel = true
+    options.targetLevel = 1
+    try db.compactRange(options: options)
+    XCTAssertEqual(try db.getString("key5"), "value5")
+
+    // A compaction cancelled up front reports incomplete
+    let token = RocksDBCancellationToken()
+    token.cancel()
+    XCTAssertTrue(token.isCancelled)
+    options.cancellation = token
+    XCTAssertThrowsError(try db.compactRange(options: options)) { error in
+      guard case RocksDBError.incomplete = error else {
+        return XCTFail("Expected incomplete, got \(error)")
+      }
+    }
+    token.reset()
+    XCTAssertFalse(token.isCancelled)
+    try db.compactRange(options: options)
+  }
+
+  func testBackgroundWorkControl() throws {
+    var options = RocksDBOptions()
+    options.level0FileNumCompactionTrigger = 10
+    options.level0SlowdownWritesTrigger = 6
+    options.level0StopWritesTrigger = 12
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath, options: options)
+    defer { db.close() }
+
+    try db.pauseBackgroundWork()
+    try db.put("value", forKey: "key")
+    try db.continueBackgroundWork()
+    try db.flush()
+
+    db.disableManualCompaction()
+    XCTAssertThrowsError(try db.compactRange())
+    db.enableManualCompaction()
+    try db.compactRange()
+
+    let now = Date()
+    let hour = Calendar.current.component(.hour, from: now)
+    let scheduler = RocksDBCompactionScheduler(
+      database: db,
+      windows: [RocksDBTimeWindow(startHour: hour, duration: 3600)],
+      safetyMargin: 2)
+    XCTAssertTrue(try scheduler.evaluate(at: now))
+    XCTAssertThrowsError(try db.compactRange())
+    XCTAssertFalse(try scheduler.evaluate(at: now.addingTimeInterval(3 * 3600)))
+    try db.compactRange()
+
+    // Nearing the slowdown trigger resumes compactions inside the window
+    XCTAssertEqual(db.level0SlowdownWritesTrigger(), 6)
+    XCTAssertTrue(try scheduler.evaluate(at: now))
+    for i in 0..<4 {
+      try db.put("value\(i)", forKey: "key\(i)")
+      try db.flush()
+    }
+    XCTAssertFalse(try scheduler.evaluate(at: now))
+    scheduler.stop()
+    XCTAssertFalse(scheduler.isQuiet)
+  }
+
+  func testStatistics() throws {
+    var options = RocksDBOptions()
+    options.enableStatistics = true
+    options.statisticsLevel = .all
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath, options: options)
+    defer { db.close() }
+
+    XCTAssertTrue(db.statisticsEnabled)
+    XCTAssertEqual(db.statisticsLevel, .all)
+
+    for i in 0..<10 {
+      try db.put("value\(i)", forKey: "key\(i)")
+    }
+    for i in 0..<10 {
+      _ = try db.getString("key\(i)")
+    }
+
+    XCTAssertEqual(db.tickerCount(.keysWritten), 10)
+    XCTAssertEqual(db.tickerCount(.memtableHit), 10)
+    XCTAssertEqual(db.tickerSnapshot()[.keysRead], 10)
+    XCTAssertEqual(RocksDBTicker(named: "rocksdb.block.cache.hit"), .blockCacheHit)
+
+    let gets = try XCTUnwrap(db.histogramData(.getMicros))
+    XCTAssertEqual(gets.count, 10)
+    XCTAssertGreaterThanOrEqual(gets.max, gets.p50)
+
+    try db.resetStatistics()
+    XCTAssertEqual(db.tickerCount(.keysWritten), 0)
+
+    db.statisticsLevel = .exceptHistogramOrTimers
+    XCTAssertEqual(db.statisticsLevel, .exceptHistogramOrTimers)
+  }
+
+  func testRowCache() throws {
+    let rowCache = RocksDBCache.lru(capacity: 1024 * 1024)
+    var options = RocksDBOptions()
+    options.enableStatistics = true
+    options.rowCache = rowCache
+    let db = try RocksDB.open(at: tempDirectory.appendingPathComponent("test.db").path, options: options)
+    defer { db.close() }
+
+    try db.put("hot", forKey: "key")
+    try db.flush()
+
+    XCTAssertEqual(try db.getString("key"), "hot")
+    XCTAssertEqual(db.tickerCount(.rowCacheMiss), 1)
+    XCTAssertGreaterThan(rowCache.usage, 0)
+    for _ in 0..<5 {
+      XCTAssertEqual(try db.getString("key"), "hot")
+    }
+    XCTAssertEqual(db.tickerCount(.rowCacheHit), 5)
+    XCTAssertEqual(db.tickerCount(.rowCacheMiss), 1)
+  }
+
+  func testPerfContext() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath)
+    defer { db.close() }
+
+    try db.put("memtable", forKey: "a")
+    try db.put("flushed", forKey: "b")
+    try db.flush()
+
+    let previousLevel = RocksDBPerfContext.level
+    let (value, stats) = try RocksDBPerfContext.measure {
+      try db.getString("b")
+    }
+    XCTAssertEqual(value, "flushed")
+    XCTAssertGreaterThan(stats.getFromMemtableCount, 0)
+    XCTAssertGreaterThan(stats.getFromOutputFilesTime, 0)
+    XCTAssertEqual(RocksDBPerfContext.level, previousLevel)
+
+    let writes = try RocksDBPerfContext.measure(level: .enableCount) {
+      try db.put("value", forKey: "c")
+    }.stats
+    XCTAssertEqual(writes.blockReadCount, 0)
+    XCTAssertEqual(writes.writeWALTime, 0)
+
+    RocksDBPerfContext.reset()
+    XCTAssertEqual(RocksDBPerfContext.snapshot(), RocksDBPerfStats())
+  }
+
+  func testEventListener() throws {
+    let listener = RocksDBEventListener(capacity: 64)
+    var options = RocksDBOptions()
+    options.eventListeners = [listener]
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath, options: options)
+    defer { db.close() }
+
+    for i in 0..<100 {
+      try db.put("value\(i)", forKey: "key\(i)")
+    }
+    try db.flush()
+    try db.compactRange()
+
+    // Callbacks run on background threads and may land just after the call returns
+    var flushes: [RocksDBFlushEvent] = []
+    var compactions: [RocksDBCompactionEvent] = []
+    let deadline = Date().addingTimeInterval(5)
+    while (flushes.isEmpty || compactions.isEmpty) && Date() < deadline {
+      for event in listener.poll() {
+        switch event {
+        case .flushCompleted(let flush): flushes.append(flush)
+        case .compactionCompleted(let compaction): compactions.append(compaction)
+        default: break
+        }
+      }
+      Thread.sleep(forTimeInterval: 0.01)
+    }
+
+    XCTAssertEqual(flushes.first?.columnFamily, "default")
+    XCTAssertGreaterThan(flushes.first?.outputBytes ?? 0, 0)
+    XCTAssertGreaterThan(compactions.first?.inputBytes ?? 0, 0)
+    XCTAssertNil(compactions.first?.error)
+    XCTAssertEqual(listener.droppedCount, 0)
+  }
+
+  func testWriteStallState() throws {
+    var options = RocksDBOptions.default
+    options.level0SlowdownWritesTrigger = 2
+    options.level0StopWritesTrigger = 4
+    let db = try RocksDB.open(at: tempDirectory.path, options: options)
+    defer { db.close() }
+
+    let initial = try db.writeStallState()
+    XCTAssertEqual(initial.condition, .normal)
+    XCTAssertEqual(initial.cause, .none)
+    XCTAssertFalse(initial.isWriteStopped)
+    XCTAssertEqual(initial.l0SlowdownTrigger, 2)
+    XCTAssertEqual(initial.l0StopTrigger, 4)
+
+    let reports = PartitionCounts()
+    let monitor = RocksDBWriteStallMonitor(database: db, warningThreshold: 0.5) { state in
+      reports.add(Int(state.condition.rawValue))
+    }
+    try monitor.evaluate()
+    XCTAssertFalse(monitor.isApproachingStall)
+
+    try db.put("a".data(using: .utf8)!, forKey: "a".data(using: .utf8)!)
+    try db.flush()
+    let state = try db.writeStallState()
+    XCTAssertEqual(state.l0Files, 1)
+    XCTAssertEqual(state.pressure, 0.5, accuracy: 0.001)
+    XCTAssertEqual(state.condition, .normal)
+
+    try monitor.evaluate()
+    XCTAssertTrue(monitor.isApproachingStall)
+    try monitor.evaluate()
+    // Reported on the first evaluation and when crossing the threshold
+    XCTAssertEqual(reports.total, 2)
+  }
+
+  func testCallTracing() throws {
+    let db = try RocksDB.open(at: tempDirectory.path)
+    defer { db.close() }
+
+    RocksDBTracing.isEnabled = true
+    defer { RocksDBTracing.isEnabled = false }
+    RocksDBTracing.reset()
+
+    let key = "traced".data(using: .utf8)!
+    for _ in 0..<10 {
+      try db.put(key, forKey: key)
+      _ = try db.get(key)
+    }
+
+    let puts = RocksDBTracing.stats(for: .put)
+    XCTAssertGreaterThanOrEqual(puts.swift.calls, 10)
+    XCTAssertGreaterThanOrEqual(puts.bridge.calls, 10)
+    XCTAssertGreaterThanOrEqual(puts.engine.calls, 10)
+    XCTAssertGreaterThanOrEqual(puts.bridge.totalNanos, puts.engine.totalNanos)
+    XCTAssertEqual(puts.bridge.buckets.reduce(0, +), puts.bridge.calls)
+    XCTAssertGreaterThan(puts.bridge.percentile(99), 0)
+    XCTAssertTrue(RocksDBTracing.snapshot().contains { $0.operation == .get })
+
+    RocksDBTracing.reset()
+    RocksDBTracing.isEnabled = false
+    try db.put(key, forKey: key)
+    XCTAssertEqual(RocksDBTracing.stats(for: .put).bridge.calls, 0)
+  }
+
+  func testTypedProperties() throws {
+    let db = try RocksDB.open(at: tempDirectory.path)
+    defer { db.close() }
+
+    for i in 0..<10 {
+      try db.put("value-\(i)", forKey: "key-\(i)")
+    }
+
+    XCTAssertEqual(db.intProperty(.numEntriesActiveMemTable), 10)
+    XCTAssertGreaterThan(db.intProperty(.curSizeAllMemTables) ?? 0, 0)
+    XCTAssertEqual(db.intProperty(.isWriteStopped), 0)
+    XCTAssertNotNil(db.aggregatedIntProperty(.estimateNumKeys))
+
+    let stats = try XCTUnwrap(db.mapProperty(.cfStats))
+    XCTAssertFalse(stats.isEmpty)
+    XCTAssertNotNil(db.mapProperty(.dbWriteStallStats))
+  }
+
+  func testBlockCacheTrace() throws {
+    var options = RocksDBOptions.default
+    var tableOptions = RocksDBTableOptions()
+    tableOptions.blockCache = .lru(capacity: 8 * 1024 * 1024)
+    options.tableOptions = tableOptions
+    let db = try RocksDB.open(at: tempDirectory.appendingPathComponent("db").path, options: options)
+    defer { db.close() }
+
+    for i in 0..<2000 {
+      try db.put(String(repeating: "v", count: 100), forKey: String(format: "key-%05d", i))
+    }
+    try db.flush()
+
+    let tracePath = tempDirectory.appendingPathComponent("cache.trace").path
+    try db.startBlockCacheTrace(to: tracePath)
+    for round in 0..<3 {
+      for i in stride(from: round, to: 2000, by: 7) {
+        _ = try db.getString(String(format: "key-%05d", i))
+      }
+    }
+    try db.endBlockCacheTrace()
+
+    let trace = try RocksDBBlockCacheTrace(contentsOf: tracePath)
+    XCTAssertFalse(trace.accesses.isEmpty)
+    XCTAssertTrue(trace.accesses.contains { $0.blockType == .data })
+    XCTAssertGreaterThan(trace.workingSetBytes, 0)
+
+    let curve = trace.hitRateCurve(capacities: [4096, 64 * 1024, 8 * 1024 * 1024])
+    XCTAssertEqual(curve.count, 6)
+    // LRU hit rates never drop as the cache grows
+    let lru = curve.filter { $0.policy == .lru }.map(\.hitRate)
+    XCTAssertEqual(lru, lru.sorted())
+    XCTAssertTrue(curve.allSatisfy { $0.lookups == trace.accesses.count })
+  }
+
+  func testQueryTraceReplay() throws {
+    let sourcePath = tempDirectory.appendingPathComponent("source").path
+    let copyPath = tempDirectory.appendingPathComponent("copy").path
+    let tracePath = tempDirectory.appendingPathComponent("query.trace").path
+
+    do {
+      let db = try RocksDB.open(at: sourcePath)
+      defer { db.close() }
+      try db.put("seed", forKey: "seed")
+      try db.flush()
+    }
+    try FileManager.default.copyItem(atPath: sourcePath, toPath: copyPath)
+
+    do {
+      let db = try RocksDB.open(at: sourcePath)
+      defer { db.close() }
+
+      var options = RocksDBTraceOptions()
+      options.excluded = [.iteratorSeeks]
+      try db.startTrace(to: tracePath, options: options)
+      for i in 0..<50 {
+        try db.put("value-\(i)", forKey: "key-\(i)")
+        _ = try db.getString("key-\(i)")
+      }
+      try db.endTrace()
+    }
+
+    let copy = try RocksDB.open(at: copyPath)
+    defer { copy.close() }
+    let result = try copy.replayTrace(from: tracePath, threads: 2, speedup: 1000)
+
+    XCTAssertEqual(result.writes.count, 50)
+    XCTAssertEqual(result.gets.count, 50)
+    XCTAssertEqual(result.writes.errors, 0)
+    XCTAssertLessThanOrEqual(result.gets.p50Micros, result.gets.maxMicros)
+    XCTAssertEqual(try copy.getString("key-49"), "value-49")
+  }
+
+  func testThreadStatus() throws {
+    var options = RocksDBOptions.default
+    options.enableThreadTracking = true
+    let db = try RocksDB.open(at: tempDirectory.path, options: options)
+    defer { db.close() }
+
+    let threads = try RocksDBEnvironment.threadList()
+    // Flush and compaction pools start their threads at open
+    XCTAssertTrue(threads.contains { $0.threadType == .highPriority || $0.threadType == .lowPriority })
+
+    // Whatever is still running belongs to this database
+    try db.put("value", forKey: "key")
+    try db.flush()
+    for job in try db.backgroundJobs() {
+      XCTAssertTrue(job.isBackgroundJob)
+      XCTAssertEqual(job.databaseName, db.path)
+    }
+  }
+
+  func testOptionPresets() throws {
+    let presets: [(String, RocksDBOptions)] = [
+      ("nvmeReadHeavy", .nvmeReadHeavy),
+      ("nvmeWriteHeavy", .nvmeWriteHeavy),
+      ("memoryConstrained", .memoryConstrained(budget: 32 * 1024 * 1024)),
+      ("largeValues", .largeValues),
+      ("timeSeries", .timeSeries),
+      ("autoTune", .autoTune(cores: 4, memory: 256 * 1024 * 1024)),
+    ]
+    for (name, options) in presets {
+      let db = try RocksDB.open(at: tempDirectory.appendingPathComponent(name).path, options: options)
+      try db.put(Data(repeating: 1, count: 8 * 1024), forKey: Data("key".utf8))
+      try db.flush()
+      XCTAssertEqual(try db.get(Data("key".utf8))?.count, 8 * 1024, name)
+      db.close()
+    }
+
+    // Memtables are charged to the budgeted cache
+    let constrained = RocksDBOptions.memoryConstrained(budget: 64 * 1024 * 1024)
+    XCTAssertEqual(constrained.tableOptions?.blockCache?.capacity, 64 * 1024 * 1024)
+    XCTAssertEqual(constrained.writeBufferManager?.bufferSize, 16 * 1024 * 1024)
+
+    let small = RocksDBOptions.autoTune(cores: 2, memory: 256 * 1024 * 1024)
+    let large = RocksDBOptions.autoTune(cores: 32, memory: 16 * 1024 * 1024 * 1024)
+    XCTAssertEqual(small.maxBackgroundJobs, 2)
+    XCTAssertEqual(large.maxBackgroundJobs, 32)
+    XCTAssertEqual(small.tableOptions?.blockCache?.capacity, 192 * 1024 * 1024)
+    XCTAssertLessThanOrEqual(large.writeBufferSize, 256 * 1024 * 1024)
+  }
+
+  func testOptionsFiles() throws {
+    let sourcePath = tempDirectory.appendingPathComponent("source").path
+    var options = RocksDBOptions.default
+    options.writeBufferSize = 8 * 1024 * 1024
+    let source = try RocksDB.open(at: sourcePath, options: options, columnFamilies: ["events": RocksDBColumnFamilyOptions()])
+    try source.put("value", forKey: "key")
+    let exported = tempDirectory.appendingPathComponent("OPTIONS-exported").path
+    try source.exportOptionsFile(to: exported)
+    source.close()
+
+    let latest = try RocksDBOptionsFile.latest(in: sourcePath)
+    XCTAssertEqual(Set(latest.columnFamilies), ["default", "events"])
+    XCTAssertTrue(latest.optionsString()?.contains("write_buffer_size=8388608") ?? false)
+
+    // Tune one family and open a second database with the exact set
+    let tuned = try RocksDBOptionsFile.load(from: exported)
+      .applying("write_buffer_size=4194304;block_based_table_factory={block_size=16384}", to: "events")
+    XCTAssertTrue(tuned.optionsString(for: "events")?.contains("write_buffer_size=4194304") ?? false)
+    XCTAssertTrue(tuned.optionsString()?.contains("write_buffer_size=8388608") ?? false)
+    XCTAssertThrowsError(try tuned.applying("no_such_option=1"))
+
+    let copy = try RocksDB.open(at: tempDirectory.appendingPathComponent("copy").path, optionsFile: tuned)
+    defer { copy.close() }
+    XCTAssertNotNil(copy.columnFamily(named: "events"))
+
+    let parsed = try RocksDBOptionsFile.parse("max_background_jobs=6;compression=kZSTD")
+    XCTAssertTrue(parsed.optionsString()?.contains("max_background_jobs=6") ?? false)
+  }
+
+  func testRuntimeOptions() throws {
+    let db = try RocksDB.open(at: tempDirectory.path)
+    defer { db.close() }
+
+    var familyOptions = RocksDBMutableColumnFamilyOptions()
+    familyOptions.writeBufferSize = 16 * 1024 * 1024
+    familyOptions.level0SlowdownWritesTrigger = 12
+    familyOptions.compression = .zstd
+    try db.setOptions(familyOptions)
+    XCTAssertEqual(db.level0SlowdownWritesTrigger(), 12)
+    XCTAssertTrue(db.currentOptions()?.contains("write_buffer_size=16777216") ?? false)
+
+    var dbOptions = RocksDBMutableDBOptions()
+    dbOptions.maxBackgroundJobs = 6
+    try db.setDBOptions(dbOptions)
+    XCTAssertTrue(db.currentOptions()?.contains("max_background_jobs=6") ?? false)
+
+    // Immutable options are rejected without changing anything
+    XCTAssertThrowsError(try db.setOptions(["level0_stop_writes_trigger": "40", "comparator": "x"]))
+    XCTAssertFalse(db.currentOptions()?.contains("level0_stop_writes_trigger=40") ?? true)
+
+    try db.put("value", forKey: "key")
+    XCTAssertEqual(try db.getString("key"), "value")
+  }
+
+  func testPlainAndCuckooTables() throws {
+    var plain = RocksDBOptions.default
+    var plainTable = RocksDBPlainTableOptions()
+    plainTable.userKeyLength = 8
+    plain.tableFormat = .plain(plainTable)
+    plain.prefixExtractor = .fixed(4)
+
+    var cuckoo = RocksDBOptions.default
+    cuckoo.tableFormat = .cuckoo(RocksDBCuckooTableOptions())
+
+    for (name, options) in [("plain", plain), ("cuckoo", cuckoo)] {
+      let path = tempDirectory.appendingPathComponent(name).path
+      let db = try RocksDB.open(at: path, options: options)
+      // Cuckoo tables need fixed-size keys and values
+      for i in 0..<100 {
+        try db.put(String(format: "value-%04d", i), forKey: String(format: "key-%04d", i))
+      }
+      try db.flush()
+      db.close()
+
+      // Served from the flushed tables through mmap
+      let reader = try RocksDB.openReadOnly(at: path, options: options)
+      XCTAssertEqual(try reader.getString("key-0042"), "value-0042", name)
+      XCTAssertNil(try reader.getString("key-0100"), name)
+      reader.close()
+    }
+  }
+
+  func testMemtableReps() throws {
+    // Vector memtable: unsorted until read, still ordered when scanned
+    let bulk = try RocksDB.open(at: tempDirectory.appendingPathComponent("vector").path, options: .bulkLoad)
+    for i in (0..<100).reversed() {
+      try bulk.put("value-\(i)", forKey: String(format: "key-%03d", i))
+    }
+    var keys: [String] = []
+    try bulk.forEach { key, _ in
+      keys.append(String(decoding: key, as: UTF8.self))
+      return true
+    }
+    XCTAssertEqual(keys, (0..<100).map { String(format: "key-%03d", $0) })
+    bulk.close()
+
+    var hashed = RocksDBOptions.default
+    hashed.prefixExtractor = .fixed(4)
+    hashed.memtableRep = .hashSkipList(bucketCount: 1024, height: 4, branchingFactor: 4)
+    let db = try RocksDB.open(at: tempDirectory.appendingPathComponent("hash").path, options: hashed)
+    defer { db.close() }
+    for user in ["usr1", "usr2"] {
+      for i in 0..<10 {
+        try db.put("v", forKey: "\(user):\(i)")
+      }
+    }
+
+    var matches = 0
+    try db.forEachWithPrefix(Data("usr2".utf8)) { key, _ in
+      XCTAssertTrue(key.starts(with: Data("usr2".utf8)))
+      matches += 1
+      return true
+    }
+    XCTAssertEqual(matches, 10)
+    XCTAssertEqual(try db.getString("usr1:3"), "v")
+  }
+
+  func testMemtableBloomFilter() throws {
+    var options = RocksDBOptions.default
+    options.memtablePrefixBloomSizeRatio = 0.1
+    options.memtableWholeKeyFiltering = true
+    let db = try RocksDB.open(at: tempDirectory.path, options: options)
+    defer { db.close() }
+
+    for i in 0..<100 {
+      try db.put("value-\(i)", forKey: "key-\(i)")
+    }
+
+    // Absent keys are rejected by the bloom filter without a skiplist search
+    let stats = try RocksDBPerfContext.measure(level: .enableCount) {
+      for i in 100..<200 {
+        _ = try db.getString("key-\(i)")
+      }
+    }.stats
+    XCTAssertGreaterThan(stats.bloomMemtableMissCount, 0)
+    XCTAssertEqual(try db.getString("key-42"), "value-42")
+  }
+
+  func testPerLevelCompression() throws {
+    var options = RocksDBOptions.default
+    options.compressionPerLevel = [.none, .none, .lz4, .lz4, .lz4, .lz4, .lz4]
+    options.bottommostCompression = .zstd
+    options.bottommostCompressionOptions = .zstdDictionary
+    let db = try RocksDB.open(at: tempDirectory.path, options: options)
+    defer { db.close() }
+
+    for i in 0..<1000 {
+      try db.put("sample-value-\(i % 10)-padding-padding", forKey: String(format: "key-%05d", i))
+    }
+    try db.flush()
+    try db.compactRange()
+    XCTAssertEqual(try db.getString("key-00042"), "sample-value-2-padding-padding")
+
+    let current = try XCTUnwrap(db.currentOptions())
+    XCTAssertTrue(current.contains("bottommost_compression=kZSTD"))
+    XCTAssertTrue(current.contains("max_dict_bytes=16384"))
+  }
+
+  func testCompactionStyles() throws {
+    var universal = RocksDBUniversalCompactionOptions()
+    universal.sizeRatio = 10
+    universal.maxSizeAmplificationPercent = 50
+    var options = RocksDBOptions.default
+    options.compactionStyle = .universal(universal)
+    let universalPath = tempDirectory.appendingPathComponent("universal").path
+    let db = try RocksDB.open(at: universalPath, options: options)
+    for i in 0..<100 {
+      try db.put("value-\(i)", forKey: String(format: "key-%03d", i))
+    }
+    try db.flush()
+    XCTAssertEqual(try db.getString("key-042"), "value-42")
+    let current = try XCTUnwrap(db.currentOptions())
+    XCTAssertTrue(current.contains("compaction_style=kCompactionStyleUniversal"))
+    XCTAssertTrue(current.contains("max_size_amplification_percent=50"))
+    db.close()
+
+    var fifo = RocksDBFIFOCompactionOptions()
+    fifo.maxTableFilesSize = 64 * 1024 * 1024
+    fifo.ttl = 3600
+    options.compactionStyle = .fifo(fifo)
+    let fifoPath = tempDirectory.appendingPathComponent("fifo").path
+    let fifoDB = try RocksDB.open(at: fifoPath, options: options)
+    defer { fifoDB.close() }
+    try fifoDB.put("event", forKey: "log-1")
+    try fifoDB.flush()
+    XCTAssertEqual(try fifoDB.getString("log-1"), "event")
+    let fifoCurrent = try XCTUnwrap(fifoDB.currentOptions())
+    XCTAssertTrue(fifoCurrent.contains("compaction_style=kCompactionStyleFIFO"))
+    XCTAssertTrue(fifoCurrent.contains("ttl=3600"))
+  }
+
+  func testLevelCompactionShape() throws {
+    var options = RocksDBOptions.default
+    options.maxBytesForLevelMultiplier = 8
+    options.compactionPriority = .roundRobin
+    options.periodicCompactionSeconds = 86_400
+    options.ttl = 7 * 86_400
+    let db = try RocksDB.open(at: tempDirectory.path, options: options)
+    defer { db.close() }
+
+    let current = try XCTUnwrap(db.currentOptions())
+    XCTAssertTrue(current.contains("level_compaction_dynamic_level_bytes=true"))
+    XCTAssertTrue(current.contains("compaction_pri=kRoundRobin"))
+    XCTAssertTrue(current.contains("periodic_compaction_seconds=86400"))
+    XCTAssertTrue(current.contains("ttl=604800"))
+
+    var changes = RocksDBMutableColumnFamilyOptions()
+    changes.ttl = 3600
+    try db.setOptions(changes)
+    XCTAssertTrue(try XCTUnwrap(db.currentOptions()).contains("ttl=3600"))
+  }
+
+  func testCompactOnDeletion() throws {
+    var options = RocksDBOptions.default
+    options.compactOnDeletion = RocksDBCompactOnDeletion(windowSize: 128, deletionTrigger: 64)
+    let db = try RocksDB.open(at: tempDirectory.appendingPathComponent("test.db").path, options: options)
+    defer { db.close() }
+
+    for i in 0..<1000 {
+      try db.put("value\(i)", forKey: String(format: "queue-%04d", i))
+    }
+    try db.flush()
+    for i in 0..<1000 {
+      try db.delete(String(format: "queue-%04d", i))
+    }
+    try db.flush()
+
+    // Two L0 files are below the compaction trigger; only the tombstone
+    // density schedules the compaction that drops both
+    let deadline = Date().addingTimeInterval(5)
+    while db.intProperty(.liveSstFilesSize) != 0 && Date() < deadline {
+      Thread.sleep(forTimeInterval: 0.01)
+    }
+    XCTAssertEqual(db.intProperty(.liveSstFilesSize), 0)
+    XCTAssertNil(try db.getString("queue-0042"))
+  }
+
+  func testSstPartitionerCutsFilesAtPrefixes() throws {
+    var options = RocksDBOptions.default
+    options.sstPartitionerPrefixLength = 2
+    let db = try RocksDB.open(at: tempDirectory.appendingPathComponent("test.db").path, options: options)
+    defer { db.close() }
+
+    for tenant in ["a", "b", "c"] {
+      for i in 0..<100 {
+        try db.put("value", forKey: "\(tenant)/\(String(format: "%03d", i))")
+      }
+    }
+    try db.flush()
+    try db.compactRange()
+
+    // The compacted file was split per tenant, so b's file lies inside the range
+    try db.deleteFiles(in: [.prefix(Data("b/".utf8))])
+    XCTAssertNil(try db.getString("b/000"))
+    XCTAssertNil(try db.getString("b/099"))
+    XCTAssertEqual(try db.getString("a/099"), "value")
+    XCTAssertEqual(try db.getString("c/000"), "value")
+  }
+
+  func testDirectIO() throws {
+    var options = RocksDBOptions.default
+    let supported = options.enableDirectIO(at: tempDirectory.path)
+    XCTAssertEqual(supported, RocksDBOptions.supportsDirectIO(at: tempDirectory.path))
+    XCTAssertEqual(options.useDirectReads, supported)
+    options.compactionReadaheadSize = 4 * 1024 * 1024
+
+    let db = try RocksDB.open(at: tempDirectory.path, options: options)
+    defer { db.close() }
+    try db.put("value", forKey: "key")
+    try db.flush()
+    XCTAssertEqual(try db.getString("key"), "value")
+
+    let current = try XCTUnwrap(db.currentOptions())
+    XCTAssertTrue(current.contains("use_direct_reads=\(supported)"))
+    XCTAssertTrue(current.contains("compaction_readahead_size=4194304"))
+  }
+
+  func testMmapReadOnly() throws {
+    var writeOptions = RocksDBOptions.default
+    writeOptions.compression = .none
+    let db = try RocksDB.open(at: tempDirectory.path, options: writeOptions)
+    for i in 0..<100 {
+      try db.put("value-\(i)", forKey: String(format: "key-%03d", i))
+    }
+    try db.flush()
+    db.close()
+
+    let reader = try RocksDB.openReadOnly(at: tempDirectory.path, options: .mmapReadOnly())
+    defer { reader.close() }
+    XCTAssertEqual(try reader.getString("key-042"), "value-42")
+    let current = try XCTUnwrap(reader.currentOptions())
+    XCTAssertTrue(current.contains("allow_mmap_reads=true"))
+  }
+
+  func testTieredCache() throws {
+    let cache = try RocksDBCache.tiered(totalCapacity: 8 * 1024 * 1024, compressedSecondaryRatio: 0.5,
+                                        admissionPolicy: .allowAll)
+    var options = RocksDBOptions()
+    options.enableStatistics = true
+    options.tableOptions = RocksDBTableOptions()
+    options.tableOptions?.blockCache = cache
+    let db = try RocksDB.open(at: tempDirectory.path, options: options)
+    defer { db.close() }
+
+    for i in 0..<100 {
+      try db.put("value-\(i)", forKey: "key-\(i)")
+    }
+    try db.flush()
+    XCTAssertEqual(try db.getString("key-1"), "value-1")
+    XCTAssertGreaterThan(cache.usage, 0)
+    XCTAssertEqual(db.tickerCount(.compressedSecondaryCacheHits), 0)
+
+    try cache.updateTiers(compressedSecondaryRatio: 0.3)
+    XCTAssertThrowsError(try RocksDBCache.lru(capacity: 1024).updateTiers(totalCapacity: 2048))
+  }
+
+  func testCheckpointAndExport() throws {
+    let db = try RocksDB.open(at: tempDirectory.appendingPathComponent("db").path)
+    defer { db.close() }
+    for i in 0..<100 {
+      try db.put("value-\(i)", forKey: "key-\(i)")
+    }
+
+    let checkpointPath = tempDirectory.appendingPathComponent("checkpoint").path
+    let sequence = try db.createCheckpoint(at: checkpointPath)
+    XCTAssertGreaterThan(sequence, 0)
+    try db.put("later", forKey: "key-1")
+
+    let copy = try RocksDB.open(at: checkpointPath)
+    XCTAssertEqual(try copy.getString("key-1"), "value-1")
+    copy.close()
+    XCTAssertThrowsError(try db.createCheckpoint(at: checkpointPath))
+
+    let export = try db.exportColumnFamily(to: tempDirectory.appendingPathComponent("export").path)
+    XCTAssertGreaterThan(export.fileCount, 0)
+    XCTAssertEqual(export.comparatorName, "leveldb.BytewiseComparator")
+
+    let imported = try db.importColumnFamily(named: "imported", from: export)
+    XCTAssertEqual(try db.get(Data("key-2".utf8), in: imported), Data("value-2".utf8))
+    XCTAssertEqual(try db.get(Data("key-1".utf8), in: imported), Data("later".utf8))
+  }
+
+  func testBackupEngine() throws {
+    let dbPath = tempDirectory.appendingPathComponent("db").path
+    var backupOptions = RocksDBBackupOptions()
+    backupOptions.maxBackgroundOperations = 4
+    let engine = try RocksDBBackupEngine.open(at: tempDirectory.appendingPathComponent("backups").path,
+                                              options: backupOptions)
+
+    let db = try RocksDB.open(at: dbPath)
+    try db.put("first", forKey: "key")
+    try db.flush()
+    let first = try engine.createBackup(of: db, metadata: "nightly")
+    try db.put("second", forKey: "key")
+    let second = try db.createBackup(in: engine, flushBeforeBackup: true)
+    db.close()
+
+    XCTAssertEqual(engine.backups.map(\.id), [first, second])
+    XCTAssertEqual(try engine.metadata(ofBackup: first), "nightly")
+    try engine.verifyBackup(second, checksums: true)
+
+    let restorePath = tempDirectory.appendingPathComponent("restored").path
+    try engine.restore(first, to: restorePath)
+    let restored = try RocksDB.open(at: restorePath)
+    XCTAssertEqual(try restored.getString("key"), "first")
+    restored.close()
+
+    try engine.purgeOldBackups(keeping: 1)
+    XCTAssertEqual(engine.backups.map(\.id), [second])
+    try engine.restore(to: restorePath)
+    let latest = try RocksDB.open(at: restorePath)
+    defer { latest.close() }
+    XCTAssertEqual(try latest.getString("key"), "second")
+  }
+
+  func testSecondaryInstance() throws {
+    let primaryPath = tempDirectory.appendingPathComponent("primary").path
+    let primary = try RocksDB.open(at: primaryPath)
+    defer { primary.close() }
+    try primary.put("one", forKey: "key-1")
+    try primary.flush()
+
+    let secondary = try RocksDB.openAsSecondary(
+      at: primaryPath, secondaryPath: tempDirectory.appendingPathComponent("secondary").path)
+    defer { secondary.close() }
+    XCTAssertEqual(try secondary.getString("key-1"), "one")
+
+    try primary.put("two", forKey: "key-2")
+    try primary.flush()
+    XCTAssertNil(try secondary.getString("key-2"))
+
+    let follower = RocksDBSecondaryFollower(database: secondary)
+    XCTAssertTrue(follower.catchUp())
+    XCTAssertEqual(follower.catchUpCount, 1)
+    XCTAssertNil(follower.lastError)
+    XCTAssertEqual(try secondary.getString("key-2"), "two")
+    XCTAssertThrowsError(try primary.tryCatchUpWithPrimary())
+  }
+
+  func testTimedOpen() throws {
+    let db = try RocksDB.open(at: tempDirectory.path)
+    for i in 0..<3 {
+      try db.put("value-\(i)", forKey: "key-\(i)")
+      try db.flush()
+    }
+    try db.put("unflushed", forKey: "wal-key")
+    db.close()
+
+    let (reopened, timing) = try RocksDB.openTimed(at: tempDirectory.path, options: .fastOpen)
+    defer { reopened.close() }
+    XCTAssertEqual(try reopened.getString("wal-key"), "unflushed")
+    XCTAssertGreaterThan(timing.total, 0)
+    XCTAssertEqual(timing.tablesOpened, 3)
+    XCTAssertGreaterThanOrEqual(timing.walFilesReplayed, 1)
+    XCTAssertLessThanOrEqual(timing.manifestRecovery + timing.tableOpening + timing.walReplay,
+                             timing.total + 0.001)
+  }
+
+  func testTieredStoragePaths() throws {
+    let fast = tempDirectory.appendingPathComponent("fast").path
+    let slow = tempDirectory.appendingPathComponent("slow").path
+    var options = RocksDBOptions()
+    options.placeLevels(onFast: fast, fastCapacity: 1024 * 1024 * 1024, slow: slow)
+    options.compactionStyle = .universal(RocksDBUniversalCompactionOptions())
+    options.lastLevelTemperature = .cold
+    XCTAssertEqual(options.dbPaths.count, 2)
+
+    let db = try RocksDB.open(at: tempDirectory.appendingPathComponent("db").path, options: options)
+    defer { db.close() }
+    for i in 0..<100 {
+      try db.put("value-\(i)", forKey: "key-\(i)")
+    }
+    try db.flush()
+
+    let fastFiles = try FileManager.default.contentsOfDirectory(atPath: fast)
+    XCTAssertTrue(fastFiles.contains { $0.hasSuffix(".sst") })
+    XCTAssertEqual(try db.getString("key-1"), "value-1")
+    XCTAssertTrue(try XCTUnwrap(db.currentOptions()).contains("last_level_temperature=kCold"))
+
+    var changes = RocksDBMutableColumnFamilyOptions()
+    changes.lastLevelTemperature = .warm
+    try db.setOptions(changes)
+  }
+
+  func testBlockCacheDumpAndLoad() throws {
+    let dbPath = tempDirectory.appendingPathComponent("db").path
+    let dumpPath = tempDirectory.appendingPathComponent("cache.dump").path
+    var options = RocksDBOptions()
+    options.tableOptions = RocksDBTableOptions()
+    options.tableOptions?.blockCache = .lru(capacity: 8 * 1024 * 1024)
+
+    let db = try RocksDB.open(at: dbPath, options: options)
+    for i in 0..<100 {
+      try db.put("value-\(i)", forKey: "key-\(i)")
+    }
+    try db.flush()
+    XCTAssertEqual(try db.getString("key-1"), "value-1")
+    try db.dumpBlockCache(to: dumpPath)
+    db.close()
+
+    // Cached data blocks are dumped uncompressed, so the values show up as written
+    let dump = try Data(contentsOf: URL(fileURLWithPath: dumpPath))
+    XCTAssertNotNil(dump.range(of: Data("value-1".utf8)))
+    XCTAssertNotNil(dump.range(of: Data("value-99".utf8)))
+
+    let cache = RocksDBCache.lru(capacity: 8 * 1024 * 1024, secondaryCapacity: 4 * 1024 * 1024)
+    options.tableOptions?.blockCache = cache
+    options.enableStatistics = true
+    let reopened = try RocksDB.open(at: dbPath, options: options)
+    defer { reopened.close() }
+    try cache.loadDump(from: dumpPath)
+    XCTAssertEqual(try reopened.getString("key-1"), "value-1")
+    // The data block came from the loaded dump rather than the SST file
+    XCTAssertGreaterThan(reopened.tickerCount(.secondaryCacheHits), 0)
+
+    XCTAssertThrowsError(try RocksDBCache.lru(capacity: 1024).loadDump(from: dumpPath))
+  }
+
+  func testSharedBlockCache() throws {
+    let cache = RocksDBCache.lru(capacity: 8 * 1024 * 1024)
+    var options = RocksDBOptions()
+    options.tableOptions = RocksDBTableOptions()
+    options.tableOptions?.blockCache = cache
+
+    let db1 = try RocksDB.open(at: tempDirectory.appendingPathComponent("db1").path, options: options)
+    let db2 = try RocksDB.open(at: tempDirectory.appendingPathComponent("db2").path, options: options)
+    defer {
+      db1.close()
+      db2.close()
+    }
+
+    for db in [db1, db2] {
+      for i in 0..<100 {
+        try db.put("value-\(i)", forKey: "key-\(i)")
+      }
+      try db.flush()
+      _ = try db.getString("key-1")
+    }
+
+    XCTAssertGreaterThan(cache.usage, 0)
+    XCTAssertEqual(cache.capacity, 8 * 1024 * 1024)
+
+    cache.capacity = 4 * 1024 * 1024
+    XCTAssertEqual(cache.capacity, 4 * 1024 * 1024)
+
+    let clock = RocksDBCache.hyperClock(capacity: 1024 * 1024)
+    XCTAssertEqual(clock.pinnedUsage, 0)
+  }
+
+  func testSharedWriteBufferManager() throws {
+    let cache = RocksDBCache.lru(capacity: 64 * 1024 * 1024)
+    let manager = RocksDBWriteBufferManager(bufferSize: 32 * 1024 * 1024, cache: cache)
+    XCTAssertEqual(manager.bufferSize, 32 * 1024 * 1024)
+
+    var options = RocksDBOptions()
+    options.writeBufferManager = manager
+
+    let db1 = try RocksDB.open(at: tempDirectory.appendingPathComponent("db1").path, options: options)
+    let db2 = try RocksDB.open(at: tempDirectory.appendingPathComponent("db2").path, options: options)
+    defer {
+      db1.close()
+      db2.close()
+    }
+
+    let value = Data(repeating: 0x42, count: 1024)
+    for i in 0..<1000 {
+      try db1.put(value, forKey: Data("key\(i)".utf8))
+      try db2.put(value, forKey: Data("key\(i)".utf8))
+    }
+
+    XCTAssertGreaterThan(manager.memoryUsage, 2 * 1000 * 1024)
+    XCTAssertGreaterThan(manager.cacheChargedUsage, 0)
+
+    manager.bufferSize = 16 * 1024 * 1024
+    XCTAssertEqual(manager.bufferSize, 16 * 1024 * 1024)
+  }
+
+  func testRateLimiter() throws {
+    let limiter = RocksDBRateLimiter(bytesPerSecond: 64 * 1024 * 1024)
+    XCTAssertEqual(limiter.bytesPerSecond, 64 * 1024 * 1024)
+
+    var options = RocksDBOptions()
+    options.rateLimiter = limiter
+
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    let db = try RocksDB.open(at: dbPath, options: options)
+    defer { db.close() }
+
+    for i in 0..<1000 {
+      try db.put(Data(repeating: 0x42, count: 1024), forKey: Data("key\(i)".utf8))
+    }
+    try db.flush()
+    XCTAssertGreaterThan(limiter.totalBytesThrough, 0)
+
+    limiter.bytesPerSecond = 8 * 1024 * 1024
+    XCTAssertEqual(limiter.bytesPerSecond, 8 * 1024 * 1024)
+  }
+
+  func testSstFileManager() throws {
+    let manager = try RocksDBSstFileManager(deleteRateBytesPerSecond: 1024 * 1024)
+    XCTAssertEqual(manager.deleteRateBytesPerSecond, 1024 * 1024)
+
+    var options = RocksDBOptions()
+    options.sstFileManager = manager
+    let db = try RocksDB.open(at: tempDirectory.appendingPathComponent("test.db").path, options: options)
+    defer { db.close() }
+
+    for i in 0..<1000 {
+      try db.put(Data(repeating: 0x42, count: 1024), forKey: Data("key\(i)".utf8))
+    }
+    try db.flush()
+    XCTAssertGreaterThan(manager.totalSize, 0)
+    XCTAssertFalse(manager.isMaxAllowedSpaceReached)
+
+    manager.setMaxAllowedSpaceUsage(1)
+    XCTAssertTrue(manager.isMaxAllowedSpaceReached)
+    manager.setMaxAllowedSpaceUsage(0)
+    manager.deleteRateBytesPerSecond = 0
+    XCTAssertEqual(manager.deleteRateBytesPerSecond, 0)
+  }
+
+  func testWALFilterSkipsRecordsOnRecovery() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    // Closing does not flush, so the writes are recovered from the WAL
+    var options = RocksDBOptions()
+    var db = try RocksDB.open(at: dbPath, options: options)
+    try db.put(Data("keep".utf8), forKey: Data("user:1".utf8))
+    try db.put(Data("drop".utf8), forKey: Data("cache:1".utf8))
+    let stop = db.latestSequenceNumber
+    try db.put(Data("late".utf8), forKey: Data("user:2".utf8))
+    db.close()
+
+    options.walFilter = RocksDBWALFilter(skipKeyPrefixes: [Data("cache:".utf8)], stopAfterSequence: stop)
+    options.walRecoveryMode = .tolerateCorruptedTailRecords
+    db = try RocksDB.open(at: dbPath, options: options)
+    XCTAssertEqual(try db.get(Data("user:1".utf8)), Data("keep".utf8))
+    XCTAssertNil(try db.get(Data("cache:1".utf8)))
+    XCTAssertNil(try db.get(Data("user:2".utf8)))
+    try db.put(Data("late".utf8), forKey: Data("user:3".utf8))
+    db.close()
+
+    // A limit of 0 is a real limit, not "unlimited"
+    options.walFilter = RocksDBWALFilter(stopAfterSequence: 0)
+    db = try RocksDB.open(at: dbPath, options: options)
+    defer { db.close() }
+    XCTAssertNil(try db.get(Data("user:3".utf8)))
+  }
+
+  func testChangeDataCapture() throws {
+    var options = RocksDBOptions()
+    options.walTTLSeconds = 3600
+    let db = try RocksDB.open(at: tempDirectory.appendingPathComponent("test.db").path, options: options)
+    defer { db.close() }
+
+    try db.put(Data("1".utf8), forKey: Data("a".utf8))
+    let start = db.latestSequenceNumber + 1
+    try db.batch { batch in
+      batch.put(Data("2".utf8), forKey: Data("b".utf8))
+      batch.delete(Data("a".utf8))
+    }
+    XCTAssertEqual(db.latestSequenceNumber, start + 1)
+
+    let updates = try db.updates(since: start)
+    defer { updates.close() }
+    let batch = try XCTUnwrap(try updates.next())
+    XCTAssertEqual(batch.sequence, start)
+    XCTAssertEqual(batch.count, 2)
+    XCTAssertFalse(batch.data.isEmpty)
+    XCTAssertEqual(batch.records, [
+      RocksDBWriteRecord(kind: .put, columnFamilyID: 0, key: Data("b".utf8), value: Data("2".utf8)),
+      RocksDBWriteRecord(kind: .delete, columnFamilyID: 0, key: Data("a".utf8), value: Data()),
+    ])
+    XCTAssertEqual(batch.nextSequence, start + 2)
+  }
+
+  func testSerializedBatchReplication() throws {
+    let leader = try RocksDB.open(at: tempDirectory.appendingPathComponent("leader.db").path)
+    defer { leader.close() }
+    let follower = try RocksDB.open(at: tempDirectory.appendingPathComponent("follower.db").path)
+    defer { follower.close() }
+
+    let batch = RocksDBBatch()
+    batch.put(Data("1".utf8), forKey: Data("a".utf8))
+    batch.put(Data("2".utf8), forKey: Data("b".utf8))
+    batch.deleteRange(from: Data("c".utf8), to: Data("d".utf8))
+    let shipped = batch.serializedData
+    XCTAssertEqual(shipped.count, batch.dataSize)
+    try leader.writeBatch(batch)
+
+    let replayed = try RocksDBBatch(serializedData: shipped)
+    XCTAssertEqual(replayed.count, 3)
+    XCTAssertTrue(replayed.withSerializedData { Data($0) == shipped })
+    try follower.writeBatch(replayed)
+    XCTAssertEqual(try follower.getString("a"), "1")
+    XCTAssertEqual(try follower.getString("b"), "2")
+
+    // A truncated batch is rejected before it reaches the WAL
+    for data in [shipped.prefix(8), shipped.dropLast(1)] {
+      XCTAssertThrowsError(try RocksDBBatch(serializedData: Data(data))) { error in
+        guard case RocksDBError.corruption = error else {
+          return XCTFail("Expected corruption, got \(error)")
+        }
+      }
+    }
+  }
+
+  func testApproximateMemoryUsage() throws {
+    let cache = RocksDBCache.lru(capacity: 8 * 1024 * 1024)
+    var tableOptions = RocksDBTableOptions()
+    tableOptions.blockCache = cache
+    var options = RocksDBOptions()
+    options.tableOptions = tableOptions
+
+    let first = try RocksDB.open(at: tempDirectory.appendingPathComponent("first.db").path, options: options)
+    defer { first.close() }
+    let second = try RocksDB.open(at: tempDirectory.appendingPathComponent("second.db").path, options: options)
+
+    for i in 0..<100 {
+      try first.put(Data(repeating: 0x42, count: 1024), forKey: Data("key\(i)".utf8))
+      try second.put(Data(repeating: 0x42, count: 1024), forKey: Data("key\(i)".utf8))
+    }
+
+    let single = try first.approximateMemoryUsage()
+    XCTAssertGreaterThan(single.memtableUnflushed, 0)
+    XCTAssertEqual(single.cacheCapacity, 8 * 1024 * 1024)
+
+    // The shared cache is counted once, even when passed explicitly
+    let both = try RocksDB.approximateMemoryUsage(of: [first, second, first], caches: [cache])
+    XCTAssertGreaterThan(both.memtableTotal, single.memtableTotal)
+    XCTAssertEqual(both.cacheCapacity, 8 * 1024 * 1024)
+
+    second.close()
+    XCTAssertThrowsError(try RocksDB.approximateMemoryUsage(of: [first, second]))
+  }
+
+  func testConcurrentWritesByWriteMode() throws {
+    var pipelined = RocksDBOptions()
+    pipelined.enablePipelinedWrite = true
+
+    var unordered = RocksDBOptions()
+    unordered.unorderedWrite = true
+
+    var serialMemtable = RocksDBOptions()
+    serialMemtable.allowConcurrentMemtableWrite = false
+
+    let modes: [(String, RocksDBOptions)] = [
+      ("default", RocksDBOptions()),
+      ("pipelined", pipelined),
+      ("unordered", unordered),
+      ("serial-memtable", serialMemtable),
+    ]
+
+    // Every write of concurrent writers lands, whichever write path they take
+    let writers = 8
+    for (name, options) in modes {
+      for (writeName, writeOptions, perWriter) in [("default", RocksDBWriteOptions.default, 200),
+                                                   ("sync", RocksDBWriteOptions.sync, 20)] {
+        let dbPath = tempDirectory.appendingPathComponent("writes-\(name)-\(writeName).db").path
+        let db = try RocksDB.open(at: dbPath, options: options)
+        defer { db.close() }
+
+        let failures = PartitionCounts()
+        DispatchQueue.concurrentPerform(iterations: writers) { w in
+          for i in 0..<perWriter {
+            do {
+              try db.put("value-\(i)", forKey: "w\(w)-k\(i)", options: writeOptions)
+            } catch {
+              failures.add(w)
+            }
+          }
+        }
+        XCTAssertEqual(failures.total, 0, "\(name) / \(writeName)")
+
+        var entries = 0
+        try db.forEach { _, _ in
+          entries += 1
+          return true
+        }
+        XCTAssertEqual(entries, writers * perWriter, "\(name) / \(writeName)")
+        XCTAssertEqual(try db.getString("w\(writers - 1)-k\(perWriter - 1)"), "value-\(perWriter - 1)")
+      }
+    }
+  }
+
+  // MARK: - Wide Column Tests
+
+  func testWideColumns() throws {
     let dbPath = tempDirectory.appendingPathComponent("test.db").path
     let db = try RocksDB.open(at: dbPath)
     defer { db.close() }
 
-    try db.put("hello", forKey: "greeting")
-    let result = try db.getString("greeting")
+    func d(_ s: String) -> Data { s.data(using: .utf8)! }
 
-    XCTAssertEqual(result, "hello")
-  }
+    try db.putEntity([(name: d("name"), value: d("alice")),
+                      (name: d("email"), value: d("a@example.com")),
+                      (name: d("age"), value: d("42"))],
+                     forKey: d("user:1"))
+    try db.batch { batch in
+      batch.putEntity([(name: d("name"), value: d("bob"))],
+                      forKey: d("user:2"), in: try db.defaultColumnFamily)
+    }
+    try db.put(d("plain"), forKey: d("user:3"))
 
-  func testGetNonExistent() throws {
-    let dbPath = tempDirectory.appendingPathComponent("test.db").path
-    let db = try RocksDB.open(at: dbPath)
-    defer { db.close() }
+    let entity = try XCTUnwrap(try db.getEntity(d("user:1")))
+    XCTAssertEqual(entity.map(\.name), [d("age"), d("email"), d("name")])
 
-    let result = try db.get("nonexistent".data(using: .utf8)!)
-    XCTAssertNil(result)
+    let selected = try XCTUnwrap(try db.getColumns([d("name"), d("phone")], forKey: d("user:1")))
+    XCTAssertEqual(selected, [d("alice"), nil])
+    XCTAssertNil(try db.getColumns([d("name")], forKey: d("missing")))
+
+    let age = try db.withEntity(forKey: d("user:1")) { columns in
+      columns.value(forColumn: d("age")).map { String(decoding: $0, as: UTF8.self) }
+    }
+    XCTAssertEqual(age, "42")
+
+    let iterator = try db.makeIterator()
+    iterator.seekToFirst()
+    var names: [Data?] = []
+    while iterator.isValid {
+      names.append(iterator.withColumns { $0.value(forColumn: d("name")).map { Data($0) } } ?? nil)
+      iterator.next()
+    }
+    XCTAssertEqual(names, [d("alice"), d("bob"), nil])
+
+    // Plain values read back as a single anonymous column
+    XCTAssertEqual(try db.getEntity(d("user:3"))?.first?.value, d("plain"))
   }
 
-  func testDelete() throws {
+  // MARK: - Column Family Tests
+
+  func testColumnFamilies() throws {
     let dbPath = tempDirectory.appendingPathComponent("test.db").path
-    let db = try RocksDB.open(at: dbPath)
-    defer { db.close() }
+    var eventOptions = RocksDBColumnFamilyOptions()
+    eventOptions.compression = .zstd
+    eventOptions.writeBufferSize = 8 * 1024 * 1024
 
-    let key = "to-delete".data(using: .utf8)!
-    let value = "some-value".data(using: .utf8)!
+    do {
+      let db = try RocksDB.open(at: dbPath, columnFamilies: [
+        "users": RocksDBColumnFamilyOptions(),
+        "events": eventOptions,
+      ])
+      let users = try XCTUnwrap(db.columnFamily(named: "users"))
+      let events = try XCTUnwrap(db.columnFamily(named: "events"))
+      let key = "id".data(using: .utf8)!
+
+      try db.put("default".data(using: .utf8)!, forKey: key)
+      try db.put("alice".data(using: .utf8)!, forKey: key, in: users)
+      try db.batch { batch in
+        batch.put("login".data(using: .utf8)!, forKey: key, in: events)
+        batch.delete("missing".data(using: .utf8)!, in: users)
+      }
 
-    try db.put(value, forKey: key)
-    XCTAssertNotNil(try db.get(key))
+      XCTAssertEqual(try db.get(key), "default".data(using: .utf8))
+      XCTAssertEqual(try db.get(key, in: users), "alice".data(using: .utf8))
+      XCTAssertEqual(try db.get(key, in: events), "login".data(using: .utf8))
+      XCTAssertNotNil(db.getProperty("rocksdb.estimate-num-keys", of: events))
 
-    try db.delete(key)
-    XCTAssertNil(try db.get(key))
-  }
+      let scratch = try db.createColumnFamily(named: "scratch")
+      try db.put("tmp".data(using: .utf8)!, forKey: key, in: scratch)
+      try db.dropColumnFamily(scratch)
+      XCTAssertNil(db.columnFamily(named: "scratch"))
+      db.close()
+    }
 
-  func testKeyMayExist() throws {
-    let dbPath = tempDirectory.appendingPathComponent("test.db").path
-    let db = try RocksDB.open(at: dbPath)
-    defer { db.close() }
+    let names = try RocksDB.listColumnFamilies(at: dbPath)
+    XCTAssertEqual(Set(names), ["default", "users", "events"])
 
-    let key = "exists".data(using: .utf8)!
-    try db.put("value".data(using: .utf8)!, forKey: key)
+    let db = try RocksDB.open(at: dbPath, columnFamilies: [
+      "users": RocksDBColumnFamilyOptions(),
+      "events": eventOptions,
+    ])
+    defer { db.close() }
+    let users = try XCTUnwrap(db.columnFamily(named: "users"))
+    XCTAssertEqual(try db.get("id".data(using: .utf8)!, in: users), "alice".data(using: .utf8))
 
-    // Note: keyMayExist can have false positives but should return true for existing keys
-    XCTAssertTrue(db.keyMayExist(key))
+    let other = try RocksDB.open(at: tempDirectory.appendingPathComponent("other.db").path)
+    defer { other.close() }
+    XCTAssertThrowsError(try other.get("id".data(using: .utf8)!, in: users))
   }
 
-  // MARK: - Batch Operations
-
-  func testBatch() throws {
-    let dbPath = tempDirectory.appendingPathComponent("test.db").path
-    let db = try RocksDB.open(at: dbPath)
+  func testBatchColumnFamilyOwnership() throws {
+    let db = try RocksDB.open(at: tempDirectory.appendingPathComponent("test.db").path)
     defer { db.close() }
+    let other = try RocksDB.openWithTransactions(at: tempDirectory.appendingPathComponent("other.db").path)
+    defer { other.close() }
+    let users = try db.createColumnFamily(named: "users")
+    let key = Data("id".utf8)
+
+    func expectInvalidArgument(_ body: () throws -> Void) {
+      XCTAssertThrowsError(try body()) { error in
+        guard case RocksDBError.invalidArgument = error else {
+          return XCTFail("Expected invalidArgument, got \(error)")
+        }
+      }
+    }
 
-    try db.batch { batch in
-      batch.put("value1", forKey: "key1")
-      batch.put("value2", forKey: "key2")
-      batch.put("value3", forKey: "key3")
+    // A batch is bound to the database of its families
+    let batch = RocksDBBatch()
+    batch.put(Data("alice".utf8), forKey: key, in: users)
+    expectInvalidArgument { try other.writeBatch(batch) }
+    try db.writeBatch(batch)
+    XCTAssertEqual(try db.get(key, in: users), Data("alice".utf8))
+
+    var builder = RocksDBBatchBuilder()
+    builder.delete(key, in: users)
+    do {
+      try other.writeBatch(builder)
+      XCTFail("Expected invalidArgument")
+    } catch RocksDBError.invalidArgument {
     }
 
-    XCTAssertEqual(try db.getString("key1"), "value1")
-    XCTAssertEqual(try db.getString("key2"), "value2")
-    XCTAssertEqual(try db.getString("key3"), "value3")
+    let indexed = RocksDBIndexedBatch()
+    indexed.put(Data("bob".utf8), forKey: key, in: users)
+    expectInvalidArgument { try other.writeBatch(indexed) }
+
+    let transaction = try other.beginTransaction()
+    expectInvalidArgument { try transaction.put(Data("carol".utf8), forKey: key, in: users) }
+    transaction.rollback()
+
+    // Families of a closed database are refused, not dereferenced
+    let scratch = try RocksDB.open(at: tempDirectory.appendingPathComponent("scratch.db").path)
+    let events = try scratch.createColumnFamily(named: "events")
+    scratch.close()
+    let stale = RocksDBBatch()
+    stale.put(Data("login".utf8), forKey: key, in: events)
+    XCTAssertEqual(stale.count, 0)
+    XCTAssertThrowsError(try stale.validate()) { error in
+      guard case RocksDBError.databaseClosed = error else {
+        return XCTFail("Expected databaseClosed, got \(error)")
+      }
+    }
+    stale.clear()
+    XCTAssertNoThrow(try stale.validate())
   }
 
-  func testBatchWithDelete() throws {
+  func testAttributeGroups() throws {
     let dbPath = tempDirectory.appendingPathComponent("test.db").path
-    let db = try RocksDB.open(at: dbPath)
+    var coldOptions = RocksDBColumnFamilyOptions()
+    coldOptions.compression = .zstd
+
+    let db = try RocksDB.open(at: dbPath, columnFamilies: [
+      "hot": RocksDBColumnFamilyOptions(),
+      "cold": coldOptions,
+    ])
     defer { db.close() }
+    let hot = try XCTUnwrap(db.columnFamily(named: "hot"))
+    let cold = try XCTUnwrap(db.columnFamily(named: "cold"))
 
-    // First add some data
-    try db.put("initial", forKey: "delete-me")
+    func d(_ s: String) -> Data { s.data(using: .utf8)! }
 
-    // Batch with both put and delete
+    try db.putEntity(groups: [
+      RocksDBAttributeGroup(columnFamily: hot, columns: [(name: d("status"), value: d("active"))]),
+      RocksDBAttributeGroup(columnFamily: cold, columns: [(name: d("bio"), value: d("long text"))]),
+    ], forKey: d("user:1"))
     try db.batch { batch in
-      batch.put("new-value", forKey: "new-key")
-      batch.delete("delete-me")
+      batch.putEntity(groups: [
+        RocksDBAttributeGroup(columnFamily: hot, columns: [(name: d("status"), value: d("idle"))]),
+      ], forKey: d("user:2"))
     }
 
-    XCTAssertEqual(try db.getString("new-key"), "new-value")
-    XCTAssertNil(try db.getString("delete-me"))
+    // Only the hot family is read
+    let status = try db.withAttributeGroups(forKey: d("user:1"), in: [hot]) { groups in
+      groups[0]?.value(forColumn: d("status")).map { Data($0) }
+    }
+    XCTAssertEqual(status, d("active"))
+
+    let groups = try db.getAttributeGroups(d("user:2"), in: [hot, cold])
+    XCTAssertEqual(groups.count, 1)
+    XCTAssertTrue(groups.first?.columnFamily === hot)
+
+    let iterator = try db.makeAttributeGroupIterator(over: [hot, cold])
+    iterator.seekToFirst()
+    var groupCounts: [Int] = []
+    while iterator.isValid {
+      groupCounts.append(iterator.groups?.count ?? 0)
+      iterator.next()
+    }
+    try iterator.checkStatus()
+    XCTAssertEqual(groupCounts, [2, 1])
   }
 
-  // MARK: - Iterator Tests
+  // MARK: - Maintenance Tests
 
-  func testIterator() throws {
+  func testFlush() throws {
     let dbPath = tempDirectory.appendingPathComponent("test.db").path
     let db = try RocksDB.open(at: dbPath)
     defer { db.close() }
 
-    // Insert sorted data
-    try db.put("a-value", forKey: "a")
-    try db.put("b-value", forKey: "b")
-    try db.put("c-value", forKey: "c")
+    try db.put("test", forKey: "key")
+    try db.flush()
+  }
 
-    let iter = try db.makeIterator()
-    defer { iter.close() }
+  func testManualWALFlush() throws {
+    let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    var options = RocksDBOptions()
+    options.manualWALFlush = true
+    options.walCompression = .zstd
+    options.walBytesPerSync = 1024 * 1024
+    options.maxTotalWALSize = 64 * 1024 * 1024
 
-    var keys: [String] = []
-    iter.seekToFirst()
-    while iter.isValid {
-      if let key = iter.keyString {
-        keys.append(key)
+    do {
+      let db = try RocksDB.open(at: dbPath, options: options)
+      for i in 0..<100 {
+        try db.put("value\(i)", forKey: "key\(i)")
       }
-      iter.next()
+      try db.flushWAL(sync: true)
+      try db.syncWAL()
+      db.close()
     }
-    try iter.checkStatus()
 
-    XCTAssertEqual(keys, ["a", "b", "c"])
+    let db = try RocksDB.open(at: dbPath, options: options)
+    defer { db.close() }
+    XCTAssertEqual(try db.getString("key99"), "value99")
   }
 
-  func testIteratorSequence() throws {
+  func testTTLExpiry() throws {
     let dbPath = tempDirectory.appendingPathComponent("test.db").path
-    let db = try RocksDB.open(at: dbPath)
+    let db = try RocksDB.openWithTTL(at: dbPath, ttl: 1)
     defer { db.close() }
 
-    try db.put("1", forKey: "key1")
-    try db.put("2", forKey: "key2")
-    try db.put("3", forKey: "key3")
-
-    let iter = try db.makeIterator()
-    defer { iter.close() }
+    try db.put("session", forKey: "token")
+    XCTAssertEqual(try db.getString("token"), "session")
 
-    var count = 0
-    for _ in iter {
-      count += 1
-    }
+    Thread.sleep(forTimeInterval: 2.5)
+    try db.compactRange()
+    XCTAssertNil(try db.getString("token"))
 
-    XCTAssertEqual(count, 3)
+    let plain = try RocksDB.open(at: tempDirectory.appendingPathComponent("plain.db").path)
+    defer { plain.close() }
+    XCTAssertThrowsError(try plain.setTTL(60))
   }
 
-  func testForEach() throws {
+  func testCompactionFilter() throws {
     let dbPath = tempDirectory.appendingPathComponent("test.db").path
-    let db = try RocksDB.open(at: dbPath)
+    let filter = RocksDBCompactionFilter()
+    filter.dropValues(width: 1, below: 2)
+
+    var options = RocksDBOptions()
+    options.compactionFilter = filter
+    let db = try RocksDB.open(at: dbPath, options: options)
     defer { db.close() }
 
-    try db.put("1", forKey: "a")
-    try db.put("2", forKey: "b")
-    try db.put("3", forKey: "c")
+    func d(_ s: String) -> Data { s.data(using: .utf8)! }
 
-    var count = 0
-    try db.forEach { _, _ in
-      count += 1
-      return true
-    }
+    try db.put(d("keep"), forKey: d("tenant-a/1"))
+    try db.put(d("drop"), forKey: d("tenant-b/1"))
+    try db.put(Data([1]) + d("old schema"), forKey: d("rows/1"))
+    try db.put(Data([2]) + d("new schema"), forKey: d("rows/2"))
 
-    XCTAssertEqual(count, 3)
+    // Prefixes added at runtime apply to the next compaction
+    filter.addDroppedPrefix(d("tenant-b/"))
+    try db.compactRange()
+
+    XCTAssertNotNil(try db.get(d("tenant-a/1")))
+    XCTAssertNil(try db.get(d("tenant-b/1")))
+    XCTAssertNil(try db.get(d("rows/1")))
+    XCTAssertNotNil(try db.get(d("rows/2")))
+    XCTAssertEqual(filter.droppedCount, 2)
   }
 
-  func testForEachWithPrefix() throws {
+  func testCompactionFilterKeepsNewestVersions() throws {
     let dbPath = tempDirectory.appendingPathComponent("test.db").path
-    let db = try RocksDB.open(at: dbPath)
-    defer { db.close() }
-
-    try db.put("val1", forKey: "prefix:1")
-    try db.put("val2", forKey: "prefix:2")
-    try db.put("val3", forKey: "other:1")
+    let filter = RocksDBCompactionFilter()
+    filter.keepNewestVersions(2, prefixLength: 4)
 
-    var prefixedKeys: [String] = []
-    let prefix = "prefix:".data(using: .utf8)!
+    var options = RocksDBOptions()
+    options.compactionFilter = filter
+    let db = try RocksDB.open(at: dbPath, options: options)
+    defer { db.close() }
 
-    try db.forEachWithPrefix(prefix) { key, _ in
-      if let keyStr = String(data: key, encoding: .utf8) {
-        prefixedKeys.append(keyStr)
-      }
-      return true
+    // Lower suffixes sort first and stand for newer versions
+    for version in ["1", "2", "3", "4", "5"] {
+      try db.put("v\(version)", forKey: "doc1/\(version)")
     }
+    try db.compactRange()
 
-    XCTAssertEqual(prefixedKeys.count, 2)
-    XCTAssertTrue(prefixedKeys.allSatisfy { $0.hasPrefix("prefix:") })
+    XCTAssertEqual(try db.getString("doc1/1"), "v1")
+    XCTAssertEqual(try db.getString("doc1/2"), "v2")
+    XCTAssertNil(try db.getString("doc1/3"))
+    XCTAssertNil(try db.getString("doc1/5"))
   }
 
-  // MARK: - Transaction Tests
-
-  func testTransaction() throws {
+  func testDeleteRangeAndPurge() throws {
     let dbPath = tempDirectory.appendingPathComponent("test.db").path
-    let db = try RocksDB.openWithTransactions(at: dbPath)
+    let db = try RocksDB.open(at: dbPath)
     defer { db.close() }
 
-    XCTAssertTrue(db.isTransactional)
+    func d(_ s: String) -> Data { s.data(using: .utf8)! }
 
-    let result = try db.transaction { txn in
-      try txn.put("txn-value", forKey: "txn-key")
-      return try txn.getString("txn-key")
+    for tenant in ["a", "b", "c"] {
+      for i in 0..<100 {
+        try db.put(d("value"), forKey: d("\(tenant)/\(String(format: "%03d", i))"))
+      }
+      try db.flush()
     }
 
-    XCTAssertEqual(result, "txn-value")
+    try db.deleteRange(from: d("a/"), to: d("a/050"))
+    XCTAssertNil(try db.get(d("a/000")))
+    XCTAssertNotNil(try db.get(d("a/050")))
 
-    // Verify committed
-    XCTAssertEqual(try db.getString("txn-key"), "txn-value")
+    try db.purgeRange(.prefix(d("b/")))
+    XCTAssertNil(try db.get(d("b/000")))
+    XCTAssertNil(try db.get(d("b/099")))
+    XCTAssertNotNil(try db.get(d("c/000")))
+
+    // Open-ended ranges are supported
+    try db.purgeRange(RocksDBKeyRange(start: d("c/")))
+    XCTAssertNil(try db.get(d("c/099")))
+    XCTAssertNotNil(try db.get(d("a/099")))
   }
 
-  func testTransactionRollback() throws {
+  func testBlobFiles() throws {
     let dbPath = tempDirectory.appendingPathComponent("test.db").path
-    let db = try RocksDB.openWithTransactions(at: dbPath)
+    var options = RocksDBOptions()
+    options.enableBlobFiles = true
+    options.minBlobSize = 4096
+    options.blobCompression = .lz4
+    options.enableBlobGarbageCollection = true
+    options.blobCache = .lru(capacity: 8 * 1024 * 1024)
+
+    let db = try RocksDB.open(at: dbPath, options: options)
     defer { db.close() }
 
-    // Put initial value
-    try db.put("initial", forKey: "rollback-test")
+    let document = Data(repeating: 0x42, count: 64 * 1024)
+    try db.put(document, forKey: "doc".data(using: .utf8)!)
+    try db.put("small", forKey: "meta")
+    try db.flush()
 
-    // Transaction that fails
-    do {
-      _ = try db.transaction { txn in
-        try txn.put("new-value", forKey: "rollback-test")
-        throw RocksDBError.invalidArgument("Intentional failure")
-      }
-      XCTFail("Should have thrown")
-    } catch {
-      // Expected
-    }
+    let blobFiles = try FileManager.default.contentsOfDirectory(atPath: dbPath)
+      .filter { $0.hasSuffix(".blob") }
+    XCTAssertFalse(blobFiles.isEmpty)
 
-    // Value should be unchanged
-    XCTAssertEqual(try db.getString("rollback-test"), "initial")
+    // Pinned reads resolve blob references
+    let count = try db.withValue(forKey: "doc".data(using: .utf8)!) { $0.count }
+    XCTAssertEqual(count, document.count)
+    XCTAssertEqual(try db.get("doc".data(using: .utf8)!), document)
+    XCTAssertEqual(try db.getString("meta"), "small")
   }
 
-  func testTransactionSavepoint() throws {
+  func testIndexedBatchReadsOwnWrites() throws {
     let dbPath = tempDirectory.appendingPathComponent("test.db").path
-    let db = try RocksDB.openWithTransactions(at: dbPath)
+    let db = try RocksDB.open(at: dbPath)
     defer { db.close() }
 
-    let txn = try db.beginTransaction()
-
-    try txn.put("value1", forKey: "key1")
-    txn.setSavepoint()
+    try db.put("stored", forKey: "a")
+    try db.put("stored", forKey: "b")
 
-    try txn.put("value2", forKey: "key2")
+    let batch = RocksDBIndexedBatch()
+    batch.put("staged", forKey: "b")
+    batch.put("staged", forKey: "c")
+    batch.delete("a")
 
-    // Rollback to savepoint
-    try txn.rollbackToSavepoint()
+    XCTAssertNil(try db.get("a".data(using: .utf8)!, stagedIn: batch))
+    XCTAssertEqual(try db.get("b".data(using: .utf8)!, stagedIn: batch), "staged".data(using: .utf8)!)
+    XCTAssertEqual(try db.getString("b"), "stored")
 
-    // key2 should be gone, key1 should remain
-    try txn.commit()
+    let iterator = try db.makeIterator(stagedIn: batch)
+    XCTAssertEqual(iterator.map { String(data: $0.key, encoding: .utf8)! }, ["b", "c"])
+    iterator.close()
 
-    XCTAssertEqual(try db.getString("key1"), "value1")
-    XCTAssertNil(try db.getString("key2"))
+    XCTAssertEqual(batch.count, 3)
+    try db.writeBatch(batch)
+    XCTAssertNil(try db.getString("a"))
+    XCTAssertEqual(try db.getString("c"), "staged")
   }
 
-  // MARK: - Options Tests
-
-  func testCustomOptions() throws {
-    var options = RocksDBOptions()
-    options.compression = .zstd
-    options.writeBufferSize = 128 * 1024 * 1024
-    options.maxOpenFiles = 500
-
+  func testSingleDelete() throws {
     let dbPath = tempDirectory.appendingPathComponent("test.db").path
-    let db = try RocksDB.open(at: dbPath, options: options)
+    let db = try RocksDB.open(at: dbPath)
     defer { db.close() }
 
-    try db.put("test", forKey: "key")
-    XCTAssertEqual(try db.getString("key"), "test")
-  }
+    let keys = (0..<3).map { "idem-\($0)".data(using: .utf8)! }
+    for key in keys {
+      try db.put("seen".data(using: .utf8)!, forKey: key)
+    }
+    try db.flush()
 
-  func testPointLookupOptions() throws {
-    let options = RocksDBOptions.pointLookup(blockCacheSizeMB: 64)
+    try db.singleDelete(keys[0])
+    let batch = RocksDBBatch()
+    batch.singleDelete(keys[1])
+    try db.writeBatch(batch)
+    XCTAssertNil(try db.get(keys[0]))
+    XCTAssertNil(try db.get(keys[1]))
+    XCTAssertNotNil(try db.get(keys[2]))
 
+    try db.compactRange()
+    XCTAssertEqual(try db.makeIterator().map(\.key), [keys[2]])
+  }
+
+  func testUserDefinedTimestamps() throws {
     let dbPath = tempDirectory.appendingPathComponent("test.db").path
+    var options = RocksDBOptions()
+    options.comparator = .bytewiseWithU64Timestamp
+
     let db = try RocksDB.open(at: dbPath, options: options)
     defer { db.close() }
 
-    try db.put("test", forKey: "key")
-    XCTAssertEqual(try db.getString("key"), "test")
-  }
+    let key = "account".data(using: .utf8)!
+    try db.put("v10".data(using: .utf8)!, forKey: key, timestamp: 10)
+    try db.put("v20".data(using: .utf8)!, forKey: key, timestamp: 20)
+    try db.delete(key, timestamp: 30)
+
+    XCTAssertNil(try db.get(key, asOf: 5))
+    let at15 = try db.get(key, asOf: 15)
+    XCTAssertEqual(at15?.value, "v10".data(using: .utf8)!)
+    XCTAssertEqual(at15?.timestamp, 10)
+    XCTAssertEqual(try db.get(key, asOf: 25)?.timestamp, 20)
+    XCTAssertNil(try db.get(key, asOf: .max))
+
+    // Every version in [10, 25], newest first
+    var readOptions = RocksDBReadOptions()
+    readOptions.timestamp = 25
+    readOptions.iterStartTimestamp = 10
+    let iterator = try db.makeIterator(options: readOptions)
+    iterator.seekToFirst()
+    var timestamps: [UInt64] = []
+    while iterator.isValid {
+      timestamps.append(iterator.timestamp ?? 0)
+      iterator.next()
+    }
+    XCTAssertEqual(timestamps, [20, 10])
 
-  // MARK: - Maintenance Tests
+    let batch = RocksDBBatch()
+    batch.put("v40".data(using: .utf8)!, forKey: key, timestamp: 40, in: try db.defaultColumnFamily)
+    try db.writeBatch(batch)
+    XCTAssertEqual(try db.get(key, asOf: 40)?.value, "v40".data(using: .utf8)!)
 
-  func testFlush() throws {
-    let dbPath = tempDirectory.appendingPathComponent("test.db").path
-    let db = try RocksDB.open(at: dbPath)
-    defer { db.close() }
+    try db.increaseFullHistoryTimestampLow(to: 20)
+    XCTAssertEqual(try db.fullHistoryTimestampLow(), 20)
+    XCTAssertThrowsError(try db.get(key, asOf: 15))
+  }
 
-    try db.put("test", forKey: "key")
-    try db.flush()
+  func testBuiltInComparators() throws {
+    var options = RocksDBOptions()
+    options.comparator = .reverseBytewise
+    let reversed = try RocksDB.open(at: tempDirectory.appendingPathComponent("reverse.db").path,
+                                    options: options)
+    defer { reversed.close() }
+    for key in ["a", "c", "b"] {
+      try reversed.put(key, forKey: key)
+    }
+    XCTAssertEqual(try reversed.makeIterator().map { String(data: $0.key, encoding: .utf8)! },
+                   ["c", "b", "a"])
+
+    options.comparator = .descendingUInt64Prefix
+    let series = try RocksDB.open(at: tempDirectory.appendingPathComponent("series.db").path,
+                                  options: options)
+    defer { series.close() }
+    func seriesKey(_ time: UInt64, _ tag: String) -> Data {
+      withUnsafeBytes(of: time.bigEndian) { Data($0) } + tag.data(using: .utf8)!
+    }
+    for (time, tag) in [(1, "b"), (300, "a"), (2, "a"), (300, "b"), (1, "a")] {
+      try series.put(Data(), forKey: seriesKey(UInt64(time), tag))
+    }
+    XCTAssertEqual(try series.makeIterator().map(\.key),
+                   [seriesKey(300, "a"), seriesKey(300, "b"), seriesKey(2, "a"),
+                    seriesKey(1, "a"), seriesKey(1, "b")])
   }
 
   func testCompactRange() throws {
@@ -399,3 +3914,54 @@ final class RocksDBTests: XCTestCase {
     }
   }
 }
+
+/// Compaction service whose worker runs on the compaction thread itself
+private final class InProcessCompactionService: RocksDBCompactionService, @unchecked Sendable {
+  private let lock = NSLock()
+  private let outputRoot: String
+  private var jobs: [String: (job: RocksDBCompactionJob, input: Data)] = [:]
+  private var completedJobs: [RocksDBCompactionJob] = []
+  private var installedJobs: [(id: String, status: RocksDBCompactionJobStatus)] = []
+
+  init(outputRoot: String) {
+    self.outputRoot = outputRoot
+  }
+
+  func schedule(_ job: RocksDBCompactionJob, input: Data) -> RocksDBCompactionSchedule {
+    let id = "\(job.sessionID)-\(job.jobID)"
+    lock.withLock { jobs[id] = (job, input) }
+    return .scheduled(jobID: id)
+  }
+
+  func wait(forJob id: String) -> RocksDBCompactionResult {
+    guard let (job, input) = lock.withLock({ jobs.removeValue(forKey: id) }) else { return .failure }
+    do {
+      let output = try RocksDB.openAndCompact(at: job.databaseName,
+                                              outputDirectory: "\(outputRoot)/\(id)", input: input)
+      lock.withLock { completedJobs.append(job) }
+      return .completed(output)
+    } catch {
+      return .failure
+    }
+  }
+
+  func installed(job id: String, status: RocksDBCompactionJobStatus) {
+    lock.withLock { installedJobs.append((id, status)) }
+  }
+
+  var finished: [RocksDBCompactionJob] { lock.withLock { completedJobs } }
+  var installations: [(id: String, status: RocksDBCompactionJobStatus)] { lock.withLock { installedJobs } }
+}
+
+/// Thread-safe per-partition key counter for parallel scan tests
+private final class PartitionCounts: @unchecked Sendable {
+  private let lock = NSLock()
+  private var counts: [Int: Int] = [:]
+
+  func add(_ partition: Int) {
+    lock.withLock { counts[partition, default: 0] += 1 }
+  }
+
+  var total: Int { lock.withLock { counts.values.reduce(0, +) } }
+  var partitions: Int { lock.withLock { counts.count } }
+}